@@ -500,6 +500,7 @@ struct st_app_context {
   uint64_t last_stat_time_ns;
 
   bool runtime_session;
+  bool af_packet; /* use the native af_packet socket backend for the kernel interface */
   bool enable_hdr_split;
   bool tx_copy_once;
   bool app_thread;
@@ -97,6 +97,18 @@ enum st_args_cmd {
   ST_ARG_PTP_KI,
   ST_ARG_PTP_TSC,
   ST_ARG_RSS_MODE,
+  ST_ARG_RSS_SCH_NB,
+  ST_ARG_PACING_CACHE,
+  ST_ARG_AF_PACKET,
+  ST_ARG_SCH_MEASURED_QUOTA,
+  ST_ARG_TASKLET_BALANCE,
+  ST_ARG_SCH_STATS_SHM,
+  ST_ARG_TX_MBUF_RECYCLE,
+  ST_ARG_TX_LAUNCH_TIME_EMU,
+  ST_ARG_SW_DMA,
+  ST_ARG_SW_DMA_LATENCY_US,
+  ST_ARG_TX_PACING_TRAIN_FAKE,
+  ST_ARG_CVT_THREADS,
   ST_ARG_RANDOM_SRC_PORT,
   ST_ARG_TX_NO_CHAIN,
   ST_ARG_MULTI_SRC_PORT,
@@ -206,6 +218,18 @@ static struct option st_app_args_options[] = {
     {"ki", required_argument, 0, ST_ARG_PTP_KI},
     {"ptp_tsc", no_argument, 0, ST_ARG_PTP_TSC},
     {"rss_mode", required_argument, 0, ST_ARG_RSS_MODE},
+    {"rss_sch_nb", required_argument, 0, ST_ARG_RSS_SCH_NB},
+    {"pacing_cache", required_argument, 0, ST_ARG_PACING_CACHE},
+    {"af_packet", no_argument, 0, ST_ARG_AF_PACKET},
+    {"sch_measured_quota", no_argument, 0, ST_ARG_SCH_MEASURED_QUOTA},
+    {"tasklet_balance", no_argument, 0, ST_ARG_TASKLET_BALANCE},
+    {"sch_stats_shm", no_argument, 0, ST_ARG_SCH_STATS_SHM},
+    {"tx_mbuf_recycle", no_argument, 0, ST_ARG_TX_MBUF_RECYCLE},
+    {"tx_launch_time_emu", no_argument, 0, ST_ARG_TX_LAUNCH_TIME_EMU},
+    {"sw_dma", no_argument, 0, ST_ARG_SW_DMA},
+    {"sw_dma_latency_us", required_argument, 0, ST_ARG_SW_DMA_LATENCY_US},
+    {"tx_pacing_train_fake", no_argument, 0, ST_ARG_TX_PACING_TRAIN_FAKE},
+    {"cvt_threads", required_argument, 0, ST_ARG_CVT_THREADS},
     {"random_src_port", no_argument, 0, ST_ARG_RANDOM_SRC_PORT},
     {"tx_no_chain", no_argument, 0, ST_ARG_TX_NO_CHAIN},
     {"multi_src_port", no_argument, 0, ST_ARG_MULTI_SRC_PORT},
@@ -627,6 +651,43 @@ int st_app_parse_args(struct st_app_context* ctx, struct mtl_init_params* p, int
         else
           err("%s, unknow rss mode %s\n", __func__, optarg);
         break;
+      case ST_ARG_RSS_SCH_NB:
+        for (enum mtl_port port = MTL_PORT_P; port < MTL_PORT_MAX; port++)
+          p->rss_sch_nb[port] = atoi(optarg);
+        break;
+      case ST_ARG_PACING_CACHE:
+        p->pacing_train_cache = optarg;
+        break;
+      case ST_ARG_AF_PACKET:
+        ctx->af_packet = true;
+        break;
+      case ST_ARG_SCH_MEASURED_QUOTA:
+        p->flags |= MTL_FLAG_SCH_MEASURED_QUOTA;
+        break;
+      case ST_ARG_TASKLET_BALANCE:
+        p->flags |= MTL_FLAG_TASKLET_BALANCE;
+        break;
+      case ST_ARG_SCH_STATS_SHM:
+        p->flags |= MTL_FLAG_SCH_STATS_SHM;
+        break;
+      case ST_ARG_TX_MBUF_RECYCLE:
+        p->flags |= MTL_FLAG_TX_MBUF_RECYCLE;
+        break;
+      case ST_ARG_TX_LAUNCH_TIME_EMU:
+        p->flags |= MTL_FLAG_TX_LAUNCH_TIME_EMU;
+        break;
+      case ST_ARG_SW_DMA:
+        p->flags |= MTL_FLAG_SW_DMA;
+        break;
+      case ST_ARG_SW_DMA_LATENCY_US:
+        p->sw_dma_latency_us = atoi(optarg);
+        break;
+      case ST_ARG_TX_PACING_TRAIN_FAKE:
+        p->flags |= MTL_FLAG_TX_PACING_TRAIN_FAKE;
+        break;
+      case ST_ARG_CVT_THREADS:
+        p->cvt_threads = atoi(optarg);
+        break;
       case ST_ARG_TX_NO_CHAIN:
         p->flags |= MTL_FLAG_TX_NO_CHAIN;
         break;
@@ -328,6 +328,8 @@ int main(int argc, char** argv) {
     }
     /* parse af xdp pmd info */
     ctx->para.pmd[i] = mtl_pmd_by_port_name(ctx->para.port[i]);
+    if (ctx->af_packet && ctx->para.pmd[i] == MTL_PMD_DPDK_AF_XDP)
+      ctx->para.pmd[i] = MTL_PMD_AF_PACKET;
     ctx->para.xdp_info[i].queue_count =
         ST_MAX(ctx->para.tx_queues_cnt[i], ctx->para.rx_queues_cnt[i]);
   }
@@ -184,6 +184,13 @@ enum mtl_pmd_type {
   MTL_PMD_DPDK_USER = 0,
   /** address family(kernel) high performance packet processing */
   MTL_PMD_DPDK_AF_XDP,
+  /**
+   * Native kernel packet socket backend, a TPACKET_V3 mmap rx ring per queue in a
+   * fanout group and sendmmsg tx, no ethdev or vdev. Run on any kernel
+   * interface(veth, lo) without a dedicated NIC. The DPDK EAL still runs in no-huge
+   * in-memory mode for the mbuf/mempool when all ports are af_packet.
+   */
+  MTL_PMD_AF_PACKET,
   /** max value of this enum */
   MTL_PMD_TYPE_MAX,
 };
@@ -426,6 +433,57 @@ enum st21_tx_pacing_way {
  * Enable built-in PHC2SYS implementation.
  */
 #define MTL_FLAG_PHC2SYS_ENABLE (MTL_BIT64(46))
+/**
+ * Flag bit in flags of struct mtl_init_params.
+ * Use the measured cpu load of the sch for the session admission instead of the
+ * static data quota, a sch is marked busy and no new session is placed if the load is
+ * too high. The load is the busy time of the tasklets, it is measured again after any
+ * quota change and the static quota is used until then.
+ */
+#define MTL_FLAG_SCH_MEASURED_QUOTA (MTL_BIT64(47))
+/**
+ * Flag bit in flags of struct mtl_init_params.
+ * Enable the tasklet balancer, the busy tasklets may be moved between the lcores to
+ * even the lcore utilization. The st20 tx builders, the audio/ancillary session and
+ * transmitter tasklets and the udp lcore tasklets can be moved. The tx/rx video
+ * session tasklets stay as their pair of tasklets share the session locks.
+ */
+#define MTL_FLAG_TASKLET_BALANCE (MTL_BIT64(48))
+/**
+ * Flag bit in flags of struct mtl_init_params.
+ * Record the histograms of the tasklet run time, the sch loop period and the sleep
+ * overshoot into a shared memory segment, see mtl_sch_stats_api.h for the layout.
+ */
+#define MTL_FLAG_SCH_STATS_SHM (MTL_BIT64(49))
+/**
+ * Flag bit in flags of struct mtl_init_params.
+ * Keep the hdr mbufs of st20 tx frame sessions after the tx and reuse them directly
+ * once the tx is done, instead of a mempool round trip for each pkt.
+ */
+#define MTL_FLAG_TX_MBUF_RECYCLE (MTL_BIT64(50))
+/**
+ * Flag bit in flags of struct mtl_init_params.
+ * Software launch time emulation on the st20 tx queues for the pacing test without a
+ * TSN NIC. The launch time and the departure time of each pkt are recorded, see
+ * mtl_get_tx_launch_time_stats. With ST21_TX_PACING_WAY_TSN the pkts are also held
+ * until the launch time by a thread per port, which sleeps until shortly before the
+ * launch time of the first waiting pkt and busy polls only the last 20us.
+ */
+#define MTL_FLAG_TX_LAUNCH_TIME_EMU (MTL_BIT64(51))
+/**
+ * Flag bit in flags of struct mtl_init_params.
+ * Add software dma devs on the dma dev slots left by the hardware dma devs, each one
+ * copies by a dedicated thread with the same interface of the hardware dma dev, for
+ * the machines without CBDMA/DSA. See sw_dma_latency_us for the emulated latency.
+ */
+#define MTL_FLAG_SW_DMA (MTL_BIT64(52))
+/**
+ * Flag bit in flags of struct mtl_init_params.
+ * Debug option, the tx rl pacing train doesn't burst the pad pkts to the NIC but takes
+ * the synthetic timing of an ideal NIC, with the same duration of a real train. For the
+ * test of the concurrent and deduplicated pacing train, the result is always 64.
+ */
+#define MTL_FLAG_TX_PACING_TRAIN_FAKE (MTL_BIT64(53))
 
 /**
  * The structure describing how to init af_xdp interface.
@@ -584,6 +642,31 @@ struct mtl_init_params {
    * static or DHCP
    */
   enum mtl_net_proto net_proto[MTL_PORT_MAX];
+  /**
+   * The number of schedulers(lcores) for the shared rss mode, the rss queues of the
+   * port are split between them. 0 means determined by lib(one scheduler).
+   */
+  uint16_t rss_sch_nb[MTL_PORT_MAX];
+  /**
+   * Path of the file to persist the tx rate limit pacing train results, NULL means
+   * disabled. The results are keyed by the port, driver, link speed and rate, a valid
+   * cached result is reused at session create time instead of a new training.
+   * A file of another lib version is ignored and replaced at the next new result.
+   * The string is copied in mtl_init.
+   */
+  char* pacing_train_cache;
+  /**
+   * The emulated latency(us) from the submit to the completion of each copy on the
+   * software dma devs, only for MTL_FLAG_SW_DMA. 0 means complete as fast as possible.
+   */
+  uint32_t sw_dma_latency_us;
+  /**
+   * The number of worker threads in the lib convert pool, the threads run on the cpus
+   * of the numa node of MTL_PORT_P. The internal convert of st20p and
+   * st_frame_convert_parallel split each frame into horizontal slices and convert them
+   * in parallel on the pool. 0 means disabled, all convert run on the caller thread.
+   */
+  uint16_t cvt_threads;
 };
 
 /**
@@ -634,6 +717,32 @@ struct mtl_port_status {
   uint64_t tx_err_packets;
 };
 
+/**
+ * A structure used to retrieve the tx launch time emulation statistics for a MTL port,
+ * see MTL_FLAG_TX_LAUNCH_TIME_EMU. All the times are in ns of the ptp clock.
+ */
+struct mtl_tx_launch_time_stats {
+  /** Total number of departed packets with a launch time. */
+  uint64_t pkts;
+  /** Number of packets departed before the launch time. */
+  uint64_t early_pkts;
+  /** Max time of a packet departed before the launch time. */
+  uint64_t early_max_ns;
+  /** Average time of a packet departed after the launch time. */
+  uint64_t late_avg_ns;
+  /** 99th percentile of the time a packet departed after the launch time. */
+  uint64_t late_p99_ns;
+  /** Max time of a packet departed after the launch time. */
+  uint64_t late_max_ns;
+  /**
+   * Max number of packets of one queue departed ahead of the launch time at the same
+   * moment, compare it with the Cmax of the ST2110-21 narrow sender.
+   */
+  uint32_t ahead_max_pkts;
+  /** The tx pacing way of this port, the stats depend on it. */
+  enum st21_tx_pacing_way pacing_way;
+};
+
 /**
  * Retrieve the fixed information of an MTL instance.
  *
@@ -688,6 +797,36 @@ int mtl_get_port_stats(mtl_handle mt, enum mtl_port port, struct mtl_port_status
  */
 int mtl_reset_port_stats(mtl_handle mt, enum mtl_port port);
 
+/**
+ * Retrieve the tx launch time emulation statistics for a MTL port.
+ * Only available with MTL_FLAG_TX_LAUNCH_TIME_EMU.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param port
+ *   The port index.
+ * @param stats
+ *   A pointer to stats structure.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int mtl_get_tx_launch_time_stats(mtl_handle mt, enum mtl_port port,
+                                 struct mtl_tx_launch_time_stats* stats);
+
+/**
+ * Reset the tx launch time emulation statistics for a MTL port.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param port
+ *   The port index.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int mtl_reset_tx_launch_time_stats(mtl_handle mt, enum mtl_port port);
+
 /**
  * Inline function returning primary port pointer from mtl_init_params
  * @param p
@@ -822,6 +961,18 @@ int mtl_sch_enable_sleep(mtl_handle mt, int sch_idx, bool enable);
  */
 int mtl_sch_set_sleep_us(mtl_handle mt, uint64_t us);
 
+/**
+ * Get the name of the sch stats shared memory object if MTL_FLAG_SCH_STATS_SHM is
+ * enabled, see mtl_sch_stats_api.h for the layout.
+ *
+ * @param mt
+ *   The handle to the MTL transport device context.
+ * @return
+ *   - The name for shm_open.
+ *   - NULL: the stats shm is not enabled or failed to create.
+ */
+const char* mtl_sch_stats_shm_name(mtl_handle mt);
+
 /**
  * Request one DPDK lcore from the MTL transport device context.
  *
@@ -0,0 +1,218 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+/**
+ * @file mtl_sch_stats_api.h
+ *
+ * Layout of the scheduler stats shared memory segment.
+ *
+ * If MTL_FLAG_SCH_STATS_SHM is enabled, the lib records the histograms of the per
+ * tasklet run time, the scheduler loop period and the sleep overshoot into a POSIX
+ * shared memory object named by MTL_SCH_STATS_SHM_NAME_FMT with the pid and the
+ * instance id, see mtl_sch_stats_shm_name. An external tool can shm_open and mmap it
+ * read only, the size of the segment is in the size field of the header. The counters
+ * are updated with plain 64 bits stores by the scheduler thread without any lock, so a
+ * reader may see one histogram in the middle of an update.
+ *
+ */
+
+#include <stdint.h>
+
+#ifndef _MTL_SCH_STATS_API_HEAD_H_
+#define _MTL_SCH_STATS_API_HEAD_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/** Magic of the stats segment, "MTLS" */
+#define MTL_SCH_STATS_MAGIC (0x534c544d)
+/** Layout version of the stats segment */
+#define MTL_SCH_STATS_VERSION (2)
+/**
+ * Name format of the shared memory object, the args are the pid of the lib user and the
+ * instance id of the mtl handle in this process.
+ */
+#define MTL_SCH_STATS_SHM_NAME_FMT "/mtl_sch_stats_%d_%d"
+/** Max number of schedulers in the stats segment */
+#define MTL_SCH_STATS_SCH_MAX (18)
+/** Max name len of the tasklet */
+#define MTL_SCH_STATS_NAME_MAX (32)
+
+/**
+ * Log-linear(HDR style) histogram, values in ns. Values below 2^MTL_HIST_SUB_BITS are
+ * exact, then each power of two range is split into 2^MTL_HIST_SUB_BITS buckets.
+ */
+#define MTL_HIST_SUB_BITS (3)
+/** Max power of two in the histogram, bigger values are put into the last bucket */
+#define MTL_HIST_MAX_BITS (40)
+/** Number of buckets in the histogram */
+#define MTL_HIST_BUCKETS \
+  ((MTL_HIST_MAX_BITS - MTL_HIST_SUB_BITS + 2) << MTL_HIST_SUB_BITS)
+
+/**
+ * The histogram in the stats segment.
+ */
+struct mtl_hist {
+  /** total count of the values */
+  uint64_t count;
+  /** sum of the values in ns */
+  uint64_t sum_ns;
+  /** max value in ns */
+  uint64_t max_ns;
+  /** count of each bucket */
+  uint64_t buckets[MTL_HIST_BUCKETS];
+};
+
+/**
+ * The stats of one tasklet.
+ */
+struct mtl_sch_stats_tasklet {
+  /**
+   * Generation of the slot, odd when the slot is being updated by a register or a
+   * move. Read it before and after the name to get a stable one.
+   */
+  uint32_t gen;
+  /** if one tasklet is running on this slot */
+  uint32_t active;
+  /** tasklet name */
+  char name[MTL_SCH_STATS_NAME_MAX];
+  /** run time of each handler call */
+  struct mtl_hist run_time;
+};
+
+/**
+ * The stats of one scheduler, followed by max_tasklets of struct mtl_sch_stats_tasklet,
+ * see mtl_sch_stats_get_tasklet.
+ */
+struct mtl_sch_stats_sch {
+  /** if this scheduler is running */
+  uint32_t active;
+  /** the number of valid tasklet slots */
+  uint32_t nb_tasklets;
+  /** time between two loops */
+  struct mtl_hist loop_period;
+  /** actual sleep time minus the target sleep time */
+  struct mtl_hist sleep_overshoot;
+};
+
+/**
+ * The header of the stats segment, followed by nb_sch scheduler entries of sch_size
+ * bytes each, see mtl_sch_stats_get_sch.
+ */
+struct mtl_sch_stats_shm {
+  /** MTL_SCH_STATS_MAGIC */
+  uint32_t magic;
+  /** MTL_SCH_STATS_VERSION */
+  uint32_t version;
+  /** MTL_HIST_SUB_BITS of the writer */
+  uint32_t hist_sub_bits;
+  /** the number of schedulers */
+  uint32_t nb_sch;
+  /** the tasklet slots of each scheduler, the tasklets_nb_per_sch of the lib */
+  uint32_t max_tasklets;
+  /** the bytes of one scheduler entry including its tasklet slots */
+  uint32_t sch_size;
+  /** the total bytes of the segment */
+  uint64_t size;
+};
+
+/**
+ * Get the bytes of one scheduler entry in the stats segment.
+ *
+ * @param max_tasklets
+ *   The tasklet slots of each scheduler.
+ * @return
+ *   The bytes of one scheduler entry.
+ */
+static inline uint64_t mtl_sch_stats_sch_size(uint32_t max_tasklets) {
+  return sizeof(struct mtl_sch_stats_sch) +
+         (uint64_t)max_tasklets * sizeof(struct mtl_sch_stats_tasklet);
+}
+
+/**
+ * Get the total bytes of the stats segment.
+ *
+ * @param nb_sch
+ *   The number of schedulers.
+ * @param max_tasklets
+ *   The tasklet slots of each scheduler.
+ * @return
+ *   The total bytes of the stats segment.
+ */
+static inline uint64_t mtl_sch_stats_shm_size(uint32_t nb_sch, uint32_t max_tasklets) {
+  return sizeof(struct mtl_sch_stats_shm) +
+         (uint64_t)nb_sch * mtl_sch_stats_sch_size(max_tasklets);
+}
+
+/**
+ * Get one scheduler entry of the stats segment.
+ *
+ * @param shm
+ *   The stats segment.
+ * @param sch_idx
+ *   The scheduler index, smaller than nb_sch.
+ * @return
+ *   The scheduler entry.
+ */
+static inline struct mtl_sch_stats_sch* mtl_sch_stats_get_sch(
+    struct mtl_sch_stats_shm* shm, uint32_t sch_idx) {
+  return (struct mtl_sch_stats_sch*)((uint8_t*)(shm + 1) +
+                                     (uint64_t)sch_idx * shm->sch_size);
+}
+
+/**
+ * Get one tasklet slot of a scheduler entry.
+ *
+ * @param sch
+ *   The scheduler entry.
+ * @param idx
+ *   The tasklet index, smaller than max_tasklets of the segment.
+ * @return
+ *   The tasklet slot.
+ */
+static inline struct mtl_sch_stats_tasklet* mtl_sch_stats_get_tasklet(
+    struct mtl_sch_stats_sch* sch, uint32_t idx) {
+  return (struct mtl_sch_stats_tasklet*)(sch + 1) + idx;
+}
+
+/**
+ * Get the bucket index of a value.
+ *
+ * @param ns
+ *   The value in ns.
+ * @return
+ *   The bucket index.
+ */
+static inline int mtl_hist_bucket(uint64_t ns) {
+  if (ns < (1ull << MTL_HIST_SUB_BITS)) return (int)ns;
+
+  int msb = 63 - __builtin_clzll(ns);
+  if (msb > MTL_HIST_MAX_BITS) return MTL_HIST_BUCKETS - 1;
+  int shift = msb - MTL_HIST_SUB_BITS;
+  return ((shift + 1) << MTL_HIST_SUB_BITS) +
+         (int)((ns >> shift) & ((1ull << MTL_HIST_SUB_BITS) - 1));
+}
+
+/**
+ * Get the lowest value of a bucket.
+ *
+ * @param idx
+ *   The bucket index.
+ * @return
+ *   The lowest value in ns.
+ */
+static inline uint64_t mtl_hist_bucket_low(int idx) {
+  if (idx < (1 << MTL_HIST_SUB_BITS)) return idx;
+
+  int shift = (idx >> MTL_HIST_SUB_BITS) - 1;
+  uint64_t sub = idx & ((1 << MTL_HIST_SUB_BITS) - 1);
+  return ((1ull << MTL_HIST_SUB_BITS) + sub) << shift;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
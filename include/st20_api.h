@@ -23,6 +23,16 @@ extern "C" {
  */
 #define ST20_FB_MAX_COUNT (8)
 
+/**
+ * Max allowed number of builder tasklets for one video(st20) tx session
+ */
+#define ST20_TX_BUILDERS_MAX (8)
+
+/**
+ * Max allowed number of video(st20) rx slots, the frames reassembled at the same time
+ */
+#define ST20_RX_SLOTS_MAX (8)
+
 /**
  * Max allowed number of video(st22) frame buffers
  */
@@ -252,6 +262,25 @@ enum st20_fmt {
   ST20_FMT_MAX,               /**< max value of this enum */
 };
 
+/**
+ * Colorimetry of st2110-20(video), the matrix used to convert between RGB and YUV
+ */
+enum st20_colorimetry {
+  ST20_COLORIMETRY_BT709 = 0, /**< ITU-R BT.709, the default */
+  ST20_COLORIMETRY_BT601,     /**< ITU-R BT.601 */
+  ST20_COLORIMETRY_BT2020,    /**< ITU-R BT.2020 non-constant luminance */
+  ST20_COLORIMETRY_MAX,       /**< max value of this enum */
+};
+
+/**
+ * Sample range of st2110-20(video) YUV, the RGB side is always full range
+ */
+enum st20_range {
+  ST20_RANGE_NARROW = 0, /**< narrow(limited), 64-940 for the 10 bit Y */
+  ST20_RANGE_FULL,       /**< full, 0-1023 for the 10 bit */
+  ST20_RANGE_MAX,        /**< max value of this enum */
+};
+
 /**
  * Session type of st2110-20(video) streaming
  */
@@ -357,6 +386,19 @@ struct st20_tx_slice_meta {
   uint16_t lines_ready;
 };
 
+/** The max number of the missing pkt ranges in st20_rx_frame_meta */
+#define ST20_RX_MISSING_RANGES_MAX (16)
+
+/**
+ * A range of the missing pkts of an incomplete st2110-20(video) rx frame.
+ */
+struct st20_rx_pkt_range {
+  /** The idx of the first missing pkt, 0 is the first pkt of the frame */
+  uint32_t start;
+  /** The number of the missing pkts */
+  uint32_t nb;
+};
+
 /**
  * Frame meta data of st2110-20(video) rx streaming
  */
@@ -400,6 +442,17 @@ struct st20_rx_frame_meta {
   const void* user_meta;
   /** size for meta data buffer */
   size_t user_meta_size;
+  /**
+   * The number of the valid items in missing_ranges, only for the incomplete frame,
+   * 0 for the complete frame.
+   */
+  uint16_t nb_missing_ranges;
+  /**
+   * The missing pkt ranges of the incomplete frame in the pkt order, for the NACK or
+   * the error concealment. Only the first ST20_RX_MISSING_RANGES_MAX ranges are
+   * reported, the frame end is estimated from the received size.
+   */
+  struct st20_rx_pkt_range missing_ranges[ST20_RX_MISSING_RANGES_MAX];
 };
 
 /**
@@ -986,6 +1039,14 @@ struct st20_tx_ops {
    * only for ST20_TYPE_FRAME_LEVEL.
    */
   uint16_t framebuff_cnt;
+  /**
+   * Optional. The number of builder tasklets for one ST20_TYPE_FRAME_LEVEL session,
+   * should be in range [0, ST20_TX_BUILDERS_MAX]. Leave to 0 or 1 to build all pkts
+   * in the session tasklet. With 2 or more, the pkts of each frame are built by the
+   * builders on other schedulers and the session tasklet only merge them in order for
+   * the pacing, this let one UHD session exceed the build capacity of one core.
+   */
+  uint16_t num_builders;
   /**
    * ST20_TYPE_FRAME_LEVEL callback when lib require a new frame.
    * User should provide the next available frame index to next_frame_idx.
@@ -1359,6 +1420,12 @@ struct st20_rx_ops {
    * Ex, cast to struct st10_vsync_meta for ST_EVENT_VSYNC.
    */
   int (*notify_event)(void* priv, enum st_event event, void* args);
+  /**
+   * the number of frames reassembled at the same time(reorder depth), for pkts out of
+   * order between frames, should be in range [0, ST20_RX_SLOTS_MAX].
+   * 0 means determined by lib. Only for ST20_TYPE_FRAME_LEVEL/ST20_TYPE_SLICE_LEVEL.
+   */
+  uint16_t slots_cnt;
 };
 
 /**
@@ -354,6 +354,38 @@ static inline int st20_rfc4175_444be10_to_yuv444p10le(
   return st20_rfc4175_444be10_to_444p10le_simd(pg, y, b, r, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_444be10 to yuv444p10le with max SIMD level and DMA helper.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be10) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param y
+ *   Point to Y(yuv444p10le) vector.
+ * @param b
+ *   Point to b(yuv444p10le) vector.
+ * @param r
+ *   Point to r(yuv444p10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_444be10_to_yuv444p10le_dma(
+    mtl_udma_handle udma, struct st20_rfc4175_444_10_pg4_be* pg_be, mtl_iova_t pg_be_iova,
+    uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w, uint32_t h) {
+  return st20_rfc4175_444be10_to_444p10le_simd_dma(udma, pg_be, pg_be_iova, y, b, r, w,
+                                                    h, MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert rfc4175_444be10 to gbrp10le with the max optimized SIMD level.
  *
@@ -379,6 +411,38 @@ static inline int st20_rfc4175_444be10_to_gbrp10le(struct st20_rfc4175_444_10_pg
   return st20_rfc4175_444be10_to_444p10le_simd(pg, g, r, b, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_444be10 to gbrp10le with max SIMD level and DMA helper.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be10) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param g
+ *   Point to g(gbrp10le) vector.
+ * @param b
+ *   Point to b(gbrp10le) vector.
+ * @param r
+ *   Point to r(gbrp10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_444be10_to_gbrp10le_dma(
+    mtl_udma_handle udma, struct st20_rfc4175_444_10_pg4_be* pg_be, mtl_iova_t pg_be_iova,
+    uint16_t* g, uint16_t* b, uint16_t* r, uint32_t w, uint32_t h) {
+  return st20_rfc4175_444be10_to_444p10le_simd_dma(udma, pg_be, pg_be_iova, g, r, b, w,
+                                                    h, MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert rfc4175_444be10 to rfc4175_444le10 with the max optimized SIMD level.
  *
@@ -400,6 +464,34 @@ static inline int st20_rfc4175_444be10_to_444le10(
   return st20_rfc4175_444be10_to_444le10_simd(pg_be, pg_le, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_444be10 to rfc4175_444le10 with max SIMD level and DMA helper.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be10) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param pg_le
+ *   Point to pg(rfc4175_444le10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_444be10_to_444le10_dma(
+    mtl_udma_handle udma, struct st20_rfc4175_444_10_pg4_be* pg_be, mtl_iova_t pg_be_iova,
+    struct st20_rfc4175_444_10_pg4_le* pg_le, uint32_t w, uint32_t h) {
+  return st20_rfc4175_444be10_to_444le10_simd_dma(udma, pg_be, pg_be_iova, pg_le, w, h,
+                                                  MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert rfc4175_444be12 to yuv444p12le with the max optimized SIMD level.
  *
@@ -425,6 +517,38 @@ static inline int st20_rfc4175_444be12_to_yuv444p12le(
   return st20_rfc4175_444be12_to_444p12le_simd(pg, y, b, r, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_444be12 to yuv444p12le with max SIMD level and DMA helper.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be12) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param y
+ *   Point to Y(yuv444p12le) vector.
+ * @param b
+ *   Point to b(yuv444p12le) vector.
+ * @param r
+ *   Point to r(yuv444p12le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_444be12_to_yuv444p12le_dma(
+    mtl_udma_handle udma, struct st20_rfc4175_444_12_pg2_be* pg_be, mtl_iova_t pg_be_iova,
+    uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w, uint32_t h) {
+  return st20_rfc4175_444be12_to_444p12le_simd_dma(udma, pg_be, pg_be_iova, y, b, r, w,
+                                                    h, MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert rfc4175_444be12 to gbrp12le with the max optimized SIMD level.
  *
@@ -450,6 +574,38 @@ static inline int st20_rfc4175_444be12_to_gbrp12le(struct st20_rfc4175_444_12_pg
   return st20_rfc4175_444be12_to_444p12le_simd(pg, g, r, b, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_444be12 to gbrp12le with max SIMD level and DMA helper.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be12) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param g
+ *   Point to g(gbrp12le) vector.
+ * @param b
+ *   Point to b(gbrp12le) vector.
+ * @param r
+ *   Point to r(gbrp12le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_444be12_to_gbrp12le_dma(
+    mtl_udma_handle udma, struct st20_rfc4175_444_12_pg2_be* pg_be, mtl_iova_t pg_be_iova,
+    uint16_t* g, uint16_t* b, uint16_t* r, uint32_t w, uint32_t h) {
+  return st20_rfc4175_444be12_to_444p12le_simd_dma(udma, pg_be, pg_be_iova, g, r, b, w,
+                                                    h, MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert rfc4175_444be12 to rfc4175_444le12 with the max optimized SIMD level.
  *
@@ -471,6 +627,195 @@ static inline int st20_rfc4175_444be12_to_444le12(
   return st20_rfc4175_444be12_to_444le12_simd(pg_be, pg_le, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_444be12 to rfc4175_444le12 with max SIMD level and DMA helper.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be12) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param pg_le
+ *   Point to pg(rfc4175_444le12) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_444be12_to_444le12_dma(
+    mtl_udma_handle udma, struct st20_rfc4175_444_12_pg2_be* pg_be, mtl_iova_t pg_be_iova,
+    struct st20_rfc4175_444_12_pg2_le* pg_le, uint32_t w, uint32_t h) {
+  return st20_rfc4175_444be12_to_444le12_simd_dma(udma, pg_be, pg_be_iova, pg_le, w, h,
+                                                  MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rfc4175_422be10 to yuv420p10le with the max optimized SIMD level.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(yuv420p10le) vector.
+ * @param b
+ *   Point to b(yuv420p10le) vector.
+ * @param r
+ *   Point to r(yuv420p10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_yuv420p10le(
+    struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y, uint16_t* b, uint16_t* r,
+    uint32_t w, uint32_t h) {
+  return st20_rfc4175_422be10_to_yuv420p10le_simd(pg, y, b, r, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rfc4175_422be10 to yuv420p8 with the max optimized SIMD level.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(yuv420p8) vector.
+ * @param b
+ *   Point to b(yuv420p8) vector.
+ * @param r
+ *   Point to r(yuv420p8) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_yuv420p8(struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint8_t* y, uint8_t* b, uint8_t* r,
+                                                   uint32_t w, uint32_t h) {
+  return st20_rfc4175_422be10_to_yuv420p8_simd(pg, y, b, r, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rfc4175_422be10 to nv12 with the max optimized SIMD level.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(nv12) vector.
+ * @param uv
+ *   Point to interleaved UV(nv12) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_nv12(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint8_t* y, uint8_t* uv, uint32_t w,
+                                               uint32_t h) {
+  return st20_rfc4175_422be10_to_nv12_simd(pg, y, uv, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rfc4175_422be10 to p010 with the max optimized SIMD level.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(p010) vector.
+ * @param uv
+ *   Point to interleaved UV(p010) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_p010(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint16_t* y, uint16_t* uv, uint32_t w,
+                                               uint32_t h) {
+  return st20_rfc4175_422be10_to_p010_simd(pg, y, uv, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rfc4175_422be10 to gbrp10le with the max optimized SIMD level.
+ * The chroma of the odd pixels is interpolated from the two neighbor pixels.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param g
+ *   Point to g(gbrp10le) vector.
+ * @param b
+ *   Point to b(gbrp10le) vector.
+ * @param r
+ *   Point to r(gbrp10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_gbrp10le(struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint16_t* g, uint16_t* b, uint16_t* r,
+                                                   uint32_t w, uint32_t h,
+                                                   enum st20_colorimetry colorimetry,
+                                                   enum st20_range range) {
+  return st20_rfc4175_422be10_to_gbrp10le_simd(pg, g, b, r, w, h, colorimetry, range,
+                                               MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rfc4175_422be10 to rgb8 with the max optimized SIMD level.
+ * The chroma of the odd pixels is interpolated from the two neighbor pixels.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param rgb
+ *   Point to packed rgb(rgb8) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_rgb8(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint8_t* rgb, uint32_t w, uint32_t h,
+                                               enum st20_colorimetry colorimetry,
+                                               enum st20_range range) {
+  return st20_rfc4175_422be10_to_rgb8_simd(pg, rgb, w, h, colorimetry, range,
+                                           MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert yuv422p10le to rfc4175_422be10.
  *
@@ -859,6 +1204,34 @@ static inline int st20_rfc4175_422le12_to_422be12(
   return st20_rfc4175_422le12_to_422be12_simd(pg_le, pg_be, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_422le12 to rfc4175_422be12 with max SIMD level and DMA helper.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_le
+ *   Point to pg(rfc4175_422le12) data.
+ * @param pg_le_iova
+ *   The mtl_iova_t address of the pg_le buffer.
+ * @param pg_be
+ *   Point to pg(rfc4175_422be12) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422le12_to_422be12_dma(
+    mtl_udma_handle udma, struct st20_rfc4175_422_12_pg2_le* pg_le, mtl_iova_t pg_le_iova,
+    struct st20_rfc4175_422_12_pg2_be* pg_be, uint32_t w, uint32_t h) {
+  return st20_rfc4175_422le12_to_422be12_simd_dma(udma, pg_le, pg_le_iova, pg_be, w, h,
+                                                  MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert yuv422p12le to rfc4175_422le12.
  *
@@ -1247,6 +1620,168 @@ static inline int st20_rfc4175_444le12_to_gbrp12le(struct st20_rfc4175_444_12_pg
   return st20_rfc4175_444le12_to_444p12le(pg, g, r, b, w, h);
 }
 
+/**
+ * Convert yuv420p10le to rfc4175_422be10 with the max optimized SIMD level.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(yuv420p10le) vector.
+ * @param b
+ *   Point to b(yuv420p10le) vector.
+ * @param r
+ *   Point to r(yuv420p10le) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_yuv420p10le_to_rfc4175_422be10(
+    uint16_t* y, uint16_t* b, uint16_t* r, struct st20_rfc4175_422_10_pg2_be* pg,
+    uint32_t w, uint32_t h) {
+  return st20_yuv420p10le_to_rfc4175_422be10_simd(y, b, r, pg, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert yuv420p8 to rfc4175_422be10 with the max optimized SIMD level.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(yuv420p8) vector.
+ * @param b
+ *   Point to b(yuv420p8) vector.
+ * @param r
+ *   Point to r(yuv420p8) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_yuv420p8_to_rfc4175_422be10(uint8_t* y, uint8_t* b, uint8_t* r,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint32_t w, uint32_t h) {
+  return st20_yuv420p8_to_rfc4175_422be10_simd(y, b, r, pg, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert nv12 to rfc4175_422be10 with the max optimized SIMD level.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(nv12) vector.
+ * @param uv
+ *   Point to interleaved UV(nv12) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_nv12_to_rfc4175_422be10(uint8_t* y, uint8_t* uv,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h) {
+  return st20_nv12_to_rfc4175_422be10_simd(y, uv, pg, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert p010 to rfc4175_422be10 with the max optimized SIMD level.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(p010) vector.
+ * @param uv
+ *   Point to interleaved UV(p010) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_p010_to_rfc4175_422be10(uint16_t* y, uint16_t* uv,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h) {
+  return st20_p010_to_rfc4175_422be10_simd(y, uv, pg, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert gbrp10le to rfc4175_422be10 with the max optimized SIMD level.
+ * The chroma of the 444 RGB is low passed by a [1 2 1] filter to the co-sited 422.
+ *
+ * @param g
+ *   Point to g(gbrp10le) vector.
+ * @param b
+ *   Point to b(gbrp10le) vector.
+ * @param r
+ *   Point to r(gbrp10le) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_gbrp10le_to_rfc4175_422be10(uint16_t* g, uint16_t* b, uint16_t* r,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint32_t w, uint32_t h,
+                                                   enum st20_colorimetry colorimetry,
+                                                   enum st20_range range) {
+  return st20_gbrp10le_to_rfc4175_422be10_simd(g, b, r, pg, w, h, colorimetry, range,
+                                               MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rgb8 to rfc4175_422be10 with the max optimized SIMD level.
+ * The chroma of the 444 RGB is low passed by a [1 2 1] filter to the co-sited 422.
+ *
+ * @param rgb
+ *   Point to packed rgb(rgb8) data.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rgb8_to_rfc4175_422be10(uint8_t* rgb,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h,
+                                               enum st20_colorimetry colorimetry,
+                                               enum st20_range range) {
+  return st20_rgb8_to_rfc4175_422be10_simd(rgb, pg, w, h, colorimetry, range,
+                                           MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert AM824 subframe to AES3 subframe.
  *
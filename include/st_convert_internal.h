@@ -20,6 +20,8 @@
 extern "C" {
 #endif
 
+struct st_frame;
+
 /**
  * Convert rfc4175_422be10 to yuv422p10le with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -382,6 +384,41 @@ int st20_rfc4175_444be10_to_444p10le_simd(struct st20_rfc4175_444_10_pg4_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level);
 
+/**
+ * Convert rfc4175_444be10 to yuv444p10le/gbrp10le with required SIMD level and DMA
+ * helper.
+ * Note the level may downgrade to the SIMD which system really support.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be10) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param y_g
+ *   Point to Y(yuv444p10le) or g(gbrp10le) vector.
+ * @param b_r
+ *   Point to b(yuv444p10le) or r(gbrp10le) vector.
+ * @param r_b
+ *   Point to r(yuv444p10le) or b(gbrp10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_444be10_to_444p10le_simd_dma(mtl_udma_handle udma,
+                                              struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                              mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                              uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                              uint32_t h, enum mtl_simd_level level);
+
 /**
  * Convert rfc4175_444be10 to rfc4175_444le10 with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -405,6 +442,37 @@ int st20_rfc4175_444be10_to_444le10_simd(struct st20_rfc4175_444_10_pg4_be* pg_b
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level);
 
+/**
+ * Convert rfc4175_444be10 to rfc4175_444le10 with required SIMD level and DMA helper.
+ * Note the level may downgrade to the SIMD which system really support.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be10) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param pg_le
+ *   Point to pg(rfc4175_444le10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_444be10_to_444le10_simd_dma(mtl_udma_handle udma,
+                                             struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                             mtl_iova_t pg_be_iova,
+                                             struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level);
+
 /**
  * Convert rfc4175_444be12 to yuv444p12le/gbrp12le with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -432,6 +500,41 @@ int st20_rfc4175_444be12_to_444p12le_simd(struct st20_rfc4175_444_12_pg2_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level);
 
+/**
+ * Convert rfc4175_444be12 to yuv444p12le/gbrp12le with required SIMD level and DMA
+ * helper.
+ * Note the level may downgrade to the SIMD which system really support.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be12) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param y_g
+ *   Point to Y(yuv444p12le) or g(gbrp12le) vector.
+ * @param b_r
+ *   Point to b(yuv444p12le) or r(gbrp12le) vector.
+ * @param r_b
+ *   Point to r(yuv444p12le) or b(gbrp12le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_444be12_to_444p12le_simd_dma(mtl_udma_handle udma,
+                                              struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                              mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                              uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                              uint32_t h, enum mtl_simd_level level);
+
 /**
  * Convert rfc4175_444be12 to rfc4175_444le12 with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -455,6 +558,37 @@ int st20_rfc4175_444be12_to_444le12_simd(struct st20_rfc4175_444_12_pg2_be* pg_b
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level);
 
+/**
+ * Convert rfc4175_444be12 to rfc4175_444le12 with required SIMD level and DMA helper.
+ * Note the level may downgrade to the SIMD which system really support.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_be
+ *   Point to pg(rfc4175_444be12) data.
+ * @param pg_be_iova
+ *   The mtl_iova_t address of the pg_be buffer.
+ * @param pg_le
+ *   Point to pg(rfc4175_444le12) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_444be12_to_444le12_simd_dma(mtl_udma_handle udma,
+                                             struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                             mtl_iova_t pg_be_iova,
+                                             struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level);
+
 /**
  * Convert yuv422p10le to rfc4175_422be10 with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -848,6 +982,37 @@ int st20_rfc4175_422le12_to_422be12_simd(struct st20_rfc4175_422_12_pg2_le* pg_l
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level);
 
+/**
+ * Convert rfc4175_422le12 to rfc4175_422be12 with required SIMD level and DMA helper.
+ * Note the level may downgrade to the SIMD which system really support.
+ * Profiling shows gain with 4k/8k solution due to LLC cache miss migration, thus pls
+ * only applied with 4k/8k.
+ *
+ * @param udma
+ *   Point to dma engine.
+ * @param pg_le
+ *   Point to pg(rfc4175_422le12) data.
+ * @param pg_le_iova
+ *   The mtl_iova_t address of the pg_le buffer.
+ * @param pg_be
+ *   Point to pg(rfc4175_422be12) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422le12_to_422be12_simd_dma(mtl_udma_handle udma,
+                                             struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                             mtl_iova_t pg_le_iova,
+                                             struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level);
+
 /**
  * Convert rfc4175_444le10 to rfc4175_444be10 with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -984,6 +1149,358 @@ int st20_rfc4175_444le12_to_444p12le(struct st20_rfc4175_444_12_pg2_le* pg, uint
                                      uint16_t* b_r, uint16_t* r_b, uint32_t w,
                                      uint32_t h);
 
+/**
+ * Convert rfc4175_422be10 to yuv420p10le with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(yuv420p10le) vector.
+ * @param b
+ *   Point to b(yuv420p10le) vector.
+ * @param r
+ *   Point to r(yuv420p10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_yuv420p10le_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level);
+
+/**
+ * Convert yuv420p10le to rfc4175_422be10 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(yuv420p10le) vector.
+ * @param b
+ *   Point to b(yuv420p10le) vector.
+ * @param r
+ *   Point to r(yuv420p10le) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_yuv420p10le_to_rfc4175_422be10_simd(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level);
+
+/**
+ * Convert rfc4175_422be10 to yuv420p8 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(yuv420p8) vector.
+ * @param b
+ *   Point to b(yuv420p8) vector.
+ * @param r
+ *   Point to r(yuv420p8) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_yuv420p8_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint8_t* y, uint8_t* b, uint8_t* r, uint32_t w,
+                                          uint32_t h, enum mtl_simd_level level);
+
+/**
+ * Convert yuv420p8 to rfc4175_422be10 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(yuv420p8) vector.
+ * @param b
+ *   Point to b(yuv420p8) vector.
+ * @param r
+ *   Point to r(yuv420p8) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_yuv420p8_to_rfc4175_422be10_simd(uint8_t* y, uint8_t* b, uint8_t* r,
+                                          struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint32_t w, uint32_t h,
+                                          enum mtl_simd_level level);
+
+/**
+ * Convert rfc4175_422be10 to nv12 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(nv12) vector.
+ * @param uv
+ *   Point to interleaved UV(nv12) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_nv12_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* y,
+                                      uint8_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level);
+
+/**
+ * Convert nv12 to rfc4175_422be10 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(nv12) vector.
+ * @param uv
+ *   Point to interleaved UV(nv12) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_nv12_to_rfc4175_422be10_simd(uint8_t* y, uint8_t* uv,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level);
+
+/**
+ * Convert rfc4175_422be10 to p010 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of each two lines is averaged vertically to one 420 chroma line.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(p010) vector.
+ * @param uv
+ *   Point to interleaved UV(p010) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_p010_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y,
+                                      uint16_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level);
+
+/**
+ * Convert p010 to rfc4175_422be10 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The 420 chroma line is duplicated to the two 422 lines it covers.
+ *
+ * @param y
+ *   Point to Y(p010) vector.
+ * @param uv
+ *   Point to interleaved UV(p010) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, must be even.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_p010_to_rfc4175_422be10_simd(uint16_t* y, uint16_t* uv,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level);
+
+/**
+ * Convert gbrp10le to rfc4175_422be10 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of the 444 RGB is low passed by a [1 2 1] filter to the co-sited 422.
+ *
+ * @param g
+ *   Point to g(gbrp10le) vector.
+ * @param b
+ *   Point to b(gbrp10le) vector.
+ * @param r
+ *   Point to r(gbrp10le) vector.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_gbrp10le_to_rfc4175_422be10_simd(uint16_t* g, uint16_t* b, uint16_t* r,
+                                          struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint32_t w, uint32_t h,
+                                          enum st20_colorimetry colorimetry,
+                                          enum st20_range range,
+                                          enum mtl_simd_level level);
+
+/**
+ * Convert rgb8 to rfc4175_422be10 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of the 444 RGB is low passed by a [1 2 1] filter to the co-sited 422.
+ *
+ * @param rgb
+ *   Point to packed rgb(rgb8) data.
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rgb8_to_rfc4175_422be10_simd(uint8_t* rgb, struct st20_rfc4175_422_10_pg2_be* pg,
+                                      uint32_t w, uint32_t h,
+                                      enum st20_colorimetry colorimetry,
+                                      enum st20_range range, enum mtl_simd_level level);
+
+/**
+ * Convert rfc4175_422be10 to gbrp10le with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of the odd pixels is interpolated from the two neighbor pixels.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param g
+ *   Point to g(gbrp10le) vector.
+ * @param b
+ *   Point to b(gbrp10le) vector.
+ * @param r
+ *   Point to r(gbrp10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_gbrp10le_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint16_t* g, uint16_t* b, uint16_t* r,
+                                          uint32_t w, uint32_t h,
+                                          enum st20_colorimetry colorimetry,
+                                          enum st20_range range,
+                                          enum mtl_simd_level level);
+
+/**
+ * Convert rfc4175_422be10 to rgb8 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ * The chroma of the odd pixels is interpolated from the two neighbor pixels.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param rgb
+ *   Point to packed rgb(rgb8) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param colorimetry
+ *   The colorimetry(matrix) of the YUV.
+ * @param range
+ *   The sample range of the YUV.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_rgb8_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h,
+                                      enum st20_colorimetry colorimetry,
+                                      enum st20_range range, enum mtl_simd_level level);
+
+/**
+ * Scale the source frame to the size of destination frame with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ *
+ * @param src
+ *   The source frame.
+ * @param dst
+ *   The destination frame.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st_frame_scale_simd(struct st_frame* src, struct st_frame* dst,
+                        enum mtl_simd_level level);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -146,6 +146,20 @@ enum st_frame_fmt {
    * transport frame without conversion. The frame should not have lines padding.
    */
   ST_FRAME_FMT_YUV422CUSTOM8 = 13,
+  /**
+   * YUV 420 semi-planar 8bit(aka NV12), one Y plane and one interleaved UV plane with
+   * half lines of the Y plane.
+   */
+  ST_FRAME_FMT_NV12 = 14,
+  /**
+   * YUV 420 semi-planar 10bit(aka P010), 16 bits little endian per sample with least
+   * significant 6 paddings, one Y plane and one interleaved UV plane with half lines.
+   */
+  ST_FRAME_FMT_P010 = 15,
+  /** YUV 420 planar 8bit(aka I420), the U and V planes have half lines */
+  ST_FRAME_FMT_YUV420PLANAR8 = 16,
+  /** YUV 420 planar 10bit little endian(aka I420-10), the U/V planes have half lines */
+  ST_FRAME_FMT_YUV420PLANAR10LE = 17,
   /** End of yuv format list, new yuv should be inserted before this */
   ST_FRAME_FMT_YUV_END,
 
@@ -198,6 +212,14 @@ enum st_frame_fmt {
 #define ST_FMT_CAP_UYVY (MTL_BIT64(ST_FRAME_FMT_UYVY))
 /** ST format cap of ST_FRAME_FMT_YUV422RFC4175PG2BE10 */
 #define ST_FMT_CAP_YUV422RFC4175PG2BE10 (MTL_BIT64(ST_FRAME_FMT_YUV422RFC4175PG2BE10))
+/** ST format cap of ST_FRAME_FMT_NV12 */
+#define ST_FMT_CAP_NV12 (MTL_BIT64(ST_FRAME_FMT_NV12))
+/** ST format cap of ST_FRAME_FMT_P010 */
+#define ST_FMT_CAP_P010 (MTL_BIT64(ST_FRAME_FMT_P010))
+/** ST format cap of ST_FRAME_FMT_YUV420PLANAR8 */
+#define ST_FMT_CAP_YUV420PLANAR8 (MTL_BIT64(ST_FRAME_FMT_YUV420PLANAR8))
+/** ST format cap of ST_FRAME_FMT_YUV420PLANAR10LE */
+#define ST_FMT_CAP_YUV420PLANAR10LE (MTL_BIT64(ST_FRAME_FMT_YUV420PLANAR10LE))
 
 /** ST format cap of ST_FRAME_FMT_ARGB */
 #define ST_FMT_CAP_ARGB (MTL_BIT64(ST_FRAME_FMT_ARGB))
@@ -284,6 +306,10 @@ struct st_frame {
   void* priv;
   /** priv data for user */
   void* opaque;
+  /** colorimetry of the yuv frame, the matrix for the RGB <-> YUV convert */
+  enum st20_colorimetry colorimetry;
+  /** sample range of the yuv frame, for the RGB <-> YUV convert */
+  enum st20_range range;
 };
 
 /** Device type of st plugin */
@@ -361,6 +387,11 @@ enum st22_quality_mode {
  * If enable the rtcp.
  */
 #define ST22P_TX_FLAG_ENABLE_RTCP (MTL_BIT32(6))
+/**
+ * Flag bit in flags of struct st22p_tx_ops.
+ * Try to request a dma dev for the frame copy of st22p_tx_put_frame_copy.
+ */
+#define ST22P_TX_FLAG_DMA_OFFLOAD (MTL_BIT32(7))
 
 /**
  * Flag bit in flags of struct st20p_tx_ops.
@@ -406,6 +437,11 @@ enum st22_quality_mode {
  * If enable the rtcp.
  */
 #define ST20P_TX_FLAG_ENABLE_RTCP (MTL_BIT32(7))
+/**
+ * Flag bit in flags of struct st20p_tx_ops.
+ * Try to request a dma dev for the frame copy of st20p_tx_put_frame_copy.
+ */
+#define ST20P_TX_FLAG_DMA_OFFLOAD (MTL_BIT32(8))
 
 /**
  * Flag bit in flags of struct st22p_rx_ops, for non MTL_PMD_DPDK_USER.
@@ -740,6 +776,13 @@ struct st20p_tx_ops {
    * Ex, cast to struct st10_vsync_meta for ST_EVENT_VSYNC.
    */
   int (*notify_event)(void* priv, enum st_event event, void* args);
+  /**
+   * Session colorimetry, the matrix used when the input_fmt is RGB and the
+   * transport_fmt is YUV. Leave to zero(BT709) if not know detail.
+   */
+  enum st20_colorimetry colorimetry;
+  /** Session YUV sample range, used with the colorimetry */
+  enum st20_range range;
 };
 
 /** The structure describing how to create a rx st2110-20 pipeline session. */
@@ -797,6 +840,21 @@ struct st20p_rx_ops {
    * Ex, cast to struct st10_vsync_meta for ST_EVENT_VSYNC.
    */
   int (*notify_event)(void* priv, enum st_event event, void* args);
+  /**
+   * Session colorimetry, the matrix used when the transport_fmt is YUV and the
+   * output_fmt is RGB. Leave to zero(BT709) if not know detail.
+   */
+  enum st20_colorimetry colorimetry;
+  /** Session YUV sample range, used with the colorimetry */
+  enum st20_range range;
+  /**
+   * Output frame width, leave to zero to use the session width. The frame is scaled
+   * by the internal converter if the output size is not same as the session size, see
+   * st_frame_scale for the supported transport formats.
+   */
+  uint32_t output_width;
+  /** Output frame height, leave to zero to use the session height */
+  uint32_t output_height;
 };
 
 /** The structure describing how to create a tx st2110-22 pipeline session. */
@@ -1159,6 +1217,29 @@ struct st_frame* st22p_tx_get_frame(st22p_tx_handle handle);
  */
 int st22p_tx_put_frame(st22p_tx_handle handle, struct st_frame* frame);
 
+/**
+ * Copy the user frame to the frame which get by st22p_tx_get_frame and put it back to
+ * the tx st2110-22 pipeline session.
+ * With ST22P_TX_FLAG_DMA_OFFLOAD the copy is done by the dma dev asynchronously, the
+ * frame is passed to the encoder only after the copy completes. The dma completion is
+ * polled by the transport tasklet and also in st22p_tx_get_frame and
+ * st22p_tx_put_frame_copy, st22p_tx_get_frame never waits for the copying frames.
+ * The src frame should be kept until the notify_frame_done of this frame.
+ *
+ * @param handle
+ *   The handle to the tx st2110-22 pipeline session.
+ * @param frame
+ *   the frame pointer by st22p_tx_get_frame.
+ * @param src
+ *   The pointer to the structure describing the user frame, the iova is required for
+ *   the dma copy.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st22p_tx_put_frame_copy(st22p_tx_handle handle, struct st_frame* frame,
+                            struct st_ext_frame* src);
+
 /**
  * Get the framebuffer pointer from the tx st2110-22 pipeline session.
  *
@@ -1356,6 +1437,31 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame);
 int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
                            struct st_ext_frame* ext_frame);
 
+/**
+ * Copy the user frame to the frame which get by st20p_tx_get_frame and put it back to
+ * the tx st2110-20 pipeline session, not for ST20P_TX_FLAG_EXT_FRAME.
+ * With ST20P_TX_FLAG_DMA_OFFLOAD the copy is done by the dma dev asynchronously, the
+ * frame is passed to the converter or the transmitter only after the copy completes.
+ * The dma completion is polled by the transport tasklet and also in st20p_tx_get_frame
+ * and st20p_tx_put_frame_copy, st20p_tx_get_frame never waits for the copying frames.
+ * With an internal convert the tasklet wakes up the user by notify_frame_available to
+ * pass the copied frames. The src frame should be kept until the notify_frame_done of
+ * this frame.
+ *
+ * @param handle
+ *   The handle to the tx st2110-20 pipeline session.
+ * @param frame
+ *   The frame pointer by st20p_tx_get_frame.
+ * @param src
+ *   The pointer to the structure describing the user frame, the iova is required for
+ *   the dma copy.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st20p_tx_put_frame_copy(st20p_tx_handle handle, struct st_frame* frame,
+                            struct st_ext_frame* src);
+
 /**
  * Get the framebuffer pointer from the tx st2110-20 pipeline session.
  *
@@ -1583,6 +1689,8 @@ int st20p_rx_reset_port_stats(st20p_rx_handle handle, enum mtl_session_port port
 
 /**
  * Convert color format from source frame to destination frame.
+ * For the RGB <-> YUV convert, the colorimetry and range of the YUV frame select the
+ * matrix.
  *
  * @param src
  *   The source frame.
@@ -1594,6 +1702,26 @@ int st20p_rx_reset_port_stats(st20p_rx_handle handle, enum mtl_session_port port
  */
 int st_frame_convert(struct st_frame* src, struct st_frame* dst);
 
+/**
+ * Convert color format from source frame to destination frame, the frame is split
+ * into horizontal slices which convert in parallel on the lib convert pool, see
+ * cvt_threads in struct mtl_init_params.
+ * Fall back to the caller thread if the pool is disabled or the format can't split.
+ * Thread safe, the concurrent callers share the pool workers and each caller
+ * converts the slices of its own frame too.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param src
+ *   The source frame.
+ * @param dst
+ *   The destination frame.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_frame_convert_parallel(mtl_handle mt, struct st_frame* src, struct st_frame* dst);
+
 /**
  * Downsample frame size to destination frame.
  *
@@ -1609,6 +1737,23 @@ int st_frame_convert(struct st_frame* src, struct st_frame* dst);
  */
 int st_frame_downsample(struct st_frame* src, struct st_frame* dst, int idx);
 
+/**
+ * Scale the source frame to the size of destination frame, both frames should be the
+ * same format. The area filter is used for downscale and bilinear for upscale, the max
+ * downscale ratio is 16 for each direction.
+ * Supported formats: the yuv422/yuv444/gbr/yuv420 planar formats and the
+ * ST_FRAME_FMT_YUV422RFC4175PG2BE10.
+ *
+ * @param src
+ *   The source frame.
+ * @param dst
+ *   The destination frame.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_frame_scale(struct st_frame* src, struct st_frame* dst);
+
 /**
  * Calculate the least linesize per the format, w, plane
  *
@@ -1624,6 +1769,21 @@ int st_frame_downsample(struct st_frame* src, struct st_frame* dst, int idx);
  */
 size_t st_frame_least_linesize(enum st_frame_fmt fmt, uint32_t width, uint8_t plane);
 
+/**
+ * Calculate the lines of one plane per the format, height, plane, the chroma planes
+ * of the 420 planar and semi-planar formats have half lines.
+ *
+ * @param fmt
+ *   format.
+ * @param height
+ *   height.
+ * @param plane
+ *   plane index.
+ * @return
+ *   The lines of the plane.
+ */
+uint32_t st_frame_plane_height(enum st_frame_fmt fmt, uint32_t height, uint8_t plane);
+
 /**
  * Calculate the frame size per the format, w and h
  *
@@ -1749,7 +1909,7 @@ int st_draw_logo(struct st_frame* frame, struct st_frame* logo, uint32_t x, uint
  *   size
  */
 static inline size_t st_frame_plane_size(struct st_frame* frame, uint8_t plane) {
-  return frame->linesize[plane] * frame->height;
+  return frame->linesize[plane] * st_frame_plane_height(frame->fmt, frame->height, plane);
 }
 
 #if defined(__cplusplus)
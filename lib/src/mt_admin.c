@@ -83,6 +83,29 @@ static int admin_clear_cpu_busy(struct mtl_main_impl* impl) {
   return 0;
 }
 
+/* the builders stop requested by the fatal error in the sch thread */
+static int admin_tx_video_stop_builders(struct mtl_main_impl* impl) {
+  struct mt_sch_impl* sch;
+  struct st_tx_video_sessions_mgr* tx_mgr;
+  struct st_tx_video_session_impl* tx_s;
+
+  for (int sch_idx = 0; sch_idx < MT_MAX_SCH_NUM; sch_idx++) {
+    sch = mt_sch_instance(impl, sch_idx);
+    if (!mt_sch_started(sch)) continue;
+
+    tx_mgr = &sch->tx_video_mgr;
+    for (int j = 0; j < tx_mgr->max_idx; j++) {
+      tx_s = tx_video_session_get(tx_mgr, j);
+      if (tx_s) {
+        if (tx_s->builders_stop_pending) tx_video_session_stop_builders(impl, tx_s);
+        tx_video_session_put(tx_mgr, j);
+      }
+    }
+  }
+
+  return 0;
+}
+
 static inline int tx_video_quota_mbs(struct st_tx_video_session_impl* s) {
   if (s->st22_handle)
     return s->st22_handle->quota_mbs;
@@ -334,6 +357,7 @@ static int admin_func(struct mtl_main_impl* impl) {
   dbg("%s, start\n", __func__);
 
   admin_cal_cpu_busy(impl);
+  admin_tx_video_stop_builders(impl);
 
   bool migrated = false;
   /* only one migrate(both tx and rx) for this period */
@@ -346,6 +370,8 @@ static int admin_func(struct mtl_main_impl* impl) {
 
   if (migrated) admin_clear_cpu_busy(impl);
 
+  if (mt_has_tasklet_balance(impl)) mt_sch_balance(impl);
+
   rte_eal_alarm_set(admin->period_us, admin_alarm_handler, impl);
 
   return 0;
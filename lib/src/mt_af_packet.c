@@ -0,0 +1,636 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+#include "mt_af_packet.h"
+
+#include "mt_log.h"
+#include "mt_socket.h"
+#include "mt_util.h"
+
+#ifndef WINDOWSENV
+#include <linux/ethtool.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/sockios.h>
+
+struct mt_afpkt_rxq {
+  struct mt_afpkt_impl* parent;
+  uint16_t queue_id;
+  int fd;
+  /* the PACKET_RX_RING mmap, MT_AF_PACKET_BLOCK_NR blocks */
+  uint8_t* ring;
+  size_t ring_size;
+  uint32_t block_idx; /* the block to read */
+  /* the next frame in the user owned block, NULL if no block in progress */
+  struct tpacket3_hdr* frame;
+  uint32_t frame_left;
+  struct rte_mempool* mbuf_pool;
+  /* stat, monotonic */
+  uint64_t stat_pkts;
+  uint64_t stat_bytes;
+  uint64_t stat_errors;
+  uint64_t stat_nombuf;
+  uint64_t stat_drops; /* the kernel drops as the ring is full */
+};
+
+struct mt_afpkt_txq {
+  struct mt_afpkt_impl* parent;
+  uint16_t queue_id;
+  int fd;
+  struct mmsghdr msgs[MT_AF_PACKET_TX_BURST];
+  struct sockaddr_ll addrs[MT_AF_PACKET_TX_BURST];
+  struct iovec iovs[MT_AF_PACKET_TX_BURST][MT_AF_PACKET_TX_SEGS_MAX];
+  /* stat, monotonic */
+  uint64_t stat_pkts;
+  uint64_t stat_bytes;
+  uint64_t stat_errors;
+};
+
+struct mt_afpkt_impl {
+  struct mtl_main_impl* parent;
+  enum mtl_port port;
+  char if_name[IF_NAMESIZE];
+  int if_index;
+  struct rte_ether_addr mac;
+  int fanout_id; /* -1 until the first rx socket join the group */
+
+  struct mt_afpkt_rxq* rxqs;
+  uint16_t nb_rxq;
+  struct mt_afpkt_txq* txqs;
+  uint16_t nb_txq;
+};
+
+static inline struct tpacket_block_desc* afpkt_block(struct mt_afpkt_rxq* rxq,
+                                                     uint32_t idx) {
+  return (struct tpacket_block_desc*)(rxq->ring + (size_t)idx * MT_AF_PACKET_BLOCK_SIZE);
+}
+
+uint16_t mt_afpkt_rx_burst(struct mt_afpkt_rxq* rxq, struct rte_mbuf** rx_pkts,
+                           uint16_t nb_pkts) {
+  struct tpacket_block_desc* bd;
+  struct tpacket3_hdr* hdr;
+  struct sockaddr_ll* sll;
+  struct rte_mbuf* pkt;
+  uint16_t nb_rx = 0;
+  uint32_t len;
+
+  while (nb_rx < nb_pkts) {
+    bd = afpkt_block(rxq, rxq->block_idx);
+    if (!rxq->frame) { /* start a new block */
+      if (!(bd->hdr.bh1.block_status & TP_STATUS_USER)) break;
+      rte_smp_rmb(); /* read the block after the kernel hand it over */
+      rxq->frame =
+          (struct tpacket3_hdr*)((uint8_t*)bd + bd->hdr.bh1.offset_to_first_pkt);
+      rxq->frame_left = bd->hdr.bh1.num_pkts;
+    }
+
+    while (rxq->frame_left && (nb_rx < nb_pkts)) {
+      hdr = rxq->frame;
+      sll = (struct sockaddr_ll*)((uint8_t*)hdr + TPACKET_ALIGN(sizeof(*hdr)));
+      len = hdr->tp_snaplen;
+      if (unlikely(sll->sll_pkttype == PACKET_OUTGOING)) {
+        /* our own tx when PACKET_IGNORE_OUTGOING is not supported */
+      } else if (unlikely(len != hdr->tp_len)) {
+        rxq->stat_errors++; /* truncated as bigger than the frame */
+      } else {
+        pkt = rte_pktmbuf_alloc(rxq->mbuf_pool);
+        /* keep the ring position, retry this frame in the next burst */
+        if (unlikely(!pkt)) {
+          rxq->stat_nombuf++;
+          return nb_rx;
+        }
+        if (unlikely(len > rte_pktmbuf_tailroom(pkt))) {
+          rte_pktmbuf_free(pkt);
+          rxq->stat_errors++;
+        } else {
+          rte_memcpy(rte_pktmbuf_mtod(pkt, void*), (uint8_t*)hdr + hdr->tp_mac, len);
+          pkt->data_len = len;
+          pkt->pkt_len = len;
+          rx_pkts[nb_rx++] = pkt;
+          rxq->stat_pkts++;
+          rxq->stat_bytes += len;
+        }
+      }
+      rxq->frame = (struct tpacket3_hdr*)((uint8_t*)hdr + hdr->tp_next_offset);
+      rxq->frame_left--;
+    }
+    if (rxq->frame_left) break; /* burst full, continue this block next time */
+
+    /* all frames consumed, give the block back to the kernel */
+    rte_smp_mb();
+    bd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+    rxq->frame = NULL;
+    rxq->block_idx = (rxq->block_idx + 1) % MT_AF_PACKET_BLOCK_NR;
+  }
+
+  return nb_rx;
+}
+
+uint16_t mt_afpkt_tx_burst(struct mt_afpkt_txq* txq, struct rte_mbuf** tx_pkts,
+                           uint16_t nb_pkts) {
+  struct rte_mbuf *pkt, *seg;
+  struct msghdr* msg;
+  uint16_t nb = RTE_MIN(nb_pkts, MT_AF_PACKET_TX_BURST);
+  uint16_t n;
+  int ret;
+
+  if (unlikely(!nb)) return 0;
+
+  /* one iovec per segment, the kernel copy the chained mbuf directly */
+  for (n = 0; n < nb; n++) {
+    pkt = tx_pkts[n];
+    if (unlikely(pkt->nb_segs > MT_AF_PACKET_TX_SEGS_MAX)) break;
+
+    msg = &txq->msgs[n].msg_hdr;
+    seg = pkt;
+    for (uint16_t s = 0; s < pkt->nb_segs; s++) {
+      txq->iovs[n][s].iov_base = rte_pktmbuf_mtod(seg, void*);
+      txq->iovs[n][s].iov_len = seg->data_len;
+      seg = seg->next;
+    }
+    msg->msg_iovlen = pkt->nb_segs;
+    txq->addrs[n].sll_protocol = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr*)->ether_type;
+  }
+  if (unlikely(!n)) { /* too many segments, drop it */
+    err("%s(%u), drop pkt with %u segs\n", __func__, txq->queue_id, tx_pkts[0]->nb_segs);
+    rte_pktmbuf_free(tx_pkts[0]);
+    txq->stat_errors++;
+    return 1;
+  }
+
+  ret = sendmmsg(txq->fd, txq->msgs, n, MSG_DONTWAIT);
+  if (ret < 0) {
+    /* the socket buffer or the device queue is full, the caller retry */
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS)) return 0;
+    /* the kernel refuse the first pkt, drop it to not block the queue */
+    dbg("%s(%u), sendmmsg fail %d\n", __func__, txq->queue_id, errno);
+    rte_pktmbuf_free(tx_pkts[0]);
+    txq->stat_errors++;
+    return 1;
+  }
+
+  for (int i = 0; i < ret; i++) txq->stat_bytes += tx_pkts[i]->pkt_len;
+  txq->stat_pkts += ret;
+  rte_pktmbuf_free_bulk(tx_pkts, ret);
+  return ret;
+}
+
+static int afpkt_fanout_join(struct mt_afpkt_impl* afpkt, struct mt_afpkt_rxq* rxq) {
+  int fd = rxq->fd;
+  int arg, ret;
+
+  if (afpkt->fanout_id < 0) { /* the first socket create the group */
+#ifdef PACKET_FANOUT_FLAG_UNIQUEID
+    arg = (PACKET_FANOUT_HASH | PACKET_FANOUT_FLAG_UNIQUEID) << 16;
+    if (setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &arg, sizeof(arg)) >= 0) {
+      socklen_t len = sizeof(arg);
+      ret = getsockopt(fd, SOL_PACKET, PACKET_FANOUT, &arg, &len);
+      if (ret < 0) {
+        ret = -errno;
+        err("%s(%d), get fanout id fail %d\n", __func__, afpkt->port, ret);
+        return ret;
+      }
+      afpkt->fanout_id = arg & 0xffff;
+      info("%s(%d), fanout id %d\n", __func__, afpkt->port, afpkt->fanout_id);
+      return 0;
+    }
+#endif
+    /* no unique id from the kernel, derive one from the pid and the port */
+    afpkt->fanout_id = (getpid() * MTL_PORT_MAX + afpkt->port) & 0xffff;
+    info("%s(%d), fanout id %d\n", __func__, afpkt->port, afpkt->fanout_id);
+  }
+
+  arg = afpkt->fanout_id | (PACKET_FANOUT_HASH << 16);
+  ret = setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &arg, sizeof(arg));
+  if (ret < 0) {
+    ret = -errno;
+    err("%s(%d,%u), join fanout %d fail %d\n", __func__, afpkt->port, rxq->queue_id,
+        afpkt->fanout_id, ret);
+    return ret;
+  }
+
+  return 0;
+}
+
+static int afpkt_rxq_uinit(struct mt_afpkt_rxq* rxq) {
+  if (rxq->ring) {
+    munmap(rxq->ring, rxq->ring_size);
+    rxq->ring = NULL;
+  }
+  if (rxq->fd >= 0) {
+    close(rxq->fd);
+    rxq->fd = -1;
+  }
+  return 0;
+}
+
+static int afpkt_rxq_init(struct mt_afpkt_impl* afpkt, struct mt_afpkt_rxq* rxq) {
+  enum mtl_port port = afpkt->port;
+  uint16_t q = rxq->queue_id;
+  struct tpacket_req3 req;
+  struct sockaddr_ll addr;
+  int val, ret;
+
+  /* protocol 0, nothing is queued before the ring and the bind are ready */
+  rxq->fd = socket(AF_PACKET, SOCK_RAW, 0);
+  if (rxq->fd < 0) {
+    ret = -errno;
+    err("%s(%d,%u), socket fail %d\n", __func__, port, q, ret);
+    return ret;
+  }
+
+  val = TPACKET_V3;
+  ret = setsockopt(rxq->fd, SOL_PACKET, PACKET_VERSION, &val, sizeof(val));
+  if (ret < 0) {
+    ret = -errno;
+    err("%s(%d,%u), set TPACKET_V3 fail %d\n", __func__, port, q, ret);
+    afpkt_rxq_uinit(rxq);
+    return ret;
+  }
+
+#ifdef PACKET_IGNORE_OUTGOING
+  val = 1;
+  ret = setsockopt(rxq->fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &val, sizeof(val));
+  if (ret < 0) dbg("%s(%d,%u), no PACKET_IGNORE_OUTGOING\n", __func__, port, q);
+#endif
+
+  memset(&req, 0, sizeof(req));
+  req.tp_block_size = MT_AF_PACKET_BLOCK_SIZE;
+  req.tp_block_nr = MT_AF_PACKET_BLOCK_NR;
+  req.tp_frame_size = MT_AF_PACKET_FRAME_SIZE;
+  req.tp_frame_nr = req.tp_block_size / req.tp_frame_size * req.tp_block_nr;
+  req.tp_retire_blk_tov = MT_AF_PACKET_BLOCK_TOV_MS;
+  ret = setsockopt(rxq->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+  if (ret < 0) {
+    ret = -errno;
+    err("%s(%d,%u), set rx ring fail %d\n", __func__, port, q, ret);
+    afpkt_rxq_uinit(rxq);
+    return ret;
+  }
+
+  rxq->ring_size = (size_t)req.tp_block_size * req.tp_block_nr;
+  rxq->ring = mmap(NULL, rxq->ring_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, rxq->fd, 0);
+  if (rxq->ring == MAP_FAILED) {
+    ret = -errno;
+    rxq->ring = NULL;
+    err("%s(%d,%u), mmap rx ring fail %d\n", __func__, port, q, ret);
+    afpkt_rxq_uinit(rxq);
+    return ret;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sll_family = AF_PACKET;
+  addr.sll_protocol = htons(ETH_P_ALL);
+  addr.sll_ifindex = afpkt->if_index;
+  ret = bind(rxq->fd, (struct sockaddr*)&addr, sizeof(addr));
+  if (ret < 0) {
+    ret = -errno;
+    err("%s(%d,%u), bind to %s fail %d\n", __func__, port, q, afpkt->if_name, ret);
+    afpkt_rxq_uinit(rxq);
+    return ret;
+  }
+
+  /* the kernel hash the flows to the rx queues */
+  if (afpkt->nb_rxq > 1) {
+    ret = afpkt_fanout_join(afpkt, rxq);
+    if (ret < 0) {
+      afpkt_rxq_uinit(rxq);
+      return ret;
+    }
+  }
+
+  info("%s(%d,%u), ring %" PRIu64 " bytes\n", __func__, port, q, rxq->ring_size);
+  return 0;
+}
+
+static int afpkt_txq_uinit(struct mt_afpkt_txq* txq) {
+  if (txq->fd >= 0) {
+    close(txq->fd);
+    txq->fd = -1;
+  }
+  return 0;
+}
+
+static int afpkt_txq_init(struct mt_afpkt_impl* afpkt, struct mt_afpkt_txq* txq) {
+  enum mtl_port port = afpkt->port;
+  uint16_t q = txq->queue_id;
+  int val, ret;
+
+  /* protocol 0 and no bind, the socket only send */
+  txq->fd = socket(AF_PACKET, SOCK_RAW, 0);
+  if (txq->fd < 0) {
+    ret = -errno;
+    err("%s(%d,%u), socket fail %d\n", __func__, port, q, ret);
+    return ret;
+  }
+
+  val = 1;
+  ret = setsockopt(txq->fd, SOL_PACKET, PACKET_QDISC_BYPASS, &val, sizeof(val));
+  if (ret < 0) warn("%s(%d,%u), no PACKET_QDISC_BYPASS\n", __func__, port, q);
+
+  for (int i = 0; i < MT_AF_PACKET_TX_BURST; i++) {
+    struct sockaddr_ll* addr = &txq->addrs[i];
+    struct msghdr* msg = &txq->msgs[i].msg_hdr;
+
+    addr->sll_family = AF_PACKET;
+    addr->sll_ifindex = afpkt->if_index;
+    msg->msg_name = addr;
+    msg->msg_namelen = sizeof(*addr);
+    msg->msg_iov = txq->iovs[i];
+  }
+
+  return 0;
+}
+
+int mt_afpkt_stop(struct mt_interface* inf) {
+  struct mt_afpkt_impl* afpkt = inf->afpkt;
+
+  if (!afpkt) return 0;
+
+  if (afpkt->rxqs) {
+    for (uint16_t q = 0; q < afpkt->nb_rxq; q++) {
+      if (inf->rx_queues) inf->rx_queues[q].afpkt = NULL;
+      afpkt_rxq_uinit(&afpkt->rxqs[q]);
+    }
+    mt_rte_free(afpkt->rxqs);
+    afpkt->rxqs = NULL;
+  }
+  afpkt->nb_rxq = 0;
+
+  if (afpkt->txqs) {
+    for (uint16_t q = 0; q < afpkt->nb_txq; q++) {
+      if (inf->tx_queues) inf->tx_queues[q].afpkt = NULL;
+      afpkt_txq_uinit(&afpkt->txqs[q]);
+    }
+    mt_rte_free(afpkt->txqs);
+    afpkt->txqs = NULL;
+  }
+  afpkt->nb_txq = 0;
+
+  afpkt->fanout_id = -1;
+  return 0;
+}
+
+int mt_afpkt_start(struct mt_interface* inf) {
+  struct mt_afpkt_impl* afpkt = inf->afpkt;
+  struct mtl_main_impl* impl = inf->parent;
+  enum mtl_port port = inf->port;
+  int ret;
+
+  afpkt->rxqs = mt_rte_zmalloc_socket(sizeof(*afpkt->rxqs) * inf->max_rx_queues,
+                                      inf->socket_id);
+  afpkt->txqs = mt_rte_zmalloc_socket(sizeof(*afpkt->txqs) * inf->max_tx_queues,
+                                      inf->socket_id);
+  if (!afpkt->rxqs || !afpkt->txqs) {
+    err("%s(%d), queues malloc fail\n", __func__, port);
+    mt_afpkt_stop(inf);
+    return -ENOMEM;
+  }
+  afpkt->nb_rxq = inf->max_rx_queues;
+  afpkt->nb_txq = inf->max_tx_queues;
+  for (uint16_t q = 0; q < afpkt->nb_rxq; q++) afpkt->rxqs[q].fd = -1;
+  for (uint16_t q = 0; q < afpkt->nb_txq; q++) afpkt->txqs[q].fd = -1;
+
+  for (uint16_t q = 0; q < afpkt->nb_rxq; q++) {
+    struct mt_afpkt_rxq* rxq = &afpkt->rxqs[q];
+
+    rxq->parent = afpkt;
+    rxq->queue_id = q;
+    rxq->mbuf_pool = inf->rx_queues[q].mbuf_pool ? inf->rx_queues[q].mbuf_pool
+                                                 : mt_get_rx_mempool(impl, port);
+    if (!rxq->mbuf_pool) {
+      err("%s(%d), no mbuf_pool for queue %u\n", __func__, port, q);
+      mt_afpkt_stop(inf);
+      return -ENOMEM;
+    }
+    ret = afpkt_rxq_init(afpkt, rxq);
+    if (ret < 0) {
+      mt_afpkt_stop(inf);
+      return ret;
+    }
+    inf->rx_queues[q].afpkt = rxq;
+  }
+
+  for (uint16_t q = 0; q < afpkt->nb_txq; q++) {
+    struct mt_afpkt_txq* txq = &afpkt->txqs[q];
+
+    txq->parent = afpkt;
+    txq->queue_id = q;
+    ret = afpkt_txq_init(afpkt, txq);
+    if (ret < 0) {
+      mt_afpkt_stop(inf);
+      return ret;
+    }
+    inf->tx_queues[q].afpkt = txq;
+  }
+
+  info("%s(%d), succ, tx_q %u rx_q %u on %s\n", __func__, port, afpkt->nb_txq,
+       afpkt->nb_rxq, afpkt->if_name);
+  return 0;
+}
+
+int mt_afpkt_link_get(struct mt_interface* inf, struct rte_eth_link* link) {
+  struct mt_afpkt_impl* afpkt = inf->afpkt;
+  struct ethtool_cmd ecmd;
+  struct ifreq ifr;
+  int sock, ret;
+
+  sock = socket(AF_INET, SOCK_DGRAM, 0);
+  if (sock < 0) {
+    err("%s(%d), socket call fail\n", __func__, afpkt->port);
+    return sock;
+  }
+
+  memset(&ifr, 0, sizeof(ifr));
+  snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", afpkt->if_name);
+  ret = ioctl(sock, SIOCGIFFLAGS, &ifr);
+  if (ret < 0) {
+    err("%s(%d), SIOCGIFFLAGS fail %d for if %s\n", __func__, afpkt->port, ret,
+        afpkt->if_name);
+    close(sock);
+    return ret;
+  }
+  memset(link, 0, sizeof(*link));
+  link->link_status = (ifr.ifr_flags & IFF_UP) && (ifr.ifr_flags & IFF_RUNNING);
+  link->link_duplex = RTE_ETH_LINK_FULL_DUPLEX;
+
+  /* virtual if(veth, lo) may not report a speed, default to 10g */
+  link->link_speed = RTE_ETH_SPEED_NUM_10G;
+  memset(&ecmd, 0, sizeof(ecmd));
+  ecmd.cmd = ETHTOOL_GSET;
+  ifr.ifr_data = (void*)&ecmd;
+  ret = ioctl(sock, SIOCETHTOOL, &ifr);
+  if (ret >= 0) {
+    uint32_t speed = ethtool_cmd_speed(&ecmd);
+    if (speed && (speed != (uint32_t)SPEED_UNKNOWN)) link->link_speed = speed;
+  }
+
+  close(sock);
+  return 0;
+}
+
+int mt_afpkt_stats_get(struct mt_interface* inf, struct rte_eth_stats* stats) {
+  struct mt_afpkt_impl* afpkt = inf->afpkt;
+
+  memset(stats, 0, sizeof(*stats));
+
+  for (uint16_t q = 0; q < afpkt->nb_rxq; q++) {
+    struct mt_afpkt_rxq* rxq = &afpkt->rxqs[q];
+    struct tpacket_stats_v3 st;
+    socklen_t len = sizeof(st);
+
+    /* the kernel clear the counters on each read */
+    if (getsockopt(rxq->fd, SOL_PACKET, PACKET_STATISTICS, &st, &len) >= 0)
+      rxq->stat_drops += st.tp_drops;
+
+    stats->ipackets += rxq->stat_pkts;
+    stats->ibytes += rxq->stat_bytes;
+    stats->ierrors += rxq->stat_errors;
+    stats->imissed += rxq->stat_drops;
+    stats->rx_nombuf += rxq->stat_nombuf;
+  }
+
+  for (uint16_t q = 0; q < afpkt->nb_txq; q++) {
+    struct mt_afpkt_txq* txq = &afpkt->txqs[q];
+
+    stats->opackets += txq->stat_pkts;
+    stats->obytes += txq->stat_bytes;
+    stats->oerrors += txq->stat_errors;
+  }
+
+  return 0;
+}
+
+int mt_afpkt_macaddr_get(struct mt_interface* inf, struct rte_ether_addr* mac_addr) {
+  rte_ether_addr_copy(&inf->afpkt->mac, mac_addr);
+  return 0;
+}
+
+int mt_afpkt_mcast_mac(struct mt_interface* inf, struct rte_ether_addr* mcast_mac,
+                       bool add) {
+  struct mt_afpkt_impl* afpkt = inf->afpkt;
+  struct packet_mreq mreq;
+  int ret;
+
+  /* the membership live with the first rx socket */
+  if (!afpkt->nb_rxq) {
+    err("%s(%d), no rx socket\n", __func__, afpkt->port);
+    return -EIO;
+  }
+
+  memset(&mreq, 0, sizeof(mreq));
+  mreq.mr_ifindex = afpkt->if_index;
+  mreq.mr_type = PACKET_MR_MULTICAST;
+  mreq.mr_alen = RTE_ETHER_ADDR_LEN;
+  memcpy(mreq.mr_address, mcast_mac->addr_bytes, RTE_ETHER_ADDR_LEN);
+  ret = setsockopt(afpkt->rxqs[0].fd, SOL_PACKET,
+                   add ? PACKET_ADD_MEMBERSHIP : PACKET_DROP_MEMBERSHIP, &mreq,
+                   sizeof(mreq));
+  if (ret < 0) {
+    ret = -errno;
+    err("%s(%d), %s membership fail %d\n", __func__, afpkt->port, add ? "add" : "drop",
+        ret);
+    return ret;
+  }
+
+  return 0;
+}
+
+int mt_afpkt_init(struct mtl_main_impl* impl, enum mtl_port port,
+                  struct rte_eth_dev_info* dev_info) {
+  struct mt_interface* inf = mt_if(impl, port);
+  struct mt_afpkt_impl* afpkt;
+  int ret;
+
+  afpkt = mt_rte_zmalloc_socket(sizeof(*afpkt), mt_socket_id(impl, port));
+  if (!afpkt) {
+    err("%s(%d), afpkt malloc fail\n", __func__, port);
+    return -ENOMEM;
+  }
+  afpkt->parent = impl;
+  afpkt->port = port;
+  afpkt->fanout_id = -1;
+  snprintf(afpkt->if_name, sizeof(afpkt->if_name), "%s",
+           mt_get_user_params(impl)->port[port]);
+
+  afpkt->if_index = if_nametoindex(afpkt->if_name);
+  if (!afpkt->if_index) {
+    err("%s(%d), no kernel if %s\n", __func__, port, afpkt->if_name);
+    mt_rte_free(afpkt);
+    return -ENODEV;
+  }
+  ret = mt_socket_get_if_mac(afpkt->if_name, &afpkt->mac);
+  if (ret < 0) {
+    err("%s(%d), get mac fail %d for if %s\n", __func__, port, ret, afpkt->if_name);
+    mt_rte_free(afpkt);
+    return ret;
+  }
+
+  /* no ethdev, report what the socket backend support */
+  memset(dev_info, 0, sizeof(*dev_info));
+  dev_info->driver_name = MT_AF_PACKET_DRV_NAME;
+  dev_info->if_index = afpkt->if_index;
+  dev_info->max_rx_queues = MT_AF_PACKET_RX_QUEUES_MAX;
+  dev_info->max_tx_queues = RTE_MAX_QUEUES_PER_PORT;
+  dev_info->max_rx_pktlen = MT_AF_PACKET_FRAME_SIZE;
+#if RTE_VERSION >= RTE_VERSION_NUM(22, 3, 0, 0)
+  dev_info->tx_offload_capa = RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
+#else
+  dev_info->tx_offload_capa = DEV_TX_OFFLOAD_MULTI_SEGS;
+#endif
+
+  inf->afpkt = afpkt;
+  info("%s(%d), succ, if %s index %d\n", __func__, port, afpkt->if_name,
+       afpkt->if_index);
+  return 0;
+}
+
+int mt_afpkt_uinit(struct mt_interface* inf) {
+  if (!inf->afpkt) return 0;
+
+  mt_afpkt_stop(inf);
+  mt_rte_free(inf->afpkt);
+  inf->afpkt = NULL;
+  return 0;
+}
+#else
+uint16_t mt_afpkt_tx_burst(struct mt_afpkt_txq* txq, struct rte_mbuf** tx_pkts,
+                           uint16_t nb_pkts) {
+  return 0;
+}
+
+uint16_t mt_afpkt_rx_burst(struct mt_afpkt_rxq* rxq, struct rte_mbuf** rx_pkts,
+                           uint16_t nb_pkts) {
+  return 0;
+}
+
+int mt_afpkt_stop(struct mt_interface* inf) { return -ENOTSUP; }
+
+int mt_afpkt_start(struct mt_interface* inf) { return -ENOTSUP; }
+
+int mt_afpkt_link_get(struct mt_interface* inf, struct rte_eth_link* link) {
+  return -ENOTSUP;
+}
+
+int mt_afpkt_stats_get(struct mt_interface* inf, struct rte_eth_stats* stats) {
+  return -ENOTSUP;
+}
+
+int mt_afpkt_macaddr_get(struct mt_interface* inf, struct rte_ether_addr* mac_addr) {
+  return -ENOTSUP;
+}
+
+int mt_afpkt_mcast_mac(struct mt_interface* inf, struct rte_ether_addr* mcast_mac,
+                       bool add) {
+  return -ENOTSUP;
+}
+
+int mt_afpkt_init(struct mtl_main_impl* impl, enum mtl_port port,
+                  struct rte_eth_dev_info* dev_info) {
+  return -ENOTSUP;
+}
+
+int mt_afpkt_uinit(struct mt_interface* inf) { return 0; }
+#endif
@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+#ifndef _MT_LIB_AF_PACKET_HEAD_H_
+#define _MT_LIB_AF_PACKET_HEAD_H_
+
+#include "mt_main.h"
+
+/* the driver name of the synthetic dev info, no ethdev behind it */
+#define MT_AF_PACKET_DRV_NAME "mtl_af_packet"
+/* invalid ethdev port id, any rte_eth_* call on the port fail with -ENODEV */
+#define MT_AF_PACKET_PORT_ID (RTE_MAX_ETHPORTS)
+
+struct mt_afpkt_impl;
+struct mt_afpkt_rxq;
+struct mt_afpkt_txq;
+
+int mt_afpkt_init(struct mtl_main_impl* impl, enum mtl_port port,
+                  struct rte_eth_dev_info* dev_info);
+int mt_afpkt_uinit(struct mt_interface* inf);
+
+/* create the sockets for all tx and rx queues of the interface */
+int mt_afpkt_start(struct mt_interface* inf);
+int mt_afpkt_stop(struct mt_interface* inf);
+
+int mt_afpkt_link_get(struct mt_interface* inf, struct rte_eth_link* link);
+/* monotonic counters since start, the caller diff them as no_dev_stats_reset */
+int mt_afpkt_stats_get(struct mt_interface* inf, struct rte_eth_stats* stats);
+int mt_afpkt_macaddr_get(struct mt_interface* inf, struct rte_ether_addr* mac_addr);
+int mt_afpkt_mcast_mac(struct mt_interface* inf, struct rte_ether_addr* mcast_mac,
+                       bool add);
+
+uint16_t mt_afpkt_tx_burst(struct mt_afpkt_txq* txq, struct rte_mbuf** tx_pkts,
+                           uint16_t nb_pkts);
+uint16_t mt_afpkt_rx_burst(struct mt_afpkt_rxq* rxq, struct rte_mbuf** rx_pkts,
+                           uint16_t nb_pkts);
+
+#endif
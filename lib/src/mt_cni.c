@@ -448,6 +448,7 @@ int mt_cni_init(struct mtl_main_impl* impl) {
     ops.start = cni_tasklet_start;
     ops.stop = cni_tasklet_stop;
     ops.handler = cni_tasklet_handler;
+    /* no MT_TASKLET_BALANCE, a light control tasklet which stay on the main sch */
 
     cni_impl->tasklet = mt_sch_register_tasklet(impl->main_sch, &ops);
     if (!cni_impl->tasklet) {
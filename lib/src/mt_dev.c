@@ -6,6 +6,7 @@
 
 #include "mt_arp.h"
 #include "mt_cni.h"
+#include "mt_dev_test.h"
 #include "mt_dhcp.h"
 #include "mt_log.h"
 #include "mt_mcast.h"
@@ -70,6 +71,13 @@ static const struct mt_dev_driver_info dev_drvs[] = {
         .drv_type = MT_DRV_MLX5,
         .flow_type = MT_FLOW_ALL,
     },
+    {
+        .name = MT_AF_PACKET_DRV_NAME,
+        .port_type = MT_PORT_AF_PKT,
+        .drv_type = MT_DRV_AF_PKT,
+        .flow_type = MT_FLOW_NONE,
+        .no_dev_stats_reset = true,
+    },
 };
 
 static int parse_driver_info(const char* driver, struct mt_dev_driver_info* drv_info) {
@@ -131,7 +139,10 @@ static int dev_inf_get_stat(struct mt_interface* inf) {
 
   rte_spinlock_lock(&inf->stats_lock);
 
-  ret = rte_eth_stats_get(port_id, &stats);
+  if (inf->afpkt)
+    ret = mt_afpkt_stats_get(inf, &stats);
+  else
+    ret = rte_eth_stats_get(port_id, &stats);
   if (ret < 0) {
     rte_spinlock_unlock(&inf->stats_lock);
     err("%s(%d), eth stats get fail %d\n", __func__, port, ret);
@@ -205,7 +216,7 @@ static int dev_inf_stat(void* pri) {
         " rx_nombuf %" PRIu64 "\n",
         port, stats_sum->imissed, stats_sum->ierrors, stats_sum->oerrors,
         stats_sum->rx_nombuf);
-    dev_eth_xstat(port_id);
+    if (!inf->afpkt) dev_eth_xstat(port_id);
   }
 
   if (!inf->dev_stats_not_reset) {
@@ -296,6 +307,13 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
   char port_params[MTL_PORT_MAX][2 * MTL_PORT_MAX_LEN];
   char* port_param;
   int pci_ports = 0;
+  /* the af_packet ports has no ethdev, only need the mbuf and mempool from eal */
+  bool no_huge = !p->num_dma_dev_port;
+  char no_huge_mem[16];
+
+  for (int i = 0; i < num_ports; i++) {
+    if (p->pmd[i] != MTL_PMD_AF_PACKET) no_huge = false;
+  }
 
   argc = 0;
 
@@ -306,13 +324,18 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
   argc++;
   argv[argc] = MT_DPDK_LIB_NAME;
   argc++;
-  argv[argc] = "--match-allocations";
-  argc++;
+  if (!no_huge) {
+    argv[argc] = "--match-allocations";
+    argc++;
+  }
 #endif
   argv[argc] = "--in-memory";
   argc++;
 
   for (int i = 0; i < num_ports; i++) {
+    /* kernel socket backend, nothing to probe in eal */
+    if (p->pmd[i] == MTL_PMD_AF_PACKET) continue;
+
     if (p->pmd[i] == MTL_PMD_DPDK_AF_XDP) {
       argv[argc] = "--vdev";
       has_afxdp = true;
@@ -361,6 +384,19 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
     argc++;
   }
 
+  if (no_huge) {
+    /* anonymous memory for the mbufs, the kernel copy to and from the sockets */
+    argv[argc] = "--no-huge";
+    argc++;
+    argv[argc] = "-m";
+    argc++;
+    snprintf(no_huge_mem, sizeof(no_huge_mem), "%d", MT_AF_PACKET_NO_HUGE_MEM_MB);
+    argv[argc] = no_huge_mem;
+    argc++;
+    info("%s, no hugepage as all ports are af_packet, mem %sMB\n", __func__,
+         no_huge_mem);
+  }
+
   if (p->iova_mode > MTL_IOVA_MODE_AUTO && p->iova_mode < MTL_IOVA_MODE_MAX) {
     argv[argc] = "--iova-mode";
     argc++;
@@ -369,6 +405,12 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
     else if (p->iova_mode == MTL_IOVA_MODE_PA)
       argv[argc] = "pa";
     argc++;
+  } else if (no_huge) {
+    /* no physical address without hugepage */
+    argv[argc] = "--iova-mode";
+    argc++;
+    argv[argc] = "va";
+    argc++;
   }
 
   argv[argc] = "--log-level";
@@ -837,8 +879,11 @@ static int dev_stop_port(struct mt_interface* inf) {
     return 0;
   }
 
-  ret = rte_eth_dev_stop(port_id);
-  if (ret < 0) err("%s(%d), rte_eth_dev_stop fail %d\n", __func__, port, ret);
+  if (inf->afpkt)
+    ret = mt_afpkt_stop(inf);
+  else
+    ret = rte_eth_dev_stop(port_id);
+  if (ret < 0) err("%s(%d), dev stop fail %d\n", __func__, port, ret);
 
   inf->status &= ~MT_IF_STAT_PORT_STARTED;
   info("%s(%d), succ\n", __func__, port);
@@ -855,8 +900,10 @@ static int dev_close_port(struct mt_interface* inf) {
     return 0;
   }
 
-  ret = rte_eth_dev_close(port_id);
-  if (ret < 0) err("%s(%d), rte_eth_dev_close fail %d\n", __func__, port, ret);
+  if (!inf->afpkt) {
+    ret = rte_eth_dev_close(port_id);
+    if (ret < 0) err("%s(%d), rte_eth_dev_close fail %d\n", __func__, port, ret);
+  }
 
   inf->status &= ~MT_IF_STAT_PORT_CONFIGURED;
   info("%s(%d), succ\n", __func__, port);
@@ -871,6 +918,21 @@ static int dev_detect_link(struct mt_interface* inf) {
 
   memset(&eth_link, 0, sizeof(eth_link));
 
+  if (inf->afpkt) {
+    for (int i = 0; i < 100; i++) {
+      mt_afpkt_link_get(inf, &eth_link);
+      if (eth_link.link_status) {
+        inf->link_speed = eth_link.link_speed;
+        info("%s(%d), link up, speed %u\n", __func__, port, eth_link.link_speed);
+        return 0;
+      }
+      mt_sleep_ms(100);
+    }
+    err("%s(%d), link not up for %s\n", __func__, port,
+        mt_get_user_params(inf->parent)->port[port]);
+    return -EIO;
+  }
+
   for (int i = 0; i < 100; i++) {
     rte_eth_link_get_nowait(port_id, &eth_link);
     if (eth_link.link_status) {
@@ -978,6 +1040,17 @@ static int dev_config_port(struct mt_interface* inf) {
   uint16_t nb_rx_q = inf->max_rx_queues, nb_tx_q = inf->max_tx_queues;
   struct rte_eth_conf port_conf = dev_port_conf;
 
+  if (inf->afpkt) { /* no ethdev, the rings are created at the start */
+    if (p->nb_tx_desc) nb_tx_desc = p->nb_tx_desc;
+    if (p->nb_rx_desc) nb_rx_desc = p->nb_rx_desc;
+    inf->nb_tx_desc = nb_tx_desc;
+    inf->nb_rx_desc = nb_rx_desc;
+    inf->net_proto = p->net_proto[port];
+    inf->status |= MT_IF_STAT_PORT_CONFIGURED;
+    info("%s(%d), af_packet tx_q %d rx_q %d\n", __func__, port, nb_tx_q, nb_rx_q);
+    return 0;
+  }
+
   if (inf->feature & MT_IF_FEATURE_TX_MULTI_SEGS) {
 #if RTE_VERSION >= RTE_VERSION_NUM(22, 3, 0, 0)
     port_conf.txmode.offloads |= RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
@@ -1002,6 +1075,19 @@ static int dev_config_port(struct mt_interface* inf) {
 #endif
   }
 
+  /* small user data room, let the nic scatter the pkt into multi segments */
+  if (impl->rx_pool_data_size && (impl->rx_pool_data_size < ST_PKT_MAX_ETHER_BYTES)) {
+#if RTE_VERSION >= RTE_VERSION_NUM(22, 3, 0, 0)
+    if (inf->dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_SCATTER)
+      port_conf.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_SCATTER;
+#else
+    if (inf->dev_info.rx_offload_capa & DEV_RX_OFFLOAD_SCATTER)
+      port_conf.rxmode.offloads |= DEV_RX_OFFLOAD_SCATTER;
+#endif
+    info("%s(%d), rx scatter for data room %u\n", __func__, port,
+         impl->rx_pool_data_size);
+  }
+
   dbg("%s(%d), rss mode %d\n", __func__, port, inf->rss_mode);
   if (mt_has_srss(impl, port)) {
     struct rte_eth_rss_conf* rss_conf;
@@ -1139,6 +1225,16 @@ static int dev_start_port(struct mt_interface* inf) {
   struct rte_eth_txconf tx_port_conf;
   struct rte_eth_rxconf rx_port_conf;
 
+  if (inf->afpkt) {
+    ret = mt_afpkt_start(inf);
+    if (ret < 0) {
+      err("%s(%d), af_packet start fail %d\n", __func__, port, ret);
+      return ret;
+    }
+    inf->status |= MT_IF_STAT_PORT_STARTED;
+    return 0;
+  }
+
   if (inf->feature & MT_IF_FEATURE_RUNTIME_RX_QUEUE) rx_deferred_start = 1;
   rx_port_conf.rx_deferred_start = rx_deferred_start;
 
@@ -1254,6 +1350,11 @@ int dev_reset_port(struct mtl_main_impl* impl, enum mtl_port port) {
     return -EIO;
   }
 
+  if (inf->afpkt) {
+    err("%s(%d), not support for af_packet\n", __func__, port);
+    return -ENOTSUP;
+  }
+
   rte_atomic32_set(&impl->instance_in_reset, 1);
 
   mt_cni_stop(impl);
@@ -1595,12 +1696,14 @@ static int dev_if_init_rx_queues(struct mtl_main_impl* impl, struct mt_interface
     return -ENOMEM;
   }
 
+  for (uint16_t q = 0; q < inf->max_rx_queues; q++) {
+    rx_queues[q].queue_id = q;
+    rx_queues[q].port = inf->port;
+    rx_queues[q].port_id = inf->port_id;
+  }
+
   if (!mt_has_rx_mono_pool(impl)) {
     for (uint16_t q = 0; q < inf->max_rx_queues; q++) {
-      rx_queues[q].queue_id = q;
-      rx_queues[q].port = inf->port;
-      rx_queues[q].port_id = inf->port_id;
-
       /* Create mempool to hold the rx queue mbufs. */
       unsigned int mbuf_elements = inf->nb_rx_desc + 1024;
       char pool_name[ST_MAX_NAME_LEN];
@@ -1608,7 +1711,7 @@ static int dev_if_init_rx_queues(struct mtl_main_impl* impl, struct mt_interface
                inf->port, q);
       struct rte_mempool* mbuf_pool = NULL;
 
-      if (mt_pmd_is_kernel(impl, inf->port)) {
+      if (mt_pmd_is_af_xdp(impl, inf->port)) {
         mbuf_pool = mt_mempool_create_by_ops(
             impl, inf->port, pool_name, mbuf_elements, MT_MBUF_CACHE_SIZE,
             sizeof(struct mt_muf_priv_data), 2048 - MT_MBUF_CACHE_SIZE, NULL);
@@ -1707,6 +1810,12 @@ static int dev_if_init_pacing(struct mt_interface* inf) {
     return 0;
   }
 
+  if (inf->afpkt) {
+    info("%s(%d), use tsc as no rl for af_packet\n", __func__, port);
+    inf->tx_pacing_way = ST21_TX_PACING_WAY_TSC;
+    return 0;
+  }
+
   if ((ST21_TX_PACING_WAY_AUTO == inf->tx_pacing_way) ||
       (ST21_TX_PACING_WAY_RL == inf->tx_pacing_way)) {
     /* IAVF require all q config with RL */
@@ -1748,7 +1857,10 @@ static struct mt_rx_flow_rsp* dev_if_create_rx_flow(struct mt_interface* inf, ui
   rsp->flow_id = -1;
   rsp->queue_id = q;
 
-  if (mt_pmd_is_kernel(impl, port)) {
+  if (mt_pmd_is_af_packet(impl, port)) {
+    /* no queue steering for packet socket, srss or rsq dispatch the flow by sw */
+    dbg("%s(%d), skip flow for af_packet queue %u\n", __func__, port, q);
+  } else if (mt_pmd_is_kernel(impl, port)) {
     ret = mt_socket_add_flow(impl, port, q, flow);
     if (ret < 0) {
       err("%s(%d), socket add flow fail for queue %d\n", __func__, port, q);
@@ -2029,6 +2141,7 @@ int mt_dev_tx_done_cleanup(struct mtl_main_impl* impl, struct mt_tx_queue* queue
   uint16_t port_id = queue->port_id;
   uint16_t queue_id = queue->queue_id;
 
+  if (queue->afpkt) return 0; /* the mbufs are freed once sent */
   return rte_eth_tx_done_cleanup(port_id, queue_id, 0);
 }
 
@@ -2163,7 +2276,7 @@ int mt_dev_create(struct mtl_main_impl* impl) {
     ret = dev_detect_link(inf); /* some port can only detect link after start */
     if (ret < 0) {
       err("%s(%d), dev_detect_link fail %d retry %d\n", __func__, i, ret, detect_retry);
-      if (detect_retry < 3) {
+      if ((detect_retry < 3) && !inf->afpkt) {
         detect_retry++;
         rte_eth_dev_reset(inf->port_id);
         ret = dev_config_port(inf);
@@ -2188,6 +2301,7 @@ int mt_dev_create(struct mtl_main_impl* impl) {
       err("%s(%d), init pacing fail\n", __func__, i);
       goto err_exit;
     }
+    if (inf->tx_pacing_way == ST21_TX_PACING_WAY_RL) mt_pacing_train_cache_load(impl, i);
 
     if (inf->drv_info.no_dev_stats_reset) {
       inf->dev_stats_not_reset =
@@ -2388,6 +2502,36 @@ int mt_dev_dst_ip_mac(struct mtl_main_impl* impl, uint8_t dip[MTL_IP_ADDR_LEN],
   return ret;
 }
 
+int mtl_rx_mbufs_in_use(mtl_handle mt, enum mtl_port port, uint32_t* in_use) {
+  struct mtl_main_impl* impl = mt;
+  struct mt_interface* inf;
+  struct mt_rx_queue* rx_queue;
+  uint32_t cnt = 0;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (port >= mt_num_ports(impl)) {
+    err("%s, invalid port %d\n", __func__, port);
+    return -EINVAL;
+  }
+
+  inf = mt_if(impl, port);
+  if (inf->rx_mbuf_pool) cnt += rte_mempool_in_use_count(inf->rx_mbuf_pool);
+  if (!mt_has_rx_mono_pool(impl)) {
+    for (uint16_t q = 0; q < inf->max_rx_queues; q++) {
+      rx_queue = &inf->rx_queues[q];
+      if (rx_queue->mbuf_pool) cnt += rte_mempool_in_use_count(rx_queue->mbuf_pool);
+      if (rx_queue->mbuf_payload_pool)
+        cnt += rte_mempool_in_use_count(rx_queue->mbuf_payload_pool);
+    }
+  }
+
+  *in_use = cnt;
+  return 0;
+}
+
 int mt_dev_if_uinit(struct mtl_main_impl* impl) {
   int num_ports = mt_num_ports(impl), ret;
   struct mt_interface* inf;
@@ -2421,8 +2565,11 @@ int mt_dev_if_uinit(struct mtl_main_impl* impl) {
     mt_pthread_mutex_destroy(&inf->tx_queues_mutex);
     mt_pthread_mutex_destroy(&inf->rx_queues_mutex);
     mt_pthread_mutex_destroy(&inf->vf_cmd_mutex);
+    mt_pthread_mutex_destroy(&inf->pt_mutex);
+    mt_pthread_cond_destroy(&inf->pt_cond);
 
     dev_close_port(inf);
+    mt_afpkt_uinit(inf);
   }
 
   return 0;
@@ -2441,21 +2588,33 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
     inf = mt_if(impl, i);
     dev_info = &inf->dev_info;
 
-    if (mt_pmd_is_kernel(impl, i))
-      port = impl->kport_info.port[i];
-    else
+    if (mt_pmd_is_af_packet(impl, i)) {
+      /* no ethdev, the kernel socket backend fill the dev_info */
       port = p->port[i];
-    ret = rte_eth_dev_get_port_by_name(port, &port_id);
-    if (ret < 0) {
-      err("%s, failed to locate %s. Please run nicctl.sh\n", __func__, port);
-      mt_dev_if_uinit(impl);
-      return ret;
-    }
-    ret = rte_eth_dev_info_get(port_id, dev_info);
-    if (ret < 0) {
-      err("%s, rte_eth_dev_info_get fail for %s\n", __func__, port);
-      mt_dev_if_uinit(impl);
-      return ret;
+      port_id = MT_AF_PACKET_PORT_ID;
+      ret = mt_afpkt_init(impl, i, dev_info);
+      if (ret < 0) {
+        err("%s, mt_afpkt_init fail %d for %s\n", __func__, ret, port);
+        mt_dev_if_uinit(impl);
+        return ret;
+      }
+    } else {
+      if (mt_pmd_is_kernel(impl, i))
+        port = impl->kport_info.port[i];
+      else
+        port = p->port[i];
+      ret = rte_eth_dev_get_port_by_name(port, &port_id);
+      if (ret < 0) {
+        err("%s, failed to locate %s. Please run nicctl.sh\n", __func__, port);
+        mt_dev_if_uinit(impl);
+        return ret;
+      }
+      ret = rte_eth_dev_info_get(port_id, dev_info);
+      if (ret < 0) {
+        err("%s, rte_eth_dev_info_get fail for %s\n", __func__, port);
+        mt_dev_if_uinit(impl);
+        return ret;
+      }
     }
     ret = parse_driver_info(dev_info->driver_name, &inf->drv_info);
     if (ret < 0) {
@@ -2470,6 +2629,9 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
     mt_pthread_mutex_init(&inf->tx_queues_mutex, NULL);
     mt_pthread_mutex_init(&inf->rx_queues_mutex, NULL);
     mt_pthread_mutex_init(&inf->vf_cmd_mutex, NULL);
+    mt_pthread_mutex_init(&inf->pt_mutex, NULL);
+    mt_pthread_cond_init(&inf->pt_cond, NULL);
+    MT_TAILQ_INIT(&inf->pt_reqs);
     rte_spinlock_init(&inf->txq_sys_entry_lock);
     rte_spinlock_init(&inf->stats_lock);
 
@@ -2497,6 +2659,11 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
       inf->max_tx_queues = p->xdp_info[i].queue_count;
       inf->max_rx_queues = inf->max_tx_queues;
       inf->system_rx_queues_end = 0;
+    } else if (p->pmd[i] == MTL_PMD_AF_PACKET) {
+      /* one raw socket per tx queue, the rx rings are in a fanout group */
+      inf->max_tx_queues = RTE_MAX(p->tx_queues_cnt[i], 1);
+      inf->max_rx_queues = RTE_MAX(p->rx_queues_cnt[i], 1);
+      inf->system_rx_queues_end = 0;
     } else {
       info("%s(%d), user request queues tx %u rx %u, deprecated sessions tx %u rx %u\n",
            __func__, i, p->tx_queues_cnt[i], p->rx_queues_cnt[i], p->tx_sessions_cnt_max,
@@ -2658,8 +2825,8 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
       return -ENOMEM;
     }
 
-    inf->pad = mt_build_pad(impl, mt_get_tx_mempool(impl, i), port_id,
-                            RTE_ETHER_TYPE_IPV4, 1024);
+    inf->pad =
+        mt_build_pad(impl, mt_get_tx_mempool(impl, i), i, RTE_ETHER_TYPE_IPV4, 1024);
     if (!inf->pad) {
       err("%s(%d), pad alloc fail\n", __func__, i);
       mt_dev_if_uinit(impl);
@@ -2682,7 +2849,7 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
     uint8_t* gw = p->gateway[i];
     info("%s(%d), gateway: %u.%u.%u.%u\n", __func__, i, gw[0], gw[1], gw[2], gw[3]);
     struct rte_ether_addr mac;
-    rte_eth_macaddr_get(port_id, &mac);
+    mt_macaddr_get(impl, i, &mac);
     info("%s(%d), mac: %02x:%02x:%02x:%02x:%02x:%02x\n", __func__, i, mac.addr_bytes[0],
          mac.addr_bytes[1], mac.addr_bytes[2], mac.addr_bytes[3], mac.addr_bytes[4],
          mac.addr_bytes[5]);
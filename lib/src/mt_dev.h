@@ -5,6 +5,7 @@
 #ifndef _MT_LIB_DEV_HEAD_H_
 #define _MT_LIB_DEV_HEAD_H_
 
+#include "mt_af_packet.h"
 #include "mt_main.h"
 
 /* default desc nb for tx and rx */
@@ -53,6 +54,7 @@ int mt_dev_flush_tx_queue(struct mtl_main_impl* impl, struct mt_tx_queue* queue,
 int mt_dev_tx_done_cleanup(struct mtl_main_impl* impl, struct mt_tx_queue* queue);
 static inline uint16_t mt_dev_tx_burst(struct mt_tx_queue* queue,
                                        struct rte_mbuf** tx_pkts, uint16_t nb_pkts) {
+  if (queue->afpkt) return mt_afpkt_tx_burst(queue->afpkt, tx_pkts, nb_pkts);
   return rte_eth_tx_burst(queue->port_id, queue->queue_id, tx_pkts, nb_pkts);
 }
 uint16_t mt_dev_tx_burst_busy(struct mtl_main_impl* impl, struct mt_tx_queue* queue,
@@ -71,6 +73,7 @@ static inline uint16_t mt_dev_rx_queue_id(struct mt_rx_queue* queue) {
 static inline uint16_t mt_dev_rx_burst(struct mt_rx_queue* queue,
                                        struct rte_mbuf** rx_pkts,
                                        const uint16_t nb_pkts) {
+  if (queue->afpkt) return mt_afpkt_rx_burst(queue->afpkt, rx_pkts, nb_pkts);
   return rte_eth_rx_burst(queue->port_id, queue->queue_id, rx_pkts, nb_pkts);
 }
 
@@ -0,0 +1,36 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+/* The test hooks of mt_dev.c, not installed, for the gtest only */
+
+#ifndef _MT_LIB_DEV_TEST_HEAD_H_
+#define _MT_LIB_DEV_TEST_HEAD_H_
+
+#include "mtl_api.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * Get the number of the mbufs taken out of all the rx pools of the port, including
+ * the ones filled in the nic rx descriptors. Used to check the mbuf leaks.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param port
+ *   The port.
+ * @param in_use
+ *   A pointer to the number of the in use mbufs.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int mtl_rx_mbufs_in_use(mtl_handle mt, enum mtl_port port, uint32_t* in_use);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -130,6 +130,149 @@ int mt_map_uinit(struct mtl_main_impl* impl) {
 #if RTE_VERSION >= RTE_VERSION_NUM(21, 11, 0, 0)
 #include <rte_dmadev.h>
 
+/* spin count of the idle soft dma thread before a sleep */
+#define MT_DMA_SOFT_IDLE_SPIN (1024 * 64)
+
+static inline void* dma_soft_iova2va(struct mt_dma_soft* soft, rte_iova_t iova) {
+  if (soft->iova_va) return (void*)(uintptr_t)iova;
+  return rte_mem_iova2virt(iova);
+}
+
+static void dma_soft_fill(void* dst, uint64_t pattern, uint32_t len) {
+  uint8_t* d = dst;
+  uint32_t i;
+
+  for (i = 0; i + sizeof(pattern) <= len; i += sizeof(pattern))
+    memcpy(d + i, &pattern, sizeof(pattern));
+  if (i < len) memcpy(d + i, &pattern, len - i);
+}
+
+static int dma_soft_enqueue(struct mt_dma_soft* soft, void* dst, void* src,
+                            uint64_t pattern, uint32_t len) {
+  struct mt_dma_soft_desc* desc;
+
+  if (!dst) return -EINVAL;
+  /* the desc is free only after the completion returned, as a dmadev */
+  if (soft->enqueued - soft->reaped >= soft->nb_desc) return -ENOSPC;
+
+  desc = &soft->descs[soft->enqueued % soft->nb_desc];
+  desc->dst = dst;
+  desc->src = src;
+  desc->pattern = pattern;
+  desc->len = len;
+  return (uint16_t)(soft->enqueued++);
+}
+
+static int dma_soft_submit(struct mt_dma_soft* soft) {
+  uint64_t submitted = rte_atomic64_read(&soft->submitted);
+  uint64_t now = mt_get_monotonic_time();
+
+  for (uint64_t i = submitted; i < soft->enqueued; i++)
+    soft->descs[i % soft->nb_desc].submit_ns = now;
+  rte_smp_wmb();
+  rte_atomic64_set(&soft->submitted, soft->enqueued);
+  return 0;
+}
+
+static uint16_t dma_soft_completed(struct mt_dma_soft* soft, uint16_t nb_cpls) {
+  uint64_t completed = rte_atomic64_read(&soft->completed);
+  uint16_t nb = RTE_MIN(completed - soft->reaped, (uint64_t)nb_cpls);
+
+  rte_smp_rmb();
+  soft->reaped += nb;
+  return nb;
+}
+
+static void* dma_soft_thread(void* arg) {
+  struct mt_dma_dev* dev = arg;
+  struct mt_dma_soft* soft = &dev->soft_engine;
+  uint64_t done = rte_atomic64_read(&soft->completed);
+  struct mt_dma_soft_desc* desc;
+  uint32_t idle = 0;
+
+  info("%s(%d), start\n", __func__, dev->idx);
+  while (rte_atomic32_read(&soft->stop_thread) == 0) {
+    if (done == (uint64_t)rte_atomic64_read(&soft->submitted)) {
+      idle++;
+      if (idle > MT_DMA_SOFT_IDLE_SPIN)
+        mt_sleep_us(1);
+      else
+        rte_pause();
+      continue;
+    }
+    idle = 0;
+    rte_smp_rmb();
+
+    desc = &soft->descs[done % soft->nb_desc];
+    if (soft->latency_ns &&
+        (mt_get_monotonic_time() < desc->submit_ns + soft->latency_ns)) {
+      rte_pause();
+      continue;
+    }
+    if (desc->src)
+      rte_memcpy(desc->dst, desc->src, desc->len);
+    else
+      dma_soft_fill(desc->dst, desc->pattern, desc->len);
+    done++;
+    rte_smp_wmb();
+    rte_atomic64_set(&soft->completed, done);
+  }
+  info("%s(%d), stop\n", __func__, dev->idx);
+
+  return NULL;
+}
+
+static int dma_soft_stop(struct mt_dma_dev* dev) {
+  struct mt_dma_soft* soft = &dev->soft_engine;
+
+  rte_atomic32_set(&soft->stop_thread, 1);
+  if (soft->tid) {
+    pthread_join(soft->tid, NULL);
+    soft->tid = 0;
+  }
+  if (soft->descs) {
+    mt_rte_free(soft->descs);
+    soft->descs = NULL;
+  }
+
+  return 0;
+}
+
+static int dma_soft_init(struct mtl_main_impl* impl, struct mt_dma_dev* dev,
+                         uint16_t nb_desc) {
+  struct mt_dma_soft* soft = &dev->soft_engine;
+  int idx = dev->idx;
+  int ret;
+
+  soft->descs = mt_rte_zmalloc_socket(sizeof(*soft->descs) * nb_desc, dev->soc_id);
+  if (!soft->descs) {
+    err("%s(%d), descs malloc fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+  soft->nb_desc = nb_desc;
+  soft->iova_va = (rte_eal_iova_mode() == RTE_IOVA_VA);
+  soft->latency_ns = (uint64_t)mt_get_user_params(impl)->sw_dma_latency_us * NS_PER_US;
+  soft->enqueued = 0;
+  soft->reaped = 0;
+  rte_atomic64_set(&soft->submitted, 0);
+  rte_atomic64_set(&soft->completed, 0);
+  soft->stat_submitted = 0;
+  soft->stat_completed = 0;
+
+  rte_atomic32_set(&soft->stop_thread, 0);
+  ret = pthread_create(&soft->tid, NULL, dma_soft_thread, dev);
+  if (ret) {
+    err("%s(%d), thread create fail %d\n", __func__, idx, ret);
+    soft->tid = 0;
+    dma_soft_stop(dev);
+    return -EIO;
+  }
+
+  info("%s(%d), nb_desc %u latency %" PRIu64 "ns\n", __func__, idx, nb_desc,
+       soft->latency_ns);
+  return 0;
+}
+
 static int dma_copy_test(struct mtl_main_impl* impl, struct mtl_dma_lender_dev* dev,
                          uint32_t off, uint32_t len) {
   void *dst = NULL, *src = NULL;
@@ -227,6 +370,15 @@ static int dma_hw_start(struct mtl_main_impl* impl, struct mt_dma_dev* dev,
 
   dbg("%s(%d), start\n", __func__, idx);
 
+  if (dev->soft) {
+    ret = dma_soft_init(impl, dev, nb_desc);
+    if (ret < 0) return ret;
+    /* perform the copy ops check */
+    ret = dma_copy_test(impl, &dev->lenders[0], 0, 32);
+    if (ret < 0) dma_soft_stop(dev);
+    return ret;
+  }
+
   ret = rte_dma_configure(dev_id, &dev_config);
   if (ret < 0) {
     err("%s(%d), rte_dma_configure fail %d\n", __func__, idx, ret);
@@ -261,6 +413,8 @@ static int dma_hw_stop(struct mt_dma_dev* dev) {
   int16_t dev_id = dev->dev_id;
   int ret, idx = dev->idx;
 
+  if (dev->soft) return dma_soft_stop(dev);
+
   ret = rte_dma_stop(dev_id);
   if (ret < 0) err("%s(%d), rte_dma_stop fail %d\n", __func__, idx, ret);
 
@@ -274,8 +428,20 @@ static int dma_stat(void* priv) {
   struct rte_dma_stats stats;
   uint64_t avg_nb_inflight = 0;
 
-  rte_dma_stats_get(dev_id, 0, &stats);
-  rte_dma_stats_reset(dev_id, 0);
+  if (dev->soft) {
+    struct mt_dma_soft* soft = &dev->soft_engine;
+    uint64_t submitted = rte_atomic64_read(&soft->submitted);
+    uint64_t completed = rte_atomic64_read(&soft->completed);
+
+    stats.submitted = submitted - soft->stat_submitted;
+    stats.completed = completed - soft->stat_completed;
+    stats.errors = 0;
+    soft->stat_submitted = submitted;
+    soft->stat_completed = completed;
+  } else {
+    rte_dma_stats_get(dev_id, 0, &stats);
+    rte_dma_stats_reset(dev_id, 0);
+  }
   if (dev->stat_commit_sum)
     avg_nb_inflight = dev->stat_inflight_sum / dev->stat_commit_sum;
   dev->stat_inflight_sum = 0;
@@ -399,7 +565,9 @@ struct mtl_dma_lender_dev* mt_dma_request_dev(struct mtl_main_impl* impl,
   /* now try to create a new dma */
   for (idx = 0; idx < MTL_DMA_DEV_MAX; idx++) {
     dev = &mgr->devs[idx];
-    if (dev->usable && !dev->active && (dev->soc_id == req->socket_id)) {
+    if (dev->usable && !dev->active && (dev->soft || dev->soc_id == req->socket_id)) {
+      /* the soft dma follows the socket of the first request */
+      if (dev->soft) dev->soc_id = req->socket_id;
       ret = dma_hw_start(impl, dev, nb_desc);
       if (ret < 0) {
         err("%s(%d), dma hw start fail %d\n", __func__, idx, ret);
@@ -462,12 +630,24 @@ int mt_dma_free_dev(struct mtl_main_impl* impl, struct mtl_dma_lender_dev* dev)
 int mt_dma_copy(struct mtl_dma_lender_dev* dev, rte_iova_t dst, rte_iova_t src,
                 uint32_t length) {
   struct mt_dma_dev* dma_dev = dev->parent;
+
+  if (dma_dev->soft) {
+    struct mt_dma_soft* soft = &dma_dev->soft_engine;
+    void* src_va = dma_soft_iova2va(soft, src);
+    if (!src_va) return -EINVAL;
+    return dma_soft_enqueue(soft, dma_soft_iova2va(soft, dst), src_va, 0, length);
+  }
   return rte_dma_copy(dma_dev->dev_id, 0, src, dst, length, 0);
 }
 
 int mt_dma_fill(struct mtl_dma_lender_dev* dev, rte_iova_t dst, uint64_t pattern,
                 uint32_t length) {
   struct mt_dma_dev* dma_dev = dev->parent;
+
+  if (dma_dev->soft) {
+    struct mt_dma_soft* soft = &dma_dev->soft_engine;
+    return dma_soft_enqueue(soft, dma_soft_iova2va(soft, dst), NULL, pattern, length);
+  }
   return rte_dma_fill(dma_dev->dev_id, 0, pattern, dst, length, 0);
 }
 
@@ -475,12 +655,14 @@ int mt_dma_submit(struct mtl_dma_lender_dev* dev) {
   struct mt_dma_dev* dma_dev = dev->parent;
   dma_dev->stat_commit_sum++;
   dma_dev->stat_inflight_sum += dma_dev->nb_inflight;
+  if (dma_dev->soft) return dma_soft_submit(&dma_dev->soft_engine);
   return rte_dma_submit(dma_dev->dev_id, 0);
 }
 
 uint16_t mt_dma_completed(struct mtl_dma_lender_dev* dev, uint16_t nb_cpls,
                           uint16_t* last_idx, bool* has_error) {
   struct mt_dma_dev* dma_dev = dev->parent;
+  if (dma_dev->soft) return dma_soft_completed(&dma_dev->soft_engine, nb_cpls);
   return rte_dma_completed(dma_dev->dev_id, 0, nb_cpls, NULL, NULL);
 }
 
@@ -557,6 +739,25 @@ int mt_dma_init(struct mtl_main_impl* impl) {
     }
     idx++;
   }
+
+  if (mt_has_sw_dma(impl)) {
+    /* soft dma on the left slots, the copy thread is created at the request time */
+    for (; idx < MTL_DMA_DEV_MAX; idx++) {
+      dev = &mgr->devs[idx];
+      dev->dev_id = -1;
+      dev->soft = true;
+      dev->soc_id = mt_socket_id(impl, MTL_PORT_P);
+      dev->usable = true;
+      dev->nb_session = 0;
+      info("%s(%d), soft dma dev\n", __func__, idx);
+      for (int render = 0; render < MT_DMA_MAX_SESSIONS; render++) {
+        lender_dev = &dev->lenders[render];
+        lender_dev->parent = dev;
+        lender_dev->lender_id = render;
+        lender_dev->active = false;
+      }
+    }
+  }
   mgr->num_dma_dev = idx;
 
   return 0;
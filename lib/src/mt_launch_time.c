@@ -0,0 +1,447 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+#include "mt_launch_time.h"
+
+#include "mt_dev.h"
+#include "mt_log.h"
+#include "mt_shared_queue.h"
+#include "mt_stat.h"
+#include "mt_util.h"
+
+#define MT_LTQ_RING_SIZE (1024)
+#define MT_LTQ_RING_PREFIX "LT_"
+/* busy polling window before the launch time, the sleep wakeup is not precise */
+#define MT_LTQ_SPIN_NS (20 * NS_PER_US)
+/* sleep time if no pkt is waiting */
+#define MT_LTQ_IDLE_US (10)
+
+static inline void ltq_lock(struct mt_ltq_impl* ltq) { rte_spinlock_lock(&ltq->mutex); }
+
+static inline void ltq_unlock(struct mt_ltq_impl* ltq) {
+  rte_spinlock_unlock(&ltq->mutex);
+}
+
+/* the launch time in ptp, 0 for the pkts without one like the pad or rtcp */
+static inline uint64_t ltq_launch_time(struct rte_mbuf* m) {
+  if (rte_pktmbuf_priv_size(m->pool) < sizeof(struct mt_muf_priv_data)) return 0;
+  return st_tx_mbuf_get_ptp(m);
+}
+
+static inline void ltq_hist_record(struct mtl_hist* hist, uint64_t ns) {
+  hist->buckets[mtl_hist_bucket(ns)]++;
+  hist->count++;
+  hist->sum_ns += ns;
+  if (ns > hist->max_ns) hist->max_ns = ns;
+}
+
+static uint64_t ltq_hist_percentile(struct mtl_hist* hist, int percent) {
+  uint64_t target = hist->count * percent / 100;
+  uint64_t sum = 0;
+
+  if (!hist->count) return 0;
+  for (int i = 0; i < MTL_HIST_BUCKETS; i++) {
+    sum += hist->buckets[i];
+    if (sum > target) return mtl_hist_bucket_low(i);
+  }
+  return hist->max_ns;
+}
+
+static void ltq_stat_merge(struct mt_ltq_stat* dst, struct mt_ltq_stat* src) {
+  dst->pkts += src->pkts;
+  dst->early_pkts += src->early_pkts;
+  dst->early_max_ns = RTE_MAX(dst->early_max_ns, src->early_max_ns);
+  dst->ahead_max_pkts = RTE_MAX(dst->ahead_max_pkts, src->ahead_max_pkts);
+  dst->late.count += src->late.count;
+  dst->late.sum_ns += src->late.sum_ns;
+  dst->late.max_ns = RTE_MAX(dst->late.max_ns, src->late.max_ns);
+  for (int i = 0; i < MTL_HIST_BUCKETS; i++) dst->late.buckets[i] += src->late.buckets[i];
+}
+
+/* record the departure of the pkts, the launch time is read before the tx */
+static void ltq_depart(struct mt_ltq_entry* entry, uint64_t* launch, uint16_t nb,
+                       uint64_t now) {
+  struct mt_ltq_stat* stat = &entry->stat;
+  uint32_t ahead = 0;
+
+  for (uint16_t i = 0; i < nb; i++) {
+    if (!launch[i]) continue; /* no launch time, the pad pkts */
+    stat->pkts++;
+    if (now < launch[i]) {
+      stat->early_pkts++;
+      stat->early_max_ns = RTE_MAX(stat->early_max_ns, launch[i] - now);
+    } else {
+      ltq_hist_record(&stat->late, now - launch[i]);
+    }
+    entry->ahead_launch[entry->ahead_pos % MT_LTQ_AHEAD_MAX] = launch[i];
+    entry->ahead_pos++;
+  }
+
+  /* the departed pkts which are still ahead of the launch time at this moment */
+  for (uint32_t i = 1; i <= RTE_MIN(entry->ahead_pos, MT_LTQ_AHEAD_MAX); i++) {
+    if (entry->ahead_launch[(entry->ahead_pos - i) % MT_LTQ_AHEAD_MAX] <= now) break;
+    ahead++;
+  }
+  if (ahead > stat->ahead_max_pkts) stat->ahead_max_pkts = ahead;
+}
+
+static inline uint16_t ltq_entry_tx(struct mt_ltq_entry* entry, struct rte_mbuf** pkts,
+                                    uint16_t nb_pkts) {
+  if (entry->tsq)
+    return mt_tsq_burst(entry->tsq, pkts, nb_pkts);
+  else
+    return mt_dev_tx_burst(entry->txq, pkts, nb_pkts);
+}
+
+/*
+ * release the pkts which reach the launch time, call with the ltq lock.
+ * return the ptp time to poll this entry again, UINT64_MAX if no pkt is waiting.
+ */
+static uint64_t ltq_entry_poll(struct mt_ltq_entry* entry, uint64_t now) {
+  uint64_t launch[MT_LTQ_BURST_SIZE];
+  uint16_t start, n = 0, tx;
+
+  if (entry->pkts_idx >= entry->pkts_num) {
+    entry->pkts_idx = 0;
+    entry->pkts_num = rte_ring_sc_dequeue_burst(entry->ring, (void**)entry->pkts,
+                                                MT_LTQ_BURST_SIZE, NULL);
+    if (!entry->pkts_num) return UINT64_MAX;
+  }
+
+  start = entry->pkts_idx;
+  while (start + n < entry->pkts_num) {
+    launch[n] = ltq_launch_time(entry->pkts[start + n]);
+    /* a launch time too far away is invalid, send it directly */
+    if ((launch[n] > now) && (launch[n] - now < NS_PER_S)) break;
+    n++;
+  }
+  /* the head pkt is waiting the launch time */
+  if (!n) return launch[0];
+
+  tx = ltq_entry_tx(entry, &entry->pkts[start], n);
+  entry->pkts_idx += tx;
+  ltq_depart(entry, launch, tx, now);
+  /* the queue is full or more pkts are ready, poll again at once */
+  return now;
+}
+
+static void* ltq_thread(void* arg) {
+  struct mt_ltq_impl* ltq = arg;
+  struct mtl_main_impl* impl = ltq->parent;
+  struct mt_ltq_entry* entry;
+  uint64_t now, next;
+
+  info("%s(%d), start\n", __func__, ltq->port);
+  while (rte_atomic32_read(&ltq->stop_thread) == 0) {
+    ltq_lock(ltq);
+    if (!MT_TAILQ_FIRST(&ltq->head)) {
+      ltq_unlock(ltq);
+      mt_sleep_ms(1);
+      continue;
+    }
+    now = mt_get_ptp_time(impl, ltq->port);
+    next = UINT64_MAX;
+    MT_TAILQ_FOREACH(entry, &ltq->head, next) {
+      if (entry->hold) next = RTE_MIN(next, ltq_entry_poll(entry, now));
+    }
+    ltq_unlock(ltq);
+
+    /* sleep without the lock, only busy poll the last window before the launch time */
+    if (next == UINT64_MAX) {
+      mt_sleep_us(MT_LTQ_IDLE_US);
+      continue;
+    }
+    now = mt_get_ptp_time(impl, ltq->port);
+    if (next > now + MT_LTQ_SPIN_NS)
+      mt_sleep_us((next - now - MT_LTQ_SPIN_NS) / NS_PER_US);
+  }
+  info("%s(%d), stop\n", __func__, ltq->port);
+
+  return NULL;
+}
+
+static int ltq_thread_start(struct mt_ltq_impl* ltq) {
+  int ret;
+
+  rte_atomic32_set(&ltq->stop_thread, 0);
+  ret = pthread_create(&ltq->tid, NULL, ltq_thread, ltq);
+  if (ret < 0) {
+    err("%s(%d), ltq thread create fail %d\n", __func__, ltq->port, ret);
+    return ret;
+  }
+
+  return 0;
+}
+
+static int ltq_thread_stop(struct mt_ltq_impl* ltq) {
+  rte_atomic32_set(&ltq->stop_thread, 1);
+  if (ltq->tid) {
+    pthread_join(ltq->tid, NULL);
+    ltq->tid = 0;
+  }
+
+  return 0;
+}
+
+/* sum the stat of the freed and the active entries, call with the ltq lock */
+static void ltq_stat_sum(struct mt_ltq_impl* ltq, struct mt_ltq_stat* sum) {
+  struct mt_ltq_entry* entry;
+
+  memset(sum, 0, sizeof(*sum));
+  ltq_stat_merge(sum, &ltq->stat);
+  MT_TAILQ_FOREACH(entry, &ltq->head, next) { ltq_stat_merge(sum, &entry->stat); }
+}
+
+static int ltq_stat(void* priv) {
+  struct mt_ltq_impl* ltq = priv;
+  enum mtl_port port = ltq->port;
+  struct mt_ltq_stat* sum;
+
+  sum = mt_rte_zmalloc_socket(sizeof(*sum), mt_socket_id(ltq->parent, port));
+  if (!sum) return -ENOMEM;
+  ltq_lock(ltq);
+  ltq_stat_sum(ltq, sum);
+  ltq_unlock(ltq);
+
+  notice("LTQ(%d): pkts %" PRIu64 ", early %" PRIu64 " max %" PRIu64 "ns\n", port,
+         sum->pkts, sum->early_pkts, sum->early_max_ns);
+  if (sum->late.count) {
+    notice("LTQ(%d): late avg %" PRIu64 "ns p99 %" PRIu64 "ns max %" PRIu64
+           "ns, ahead max %u pkts\n",
+           port, sum->late.sum_ns / sum->late.count, ltq_hist_percentile(&sum->late, 99),
+           sum->late.max_ns, sum->ahead_max_pkts);
+  }
+
+  mt_rte_free(sum);
+  return 0;
+}
+
+struct mt_ltq_entry* mt_ltq_get(struct mtl_main_impl* impl, enum mtl_port port,
+                                struct mt_tx_queue* txq, struct mt_tsq_entry* tsq,
+                                bool hold) {
+  struct mt_ltq_impl* ltq = impl->ltq[port];
+  struct mt_ltq_entry* entry;
+
+  if (!ltq) {
+    err("%s(%d), launch time emulation not enabled\n", __func__, port);
+    return NULL;
+  }
+
+  entry = mt_rte_zmalloc_socket(sizeof(*entry), mt_socket_id(impl, port));
+  if (!entry) {
+    err("%s(%d), malloc fail\n", __func__, port);
+    return NULL;
+  }
+  entry->parent = ltq;
+  entry->txq = txq;
+  entry->tsq = tsq;
+  entry->hold = hold;
+
+  ltq_lock(ltq);
+  entry->idx = ltq->entry_idx++;
+  ltq_unlock(ltq);
+
+  if (hold) {
+    char ring_name[32];
+    snprintf(ring_name, 32, "%sP%d_%d", MT_LTQ_RING_PREFIX, port, entry->idx);
+    /* single producer(the tx tasklet) and single consumer(the ltq thread) */
+    unsigned int flags = RING_F_SP_ENQ | RING_F_SC_DEQ;
+    entry->ring =
+        rte_ring_create(ring_name, MT_LTQ_RING_SIZE, mt_socket_id(impl, port), flags);
+    if (!entry->ring) {
+      err("%s(%d,%d), ring create fail\n", __func__, port, entry->idx);
+      mt_rte_free(entry);
+      return NULL;
+    }
+  }
+
+  ltq_lock(ltq);
+  MT_TAILQ_INSERT_TAIL(&ltq->head, entry, next);
+  ltq_unlock(ltq);
+
+  info("%s(%d,%d), succ, %s\n", __func__, port, entry->idx, hold ? "hold" : "measure");
+  return entry;
+}
+
+uint16_t mt_ltq_burst(struct mt_ltq_entry* entry, struct rte_mbuf** tx_pkts,
+                      uint16_t nb_pkts) {
+  struct mt_ltq_impl* ltq = entry->parent;
+  uint64_t launch[nb_pkts];
+  uint64_t now;
+  uint16_t tx;
+
+  if (entry->hold)
+    return rte_ring_sp_enqueue_burst(entry->ring, (void**)tx_pkts, nb_pkts, NULL);
+
+  /* measure only, the pkts may be freed by the NIC after the tx */
+  for (uint16_t i = 0; i < nb_pkts; i++) launch[i] = ltq_launch_time(tx_pkts[i]);
+  now = mt_get_ptp_time(ltq->parent, ltq->port);
+  tx = ltq_entry_tx(entry, tx_pkts, nb_pkts);
+  ltq_depart(entry, launch, tx, now);
+  return tx;
+}
+
+int mt_ltq_flush(struct mt_ltq_entry* entry) {
+  struct mt_ltq_impl* ltq = entry->parent;
+
+  if (!entry->hold) return 0;
+
+  ltq_lock(ltq);
+  if (entry->pkts_idx < entry->pkts_num) {
+    rte_pktmbuf_free_bulk(&entry->pkts[entry->pkts_idx],
+                          entry->pkts_num - entry->pkts_idx);
+    entry->pkts_idx = entry->pkts_num = 0;
+  }
+  mt_ring_dequeue_clean(entry->ring);
+  ltq_unlock(ltq);
+
+  return 0;
+}
+
+int mt_ltq_put(struct mt_ltq_entry* entry) {
+  struct mt_ltq_impl* ltq = entry->parent;
+
+  ltq_lock(ltq);
+  MT_TAILQ_REMOVE(&ltq->head, entry, next);
+  ltq_stat_merge(&ltq->stat, &entry->stat);
+  ltq_unlock(ltq);
+
+  if (entry->ring) {
+    if (entry->pkts_idx < entry->pkts_num)
+      rte_pktmbuf_free_bulk(&entry->pkts[entry->pkts_idx],
+                            entry->pkts_num - entry->pkts_idx);
+    mt_ring_dequeue_clean(entry->ring);
+    rte_ring_free(entry->ring);
+    entry->ring = NULL;
+  }
+
+  info("%s(%d,%d), succ\n", __func__, ltq->port, entry->idx);
+  mt_rte_free(entry);
+  return 0;
+}
+
+int mt_ltq_init(struct mtl_main_impl* impl) {
+  int num_ports = mt_num_ports(impl);
+  int ret;
+
+  if (!mt_has_tx_launch_time_emu(impl)) return 0;
+
+  for (int i = 0; i < num_ports; i++) {
+    impl->ltq[i] = mt_rte_zmalloc_socket(sizeof(*impl->ltq[i]), mt_socket_id(impl, i));
+    if (!impl->ltq[i]) {
+      err("%s(%d), ltq malloc fail\n", __func__, i);
+      mt_ltq_uinit(impl);
+      return -ENOMEM;
+    }
+    struct mt_ltq_impl* ltq = impl->ltq[i];
+
+    ltq->port = i;
+    ltq->parent = impl;
+    rte_spinlock_init(&ltq->mutex);
+    MT_TAILQ_INIT(&ltq->head);
+
+    ret = ltq_thread_start(ltq);
+    if (ret < 0) {
+      err("%s(%d), ltq_thread_start fail\n", __func__, i);
+      mt_ltq_uinit(impl);
+      return ret;
+    }
+
+    mt_stat_register(impl, ltq_stat, ltq, "ltq");
+
+    warn("%s(%d), tx launch time emulation enabled, for test only\n", __func__, i);
+  }
+
+  return 0;
+}
+
+int mt_ltq_uinit(struct mtl_main_impl* impl) {
+  int num_ports = mt_num_ports(impl);
+
+  for (int i = 0; i < num_ports; i++) {
+    struct mt_ltq_impl* ltq = impl->ltq[i];
+    if (!ltq) continue;
+
+    mt_stat_unregister(impl, ltq_stat, ltq);
+    ltq_thread_stop(ltq);
+    struct mt_ltq_entry* entry;
+    while ((entry = MT_TAILQ_FIRST(&ltq->head))) {
+      warn("%s(%d), still has entry %d\n", __func__, i, entry->idx);
+      mt_ltq_put(entry);
+    }
+
+    mt_rte_free(ltq);
+    impl->ltq[i] = NULL;
+  }
+
+  return 0;
+}
+
+int mtl_get_tx_launch_time_stats(mtl_handle mt, enum mtl_port port,
+                                 struct mtl_tx_launch_time_stats* stats) {
+  struct mtl_main_impl* impl = mt;
+  struct mt_ltq_stat* sum;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (port >= mt_num_ports(impl)) {
+    err("%s, invalid port %d\n", __func__, port);
+    return -EIO;
+  }
+  struct mt_ltq_impl* ltq = impl->ltq[port];
+  if (!ltq) {
+    err("%s(%d), launch time emulation not enabled\n", __func__, port);
+    return -EINVAL;
+  }
+
+  sum = mt_rte_zmalloc_socket(sizeof(*sum), mt_socket_id(impl, port));
+  if (!sum) return -ENOMEM;
+  ltq_lock(ltq);
+  ltq_stat_sum(ltq, sum);
+  ltq_unlock(ltq);
+
+  memset(stats, 0, sizeof(*stats));
+  stats->pkts = sum->pkts;
+  stats->early_pkts = sum->early_pkts;
+  stats->early_max_ns = sum->early_max_ns;
+  if (sum->late.count) stats->late_avg_ns = sum->late.sum_ns / sum->late.count;
+  stats->late_p99_ns = ltq_hist_percentile(&sum->late, 99);
+  stats->late_max_ns = sum->late.max_ns;
+  stats->ahead_max_pkts = sum->ahead_max_pkts;
+  stats->pacing_way = mt_if(impl, port)->tx_pacing_way;
+
+  mt_rte_free(sum);
+  return 0;
+}
+
+int mtl_reset_tx_launch_time_stats(mtl_handle mt, enum mtl_port port) {
+  struct mtl_main_impl* impl = mt;
+  struct mt_ltq_entry* entry;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (port >= mt_num_ports(impl)) {
+    err("%s, invalid port %d\n", __func__, port);
+    return -EIO;
+  }
+  struct mt_ltq_impl* ltq = impl->ltq[port];
+  if (!ltq) {
+    err("%s(%d), launch time emulation not enabled\n", __func__, port);
+    return -EINVAL;
+  }
+
+  /* the measure only entries are updated by the tx tasklets without the lock */
+  ltq_lock(ltq);
+  memset(&ltq->stat, 0, sizeof(ltq->stat));
+  MT_TAILQ_FOREACH(entry, &ltq->head, next) {
+    memset(&entry->stat, 0, sizeof(entry->stat));
+  }
+  ltq_unlock(ltq);
+
+  return 0;
+}
@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+#ifndef _MT_LIB_LAUNCH_TIME_HEAD_H_
+#define _MT_LIB_LAUNCH_TIME_HEAD_H_
+
+#include "mt_main.h"
+
+int mt_ltq_init(struct mtl_main_impl* impl);
+int mt_ltq_uinit(struct mtl_main_impl* impl);
+
+struct mt_ltq_entry* mt_ltq_get(struct mtl_main_impl* impl, enum mtl_port port,
+                                struct mt_tx_queue* txq, struct mt_tsq_entry* tsq,
+                                bool hold);
+uint16_t mt_ltq_burst(struct mt_ltq_entry* entry, struct rte_mbuf** tx_pkts,
+                      uint16_t nb_pkts);
+/* drop all the pkts waiting the launch time */
+int mt_ltq_flush(struct mt_ltq_entry* entry);
+int mt_ltq_put(struct mt_ltq_entry* entry);
+
+static inline void mt_ltq_lock(struct mt_ltq_entry* entry) {
+  rte_spinlock_lock(&entry->parent->mutex);
+}
+
+static inline void mt_ltq_unlock(struct mt_ltq_entry* entry) {
+  rte_spinlock_unlock(&entry->parent->mutex);
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include "mt_dev.h"
 #include "mt_dhcp.h"
 #include "mt_dma.h"
+#include "mt_launch_time.h"
 #include "mt_log.h"
 #include "mt_mcast.h"
 #include "mt_ptp.h"
@@ -23,6 +24,9 @@
 #include "st2110/pipeline/st_plugin.h"
 #include "udp/udp_rxq.h"
 
+/* the instance id of the next mtl_init in this process */
+static rte_atomic32_t mt_instance_cnt;
+
 enum mtl_port mt_port_by_id(struct mtl_main_impl* impl, uint16_t port_id) {
   int num_ports = mt_num_ports(impl);
   int i;
@@ -123,6 +127,11 @@ static int mt_main_create(struct mtl_main_impl* impl) {
     err("%s, mt_tsq_init fail %d\n", __func__, ret);
     return ret;
   }
+  ret = mt_ltq_init(impl);
+  if (ret < 0) {
+    err("%s, mt_ltq_init fail %d\n", __func__, ret);
+    return ret;
+  }
 
   ret = mt_dev_if_post_init(impl);
   if (ret < 0) {
@@ -166,6 +175,12 @@ static int mt_main_create(struct mtl_main_impl* impl) {
     return ret;
   }
 
+  ret = st_cvt_pool_init(impl);
+  if (ret < 0) {
+    err("%s, st_cvt_pool_init fail %d\n", __func__, ret);
+    return ret;
+  }
+
   ret = mt_config_init(impl);
   if (ret < 0) {
     err("%s, mt_config_init fail %d\n", __func__, ret);
@@ -206,6 +221,7 @@ static int mt_main_free(struct mtl_main_impl* impl) {
   mt_ptp_uinit(impl);
   mt_dhcp_uinit(impl);
   mt_config_uinit(impl);
+  st_cvt_pool_uinit(impl);
   st_plugins_uinit(impl);
   mt_admin_uinit(impl);
   mt_cni_uinit(impl);
@@ -215,6 +231,7 @@ static int mt_main_free(struct mtl_main_impl* impl) {
   mt_map_uinit(impl);
   mt_dma_uinit(impl);
   mt_dev_if_pre_uinit(impl);
+  mt_ltq_uinit(impl);
   mt_rsq_uinit(impl);
   mt_tsq_uinit(impl);
   mt_srss_uinit(impl);
@@ -267,6 +284,14 @@ static int mt_user_params_check(struct mtl_init_params* p) {
         return ret;
       }
     }
+    /* af packet check, kernel if should has ip */
+    if (pmd == MTL_PMD_AF_PACKET) {
+      ret = mt_socket_get_if_ip(p->port[i], if_ip, if_netmask);
+      if (ret < 0) {
+        err("%s(%d), get ip fail from if %s for af_packet\n", __func__, i, p->port[i]);
+        return ret;
+      }
+    }
     if (p->net_proto[i] == MTL_PROTO_STATIC && p->pmd[i] == MTL_PMD_DPDK_USER) {
       ip = p->sip_addr[i];
       ret = mt_ip_addr_check(ip);
@@ -359,7 +384,9 @@ mtl_handle mtl_init(struct mtl_init_params* p) {
   info("st version: %s, dpdk version: %s\n", mtl_version(), rte_version());
 
   for (int i = 0; i < num_ports; i++) {
-    if (p->pmd[i] != MTL_PMD_DPDK_USER)
+    if (p->pmd[i] == MTL_PMD_AF_PACKET)
+      socket[i] = 0; /* no ethdev, the no-huge eal memory is only on socket 0 */
+    else if (p->pmd[i] != MTL_PMD_DPDK_USER)
       socket[i] = mt_dev_get_socket(kport_info.port[i]);
     else
       socket[i] = mt_dev_get_socket(p->port[i]);
@@ -392,12 +419,17 @@ mtl_handle mtl_init(struct mtl_init_params* p) {
   if (!impl) goto err_exit;
 
   rte_memcpy(&impl->user_para, p, sizeof(*p));
+  if (p->pacing_train_cache)
+    snprintf(impl->pacing_cache_path, sizeof(impl->pacing_cache_path), "%s",
+             p->pacing_train_cache);
+  mt_pthread_mutex_init(&impl->pacing_cache_mutex, NULL);
   impl->var_para.sch_default_sleep_us = 1 * US_PER_MS; /* default 1ms */
   /* use sleep zero if sleep us is smaller than this thresh */
   impl->var_para.sch_zero_sleep_threshold_us = 200;
 
   rte_memcpy(&impl->kport_info, &kport_info, sizeof(kport_info));
   impl->type = MT_HANDLE_MAIN;
+  impl->instance_id = rte_atomic32_add_return(&mt_instance_cnt, 1) - 1;
   for (int i = 0; i < num_ports; i++) {
     inf = mt_if(impl, i);
     inf->parent = impl;
@@ -531,6 +563,7 @@ int mtl_uninit(mtl_handle mt) {
   mt_main_free(impl);
 
   mt_dev_if_uinit(impl);
+  mt_pthread_mutex_destroy(&impl->pacing_cache_mutex);
   mt_rte_free(impl);
 
   mt_dev_uinit(p);
@@ -719,7 +752,8 @@ mtl_iova_t mtl_dma_map(mtl_handle mt, const void* vaddr, size_t size) {
     goto fail_extmem;
   }
 
-  /* only map for MTL_PORT_P now */
+  /* only map for MTL_PORT_P now, the af_packet port has no device to map */
+  if (mt_pmd_is_af_packet(impl, MTL_PORT_P)) return iova;
   ret = rte_dev_dma_map(mt_port_device(impl, MTL_PORT_P), (void*)vaddr, iova, size);
   if (ret < 0) {
     err("%s, dma map fail(%d,%s) for add(%p,%" PRIu64 ")\n", __func__, ret,
@@ -768,8 +802,11 @@ int mtl_dma_unmap(mtl_handle mt, const void* vaddr, mtl_iova_t iova, size_t size
   ret = mt_map_remove(impl, &item);
   if (ret < 0) return ret;
 
-  /* only unmap for MTL_PORT_P now */
-  ret = rte_dev_dma_unmap(mt_port_device(impl, MTL_PORT_P), (void*)vaddr, iova, size);
+  /* only unmap for MTL_PORT_P now, the af_packet port has no device to map */
+  if (mt_pmd_is_af_packet(impl, MTL_PORT_P))
+    ret = 0;
+  else
+    ret = rte_dev_dma_unmap(mt_port_device(impl, MTL_PORT_P), (void*)vaddr, iova, size);
   if (ret < 0) {
     err("%s, dma unmap fail(%d,%s) for add(%p,%" PRIu64 ")\n", __func__, ret,
         rte_strerror(rte_errno), vaddr, size);
@@ -948,6 +985,19 @@ int mtl_sch_set_sleep_us(mtl_handle mt, uint64_t us) {
   return 0;
 }
 
+const char* mtl_sch_stats_shm_name(mtl_handle mt) {
+  struct mtl_main_impl* impl = mt;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+
+  struct mt_sch_mgr* mgr = mt_sch_get_mgr(impl);
+  if (!mgr->stats_shm) return NULL;
+  return mgr->stats_shm_name;
+}
+
 uint64_t mtl_ptp_read_time(mtl_handle mt) {
   struct mtl_main_impl* impl = mt;
   enum mtl_port port = MTL_PORT_P;
@@ -23,6 +23,7 @@
 #include "mt_mem.h"
 #include "mt_platform.h"
 #include "mt_quirk.h"
+#include "mtl_sch_stats_api.h"
 #include "st2110/st_header.h"
 
 #ifndef _MT_LIB_MAIN_HEAD_H_
@@ -50,10 +51,39 @@
 #define MT_MBUF_DEFAULT_DATA_SIZE (RTE_MBUF_DEFAULT_DATAROOM) /* 2048 */
 
 #define MT_MAX_SCH_NUM (18) /* max 18 scheduler lcore */
+/* wake up ahead of the tasklet deadline then spin, to absorb the os wakeup latency */
+#define MT_SCH_DEADLINE_SPIN_NS (20 * 1000)
+/* the window(ns) to measure the sch cpu load for the measured quota mode */
+#define MT_SCH_LOAD_WINDOW_NS (1000 * 1000 * 1000)
+/* max estimated load(%) to admit a new session in the measured quota mode */
+#define MT_SCH_LOAD_ADMIT_LIMIT (85.0)
+/* measured load(%) to mark the sch busy */
+#define MT_SCH_LOAD_BUSY_LIMIT (95.0)
+/* min utilization(%) gap between two sch to trigger a tasklet balance */
+#define MT_SCH_BALANCE_GAP (20.0)
+/* a tasklet stay at least this time(ns) on the new sch after a balance move */
+#define MT_SCH_BALANCE_COOLDOWN_NS (15 * 1000 * 1000 * 1000ull)
+
+/* TPACKET_V3 rx ring layout of the af_packet port, per rx queue */
+#define MT_AF_PACKET_BLOCK_SIZE (1024 * 1024)
+#define MT_AF_PACKET_BLOCK_NR (8)
+#define MT_AF_PACKET_FRAME_SIZE (2048)
+/* the kernel retire a partially filled block after this time */
+#define MT_AF_PACKET_BLOCK_TOV_MS (1)
+/* max rx sockets in the fanout group of one af_packet port */
+#define MT_AF_PACKET_RX_QUEUES_MAX (8)
+/* max pkts per sendmmsg and max mbuf segments per pkt */
+#define MT_AF_PACKET_TX_BURST (64)
+#define MT_AF_PACKET_TX_SEGS_MAX (4)
+/* eal memory(MB) when all ports are af_packet, no hugepage */
+#define MT_AF_PACKET_NO_HUGE_MEM_MB (2048)
 
 /* max RL items */
 #define MT_MAX_RL_ITEMS (64)
 
+/* max path len of the pacing train cache file */
+#define MT_PACING_CACHE_PATH_LEN (256)
+
 #define MT_ARP_ENTRY_MAX (60)
 
 #define MT_MCAST_GROUP_MAX (60)
@@ -117,6 +147,7 @@ enum mt_port_type {
   MT_PORT_VF,
   MT_PORT_PF,
   MT_PORT_AF_XDP,
+  MT_PORT_AF_PKT,
 };
 
 enum mt_driver_type {
@@ -129,6 +160,7 @@ enum mt_driver_type {
   MT_DRV_IGC,       /* igc, net_igc */
   MT_DRV_ENA,       /* aws ena, net_ena */
   MT_DRV_MLX5,      /* mlx, mlx5_pci */
+  MT_DRV_AF_PKT,    /* af packet, mtl_af_packet, no ethdev */
 };
 
 enum mt_flow_type {
@@ -390,6 +422,9 @@ struct mt_dhcp_impl {
 #define MT_TASKLET_HAS_PENDING (1)
 #define MT_TASKLET_ALL_DONE (0)
 
+/* the tasklet can be moved to another sch by the balancer */
+#define MT_TASKLET_BALANCE (MTL_BIT32(0))
+
 /*
  * Tasklets share the time slot on a lcore,
  * only non-block method can be used in handler routine.
@@ -412,6 +447,17 @@ struct mt_sch_tasklet_ops {
    * leave to zero if you don't know.
    */
   uint64_t advice_sleep_us;
+  /*
+   * optional, return the tsc(mt_get_tsc) time when the tasklet has the next work,
+   * return 0 if it has work now or don't know. Caller should convert a ptp target to
+   * the tsc time. The sch skip the handler until the deadline is reached, run the due
+   * tasklets in earliest deadline first order and sleep to the nearest deadline.
+   */
+  uint64_t (*deadline)(void* priv);
+  /* MT_TASKLET_* flags */
+  uint32_t flags;
+  /* the data quota(mb/s) of this tasklet, it follows the tasklet moved by balancer */
+  int quota_mbs;
 };
 
 struct mt_sch_tasklet_impl {
@@ -422,11 +468,20 @@ struct mt_sch_tasklet_impl {
   int idx;
   bool request_exit;
   bool ack_exit;
+  uint64_t deadline_tsc; /* the next deadline reported by ops.deadline */
+  /* the sch which register this tasklet, it may run on another sch by balance */
+  struct mt_sch_impl* home_sch;
+  uint64_t bal_busy_ns;      /* time of the handler calls which report pending */
+  uint64_t bal_last_move_ns; /* last balance move time */
+  bool bal_moving;           /* the balancer is moving it out of the sch locks */
+  uint64_t load_busy_ns;     /* busy time in the measured quota window */
 
   uint32_t stat_max_time_us;
   uint64_t stat_sum_time_us;
   uint64_t stat_time_cnt;
   uint32_t stat_min_time_us;
+  uint64_t stat_deadline_cnt;        /* ops.deadline calls */
+  uint64_t stat_deadline_future_cnt; /* ops.deadline calls which report a future time */
 };
 
 enum mt_sch_type {
@@ -509,6 +564,27 @@ struct mt_sch_impl {
   uint32_t stat_sleep_cnt;
   uint64_t stat_sleep_ns_min;
   uint64_t stat_sleep_ns_max;
+  uint64_t stat_deadline_skip; /* handler calls skipped as the deadline not reached */
+  uint32_t stat_deadline_spin_cnt;
+
+  /* measured quota mode, the load is the busy time of the tasklets in the window */
+  bool measured_quota;
+  uint64_t load_start_ns;
+  float load_score;      /* measured load(%) of the tasklets in last window */
+  int load_quota_mbs;    /* the data quota when the window start */
+  float load_cost;       /* measured load(%) per mb/s, 0 if not measured yet */
+  bool load_restart;     /* quota changed, restart the measure window */
+  bool load_marked_busy; /* cpu_busy set by the measured load */
+
+  /* tasklet balance */
+  bool balance;
+  bool bal_stopping; /* the sch is going to stop, no more tasklet move in */
+  int bal_hold_idx;  /* the slot held for the tasklet in a balance move, -1 if none */
+  uint64_t bal_start_ns; /* start time of the current balance window */
+
+  /* histograms in the stats shm, NULL if not enabled */
+  struct mtl_sch_stats_sch* stats;
+  uint64_t stats_last_loop_ns;
 };
 
 struct mt_sch_mgr {
@@ -516,6 +592,15 @@ struct mt_sch_mgr {
   /* active sch cnt */
   rte_atomic32_t sch_cnt;
   pthread_mutex_t mgr_mutex; /* protect sch mgr */
+
+  /* the stats shm for external tools */
+  struct mtl_sch_stats_shm* stats_shm;
+  char stats_shm_name[64];
+
+  /* the utilization(%) spread of the balance schs in the last balance round */
+  float bal_util_max;
+  float bal_util_min;
+  uint32_t bal_rounds;
 };
 
 struct mt_pacing_train_result {
@@ -523,6 +608,19 @@ struct mt_pacing_train_result {
   float pacing_pad_interval; /* result */
 };
 
+/* one in flight pacing train, later requests with same rl_bps wait for the result */
+struct mt_pacing_train_req {
+  uint64_t rl_bps;
+  float pad_interval;
+  int result; /* 0 or negative errno */
+  bool done;
+  int waiters;
+  /* link to next */
+  MT_TAILQ_ENTRY(mt_pacing_train_req) next;
+};
+
+MT_TAILQ_HEAD(mt_pacing_train_req_list, mt_pacing_train_req);
+
 struct mt_rl_shaper {
   uint64_t rl_bps; /* input, byte per sec */
   uint32_t shaper_profile_id;
@@ -546,6 +644,8 @@ struct mt_rx_queue {
   unsigned int mbuf_elements;
   /* pool for hdr split payload */
   struct rte_mempool* mbuf_payload_pool;
+  /* the rx ring socket for af_packet port, NULL for ethdev */
+  struct mt_afpkt_rxq* afpkt;
 };
 
 struct mt_tx_queue {
@@ -557,6 +657,8 @@ struct mt_tx_queue {
   bool fatal_error;
   int rl_shapers_mapping; /* map to tx_rl_shapers */
   uint64_t bps;           /* bytes per sec for rate limit */
+  /* the raw socket for af_packet port, NULL for ethdev */
+  struct mt_afpkt_txq* afpkt;
 };
 
 struct mt_dev_driver_info {
@@ -575,6 +677,8 @@ struct mt_interface {
   enum mtl_port port;
   uint16_t port_id;
   struct rte_eth_dev_info dev_info;
+  /* the kernel socket backend for af_packet port, NULL for ethdev */
+  struct mt_afpkt_impl* afpkt;
   struct mt_dev_driver_info drv_info;
   enum mtl_rss_mode rss_mode;
   enum mtl_net_proto net_proto;
@@ -620,6 +724,10 @@ struct mt_interface {
   bool tx_rl_root_active;
   /* video rl pacing train result */
   struct mt_pacing_train_result pt_results[MT_MAX_RL_ITEMS];
+  /* the in flight trains, protected by pt_mutex */
+  struct mt_pacing_train_req_list pt_reqs;
+  pthread_mutex_t pt_mutex; /* protect pt_results and pt_reqs */
+  pthread_cond_t pt_cond;   /* wake the waiters when a train done */
 
   /* function ops per interface(pf/vf) */
   uint64_t (*ptp_get_time_fn)(struct mtl_main_impl* impl, enum mtl_port port);
@@ -662,8 +770,35 @@ struct mtl_dma_lender_dev {
   mt_dma_drop_mbuf_cb cb;
 };
 
+struct mt_dma_soft_desc {
+  void* dst;
+  void* src; /* NULL for a fill */
+  uint64_t pattern;
+  uint32_t len;
+  uint64_t submit_ns; /* monotonic time of the submit, for the emulated latency */
+};
+
+/* the software dma engine, the copies are done by a dedicated thread */
+struct mt_dma_soft {
+  struct mt_dma_soft_desc* descs;
+  uint16_t nb_desc;
+  bool iova_va;             /* iova is the va, else translate by rte_mem_iova2virt */
+  uint64_t latency_ns;      /* emulated latency from the submit to the completion */
+  uint64_t enqueued;        /* updated by the enqueue side only */
+  uint64_t reaped;          /* completions returned, by the enqueue side only */
+  rte_atomic64_t submitted; /* published to the copy thread */
+  rte_atomic64_t completed; /* updated by the copy thread */
+  pthread_t tid;
+  rte_atomic32_t stop_thread;
+  /* the counters at the last stat */
+  uint64_t stat_submitted;
+  uint64_t stat_completed;
+};
+
 struct mt_dma_dev {
   int16_t dev_id;
+  bool soft; /* software engine instead of a dmadev */
+  struct mt_dma_soft soft_engine;
   uint16_t nb_desc;
   bool active;
   bool usable;
@@ -765,6 +900,40 @@ struct mt_dev_stats {
   uint64_t tx_errors;
 };
 
+/* the initial buckets of the flow hash, it doubles when the chains get longer */
+#define MT_FLOW_HASH_BUCKETS_MIN (64)
+#define MT_FLOW_HASH_BUCKETS_MAX (1 << 16)
+/* the max average nodes per bucket before the flow hash grows */
+#define MT_FLOW_HASH_LOAD_MAX (2)
+/* the synthetic pkts and the max flows of mtl_flow_hash_bench */
+#define MT_FLOW_HASH_BENCH_MBUFS (256)
+#define MT_FLOW_HASH_BENCH_FLOWS_MAX (1 << 16)
+
+enum mt_flow_hash_type {
+  MT_FLOW_HASH_FULL = 0, /* match ip and port */
+  MT_FLOW_HASH_NO_IP,    /* match port only */
+  MT_FLOW_HASH_NO_PORT,  /* match ip only */
+  MT_FLOW_HASH_ANY,      /* match all */
+  MT_FLOW_HASH_TYPE_MAX,
+};
+
+/* node of the flow hash, embedded in the flow entry */
+struct mt_flow_hash_node {
+  uint64_t key; /* ip(be) << 16 | dst port, zero for the wildcard part */
+  enum mt_flow_hash_type type;
+  void* priv; /* the owner entry */
+  struct mt_flow_hash_node* next;
+};
+
+/* hash of rx flows keyed on ip and udp dst port, caller should take care of the lock */
+struct mt_flow_hash {
+  struct mt_flow_hash_node** buckets;
+  uint32_t nb_buckets; /* power of 2 */
+  uint32_t nb_total;   /* nodes of all types */
+  int nb_nodes[MT_FLOW_HASH_TYPE_MAX];
+  int soc_id;
+};
+
 struct mt_rsq_impl; /* forward delcare */
 
 struct mt_rsq_entry {
@@ -774,6 +943,7 @@ struct mt_rsq_entry {
   struct mt_rx_flow_rsp* flow_rsp;
   struct mt_rsq_impl* parent;
   struct rte_ring* ring;
+  struct mt_flow_hash_node hash_node;
   uint32_t stat_enqueue_cnt;
   uint32_t stat_dequeue_cnt;
   uint32_t stat_enqueue_fail_cnt;
@@ -783,10 +953,12 @@ struct mt_rsq_entry {
 MT_TAILQ_HEAD(mt_rsq_entrys_list, mt_rsq_entry);
 
 struct mt_rsq_queue {
-  uint16_t port_id;
+  struct mt_rx_queue* rx_queue;
   uint16_t queue_id;
   /* List of rsq entry */
   struct mt_rsq_entrys_list head;
+  /* hash index of the entries in head for the rx dispatch */
+  struct mt_flow_hash flow_hash;
   rte_spinlock_t mutex;
   rte_atomic32_t entry_cnt;
   int entry_idx;
@@ -811,6 +983,10 @@ struct mt_txq_flow {
   /* mandatory if not sys_queue */
   uint8_t dip_addr[MTL_IP_ADDR_LEN]; /* tx destination IP */
   uint16_t dst_port;                 /* udp destination port */
+  /* the pkts carry the launch time(ptp), for MTL_FLAG_TX_LAUNCH_TIME_EMU */
+  bool launch_time;
+  /* hold the pkts until the launch time like a TSN NIC, otherwise only measure */
+  bool launch_time_hold;
 };
 
 struct mt_tsq_impl; /* forward delcare */
@@ -820,24 +996,50 @@ struct mt_tsq_entry {
   struct mt_txq_flow flow;
   struct mt_tsq_impl* parent;
   struct rte_mempool* tx_pool;
+  /*
+   * the completion of the pkts this producer enqueued to the tx ring, completed is
+   * what the nic accepted and dropped is what freed without tx. The entry can be freed
+   * only if enqueued == completed + dropped, the ring keeps a pointer to it.
+   */
+  rte_atomic64_t enqueued;
+  rte_atomic64_t completed;
+  rte_atomic64_t dropped;
+  /* put timeout, the drain free its pkts left in the tx ring instead of the tx */
+  bool dead;
   /* linked list */
   MT_TAILQ_ENTRY(mt_tsq_entry) next;
 };
 MT_TAILQ_HEAD(mt_tsq_entrys_list, mt_tsq_entry);
 
 struct mt_tsq_queue {
-  uint16_t port_id;
+  struct mt_tx_queue* tx_queue;
   uint16_t queue_id;
   /* shared tx mempool */
   struct rte_mempool* tx_pool;
   /* List of rsq entry */
   struct mt_tsq_entrys_list head;
+  /* the dead entries put with pkts still in the tx ring, freed once all done */
+  struct mt_tsq_entrys_list dead_head;
   pthread_mutex_t mutex;
+  /*
+   * mp enqueue and sc dequeue ring of struct mt_tsq_ring_elem, aggregate the pkts from
+   * all producers. Not used for the sys queue, see mt_tsq_burst.
+   */
+  struct rte_ring* tx_ring;
+  /* the drain owner, only the holder dequeue the tx_ring and burst to nic */
   rte_spinlock_t tx_mutex;
   rte_atomic32_t entry_cnt;
   bool fatal_error;
   /* stat */
   int stat_pkts_send;
+  int stat_drain_cnt;
+  int stat_nic_full_cnt;
+};
+
+/* element of the tsq tx_ring, the pkt and the producer entry for the completion */
+struct mt_tsq_ring_elem {
+  struct rte_mbuf* pkt;
+  struct mt_tsq_entry* entry;
 };
 
 struct mt_tsq_impl {
@@ -846,21 +1048,48 @@ struct mt_tsq_impl {
   /* sq tx queue resources */
   uint16_t max_tsq_queues;
   struct mt_tsq_queue* tsq_queues;
+  /* drain the pkts left in the tx rings when no producer is sending */
+  struct mt_sch_tasklet_impl* tasklet;
 };
 
+#define MT_SRSS_SCH_MAX (8)
+
 struct mt_srss_entry {
   struct mt_rxq_flow flow;
   struct mt_srss_impl* srss;
   int idx;
   struct rte_ring* ring;
-  uint32_t stat_enqueue_cnt;
-  uint32_t stat_dequeue_cnt;
-  uint32_t stat_enqueue_fail_cnt;
+  /* one node for the flow hash of each srss sch */
+  struct mt_flow_hash_node hash_node[MT_SRSS_SCH_MAX];
+  /*
+   * one counter for each srss sch, only updated by the owner of the srss sch lock. The
+   * counters never reset, the stat prints the delta from the last reported one.
+   */
+  uint32_t stat_enqueue_cnt[MT_SRSS_SCH_MAX];
+  uint32_t stat_enqueue_fail_cnt[MT_SRSS_SCH_MAX];
+  uint32_t stat_dequeue_cnt; /* only the ring consumer */
+  /* the last reported sum, only updated by the stat */
+  uint32_t stat_enqueue_reported;
+  uint32_t stat_enqueue_fail_reported;
+  uint32_t stat_dequeue_reported;
   /* linked list */
   MT_TAILQ_ENTRY(mt_srss_entry) next;
 };
 MT_TAILQ_HEAD(mt_srss_entrys_list, mt_srss_entry);
 
+/* one srss sch polls a range of the rss queues */
+struct mt_srss_sch {
+  struct mt_srss_impl* parent;
+  int idx;
+  uint16_t q_start;
+  uint16_t q_end;
+  rte_spinlock_t mutex; /* protect the queues polling and flow_hash */
+  /* hash index of the entries for the rx dispatch */
+  struct mt_flow_hash flow_hash;
+  struct mt_sch_tasklet_impl* tasklet;
+  struct mt_sch_impl* sch;
+};
+
 struct mt_srss_impl {
   struct mtl_main_impl* parent;
   rte_spinlock_t mutex; /* protect struct mt_srss_entrys_list head */
@@ -868,12 +1097,61 @@ struct mt_srss_impl {
   struct mt_srss_entrys_list head;
   pthread_t tid;
   rte_atomic32_t stop_thread;
-  struct mt_sch_tasklet_impl* tasklet;
-  struct mt_sch_impl* sch;
+  /* protect the srss thread start and stop, sleepable for the pthread_join */
+  pthread_mutex_t thread_mutex;
+  int tasklet_started; /* the number of srss sch tasklet started */
+  struct mt_srss_sch schs[MT_SRSS_SCH_MAX];
+  int schs_cnt;
   struct mt_srss_entry* cni_entry;
   int entry_idx;
 };
 
+#define MT_LTQ_BURST_SIZE (64)
+/* the number of the last departed launch time kept for the ahead count */
+#define MT_LTQ_AHEAD_MAX (64)
+
+struct mt_ltq_stat {
+  uint64_t pkts;
+  uint64_t early_pkts;
+  uint64_t early_max_ns;
+  uint32_t ahead_max_pkts;
+  /* departure time minus launch time */
+  struct mtl_hist late;
+};
+
+/* software launch time emulation of one tx queue */
+struct mt_ltq_entry {
+  struct mt_ltq_impl* parent;
+  int idx;
+  struct mt_tx_queue* txq;
+  struct mt_tsq_entry* tsq;
+  bool hold;
+  /* hold mode only, the pkts wait the launch time */
+  struct rte_ring* ring;
+  struct rte_mbuf* pkts[MT_LTQ_BURST_SIZE];
+  uint16_t pkts_idx;
+  uint16_t pkts_num;
+  uint64_t ahead_launch[MT_LTQ_AHEAD_MAX];
+  uint32_t ahead_pos;
+  /* single writer, the ltq thread for hold mode or the tx tasklet */
+  struct mt_ltq_stat stat;
+  /* linked list */
+  MT_TAILQ_ENTRY(mt_ltq_entry) next;
+};
+MT_TAILQ_HEAD(mt_ltq_entrys_list, mt_ltq_entry);
+
+struct mt_ltq_impl {
+  struct mtl_main_impl* parent;
+  rte_spinlock_t mutex; /* protect the entry list and the pkts release */
+  enum mtl_port port;
+  struct mt_ltq_entrys_list head;
+  pthread_t tid;
+  rte_atomic32_t stop_thread;
+  int entry_idx;
+  /* merged from the freed entries */
+  struct mt_ltq_stat stat;
+};
+
 struct mtl_main_impl {
   struct mt_interface inf[MTL_PORT_MAX];
 
@@ -893,6 +1171,8 @@ struct mtl_main_impl {
   /* shared rx queue mgr */
   struct mt_rsq_impl* rsq[MTL_PORT_MAX];
   struct mt_tsq_impl* tsq[MTL_PORT_MAX];
+  /* tx launch time emulation */
+  struct mt_ltq_impl* ltq[MTL_PORT_MAX];
 
   /* stat */
   pthread_t stat_tid;
@@ -906,6 +1186,7 @@ struct mtl_main_impl {
   rte_atomic32_t instance_in_reset; /* if mt instance is in reset */
   /* if mt instance is aborted, in case for ctrl-c from app */
   rte_atomic32_t instance_aborted;
+  int instance_id; /* the idx of the mt instance in this process */
   struct mt_sch_impl* main_sch; /* system sch */
 
   /* admin context */
@@ -933,6 +1214,8 @@ struct mtl_main_impl {
 
   /* st plugin dev mgr */
   struct st_plugin_mgr plugin_mgr;
+  /* the worker pool for the slice parallel convert, NULL if disabled */
+  struct st_cvt_pool_impl* cvt_pool;
 
   void* mudp_rxq_mgr[MTL_PORT_MAX];
 
@@ -963,6 +1246,11 @@ struct mtl_main_impl {
   uint16_t pkt_udp_suggest_max_size;
   uint16_t rx_pool_data_size;
   uint32_t sch_schedule_ns;
+
+  /* persisted pacing train results, empty if disabled */
+  char pacing_cache_path[MT_PACING_CACHE_PATH_LEN];
+  /* the ports train in parallel, serialize the cache file access */
+  pthread_mutex_t pacing_cache_mutex;
 };
 
 static inline struct mtl_init_params* mt_get_user_params(struct mtl_main_impl* impl) {
@@ -1014,6 +1302,13 @@ static inline bool mt_pmd_is_af_xdp(struct mtl_main_impl* impl, enum mtl_port po
     return false;
 }
 
+static inline bool mt_pmd_is_af_packet(struct mtl_main_impl* impl, enum mtl_port port) {
+  if (MTL_PMD_AF_PACKET == mt_get_user_params(impl)->pmd[port])
+    return true;
+  else
+    return false;
+}
+
 static inline int mt_num_ports(struct mtl_main_impl* impl) {
   return RTE_MIN(mt_get_user_params(impl)->num_ports, MTL_PORT_MAX);
 }
@@ -1066,6 +1361,13 @@ static inline bool mt_has_user_quota(struct mtl_main_impl* impl) {
     return false;
 }
 
+static inline bool mt_has_sch_measured_quota(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_SCH_MEASURED_QUOTA)
+    return true;
+  else
+    return false;
+}
+
 static inline bool mt_has_ebu(struct mtl_main_impl* impl) {
   if (mt_get_user_params(impl)->flags & MTL_FLAG_RX_VIDEO_EBU)
     return true;
@@ -1080,6 +1382,48 @@ static inline bool mt_has_rxv_separate_sch(struct mtl_main_impl* impl) {
     return false;
 }
 
+static inline bool mt_has_tx_mbuf_recycle(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_TX_MBUF_RECYCLE)
+    return true;
+  else
+    return false;
+}
+
+static inline bool mt_has_tx_launch_time_emu(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_TX_LAUNCH_TIME_EMU)
+    return true;
+  else
+    return false;
+}
+
+static inline bool mt_has_sw_dma(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_SW_DMA)
+    return true;
+  else
+    return false;
+}
+
+static inline bool mt_has_tx_pacing_train_fake(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_TX_PACING_TRAIN_FAKE)
+    return true;
+  else
+    return false;
+}
+
+static inline bool mt_has_sch_stats_shm(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_SCH_STATS_SHM)
+    return true;
+  else
+    return false;
+}
+
+static inline bool mt_has_tasklet_balance(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_TASKLET_BALANCE)
+    return true;
+  else
+    return false;
+}
+
 static inline bool mt_has_tx_video_migrate(struct mtl_main_impl* impl) {
   if (mt_get_user_params(impl)->flags & MTL_FLAG_TX_VIDEO_MIGRATE)
     return true;
@@ -70,7 +70,7 @@ int mcast_membership_general_query(struct mtl_main_impl* impl, enum mtl_port por
   }
 
   eth_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ether_hdr*, hdr_offset);
-  rte_eth_macaddr_get(mt_port_id(impl, port), mt_eth_s_addr(eth_hdr));
+  mt_macaddr_get(impl, port, mt_eth_s_addr(eth_hdr));
   rte_ether_addr_copy(&mcast_mac_query, mt_eth_d_addr(eth_hdr));
   eth_hdr->ether_type = htons(RTE_ETHER_TYPE_IPV4);
   hdr_offset += sizeof(*eth_hdr);
@@ -149,7 +149,7 @@ static int mcast_membership_report(struct mtl_main_impl* impl,
   }
 
   eth_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ether_hdr*, hdr_offset);
-  rte_eth_macaddr_get(mt_port_id(impl, port), mt_eth_s_addr(eth_hdr));
+  mt_macaddr_get(impl, port, mt_eth_s_addr(eth_hdr));
   rte_ether_addr_copy(&mcast_mac_dst, mt_eth_d_addr(eth_hdr));
   eth_hdr->ether_type = htons(RTE_ETHER_TYPE_IPV4);
   hdr_offset += sizeof(*eth_hdr);
@@ -286,6 +286,7 @@ static int mcast_inf_add_mac(struct mt_interface* inf, struct rte_ether_addr* mc
   }
 
   mcast_addr_pool_append(inf, mcast_mac);
+  if (inf->afpkt) return mt_afpkt_mcast_mac(inf, mcast_mac, true);
   if (inf->drv_info.use_mc_addr_list)
     return rte_eth_dev_set_mc_addr_list(port_id, inf->mcast_mac_lists, inf->mcast_nb);
   else
@@ -308,6 +309,7 @@ static int mcast_inf_remove_mac(struct mt_interface* inf,
   }
 
   mcast_addr_pool_remove(inf, i);
+  if (inf->afpkt) return mt_afpkt_mcast_mac(inf, mcast_mac, false);
   if (inf->drv_info.use_mc_addr_list)
     return rte_eth_dev_set_mc_addr_list(port_id, inf->mcast_mac_lists, inf->mcast_nb);
   else
@@ -454,7 +456,10 @@ int mt_mcast_restore(struct mtl_main_impl* impl, enum mtl_port port) {
   struct mt_interface* inf = mt_if(impl, port);
   uint16_t port_id = inf->port_id;
 
-  if (inf->drv_info.use_mc_addr_list) {
+  if (inf->afpkt) {
+    for (uint32_t i = 0; i < inf->mcast_nb; i++)
+      mt_afpkt_mcast_mac(inf, &inf->mcast_mac_lists[i], true);
+  } else if (inf->drv_info.use_mc_addr_list) {
     rte_eth_dev_set_mc_addr_list(port_id, inf->mcast_mac_lists, inf->mcast_nb);
   } else {
     for (uint32_t i = 0; i < inf->mcast_nb; i++)
@@ -21,7 +21,9 @@
 #include <netinet/udp.h>
 #include <numa.h>
 #include <poll.h>
+#include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/shm.h>
 #include <sys/socket.h>
 
@@ -129,6 +131,10 @@ static inline int mt_pthread_cond_signal(pthread_cond_t* cond) {
   return pthread_cond_signal(cond);
 }
 
+static inline int mt_pthread_cond_broadcast(pthread_cond_t* cond) {
+  return pthread_cond_broadcast(cond);
+}
+
 static inline bool mt_socket_match(int cpu_socket, int dev_socket) {
 #ifdef WINDOWSENV
   return true;  // windows cpu socket always 0
@@ -98,6 +98,11 @@ struct mt_txq_entry* mt_txq_get(struct mtl_main_impl* impl, enum mtl_port port,
     entry->queue_id = mt_dev_tx_queue_id(entry->txq);
   }
 
+  if (flow->launch_time && mt_has_tx_launch_time_emu(impl)) {
+    entry->ltq = mt_ltq_get(impl, port, entry->txq, entry->tsq, flow->launch_time_hold);
+    if (!entry->ltq) goto fail;
+  }
+
   return entry;
 
 fail:
@@ -106,6 +111,10 @@ fail:
 }
 
 int mt_txq_put(struct mt_txq_entry* entry) {
+  if (entry->ltq) {
+    mt_ltq_put(entry->ltq);
+    entry->ltq = NULL;
+  }
   if (entry->txq) {
     mt_dev_put_tx_queue(entry->parent, entry->txq);
     entry->txq = NULL;
@@ -119,18 +128,23 @@ int mt_txq_put(struct mt_txq_entry* entry) {
 }
 
 int mt_txq_fatal_error(struct mt_txq_entry* entry) {
+  if (entry->ltq) mt_ltq_flush(entry->ltq);
   if (entry->txq) mt_dev_tx_queue_fatal_error(entry->parent, entry->txq);
   if (entry->tsq) mt_tsq_fatal_error(entry->tsq);
   return 0;
 }
 
 int mt_txq_done_cleanup(struct mt_txq_entry* entry) {
+  /* the ltq thread may be in the tx burst of this queue */
+  if (entry->ltq) mt_ltq_lock(entry->ltq);
   if (entry->txq) mt_dev_tx_done_cleanup(entry->parent, entry->txq);
   if (entry->tsq) mt_tsq_done_cleanup(entry->tsq);
+  if (entry->ltq) mt_ltq_unlock(entry->ltq);
   return 0;
 }
 
 int mt_txq_flush(struct mt_txq_entry* entry, struct rte_mbuf* pad) {
+  if (entry->ltq) mt_ltq_flush(entry->ltq);
   if (entry->tsq)
     return mt_tsq_flush(entry->parent, entry->tsq, pad);
   else
@@ -139,7 +153,9 @@ int mt_txq_flush(struct mt_txq_entry* entry, struct rte_mbuf* pad) {
 
 uint16_t mt_txq_burst(struct mt_txq_entry* entry, struct rte_mbuf** tx_pkts,
                       uint16_t nb_pkts) {
-  if (entry->tsq)
+  if (entry->ltq)
+    return mt_ltq_burst(entry->ltq, tx_pkts, nb_pkts);
+  else if (entry->tsq)
     return mt_tsq_burst(entry->tsq, tx_pkts, nb_pkts);
   else
     return mt_dev_tx_burst(entry->txq, tx_pkts, nb_pkts);
@@ -4,6 +4,7 @@
 
 #include "mt_cni.h"
 #include "mt_dev.h"
+#include "mt_launch_time.h"
 #include "mt_shared_queue.h"
 #include "mt_shared_rss.h"
 
@@ -33,6 +34,7 @@ struct mt_txq_entry {
   uint16_t queue_id;
   struct mt_tx_queue* txq;
   struct mt_tsq_entry* tsq;
+  struct mt_ltq_entry* ltq;
 };
 
 struct mt_txq_entry* mt_txq_get(struct mtl_main_impl* impl, enum mtl_port port,
@@ -6,6 +6,7 @@
 
 #include "mt_dev.h"
 #include "mt_log.h"
+#include "mt_sch_test.h"
 #include "mt_stat.h"
 #include "st2110/st_rx_ancillary_session.h"
 #include "st2110/st_rx_audio_session.h"
@@ -30,6 +31,33 @@ static inline void sch_unlock(struct mt_sch_impl* sch) {
   mt_pthread_mutex_unlock(&sch->mutex);
 }
 
+static inline void sch_hist_record(struct mtl_hist* hist, uint64_t ns) {
+  hist->buckets[mtl_hist_bucket(ns)]++;
+  hist->count++;
+  hist->sum_ns += ns;
+  if (ns > hist->max_ns) hist->max_ns = ns;
+}
+
+/* update the shm slot of a tasklet, call before the tasklet is visible to the loop */
+static void sch_stats_slot_set(struct mt_sch_impl* sch, int idx, const char* name) {
+  struct mtl_sch_stats_sch* stats = sch->stats;
+  if (!stats || idx >= sch->nb_tasklets) return;
+
+  struct mtl_sch_stats_tasklet* slot = mtl_sch_stats_get_tasklet(stats, idx);
+  slot->gen++;
+  rte_smp_wmb();
+  if (name) {
+    snprintf(slot->name, sizeof(slot->name), "%s", name);
+    memset(&slot->run_time, 0, sizeof(slot->run_time));
+    slot->active = 1;
+  } else {
+    slot->active = 0;
+  }
+  rte_smp_wmb();
+  slot->gen++;
+  stats->nb_tasklets = sch->nb_tasklets;
+}
+
 static void sch_sleep_wakeup(struct mt_sch_impl* sch) {
   mt_pthread_mutex_lock(&sch->sleep_wake_mutex);
   mt_pthread_cond_signal(&sch->sleep_wake_cond);
@@ -42,7 +70,31 @@ static void sch_sleep_alarm_handler(void* param) {
   sch_sleep_wakeup(sch);
 }
 
-static int sch_tasklet_sleep(struct mtl_main_impl* impl, struct mt_sch_impl* sch) {
+static void sch_tasklet_deadline_wait(struct mtl_main_impl* impl,
+                                      struct mt_sch_impl* sch, uint64_t deadline_tsc) {
+  uint64_t cur_tsc = mt_get_tsc(impl);
+
+  if (deadline_tsc <= cur_tsc) return;
+
+  uint64_t delta = deadline_tsc - cur_tsc;
+  if (delta > MT_SCH_DEADLINE_SPIN_NS) {
+    /* absolute wait without the alarm thread, wake up ahead of the deadline */
+    struct timespec abs_time;
+    clock_gettime(MT_THREAD_TIMEDWAIT_CLOCK_ID, &abs_time);
+    mt_ns_to_timespec(mt_timespec_to_ns(&abs_time) + delta - MT_SCH_DEADLINE_SPIN_NS,
+                      &abs_time);
+    mt_pthread_mutex_lock(&sch->sleep_wake_mutex);
+    mt_pthread_cond_timedwait(&sch->sleep_wake_cond, &sch->sleep_wake_mutex, &abs_time);
+    mt_pthread_mutex_unlock(&sch->sleep_wake_mutex);
+  }
+
+  /* spin for the remaining */
+  while (mt_get_tsc(impl) < deadline_tsc) rte_pause();
+  sch->stat_deadline_spin_cnt++;
+}
+
+static int sch_tasklet_sleep(struct mtl_main_impl* impl, struct mt_sch_impl* sch,
+                             uint64_t deadline_tsc) {
   /* get sleep us */
   uint64_t sleep_us = mt_sch_default_sleep_us(impl);
   uint64_t force_sleep_us = mt_sch_force_sleep_us(impl);
@@ -64,9 +116,16 @@ static int sch_tasklet_sleep(struct mtl_main_impl* impl, struct mt_sch_impl* sch
 
   /* sleep now */
   uint64_t start = mt_get_tsc(impl);
-  if (sleep_us < mt_sch_zero_sleep_thresh_us(impl)) {
+  uint64_t target_ns = 0;
+  if (deadline_tsc && !force_sleep_us &&
+      (deadline_tsc <= start + sleep_us * NS_PER_US)) {
+    /* the nearest tasklet deadline comes before the advice sleep */
+    if (deadline_tsc > start) target_ns = deadline_tsc - start;
+    sch_tasklet_deadline_wait(impl, sch, deadline_tsc);
+  } else if (sleep_us < mt_sch_zero_sleep_thresh_us(impl)) {
     mt_sleep_ms(0);
   } else {
+    target_ns = sleep_us * NS_PER_US;
     struct timespec abs_time;
     clock_gettime(MT_THREAD_TIMEDWAIT_CLOCK_ID, &abs_time);
     abs_time.tv_sec += 1; /* timeout 1s */
@@ -78,6 +137,10 @@ static int sch_tasklet_sleep(struct mtl_main_impl* impl, struct mt_sch_impl* sch
   }
   uint64_t end = mt_get_tsc(impl);
   uint64_t delta = end - start;
+  if (sch->stats) {
+    uint64_t overshoot = delta > target_ns ? delta - target_ns : 0;
+    sch_hist_record(&sch->stats->sleep_overshoot, overshoot);
+  }
   sch->stat_sleep_ns += delta;
   sch->stat_sleep_cnt++;
   sch->stat_sleep_ns_min = RTE_MIN(delta, sch->stat_sleep_ns_min);
@@ -99,6 +162,115 @@ static int sch_tasklet_sleep(struct mtl_main_impl* impl, struct mt_sch_impl* sch
   return 0;
 }
 
+/* the measured cost is stale once the quota change, call with the sch lock */
+static inline void sch_load_reset(struct mt_sch_impl* sch) {
+  sch->load_restart = true;
+  sch->load_cost = 0;
+}
+
+/* the load is the sum of the tasklets busy time, not the loop level busy ratio */
+static void sch_load_update(struct mtl_main_impl* impl, struct mt_sch_impl* sch) {
+  uint64_t cur_tsc = mt_get_tsc(impl);
+  struct mt_sch_tasklet_impl* tasklet;
+  uint64_t busy_ns = 0;
+
+  if (sch->load_restart) {
+    /* the window should not mix the loads of different session sets */
+    sch->load_restart = false;
+    sch->load_quota_mbs = sch->data_quota_mbs_total;
+    for (int i = 0; i < sch->max_tasklet_idx; i++) {
+      tasklet = sch->tasklet[i];
+      if (tasklet) tasklet->load_busy_ns = 0;
+    }
+    sch->load_start_ns = cur_tsc;
+    return;
+  }
+
+  uint64_t dur = cur_tsc - sch->load_start_ns;
+  if (dur < MT_SCH_LOAD_WINDOW_NS) return;
+
+  for (int i = 0; i < sch->max_tasklet_idx; i++) {
+    tasklet = sch->tasklet[i];
+    if (!tasklet) continue;
+    busy_ns += tasklet->load_busy_ns;
+    tasklet->load_busy_ns = 0;
+  }
+  sch->load_start_ns = cur_tsc;
+  if (sch->load_quota_mbs != sch->data_quota_mbs_total) {
+    /* the quota changed in the window, measure again */
+    sch->load_quota_mbs = sch->data_quota_mbs_total;
+    return;
+  }
+  sch->load_score = (float)busy_ns * 100.0 / dur;
+  if (sch->load_quota_mbs) sch->load_cost = sch->load_score / sch->load_quota_mbs;
+
+  if (sch->load_score > MT_SCH_LOAD_BUSY_LIMIT) {
+    if (!sch->load_marked_busy) {
+      warn("%s(%d), overloaded, load %f quota %d\n", __func__, sch->idx, sch->load_score,
+           sch->load_quota_mbs);
+      sch->load_marked_busy = true;
+      mt_sch_set_cpu_busy(sch, true);
+    }
+  } else if (sch->load_marked_busy && sch->load_score < MT_SCH_LOAD_ADMIT_LIMIT) {
+    info("%s(%d), load %f back to normal\n", __func__, sch->idx, sch->load_score);
+    sch->load_marked_busy = false;
+    mt_sch_set_cpu_busy(sch, false);
+  }
+}
+
+static inline int sch_tasklet_run(struct mtl_main_impl* impl,
+                                  struct mt_sch_tasklet_impl* tasklet,
+                                  bool time_measure) {
+  struct mt_sch_tasklet_ops* ops = &tasklet->ops;
+  bool balance = tasklet->sch->balance;
+  bool measured_quota = tasklet->sch->measured_quota;
+  struct mtl_sch_stats_sch* stats = tasklet->sch->stats;
+  bool measure = time_measure || balance || measured_quota || stats;
+  uint64_t tsc_s = 0;
+  int pending;
+
+  if (measure) tsc_s = mt_get_tsc(impl);
+  pending = ops->handler(ops->priv);
+  if (measure) {
+    uint64_t delta_ns = mt_get_tsc(impl) - tsc_s;
+    if (stats)
+      sch_hist_record(&mtl_sch_stats_get_tasklet(stats, tasklet->idx)->run_time,
+                      delta_ns);
+    if (time_measure) {
+      uint32_t delta_us = delta_ns / NS_PER_US;
+      tasklet->stat_max_time_us = RTE_MAX(tasklet->stat_max_time_us, delta_us);
+      tasklet->stat_min_time_us = RTE_MIN(tasklet->stat_min_time_us, delta_us);
+      tasklet->stat_sum_time_us += delta_us;
+      tasklet->stat_time_cnt++;
+    }
+    /* only count the calls which did the work, not the idle polling */
+    if (pending != MT_TASKLET_ALL_DONE) {
+      if (balance) tasklet->bal_busy_ns += delta_ns;
+      if (measured_quota) tasklet->load_busy_ns += delta_ns;
+    }
+  }
+  if (ops->deadline) {
+    tasklet->deadline_tsc = ops->deadline(ops->priv);
+    tasklet->stat_deadline_cnt++;
+    if (tasklet->deadline_tsc && tasklet->deadline_tsc > mt_get_tsc(impl))
+      tasklet->stat_deadline_future_cnt++;
+  }
+
+  return pending;
+}
+
+/* insert to the due list which is sorted by the deadline, earliest first */
+static inline void sch_edf_insert(struct mt_sch_tasklet_impl** due, int nb_due,
+                                  struct mt_sch_tasklet_impl* tasklet) {
+  int i = nb_due;
+
+  while (i > 0 && due[i - 1]->deadline_tsc > tasklet->deadline_tsc) {
+    due[i] = due[i - 1];
+    i--;
+  }
+  due[i] = tasklet;
+}
+
 static int sch_tasklet_func(void* args) {
   struct mt_sch_impl* sch = args;
   struct mtl_main_impl* impl = sch->parent;
@@ -107,7 +279,7 @@ static int sch_tasklet_func(void* args) {
   struct mt_sch_tasklet_ops* ops;
   struct mt_sch_tasklet_impl* tasklet;
   bool time_measure = mt_has_tasklet_time_measure(impl);
-  uint64_t tsc_s = 0;
+  struct mt_sch_tasklet_impl* due[sch->nb_tasklets];
 
   num_tasklet = sch->max_tasklet_idx;
   info("%s(%d), start with %d tasklets\n", __func__, idx, num_tasklet);
@@ -127,9 +299,24 @@ static int sch_tasklet_func(void* args) {
   }
 
   sch->sleep_ratio_start_ns = mt_get_tsc(impl);
+  sch->load_restart = true;
+  sch->bal_start_ns = sch->sleep_ratio_start_ns;
+  sch->stats_last_loop_ns = 0;
+  if (sch->stats) sch->stats->active = 1;
 
   while (rte_atomic32_read(&sch->request_stop) == 0) {
     int pending = MT_TASKLET_ALL_DONE;
+    uint64_t loop_start = 0;
+    uint64_t cur_tsc = 0;
+    uint64_t nearest_deadline = 0;
+    int nb_due = 0;
+
+    if (sch->stats) loop_start = mt_get_tsc(impl);
+    if (sch->stats) {
+      if (sch->stats_last_loop_ns)
+        sch_hist_record(&sch->stats->loop_period, loop_start - sch->stats_last_loop_ns);
+      sch->stats_last_loop_ns = loop_start;
+    }
 
     num_tasklet = sch->max_tasklet_idx;
     for (i = 0; i < num_tasklet; i++) {
@@ -141,19 +328,44 @@ static int sch_tasklet_func(void* args) {
         dbg("%s(%d), tasklet %s(%d) exit\n", __func__, idx, tasklet->name, i);
         continue;
       }
-      ops = &tasklet->ops;
-      if (time_measure) tsc_s = mt_get_tsc(impl);
-      pending += ops->handler(ops->priv);
-      if (time_measure) {
-        uint32_t delta_us = (mt_get_tsc(impl) - tsc_s) / NS_PER_US;
-        tasklet->stat_max_time_us = RTE_MAX(tasklet->stat_max_time_us, delta_us);
-        tasklet->stat_min_time_us = RTE_MIN(tasklet->stat_min_time_us, delta_us);
-        tasklet->stat_sum_time_us += delta_us;
-        tasklet->stat_time_cnt++;
+      if (!tasklet->ops.deadline) continue;
+      /* deadline driven, skip if the deadline is not reached */
+      if (tasklet->deadline_tsc) {
+        if (!cur_tsc) cur_tsc = mt_get_tsc(impl);
+        if (tasklet->deadline_tsc > cur_tsc) {
+          sch->stat_deadline_skip++;
+          continue;
+        }
       }
+      sch_edf_insert(due, nb_due, tasklet);
+      nb_due++;
+    }
+    /* the due deadline tasklets first, earliest deadline first */
+    for (i = 0; i < nb_due; i++) {
+      pending += sch_tasklet_run(impl, due[i], time_measure);
+    }
+    /* then round robin for all others */
+    for (i = 0; i < num_tasklet; i++) {
+      tasklet = sch->tasklet[i];
+      if (!tasklet || tasklet->ops.deadline) continue;
+      pending += sch_tasklet_run(impl, tasklet, time_measure);
     }
+
+    if (sch->measured_quota) sch_load_update(impl, sch);
+
     if (sch->allow_sleep && (pending == MT_TASKLET_ALL_DONE)) {
-      sch_tasklet_sleep(impl, sch);
+      /* find the nearest deadline */
+      for (i = 0; i < num_tasklet; i++) {
+        tasklet = sch->tasklet[i];
+        if (!tasklet || !tasklet->ops.deadline) continue;
+        if (!tasklet->deadline_tsc) { /* has work now */
+          nearest_deadline = 0;
+          break;
+        }
+        if (!nearest_deadline || tasklet->deadline_tsc < nearest_deadline)
+          nearest_deadline = tasklet->deadline_tsc;
+      }
+      sch_tasklet_sleep(impl, sch, nearest_deadline);
     }
   }
 
@@ -164,7 +376,15 @@ static int sch_tasklet_func(void* args) {
     ops = &tasklet->ops;
     if (ops->stop) ops->stop(ops->priv);
   }
+  /* ack the pending detach, the waiter out of the sch lock should not wait a stop */
+  for (i = 0; i < num_tasklet; i++) {
+    tasklet = sch->tasklet[i];
+    if (!tasklet || !tasklet->request_exit) continue;
+    tasklet->ack_exit = true;
+    sch->tasklet[i] = NULL;
+  }
 
+  if (sch->stats) sch->stats->active = 0;
   rte_atomic32_set(&sch->stopped, 1);
   info("%s(%d), end with %d tasklets\n", __func__, idx, num_tasklet);
   return 0;
@@ -260,6 +480,7 @@ static struct mt_sch_impl* sch_request(struct mtl_main_impl* impl, enum mt_sch_t
     sch_lock(sch);
     if (!mt_sch_is_active(sch)) { /* find one free sch */
       sch->type = type;
+      sch->bal_stopping = false;
       rte_atomic32_inc(&sch->active);
       rte_atomic32_inc(&mt_sch_get_mgr(impl)->sch_cnt);
       sch_unlock(sch);
@@ -303,6 +524,7 @@ static int sch_free_quota(struct mt_sch_impl* sch, int quota_mbs) {
 
   sch_lock(sch);
   sch->data_quota_mbs_total -= quota_mbs;
+  sch_load_reset(sch);
   if (!sch->data_quota_mbs_total) {
     /* no tx/rx video, change to default */
     sch->type = MT_SCH_TYPE_DEFAULT;
@@ -373,6 +595,17 @@ static int sch_stat(void* priv) {
     sch->stat_sleep_ns_min = -1;
     sch->stat_sleep_ns_max = 0;
   }
+  if (sch->measured_quota) {
+    notice("SCH(%d): measured load %f with quota %d(%d now), cost %f per mb/s\n", idx,
+           sch->load_score, sch->load_quota_mbs, sch->data_quota_mbs_total,
+           sch->load_cost);
+  }
+  if (sch->stat_deadline_skip) {
+    notice("SCH(%d): deadline skip %" PRIu64 ", spin %u\n", idx, sch->stat_deadline_skip,
+           sch->stat_deadline_spin_cnt);
+    sch->stat_deadline_skip = 0;
+    sch->stat_deadline_spin_cnt = 0;
+  }
   if (mt_sch_is_active(sch) && !mt_sch_started(sch)) {
     notice("SCH(%d): active but still not started\n", idx);
   }
@@ -380,56 +613,243 @@ static int sch_stat(void* priv) {
   return 0;
 }
 
+static inline struct mt_sch_impl* sch_tasklet_lock(struct mt_sch_tasklet_impl* tasklet) {
+  struct mt_sch_impl* sch;
+
+  /* the tasklet may be moved to another sch by the balancer before we get the lock */
+  while (true) {
+    sch = tasklet->sch;
+    sch_lock(sch);
+    if (tasklet->sch == sch) return sch;
+    sch_unlock(sch);
+  }
+}
+
+/* request the sch to drop the tasklet at the safe point, call with sch lock */
+static bool sch_tasklet_detach_request(struct mt_sch_impl* sch,
+                                       struct mt_sch_tasklet_impl* tasklet) {
+  if (!mt_sch_started(sch)) {
+    /* safe to directly remove */
+    sch->tasklet[tasklet->idx] = NULL;
+    return false;
+  }
+
+  tasklet->ack_exit = false;
+  tasklet->request_exit = true;
+  return true;
+}
+
+/* wait the sch ack the exit, the sch lock is not required */
+static int sch_tasklet_detach_wait(struct mt_sch_impl* sch,
+                                   struct mt_sch_tasklet_impl* tasklet) {
+  int retry = 0;
+
+  while (!tasklet->ack_exit) {
+    mt_sleep_ms(1);
+    retry++;
+    if (retry > 1000) {
+      err("%s(%d), tasklet %s(%d) runtime detach timeout\n", __func__, sch->idx,
+          tasklet->name, tasklet->idx);
+      return -EIO;
+    }
+  }
+  dbg("%s(%d), tasklet %s(%d) detached, retry %d\n", __func__, sch->idx, tasklet->name,
+      tasklet->idx, retry);
+  return 0;
+}
+
+/* clear the exit request after the ack, call with sch lock */
+static void sch_tasklet_detach_done(struct mt_sch_impl* sch,
+                                    struct mt_sch_tasklet_impl* tasklet) {
+  tasklet->request_exit = false;
+
+  int max_idx = 0;
+  for (int i = 0; i < sch->nb_tasklets; i++) {
+    if (sch->tasklet[i]) max_idx = i + 1;
+  }
+  sch->max_tasklet_idx = max_idx;
+}
+
+/* detach the tasklet from the sch at the safe point, call with sch lock */
+static int sch_tasklet_detach(struct mt_sch_impl* sch,
+                              struct mt_sch_tasklet_impl* tasklet) {
+  if (sch_tasklet_detach_request(sch, tasklet)) {
+    int ret = sch_tasklet_detach_wait(sch, tasklet);
+    if (ret < 0) return ret;
+  }
+  sch_tasklet_detach_done(sch, tasklet);
+  return 0;
+}
+
 int mt_sch_unregister_tasklet(struct mt_sch_tasklet_impl* tasklet) {
-  struct mt_sch_impl* sch = tasklet->sch;
+  struct mt_sch_impl* sch = sch_tasklet_lock(tasklet);
+
+  /* the balancer is moving it out of the locks, wait the move done */
+  while (tasklet->bal_moving) {
+    sch_unlock(sch);
+    mt_sleep_ms(1);
+    sch = sch_tasklet_lock(tasklet);
+  }
+
   int sch_idx = sch->idx;
   int idx = tasklet->idx;
 
-  sch_lock(sch);
-
   if (sch->tasklet[idx] != tasklet) {
     err("%s(%d), invalid tasklet on %d\n", __func__, sch_idx, idx);
     sch_unlock(sch);
     return -EIO;
   }
 
-  if (mt_sch_started(sch)) {
-    int retry = 0;
-    /* wait sch ack this exit */
-    dbg("%s(%d), tasklet %s(%d) runtime unregistered\n", __func__, sch_idx, tasklet->name,
-        idx);
-    tasklet->ack_exit = false;
-    tasklet->request_exit = true;
-    do {
-      mt_sleep_ms(1);
-      retry++;
-      if (retry > 1000) {
-        err("%s(%d), tasklet %s(%d) runtime unregistered timeout\n", __func__, sch_idx,
-            tasklet->name, idx);
-        sch_unlock(sch);
-        return -EIO;
-      }
-    } while (!tasklet->ack_exit);
-    info("%s(%d), tasklet %s(%d) unregistered, retry %d\n", __func__, sch_idx,
-         tasklet->name, idx, retry);
-  } else {
-    /* safe to directly remove */
-    sch->tasklet[idx] = NULL;
-    info("%s(%d), tasklet %s(%d) unregistered\n", __func__, sch_idx, tasklet->name, idx);
+  int ret = sch_tasklet_detach(sch, tasklet);
+  if (ret < 0) {
+    err("%s(%d), tasklet %s(%d) detach fail %d\n", __func__, sch_idx, tasklet->name, idx,
+        ret);
+    sch_unlock(sch);
+    return ret;
+  }
+  info("%s(%d), tasklet %s(%d) unregistered\n", __func__, sch_idx, tasklet->name, idx);
+  sch_stats_slot_set(sch, idx, NULL);
+
+  /* the owner put the quota on the home sch, give back the quota moved with tasklet */
+  struct mt_sch_impl* home_sch = tasklet->home_sch;
+  int away_quota = (sch != home_sch) ? tasklet->ops.quota_mbs : 0;
+  if (away_quota) {
+    sch->data_quota_mbs_total -= away_quota;
+    sch_load_reset(sch);
   }
 
   mt_rte_free(tasklet);
 
-  int max_idx = 0;
+  sch_unlock(sch);
+
+  if (away_quota) {
+    sch_lock(home_sch);
+    home_sch->data_quota_mbs_total += away_quota;
+    sch_load_reset(home_sch);
+    sch_unlock(home_sch);
+  }
+  return 0;
+}
+
+/* the slot held by a balance move is not free */
+static int sch_find_free_slot(struct mt_sch_impl* sch) {
   for (int i = 0; i < sch->nb_tasklets; i++) {
-    if (sch->tasklet[i]) max_idx = i + 1;
+    if (!sch->tasklet[i] && i != sch->bal_hold_idx) return i;
   }
-  sch->max_tasklet_idx = max_idx;
+  return -1;
+}
 
-  sch_unlock(sch);
+/* attach a detached tasklet to the slot, call with the sch lock */
+static void sch_tasklet_attach(struct mt_sch_impl* sch,
+                               struct mt_sch_tasklet_impl* tasklet, int slot) {
+  sch_stats_slot_set(sch, slot, tasklet->name);
+  /* it's picked up at the next loop */
+  tasklet->sch = sch;
+  tasklet->idx = slot;
+  tasklet->deadline_tsc = 0;
+  sch->tasklet[slot] = tasklet;
+  sch->max_tasklet_idx = RTE_MAX(sch->max_tasklet_idx, slot + 1);
+}
+
+/*
+ * attach the tasklet detached from from_sch to to_sch, call with the from_sch lock.
+ * Return the slot on to_sch or -ENOMEM if to_sch is full.
+ */
+static int sch_tasklet_move_attach(struct mt_sch_impl* from_sch,
+                                   struct mt_sch_tasklet_impl* tasklet, bool from_started,
+                                   struct mt_sch_impl* to_sch) {
+  struct mt_sch_tasklet_ops* ops = &tasklet->ops;
+  int slot;
+
+  sch_lock(to_sch);
+  slot = sch_find_free_slot(to_sch);
+  if (slot < 0) {
+    sch_unlock(to_sch);
+    return -ENOMEM;
+  }
+  bool to_started = mt_sch_started(to_sch);
+  /* pair the start/stop callbacks if the tasklet move across the start state */
+  if (from_started && !to_started && ops->stop) ops->stop(ops->priv);
+  sch_tasklet_attach(to_sch, tasklet, slot);
+  if (!from_started && to_started) {
+    if (ops->pre_start) ops->pre_start(ops->priv);
+    if (ops->start) ops->start(ops->priv);
+  }
+  /* the quota follow the tasklet, the admission see the real load */
+  if (ops->quota_mbs) {
+    to_sch->data_quota_mbs_total += ops->quota_mbs;
+    sch_load_reset(to_sch);
+  }
+  sch_unlock(to_sch);
+
+  if (ops->quota_mbs) {
+    from_sch->data_quota_mbs_total -= ops->quota_mbs;
+    sch_load_reset(from_sch);
+  }
+  return slot;
+}
+
+/*
+ * move the tasklet on from_sch to to_sch, call with the from_sch lock and the mgr lock.
+ * Only from_sch is locked during the detach wait, the to_sch is locked for the attach.
+ */
+static int sch_tasklet_move(struct mt_sch_impl* from_sch,
+                            struct mt_sch_tasklet_impl* tasklet,
+                            struct mt_sch_impl* to_sch) {
+  int from_idx = tasklet->idx;
+  bool from_started = mt_sch_started(from_sch);
+  int slot, ret;
+
+  if (from_sch == to_sch) return 0;
+
+  /* fast check before the detach, the slot is checked again with the lock */
+  if (sch_find_free_slot(to_sch) < 0) {
+    dbg("%s(%d), no space on sch %d\n", __func__, from_sch->idx, to_sch->idx);
+    return -ENOMEM;
+  }
+
+  ret = sch_tasklet_detach(from_sch, tasklet);
+  if (ret < 0) {
+    err("%s(%d), tasklet %s(%d) detach fail %d\n", __func__, from_sch->idx,
+        tasklet->name, from_idx, ret);
+    return ret;
+  }
+  sch_stats_slot_set(from_sch, from_idx, NULL);
+
+  slot = sch_tasklet_move_attach(from_sch, tasklet, from_started, to_sch);
+  if (slot < 0) {
+    /* the old slot is still free as the from_sch is locked, put it back */
+    warn("%s(%d), sch %d full now, tasklet %s stay\n", __func__, from_sch->idx,
+         to_sch->idx, tasklet->name);
+    sch_tasklet_attach(from_sch, tasklet, from_idx);
+    return -ENOMEM;
+  }
+
+  info("%s, tasklet %s move from (%d,%d) to (%d,%d)\n", __func__, tasklet->name,
+       from_sch->idx, from_idx, to_sch->idx, slot);
   return 0;
 }
 
+int mt_sch_move_tasklet(struct mt_sch_tasklet_impl* tasklet, struct mt_sch_impl* to_sch) {
+  struct mt_sch_mgr* mgr = mt_sch_get_mgr(to_sch->parent);
+  struct mt_sch_impl* from_sch;
+  int ret;
+
+  /* serialize with the balancer */
+  sch_mgr_lock(mgr);
+  from_sch = sch_tasklet_lock(tasklet);
+  if (tasklet->bal_moving) {
+    dbg("%s(%d), tasklet %s is in a balance move\n", __func__, from_sch->idx,
+        tasklet->name);
+    ret = -EBUSY;
+  } else {
+    ret = sch_tasklet_move(from_sch, tasklet, to_sch);
+  }
+  sch_unlock(from_sch);
+  sch_mgr_unlock(mgr);
+  return ret;
+}
+
 struct mt_sch_tasklet_impl* mt_sch_register_tasklet(
     struct mt_sch_impl* sch, struct mt_sch_tasklet_ops* tasklet_ops) {
   int idx = sch->idx;
@@ -440,7 +860,7 @@ struct mt_sch_tasklet_impl* mt_sch_register_tasklet(
 
   /* find one empty slot in the mgr */
   for (int i = 0; i < sch->nb_tasklets; i++) {
-    if (sch->tasklet[i]) continue;
+    if (sch->tasklet[i] || i == sch->bal_hold_idx) continue;
 
     /* find one empty tasklet slot */
     tasklet = mt_rte_zmalloc_socket(sizeof(*tasklet), mt_socket_id(impl, MTL_PORT_P));
@@ -453,8 +873,10 @@ struct mt_sch_tasklet_impl* mt_sch_register_tasklet(
     tasklet->ops = *tasklet_ops;
     strncpy(tasklet->name, tasklet_ops->name, ST_MAX_NAME_LEN - 1);
     tasklet->sch = sch;
+    tasklet->home_sch = sch;
     tasklet->idx = i;
     sch_tasklet_stat_clear(tasklet);
+    sch_stats_slot_set(sch, i, tasklet->name);
 
     sch->tasklet[i] = tasklet;
     sch->max_tasklet_idx = RTE_MAX(sch->max_tasklet_idx, i + 1);
@@ -475,6 +897,81 @@ struct mt_sch_tasklet_impl* mt_sch_register_tasklet(
   return NULL;
 }
 
+static int sch_stats_shm_uinit(struct mtl_main_impl* impl) {
+  struct mt_sch_mgr* mgr = mt_sch_get_mgr(impl);
+
+  for (int sch_idx = 0; sch_idx < MT_MAX_SCH_NUM; sch_idx++) {
+    mt_sch_instance(impl, sch_idx)->stats = NULL;
+  }
+
+  if (mgr->stats_shm) {
+#ifndef WINDOWSENV
+    munmap(mgr->stats_shm, mgr->stats_shm->size);
+    shm_unlink(mgr->stats_shm_name);
+#endif
+    mgr->stats_shm = NULL;
+  }
+  return 0;
+}
+
+static int sch_stats_shm_init(struct mtl_main_impl* impl, int nb_tasklets) {
+  struct mt_sch_mgr* mgr = mt_sch_get_mgr(impl);
+#ifdef WINDOWSENV
+  MT_MAY_UNUSED(mgr);
+  MT_MAY_UNUSED(nb_tasklets);
+  warn("%s, stats shm not support on windows\n", __func__);
+  return -ENOTSUP;
+#else
+  struct mtl_sch_stats_shm* shm;
+  uint32_t nb_sch = RTE_MIN(MT_MAX_SCH_NUM, MTL_SCH_STATS_SCH_MAX);
+  size_t sz = mtl_sch_stats_shm_size(nb_sch, nb_tasklets);
+  int fd, ret;
+
+  snprintf(mgr->stats_shm_name, sizeof(mgr->stats_shm_name), MTL_SCH_STATS_SHM_NAME_FMT,
+           getpid(), impl->instance_id);
+  /* never reuse an existing one, it may belong to another process */
+  fd = shm_open(mgr->stats_shm_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    err("%s, shm_open %s fail %s\n", __func__, mgr->stats_shm_name, strerror(errno));
+    return -errno;
+  }
+  ret = ftruncate(fd, sz);
+  if (ret < 0) {
+    ret = -errno;
+    err("%s, ftruncate %s fail %s\n", __func__, mgr->stats_shm_name, strerror(errno));
+    close(fd);
+    shm_unlink(mgr->stats_shm_name);
+    return ret;
+  }
+  shm = mmap(NULL, sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (shm == MAP_FAILED) {
+    ret = -errno;
+    err("%s, mmap %s fail %s\n", __func__, mgr->stats_shm_name, strerror(errno));
+    shm_unlink(mgr->stats_shm_name);
+    return ret;
+  }
+
+  memset(shm, 0, sz);
+  shm->version = MTL_SCH_STATS_VERSION;
+  shm->hist_sub_bits = MTL_HIST_SUB_BITS;
+  shm->nb_sch = nb_sch;
+  shm->max_tasklets = nb_tasklets;
+  shm->sch_size = mtl_sch_stats_sch_size(nb_tasklets);
+  shm->size = sz;
+  for (uint32_t sch_idx = 0; sch_idx < shm->nb_sch; sch_idx++) {
+    mt_sch_instance(impl, sch_idx)->stats = mtl_sch_stats_get_sch(shm, sch_idx);
+  }
+  /* magic is the last one, reader check it to know the header is ready */
+  rte_smp_wmb();
+  shm->magic = MTL_SCH_STATS_MAGIC;
+  mgr->stats_shm = shm;
+
+  info("%s, succ on %s size %" PRIu64 "\n", __func__, mgr->stats_shm_name, (uint64_t)sz);
+  return 0;
+#endif
+}
+
 int mt_sch_mrg_init(struct mtl_main_impl* impl, int data_quota_mbs_limit) {
   struct mt_sch_impl* sch;
   struct mt_sch_mgr* mgr = mt_sch_get_mgr(impl);
@@ -496,6 +993,9 @@ int mt_sch_mrg_init(struct mtl_main_impl* impl, int data_quota_mbs_limit) {
     sch->data_quota_mbs_total = 0;
     sch->data_quota_mbs_limit = data_quota_mbs_limit;
     sch->run_in_thread = mt_tasklet_has_thread(impl);
+    sch->measured_quota = mt_has_sch_measured_quota(impl);
+    sch->balance = mt_has_tasklet_balance(impl);
+    sch->bal_hold_idx = -1;
 
     /* sleep info init */
     sch->allow_sleep = mt_tasklet_has_sleep(impl);
@@ -531,6 +1031,11 @@ int mt_sch_mrg_init(struct mtl_main_impl* impl, int data_quota_mbs_limit) {
     }
   }
 
+  if (mt_has_sch_stats_shm(impl)) {
+    /* stats is optional, not fail the init */
+    sch_stats_shm_init(impl, nb_tasklets);
+  }
+
   info("%s, succ with data quota %d M, nb_tasklets %d\n", __func__, data_quota_mbs_limit,
        nb_tasklets);
   return 0;
@@ -540,6 +1045,8 @@ int mt_sch_mrg_uinit(struct mtl_main_impl* impl) {
   struct mt_sch_impl* sch;
   struct mt_sch_mgr* mgr = mt_sch_get_mgr(impl);
 
+  sch_stats_shm_uinit(impl);
+
   for (int sch_idx = 0; sch_idx < MT_MAX_SCH_NUM; sch_idx++) {
     sch = mt_sch_instance(impl, sch_idx);
 
@@ -578,11 +1085,30 @@ int mt_sch_add_quota(struct mt_sch_impl* sch, int quota_mbs) {
   }
 
   sch_lock(sch);
+  /* the cost is valid only if measured with the current quota, else use the limit */
+  if (sch->measured_quota && sch->data_quota_mbs_total && sch->load_cost > 0 &&
+      sch->load_quota_mbs == sch->data_quota_mbs_total) {
+    /* estimate the new load by the measured cost per mb/s */
+    float load = sch->load_cost * (sch->data_quota_mbs_total + quota_mbs);
+    if (load <= MT_SCH_LOAD_ADMIT_LIMIT) {
+      sch->data_quota_mbs_total += quota_mbs;
+      sch_load_reset(sch);
+      info("%s(%d:%d), quota %d total now %d, estimated load %f\n", __func__, idx,
+           sch->type, quota_mbs, sch->data_quota_mbs_total, load);
+      sch_unlock(sch);
+      return 0;
+    }
+    dbg("%s(%d), no headroom for quota %d, estimated load %f\n", __func__, idx, quota_mbs,
+        load);
+    sch_unlock(sch);
+    return -ENOMEM;
+  }
   /* either the first quota request or sch is capable the quota */
   if (!sch->data_quota_mbs_total ||
       ((sch->data_quota_mbs_total + quota_mbs) <= sch->data_quota_mbs_limit)) {
     /* find one sch capable with quota */
     sch->data_quota_mbs_total += quota_mbs;
+    sch_load_reset(sch);
     info("%s(%d:%d), quota %d total now %d\n", __func__, idx, sch->type, quota_mbs,
          sch->data_quota_mbs_total);
     sch_unlock(sch);
@@ -593,6 +1119,208 @@ int mt_sch_add_quota(struct mt_sch_impl* sch, int quota_mbs) {
   return -ENOMEM;
 }
 
+static bool sch_can_balance(struct mt_sch_impl* sch) {
+  if (!sch->balance || sch->bal_stopping) return false;
+  if (!mt_sch_is_active(sch) || !mt_sch_started(sch)) return false;
+  return true;
+}
+
+/* send back the tasklets moved in by the balancer, call with the mgr lock */
+static int sch_tasklets_go_home(struct mt_sch_impl* sch) {
+  struct mtl_main_impl* impl = sch->parent;
+  struct mt_sch_tasklet_impl* tasklet;
+  struct mt_sch_impl* to_sch;
+  int ret = 0, move_ret;
+
+  /* hold the lock, the owner can't free the tasklet during the move */
+  sch_lock(sch);
+  for (int i = 0; i < sch->nb_tasklets; i++) {
+    tasklet = sch->tasklet[i];
+    /* the balancer put it on a live sch when the move is done */
+    if (!tasklet || tasklet->home_sch == sch || tasklet->bal_moving) continue;
+    move_ret = sch_tasklet_move(sch, tasklet, tasklet->home_sch);
+    /* the home is full, try any other sch which can run it */
+    for (int idx = 0; (move_ret < 0) && (idx < MT_MAX_SCH_NUM); idx++) {
+      to_sch = mt_sch_instance(impl, idx);
+      if (to_sch == sch || to_sch == tasklet->home_sch) continue;
+      if (!sch_can_balance(to_sch) || to_sch->type != sch->type) continue;
+      move_ret = sch_tasklet_move(sch, tasklet, to_sch);
+    }
+    if (move_ret < 0) {
+      err("%s(%d), tasklet %s can't leave, ret %d\n", __func__, sch->idx, tasklet->name,
+          move_ret);
+      ret = move_ret;
+    }
+  }
+  sch_unlock(sch);
+  return ret;
+}
+
+static float sch_balance_util(struct mt_sch_impl* sch, uint64_t window_ns) {
+  struct mt_sch_tasklet_impl* tasklet;
+  uint64_t busy_ns = 0;
+
+  sch_lock(sch);
+  for (int i = 0; i < sch->max_tasklet_idx; i++) {
+    tasklet = sch->tasklet[i];
+    if (tasklet) busy_ns += tasklet->bal_busy_ns;
+  }
+  sch_unlock(sch);
+
+  return (float)busy_ns * 100.0 / window_ns;
+}
+
+/*
+ * attach the tasklet detached by the balancer, call with the from_sch lock and the mgr
+ * lock. The sch may stop or be freed during the detach wait out of the locks.
+ */
+static int sch_balance_move_done(struct mt_sch_impl* from_sch,
+                                 struct mt_sch_tasklet_impl* tasklet,
+                                 struct mt_sch_impl* to_sch, int detach_ret) {
+  int from_idx = tasklet->idx;
+  bool from_started = mt_sch_started(from_sch);
+  struct mt_sch_impl* home_sch = tasklet->home_sch;
+  int slot = -ENOMEM;
+
+  if (detach_ret < 0) {
+    /* the sch loop is stuck, leave the exit request same to the sync detach */
+    err("%s(%d), tasklet %s(%d) detach fail %d\n", __func__, from_sch->idx,
+        tasklet->name, from_idx, detach_ret);
+    return detach_ret;
+  }
+  sch_tasklet_detach_done(from_sch, tasklet);
+  sch_stats_slot_set(from_sch, from_idx, NULL);
+
+  if (sch_can_balance(to_sch))
+    slot = sch_tasklet_move_attach(from_sch, tasklet, from_started, to_sch);
+  if (slot >= 0) {
+    info("%s, tasklet %s move from (%d,%d) to (%d,%d)\n", __func__, tasklet->name,
+         from_sch->idx, from_idx, to_sch->idx, slot);
+    return 0;
+  }
+
+  /* the from_sch is going to be freed, its go home has skipped this tasklet */
+  if (from_sch->bal_stopping && home_sch != from_sch) {
+    slot = sch_tasklet_move_attach(from_sch, tasklet, from_started, home_sch);
+    if (slot >= 0) {
+      info("%s, tasklet %s back to home (%d,%d)\n", __func__, tasklet->name,
+           home_sch->idx, slot);
+      return -EIO;
+    }
+    err("%s(%d), tasklet %s can't go home\n", __func__, from_sch->idx, tasklet->name);
+  }
+
+  /* put it back to the held slot */
+  warn("%s(%d), sch %d can't take tasklet %s now, stay\n", __func__, from_sch->idx,
+       to_sch->idx, tasklet->name);
+  sch_tasklet_attach(from_sch, tasklet, from_idx);
+  return -EIO;
+}
+
+int mt_sch_balance(struct mtl_main_impl* impl) {
+  struct mt_sch_mgr* mgr = mt_sch_get_mgr(impl);
+  uint64_t cur_ns = mt_get_tsc(impl);
+  float util[MT_MAX_SCH_NUM];
+  struct mt_sch_impl* sch;
+  struct mt_sch_impl* max_sch = NULL;
+  struct mt_sch_impl* min_sch = NULL;
+  struct mt_sch_tasklet_impl* tasklet;
+  struct mt_sch_tasklet_impl* best = NULL;
+  float util_min = 0;
+  bool detaching = false;
+  int ret = 0;
+
+  sch_mgr_lock(mgr);
+
+  for (int idx = 0; idx < MT_MAX_SCH_NUM; idx++) {
+    sch = mt_sch_instance(impl, idx);
+    util[idx] = 0;
+    if (!sch_can_balance(sch) || cur_ns <= sch->bal_start_ns) continue;
+    util[idx] = sch_balance_util(sch, cur_ns - sch->bal_start_ns);
+    dbg("%s(%d), util %f\n", __func__, idx, util[idx]);
+    if (!max_sch || util[idx] < util_min) util_min = util[idx];
+    if (!max_sch || util[idx] > util[max_sch->idx]) max_sch = sch;
+  }
+  if (!max_sch) goto out;
+  mgr->bal_util_max = util[max_sch->idx];
+  mgr->bal_util_min = util_min;
+  mgr->bal_rounds++;
+
+  /* the least loaded sch which can host the tasklet of max_sch */
+  for (int idx = 0; idx < MT_MAX_SCH_NUM; idx++) {
+    sch = mt_sch_instance(impl, idx);
+    if (sch == max_sch || !sch_can_balance(sch)) continue;
+    if (sch->type != max_sch->type || sch->cpu_busy) continue;
+    if (!min_sch || util[idx] < util[min_sch->idx]) min_sch = sch;
+  }
+  if (!min_sch) goto out;
+
+  float gap = util[max_sch->idx] - util[min_sch->idx];
+  if (gap < MT_SCH_BALANCE_GAP) goto out; /* hysteresis */
+
+  /*
+   * pick the tasklet which load is closest to the half gap, the load must be less than
+   * the gap otherwise it just swap the imbalance.
+   */
+  uint64_t window_ns = cur_ns - max_sch->bal_start_ns;
+  float best_diff = gap;
+  sch_lock(max_sch);
+  for (int i = 0; i < max_sch->max_tasklet_idx; i++) {
+    tasklet = max_sch->tasklet[i];
+    if (!tasklet || !tasklet->bal_busy_ns) continue;
+    if (!(tasklet->ops.flags & MT_TASKLET_BALANCE)) continue;
+    if (tasklet->bal_last_move_ns &&
+        (cur_ns - tasklet->bal_last_move_ns) < MT_SCH_BALANCE_COOLDOWN_NS)
+      continue;
+    float load = (float)tasklet->bal_busy_ns * 100.0 / window_ns;
+    if (load >= gap) continue;
+    float diff = fabs(load - gap / 2);
+    if (diff < best_diff) {
+      best_diff = diff;
+      best = tasklet;
+    }
+  }
+  if (best) {
+    info("%s, move tasklet %s from sch %d(%f) to sch %d(%f)\n", __func__, best->name,
+         max_sch->idx, util[max_sch->idx], min_sch->idx, util[min_sch->idx]);
+    /* the owner wait the move done to free it, and the slot is held for a put back */
+    best->bal_moving = true;
+    max_sch->bal_hold_idx = best->idx;
+    detaching = sch_tasklet_detach_request(max_sch, best);
+  }
+  sch_unlock(max_sch);
+
+out:
+  /* start a new window */
+  for (int idx = 0; idx < MT_MAX_SCH_NUM; idx++) {
+    sch = mt_sch_instance(impl, idx);
+    if (!sch_can_balance(sch)) continue;
+    sch_lock(sch);
+    for (int i = 0; i < sch->max_tasklet_idx; i++) {
+      tasklet = sch->tasklet[i];
+      if (tasklet) tasklet->bal_busy_ns = 0;
+    }
+    sch->bal_start_ns = cur_ns;
+    sch_unlock(sch);
+  }
+  sch_mgr_unlock(mgr);
+
+  if (!best) return 0;
+
+  /* wait the sch loop drop it out of the locks, the sessions create/free go on */
+  if (detaching) ret = sch_tasklet_detach_wait(max_sch, best);
+
+  sch_mgr_lock(mgr);
+  sch_lock(max_sch);
+  ret = sch_balance_move_done(max_sch, best, min_sch, ret);
+  if (ret >= 0) best->bal_last_move_ns = cur_ns;
+  max_sch->bal_hold_idx = -1;
+  best->bal_moving = false;
+  sch_unlock(max_sch);
+  sch_mgr_unlock(mgr);
+  return ret;
+}
+
 int mt_sch_put(struct mt_sch_impl* sch, int quota_mbs) {
   int sidx = sch->idx, ret;
   struct mtl_main_impl* impl = sch->parent;
@@ -601,6 +1329,17 @@ int mt_sch_put(struct mt_sch_impl* sch, int quota_mbs) {
 
   if (rte_atomic32_dec_and_test(&sch->ref_cnt)) {
     info("%s(%d), ref_cnt now zero\n", __func__, sidx);
+    if (sch->balance) {
+      struct mt_sch_mgr* mgr = mt_sch_get_mgr(impl);
+
+      sch_mgr_lock(mgr);
+      /* no balance round can pick this sch after the flag */
+      sch->bal_stopping = true;
+      /* send back the tasklets moved in by the balancer */
+      ret = sch_tasklets_go_home(sch);
+      sch_mgr_unlock(mgr);
+      if (ret < 0) err("%s(%d), tasklets go home fail %d\n", __func__, sidx, ret);
+    }
     if (sch->data_quota_mbs_total)
       err("%s(%d), still has %d data_quota_mbs_total\n", __func__, sidx,
           sch->data_quota_mbs_total);
@@ -736,3 +1475,202 @@ int mt_sch_stop_all(struct mtl_main_impl* impl) {
   info("%s, succ\n", __func__);
   return 0;
 }
+
+int mtl_sch_tasklet_deadline_stats(mtl_handle mt, const char* name, uint64_t* calls,
+                                   uint64_t* future) {
+  struct mtl_main_impl* impl = mt;
+  struct mt_sch_impl* sch;
+  struct mt_sch_tasklet_impl* tasklet;
+  int found = 0;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (!name) {
+    err("%s, null name\n", __func__);
+    return -EINVAL;
+  }
+
+  *calls = 0;
+  *future = 0;
+  for (int sch_idx = 0; sch_idx < MT_MAX_SCH_NUM; sch_idx++) {
+    sch = mt_sch_instance(impl, sch_idx);
+    if (!mt_sch_is_active(sch)) continue;
+    sch_lock(sch);
+    for (int i = 0; i < sch->max_tasklet_idx; i++) {
+      tasklet = sch->tasklet[i];
+      if (!tasklet || strcmp(tasklet->name, name)) continue;
+      *calls += tasklet->stat_deadline_cnt;
+      *future += tasklet->stat_deadline_future_cnt;
+      found++;
+    }
+    sch_unlock(sch);
+  }
+
+  return found ? 0 : -ENOENT;
+}
+
+int mtl_sch_load_get(mtl_handle mt, int sch_idx, float* load, float* cost) {
+  struct mtl_main_impl* impl = mt;
+  struct mt_sch_impl* sch;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (sch_idx < 0 || sch_idx >= MT_MAX_SCH_NUM) {
+    err("%s, invalid sch_idx %d\n", __func__, sch_idx);
+    return -EINVAL;
+  }
+  sch = mt_sch_instance(impl, sch_idx);
+  if (!mt_sch_is_active(sch)) {
+    err("%s(%d), sch is not allocated\n", __func__, sch_idx);
+    return -EIO;
+  }
+  if (!sch->measured_quota) {
+    err("%s(%d), measured quota not enabled\n", __func__, sch_idx);
+    return -ENOTSUP;
+  }
+
+  sch_lock(sch);
+  *load = sch->load_score;
+  /* the cost measured with another quota is stale for the admission */
+  *cost = (sch->load_quota_mbs == sch->data_quota_mbs_total) ? sch->load_cost : 0;
+  sch_unlock(sch);
+  return 0;
+}
+
+/* the period of the synthetic busy tasklet, it spin the load of each period */
+#define MT_SCH_BUSY_PERIOD_NS (NS_PER_MS)
+
+struct mtl_sch_busy_tasklet_impl {
+  struct mtl_main_impl* parent;
+  struct mt_sch_impl* sch; /* the sch get with the quota */
+  struct mt_sch_tasklet_impl* tasklet;
+  int quota_mbs;
+  uint64_t busy_ns; /* spin time of each period */
+  uint64_t next_ns; /* start time of the next period */
+};
+
+static int sch_busy_tasklet_handler(void* priv) {
+  struct mtl_sch_busy_tasklet_impl* busy = priv;
+  struct mtl_main_impl* impl = busy->parent;
+  uint64_t cur_ns = mt_get_tsc(impl);
+
+  if (cur_ns < busy->next_ns) return MT_TASKLET_ALL_DONE;
+
+  uint64_t end_ns = cur_ns + busy->busy_ns;
+  while (mt_get_tsc(impl) < end_ns) rte_pause();
+  busy->next_ns += MT_SCH_BUSY_PERIOD_NS;
+  /* drop the periods missed by a late run, the load should not exceed the target */
+  if (busy->next_ns < cur_ns) busy->next_ns = cur_ns + MT_SCH_BUSY_PERIOD_NS;
+  return MT_TASKLET_HAS_PENDING;
+}
+
+int mtl_sch_busy_tasklet_free(mtl_sch_busy_handle handle) {
+  struct mtl_sch_busy_tasklet_impl* busy = handle;
+
+  if (busy->tasklet) {
+    mt_sch_unregister_tasklet(busy->tasklet);
+    busy->tasklet = NULL;
+  }
+  if (busy->sch) {
+    mt_sch_put(busy->sch, busy->quota_mbs);
+    busy->sch = NULL;
+  }
+  mt_rte_free(busy);
+  return 0;
+}
+
+mtl_sch_busy_handle mtl_sch_busy_tasklet_create(mtl_handle mt,
+                                                struct mtl_sch_busy_ops* ops) {
+  struct mtl_main_impl* impl = mt;
+  struct mtl_sch_busy_tasklet_impl* busy;
+  struct mt_sch_tasklet_ops tasklet_ops;
+  mt_sch_mask_t mask = MT_SCH_MASK_ALL;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+  if (!ops->name || ops->quota_mbs < 0 || ops->load < 0 || ops->load > 100) {
+    err("%s, invalid ops, quota %d load %f\n", __func__, ops->quota_mbs, ops->load);
+    return NULL;
+  }
+  if (ops->sch_idx >= MT_MAX_SCH_NUM) {
+    err("%s, invalid sch_idx %d\n", __func__, ops->sch_idx);
+    return NULL;
+  }
+  if (ops->sch_idx >= 0) {
+    mask = MTL_BIT64(ops->sch_idx);
+  } else if (ops->new_sch) {
+    for (int i = 0; i < MT_MAX_SCH_NUM; i++) {
+      if (mt_sch_is_active(mt_sch_instance(impl, i))) mask &= ~MTL_BIT64(i);
+    }
+  }
+
+  busy = mt_rte_zmalloc_socket(sizeof(*busy), mt_socket_id(impl, MTL_PORT_P));
+  if (!busy) {
+    err("%s, busy malloc fail\n", __func__);
+    return NULL;
+  }
+  busy->parent = impl;
+  busy->quota_mbs = ops->quota_mbs;
+  busy->busy_ns = MT_SCH_BUSY_PERIOD_NS * ops->load / 100;
+
+  busy->sch = mt_sch_get(impl, ops->quota_mbs, MT_SCH_TYPE_DEFAULT, mask);
+  if (!busy->sch) {
+    info("%s(%s), no sch admit quota %d\n", __func__, ops->name, ops->quota_mbs);
+    mtl_sch_busy_tasklet_free(busy);
+    return NULL;
+  }
+
+  memset(&tasklet_ops, 0, sizeof(tasklet_ops));
+  tasklet_ops.priv = busy;
+  tasklet_ops.name = (char*)ops->name;
+  tasklet_ops.handler = sch_busy_tasklet_handler;
+  tasklet_ops.quota_mbs = ops->quota_mbs;
+  if (ops->balance) tasklet_ops.flags = MT_TASKLET_BALANCE;
+
+  busy->tasklet = mt_sch_register_tasklet(busy->sch, &tasklet_ops);
+  if (!busy->tasklet) {
+    err("%s(%s), register tasklet fail\n", __func__, ops->name);
+    mtl_sch_busy_tasklet_free(busy);
+    return NULL;
+  }
+
+  info("%s(%s), sch %d quota %d load %f\n", __func__, ops->name, busy->sch->idx,
+       ops->quota_mbs, ops->load);
+  return busy;
+}
+
+int mtl_sch_busy_tasklet_sch(mtl_sch_busy_handle handle) {
+  struct mtl_sch_busy_tasklet_impl* busy = handle;
+  /* the balancer may move the tasklet to another sch */
+  return busy->tasklet->sch->idx;
+}
+
+int mtl_sch_balance_util(mtl_handle mt, uint32_t* rounds, float* max_util,
+                         float* min_util, float* gap) {
+  struct mtl_main_impl* impl = mt;
+  struct mt_sch_mgr* mgr;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (!mt_has_tasklet_balance(impl)) {
+    err("%s, tasklet balance not enabled\n", __func__);
+    return -ENOTSUP;
+  }
+
+  mgr = mt_sch_get_mgr(impl);
+  sch_mgr_lock(mgr);
+  *rounds = mgr->bal_rounds;
+  *max_util = mgr->bal_util_max;
+  *min_util = mgr->bal_util_min;
+  sch_mgr_unlock(mgr);
+  *gap = MT_SCH_BALANCE_GAP;
+  return 0;
+}
@@ -34,6 +34,7 @@ static inline void mt_sch_enable_allow_sleep(struct mt_sch_impl* sch, bool enabl
 }
 
 static inline bool mt_sch_has_busy(struct mt_sch_impl* sch) {
+  if (sch->measured_quota) return sch->load_score > MT_SCH_LOAD_ADMIT_LIMIT;
   if (!sch->allow_sleep || sch->sleep_ratio_score > 70.0)
     return true;
   else
@@ -46,6 +47,10 @@ int mt_sch_mrg_uinit(struct mtl_main_impl* impl);
 struct mt_sch_tasklet_impl* mt_sch_register_tasklet(
     struct mt_sch_impl* sch, struct mt_sch_tasklet_ops* tasklet_ops);
 int mt_sch_unregister_tasklet(struct mt_sch_tasklet_impl* tasklet);
+/* move a tasklet and its quota to another sch, the detach happen at the safe point */
+int mt_sch_move_tasklet(struct mt_sch_tasklet_impl* tasklet, struct mt_sch_impl* to_sch);
+/* one balance round, move at most one busy tasklet to the least loaded sch */
+int mt_sch_balance(struct mtl_main_impl* impl);
 
 static inline void mt_tasklet_set_sleep(struct mt_sch_tasklet_impl* tasklet,
                                         uint64_t advice_sleep_us) {
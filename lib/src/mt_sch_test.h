@@ -0,0 +1,136 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+/* The test hooks of mt_sch.c, not installed, for the gtest only */
+
+#ifndef _MT_LIB_SCH_TEST_HEAD_H_
+#define _MT_LIB_SCH_TEST_HEAD_H_
+
+#include "mtl_api.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * Get the ops.deadline stats of the tasklets with the name on all the active sch, since
+ * the tasklets register.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param name
+ *   The tasklet name.
+ * @param calls
+ *   A pointer to the number of the ops.deadline calls.
+ * @param future
+ *   A pointer to the number of the ops.deadline calls which report a future time.
+ * @return
+ *   - 0 if successful.
+ *   - -ENOENT: no tasklet with the name.
+ *   - <0: Error code if fail.
+ */
+int mtl_sch_tasklet_deadline_stats(mtl_handle mt, const char* name, uint64_t* calls,
+                                   uint64_t* future);
+
+/**
+ * Get the measured load of the sch in the MTL_FLAG_SCH_MEASURED_QUOTA mode.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param sch_idx
+ *   The sch index.
+ * @param load
+ *   A pointer to the load(%) of the tasklets in the last measure window.
+ * @param cost
+ *   A pointer to the load(%) per mb/s used by the admission, 0 if not measured with
+ *   the current data quota yet.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int mtl_sch_load_get(mtl_handle mt, int sch_idx, float* load, float* cost);
+
+/**
+ * Get the utilization spread of the schs in the last round of the tasklet balancer,
+ * the balancer run at every admin period.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param rounds
+ *   A pointer to the number of the balance rounds which measure the utilization.
+ * @param max_util
+ *   A pointer to the max utilization(%) of the schs in the last round.
+ * @param min_util
+ *   A pointer to the min utilization(%) of the schs in the last round.
+ * @param gap
+ *   A pointer to the min utilization(%) gap between two schs to trigger a move.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int mtl_sch_balance_util(mtl_handle mt, uint32_t* rounds, float* max_util,
+                         float* min_util, float* gap);
+
+/** Handle to the synthetic busy tasklet for the sch tests */
+typedef struct mtl_sch_busy_tasklet_impl* mtl_sch_busy_handle;
+
+/**
+ * The structure describing how to create a synthetic busy tasklet.
+ */
+struct mtl_sch_busy_ops {
+  /** name of the tasklet */
+  const char* name;
+  /** the data quota(mb/s) to get the sch with, same to a session */
+  int quota_mbs;
+  /** the load(%) of one lcore the tasklet spin */
+  float load;
+  /** the sch index to get, -1 for any sch */
+  int sch_idx;
+  /** get a sch which has no any tasklet yet, ignored if sch_idx is set */
+  bool new_sch;
+  /** movable by the balancer if MTL_FLAG_TASKLET_BALANCE enabled */
+  bool balance;
+};
+
+/**
+ * Create a tasklet which spin the load of every 1ms on a sch get with the quota, the
+ * sch admission is same to a session.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param ops
+ *   The pointer to the structure describing the busy tasklet.
+ * @return
+ *   - NULL on error or no sch admit the quota.
+ *   - Otherwise, the handle to the busy tasklet.
+ */
+mtl_sch_busy_handle mtl_sch_busy_tasklet_create(mtl_handle mt,
+                                                struct mtl_sch_busy_ops* ops);
+
+/**
+ * Free the synthetic busy tasklet.
+ *
+ * @param handle
+ *   The handle to the busy tasklet.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int mtl_sch_busy_tasklet_free(mtl_sch_busy_handle handle);
+
+/**
+ * Get the index of the sch which the busy tasklet run on now.
+ *
+ * @param handle
+ *   The handle to the busy tasklet.
+ * @return
+ *   The sch index.
+ */
+int mtl_sch_busy_tasklet_sch(mtl_sch_busy_handle handle);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -4,13 +4,23 @@
 
 #include "mt_shared_queue.h"
 
+#include <rte_ring_elem.h>
+#include <rte_ring_peek.h>
+
 #include "mt_dev.h"
 #include "mt_log.h"
+#include "mt_sch.h"
+#include "mt_shared_queue_test.h"
 #include "mt_stat.h"
 #include "mt_util.h"
 
 #define MT_SQ_RING_PREFIX "SQ_"
 #define MT_SQ_BURST_SIZE (128)
+/* max wait time for the pkts of one tsq entry in the tx ring at the put */
+#define MT_TSQ_PUT_TIMEOUT_MS (100)
+/* the producer threads and the pkts per burst call of mtl_tsq_stress */
+#define MT_TSQ_STRESS_PRODUCERS_MAX (64)
+#define MT_TSQ_STRESS_BULK (32)
 
 static inline struct mt_rsq_impl* rsq_ctx_get(struct mtl_main_impl* impl,
                                               enum mtl_port port) {
@@ -93,6 +103,7 @@ static int rsq_uinit(struct mt_rsq_impl* rsq) {
         MT_TAILQ_REMOVE(&rsq_queue->head, entry, next);
         rsq_entry_free(entry);
       }
+      mt_flow_hash_uinit(&rsq_queue->flow_hash);
     }
     mt_rte_free(rsq->rsq_queues);
     rsq->rsq_queues = NULL;
@@ -118,10 +129,16 @@ static int rsq_init(struct mtl_main_impl* impl, struct mt_rsq_impl* rsq) {
   for (uint16_t q = 0; q < rsq->max_rsq_queues; q++) {
     rsq_queue = &rsq->rsq_queues[q];
     rsq_queue->queue_id = q;
-    rsq_queue->port_id = mt_port_id(impl, port);
+    rsq_queue->rx_queue = &mt_if(impl, port)->rx_queues[q];
     rte_atomic32_set(&rsq_queue->entry_cnt, 0);
     rte_spinlock_init(&rsq_queue->mutex);
     MT_TAILQ_INIT(&rsq_queue->head);
+    int ret = mt_flow_hash_init(&rsq_queue->flow_hash, soc_id);
+    if (ret < 0) {
+      err("%s(%d,%u), flow hash init fail %d\n", __func__, port, q, ret);
+      rsq_uinit(rsq);
+      return ret;
+    }
   }
 
   int ret = mt_stat_register(impl, rsq_stat_dump, rsq, "rsq");
@@ -196,7 +213,10 @@ struct mt_rsq_entry* mt_rsq_get(struct mtl_main_impl* impl, enum mtl_port port,
   MT_TAILQ_INSERT_HEAD(&rsq_queue->head, entry, next);
   rte_atomic32_inc(&rsq_queue->entry_cnt);
   rsq_queue->entry_idx++;
-  if (flow->sys_queue) rsq_queue->cni_entry = entry;
+  if (flow->sys_queue)
+    rsq_queue->cni_entry = entry;
+  else
+    mt_flow_hash_add(&rsq_queue->flow_hash, &entry->hash_node, &entry->flow, entry);
   rsq_unlock(rsq_queue);
 
   uint8_t* ip = flow->dip_addr;
@@ -212,6 +232,11 @@ int mt_rsq_put(struct mt_rsq_entry* entry) {
   rsq_lock(rsq_queue);
   MT_TAILQ_REMOVE(&rsq_queue->head, entry, next);
   rte_atomic32_dec(&rsq_queue->entry_cnt);
+  if (entry->flow.sys_queue) {
+    if (rsq_queue->cni_entry == entry) rsq_queue->cni_entry = NULL;
+  } else {
+    mt_flow_hash_del(&rsq_queue->flow_hash, &entry->hash_node);
+  }
   rsq_unlock(rsq_queue);
 
   rsq_entry_free(entry);
@@ -250,41 +275,22 @@ static int rsq_rx(struct mt_rsq_queue* rsq_queue) {
   struct rte_ipv4_hdr* ipv4;
   struct rte_udp_hdr* udp;
 
-  rx = rte_eth_rx_burst(rsq_queue->port_id, q, pkts, MT_SQ_BURST_SIZE);
+  rx = mt_dev_rx_burst(rsq_queue->rx_queue, pkts, MT_SQ_BURST_SIZE);
   if (rx) dbg("%s(%u), rx pkts %u\n", __func__, q, rx);
   rsq_queue->stat_pkts_recv += rx;
 
   for (uint16_t i = 0; i < rx; i++) {
-    rsq_entry = NULL;
-
     hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
     ipv4 = &hdr->ipv4;
     udp = &hdr->udp;
     dbg("%s(%u), pkt %u ip %u.%u.%u.%u, port dst %u src %u\n", __func__, q, i,
         ntohs(udp->dst_port), ntohs(udp->src_port));
 
-    MT_TAILQ_FOREACH(rsq_entry, &rsq_queue->head, next) {
-      bool ip_matched;
-      if (rsq_entry->flow.no_ip_flow) {
-        ip_matched = true;
-      } else {
-        ip_matched = mt_is_multicast_ip(rsq_entry->flow.dip_addr)
-                         ? (ipv4->dst_addr == *(uint32_t*)rsq_entry->flow.dip_addr)
-                         : (ipv4->src_addr == *(uint32_t*)rsq_entry->flow.dip_addr);
-      }
-      bool port_matched;
-      if (rsq_entry->flow.no_port_flow) {
-        port_matched = true;
-      } else {
-        port_matched = ntohs(udp->dst_port) == rsq_entry->flow.dst_port;
-      }
-      if (ip_matched && port_matched) { /* match dst ip:port */
-        if (rsq_entry != last_rsq_entry) UPDATE_ENTRY();
-        matched_pkts[matched_pkts_nb++] = pkts[i];
-        break;
-      }
-    }
-    if (!rsq_entry) { /* no match, redirect to cni */
+    rsq_entry = mt_flow_hash_lookup(&rsq_queue->flow_hash, ipv4, udp);
+    if (rsq_entry) { /* match dst ip:port */
+      if (rsq_entry != last_rsq_entry) UPDATE_ENTRY();
+      matched_pkts[matched_pkts_nb++] = pkts[i];
+    } else { /* no match, redirect to cni */
       UPDATE_ENTRY();
       if (rsq_queue->cni_entry) rsq_entry_pkts_enqueue(rsq_queue->cni_entry, &pkts[i], 1);
     }
@@ -369,34 +375,212 @@ static inline void tsq_unlock(struct mt_tsq_queue* s) {
 static int tsq_stat_dump(void* priv) {
   struct mt_tsq_impl* tsq = priv;
   struct mt_tsq_queue* s;
+  int pkts_send, drain_cnt, nic_full_cnt;
 
   for (uint16_t q = 0; q < tsq->max_tsq_queues; q++) {
     s = &tsq->tsq_queues[q];
-    if (!tsq_try_lock(s)) continue;
-    if (s->stat_pkts_send) {
-      notice("%s(%d,%u), entries %d, pkt send %d\n", __func__, tsq->port, q,
-             rte_atomic32_read(&s->entry_cnt), s->stat_pkts_send);
-      s->stat_pkts_send = 0;
+    /* the stat is updated by the tx_mutex holder, not log with the tx path blocked */
+    if (!rte_spinlock_trylock(&s->tx_mutex)) continue;
+    pkts_send = s->stat_pkts_send;
+    drain_cnt = s->stat_drain_cnt;
+    nic_full_cnt = s->stat_nic_full_cnt;
+    s->stat_pkts_send = 0;
+    s->stat_drain_cnt = 0;
+    s->stat_nic_full_cnt = 0;
+    rte_spinlock_unlock(&s->tx_mutex);
+
+    if (pkts_send) {
+      notice("%s(%d,%u), entries %d, pkt send %d drain %d\n", __func__, tsq->port, q,
+             rte_atomic32_read(&s->entry_cnt), pkts_send, drain_cnt);
+    }
+    if (nic_full_cnt) {
+      notice("%s(%d,%u), nic full %d\n", __func__, tsq->port, q, nic_full_cnt);
     }
-    tsq_unlock(s);
+  }
+
+  return 0;
+}
+
+/*
+ * drain the tx_ring to nic in bursts, caller should hold the tx_mutex.
+ * The pkts of the dead entries are freed without tx when they reach the ring head.
+ */
+static uint32_t tsq_ring_drain(struct mt_tsq_queue* tsq_queue) {
+  struct mt_tsq_ring_elem elems[MT_SQ_BURST_SIZE];
+  struct rte_mbuf* pkts[MT_SQ_BURST_SIZE];
+  uint32_t sent = 0;
+  uint32_t n, nb;
+  uint16_t tx;
+
+  while (1) {
+    /* peek so that the pkts not accepted by nic keep the order in the ring */
+    n = rte_ring_dequeue_burst_elem_start(tsq_queue->tx_ring, elems, sizeof(elems[0]),
+                                          MT_SQ_BURST_SIZE, NULL);
+    if (!n) break;
+
+    for (nb = 0; nb < n && elems[nb].entry->dead; nb++) {
+      rte_pktmbuf_free(elems[nb].pkt);
+      rte_atomic64_inc(&elems[nb].entry->dropped);
+    }
+    if (nb) {
+      rte_ring_dequeue_elem_finish(tsq_queue->tx_ring, nb);
+      continue;
+    }
+
+    /* the live pkts until the next dead one */
+    for (nb = 0; nb < n && !elems[nb].entry->dead; nb++) pkts[nb] = elems[nb].pkt;
+    tx = mt_dev_tx_burst(tsq_queue->tx_queue, pkts, nb);
+    rte_ring_dequeue_elem_finish(tsq_queue->tx_ring, tx);
+    for (uint16_t i = 0; i < tx; i++) rte_atomic64_inc(&elems[i].entry->completed);
+    sent += tx;
+    if (tx < nb) {
+      tsq_queue->stat_nic_full_cnt++;
+      break;
+    }
+  }
+
+  tsq_queue->stat_pkts_send += sent;
+  tsq_queue->stat_drain_cnt++;
+  return sent;
+}
+
+/* the producer who get the tx_mutex drain the ring, others just leave */
+static void tsq_ring_try_drain(struct mt_tsq_queue* tsq_queue) {
+  while (!rte_ring_empty(tsq_queue->tx_ring) &&
+         rte_spinlock_trylock(&tsq_queue->tx_mutex)) {
+    uint32_t tx = tsq_ring_drain(tsq_queue);
+    rte_spinlock_unlock(&tsq_queue->tx_mutex);
+    /* nic full, the tsq tasklet or the next burst will retry */
+    if (!tx) break;
+    /* recheck for the pkts enqueued by others during the drain */
+    rte_smp_mb();
+  }
+}
+
+/*
+ * free all the pkts in the tx_ring without tx, caller should hold the tx_mutex.
+ * Only for the uinit, the live entries drop their own pkts by the dead flag.
+ */
+static uint32_t tsq_ring_purge(struct mt_tsq_queue* tsq_queue) {
+  struct mt_tsq_ring_elem elems[MT_SQ_BURST_SIZE];
+  uint32_t n, purged = 0;
+
+  while ((n = rte_ring_sc_dequeue_burst_elem(tsq_queue->tx_ring, elems, sizeof(elems[0]),
+                                             MT_SQ_BURST_SIZE, NULL))) {
+    for (uint32_t i = 0; i < n; i++) {
+      rte_pktmbuf_free(elems[i].pkt);
+      rte_atomic64_inc(&elems[i].entry->dropped);
+    }
+    purged += n;
+  }
+
+  return purged;
+}
+
+static inline uint64_t tsq_entry_inflight(struct mt_tsq_entry* entry) {
+  return rte_atomic64_read(&entry->enqueued) - rte_atomic64_read(&entry->completed) -
+         rte_atomic64_read(&entry->dropped);
+}
+
+/* mark the entry dead, the drain free its pkts and keep the others in the ring */
+static void tsq_entry_kill(struct mt_tsq_queue* tsq_queue, struct mt_tsq_entry* entry) {
+  rte_spinlock_lock(&tsq_queue->tx_mutex);
+  entry->dead = true;
+  if (tsq_queue->tx_ring) tsq_ring_drain(tsq_queue);
+  rte_spinlock_unlock(&tsq_queue->tx_mutex);
+}
+
+/* wait all pkts of this entry leave the tx_ring, drop its own pkts if timeout */
+static int tsq_entry_wait_done(struct mtl_main_impl* impl, struct mt_tsq_entry* entry,
+                               int timeout_ms) {
+  struct mt_tsq_impl* tsqm = entry->parent;
+  struct mt_tsq_queue* tsq_queue = &tsqm->tsq_queues[entry->queue_id];
+  uint64_t start_ts = mt_get_tsc(impl);
+
+  if (!tsq_queue->tx_ring) return 0;
+
+  while (tsq_entry_inflight(entry)) {
+    if ((mt_get_tsc(impl) - start_ts) / NS_PER_MS > timeout_ms) {
+      tsq_entry_kill(tsq_queue, entry);
+      uint64_t inflight = tsq_entry_inflight(entry);
+      if (!inflight) return 0;
+      /* the pkts ahead of its ones are not accepted by the nic yet */
+      warn("%s(%d,%u), timeout to %d ms, %" PRIu64 " pkts still in ring\n", __func__,
+           tsqm->port, entry->queue_id, timeout_ms, inflight);
+      return -ETIMEDOUT;
+    }
+    tsq_ring_try_drain(tsq_queue);
   }
 
   return 0;
 }
 
 static int tsq_entry_free(struct mt_tsq_entry* entry) {
+  uint64_t dropped = rte_atomic64_read(&entry->dropped);
+
+  if (dropped) {
+    warn("%s(%d), %" PRIu64 " of %" PRIu64 " pkts dropped\n", __func__,
+         entry->queue_id, dropped, rte_atomic64_read(&entry->enqueued));
+  }
   mt_rte_free(entry);
   return 0;
 }
 
+/* free the dead entries which have no pkts in the tx_ring now */
+static void tsq_dead_entries_free(struct mt_tsq_queue* tsq_queue) {
+  struct mt_tsq_entry *entry, *next;
+
+  /* lockless peek, the tasklet check it again in the next run */
+  if (!MT_TAILQ_FIRST(&tsq_queue->dead_head)) return;
+  if (!tsq_try_lock(tsq_queue)) return;
+  for (entry = MT_TAILQ_FIRST(&tsq_queue->dead_head); entry; entry = next) {
+    next = MT_TAILQ_NEXT(entry, next);
+    if (tsq_entry_inflight(entry)) continue;
+    MT_TAILQ_REMOVE(&tsq_queue->dead_head, entry, next);
+    tsq_entry_free(entry);
+  }
+  tsq_unlock(tsq_queue);
+}
+
+static int tsq_tasklet_handler(void* priv) {
+  struct mt_tsq_impl* tsq = priv;
+  struct mt_tsq_queue* tsq_queue;
+  int pending = MT_TASKLET_ALL_DONE;
+
+  for (uint16_t q = 0; q < tsq->max_tsq_queues; q++) {
+    tsq_queue = &tsq->tsq_queues[q];
+    if (!tsq_queue->tx_ring) continue;
+    tsq_ring_try_drain(tsq_queue);
+    tsq_dead_entries_free(tsq_queue);
+    if (!rte_ring_empty(tsq_queue->tx_ring)) pending = MT_TASKLET_HAS_PENDING;
+  }
+
+  return pending;
+}
+
 static int tsq_uinit(struct mt_tsq_impl* tsq) {
   struct mt_tsq_queue* tsq_queue;
   struct mt_tsq_entry* entry;
 
+  if (tsq->tasklet) {
+    mt_sch_unregister_tasklet(tsq->tasklet);
+    tsq->tasklet = NULL;
+  }
+
   if (tsq->tsq_queues) {
     for (uint16_t q = 0; q < tsq->max_tsq_queues; q++) {
       tsq_queue = &tsq->tsq_queues[q];
 
+      /* the ring elements refer to the entries, no producer left now */
+      if (tsq_queue->tx_ring) {
+        tsq_ring_purge(tsq_queue);
+        rte_ring_free(tsq_queue->tx_ring);
+        tsq_queue->tx_ring = NULL;
+      }
+      while ((entry = MT_TAILQ_FIRST(&tsq_queue->dead_head))) {
+        MT_TAILQ_REMOVE(&tsq_queue->dead_head, entry, next);
+        tsq_entry_free(entry);
+      }
       /* check if any not free */
       while ((entry = MT_TAILQ_FIRST(&tsq_queue->head))) {
         warn("%s(%u), entry %p not free\n", __func__, q, entry);
@@ -434,10 +618,11 @@ static int tsq_init(struct mtl_main_impl* impl, struct mt_tsq_impl* tsq) {
   for (uint16_t q = 0; q < tsq->max_tsq_queues; q++) {
     tsq_queue = &tsq->tsq_queues[q];
     tsq_queue->queue_id = q;
-    tsq_queue->port_id = mt_port_id(impl, port);
+    tsq_queue->tx_queue = &mt_if(impl, port)->tx_queues[q];
     rte_atomic32_set(&tsq_queue->entry_cnt, 0);
     mt_pthread_mutex_init(&tsq_queue->mutex, NULL);
     MT_TAILQ_INIT(&tsq_queue->head);
+    MT_TAILQ_INIT(&tsq_queue->dead_head);
   }
 
   int ret = mt_stat_register(impl, tsq_stat_dump, tsq, "tsq");
@@ -446,6 +631,19 @@ static int tsq_init(struct mtl_main_impl* impl, struct mt_tsq_impl* tsq) {
     return ret;
   }
 
+  struct mt_sch_tasklet_ops ops;
+  memset(&ops, 0x0, sizeof(ops));
+  ops.priv = tsq;
+  ops.name = "shared_tx_queue";
+  ops.handler = tsq_tasklet_handler;
+  /* no MT_TASKLET_BALANCE, a light flush tasklet which stay on the main sch */
+  tsq->tasklet = mt_sch_register_tasklet(impl->main_sch, &ops);
+  if (!tsq->tasklet) {
+    err("%s(%d), mt_sch_register_tasklet fail\n", __func__, port);
+    tsq_uinit(tsq);
+    return -EIO;
+  }
+
   return 0;
 }
 
@@ -525,6 +723,21 @@ struct mt_tsq_entry* mt_tsq_get(struct mtl_main_impl* impl, enum mtl_port port,
     }
     tsq_queue->tx_pool = pool;
   }
+  if (!flow->sys_queue && !tsq_queue->tx_ring) {
+    char ring_name[32];
+    snprintf(ring_name, 32, "%sTP%dQ%u", MT_SQ_RING_PREFIX, port, q);
+    struct rte_ring* ring = rte_ring_create_elem(
+        ring_name, sizeof(struct mt_tsq_ring_elem),
+        rte_align32pow2(mt_if_nb_tx_desc(impl, port)), mt_socket_id(impl, port),
+        RING_F_SC_DEQ);
+    if (!ring) {
+      err("%s(%d:%u), ring create fail\n", __func__, port, q);
+      tsq_unlock(tsq_queue);
+      mt_rte_free(entry);
+      return NULL;
+    }
+    tsq_queue->tx_ring = ring;
+  }
   MT_TAILQ_INSERT_HEAD(&tsq_queue->head, entry, next);
   rte_atomic32_inc(&tsq_queue->entry_cnt);
   tsq_unlock(tsq_queue);
@@ -541,9 +754,18 @@ int mt_tsq_put(struct mt_tsq_entry* entry) {
   struct mt_tsq_impl* tsqm = entry->parent;
   struct mt_tsq_queue* tsq_queue = &tsqm->tsq_queues[entry->queue_id];
 
+  /* the tx_ring refer to the entry until all its pkts are done */
+  int ret = tsq_entry_wait_done(tsqm->parent, entry, MT_TSQ_PUT_TIMEOUT_MS);
+
   tsq_lock(tsq_queue);
   MT_TAILQ_REMOVE(&tsq_queue->head, entry, next);
   rte_atomic32_dec(&tsq_queue->entry_cnt);
+  if (ret < 0) {
+    /* the tasklet free it once the drain drop all its pkts */
+    MT_TAILQ_INSERT_TAIL(&tsq_queue->dead_head, entry, next);
+    tsq_unlock(tsq_queue);
+    return 0;
+  }
   tsq_unlock(tsq_queue);
 
   tsq_entry_free(entry);
@@ -556,6 +778,8 @@ int mt_tsq_fatal_error(struct mt_tsq_entry* entry) {
 
   tsq_lock(tsq_queue);
   tsq_queue->fatal_error = true;
+  /* drop only the pkts of this entry, the other producers put their own */
+  tsq_entry_kill(tsq_queue, entry);
   tsq_unlock(tsq_queue);
 
   err("%s(%d), q %d masked as fatal error\n", __func__, tsqm->port, tsq_queue->queue_id);
@@ -567,28 +791,83 @@ int mt_tsq_done_cleanup(struct mt_tsq_entry* entry) {
   struct mt_tsq_queue* tsq_queue = &tsqm->tsq_queues[entry->queue_id];
 
   tsq_lock(tsq_queue);
-  rte_eth_tx_done_cleanup(tsq_queue->port_id, tsq_queue->queue_id, 0);
+  rte_spinlock_lock(&tsq_queue->tx_mutex);
+  if (tsq_queue->tx_ring) tsq_ring_drain(tsq_queue);
+  mt_dev_tx_done_cleanup(tsqm->parent, tsq_queue->tx_queue);
+  rte_spinlock_unlock(&tsq_queue->tx_mutex);
   tsq_unlock(tsq_queue);
 
   return 0;
 }
 
-uint16_t mt_tsq_burst(struct mt_tsq_entry* entry, struct rte_mbuf** tx_pkts,
-                      uint16_t nb_pkts) {
+/* the tx_mutex path, send to nic directly and return the pkts the nic accepted */
+static uint16_t tsq_burst_mutex(struct mt_tsq_entry* entry, struct rte_mbuf** tx_pkts,
+                                uint16_t nb_pkts) {
   struct mt_tsq_impl* tsqm = entry->parent;
   struct mt_tsq_queue* tsq_queue = &tsqm->tsq_queues[entry->queue_id];
-  uint16_t tx;
+  uint16_t tx = 0;
 
   rte_spinlock_lock(&tsq_queue->tx_mutex);
-  tx = rte_eth_tx_burst(tsq_queue->port_id, tsq_queue->queue_id, tx_pkts, nb_pkts);
-  tsq_queue->stat_pkts_send += tx;
+  /* keep the order with the pkts already in the ring */
+  if (tsq_queue->tx_ring) tsq_ring_drain(tsq_queue);
+  if (!tsq_queue->tx_ring || rte_ring_empty(tsq_queue->tx_ring)) {
+    tx = mt_dev_tx_burst(tsq_queue->tx_queue, tx_pkts, nb_pkts);
+    tsq_queue->stat_pkts_send += tx;
+  }
   rte_spinlock_unlock(&tsq_queue->tx_mutex);
 
+  rte_atomic64_add(&entry->enqueued, tx);
+  rte_atomic64_add(&entry->completed, tx);
   return tx;
 }
 
+/* the ring path, never block, return the pkts enqueued to the tx_ring */
+static uint16_t tsq_burst_ring(struct mt_tsq_entry* entry, struct rte_mbuf** tx_pkts,
+                               uint16_t nb_pkts) {
+  struct mt_tsq_impl* tsqm = entry->parent;
+  struct mt_tsq_queue* tsq_queue = &tsqm->tsq_queues[entry->queue_id];
+  struct mt_tsq_ring_elem elems[MT_SQ_BURST_SIZE];
+  uint16_t enqueued = 0;
+  uint32_t n, bulk;
+
+  while (enqueued < nb_pkts) {
+    bulk = RTE_MIN(nb_pkts - enqueued, MT_SQ_BURST_SIZE);
+    for (uint32_t i = 0; i < bulk; i++) {
+      elems[i].pkt = tx_pkts[enqueued + i];
+      elems[i].entry = entry;
+    }
+    n = rte_ring_mp_enqueue_burst_elem(tsq_queue->tx_ring, elems, sizeof(elems[0]), bulk,
+                                       NULL);
+    rte_atomic64_add(&entry->enqueued, n);
+    enqueued += n;
+    if (n < bulk) break; /* ring full, the caller retry */
+  }
+
+  tsq_ring_try_drain(tsq_queue);
+  return enqueued;
+}
+
+/*
+ * The pkts returned as sent are owned by the tsq. On the ring path they may still
+ * wait in the tx_ring, see mt_tsq_burst_busy to wait for the nic. The sys queue keeps
+ * the direct send: its callers are already serialized by the sys queue lock and the
+ * ptp tx timestamp need the pkt on the nic at the return.
+ */
+uint16_t mt_tsq_burst(struct mt_tsq_entry* entry, struct rte_mbuf** tx_pkts,
+                      uint16_t nb_pkts) {
+  struct mt_tsq_impl* tsqm = entry->parent;
+  struct mt_tsq_queue* tsq_queue = &tsqm->tsq_queues[entry->queue_id];
+
+  if (entry->flow.sys_queue || !tsq_queue->tx_ring)
+    return tsq_burst_mutex(entry, tx_pkts, nb_pkts);
+  else
+    return tsq_burst_ring(entry, tx_pkts, nb_pkts);
+}
+
 uint16_t mt_tsq_burst_busy(struct mtl_main_impl* impl, struct mt_tsq_entry* entry,
                            struct rte_mbuf** tx_pkts, uint16_t nb_pkts, int timeout_ms) {
+  struct mt_tsq_impl* tsqm = entry->parent;
+  struct mt_tsq_queue* tsq_queue = &tsqm->tsq_queues[entry->queue_id];
   uint16_t sent = 0;
   uint64_t start_ts = mt_get_tsc(impl);
 
@@ -605,9 +884,175 @@ uint16_t mt_tsq_burst_busy(struct mtl_main_impl* impl, struct mt_tsq_entry* entr
     sent += mt_tsq_burst(entry, &tx_pkts[sent], nb_pkts - sent);
   }
 
+  /* wait the nic accept all the pkts of this entry */
+  while (tsq_queue->tx_ring && tsq_entry_inflight(entry)) {
+    if (timeout_ms > 0) {
+      int ms = (mt_get_tsc(impl) - start_ts) / NS_PER_MS;
+      if (ms > timeout_ms) {
+        warn("%s(%u), pkts still in ring as timeout to %d ms\n", __func__,
+             mt_tsq_queue_id(entry), timeout_ms);
+        break;
+      }
+    }
+    tsq_ring_try_drain(tsq_queue);
+  }
+
   return sent;
 }
 
+struct tsq_stress_producer {
+  struct mtl_main_impl* impl;
+  struct mt_tsq_entry* entry;
+  bool mutex;
+  uint32_t nb_pkts;
+  uint64_t* lat_ns; /* latency of each burst call */
+  uint32_t max_lat;
+  uint32_t nb_lat;
+  uint32_t sent;
+};
+
+static void* tsq_stress_thread(void* arg) {
+  struct tsq_stress_producer* p = arg;
+  struct mtl_main_impl* impl = p->impl;
+  struct mt_tsq_entry* entry = p->entry;
+  enum mtl_port port = entry->parent->port;
+  struct rte_mbuf* pkts[MT_TSQ_STRESS_BULK];
+  struct mt_udp_hdr* hdr;
+  uint16_t bulk, tx;
+
+  while (p->sent < p->nb_pkts) {
+    bulk = RTE_MIN(p->nb_pkts - p->sent, MT_TSQ_STRESS_BULK);
+    if (rte_pktmbuf_alloc_bulk(entry->tx_pool, pkts, bulk) < 0) {
+      rte_pause();
+      continue;
+    }
+    for (uint16_t i = 0; i < bulk; i++) {
+      hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
+      memset(hdr, 0, sizeof(*hdr));
+      mt_macaddr_get(impl, port, mt_eth_s_addr(&hdr->eth));
+      mt_macaddr_get(impl, port, mt_eth_d_addr(&hdr->eth));
+      hdr->eth.ether_type = htons(RTE_ETHER_TYPE_IPV4);
+      hdr->ipv4.version_ihl = (4 << 4) | (sizeof(struct rte_ipv4_hdr) / 4);
+      hdr->ipv4.time_to_live = 64;
+      hdr->ipv4.next_proto_id = IPPROTO_UDP;
+      hdr->ipv4.total_length = htons(sizeof(hdr->ipv4) + sizeof(hdr->udp));
+      hdr->ipv4.src_addr = *(uint32_t*)mt_sip_addr(impl, port);
+      hdr->ipv4.dst_addr = *(uint32_t*)entry->flow.dip_addr;
+      hdr->udp.dst_port = htons(entry->flow.dst_port);
+      hdr->udp.src_port = hdr->udp.dst_port;
+      hdr->udp.dgram_len = htons(sizeof(hdr->udp));
+      pkts[i]->data_len = sizeof(*hdr);
+      pkts[i]->pkt_len = sizeof(*hdr);
+    }
+
+    uint16_t done = 0;
+    while (done < bulk) {
+      uint64_t start = mt_get_tsc(impl);
+      if (p->mutex)
+        tx = tsq_burst_mutex(entry, &pkts[done], bulk - done);
+      else
+        tx = tsq_burst_ring(entry, &pkts[done], bulk - done);
+      p->lat_ns[p->nb_lat++ % p->max_lat] = mt_get_tsc(impl) - start;
+      done += tx;
+    }
+    p->sent += bulk;
+  }
+
+  return NULL;
+}
+
+static int tsq_stress_u64_cmp(const void* a, const void* b) {
+  uint64_t ai = *(const uint64_t*)a;
+  uint64_t bi = *(const uint64_t*)b;
+  return ai < bi ? -1 : (ai > bi ? 1 : 0);
+}
+
+int mtl_tsq_stress(mtl_handle mt, enum mtl_port port, bool mutex, uint32_t nb_producers,
+                   uint32_t nb_pkts, struct mtl_tsq_stress_result* result) {
+  struct mtl_main_impl* impl = mt;
+  struct tsq_stress_producer producers[MT_TSQ_STRESS_PRODUCERS_MAX];
+  pthread_t tids[MT_TSQ_STRESS_PRODUCERS_MAX];
+  uint64_t* lat_ns = NULL;
+  uint32_t max_lat = nb_pkts / MT_TSQ_STRESS_BULK + 1;
+  uint32_t nb_lat = 0;
+  struct mt_txq_flow flow;
+  int ret = 0;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (port >= mt_num_ports(impl) || !impl->tsq[port]) {
+    err("%s(%d), shared tx queue not enabled\n", __func__, port);
+    return -ENOTSUP;
+  }
+  if (!nb_producers || nb_producers > MT_TSQ_STRESS_PRODUCERS_MAX || !nb_pkts) {
+    err("%s(%d), invalid nb_producers %u or nb_pkts %u\n", __func__, port, nb_producers,
+        nb_pkts);
+    return -EINVAL;
+  }
+
+  /* all producers on the same flow, so the same shared queue */
+  memset(&flow, 0, sizeof(flow));
+  rte_memcpy(flow.dip_addr, mt_sip_addr(impl, port), MTL_IP_ADDR_LEN);
+  flow.dst_port = 9; /* discard */
+  memset(producers, 0, sizeof(producers));
+  lat_ns = mt_zmalloc(sizeof(*lat_ns) * max_lat * nb_producers);
+  if (!lat_ns) {
+    err("%s(%d), lat_ns malloc fail\n", __func__, port);
+    return -ENOMEM;
+  }
+  for (uint32_t i = 0; i < nb_producers; i++) {
+    producers[i].impl = impl;
+    producers[i].mutex = mutex;
+    producers[i].nb_pkts = nb_pkts;
+    producers[i].max_lat = max_lat;
+    producers[i].lat_ns = lat_ns + (uint64_t)i * max_lat;
+    producers[i].entry = mt_tsq_get(impl, port, &flow);
+    if (!producers[i].entry) {
+      err("%s(%d), tsq get fail on %u\n", __func__, port, i);
+      ret = -EIO;
+      goto exit;
+    }
+  }
+
+  uint64_t start = mt_get_tsc(impl);
+  for (uint32_t i = 0; i < nb_producers; i++)
+    pthread_create(&tids[i], NULL, tsq_stress_thread, &producers[i]);
+  for (uint32_t i = 0; i < nb_producers; i++) pthread_join(tids[i], NULL);
+  /* the pps count the pkts which reach the nic */
+  for (uint32_t i = 0; i < nb_producers; i++) {
+    if (tsq_entry_wait_done(impl, producers[i].entry, MT_TSQ_PUT_TIMEOUT_MS) < 0)
+      ret = -ETIMEDOUT;
+  }
+  uint64_t end = mt_get_tsc(impl);
+
+  memset(result, 0, sizeof(*result));
+  for (uint32_t i = 0; i < nb_producers; i++) {
+    struct tsq_stress_producer* p = &producers[i];
+    uint32_t nb = RTE_MIN(p->nb_lat, p->max_lat);
+
+    result->sent += rte_atomic64_read(&p->entry->completed);
+    result->dropped += rte_atomic64_read(&p->entry->dropped);
+    memmove(lat_ns + nb_lat, p->lat_ns, sizeof(*lat_ns) * nb);
+    nb_lat += nb;
+  }
+  qsort(lat_ns, nb_lat, sizeof(*lat_ns), tsq_stress_u64_cmp);
+  result->p99_ns = lat_ns[(uint64_t)nb_lat * 99 / 100];
+  result->max_ns = lat_ns[nb_lat - 1];
+  result->pps = (double)result->sent * NS_PER_S / (end - start);
+  info("%s(%d), %s %u producers, pps %f p99 %" PRIu64 "ns max %" PRIu64 "ns\n",
+       __func__, port, mutex ? "mutex" : "ring", nb_producers, result->pps,
+       result->p99_ns, result->max_ns);
+
+exit:
+  for (uint32_t i = 0; i < nb_producers; i++) {
+    if (producers[i].entry) mt_tsq_put(producers[i].entry);
+  }
+  mt_free(lat_ns);
+  return ret;
+}
+
 int mt_tsq_flush(struct mtl_main_impl* impl, struct mt_tsq_entry* entry,
                  struct rte_mbuf* pad) {
   struct mt_tsq_impl* tsqm = entry->parent;
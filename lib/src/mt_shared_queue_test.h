@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+/* The test hooks of mt_shared_queue.c, not installed, for the gtest only */
+
+#ifndef _MT_LIB_SHARED_QUEUE_TEST_HEAD_H_
+#define _MT_LIB_SHARED_QUEUE_TEST_HEAD_H_
+
+#include "mtl_api.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * The result of mtl_tsq_stress.
+ */
+struct mtl_tsq_stress_result {
+  /** the pkts accepted by the nic per second */
+  double pps;
+  /** the p99 latency of one burst call of the producers in ns */
+  uint64_t p99_ns;
+  /** the max latency of one burst call of the producers in ns */
+  uint64_t max_ns;
+  /** the pkts accepted by the nic */
+  uint64_t sent;
+  /** the pkts dropped without tx */
+  uint64_t dropped;
+};
+
+/**
+ * Stress one shared tx queue with multi producer threads, each one sends nb_pkts small
+ * udp pkts to the port itself through its own tsq entry on the same queue. Compare the
+ * lock-free ring aggregation against the tx mutex path.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param port
+ *   The port, the shared tx queue should be enabled on it.
+ * @param mutex
+ *   True to send by the tx mutex path, false by the ring path.
+ * @param nb_producers
+ *   The number of the producer threads, max 64.
+ * @param nb_pkts
+ *   The number of the pkts of each producer.
+ * @param result
+ *   A pointer to the result.
+ * @return
+ *   - 0 if successful.
+ *   - -ENOTSUP: the shared tx queue is not enabled.
+ *   - <0: Error code if fail or any pkt not accepted by the nic in time.
+ */
+int mtl_tsq_stress(mtl_handle mt, enum mtl_port port, bool mutex, uint32_t nb_producers,
+                   uint32_t nb_pkts, struct mtl_tsq_stress_result* result);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
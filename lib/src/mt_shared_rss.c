@@ -4,6 +4,7 @@
 
 #include "mt_shared_rss.h"
 
+#include "mt_dev.h"
 #include "mt_log.h"
 #include "mt_sch.h"
 #include "mt_stat.h"
@@ -26,36 +27,52 @@ static inline void srss_unlock(struct mt_srss_impl* srss) {
   rte_spinlock_unlock(&srss->mutex);
 }
 
-static inline void srss_entry_pkts_enqueue(struct mt_srss_entry* entry,
+static inline void srss_sch_lock(struct mt_srss_sch* srss_sch) {
+  rte_spinlock_lock(&srss_sch->mutex);
+}
+
+/* return true if try lock succ */
+static inline bool srss_sch_try_lock(struct mt_srss_sch* srss_sch) {
+  int ret = rte_spinlock_trylock(&srss_sch->mutex);
+  return ret ? true : false;
+}
+
+static inline void srss_sch_unlock(struct mt_srss_sch* srss_sch) {
+  rte_spinlock_unlock(&srss_sch->mutex);
+}
+
+static inline void srss_entry_pkts_enqueue(struct mt_srss_entry* entry, int sch_idx,
                                            struct rte_mbuf** pkts,
                                            const uint16_t nb_pkts) {
-  /* use bulk version */
-  unsigned int n = rte_ring_sp_enqueue_bulk(entry->ring, (void**)pkts, nb_pkts, NULL);
-  entry->stat_enqueue_cnt += n;
+  /* use bulk version, mp or sp is decided by the ring flags */
+  unsigned int n = rte_ring_enqueue_bulk(entry->ring, (void**)pkts, nb_pkts, NULL);
+  entry->stat_enqueue_cnt[sch_idx] += n;
   if (n == 0) {
     rte_pktmbuf_free_bulk(pkts, nb_pkts);
-    entry->stat_enqueue_fail_cnt += nb_pkts;
+    entry->stat_enqueue_fail_cnt[sch_idx] += nb_pkts;
   }
 }
 
-#define UPDATE_ENTRY()                                                             \
-  do {                                                                             \
-    if (matched_pkts_nb)                                                           \
-      srss_entry_pkts_enqueue(last_srss_entry, &matched_pkts[0], matched_pkts_nb); \
-    last_srss_entry = srss_entry;                                                  \
-    matched_pkts_nb = 0;                                                           \
+#define UPDATE_ENTRY()                                                           \
+  do {                                                                           \
+    if (matched_pkts_nb)                                                         \
+      srss_entry_pkts_enqueue(last_srss_entry, srss_sch->idx, &matched_pkts[0],  \
+                              matched_pkts_nb);                                  \
+    last_srss_entry = srss_entry;                                                \
+    matched_pkts_nb = 0;                                                         \
   } while (0)
 
-#define CNI_ENQUEUE()                                        \
-  do {                                                       \
-    if (srss->cni_entry)                                     \
-      srss_entry_pkts_enqueue(srss->cni_entry, &pkts[i], 1); \
-    else                                                     \
-      rte_pktmbuf_free(pkts[i]);                             \
+#define CNI_ENQUEUE()                                                       \
+  do {                                                                      \
+    if (srss->cni_entry)                                                    \
+      srss_entry_pkts_enqueue(srss->cni_entry, srss_sch->idx, &pkts[i], 1); \
+    else                                                                    \
+      rte_pktmbuf_free(pkts[i]);                                            \
   } while (0)
 
-static int srss_tasklet_handler(void* priv) {
-  struct mt_srss_impl* srss = priv;
+static int srss_sch_tasklet_handler(void* priv) {
+  struct mt_srss_sch* srss_sch = priv;
+  struct mt_srss_impl* srss = srss_sch->parent;
   struct mtl_main_impl* impl = srss->parent;
   struct mt_interface* inf = mt_if(impl, srss->port);
   struct rte_mbuf *pkts[MT_SRSS_BURST_SIZE], *matched_pkts[MT_SRSS_BURST_SIZE];
@@ -64,14 +81,15 @@ static int srss_tasklet_handler(void* priv) {
   struct rte_ipv4_hdr* ipv4;
   struct rte_udp_hdr* udp;
 
-  for (uint16_t queue = 0; queue < inf->max_rx_queues; queue++) {
+  /* the srss thread or other tasklet is polling */
+  if (!srss_sch_try_lock(srss_sch)) return MT_TASKLET_ALL_DONE;
+
+  for (uint16_t queue = srss_sch->q_start; queue < srss_sch->q_end; queue++) {
     uint16_t matched_pkts_nb = 0;
 
-    uint16_t rx =
-        rte_eth_rx_burst(mt_port_id(impl, srss->port), queue, pkts, MT_SRSS_BURST_SIZE);
+    uint16_t rx = mt_dev_rx_burst(&inf->rx_queues[queue], pkts, MT_SRSS_BURST_SIZE);
     if (!rx) continue;
 
-    srss_lock(srss);
     last_srss_entry = NULL;
     for (uint16_t i = 0; i < rx; i++) {
       srss_entry = NULL;
@@ -89,37 +107,21 @@ static int srss_tasklet_handler(void* priv) {
         continue;
       }
       udp = &hdr->udp;
-      MT_TAILQ_FOREACH(srss_entry, &srss->head, next) {
-        bool ip_matched;
-        if (srss_entry->flow.no_ip_flow) {
-          ip_matched = true;
-        } else {
-          ip_matched = mt_is_multicast_ip(srss_entry->flow.dip_addr)
-                           ? (ipv4->dst_addr == *(uint32_t*)srss_entry->flow.dip_addr)
-                           : (ipv4->src_addr == *(uint32_t*)srss_entry->flow.dip_addr);
-        }
-        bool port_matched;
-        if (srss_entry->flow.no_port_flow) {
-          port_matched = true;
-        } else {
-          port_matched = ntohs(udp->dst_port) == srss_entry->flow.dst_port;
-        }
-        if (ip_matched && port_matched) { /* match dst ip:port */
-          if (srss_entry != last_srss_entry) UPDATE_ENTRY();
-          matched_pkts[matched_pkts_nb++] = pkts[i];
-          break;
-        }
-      }
-      if (!srss_entry) { /* no match, redirect to cni */
+      srss_entry = mt_flow_hash_lookup(&srss_sch->flow_hash, ipv4, udp);
+      if (srss_entry) { /* match dst ip:port */
+        if (srss_entry != last_srss_entry) UPDATE_ENTRY();
+        matched_pkts[matched_pkts_nb++] = pkts[i];
+      } else { /* no match, redirect to cni */
         UPDATE_ENTRY();
         CNI_ENQUEUE();
       }
     }
     if (matched_pkts_nb)
-      srss_entry_pkts_enqueue(last_srss_entry, &matched_pkts[0], matched_pkts_nb);
-    srss_unlock(srss);
+      srss_entry_pkts_enqueue(last_srss_entry, srss_sch->idx, &matched_pkts[0],
+                              matched_pkts_nb);
   }
 
+  srss_sch_unlock(srss_sch);
   return 0;
 }
 
@@ -128,7 +130,7 @@ static void* srss_traffic_thread(void* arg) {
 
   info("%s, start\n", __func__);
   while (rte_atomic32_read(&srss->stop_thread) == 0) {
-    srss_tasklet_handler(srss);
+    for (int i = 0; i < srss->schs_cnt; i++) srss_sch_tasklet_handler(&srss->schs[i]);
     mt_sleep_ms(1);
   }
   info("%s, stop\n", __func__);
@@ -164,19 +166,28 @@ static int srss_traffic_thread_stop(struct mt_srss_impl* srss) {
   return 0;
 }
 
-static int srss_tasklet_start(void* priv) {
-  struct mt_srss_impl* srss = priv;
+static int srss_sch_tasklet_start(void* priv) {
+  struct mt_srss_sch* srss_sch = priv;
+  struct mt_srss_impl* srss = srss_sch->parent;
 
-  /* tasklet will take over the srss thread */
-  srss_traffic_thread_stop(srss);
+  /* the first tasklet will take over the srss thread, not hold any spinlock for join */
+  mt_pthread_mutex_lock(&srss->thread_mutex);
+  srss->tasklet_started++;
+  if (srss->tasklet_started == 1) srss_traffic_thread_stop(srss);
+  mt_pthread_mutex_unlock(&srss->thread_mutex);
 
   return 0;
 }
 
-static int srss_tasklet_stop(void* priv) {
-  struct mt_srss_impl* srss = priv;
+static int srss_sch_tasklet_stop(void* priv) {
+  struct mt_srss_sch* srss_sch = priv;
+  struct mt_srss_impl* srss = srss_sch->parent;
 
-  srss_traffic_thread_start(srss);
+  /* the last tasklet give back to the srss thread */
+  mt_pthread_mutex_lock(&srss->thread_mutex);
+  srss->tasklet_started--;
+  if (srss->tasklet_started == 0) srss_traffic_thread_start(srss);
+  mt_pthread_mutex_unlock(&srss->thread_mutex);
 
   return 0;
 }
@@ -192,16 +203,24 @@ static int srss_stat(void* priv) {
     return 0;
   }
   MT_TAILQ_FOREACH(entry, &srss->head, next) {
+    uint32_t enqueue = 0, enqueue_fail = 0;
+    uint32_t dequeue = entry->stat_dequeue_cnt;
+
     idx = entry->idx;
+    for (int i = 0; i < srss->schs_cnt; i++) {
+      enqueue += entry->stat_enqueue_cnt[i];
+      enqueue_fail += entry->stat_enqueue_fail_cnt[i];
+    }
     notice("%s(%d,%d), enqueue %u dequeue %u\n", __func__, port, idx,
-           entry->stat_enqueue_cnt, entry->stat_dequeue_cnt);
-    entry->stat_enqueue_cnt = 0;
-    entry->stat_dequeue_cnt = 0;
-    if (entry->stat_enqueue_fail_cnt) {
+           enqueue - entry->stat_enqueue_reported,
+           dequeue - entry->stat_dequeue_reported);
+    if (enqueue_fail != entry->stat_enqueue_fail_reported) {
       warn("%s(%d,%d), enqueue fail %u\n", __func__, port, idx,
-           entry->stat_enqueue_fail_cnt);
-      entry->stat_enqueue_fail_cnt = 0;
+           enqueue_fail - entry->stat_enqueue_fail_reported);
     }
+    entry->stat_enqueue_reported = enqueue;
+    entry->stat_enqueue_fail_reported = enqueue_fail;
+    entry->stat_dequeue_reported = dequeue;
   }
   srss_unlock(srss);
 
@@ -238,8 +257,10 @@ struct mt_srss_entry* mt_srss_get(struct mtl_main_impl* impl, enum mtl_port port
   /* ring create */
   char ring_name[32];
   snprintf(ring_name, 32, "%sP%d_%d", MT_SRSS_RING_PREFIX, port, idx);
-  entry->ring = rte_ring_create(ring_name, 512, mt_socket_id(impl, MTL_PORT_P),
-                                RING_F_SP_ENQ | RING_F_SC_DEQ);
+  unsigned int flags = RING_F_SC_DEQ;
+  /* single producer only if one srss sch */
+  if (srss->schs_cnt <= 1) flags |= RING_F_SP_ENQ;
+  entry->ring = rte_ring_create(ring_name, 512, mt_socket_id(impl, MTL_PORT_P), flags);
   if (!entry->ring) {
     err("%s(%d,%d), ring create fail\n", __func__, port, idx);
     mt_rte_free(entry);
@@ -252,7 +273,16 @@ struct mt_srss_entry* mt_srss_get(struct mtl_main_impl* impl, enum mtl_port port
 
   srss_lock(srss);
   MT_TAILQ_INSERT_TAIL(&srss->head, entry, next);
-  if (flow->sys_queue) srss->cni_entry = entry;
+  if (flow->sys_queue) {
+    srss->cni_entry = entry;
+  } else {
+    for (int i = 0; i < srss->schs_cnt; i++) {
+      struct mt_srss_sch* srss_sch = &srss->schs[i];
+      srss_sch_lock(srss_sch);
+      mt_flow_hash_add(&srss_sch->flow_hash, &entry->hash_node[i], &entry->flow, entry);
+      srss_sch_unlock(srss_sch);
+    }
+  }
   srss->entry_idx++;
   srss_unlock(srss);
 
@@ -267,6 +297,19 @@ int mt_srss_put(struct mt_srss_entry* entry) {
 
   srss_lock(srss);
   MT_TAILQ_REMOVE(&srss->head, entry, next);
+  if (entry->flow.sys_queue) {
+    /* wait all srss sch leave the cni entry */
+    for (int i = 0; i < srss->schs_cnt; i++) srss_sch_lock(&srss->schs[i]);
+    if (srss->cni_entry == entry) srss->cni_entry = NULL;
+    for (int i = 0; i < srss->schs_cnt; i++) srss_sch_unlock(&srss->schs[i]);
+  } else {
+    for (int i = 0; i < srss->schs_cnt; i++) {
+      struct mt_srss_sch* srss_sch = &srss->schs[i];
+      srss_sch_lock(srss_sch);
+      mt_flow_hash_del(&srss_sch->flow_hash, &entry->hash_node[i]);
+      srss_sch_unlock(srss_sch);
+    }
+  }
   srss_unlock(srss);
 
   if (entry->ring) {
@@ -280,6 +323,96 @@ int mt_srss_put(struct mt_srss_entry* entry) {
   return 0;
 }
 
+static int srss_schs_uinit(struct mt_srss_impl* srss) {
+  for (int i = 0; i < srss->schs_cnt; i++) {
+    struct mt_srss_sch* srss_sch = &srss->schs[i];
+
+    if (srss_sch->tasklet) {
+      mt_sch_unregister_tasklet(srss_sch->tasklet);
+      srss_sch->tasklet = NULL;
+    }
+    if (srss_sch->sch) {
+      mt_sch_put(srss_sch->sch, 0);
+      srss_sch->sch = NULL;
+    }
+    mt_flow_hash_uinit(&srss_sch->flow_hash);
+  }
+
+  return 0;
+}
+
+static int srss_schs_init(struct mtl_main_impl* impl, struct mt_srss_impl* srss) {
+  enum mtl_port port = srss->port;
+  uint16_t nb_queues = mt_if(impl, port)->max_rx_queues;
+  int schs_cnt = mt_get_user_params(impl)->rss_sch_nb[port];
+  mt_sch_mask_t sch_mask = MT_SCH_MASK_ALL;
+
+  if (!schs_cnt) schs_cnt = 1;
+  if (schs_cnt > MT_SRSS_SCH_MAX) {
+    warn("%s(%d), sch nb %d too large, limit to %d\n", __func__, port, schs_cnt,
+         MT_SRSS_SCH_MAX);
+    schs_cnt = MT_SRSS_SCH_MAX;
+  }
+  if (schs_cnt > nb_queues) schs_cnt = nb_queues;
+
+  /* each srss sch on a different sch, go on with the ones got if lcores not enough */
+  for (int i = 0; i < schs_cnt; i++) {
+    struct mt_sch_impl* sch = mt_sch_get(impl, 0, MT_SCH_TYPE_DEFAULT, sch_mask);
+    if (!sch) {
+      if (!i) {
+        err("%s(%d), get sch fail\n", __func__, port);
+        return -EIO;
+      }
+      warn("%s(%d), only %d of %d sch got, split the queues on them\n", __func__, port,
+           i, schs_cnt);
+      schs_cnt = i;
+      break;
+    }
+    srss->schs[i].sch = sch;
+    /* count it now for the uinit routine */
+    srss->schs_cnt = i + 1;
+    sch_mask &= ~MTL_BIT64(sch->idx);
+  }
+
+  for (int i = 0; i < schs_cnt; i++) {
+    struct mt_srss_sch* srss_sch = &srss->schs[i];
+    struct mt_sch_impl* sch = srss_sch->sch;
+
+    srss_sch->parent = srss;
+    srss_sch->idx = i;
+    /* split the queues evenly */
+    srss_sch->q_start = nb_queues * i / schs_cnt;
+    srss_sch->q_end = nb_queues * (i + 1) / schs_cnt;
+    rte_spinlock_init(&srss_sch->mutex);
+    int ret = mt_flow_hash_init(&srss_sch->flow_hash, mt_socket_id(impl, port));
+    if (ret < 0) {
+      err("%s(%d,%d), flow hash init fail %d\n", __func__, port, i, ret);
+      srss_schs_uinit(srss);
+      return ret;
+    }
+
+    struct mt_sch_tasklet_ops ops;
+    memset(&ops, 0x0, sizeof(ops));
+    ops.priv = srss_sch;
+    ops.name = "shared_rss";
+    ops.start = srss_sch_tasklet_start;
+    ops.stop = srss_sch_tasklet_stop;
+    ops.handler = srss_sch_tasklet_handler;
+    /* no MT_TASKLET_BALANCE, the srss schs are spread on different sch by design */
+
+    srss_sch->tasklet = mt_sch_register_tasklet(sch, &ops);
+    if (!srss_sch->tasklet) {
+      err("%s(%d,%d), mt_sch_register_tasklet fail\n", __func__, port, i);
+      srss_schs_uinit(srss);
+      return -EIO;
+    }
+    info("%s(%d,%d), queues %u to %u on sch %d\n", __func__, port, i, srss_sch->q_start,
+         srss_sch->q_end, sch->idx);
+  }
+
+  return 0;
+}
+
 int mt_srss_init(struct mtl_main_impl* impl) {
   int num_ports = mt_num_ports(impl);
   int ret;
@@ -295,31 +428,17 @@ int mt_srss_init(struct mtl_main_impl* impl) {
     }
     struct mt_srss_impl* srss = impl->srss[i];
 
-    struct mt_sch_impl* sch = mt_sch_get(impl, 0, MT_SCH_TYPE_DEFAULT, MT_SCH_MASK_ALL);
-    if (!sch) {
-      err("%s(%d), get sch fail\n", __func__, i);
-      mt_srss_uinit(impl);
-      return -EIO;
-    }
-
-    struct mt_sch_tasklet_ops ops;
-    memset(&ops, 0x0, sizeof(ops));
-    ops.priv = srss;
-    ops.name = "shared_rss";
-    ops.start = srss_tasklet_start;
-    ops.stop = srss_tasklet_stop;
-    ops.handler = srss_tasklet_handler;
-
-    srss->sch = sch;
     srss->port = i;
     srss->parent = impl;
     MT_TAILQ_INIT(&srss->head);
+    mt_pthread_mutex_init(&srss->thread_mutex, NULL);
+    srss->tasklet_started = 0;
 
-    srss->tasklet = mt_sch_register_tasklet(sch, &ops);
-    if (!srss->tasklet) {
-      err("%s, mt_sch_register_tasklet fail\n", __func__);
+    ret = srss_schs_init(impl, srss);
+    if (ret < 0) {
+      err("%s(%d), srss_schs_init fail\n", __func__, i);
       mt_srss_uinit(impl);
-      return -EIO;
+      return ret;
     }
 
     rte_atomic32_set(&srss->stop_thread, 0);
@@ -332,7 +451,7 @@ int mt_srss_init(struct mtl_main_impl* impl) {
 
     mt_stat_register(impl, srss_stat, srss, "srss");
 
-    info("%s(%d), succ with shared rss mode\n", __func__, i);
+    info("%s(%d), succ with shared rss mode, %d sch\n", __func__, i, srss->schs_cnt);
   }
 
   return 0;
@@ -347,14 +466,7 @@ int mt_srss_uinit(struct mtl_main_impl* impl) {
 
     mt_stat_unregister(impl, srss_stat, srss);
     srss_traffic_thread_stop(srss);
-    if (srss->tasklet) {
-      mt_sch_unregister_tasklet(srss->tasklet);
-      srss->tasklet = NULL;
-    }
-    if (srss->sch) {
-      mt_sch_put(srss->sch, 0);
-      srss->sch = NULL;
-    }
+    srss_schs_uinit(srss);
     struct mt_srss_entry* entry;
     while ((entry = MT_TAILQ_FIRST(&srss->head))) {
       warn("%s, still has entry %p\n", __func__, entry);
@@ -362,9 +474,10 @@ int mt_srss_uinit(struct mtl_main_impl* impl) {
       mt_rte_free(entry);
     }
 
+    mt_pthread_mutex_destroy(&srss->thread_mutex);
     mt_rte_free(srss);
     impl->srss[i] = NULL;
   }
 
   return 0;
-}
\ No newline at end of file
+}
@@ -4,8 +4,11 @@
 
 #include "mt_util.h"
 
+#include "mt_af_packet.h"
 #include "mt_log.h"
 #include "mt_main.h"
+#include "mt_simd.h"
+#include "mt_util_test.h"
 
 #ifdef MTL_HAS_ASAN
 #include <execinfo.h>
@@ -160,6 +163,403 @@ bool mt_bitmap_test_and_unset(uint8_t* bitmap, int idx) {
   return false;
 }
 
+static enum mtl_simd_level bitmap_simd_level(void) {
+  static int level = -1;
+
+  /* cpu flags query is not cheap, cache it */
+  if (level < 0) level = mtl_get_simd_level();
+  return level;
+}
+
+#ifdef MTL_HAS_AVX2
+MT_TARGET_CODE_START_AVX2
+static void bitmap64_clear_avx2(uint64_t* bitmap, uint32_t nb_words) {
+  __m256i zero = _mm256_setzero_si256();
+  uint32_t i = 0;
+
+  for (; i + 4 <= nb_words; i += 4) _mm256_storeu_si256((__m256i*)&bitmap[i], zero);
+  for (; i < nb_words; i++) bitmap[i] = 0;
+}
+
+static uint32_t bitmap64_count_avx2(uint64_t* bitmap, uint32_t nb_words) {
+  /* bits count for each nibble */
+  __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                                 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i zero = _mm256_setzero_si256();
+  __m256i acc = zero;
+  uint32_t i = 0;
+  uint64_t sum;
+
+  for (; i + 4 <= nb_words; i += 4) {
+    __m256i v = _mm256_loadu_si256((__m256i*)&bitmap[i]);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i cnt =
+        _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, zero));
+  }
+  sum = _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+        _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+  for (; i < nb_words; i++) sum += __builtin_popcountll(bitmap[i]);
+
+  return sum;
+}
+MT_TARGET_CODE_STOP
+#endif
+
+#ifdef MTL_HAS_AVX512
+MT_TARGET_CODE_START_AVX512
+static void bitmap64_clear_avx512(uint64_t* bitmap, uint32_t nb_words) {
+  __m512i zero = _mm512_setzero_si512();
+  uint32_t i = 0;
+
+  for (; i + 8 <= nb_words; i += 8) _mm512_storeu_si512((__m512i*)&bitmap[i], zero);
+  for (; i < nb_words; i++) bitmap[i] = 0;
+}
+
+static uint32_t bitmap64_count_avx512(uint64_t* bitmap, uint32_t nb_words) {
+  /* bits count for each nibble */
+  __m512i lut = _mm512_set4_epi32(0x04030302, 0x03020201, 0x03020201, 0x02010100);
+  __m512i low_mask = _mm512_set1_epi8(0x0f);
+  __m512i zero = _mm512_setzero_si512();
+  __m512i acc = zero;
+  uint32_t i = 0;
+  uint64_t sum;
+
+  for (; i + 8 <= nb_words; i += 8) {
+    __m512i v = _mm512_loadu_si512((__m512i*)&bitmap[i]);
+    __m512i lo = _mm512_and_si512(v, low_mask);
+    __m512i hi = _mm512_and_si512(_mm512_srli_epi16(v, 4), low_mask);
+    __m512i cnt =
+        _mm512_add_epi8(_mm512_shuffle_epi8(lut, lo), _mm512_shuffle_epi8(lut, hi));
+    acc = _mm512_add_epi64(acc, _mm512_sad_epu8(cnt, zero));
+  }
+  sum = _mm512_reduce_add_epi64(acc);
+  for (; i < nb_words; i++) sum += __builtin_popcountll(bitmap[i]);
+
+  return sum;
+}
+MT_TARGET_CODE_STOP
+#endif
+
+void mt_bitmap64_clear_simd(uint64_t* bitmap, uint32_t nb_words,
+                            enum mtl_simd_level level) {
+  level = RTE_MIN(level, bitmap_simd_level());
+  MT_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX512
+  if (level >= MTL_SIMD_LEVEL_AVX512) {
+    bitmap64_clear_avx512(bitmap, nb_words);
+    return;
+  }
+#endif
+#ifdef MTL_HAS_AVX2
+  if (level >= MTL_SIMD_LEVEL_AVX2) {
+    bitmap64_clear_avx2(bitmap, nb_words);
+    return;
+  }
+#endif
+
+  memset(bitmap, 0, nb_words * sizeof(*bitmap));
+}
+
+uint32_t mt_bitmap64_count_simd(uint64_t* bitmap, uint32_t nb_words,
+                                enum mtl_simd_level level) {
+  uint32_t sum = 0;
+
+  level = RTE_MIN(level, bitmap_simd_level());
+  MT_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX512
+  if (level >= MTL_SIMD_LEVEL_AVX512) return bitmap64_count_avx512(bitmap, nb_words);
+#endif
+#ifdef MTL_HAS_AVX2
+  if (level >= MTL_SIMD_LEVEL_AVX2) return bitmap64_count_avx2(bitmap, nb_words);
+#endif
+
+  for (uint32_t i = 0; i < nb_words; i++) sum += __builtin_popcountll(bitmap[i]);
+  return sum;
+}
+
+void mt_bitmap64_clear(uint64_t* bitmap, uint32_t nb_words) {
+  mt_bitmap64_clear_simd(bitmap, nb_words, bitmap_simd_level());
+}
+
+uint32_t mt_bitmap64_count(uint64_t* bitmap, uint32_t nb_words) {
+  return mt_bitmap64_count_simd(bitmap, nb_words, bitmap_simd_level());
+}
+
+int mt_bitmap64_missing_ranges(uint64_t* bitmap, uint32_t nb_bits,
+                               struct mt_bitmap_range* ranges, int max_ranges) {
+  uint32_t nb_words = mt_bitmap64_words(nb_bits);
+  uint32_t idx = 0, start, w;
+  uint64_t bits;
+  int nb = 0;
+
+  while ((idx < nb_bits) && (nb < max_ranges)) {
+    /* find the next unset bit */
+    w = idx / 64;
+    bits = ~bitmap[w] & (UINT64_MAX << (idx % 64));
+    if (!bits) {
+      idx = (w + 1) * 64;
+      continue;
+    }
+    start = w * 64 + __builtin_ctzll(bits);
+    if (start >= nb_bits) break;
+
+    /* find the next set bit */
+    bits = bitmap[w] & (UINT64_MAX << (start % 64));
+    while (!bits && (++w < nb_words)) bits = bitmap[w];
+    idx = bits ? (w * 64 + __builtin_ctzll(bits)) : nb_bits;
+    if (idx > nb_bits) idx = nb_bits;
+
+    ranges[nb].start = start;
+    ranges[nb].nb = idx - start;
+    nb++;
+  }
+
+  return nb;
+}
+
+void mtl_bitmap64_clear(uint64_t* bitmap, uint32_t nb_words, enum mtl_simd_level level) {
+  mt_bitmap64_clear_simd(bitmap, nb_words, level);
+}
+
+uint32_t mtl_bitmap64_count(uint64_t* bitmap, uint32_t nb_words,
+                            enum mtl_simd_level level) {
+  return mt_bitmap64_count_simd(bitmap, nb_words, level);
+}
+
+int mtl_bitmap64_missing_ranges(uint64_t* bitmap, uint32_t nb_bits,
+                                struct st20_rx_pkt_range* ranges, int max_ranges) {
+  if (max_ranges <= 0) return -EINVAL;
+
+  struct mt_bitmap_range bm_ranges[max_ranges];
+  int nb = mt_bitmap64_missing_ranges(bitmap, nb_bits, bm_ranges, max_ranges);
+  for (int i = 0; i < nb; i++) {
+    ranges[i].start = bm_ranges[i].start;
+    ranges[i].nb = bm_ranges[i].nb;
+  }
+  return nb;
+}
+
+int mt_flow_hash_init(struct mt_flow_hash* hash, int soc_id) {
+  memset(hash, 0, sizeof(*hash));
+  hash->soc_id = soc_id;
+  hash->buckets =
+      mt_rte_zmalloc_socket(sizeof(*hash->buckets) * MT_FLOW_HASH_BUCKETS_MIN, soc_id);
+  if (!hash->buckets) {
+    err("%s, buckets malloc fail\n", __func__);
+    return -ENOMEM;
+  }
+  hash->nb_buckets = MT_FLOW_HASH_BUCKETS_MIN;
+  return 0;
+}
+
+void mt_flow_hash_uinit(struct mt_flow_hash* hash) {
+  if (hash->buckets) {
+    mt_rte_free(hash->buckets);
+    hash->buckets = NULL;
+  }
+  hash->nb_buckets = 0;
+}
+
+/* double the buckets and rehash all nodes, keep the order of each chain */
+static int flow_hash_grow(struct mt_flow_hash* hash) {
+  uint32_t nb_buckets = hash->nb_buckets * 2;
+  struct mt_flow_hash_node** buckets;
+  struct mt_flow_hash_node** tails;
+  struct mt_flow_hash_node* node;
+
+  buckets = mt_rte_zmalloc_socket(sizeof(*buckets) * nb_buckets, hash->soc_id);
+  if (!buckets) return -ENOMEM;
+  /* the tail of each new chain */
+  tails = mt_rte_zmalloc_socket(sizeof(*tails) * nb_buckets, hash->soc_id);
+  if (!tails) {
+    mt_rte_free(buckets);
+    return -ENOMEM;
+  }
+
+  for (uint32_t i = 0; i < hash->nb_buckets; i++) {
+    node = hash->buckets[i];
+    while (node) {
+      struct mt_flow_hash_node* next = node->next;
+      uint32_t b = rte_hash_crc_8byte(node->key, node->type) & (nb_buckets - 1);
+
+      node->next = NULL;
+      if (tails[b])
+        tails[b]->next = node;
+      else
+        buckets[b] = node;
+      tails[b] = node;
+      node = next;
+    }
+  }
+
+  mt_rte_free(tails);
+  mt_rte_free(hash->buckets);
+  hash->buckets = buckets;
+  hash->nb_buckets = nb_buckets;
+  dbg("%s, %u buckets for %u nodes\n", __func__, nb_buckets, hash->nb_total);
+  return 0;
+}
+
+int mt_flow_hash_add(struct mt_flow_hash* hash, struct mt_flow_hash_node* node,
+                     struct mt_rxq_flow* flow, void* priv) {
+  uint32_t ip = flow->no_ip_flow ? 0 : *(uint32_t*)flow->dip_addr;
+  uint16_t port = flow->no_port_flow ? 0 : flow->dst_port;
+  uint32_t bucket;
+
+  if (flow->sys_queue) {
+    err("%s, sys queue flow is not hashed\n", __func__);
+    return -EINVAL;
+  }
+
+  if (flow->no_ip_flow)
+    node->type = flow->no_port_flow ? MT_FLOW_HASH_ANY : MT_FLOW_HASH_NO_IP;
+  else
+    node->type = flow->no_port_flow ? MT_FLOW_HASH_NO_PORT : MT_FLOW_HASH_FULL;
+  node->key = mt_flow_hash_key(ip, port);
+  node->priv = priv;
+
+  if ((hash->nb_total >= hash->nb_buckets * MT_FLOW_HASH_LOAD_MAX) &&
+      (hash->nb_buckets < MT_FLOW_HASH_BUCKETS_MAX)) {
+    /* a longer chain still works if no memory */
+    if (flow_hash_grow(hash) < 0)
+      warn("%s, grow fail, keep %u buckets\n", __func__, hash->nb_buckets);
+  }
+
+  /* append to the tail, the first one wins if any duplicated key as the list walk */
+  bucket = mt_flow_hash_bucket(hash, node->type, node->key);
+  struct mt_flow_hash_node** pos = &hash->buckets[bucket];
+  while (*pos) pos = &(*pos)->next;
+  node->next = NULL;
+  *pos = node;
+  hash->nb_nodes[node->type]++;
+  hash->nb_total++;
+  return 0;
+}
+
+int mt_flow_hash_del(struct mt_flow_hash* hash, struct mt_flow_hash_node* node) {
+  struct mt_flow_hash_node** pos =
+      &hash->buckets[mt_flow_hash_bucket(hash, node->type, node->key)];
+
+  while (*pos) {
+    if (*pos == node) {
+      *pos = node->next;
+      node->next = NULL;
+      hash->nb_nodes[node->type]--;
+      hash->nb_total--;
+      return 0;
+    }
+    pos = &(*pos)->next;
+  }
+
+  err("%s, node %p not found\n", __func__, node);
+  return -EIO;
+}
+
+/* the seq for the unique mempool name of mtl_flow_hash_bench */
+static rte_atomic32_t mt_flow_hash_bench_cnt;
+
+int mtl_flow_hash_bench(mtl_handle mt, uint32_t nb_flows, uint32_t nb_pkts,
+                        double* ns_per_pkt) {
+  struct mtl_main_impl* impl = mt;
+  int soc_id = mt_socket_id(impl, MTL_PORT_P);
+  struct rte_mbuf* pkts[MT_FLOW_HASH_BENCH_MBUFS];
+  struct mt_flow_hash* hash = NULL;
+  struct mt_flow_hash_node* nodes = NULL;
+  struct rte_mempool* pool = NULL;
+  struct mt_udp_hdr* hdr;
+  uint32_t miss = 0;
+  int ret;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (!nb_flows || (nb_flows > MT_FLOW_HASH_BENCH_FLOWS_MAX) || !nb_pkts) {
+    err("%s, invalid nb_flows %u or nb_pkts %u\n", __func__, nb_flows, nb_pkts);
+    return -EINVAL;
+  }
+
+  hash = mt_rte_zmalloc_socket(sizeof(*hash), soc_id);
+  nodes = mt_rte_zmalloc_socket(sizeof(*nodes) * nb_flows, soc_id);
+  /* unique name as the benches may run on multi instances or threads */
+  char pool_name[32];
+  snprintf(pool_name, 32, "FHB_P%dB%d", MTL_PORT_P,
+           rte_atomic32_add_return(&mt_flow_hash_bench_cnt, 1));
+  pool = mt_mempool_create(impl, MTL_PORT_P, pool_name, MT_FLOW_HASH_BENCH_MBUFS, 0, 0,
+                           MT_MBUF_DEFAULT_DATA_SIZE);
+  if (!hash || !nodes || !pool) {
+    err("%s, alloc fail\n", __func__);
+    ret = -ENOMEM;
+    goto exit;
+  }
+  ret = rte_pktmbuf_alloc_bulk(pool, pkts, MT_FLOW_HASH_BENCH_MBUFS);
+  if (ret < 0) {
+    err("%s, mbuf alloc fail %d\n", __func__, ret);
+    goto exit;
+  }
+
+  ret = mt_flow_hash_init(hash, soc_id);
+  if (ret < 0) goto exit;
+  /* one multicast ip:port flow each, 239.168.x.y and port 10000 + idx % 1000 */
+  for (uint32_t i = 0; i < nb_flows; i++) {
+    struct mt_rxq_flow flow;
+
+    memset(&flow, 0, sizeof(flow));
+    flow.dip_addr[0] = 239;
+    flow.dip_addr[1] = 168;
+    flow.dip_addr[2] = (i >> 8) & 0xff;
+    flow.dip_addr[3] = i & 0xff;
+    flow.dst_port = 10000 + i % 1000;
+    mt_flow_hash_add(hash, &nodes[i], &flow, &nodes[i]);
+  }
+
+  /* the synthetic pkts spread over all the flows */
+  for (uint32_t i = 0; i < MT_FLOW_HASH_BENCH_MBUFS; i++) {
+    uint32_t flow_idx = (uint64_t)i * nb_flows / MT_FLOW_HASH_BENCH_MBUFS;
+    uint8_t* ip;
+
+    hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->eth.ether_type = htons(RTE_ETHER_TYPE_IPV4);
+    hdr->ipv4.next_proto_id = IPPROTO_UDP;
+    ip = (uint8_t*)&hdr->ipv4.dst_addr;
+    ip[0] = 239;
+    ip[1] = 168;
+    ip[2] = (flow_idx >> 8) & 0xff;
+    ip[3] = flow_idx & 0xff;
+    hdr->udp.dst_port = htons(10000 + flow_idx % 1000);
+    pkts[i]->data_len = sizeof(*hdr);
+    pkts[i]->pkt_len = sizeof(*hdr);
+  }
+
+  uint64_t start = mt_get_tsc(impl);
+  for (uint32_t i = 0; i < nb_pkts; i++) {
+    hdr = rte_pktmbuf_mtod(pkts[i % MT_FLOW_HASH_BENCH_MBUFS], struct mt_udp_hdr*);
+    if (!mt_flow_hash_lookup(hash, &hdr->ipv4, &hdr->udp)) miss++;
+  }
+  uint64_t end = mt_get_tsc(impl);
+  *ns_per_pkt = (double)(end - start) / nb_pkts;
+
+  rte_pktmbuf_free_bulk(pkts, MT_FLOW_HASH_BENCH_MBUFS);
+  info("%s, flows %u pkts %u, %fns per pkt, miss %u\n", __func__, nb_flows, nb_pkts,
+       *ns_per_pkt, miss);
+  ret = miss ? -EIO : 0;
+
+exit:
+  if (pool) mt_mempool_free(pool);
+  if (nodes) mt_rte_free(nodes);
+  if (hash) {
+    mt_flow_hash_uinit(hash);
+    mt_rte_free(hash);
+  }
+  return ret;
+}
+
 int mt_ring_dequeue_clean(struct rte_ring* ring) {
   int ret;
   struct rte_mbuf* pkt;
@@ -189,6 +589,44 @@ void mt_mbuf_sanity_check(struct rte_mbuf** mbufs, uint16_t nb, char* tag) {
   }
 }
 
+uint32_t mt_mbuf_gather_copy(void* dst, struct rte_mbuf* mbuf, uint32_t offset,
+                             uint32_t len) {
+  struct rte_mbuf* seg = mbuf;
+  uint32_t copied = 0, seg_len;
+
+  /* locate the segment of the offset */
+  while (seg && offset >= seg->data_len) {
+    offset -= seg->data_len;
+    seg = seg->next;
+  }
+
+  while (seg && copied < len) {
+    seg_len = RTE_MIN((uint32_t)seg->data_len - offset, len - copied);
+    rte_memcpy(RTE_PTR_ADD(dst, copied), rte_pktmbuf_mtod_offset(seg, void*, offset),
+               seg_len);
+    copied += seg_len;
+    offset = 0;
+    seg = seg->next;
+  }
+
+  return copied;
+}
+
+void mt_mbuf_refcnt_update_tails(struct rte_mbuf* mbuf, int16_t value) {
+  for (struct rte_mbuf* seg = mbuf->next; seg; seg = seg->next)
+    rte_mbuf_refcnt_update(seg, value);
+}
+
+void mt_mbuf_free_head_seg(struct rte_mbuf* mbuf) {
+  if (rte_mbuf_refcnt_update(mbuf, -1) == 0) {
+    /* the chain seg is freed by the other refs */
+    mbuf->next = NULL;
+    mbuf->nb_segs = 1;
+    rte_mbuf_refcnt_set(mbuf, 1);
+    rte_pktmbuf_free_seg(mbuf);
+  }
+}
+
 int mt_build_port_map(struct mtl_main_impl* impl, char** ports, enum mtl_port* maps,
                       int num_ports) {
   struct mtl_init_params* p = mt_get_user_params(impl);
@@ -224,8 +662,10 @@ int mt_build_port_map(struct mtl_main_impl* impl, char** ports, enum mtl_port* m
   return 0;
 }
 
-int mt_pacing_train_result_add(struct mtl_main_impl* impl, enum mtl_port port,
-                               uint64_t rl_bps, float pad_interval) {
+#define MT_PACING_CACHE_MAGIC "mtl_pacing_train_cache"
+
+static int pacing_train_result_insert(struct mtl_main_impl* impl, enum mtl_port port,
+                                      uint64_t rl_bps, float pad_interval) {
   struct mt_pacing_train_result* ptr = &mt_if(impl, port)->pt_results[0];
 
   for (int i = 0; i < MT_MAX_RL_ITEMS; i++) {
@@ -239,6 +679,188 @@ int mt_pacing_train_result_add(struct mtl_main_impl* impl, enum mtl_port port,
   return -ENOMEM;
 }
 
+/* check the header, the cache is invalid if the lib version changed */
+static bool pacing_cache_header_valid(FILE* fp) {
+  char line[256];
+  char magic[64];
+  int version;
+
+  if (!fgets(line, sizeof(line), fp)) return false;
+  if (sscanf(line, "%63s %d", magic, &version) != 2) return false;
+  if (strcmp(magic, MT_PACING_CACHE_MAGIC) || version != MTL_VERSION) return false;
+  return true;
+}
+
+/* call with the pacing_cache_mutex */
+static int pacing_cache_append(struct mtl_main_impl* impl, enum mtl_port port,
+                               const char* path, uint64_t rl_bps, float pad_interval) {
+  struct mt_interface* inf = mt_if(impl, port);
+  char tmp_path[MT_PACING_CACHE_PATH_LEN + 8];
+  bool valid = false;
+  FILE* fp;
+
+  fp = fopen(path, "r");
+  if (fp) {
+    valid = pacing_cache_header_valid(fp);
+    fclose(fp);
+  }
+
+  if (valid) {
+    fp = fopen(path, "a");
+  } else {
+    /* missing or stale, build a new one aside and replace it at once */
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    fp = fopen(tmp_path, "w");
+    if (fp) fprintf(fp, "%s %d\n", MT_PACING_CACHE_MAGIC, MTL_VERSION);
+  }
+  if (!fp) {
+    warn("%s(%d), open %s fail\n", __func__, port, path);
+    return -EIO;
+  }
+
+  fprintf(fp, "%s %s %u %" PRIu64 " %f\n", mt_get_user_params(impl)->port[port],
+          inf->dev_info.driver_name, inf->link_speed, rl_bps, pad_interval);
+  if (fclose(fp) != 0) {
+    warn("%s(%d), write %s fail\n", __func__, port, path);
+    if (!valid) remove(tmp_path);
+    return -EIO;
+  }
+  if (!valid && rename(tmp_path, path) < 0) {
+    warn("%s(%d), rename %s fail %s\n", __func__, port, tmp_path, strerror(errno));
+    remove(tmp_path);
+    return -EIO;
+  }
+
+  dbg("%s(%d), rl_bps %" PRIu64 " pad_interval %f\n", __func__, port, rl_bps,
+      pad_interval);
+  return 0;
+}
+
+/*
+ * Read the results of this port from the cache, call with the pacing_cache_mutex.
+ * Return the number of results, 0 if the cache is missing or stale.
+ */
+static int pacing_cache_read(struct mtl_main_impl* impl, enum mtl_port port,
+                             const char* path, uint64_t* rl_bps, float* pad_intervals,
+                             int max) {
+  struct mt_interface* inf = mt_if(impl, port);
+  const char* port_name = mt_get_user_params(impl)->port[port];
+  char line[256];
+  char name[MTL_PORT_MAX_LEN], driver[64];
+  unsigned int link_speed;
+  uint64_t bps;
+  float pad_interval;
+  int nb = 0, skipped = 0;
+
+  FILE* fp = fopen(path, "r");
+  if (!fp) {
+    info("%s(%d), no cache at %s\n", __func__, port, path);
+    return 0;
+  }
+
+  /* keep the stale file, the next append replace it */
+  if (!pacing_cache_header_valid(fp)) {
+    fclose(fp);
+    warn("%s(%d), invalid cache %s, ignore it\n", __func__, port, path);
+    return 0;
+  }
+
+  while ((nb < max) && fgets(line, sizeof(line), fp)) {
+    if (sscanf(line, "%63s %63s %u %" SCNu64 " %f", name, driver, &link_speed, &bps,
+               &pad_interval) != 5) {
+      skipped++;
+      continue;
+    }
+    /* results only valid for the same port, driver and link speed */
+    if (strcmp(name, port_name) || strcmp(driver, inf->dev_info.driver_name) ||
+        link_speed != inf->link_speed)
+      continue;
+    /* same as the min check in the training */
+    if (!bps || pad_interval < 32) {
+      skipped++;
+      continue;
+    }
+    rl_bps[nb] = bps;
+    pad_intervals[nb] = pad_interval;
+    nb++;
+  }
+  fclose(fp);
+
+  if (skipped) warn("%s(%d), %d invalid lines in %s\n", __func__, port, skipped, path);
+  return nb;
+}
+
+int mt_pacing_train_cache_load(struct mtl_main_impl* impl, enum mtl_port port) {
+  const char* path = impl->pacing_cache_path;
+  uint64_t rl_bps[MT_MAX_RL_ITEMS];
+  float pad_intervals[MT_MAX_RL_ITEMS];
+  float pad_interval;
+  int nb, loaded = 0;
+
+  if (!path[0]) return 0; /* cache disabled */
+
+  mt_pthread_mutex_lock(&impl->pacing_cache_mutex);
+  nb = pacing_cache_read(impl, port, path, rl_bps, pad_intervals, MT_MAX_RL_ITEMS);
+  mt_pthread_mutex_unlock(&impl->pacing_cache_mutex);
+
+  for (int i = 0; i < nb; i++) {
+    if (mt_pacing_train_result_search(impl, port, rl_bps[i], &pad_interval) >= 0)
+      continue; /* duplicated */
+    if (pacing_train_result_insert(impl, port, rl_bps[i], pad_intervals[i]) < 0) break;
+    loaded++;
+  }
+
+  info("%s(%d), %d results loaded from %s\n", __func__, port, loaded, path);
+  return loaded;
+}
+
+int mt_pacing_train_result_add(struct mtl_main_impl* impl, enum mtl_port port,
+                               uint64_t rl_bps, float pad_interval) {
+  int ret = pacing_train_result_insert(impl, port, rl_bps, pad_interval);
+  if (ret < 0) return ret;
+
+  if (impl->pacing_cache_path[0]) {
+    mt_pthread_mutex_lock(&impl->pacing_cache_mutex);
+    pacing_cache_append(impl, port, impl->pacing_cache_path, rl_bps, pad_interval);
+    mt_pthread_mutex_unlock(&impl->pacing_cache_mutex);
+  }
+  return 0;
+}
+
+int mtl_pacing_train_cache_append(mtl_handle mt, enum mtl_port port, const char* path,
+                                  uint64_t rl_bps, float pad_interval) {
+  struct mtl_main_impl* impl = mt;
+  int ret;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (port >= mt_num_ports(impl) || !path) return -EINVAL;
+
+  mt_pthread_mutex_lock(&impl->pacing_cache_mutex);
+  ret = pacing_cache_append(impl, port, path, rl_bps, pad_interval);
+  mt_pthread_mutex_unlock(&impl->pacing_cache_mutex);
+  return ret;
+}
+
+int mtl_pacing_train_cache_read(mtl_handle mt, enum mtl_port port, const char* path,
+                                uint64_t* rl_bps, float* pad_intervals, int max) {
+  struct mtl_main_impl* impl = mt;
+  int ret;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (port >= mt_num_ports(impl) || !path || max <= 0) return -EINVAL;
+
+  mt_pthread_mutex_lock(&impl->pacing_cache_mutex);
+  ret = pacing_cache_read(impl, port, path, rl_bps, pad_intervals, max);
+  mt_pthread_mutex_unlock(&impl->pacing_cache_mutex);
+  return ret;
+}
+
 int mt_pacing_train_result_search(struct mtl_main_impl* impl, enum mtl_port port,
                                   uint64_t rl_bps, float* pad_interval) {
   struct mt_pacing_train_result* ptr = &mt_if(impl, port)->pt_results[0];
@@ -254,6 +876,61 @@ int mt_pacing_train_result_search(struct mtl_main_impl* impl, enum mtl_port port
   return -EINVAL;
 }
 
+int mt_pacing_train_run(struct mtl_main_impl* impl, enum mtl_port port, uint64_t rl_bps,
+                        float* pad_interval, mt_pacing_train_fn train, void* priv) {
+  struct mt_interface* inf = mt_if(impl, port);
+  struct mt_pacing_train_req* req;
+  int ret;
+
+  mt_pthread_mutex_lock(&inf->pt_mutex);
+  ret = mt_pacing_train_result_search(impl, port, rl_bps, pad_interval);
+  if (ret >= 0) {
+    mt_pthread_mutex_unlock(&inf->pt_mutex);
+    return 0;
+  }
+
+  /* same rate already in training, wait the result */
+  MT_TAILQ_FOREACH(req, &inf->pt_reqs, next) {
+    if (req->rl_bps != rl_bps) continue;
+    req->waiters++;
+    info("%s(%d), wait in flight train for %" PRIu64 "\n", __func__, port, rl_bps);
+    while (!req->done) mt_pthread_cond_wait(&inf->pt_cond, &inf->pt_mutex);
+    ret = req->result;
+    *pad_interval = req->pad_interval;
+    req->waiters--;
+    if (!req->waiters) mt_rte_free(req); /* owner already removed it from list */
+    mt_pthread_mutex_unlock(&inf->pt_mutex);
+    return ret;
+  }
+
+  req = mt_rte_zmalloc_socket(sizeof(*req), inf->socket_id);
+  if (!req) {
+    mt_pthread_mutex_unlock(&inf->pt_mutex);
+    err("%s(%d), req malloc fail\n", __func__, port);
+    return -ENOMEM;
+  }
+  req->rl_bps = rl_bps;
+  MT_TAILQ_INSERT_TAIL(&inf->pt_reqs, req, next);
+  mt_pthread_mutex_unlock(&inf->pt_mutex);
+
+  /* the train run without lock, other ports and rates can train in parallel */
+  ret = train(priv, pad_interval);
+
+  mt_pthread_mutex_lock(&inf->pt_mutex);
+  if (ret >= 0) mt_pacing_train_result_add(impl, port, rl_bps, *pad_interval);
+  req->result = ret;
+  req->pad_interval = *pad_interval;
+  req->done = true;
+  MT_TAILQ_REMOVE(&inf->pt_reqs, req, next);
+  if (req->waiters)
+    mt_pthread_cond_broadcast(&inf->pt_cond);
+  else
+    mt_rte_free(req);
+  mt_pthread_mutex_unlock(&inf->pt_mutex);
+
+  return ret;
+}
+
 void st_video_rtp_dump(enum mtl_port port, int idx, char* tag,
                        struct st20_rfc4175_rtp_hdr* rtp) {
   uint16_t line1_number = ntohs(rtp->row_number);
@@ -343,8 +1020,16 @@ void mt_eth_macaddr_dump(enum mtl_port port, char* tag, struct rte_ether_addr* m
        addr[5]);
 }
 
+int mt_macaddr_get(struct mtl_main_impl* impl, enum mtl_port port,
+                   struct rte_ether_addr* mac_addr) {
+  struct mt_interface* inf = mt_if(impl, port);
+
+  if (inf->afpkt) return mt_afpkt_macaddr_get(inf, mac_addr);
+  return rte_eth_macaddr_get(inf->port_id, mac_addr);
+}
+
 struct rte_mbuf* mt_build_pad(struct mtl_main_impl* impl, struct rte_mempool* mempool,
-                              uint16_t port_id, uint16_t ether_type, uint16_t len) {
+                              enum mtl_port port, uint16_t ether_type, uint16_t len) {
   struct rte_ether_addr src_mac;
   struct rte_mbuf* pad;
   struct rte_ether_hdr* eth_hdr;
@@ -355,7 +1040,7 @@ struct rte_mbuf* mt_build_pad(struct mtl_main_impl* impl, struct rte_mempool* me
     return NULL;
   }
 
-  rte_eth_macaddr_get(port_id, &src_mac);
+  mt_macaddr_get(impl, port, &src_mac);
   rte_pktmbuf_append(pad, len);
   pad->data_len = len;
   pad->pkt_len = len;
@@ -5,6 +5,8 @@
 #ifndef _MT_LIB_UTIL_HEAD_H_
 #define _MT_LIB_UTIL_HEAD_H_
 
+#include <rte_hash_crc.h>
+
 #include "mt_main.h"
 
 static inline bool mt_rtp_len_valid(uint16_t len) {
@@ -51,17 +53,140 @@ bool mt_bitmap_test_and_set(uint8_t* bitmap, int idx);
 bool mt_bitmap_test(uint8_t* bitmap, int idx);
 bool mt_bitmap_test_and_unset(uint8_t* bitmap, int idx);
 
+/* 64 bits word bitmap */
+struct mt_bitmap_range {
+  uint32_t start; /* the first bit idx */
+  uint32_t nb;    /* number of bits */
+};
+
+static inline uint32_t mt_bitmap64_words(uint32_t nb_bits) {
+  return (nb_bits + 63) / 64;
+}
+
+static inline bool mt_bitmap64_test(uint64_t* bitmap, uint32_t idx) {
+  return (bitmap[idx / 64] & (UINT64_C(1) << (idx % 64))) ? true : false;
+}
+
+static inline bool mt_bitmap64_test_and_set(uint64_t* bitmap, uint32_t idx) {
+  uint64_t* word = &bitmap[idx / 64];
+  uint64_t mask = UINT64_C(1) << (idx % 64);
+
+  /* already set */
+  if (*word & mask) return true;
+
+  *word |= mask;
+  return false;
+}
+
+/* clear all the words, with avx2/avx512 path if cpu support */
+void mt_bitmap64_clear(uint64_t* bitmap, uint32_t nb_words);
+/* return the number of set bits, with avx2/avx512 path if cpu support */
+uint32_t mt_bitmap64_count(uint64_t* bitmap, uint32_t nb_words);
+/* same as above with a max simd level, the level is limited by the cpu also */
+void mt_bitmap64_clear_simd(uint64_t* bitmap, uint32_t nb_words,
+                            enum mtl_simd_level level);
+uint32_t mt_bitmap64_count_simd(uint64_t* bitmap, uint32_t nb_words,
+                                enum mtl_simd_level level);
+/*
+ * Fill the unset bit ranges within [0, nb_bits) to ranges, return the number of ranges.
+ * The search stop if max_ranges reached.
+ */
+int mt_bitmap64_missing_ranges(uint64_t* bitmap, uint32_t nb_bits,
+                               struct mt_bitmap_range* ranges, int max_ranges);
+
+int mt_flow_hash_init(struct mt_flow_hash* hash, int soc_id);
+void mt_flow_hash_uinit(struct mt_flow_hash* hash);
+int mt_flow_hash_add(struct mt_flow_hash* hash, struct mt_flow_hash_node* node,
+                     struct mt_rxq_flow* flow, void* priv);
+int mt_flow_hash_del(struct mt_flow_hash* hash, struct mt_flow_hash_node* node);
+
+static inline uint64_t mt_flow_hash_key(uint32_t ip, uint16_t port) {
+  return ((uint64_t)ip << 16) | port;
+}
+
+/* the type is part of the key, a zero ip or port of a full flow is not a wildcard */
+static inline uint32_t mt_flow_hash_bucket(struct mt_flow_hash* hash,
+                                           enum mt_flow_hash_type type, uint64_t key) {
+  return rte_hash_crc_8byte(key, type) & (hash->nb_buckets - 1);
+}
+
+static inline void* mt_flow_hash_find(struct mt_flow_hash* hash,
+                                      enum mt_flow_hash_type type, uint64_t key) {
+  struct mt_flow_hash_node* node = hash->buckets[mt_flow_hash_bucket(hash, type, key)];
+
+  while (node) {
+    if ((node->key == key) && (node->type == type)) return node->priv;
+    node = node->next;
+  }
+
+  return NULL;
+}
+
+/*
+ * Find the flow owner of one udp pkt, the most specific flow wins: ip:port, then port
+ * only, then ip only, then the match all one. The first added wins for the same key.
+ * The ip is the dst for multicast and the src for unicast, same as the rte flow rule.
+ */
+static inline void* mt_flow_hash_lookup(struct mt_flow_hash* hash,
+                                        struct rte_ipv4_hdr* ipv4,
+                                        struct rte_udp_hdr* udp) {
+  uint16_t port = ntohs(udp->dst_port);
+  uint32_t ip = mt_is_multicast_ip((uint8_t*)&ipv4->dst_addr) ? ipv4->dst_addr
+                                                               : ipv4->src_addr;
+  void* priv;
+
+  if (hash->nb_nodes[MT_FLOW_HASH_FULL]) {
+    priv = mt_flow_hash_find(hash, MT_FLOW_HASH_FULL, mt_flow_hash_key(ip, port));
+    if (priv) return priv;
+  }
+  if (hash->nb_nodes[MT_FLOW_HASH_NO_IP]) {
+    priv = mt_flow_hash_find(hash, MT_FLOW_HASH_NO_IP, mt_flow_hash_key(0, port));
+    if (priv) return priv;
+  }
+  if (hash->nb_nodes[MT_FLOW_HASH_NO_PORT]) {
+    priv = mt_flow_hash_find(hash, MT_FLOW_HASH_NO_PORT, mt_flow_hash_key(ip, 0));
+    if (priv) return priv;
+  }
+  if (hash->nb_nodes[MT_FLOW_HASH_ANY]) {
+    return mt_flow_hash_find(hash, MT_FLOW_HASH_ANY, mt_flow_hash_key(0, 0));
+  }
+
+  return NULL;
+}
+
 /* only for mbuf ring with RING_F_SP_ENQ | RING_F_SC_DEQ */
 int mt_ring_dequeue_clean(struct rte_ring* ring);
 
 void mt_mbuf_sanity_check(struct rte_mbuf** mbufs, uint16_t nb, char* tag);
 
+/* copy len bytes from the offset of a (chained) mbuf to dst, return the copied bytes */
+uint32_t mt_mbuf_gather_copy(void* dst, struct rte_mbuf* mbuf, uint32_t offset,
+                             uint32_t len);
+
+/* update the refcnt of all the segments after the head of a chained mbuf */
+void mt_mbuf_refcnt_update_tails(struct rte_mbuf* mbuf, int16_t value);
+
+/* drop one ref of the head segment only, the chain segs are freed by the other refs */
+void mt_mbuf_free_head_seg(struct rte_mbuf* mbuf);
+
 int mt_pacing_train_result_add(struct mtl_main_impl* impl, enum mtl_port port,
                                uint64_t rl_bps, float pad_interval);
 
 int mt_pacing_train_result_search(struct mtl_main_impl* impl, enum mtl_port port,
                                   uint64_t rl_bps, float* pad_interval);
 
+/* load the persisted results matching the port, return the number of loaded items */
+int mt_pacing_train_cache_load(struct mtl_main_impl* impl, enum mtl_port port);
+
+typedef int (*mt_pacing_train_fn)(void* priv, float* pad_interval);
+
+/*
+ * Get the pad interval for rl_bps, the train is only called if no result and no same
+ * rl_bps train in flight. Different ports or rates train concurrently.
+ */
+int mt_pacing_train_run(struct mtl_main_impl* impl, enum mtl_port port, uint64_t rl_bps,
+                        float* pad_interval, mt_pacing_train_fn train, void* priv);
+
 int mt_build_port_map(struct mtl_main_impl* impl, char** ports, enum mtl_port* maps,
                       int num_ports);
 
@@ -91,6 +216,10 @@ static inline bool st_is_valid_payload_type(int payload_type) {
 
 void mt_eth_macaddr_dump(enum mtl_port port, char* tag, struct rte_ether_addr* mac_addr);
 
+/* the port mac, from the ethdev or the kernel if for af_packet */
+int mt_macaddr_get(struct mtl_main_impl* impl, enum mtl_port port,
+                   struct rte_ether_addr* mac_addr);
+
 static inline bool st_rx_seq_drop(uint16_t new_id, uint16_t old_id, uint16_t delta) {
   if ((new_id <= old_id) && ((old_id - new_id) < delta))
     return true;
@@ -99,7 +228,7 @@ static inline bool st_rx_seq_drop(uint16_t new_id, uint16_t old_id, uint16_t del
 }
 
 struct rte_mbuf* mt_build_pad(struct mtl_main_impl* impl, struct rte_mempool* mempool,
-                              uint16_t port_id, uint16_t ether_type, uint16_t len);
+                              enum mtl_port port, uint16_t ether_type, uint16_t len);
 
 struct rte_mempool* mt_mempool_create_by_ops(struct mtl_main_impl* impl,
                                              enum mtl_port port, const char* name,
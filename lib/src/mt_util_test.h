@@ -0,0 +1,131 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+/* The test hooks of mt_util.c, not installed, for the gtest only */
+
+#ifndef _MT_LIB_UTIL_TEST_HEAD_H_
+#define _MT_LIB_UTIL_TEST_HEAD_H_
+
+#include "mtl_api.h"
+#include "st20_api.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * Benchmark the flow lookup of the shared rx queue and the shared rss dispatch.
+ * nb_flows multicast ip:port flows are added to a private flow hash, then the
+ * synthetic udp mbufs spread over the flows are looked up nb_pkts times.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param nb_flows
+ *   The number of the flows, max 65536.
+ * @param nb_pkts
+ *   The number of the pkts to look up.
+ * @param ns_per_pkt
+ *   A pointer to the average lookup time of one pkt in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail or any pkt not matched.
+ */
+int mtl_flow_hash_bench(mtl_handle mt, uint32_t nb_flows, uint32_t nb_pkts,
+                        double* ns_per_pkt);
+
+/**
+ * Append one pacing train result of the port to a pacing train cache file, the same
+ * path used by the lib if mtl_init_params.pacing_train_cache is set to it.
+ * A missing or stale file is rebuilt in a temp file and renamed over the old one.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param port
+ *   The port.
+ * @param path
+ *   The path of the cache file.
+ * @param rl_bps
+ *   The rate limit in byte per second.
+ * @param pad_interval
+ *   The pad interval of the rate.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int mtl_pacing_train_cache_append(mtl_handle mt, enum mtl_port port, const char* path,
+                                  uint64_t rl_bps, float pad_interval);
+
+/**
+ * Read the pacing train results of the port from a pacing train cache file.
+ *
+ * @param mt
+ *   The handle to MTL instance.
+ * @param port
+ *   The port.
+ * @param path
+ *   The path of the cache file.
+ * @param rl_bps
+ *   The array to store the rate limits.
+ * @param pad_intervals
+ *   The array to store the pad intervals.
+ * @param max
+ *   The size of the arrays.
+ * @return
+ *   - >=0: the number of the results, 0 if the file is missing or stale.
+ *   - <0: Error code if fail.
+ */
+int mtl_pacing_train_cache_read(mtl_handle mt, enum mtl_port port, const char* path,
+                                uint64_t* rl_bps, float* pad_intervals, int max);
+
+/**
+ * Clear the 64 bits word bitmap of the rx frame slots with a max simd level.
+ *
+ * @param bitmap
+ *   The bitmap.
+ * @param nb_words
+ *   The number of the 64 bits words.
+ * @param level
+ *   The max simd level, limited by the cpu also.
+ */
+void mtl_bitmap64_clear(uint64_t* bitmap, uint32_t nb_words, enum mtl_simd_level level);
+
+/**
+ * Count the set bits of the 64 bits word bitmap with a max simd level.
+ *
+ * @param bitmap
+ *   The bitmap.
+ * @param nb_words
+ *   The number of the 64 bits words.
+ * @param level
+ *   The max simd level, limited by the cpu also.
+ * @return
+ *   The number of the set bits.
+ */
+uint32_t mtl_bitmap64_count(uint64_t* bitmap, uint32_t nb_words,
+                            enum mtl_simd_level level);
+
+/**
+ * Get the unset bit ranges within [0, nb_bits) of the 64 bits word bitmap, the same
+ * ranges reported in st20_rx_frame_meta.missing_ranges.
+ *
+ * @param bitmap
+ *   The bitmap.
+ * @param nb_bits
+ *   The number of the bits to search.
+ * @param ranges
+ *   The array to store the ranges.
+ * @param max_ranges
+ *   The size of the ranges array, the search stop if reached.
+ * @return
+ *   - >=0: the number of the ranges.
+ *   - <0: Error code if fail.
+ */
+int mtl_bitmap64_missing_ranges(uint64_t* bitmap, uint32_t nb_bits,
+                                struct st20_rx_pkt_range* ranges, int max_ranges);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
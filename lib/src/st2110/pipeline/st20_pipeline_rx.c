@@ -180,7 +180,7 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
   if (ctx->convert_impl) st20_convert_notify_frame_ready(ctx->convert_impl);
 
   /* or ask app to consume with internal converter */
-  if (ctx->internal_converter) {
+  if (ctx->internal_converter || ctx->scaler) {
     if (ctx->ops.notify_frame_available) { /* notify app */
       ctx->ops.notify_frame_available(ctx->ops.priv);
     }
@@ -414,6 +414,8 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     frames[i].src.fmt = st_frame_fmt_from_transport(ctx->ops.transport_fmt);
     frames[i].src.interlaced = ops->interlaced;
+    frames[i].src.colorimetry = ops->colorimetry;
+    frames[i].src.range = ops->range;
     frames[i].src.buffer_size =
         st_frame_size(frames[i].src.fmt, ops->width, ops->height, ops->interlaced);
     frames[i].src.data_size = frames[i].src.buffer_size;
@@ -480,8 +482,10 @@ static int rx_st20p_init_dst_fbs(struct mtl_main_impl* impl, struct st20p_rx_ctx
     frames[i].idx = i;
     frames[i].dst.fmt = ops->output_fmt;
     frames[i].dst.interlaced = ops->interlaced;
-    frames[i].dst.width = ops->width;
-    frames[i].dst.height = ops->height;
+    frames[i].dst.colorimetry = ops->colorimetry;
+    frames[i].dst.range = ops->range;
+    frames[i].dst.width = ctx->output_width;
+    frames[i].dst.height = ctx->output_height;
     if (!ctx->derive) { /* when derive, no need to alloc dst frames */
       uint8_t planes = st_frame_fmt_planes(frames[i].dst.fmt);
       if (ops->ext_frames) {
@@ -553,7 +557,9 @@ static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ct
   req.put_frame = rx_st20p_convert_put_frame;
   req.dump = rx_st20p_convert_dump;
 
-  struct st20_convert_session_impl* convert_impl = st20_get_converter(impl, &req);
+  struct st20_convert_session_impl* convert_impl = NULL;
+  /* the plugins have no scale, the scaled frame always convert internal */
+  if (!ctx->scaler) convert_impl = st20_get_converter(impl, &req);
   if (req.device == ST_PLUGIN_DEVICE_TEST_INTERNAL || !convert_impl) {
     struct st_frame_converter* converter = NULL;
     converter = mt_rte_zmalloc_socket(sizeof(*converter), mt_socket_id(impl, MTL_PORT_P));
@@ -576,6 +582,78 @@ static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ct
   return 0;
 }
 
+static int rx_st20p_uinit_scaler(struct st20p_rx_ctx* ctx) {
+  if (ctx->scaler) {
+    st_frame_scaler_free(ctx->scaler);
+    ctx->scaler = NULL;
+  }
+  if (ctx->scale_frame.addr[0]) {
+    mt_rte_free(ctx->scale_frame.addr[0]);
+    ctx->scale_frame.addr[0] = NULL;
+  }
+
+  return 0;
+}
+
+static int rx_st20p_init_scaler(struct mtl_main_impl* impl, struct st20p_rx_ctx* ctx,
+                                struct st20p_rx_ops* ops) {
+  int idx = ctx->idx;
+  enum st_frame_fmt fmt = st_frame_fmt_from_transport(ops->transport_fmt);
+  struct st_frame* frame = &ctx->scale_frame;
+  size_t size;
+  void* buf;
+
+  ctx->scaler = st_frame_scaler_create(fmt, ops->width, ops->height, ctx->output_width,
+                                       ctx->output_height, MTL_SIMD_LEVEL_MAX);
+  if (!ctx->scaler) {
+    err("%s(%d), scaler create fail\n", __func__, idx);
+    return -EINVAL;
+  }
+
+  /* scale to the dst frame directly if no convert */
+  if (st_frame_fmt_equal_transport(ops->output_fmt, ops->transport_fmt)) return 0;
+
+  size = st_frame_size(fmt, ctx->output_width, ctx->output_height, false);
+  buf = mt_rte_zmalloc_socket(size, mt_socket_id(impl, MTL_PORT_P));
+  if (!buf) {
+    err("%s(%d), scale frame malloc fail\n", __func__, idx);
+    rx_st20p_uinit_scaler(ctx);
+    return -ENOMEM;
+  }
+  frame->fmt = fmt;
+  frame->width = ctx->output_width;
+  frame->height = ctx->output_height;
+  frame->colorimetry = ops->colorimetry;
+  frame->range = ops->range;
+  frame->buffer_size = size;
+  frame->data_size = size;
+  st_frame_init_plane_single_src(frame, buf, mtl_hp_virt2iova(impl, buf));
+
+  return 0;
+}
+
+/* scale and convert the src to the dst frame on the get frame */
+static int rx_st20p_convert_internal(struct st20p_rx_ctx* ctx,
+                                     struct st20p_rx_frame* framebuff) {
+  struct st_frame* src = &framebuff->src;
+  int ret = 0;
+
+  if (ctx->scaler) {
+    if (!ctx->internal_converter) {
+      ret = st_frame_scaler_run(ctx->scaler, src, &framebuff->dst);
+    } else {
+      ret = st_frame_scaler_run(ctx->scaler, src, &ctx->scale_frame);
+      src = &ctx->scale_frame;
+    }
+  }
+  if (ret >= 0 && ctx->internal_converter)
+    ret = st_frame_convert_slices(ctx->impl, ctx->internal_converter, src,
+                                  &framebuff->dst);
+
+  if (ret < 0) rte_atomic32_inc(&ctx->stat_convert_fail);
+  return ret;
+}
+
 struct st_frame* st20p_rx_get_ext_frame(st20p_rx_handle handle,
                                         struct st_ext_frame* ext_frame) {
   struct st20p_rx_ctx* ctx = handle;
@@ -593,7 +671,7 @@ struct st_frame* st20p_rx_get_ext_frame(st20p_rx_handle handle,
     return NULL;
   }
 
-  if (!ctx->internal_converter) {
+  if (!ctx->internal_converter && !ctx->scaler) {
     err("%s(%d), only used for internal converter\n", __func__, idx);
     return NULL;
   }
@@ -624,7 +702,7 @@ struct st_frame* st20p_rx_get_ext_frame(st20p_rx_handle handle,
     mt_pthread_mutex_unlock(&ctx->lock);
     return NULL;
   }
-  ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+  rx_st20p_convert_internal(ctx, framebuff);
 
   framebuff->stat = ST20P_RX_FRAME_IN_USER;
   /* point to next */
@@ -659,7 +737,7 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
 
   mt_pthread_mutex_lock(&ctx->lock);
 
-  if (ctx->internal_converter) { /* convert internal */
+  if (ctx->internal_converter || ctx->scaler) { /* convert internal */
     framebuff =
         rx_st20p_next_available(ctx, ctx->framebuff_consumer_idx, ST20P_RX_FRAME_READY);
     /* not any ready frame */
@@ -667,7 +745,7 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
       mt_pthread_mutex_unlock(&ctx->lock);
       return NULL;
     }
-    ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+    rx_st20p_convert_internal(ctx, framebuff);
   } else {
     framebuff = rx_st20p_next_available(ctx, ctx->framebuff_consumer_idx,
                                         ST20P_RX_FRAME_CONVERTED);
@@ -727,6 +805,8 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
   int ret;
   int idx = 0; /* todo */
   size_t dst_size;
+  uint32_t output_width, output_height;
+  bool scale;
 
   if (impl->type != MT_HANDLE_MAIN) {
     err("%s, invalid type %d\n", __func__, impl->type);
@@ -738,7 +818,22 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
     return NULL;
   }
 
-  dst_size = st_frame_size(ops->output_fmt, ops->width, ops->height, ops->interlaced);
+  if (ops->colorimetry >= ST20_COLORIMETRY_MAX || ops->range >= ST20_RANGE_MAX) {
+    err("%s, invalid colorimetry %d or range %d\n", __func__, ops->colorimetry,
+        ops->range);
+    return NULL;
+  }
+
+  output_width = ops->output_width ? ops->output_width : ops->width;
+  output_height = ops->output_height ? ops->output_height : ops->height;
+  scale = (output_width != ops->width) || (output_height != ops->height);
+  if (scale && (ops->interlaced || (ops->flags & ST20P_RX_FLAG_PKT_CONVERT))) {
+    err("%s, scale not support interlaced or packet convert\n", __func__);
+    return NULL;
+  }
+
+  dst_size =
+      st_frame_size(ops->output_fmt, output_width, output_height, ops->interlaced);
   if (!dst_size) {
     err("%s(%d), get dst size fail\n", __func__, idx);
     return NULL;
@@ -752,7 +847,10 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
 
   ctx->idx = idx;
   ctx->ready = false;
-  ctx->derive = st_frame_fmt_equal_transport(ops->output_fmt, ops->transport_fmt);
+  ctx->derive =
+      !scale && st_frame_fmt_equal_transport(ops->output_fmt, ops->transport_fmt);
+  ctx->output_width = output_width;
+  ctx->output_height = output_height;
   ctx->impl = impl;
   ctx->type = MT_ST20_HANDLE_PIPELINE_RX;
   ctx->dst_size = dst_size;
@@ -764,8 +862,18 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
   strncpy(ctx->ops_name, ops->name, ST_MAX_NAME_LEN - 1);
   ctx->ops = *ops;
 
+  if (scale) {
+    ret = rx_st20p_init_scaler(impl, ctx, ops);
+    if (ret < 0) {
+      err("%s(%d), init scaler fail %d\n", __func__, idx, ret);
+      st20p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* get one suitable convert device */
-  if (!ctx->derive && !(ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT)) {
+  if (!ctx->derive && !(ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT) &&
+      !st_frame_fmt_equal_transport(ops->output_fmt, ops->transport_fmt)) {
     ret = rx_st20p_get_converter(impl, ctx, ops);
     if (ret < 0) {
       err("%s(%d), get converter fail %d\n", __func__, idx, ret);
@@ -794,6 +902,9 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
   ctx->ready = true;
   info("%s(%d), transport fmt %s, output fmt %s\n", __func__, idx,
        st20_frame_fmt_name(ops->transport_fmt), st_frame_fmt_name(ops->output_fmt));
+  if (scale)
+    info("%s(%d), scale %ux%u to %ux%u\n", __func__, idx, ops->width, ops->height,
+         output_width, output_height);
 
   if (ctx->ops.notify_frame_available) { /* notify app */
     ctx->ops.notify_frame_available(ctx->ops.priv);
@@ -820,6 +931,7 @@ int st20p_rx_free(st20p_rx_handle handle) {
     mt_rte_free(ctx->internal_converter);
     ctx->internal_converter = NULL;
   }
+  rx_st20p_uinit_scaler(ctx);
 
   if (ctx->transport) {
     st20_rx_free(ctx->transport);
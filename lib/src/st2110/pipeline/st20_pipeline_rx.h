@@ -49,6 +49,12 @@ struct st20p_rx_ctx {
   bool ready;
   bool derive;
 
+  /* the output size, scale from the transport frame if not same as the session */
+  uint32_t output_width;
+  uint32_t output_height;
+  struct st_frame_scaler* scaler;
+  struct st_frame scale_frame; /* the scaled transport frame before converting */
+
   size_t dst_size;
 
   rte_atomic32_t stat_convert_fail;
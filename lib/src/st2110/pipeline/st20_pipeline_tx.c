@@ -4,10 +4,11 @@
 
 #include "st20_pipeline_tx.h"
 
+#include "../../mt_dma.h"
 #include "../../mt_log.h"
 
 static const char* st20p_tx_frame_stat_name[ST20P_TX_FRAME_STATUS_MAX] = {
-    "free", "ready", "in_converting", "converted", "in_user", "in_transmitting",
+    "free", "ready", "in_converting", "converted", "in_user", "in_transmitting", "in_dma",
 };
 
 static const char* tx_st20p_stat_name(enum st20p_tx_frame_status stat) {
@@ -22,6 +23,8 @@ static uint16_t tx_st20p_next_idx(struct st20p_tx_ctx* ctx, uint16_t idx) {
   return next_idx;
 }
 
+static void tx_st20p_dma_poll(struct st20p_tx_ctx* ctx, bool tasklet);
+
 static inline struct st_frame* tx_st20p_user_frame(struct st20p_tx_ctx* ctx,
                                                    struct st20p_tx_frame* framebuff) {
   return ctx->derive ? &framebuff->dst : &framebuff->src;
@@ -57,6 +60,8 @@ static int tx_st20p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
+  if (ctx->dma_dev) tx_st20p_dma_poll(ctx, true);
+
   mt_pthread_mutex_lock(&ctx->lock);
   framebuff =
       tx_st20p_next_available(ctx, ctx->framebuff_consumer_idx, ST20P_TX_FRAME_CONVERTED);
@@ -286,9 +291,12 @@ static int tx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_tx
       frames[i].dst.addr[0] = NULL;
     } else {
       frames[i].dst.addr[0] = st20_tx_get_framebuffer(transport, i);
+      frames[i].dst.iova[0] = mtl_hp_virt2iova(impl, frames[i].dst.addr[0]);
     }
     frames[i].dst.fmt = st_frame_fmt_from_transport(ctx->ops.transport_fmt);
     frames[i].dst.interlaced = ops->interlaced;
+    frames[i].dst.colorimetry = ops->colorimetry;
+    frames[i].dst.range = ops->range;
     frames[i].dst.buffer_size =
         st_frame_size(frames[i].dst.fmt, ops->width, ops->height, ops->interlaced);
     frames[i].dst.data_size = frames[i].dst.buffer_size;
@@ -352,6 +360,8 @@ static int tx_st20p_init_src_fbs(struct mtl_main_impl* impl, struct st20p_tx_ctx
     frames[i].idx = i;
     frames[i].src.fmt = ops->input_fmt;
     frames[i].src.interlaced = ops->interlaced;
+    frames[i].src.colorimetry = ops->colorimetry;
+    frames[i].src.range = ops->range;
     frames[i].src.width = ops->width;
     frames[i].src.height = ops->height;
     if (!ctx->derive) { /* when derive, no need to alloc src frames */
@@ -439,6 +449,133 @@ static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ct
   return 0;
 }
 
+static int tx_st20p_init_dma(struct mtl_main_impl* impl, struct st20p_tx_ctx* ctx) {
+  int idx = ctx->idx;
+  struct mt_dma_request_req req;
+
+  req.nb_desc = 128;
+  req.max_shared = 1; /* the copies are enqueued from the user thread */
+  req.sch_idx = 0;
+  req.socket_id = mt_socket_id(impl, MTL_PORT_P);
+  req.priv = ctx;
+  req.drop_mbuf_cb = NULL;
+  struct mtl_dma_lender_dev* dma_dev = mt_dma_request_dev(impl, &req);
+  if (!dma_dev) {
+    info("%s(%d), fail, can not request dma dev, copy by cpu\n", __func__, idx);
+    return -EIO;
+  }
+  ctx->dma_dev = dma_dev;
+  rte_spinlock_init(&ctx->dma_lock);
+  ctx->dma_seq = 0;
+  ctx->dma_done = 0;
+  ctx->dma_passed = 0;
+
+  info("%s(%d), succ, dma %d lender id %u\n", __func__, idx, mt_dma_dev_id(dma_dev),
+       mt_dma_lender_id(dma_dev));
+  return 0;
+}
+
+/* pass the frame to the converter or the transmitter */
+static void tx_st20p_frame_ready(struct st20p_tx_ctx* ctx,
+                                 struct st20p_tx_frame* framebuff) {
+  if (ctx->internal_converter) { /* convert internal */
+    st_frame_convert_slices(ctx->impl, ctx->internal_converter, &framebuff->src,
+                            &framebuff->dst);
+    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
+  } else if (ctx->derive) {
+    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
+  } else {
+    framebuff->stat = ST20P_TX_FRAME_READY;
+    st20_convert_notify_frame_ready(ctx->convert_impl);
+  }
+}
+
+/*
+ * pass the frames whose dma copies all completed, called from both the user thread and
+ * the next frame callback of the transport tasklet. Never wait for the lock, the holder
+ * passes the completed frames anyway. The internal convert is too heavy for the tasklet,
+ * it only wakes up the user to pass the frames.
+ */
+static void tx_st20p_dma_poll(struct st20p_tx_ctx* ctx, bool tasklet) {
+  struct st20p_tx_frame* framebuff;
+  uint16_t idx = ctx->framebuff_consumer_idx;
+  bool notify = false;
+
+  if (!rte_spinlock_trylock(&ctx->dma_lock)) return;
+  if (ctx->dma_done < ctx->dma_seq) {
+    ctx->dma_done +=
+        mt_dma_completed(ctx->dma_dev, ctx->framebuff_cnt * ST_MAX_PLANES, NULL, NULL);
+  }
+  /* the copies complete in order, no new frame since the last pass */
+  if (ctx->dma_done <= ctx->dma_passed) {
+    rte_spinlock_unlock(&ctx->dma_lock);
+    return;
+  }
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[idx];
+    if ((framebuff->stat == ST20P_TX_FRAME_IN_DMA) &&
+        (framebuff->dma_last_seq <= ctx->dma_done)) {
+      if (tasklet && ctx->internal_converter) {
+        notify = true;
+      } else {
+        dbg("%s(%d), frame %u copy done\n", __func__, ctx->idx, idx);
+        tx_st20p_frame_ready(ctx, framebuff);
+        ctx->dma_passed = RTE_MAX(ctx->dma_passed, framebuff->dma_last_seq);
+      }
+    }
+    idx = tx_st20p_next_idx(ctx, idx);
+  }
+  rte_spinlock_unlock(&ctx->dma_lock);
+
+  if (notify && ctx->ops.notify_frame_available) {
+    ctx->ops.notify_frame_available(ctx->ops.priv);
+  }
+}
+
+static int tx_st20p_dma_drain(struct st20p_tx_ctx* ctx) {
+  int max_retry = 10000; /* 100ms at least */
+
+  for (int retry = 0; retry < max_retry; retry++) {
+    tx_st20p_dma_poll(ctx, false);
+    if (ctx->dma_done >= ctx->dma_seq) return 0;
+    mt_sleep_us(10);
+  }
+
+  err("%s(%d), timeout, %" PRIu64 " copies not completed\n", __func__, ctx->idx,
+      ctx->dma_seq - ctx->dma_done);
+  return -ETIMEDOUT;
+}
+
+static int tx_st20p_free_dma(struct mtl_main_impl* impl, struct st20p_tx_ctx* ctx) {
+  if (ctx->dma_dev) {
+    tx_st20p_dma_drain(ctx);
+    mt_dma_free_dev(impl, ctx->dma_dev);
+    ctx->dma_dev = NULL;
+  }
+
+  return 0;
+}
+
+static int tx_st20p_copy_user_meta(struct st20p_tx_ctx* ctx,
+                                   struct st20p_tx_frame* framebuff,
+                                   struct st_frame* frame) {
+  framebuff->user_meta_data_size = 0;
+  if (frame->user_meta) {
+    if (frame->user_meta_size > framebuff->user_meta_buffer_size) {
+      err("%s(%d), frame %u user meta size %" PRId64 " too large\n", __func__, ctx->idx,
+          framebuff->idx, frame->user_meta_size);
+      return -EIO;
+    }
+
+    /* copy user meta to framebuff user_meta */
+    rte_memcpy(framebuff->user_meta, frame->user_meta, frame->user_meta_size);
+    framebuff->user_meta_data_size = frame->user_meta_size;
+  }
+
+  return 0;
+}
+
 struct st_frame* st20p_tx_get_frame(st20p_tx_handle handle) {
   struct st20p_tx_ctx* ctx = handle;
   int idx = ctx->idx;
@@ -451,12 +588,15 @@ struct st_frame* st20p_tx_get_frame(st20p_tx_handle handle) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
+  if (ctx->dma_dev) tx_st20p_dma_poll(ctx, false);
+
   mt_pthread_mutex_lock(&ctx->lock);
   framebuff =
       tx_st20p_next_available(ctx, ctx->framebuff_producer_idx, ST20P_TX_FRAME_FREE);
   /* not any free frame */
   if (!framebuff) {
     mt_pthread_mutex_unlock(&ctx->lock);
+    /* the copying frames reach the tx from the next frame callback, retry later */
     return NULL;
   }
 
@@ -493,31 +633,67 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame) {
     return -EIO;
   }
 
-  framebuff->user_meta_data_size = 0;
-  if (frame->user_meta) {
-    if (frame->user_meta_size > framebuff->user_meta_buffer_size) {
-      err("%s(%d), frame %u user meta size %" PRId64 " too large\n", __func__, idx,
-          producer_idx, frame->user_meta_size);
-      framebuff->stat = ST20P_TX_FRAME_FREE;
-      return -EIO;
-    }
+  if (tx_st20p_copy_user_meta(ctx, framebuff, frame) < 0) {
+    framebuff->stat = ST20P_TX_FRAME_FREE;
+    return -EIO;
+  }
 
-    /* copy user meta to framebuff user_meta */
-    rte_memcpy(framebuff->user_meta, frame->user_meta, frame->user_meta_size);
-    framebuff->user_meta_data_size = frame->user_meta_size;
+  tx_st20p_frame_ready(ctx, framebuff);
+
+  dbg("%s(%d), frame %u succ\n", __func__, idx, producer_idx);
+  return 0;
+}
+
+int st20p_tx_put_frame_copy(st20p_tx_handle handle, struct st_frame* frame,
+                            struct st_ext_frame* src) {
+  struct st20p_tx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st20p_tx_frame* framebuff = frame->priv;
+  uint16_t producer_idx = framebuff->idx;
+  int ret;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
   }
 
-  if (ctx->internal_converter) { /* convert internal */
-    ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
-    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
-  } else if (ctx->derive) {
-    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
-  } else {
-    framebuff->stat = ST20P_TX_FRAME_READY;
-    st20_convert_notify_frame_ready(ctx->convert_impl);
+  if (ctx->ops.flags & ST20P_TX_FLAG_EXT_FRAME) {
+    err("%s(%d), not support for EXT_FRAME\n", __func__, idx);
+    return -EIO;
   }
 
-  dbg("%s(%d), frame %u succ\n", __func__, idx, producer_idx);
+  if (ST20P_TX_FRAME_IN_USER != framebuff->stat) {
+    err("%s(%d), frame %u not in user %d\n", __func__, idx, producer_idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  if (tx_st20p_copy_user_meta(ctx, framebuff, frame) < 0) {
+    framebuff->stat = ST20P_TX_FRAME_FREE;
+    return -EIO;
+  }
+
+  /* reap the completions to free the dma desc */
+  if (ctx->dma_dev) tx_st20p_dma_poll(ctx, false);
+
+  frame->opaque = src->opaque;
+  if (ctx->dma_dev) rte_spinlock_lock(&ctx->dma_lock);
+  ret = st_frame_copy_from_ext(ctx->dma_dev, frame, src);
+  if (ret > 0) { /* pass to tx once all dma copies completed */
+    ctx->dma_seq += ret;
+    framebuff->dma_last_seq = ctx->dma_seq;
+    framebuff->stat = ST20P_TX_FRAME_IN_DMA;
+    mt_dma_submit(ctx->dma_dev);
+  }
+  if (ctx->dma_dev) rte_spinlock_unlock(&ctx->dma_lock);
+  if (ret < 0) {
+    err("%s(%d), frame %u copy fail %d\n", __func__, idx, producer_idx, ret);
+    framebuff->stat = ST20P_TX_FRAME_FREE;
+    return ret;
+  }
+  if (!ret) tx_st20p_frame_ready(ctx, framebuff);
+
+  dbg("%s(%d), frame %u succ, dma copies %d\n", __func__, idx, producer_idx, ret);
   return 0;
 }
 
@@ -577,7 +753,8 @@ int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
       return -EIO;
     }
     if (ctx->internal_converter) { /* convert internal */
-      ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+      st_frame_convert_slices(ctx->impl, ctx->internal_converter, &framebuff->src,
+                              &framebuff->dst);
       framebuff->stat = ST20P_TX_FRAME_CONVERTED;
       if (ctx->ops.notify_frame_done)
         ctx->ops.notify_frame_done(ctx->ops.priv, &framebuff->src);
@@ -608,6 +785,12 @@ st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
     return NULL;
   }
 
+  if (ops->colorimetry >= ST20_COLORIMETRY_MAX || ops->range >= ST20_RANGE_MAX) {
+    err("%s, invalid colorimetry %d or range %d\n", __func__, ops->colorimetry,
+        ops->range);
+    return NULL;
+  }
+
   src_size = st_frame_size(ops->input_fmt, ops->width, ops->height, ops->interlaced);
   if (!src_size) {
     err("%s(%d), get src size fail\n", __func__, idx);
@@ -660,6 +843,10 @@ st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
     return NULL;
   }
 
+  /* try to request dma dev for the frame copy */
+  if ((ops->flags & ST20P_TX_FLAG_DMA_OFFLOAD) && !(ops->flags & ST20P_TX_FLAG_EXT_FRAME))
+    tx_st20p_init_dma(impl, ctx);
+
   /* all ready now */
   ctx->ready = true;
   info("%s(%d), transport fmt %s, input fmt: %s\n", __func__, idx,
@@ -681,6 +868,14 @@ int st20p_tx_free(st20p_tx_handle handle) {
     return -EIO;
   }
 
+  /* stop the transport first as its next frame callback polls the dma */
+  if (ctx->transport) {
+    st20_tx_free(ctx->transport);
+    ctx->transport = NULL;
+  }
+
+  tx_st20p_free_dma(impl, ctx);
+
   if (ctx->convert_impl) {
     st20_put_converter(impl, ctx->convert_impl);
     ctx->convert_impl = NULL;
@@ -691,10 +886,6 @@ int st20p_tx_free(st20p_tx_handle handle) {
     ctx->internal_converter = NULL;
   }
 
-  if (ctx->transport) {
-    st20_tx_free(ctx->transport);
-    ctx->transport = NULL;
-  }
   tx_st20p_uinit_src_fbs(ctx);
 
   mt_pthread_mutex_destroy(&ctx->lock);
@@ -15,6 +15,7 @@ enum st20p_tx_frame_status {
   ST20P_TX_FRAME_CONVERTED,
   ST20P_TX_FRAME_IN_USER,         /* in user */
   ST20P_TX_FRAME_IN_TRANSMITTING, /* for transport */
+  ST20P_TX_FRAME_IN_DMA,          /* user frame copying by dma */
   ST20P_TX_FRAME_STATUS_MAX,
 };
 
@@ -27,6 +28,7 @@ struct st20p_tx_frame {
   void* user_meta; /* the meta data from user */
   size_t user_meta_buffer_size;
   size_t user_meta_data_size;
+  uint64_t dma_last_seq; /* the dma seq of the last copy to this frame */
 };
 
 struct st20p_tx_ctx {
@@ -54,6 +56,13 @@ struct st20p_tx_ctx {
 
   bool second_field;
 
+  /* dma dev for st20p_tx_put_frame_copy */
+  struct mtl_dma_lender_dev* dma_dev;
+  rte_spinlock_t dma_lock; /* the copies enqueue and the completions dequeue */
+  uint64_t dma_seq;        /* total dma copies enqueued */
+  uint64_t dma_done;       /* total dma copies completed */
+  uint64_t dma_passed;     /* the dma seq of the last frame passed */
+
   rte_atomic32_t stat_convert_fail;
   rte_atomic32_t stat_busy;
 };
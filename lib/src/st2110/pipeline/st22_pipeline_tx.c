@@ -4,10 +4,11 @@
 
 #include "st22_pipeline_tx.h"
 
+#include "../../mt_dma.h"
 #include "../../mt_log.h"
 
 static const char* st22p_tx_frame_stat_name[ST22P_TX_FRAME_STATUS_MAX] = {
-    "free", "in_user", "ready", "in_encoding", "encoded", "in_trans",
+    "free", "in_user", "ready", "in_encoding", "encoded", "in_trans", "in_dma",
 };
 
 static const char* tx_st22p_stat_name(enum st22p_tx_frame_status stat) {
@@ -22,6 +23,8 @@ static uint16_t tx_st22p_next_idx(struct st22p_tx_ctx* ctx, uint16_t idx) {
   return next_idx;
 }
 
+static void tx_st22p_dma_poll(struct st22p_tx_ctx* ctx);
+
 static struct st22p_tx_frame* tx_st22p_next_available(
     struct st22p_tx_ctx* ctx, uint16_t idx_start, enum st22p_tx_frame_status desired) {
   uint16_t idx = idx_start;
@@ -52,6 +55,9 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
+  /* pass the copied frames to the encoder without waiting for the user */
+  if (ctx->dma_dev) tx_st22p_dma_poll(ctx);
+
   mt_pthread_mutex_lock(&ctx->lock);
   framebuff =
       tx_st22p_next_available(ctx, ctx->framebuff_consumer_idx, ST22P_TX_FRAME_ENCODED);
@@ -388,6 +394,96 @@ static int tx_st22p_get_encoder(struct mtl_main_impl* impl, struct st22p_tx_ctx*
   return 0;
 }
 
+static int tx_st22p_init_dma(struct mtl_main_impl* impl, struct st22p_tx_ctx* ctx) {
+  int idx = ctx->idx;
+  struct mt_dma_request_req req;
+
+  req.nb_desc = 128;
+  req.max_shared = 1; /* the copies are enqueued from the user thread */
+  req.sch_idx = 0;
+  req.socket_id = mt_socket_id(impl, MTL_PORT_P);
+  req.priv = ctx;
+  req.drop_mbuf_cb = NULL;
+  struct mtl_dma_lender_dev* dma_dev = mt_dma_request_dev(impl, &req);
+  if (!dma_dev) {
+    info("%s(%d), fail, can not request dma dev, copy by cpu\n", __func__, idx);
+    return -EIO;
+  }
+  ctx->dma_dev = dma_dev;
+  rte_spinlock_init(&ctx->dma_lock);
+  ctx->dma_seq = 0;
+  ctx->dma_done = 0;
+
+  info("%s(%d), succ, dma %d lender id %u\n", __func__, idx, mt_dma_dev_id(dma_dev),
+       mt_dma_lender_id(dma_dev));
+  return 0;
+}
+
+/* pass the frame to the encoder */
+static void tx_st22p_frame_ready(struct st22p_tx_ctx* ctx,
+                                 struct st22p_tx_frame* framebuff) {
+  framebuff->stat = ST22P_TX_FRAME_READY;
+  st22_encode_notify_frame_ready(ctx->encode_impl);
+}
+
+/*
+ * pass the frames whose dma copies all completed, called from both the user thread and
+ * the next frame callback of the transport tasklet. Never wait for the lock, the holder
+ * passes the completed frames anyway.
+ */
+static void tx_st22p_dma_poll(struct st22p_tx_ctx* ctx) {
+  struct st22p_tx_frame* framebuff;
+  uint16_t idx = ctx->framebuff_encode_idx;
+  uint16_t nb_dq;
+
+  if (!rte_spinlock_trylock(&ctx->dma_lock)) return;
+  if (ctx->dma_done >= ctx->dma_seq) {
+    rte_spinlock_unlock(&ctx->dma_lock);
+    return;
+  }
+  nb_dq = mt_dma_completed(ctx->dma_dev, ctx->framebuff_cnt * ST_MAX_PLANES, NULL, NULL);
+  if (!nb_dq) {
+    rte_spinlock_unlock(&ctx->dma_lock);
+    return;
+  }
+  ctx->dma_done += nb_dq;
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[idx];
+    if ((framebuff->stat == ST22P_TX_FRAME_IN_DMA) &&
+        (framebuff->dma_last_seq <= ctx->dma_done)) {
+      dbg("%s(%d), frame %u copy done\n", __func__, ctx->idx, idx);
+      tx_st22p_frame_ready(ctx, framebuff);
+    }
+    idx = tx_st22p_next_idx(ctx, idx);
+  }
+  rte_spinlock_unlock(&ctx->dma_lock);
+}
+
+static int tx_st22p_dma_drain(struct st22p_tx_ctx* ctx) {
+  int max_retry = 10000; /* 100ms at least */
+
+  for (int retry = 0; retry < max_retry; retry++) {
+    tx_st22p_dma_poll(ctx);
+    if (ctx->dma_done >= ctx->dma_seq) return 0;
+    mt_sleep_us(10);
+  }
+
+  err("%s(%d), timeout, %" PRIu64 " copies not completed\n", __func__, ctx->idx,
+      ctx->dma_seq - ctx->dma_done);
+  return -ETIMEDOUT;
+}
+
+static int tx_st22p_free_dma(struct mtl_main_impl* impl, struct st22p_tx_ctx* ctx) {
+  if (ctx->dma_dev) {
+    tx_st22p_dma_drain(ctx);
+    mt_dma_free_dev(impl, ctx->dma_dev);
+    ctx->dma_dev = NULL;
+  }
+
+  return 0;
+}
+
 struct st_frame* st22p_tx_get_frame(st22p_tx_handle handle) {
   struct st22p_tx_ctx* ctx = handle;
   int idx = ctx->idx;
@@ -400,12 +496,15 @@ struct st_frame* st22p_tx_get_frame(st22p_tx_handle handle) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
+  if (ctx->dma_dev) tx_st22p_dma_poll(ctx);
+
   mt_pthread_mutex_lock(&ctx->lock);
   framebuff =
       tx_st22p_next_available(ctx, ctx->framebuff_producer_idx, ST22P_TX_FRAME_FREE);
   /* not any free frame */
   if (!framebuff) {
     mt_pthread_mutex_unlock(&ctx->lock);
+    /* the copying frames reach the encoder from the next frame callback, retry later */
     return NULL;
   }
 
@@ -435,13 +534,55 @@ int st22p_tx_put_frame(st22p_tx_handle handle, struct st_frame* frame) {
     return -EIO;
   }
 
-  framebuff->stat = ST22P_TX_FRAME_READY;
-  st22_encode_notify_frame_ready(ctx->encode_impl);
+  tx_st22p_frame_ready(ctx, framebuff);
   dbg("%s(%d), frame %u succ\n", __func__, idx, producer_idx);
 
   return 0;
 }
 
+int st22p_tx_put_frame_copy(st22p_tx_handle handle, struct st_frame* frame,
+                            struct st_ext_frame* src) {
+  struct st22p_tx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st22p_tx_frame* framebuff = frame->priv;
+  uint16_t producer_idx = framebuff->idx;
+  int ret;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ST22P_TX_FRAME_IN_USER != framebuff->stat) {
+    err("%s(%d), frame %u not in free %d\n", __func__, idx, producer_idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  /* reap the completions to free the dma desc */
+  if (ctx->dma_dev) tx_st22p_dma_poll(ctx);
+
+  frame->opaque = src->opaque;
+  if (ctx->dma_dev) rte_spinlock_lock(&ctx->dma_lock);
+  ret = st_frame_copy_from_ext(ctx->dma_dev, frame, src);
+  if (ret > 0) { /* pass to encoder once all dma copies completed */
+    ctx->dma_seq += ret;
+    framebuff->dma_last_seq = ctx->dma_seq;
+    framebuff->stat = ST22P_TX_FRAME_IN_DMA;
+    mt_dma_submit(ctx->dma_dev);
+  }
+  if (ctx->dma_dev) rte_spinlock_unlock(&ctx->dma_lock);
+  if (ret < 0) {
+    err("%s(%d), frame %u copy fail %d\n", __func__, idx, producer_idx, ret);
+    framebuff->stat = ST22P_TX_FRAME_FREE;
+    return ret;
+  }
+  if (!ret) tx_st22p_frame_ready(ctx, framebuff);
+
+  dbg("%s(%d), frame %u succ, dma copies %d\n", __func__, idx, producer_idx, ret);
+  return 0;
+}
+
 st22p_tx_handle st22p_tx_create(mtl_handle mt, struct st22p_tx_ops* ops) {
   struct mtl_main_impl* impl = mt;
   struct st22p_tx_ctx* ctx;
@@ -518,6 +659,9 @@ st22p_tx_handle st22p_tx_create(mtl_handle mt, struct st22p_tx_ops* ops) {
     return NULL;
   }
 
+  /* try to request dma dev for the frame copy */
+  if (ops->flags & ST22P_TX_FLAG_DMA_OFFLOAD) tx_st22p_init_dma(impl, ctx);
+
   /* all ready now */
   ctx->ready = true;
   info("%s(%d), codestream fmt %s, input fmt: %s\n", __func__, idx,
@@ -539,15 +683,19 @@ int st22p_tx_free(st22p_tx_handle handle) {
     return -EIO;
   }
 
+  /* stop the transport first as its next frame callback polls the dma */
+  if (ctx->transport) {
+    st22_tx_free(ctx->transport);
+    ctx->transport = NULL;
+  }
+
+  tx_st22p_free_dma(impl, ctx);
+
   if (ctx->encode_impl) {
     st22_put_encoder(impl, ctx->encode_impl);
     ctx->encode_impl = NULL;
   }
 
-  if (ctx->transport) {
-    st22_tx_free(ctx->transport);
-    ctx->transport = NULL;
-  }
   tx_st22p_uinit_src_fbs(ctx);
 
   mt_pthread_mutex_destroy(&ctx->lock);
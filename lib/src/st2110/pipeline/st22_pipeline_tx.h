@@ -15,6 +15,7 @@ enum st22p_tx_frame_status {
   ST22P_TX_FRAME_IN_ENCODING, /* for encoding */
   ST22P_TX_FRAME_ENCODED,
   ST22P_TX_FRAME_IN_TRANSMITTING, /* for transport */
+  ST22P_TX_FRAME_IN_DMA,          /* user frame copying by dma */
   ST22P_TX_FRAME_STATUS_MAX,
 };
 
@@ -24,6 +25,7 @@ struct st22p_tx_frame {
   struct st_frame dst; /* encoded */
   struct st22_encode_frame_meta encode_frame;
   uint16_t idx;
+  uint64_t dma_last_seq; /* the dma seq of the last copy to this frame */
 };
 
 struct st22p_tx_ctx {
@@ -48,6 +50,12 @@ struct st22p_tx_ctx {
 
   size_t src_size;
 
+  /* dma dev for st22p_tx_put_frame_copy */
+  struct mtl_dma_lender_dev* dma_dev;
+  rte_spinlock_t dma_lock; /* the copies enqueue and the completions dequeue */
+  uint64_t dma_seq;        /* total dma copies enqueued */
+  uint64_t dma_done;       /* total dma copies completed */
+
   rte_atomic32_t stat_encode_fail;
 };
 
@@ -147,6 +147,8 @@ int st_audio_transmitter_init(struct mtl_main_impl* impl, struct mt_sch_impl* sc
   ops.start = st_audio_trs_tasklet_start;
   ops.stop = st_audio_trs_tasklet_stop;
   ops.handler = st_audio_trs_tasklet_handler;
+  /* it only drain the mgr ring to the queue, it can run on any sch */
+  ops.flags = MT_TASKLET_BALANCE;
 
   trs->tasklet = mt_sch_register_tasklet(sch, &ops);
   if (!trs->tasklet) {
@@ -215,5 +215,620 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
   return 0;
 }
 /* end st20_rfc4175_422le10_to_422be10_avx2 */
+
+/* begin the 444 and 12bit helpers of the avx2 */
+/* each lane: 2 groups of the 10bit be stream(10 bytes) to 8 samples */
+static uint8_t be10_unpack_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, /* 4 samples from the 1st 5 bytes */
+    6, 5, 7, 6, 8, 7, 9, 8, /* 4 samples from the 2nd 5 bytes */
+};
+
+/* shift left to align the sample msb to the bit 15, then a right shift of 6 */
+static uint16_t be10_unpack_mullo_tbl_128[8] = {
+    1, 4, 16, 64, 1, 4, 16, 64,
+};
+
+/* each lane: the 40 bits in each 64 bits to 10 bytes of the be stream */
+static uint8_t be10_pack_shuffle_tbl_128[16] = {
+    4,    3,    2,    1,    0,    /* 1st 5 bytes */
+    12,   11,   10,   9,    8,    /* 2nd 5 bytes */
+    0x80, 0x80, 0x80, 0x80, 0x80, /* zeros */
+    0x80,                         /* zeros */
+};
+
+/* each lane: 4 groups of the 12bit be stream(12 bytes) to 8 samples */
+static uint8_t be12_unpack_shuffle_tbl_128[16] = {
+    1, 0, 2, 1,   /* 2 samples from bytes 0,1,2 */
+    4, 3, 5, 4,   /* 2 samples from bytes 3,4,5 */
+    7, 6, 8, 7,   /* 2 samples from bytes 6,7,8 */
+    10, 9, 11, 10, /* 2 samples from bytes 9,10,11 */
+};
+
+static uint16_t be12_unpack_mullo_tbl_128[8] = {
+    1, 16, 1, 16, 1, 16, 1, 16,
+};
+
+/* each lane: 4 groups of the 12bit le stream(12 bytes) to 8 samples */
+static uint8_t le12_unpack_shuffle_tbl_128[16] = {
+    0, 1, 1, 2,    /* 2 samples from bytes 0,1,2 */
+    3, 4, 4, 5,    /* 2 samples from bytes 3,4,5 */
+    6, 7, 7, 8,    /* 2 samples from bytes 6,7,8 */
+    9, 10, 10, 11, /* 2 samples from bytes 9,10,11 */
+};
+
+static uint16_t le12_unpack_mullo_tbl_128[8] = {
+    16, 1, 16, 1, 16, 1, 16, 1,
+};
+
+/* each lane: the 24 bits in each 32 bits to 12 bytes of the be stream */
+static uint8_t be12_pack_shuffle_tbl_128[16] = {
+    2,    1,    0,    /* dword 0 */
+    6,    5,    4,    /* dword 1 */
+    10,   9,    8,    /* dword 2 */
+    14,   13,   12,   /* dword 3 */
+    0x80, 0x80, 0x80, /* zeros */
+    0x80,             /* zeros */
+};
+
+struct cvt_b10_avx2 {
+  __m256i unpack_shuffle;
+  __m256i unpack_mullo;
+  __m256i mask;
+  __m256i pack_shuffle;
+};
+
+static inline void cvt_b10_avx2_init(struct cvt_b10_avx2* c) {
+  c->unpack_shuffle =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)be10_unpack_shuffle_tbl_128));
+  c->unpack_mullo =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)be10_unpack_mullo_tbl_128));
+  c->mask = _mm256_set1_epi16(0x3ff);
+  c->pack_shuffle =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)be10_pack_shuffle_tbl_128));
+}
+
+/* the lane 0 from lo and the lane 1 from hi, each read 16 bytes */
+static inline __m256i cvt_load_lanes_m256i(void* lo, void* hi) {
+  __m128i lo_input = _mm_loadu_si128((__m128i*)lo);
+  __m128i hi_input = _mm_loadu_si128((__m128i*)hi);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo_input), hi_input, 1);
+}
+
+/* 10 bytes of the be stream from each of lo and hi to 16 samples */
+static inline __m256i cvt_be10_unpack_m256i(struct cvt_b10_avx2* c, void* lo, void* hi) {
+  __m256i input = cvt_load_lanes_m256i(lo, hi);
+  __m256i shuffle_result = _mm256_shuffle_epi8(input, c->unpack_shuffle);
+  __m256i mullo_result = _mm256_mullo_epi16(shuffle_result, c->unpack_mullo);
+  return _mm256_srli_epi16(mullo_result, 6);
+}
+
+/* 16 samples to 10 bytes of the be stream in each of lo and hi */
+static inline void cvt_be10_pack_m256i(struct cvt_b10_avx2* c, __m256i samples,
+                                       void* lo, void* hi) {
+  __m256i s = _mm256_and_si256(samples, c->mask);
+  /* each 64 bits with 4 samples to s0 << 30 | s1 << 20 | s2 << 10 | s3 */
+  __m256i s0 = _mm256_slli_epi64(_mm256_and_si256(s, _mm256_set1_epi64x(0x3ff)), 30);
+  __m256i s1 =
+      _mm256_slli_epi64(_mm256_and_si256(s, _mm256_set1_epi64x(0x3ff0000)), 4);
+  __m256i s2 =
+      _mm256_srli_epi64(_mm256_and_si256(s, _mm256_set1_epi64x(0x3ff00000000)), 22);
+  __m256i s3 = _mm256_srli_epi64(s, 48);
+  __m256i v = _mm256_or_si256(_mm256_or_si256(s0, s1), _mm256_or_si256(s2, s3));
+  __m256i result = _mm256_shuffle_epi8(v, c->pack_shuffle);
+  __m128i lo_result = _mm256_castsi256_si128(result);
+  __m128i hi_result = _mm256_extracti128_si256(result, 1);
+
+  /* store the 10 bytes only */
+  _mm_storel_epi64((__m128i*)lo, lo_result);
+  *(uint16_t*)((uint8_t*)lo + 8) = _mm_extract_epi16(lo_result, 4);
+  _mm_storel_epi64((__m128i*)hi, hi_result);
+  *(uint16_t*)((uint8_t*)hi + 8) = _mm_extract_epi16(hi_result, 4);
+}
+
+struct cvt_b12_avx2 {
+  __m256i unpack_shuffle;
+  __m256i unpack_mullo;
+  __m256i mask;
+  __m256i pack_shuffle;
+};
+
+static inline void cvt_b12_avx2_init(struct cvt_b12_avx2* c, bool le) {
+  if (le) {
+    c->unpack_shuffle = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((__m128i*)le12_unpack_shuffle_tbl_128));
+    c->unpack_mullo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)le12_unpack_mullo_tbl_128));
+  } else {
+    c->unpack_shuffle = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((__m128i*)be12_unpack_shuffle_tbl_128));
+    c->unpack_mullo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)be12_unpack_mullo_tbl_128));
+  }
+  c->mask = _mm256_set1_epi16(0xfff);
+  c->pack_shuffle =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)be12_pack_shuffle_tbl_128));
+}
+
+/* 12 bytes of the be(or le) stream from each of lo and hi to 16 samples */
+static inline __m256i cvt_b12_unpack_m256i(struct cvt_b12_avx2* c, void* lo, void* hi) {
+  __m256i input = cvt_load_lanes_m256i(lo, hi);
+  __m256i shuffle_result = _mm256_shuffle_epi8(input, c->unpack_shuffle);
+  __m256i mullo_result = _mm256_mullo_epi16(shuffle_result, c->unpack_mullo);
+  return _mm256_srli_epi16(mullo_result, 4);
+}
+
+/* 16 samples to 12 bytes of the be stream in each of lo and hi */
+static inline void cvt_be12_pack_m256i(struct cvt_b12_avx2* c, __m256i samples,
+                                       void* lo, void* hi) {
+  __m256i s = _mm256_and_si256(samples, c->mask);
+  /* each 32 bits with 2 samples to s0 << 12 | s1 */
+  __m256i s0 = _mm256_slli_epi32(_mm256_and_si256(s, _mm256_set1_epi32(0xfff)), 12);
+  __m256i s1 = _mm256_srli_epi32(s, 16);
+  __m256i result = _mm256_shuffle_epi8(_mm256_or_si256(s0, s1), c->pack_shuffle);
+  __m128i lo_result = _mm256_castsi256_si128(result);
+  __m128i hi_result = _mm256_extracti128_si256(result, 1);
+
+  /* store the 12 bytes only */
+  _mm_storel_epi64((__m128i*)lo, lo_result);
+  *(uint32_t*)((uint8_t*)lo + 8) = _mm_extract_epi32(lo_result, 2);
+  _mm_storel_epi64((__m128i*)hi, hi_result);
+  *(uint32_t*)((uint8_t*)hi + 8) = _mm_extract_epi32(hi_result, 2);
+}
+
+/*
+ * 24 samples {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} of 8 pixels in the 3 regs, to
+ * the 8 pixels of each plane, in each lane.
+ */
+static uint8_t cvt_444_to_plane_shuffle_tbl_128[3][3][16] = {
+    {
+        /* b_r */
+        {0, 1, 6, 7, 12, 13, 0x80, 0x80,
+         0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2, 3,
+         8, 9, 14, 15, 0x80, 0x80, 0x80, 0x80},
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+         0x80, 0x80, 0x80, 0x80, 4, 5, 10, 11},
+    },
+    {
+        /* y_g */
+        {2, 3, 8, 9, 14, 15, 0x80, 0x80,
+         0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 4, 5,
+         10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+         0x80, 0x80, 0, 1, 6, 7, 12, 13},
+    },
+    {
+        /* r_b */
+        {4, 5, 10, 11, 0x80, 0x80, 0x80, 0x80,
+         0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x80, 0x80, 0x80, 0x80, 0, 1, 6, 7,
+         12, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+         0x80, 0x80, 2, 3, 8, 9, 14, 15},
+    },
+};
+
+/* the 8 pixels of each plane to 24 samples {B_R0, Y_G0, R_B0, ...}, in each lane */
+static uint8_t cvt_444_to_pg_shuffle_tbl_128[3][3][16] = {
+    {
+        /* samples 0 - 7 */
+        {0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3,
+         0x80, 0x80, 0x80, 0x80, 4, 5, 0x80, 0x80},
+        {0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80,
+         2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5},
+        {0x80, 0x80, 0x80, 0x80, 0, 1, 0x80, 0x80,
+         0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80},
+    },
+    {
+        /* samples 8 - 15 */
+        {0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80,
+         8, 9, 0x80, 0x80, 0x80, 0x80, 10, 11},
+        {0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80,
+         0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80},
+        {4, 5, 0x80, 0x80, 0x80, 0x80, 6, 7,
+         0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80},
+    },
+    {
+        /* samples 16 - 23 */
+        {0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80,
+         0x80, 0x80, 14, 15, 0x80, 0x80, 0x80, 0x80},
+        {10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13,
+         0x80, 0x80, 0x80, 0x80, 14, 15, 0x80, 0x80},
+        {0x80, 0x80, 10, 11, 0x80, 0x80, 0x80, 0x80,
+         12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15},
+    },
+};
+
+/* pick from the 3 regs with the shuffle tables of one output, all in lane */
+static inline __m256i cvt_444_pick_m256i(__m256i s0, __m256i s1, __m256i s2,
+                                         uint8_t tbl[3][16]) {
+  __m256i t0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)tbl[0]));
+  __m256i t1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)tbl[1]));
+  __m256i t2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)tbl[2]));
+  __m256i r0 = _mm256_shuffle_epi8(s0, t0);
+  __m256i r1 = _mm256_shuffle_epi8(s1, t1);
+  __m256i r2 = _mm256_shuffle_epi8(s2, t2);
+  return _mm256_or_si256(_mm256_or_si256(r0, r1), r2);
+}
+/* end the 444 and 12bit helpers of the avx2 */
+
+/* begin st20_rfc4175_444be10_to_444p10le_avx2 */
+int st20_rfc4175_444be10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  struct cvt_b10_avx2 c;
+  int pg_cnt = w * h / 4;
+
+  cvt_b10_avx2_init(&c);
+
+  /* each batch handle 4 pg groups(16 pixels), 2 in each lane */
+  int batch = pg_cnt / 4;
+  int left = pg_cnt % 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+  /* jump the last batch, for the Xmm may access invalid memory in the last bytes */
+  if (batch != 0 && left == 0) {
+    left = 4;
+    batch -= 1;
+  }
+
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+    __m256i s0 = cvt_be10_unpack_m256i(&c, be, be + 30);
+    __m256i s1 = cvt_be10_unpack_m256i(&c, be + 10, be + 40);
+    __m256i s2 = cvt_be10_unpack_m256i(&c, be + 20, be + 50);
+    be += 60;
+
+    __m256i b_r_result =
+        cvt_444_pick_m256i(s0, s1, s2, cvt_444_to_plane_shuffle_tbl_128[0]);
+    _mm256_storeu_si256((__m256i*)b_r, b_r_result);
+    b_r += 16;
+    __m256i y_g_result =
+        cvt_444_pick_m256i(s0, s1, s2, cvt_444_to_plane_shuffle_tbl_128[1]);
+    _mm256_storeu_si256((__m256i*)y_g, y_g_result);
+    y_g += 16;
+    __m256i r_b_result =
+        cvt_444_pick_m256i(s0, s1, s2, cvt_444_to_plane_shuffle_tbl_128[2]);
+    _mm256_storeu_si256((__m256i*)r_b, r_b_result);
+    r_b += 16;
+  }
+  pg += batch * 4;
+
+  while (left) {
+    st20_unpack_pg4be_444le10(pg, b_r, y_g, r_b);
+    pg++;
+    y_g += 4;
+    b_r += 4;
+    r_b += 4;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be10_to_444p10le_avx2 */
+
+/* begin st20_444p10le_to_rfc4175_444be10_avx2 */
+int st20_444p10le_to_rfc4175_444be10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint32_t w, uint32_t h) {
+  struct cvt_b10_avx2 c;
+  int pg_cnt = w * h / 4;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  cvt_b10_avx2_init(&c);
+
+  /* each batch handle 4 pg groups(16 pixels), 2 in each lane */
+  int batch = pg_cnt / 4;
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    __m256i b_r_input = _mm256_loadu_si256((__m256i*)b_r);
+    b_r += 16;
+    __m256i y_g_input = _mm256_loadu_si256((__m256i*)y_g);
+    y_g += 16;
+    __m256i r_b_input = _mm256_loadu_si256((__m256i*)r_b);
+    r_b += 16;
+
+    for (int j = 0; j < 3; j++) {
+      /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+      __m256i s = cvt_444_pick_m256i(b_r_input, y_g_input, r_b_input,
+                                     cvt_444_to_pg_shuffle_tbl_128[j]);
+      cvt_be10_pack_m256i(&c, s, be + 10 * j, be + 30 + 10 * j);
+    }
+    be += 60;
+  }
+  pg += batch * 4;
+
+  int left = pg_cnt % 4;
+  while (left) {
+    st20_pack_444le10_pg4be(b_r, y_g, r_b, pg);
+    pg++;
+    y_g += 4;
+    b_r += 4;
+    r_b += 4;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p10le_to_rfc4175_444be10_avx2 */
+
+/* begin st20_rfc4175_444be12_to_444p12le_avx2 */
+int st20_rfc4175_444be12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  struct cvt_b12_avx2 c;
+  int pg_cnt = w * h / 2;
+
+  cvt_b12_avx2_init(&c, false);
+
+  /* each batch handle 8 pg groups(16 pixels), 4 in each lane */
+  int batch = pg_cnt / 8;
+  int left = pg_cnt % 8;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+  /* jump the last batch, for the Xmm may access invalid memory in the last bytes */
+  if (batch != 0 && left == 0) {
+    left = 8;
+    batch -= 1;
+  }
+
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+    __m256i s0 = cvt_b12_unpack_m256i(&c, be, be + 36);
+    __m256i s1 = cvt_b12_unpack_m256i(&c, be + 12, be + 48);
+    __m256i s2 = cvt_b12_unpack_m256i(&c, be + 24, be + 60);
+    be += 72;
+
+    __m256i b_r_result =
+        cvt_444_pick_m256i(s0, s1, s2, cvt_444_to_plane_shuffle_tbl_128[0]);
+    _mm256_storeu_si256((__m256i*)b_r, b_r_result);
+    b_r += 16;
+    __m256i y_g_result =
+        cvt_444_pick_m256i(s0, s1, s2, cvt_444_to_plane_shuffle_tbl_128[1]);
+    _mm256_storeu_si256((__m256i*)y_g, y_g_result);
+    y_g += 16;
+    __m256i r_b_result =
+        cvt_444_pick_m256i(s0, s1, s2, cvt_444_to_plane_shuffle_tbl_128[2]);
+    _mm256_storeu_si256((__m256i*)r_b, r_b_result);
+    r_b += 16;
+  }
+  pg += batch * 8;
+
+  while (left) {
+    st20_unpack_pg2be_444le12(pg, b_r, y_g, r_b);
+    pg++;
+    y_g += 2;
+    b_r += 2;
+    r_b += 2;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be12_to_444p12le_avx2 */
+
+/* begin st20_444p12le_to_rfc4175_444be12_avx2 */
+int st20_444p12le_to_rfc4175_444be12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint32_t w, uint32_t h) {
+  struct cvt_b12_avx2 c;
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  cvt_b12_avx2_init(&c, false);
+
+  /* each batch handle 8 pg groups(16 pixels), 4 in each lane */
+  int batch = pg_cnt / 8;
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    __m256i b_r_input = _mm256_loadu_si256((__m256i*)b_r);
+    b_r += 16;
+    __m256i y_g_input = _mm256_loadu_si256((__m256i*)y_g);
+    y_g += 16;
+    __m256i r_b_input = _mm256_loadu_si256((__m256i*)r_b);
+    r_b += 16;
+
+    for (int j = 0; j < 3; j++) {
+      /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+      __m256i s = cvt_444_pick_m256i(b_r_input, y_g_input, r_b_input,
+                                     cvt_444_to_pg_shuffle_tbl_128[j]);
+      cvt_be12_pack_m256i(&c, s, be + 12 * j, be + 36 + 12 * j);
+    }
+    be += 72;
+  }
+  pg += batch * 8;
+
+  int left = pg_cnt % 8;
+  while (left) {
+    st20_pack_444le12_pg2be(b_r, y_g, r_b, pg);
+    pg++;
+    y_g += 2;
+    b_r += 2;
+    r_b += 2;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p12le_to_rfc4175_444be12_avx2 */
+
+/* begin st20_yuv422p12le_to_rfc4175_422be12_avx2 */
+/* {Cb0, Cr0, ...} and {Y0, Y1, ...} to {Cb0, Y0, Cr0, Y1, ...}, 2 pg in each lane */
+static uint8_t ple12_to_be_br_shuffle_tbl_256[32] = {
+    0,  1,  0x80, 0x80, 2,  3,  0x80, 0x80, /* lane 0, Cb0, Cr0 */
+    4,  5,  0x80, 0x80, 6,  7,  0x80, 0x80, /* lane 0, Cb1, Cr1 */
+    8,  9,  0x80, 0x80, 10, 11, 0x80, 0x80, /* lane 1, Cb2, Cr2 */
+    12, 13, 0x80, 0x80, 14, 15, 0x80, 0x80, /* lane 1, Cb3, Cr3 */
+};
+
+static uint8_t ple12_to_be_y_shuffle_tbl_256[32] = {
+    0x80, 0x80, 0,  1,  0x80, 0x80, 2,  3,  /* lane 0, Y0, Y1 */
+    0x80, 0x80, 4,  5,  0x80, 0x80, 6,  7,  /* lane 0, Y2, Y3 */
+    0x80, 0x80, 8,  9,  0x80, 0x80, 10, 11, /* lane 1, Y4, Y5 */
+    0x80, 0x80, 12, 13, 0x80, 0x80, 14, 15, /* lane 1, Y6, Y7 */
+};
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint32_t w, uint32_t h) {
+  struct cvt_b12_avx2 c;
+  __m256i br_shuffle = _mm256_loadu_si256((__m256i*)ple12_to_be_br_shuffle_tbl_256);
+  __m256i y_shuffle = _mm256_loadu_si256((__m256i*)ple12_to_be_y_shuffle_tbl_256);
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  cvt_b12_avx2_init(&c, false);
+
+  /* each batch handle 8 pg groups(16 pixels) */
+  int batch = pg_cnt / 8;
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    __m128i b_input = _mm_loadu_si128((__m128i*)b);
+    b += 8;
+    __m128i r_input = _mm_loadu_si128((__m128i*)r);
+    r += 8;
+    __m256i y_input = _mm256_loadu_si256((__m256i*)y);
+    y += 16;
+
+    /* {Cb0, Cr0, Cb1, Cr1, ...} */
+    __m128i br_lo = _mm_unpacklo_epi16(b_input, r_input);
+    __m128i br_hi = _mm_unpackhi_epi16(b_input, r_input);
+    __m256i br0 = _mm256_broadcastsi128_si256(br_lo);
+    __m256i br1 = _mm256_broadcastsi128_si256(br_hi);
+    __m256i y0 = _mm256_broadcastsi128_si256(_mm256_castsi256_si128(y_input));
+    __m256i y1 = _mm256_broadcastsi128_si256(_mm256_extracti128_si256(y_input, 1));
+
+    /* {Cb0, Y0, Cr0, Y1, ...} */
+    __m256i s0 = _mm256_or_si256(_mm256_shuffle_epi8(br0, br_shuffle),
+                                 _mm256_shuffle_epi8(y0, y_shuffle));
+    cvt_be12_pack_m256i(&c, s0, be, be + 12);
+    __m256i s1 = _mm256_or_si256(_mm256_shuffle_epi8(br1, br_shuffle),
+                                 _mm256_shuffle_epi8(y1, y_shuffle));
+    cvt_be12_pack_m256i(&c, s1, be + 24, be + 36);
+    be += 48;
+  }
+  pg += batch * 8;
+
+  int left = pg_cnt % 8;
+  while (left) {
+    st20_pack_422le12_pg2be(*b, *y, *r, *(y + 1), pg);
+    b++;
+    r++;
+    y += 2;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_yuv422p12le_to_rfc4175_422be12_avx2 */
+
+/* begin st20_rfc4175_422le12_to_422be12_avx2 */
+int st20_rfc4175_422le12_to_422be12_avx2(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         uint32_t w, uint32_t h) {
+  struct cvt_b12_avx2 c;
+  int pg_cnt = w * h / 2;
+
+  cvt_b12_avx2_init(&c, true);
+
+  /* each batch handle 4 pg groups(24 bytes), 2 in each lane */
+  int batch = pg_cnt / 4;
+  int left = pg_cnt % 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+  /* jump the last batch, for the Xmm may access invalid memory in the last bytes */
+  if (batch != 0 && left == 0) {
+    left = 4;
+    batch -= 1;
+  }
+
+  for (int i = 0; i < batch; i++) {
+    __m256i s = cvt_b12_unpack_m256i(&c, pg_le, pg_le + 2);
+    cvt_be12_pack_m256i(&c, s, pg_be, pg_be + 2);
+    pg_le += 4;
+    pg_be += 4;
+  }
+
+  while (left) {
+    uint16_t cb, y0, cr, y1;
+
+    cb = pg_le->Cb00 + (pg_le->Cb00_ << 8);
+    y0 = pg_le->Y00 + (pg_le->Y00_ << 4);
+    cr = pg_le->Cr00 + (pg_le->Cr00_ << 8);
+    y1 = pg_le->Y01 + (pg_le->Y01_ << 4);
+    st20_pack_422le12_pg2be(cb, y0, cr, y1, pg_be);
+
+    pg_be++;
+    pg_le++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422le12_to_422be12_avx2 */
+
+/* begin st_scale_vertical_avx2 */
+void st_scale_vertical_avx2(const uint16_t** lines, const int16_t* coef, uint32_t taps,
+                            uint16_t* dst, uint32_t w) {
+  __m256i round = _mm256_set1_epi32(1 << (ST_SCALE_V_SHIFT - 1));
+  __m256i zero = _mm256_setzero_si256();
+  __m256i pairs[ST_SCALE_MAX_TAPS / 2];
+  uint32_t x = 0;
+
+  /* two lines in one madd, the last odd line pairs with a zero coef */
+  for (uint32_t k = 0; k < taps; k += 2) {
+    uint16_t c1 = ((k + 1) < taps) ? coef[k + 1] : 0;
+    pairs[k / 2] = _mm256_set1_epi32(((uint32_t)c1 << 16) | (uint16_t)coef[k]);
+  }
+
+  for (; (x + 16) <= w; x += 16) {
+    __m256i lo = round;
+    __m256i hi = round;
+    for (uint32_t k = 0; k < taps; k += 2) {
+      __m256i a = _mm256_loadu_si256((__m256i*)(lines[k] + x));
+      __m256i b = ((k + 1) < taps) ? _mm256_loadu_si256((__m256i*)(lines[k + 1] + x))
+                                   : zero;
+      lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b),
+                                                  pairs[k / 2]));
+      hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b),
+                                                  pairs[k / 2]));
+    }
+    lo = _mm256_srai_epi32(lo, ST_SCALE_V_SHIFT);
+    hi = _mm256_srai_epi32(hi, ST_SCALE_V_SHIFT);
+    /* the unpack and pack are both in lane, the order keeps */
+    _mm256_storeu_si256((__m256i*)(dst + x), _mm256_packus_epi32(lo, hi));
+  }
+
+  st_scale_vertical_scalar(lines, coef, taps, dst, x, w);
+}
+/* end st_scale_vertical_avx2 */
+
+/* begin st_scale_horizontal_avx2 */
+void st_scale_horizontal_avx2(const uint16_t* src, uint16_t* dst, uint32_t w,
+                              const uint32_t* start, const int16_t* coef, uint32_t taps) {
+  __m256i round = _mm256_set1_epi32(1 << (ST_SCALE_H_SHIFT - 1));
+  __m256i two = _mm256_set1_epi32(2);
+  uint32_t i = 0;
+
+  for (; (i + 8) <= w; i += 8) {
+    __m256i idx = _mm256_loadu_si256((__m256i*)(start + i));
+    __m256i sum = round;
+    for (uint32_t k = 0; k < taps; k += 2) {
+      /* one dword gather get the two neighbour samples of the tap pair */
+      __m256i s = _mm256_i32gather_epi32((const int*)src, idx, 2);
+      __m256i c = _mm256_loadu_si256((__m256i*)(coef + (k * w) + (i * 2)));
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(s, c));
+      idx = _mm256_add_epi32(idx, two);
+    }
+    sum = _mm256_srai_epi32(sum, ST_SCALE_H_SHIFT);
+    _mm_storeu_si128((__m128i*)(dst + i),
+                     _mm_packus_epi32(_mm256_castsi256_si128(sum),
+                                      _mm256_extracti128_si256(sum, 1)));
+  }
+
+  st_scale_horizontal_scalar(src, dst, i, w, start, coef, taps);
+}
+/* end st_scale_horizontal_avx2 */
 MT_TARGET_CODE_STOP
 #endif
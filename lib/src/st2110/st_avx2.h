@@ -15,4 +15,36 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
                                          struct st20_rfc4175_422_10_pg2_be* pg_be,
                                          uint32_t w, uint32_t h);
 
+int st20_rfc4175_444be10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p10le_to_rfc4175_444be10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p12le_to_rfc4175_444be12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le12_to_422be12_avx2(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         uint32_t w, uint32_t h);
+
+/* the vertical filter of one output line, see st_scale_vertical_scalar */
+void st_scale_vertical_avx2(const uint16_t** lines, const int16_t* coef, uint32_t taps,
+                            uint16_t* dst, uint32_t w);
+
+/* the horizontal filter of one line, see st_scale_horizontal_scalar */
+void st_scale_horizontal_avx2(const uint16_t* src, uint16_t* dst, uint32_t w,
+                              const uint32_t* start, const int16_t* coef, uint32_t taps);
+
 #endif
\ No newline at end of file
@@ -2629,5 +2629,1698 @@ int st20_rfc4175_422be12_to_yuv422p12le_avx512_dma(
   return 0;
 }
 /* end st20_rfc4175_422be12_to_yuv422p12le_avx512 */
+
+/*
+ * pick one plane from 96 samples of 3 __m512i in {B_R, Y_G, R_B} order, the first
+ * permute pick the samples from s0 and s1, the second one pick the rest from s2.
+ */
+static uint16_t cvt_444_to_plane_idx_tbl_512[3][32] = {
+    {
+        0,  3,  6,  9,  12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45,
+        48, 51, 54, 57, 60, 63, 2,  5,  8,  11, 14, 17, 20, 23, 26, 29,
+    },
+    {
+        1,  4,  7,  10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+        49, 52, 55, 58, 61, 0,  3,  6,  9,  12, 15, 18, 21, 24, 27, 30,
+    },
+    {
+        2,  5,  8,  11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47,
+        50, 53, 56, 59, 62, 1,  4,  7,  10, 13, 16, 19, 22, 25, 28, 31,
+    },
+};
+
+static __mmask32 cvt_444_to_plane_k_tbl[3] = {0xffc00000, 0xffe00000, 0xffe00000};
+
+/*
+ * the reverse of above, build 3 __m512i of 96 samples in {B_R, Y_G, R_B} order from
+ * the 32 samples of each plane.
+ */
+static uint16_t cvt_444_to_pg_idx_tbl_512[3][32] = {
+    {
+        0,  32, 0,  1,  33, 1,  2,  34, 2,  3,  35, 3,  4,  36, 4,  5,
+        37, 5,  6,  38, 6,  7,  39, 7,  8,  40, 8,  9,  41, 9,  10, 42,
+    },
+    {
+        10, 11, 43, 11, 12, 44, 12, 13, 45, 13, 14, 46, 14, 15, 47, 15,
+        16, 48, 16, 17, 49, 17, 18, 50, 18, 19, 51, 19, 20, 52, 20, 21,
+    },
+    {
+        53, 21, 22, 54, 22, 23, 55, 23, 24, 56, 24, 25, 57, 25, 26, 58,
+        26, 27, 59, 27, 28, 60, 28, 29, 61, 29, 30, 62, 30, 31, 63, 31,
+    },
+};
+
+static __mmask32 cvt_444_to_pg_k_tbl[3] = {0x24924924, 0x49249249, 0x92492492};
+
+static inline __m512i cvt_444_pick_m512i(__m512i s0, __m512i s1, __m512i s2,
+                                         __m512i idx, __mmask32 k) {
+  __m512i s01 = _mm512_permutex2var_epi16(s0, idx, s1);
+  return _mm512_mask_permutexvar_epi16(s01, k, idx, s2);
+}
+
+/* 10bit be stream, 5 bytes with 4 samples, 10 bytes to each 128 bits lane */
+static uint16_t be10_spread_tbl_512[32] = {
+    0,  1,  2,  3,  4,  4,  4,  4,  5,  6,  7,  8,  9,  9,  9,  9,
+    10, 11, 12, 13, 14, 14, 14, 14, 15, 16, 17, 18, 19, 19, 19, 19,
+};
+
+static uint8_t be10_unpack_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, /* first 4 samples */
+    6, 5, 7, 6, 8, 7, 9, 8, /* second 4 samples */
+};
+
+static uint16_t be10_unpack_srlv_tbl_128[8] = {
+    6, 4, 2, 0, 6, 4, 2, 0,
+};
+
+static uint8_t be10_pack_shuffle_tbl_128[16] = {
+    4,    3,    2,    1,    0,    /* first 4 samples */
+    12,   11,   10,   9,    8,    /* second 4 samples */
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+static uint16_t be10_pack_compact_tbl_512[32] = {
+    0,  1,  2,  3,  4, 8, 9, 10, 11, 12, 16, 17, 18, 19, 20, 24,
+    25, 26, 27, 28, 0, 0, 0, 0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+/* 12bit stream, 3 bytes with 2 samples, 12 bytes to each 128 bits lane */
+static uint32_t b12_spread_tbl_512[16] = {
+    0, 1, 2, 0, 3, 4, 5, 0, 6, 7, 8, 0, 9, 10, 11, 0,
+};
+
+static uint8_t be12_unpack_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+};
+
+static uint16_t be12_unpack_srlv_tbl_128[8] = {
+    4, 0, 4, 0, 4, 0, 4, 0,
+};
+
+static uint8_t le12_unpack_shuffle_tbl_128[16] = {
+    0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+};
+
+static uint16_t le12_unpack_srlv_tbl_128[8] = {
+    0, 4, 0, 4, 0, 4, 0, 4,
+};
+
+static uint8_t be12_pack_shuffle_tbl_128[16] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0x80, 0x80, 0x80, 0x80,
+};
+
+static uint32_t b12_pack_compact_tbl_512[16] = {
+    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 0, 0, 0, 0,
+};
+
+struct cvt_b10_avx512 {
+  __m512i spread;
+  __m512i unpack_shuffle;
+  __m512i unpack_srlv;
+  __m512i mask;
+  __m512i pack_shuffle;
+  __m512i pack_compact;
+};
+
+static inline void cvt_b10_avx512_init(struct cvt_b10_avx512* c) {
+  c->spread = _mm512_loadu_si512((__m512i*)be10_spread_tbl_512);
+  c->unpack_shuffle =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)be10_unpack_shuffle_tbl_128));
+  c->unpack_srlv =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)be10_unpack_srlv_tbl_128));
+  c->mask = _mm512_set1_epi16(0x3ff);
+  c->pack_shuffle =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)be10_pack_shuffle_tbl_128));
+  c->pack_compact = _mm512_loadu_si512((__m512i*)be10_pack_compact_tbl_512);
+}
+
+/* 40 bytes of 10bit be stream to 32 samples */
+static inline __m512i cvt_be10_unpack_m512i(struct cvt_b10_avx512* c, void* be) {
+  __m512i input = _mm512_maskz_loadu_epi16(0xfffff, be);
+  __m512i spread_result = _mm512_permutexvar_epi16(c->spread, input);
+  __m512i shuffle_result = _mm512_shuffle_epi8(spread_result, c->unpack_shuffle);
+  __m512i srlv_result = _mm512_srlv_epi16(shuffle_result, c->unpack_srlv);
+  return _mm512_and_si512(srlv_result, c->mask);
+}
+
+/* 32 samples to 40 bytes of 10bit be stream */
+static inline void cvt_be10_pack_m512i(struct cvt_b10_avx512* c, __m512i samples,
+                                       void* be) {
+  __m512i s = _mm512_and_si512(samples, c->mask);
+  /* each 64 bits with 4 samples to s0 << 30 | s1 << 20 | s2 << 10 | s3 */
+  __m512i s0 = _mm512_slli_epi64(_mm512_and_si512(s, _mm512_set1_epi64(0x3ff)), 30);
+  __m512i s1 = _mm512_slli_epi64(_mm512_and_si512(s, _mm512_set1_epi64(0x3ff0000)), 4);
+  __m512i s2 =
+      _mm512_srli_epi64(_mm512_and_si512(s, _mm512_set1_epi64(0x3ff00000000)), 22);
+  __m512i s3 = _mm512_srli_epi64(s, 48);
+  __m512i v = _mm512_or_si512(_mm512_or_si512(s0, s1), _mm512_or_si512(s2, s3));
+  __m512i shuffle_result = _mm512_shuffle_epi8(v, c->pack_shuffle);
+  __m512i result = _mm512_permutexvar_epi16(c->pack_compact, shuffle_result);
+  _mm512_mask_storeu_epi16(be, 0xfffff, result);
+}
+
+struct cvt_b12_avx512 {
+  __m512i spread;
+  __m512i unpack_shuffle;
+  __m512i unpack_srlv;
+  __m512i mask;
+  __m512i pack_shuffle;
+  __m512i pack_compact;
+};
+
+static inline void cvt_b12_avx512_init(struct cvt_b12_avx512* c, bool le) {
+  c->spread = _mm512_loadu_si512((__m512i*)b12_spread_tbl_512);
+  if (le) {
+    c->unpack_shuffle =
+        _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)le12_unpack_shuffle_tbl_128));
+    c->unpack_srlv =
+        _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)le12_unpack_srlv_tbl_128));
+  } else {
+    c->unpack_shuffle =
+        _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)be12_unpack_shuffle_tbl_128));
+    c->unpack_srlv =
+        _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)be12_unpack_srlv_tbl_128));
+  }
+  c->mask = _mm512_set1_epi16(0xfff);
+  c->pack_shuffle =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)be12_pack_shuffle_tbl_128));
+  c->pack_compact = _mm512_loadu_si512((__m512i*)b12_pack_compact_tbl_512);
+}
+
+/* 48 bytes of 12bit be(or le) stream to 32 samples */
+static inline __m512i cvt_b12_unpack_m512i(struct cvt_b12_avx512* c, void* pg) {
+  __m512i input = _mm512_maskz_loadu_epi32(0xfff, pg);
+  __m512i spread_result = _mm512_permutexvar_epi32(c->spread, input);
+  __m512i shuffle_result = _mm512_shuffle_epi8(spread_result, c->unpack_shuffle);
+  __m512i srlv_result = _mm512_srlv_epi16(shuffle_result, c->unpack_srlv);
+  return _mm512_and_si512(srlv_result, c->mask);
+}
+
+/* 32 samples to 48 bytes of 12bit be stream */
+static inline void cvt_be12_pack_m512i(struct cvt_b12_avx512* c, __m512i samples,
+                                       void* be) {
+  __m512i s = _mm512_and_si512(samples, c->mask);
+  /* each 32 bits with 2 samples to s0 << 12 | s1 */
+  __m512i s0 = _mm512_slli_epi32(_mm512_and_si512(s, _mm512_set1_epi32(0xfff)), 12);
+  __m512i s1 = _mm512_srli_epi32(s, 16);
+  __m512i shuffle_result = _mm512_shuffle_epi8(_mm512_or_si512(s0, s1), c->pack_shuffle);
+  __m512i result = _mm512_permutexvar_epi32(c->pack_compact, shuffle_result);
+  _mm512_mask_storeu_epi32(be, 0xfff, result);
+}
+
+/* begin st20_rfc4175_444be10_to_444p10le_avx512 */
+/* each batch handle 8 pg groups(32 pixels) */
+static void rfc4175_444be10_to_444p10le_avx512_batch(
+    struct st20_rfc4175_444_10_pg4_be* pg, uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+    int batch) {
+  struct cvt_b10_avx512 c;
+  __m512i idx[3];
+  uint8_t* be = (uint8_t*)pg;
+
+  cvt_b10_avx512_init(&c);
+  for (int i = 0; i < 3; i++)
+    idx[i] = _mm512_loadu_si512((__m512i*)cvt_444_to_plane_idx_tbl_512[i]);
+
+  for (int i = 0; i < batch; i++) {
+    /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+    __m512i s0 = cvt_be10_unpack_m512i(&c, be);
+    __m512i s1 = cvt_be10_unpack_m512i(&c, be + 40);
+    __m512i s2 = cvt_be10_unpack_m512i(&c, be + 80);
+    be += 120;
+
+    __m512i b_r_result =
+        cvt_444_pick_m512i(s0, s1, s2, idx[0], cvt_444_to_plane_k_tbl[0]);
+    _mm512_storeu_si512((__m512i*)b_r, b_r_result);
+    b_r += 32;
+    __m512i y_g_result =
+        cvt_444_pick_m512i(s0, s1, s2, idx[1], cvt_444_to_plane_k_tbl[1]);
+    _mm512_storeu_si512((__m512i*)y_g, y_g_result);
+    y_g += 32;
+    __m512i r_b_result =
+        cvt_444_pick_m512i(s0, s1, s2, idx[2], cvt_444_to_plane_k_tbl[2]);
+    _mm512_storeu_si512((__m512i*)r_b, r_b_result);
+    r_b += 32;
+  }
+}
+
+int st20_rfc4175_444be10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  int batch = pg_cnt / 8;
+  rfc4175_444be10_to_444p10le_avx512_batch(pg, y_g, b_r, r_b, batch);
+  pg += batch * 8;
+  y_g += batch * 32;
+  b_r += batch * 32;
+  r_b += batch * 32;
+
+  int left = pg_cnt % 8;
+  while (left) {
+    st20_unpack_pg4be_444le10(pg, b_r, y_g, r_b);
+    pg++;
+    y_g += 4;
+    b_r += 4;
+    r_b += 4;
+    left--;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_444be10_to_444p10le_avx512_dma(struct mtl_dma_lender_dev* dma,
+                                                struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                                mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                                uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                                uint32_t h) {
+  int pg_cnt = w * h / 4;
+
+  int caches_num = 4;
+  int cache_pg_cnt = (256 * 1024) / sizeof(*pg_be); /* pg cnt for each cache */
+  int align = caches_num * 8; /* align to simd pg groups and caches_num */
+  cache_pg_cnt = cache_pg_cnt / align * align;
+  size_t cache_size = cache_pg_cnt * sizeof(*pg_be);
+  int soc_id = dma->parent->soc_id;
+
+  struct st20_rfc4175_444_10_pg4_be* be_caches =
+      mt_rte_zmalloc_socket(cache_size * caches_num, soc_id);
+  struct mt_cvt_dma_ctx* ctx = mt_cvt_dma_ctx_init(2 * caches_num, soc_id, 2);
+  if (!be_caches || !ctx) {
+    err("%s, alloc cache(%d,%" PRIu64 ") fail, %p\n", __func__, cache_pg_cnt, cache_size,
+        be_caches);
+    if (be_caches) mt_rte_free(be_caches);
+    if (ctx) mt_cvt_dma_ctx_uinit(ctx);
+    return st20_rfc4175_444be10_to_444p10le_avx512(pg_be, y_g, b_r, r_b, w, h);
+  }
+  rte_iova_t be_caches_iova = rte_malloc_virt2iova(be_caches);
+
+  /* first with caches batch step */
+  int cache_batch = pg_cnt / cache_pg_cnt;
+  dbg("%s, pg_cnt %d cache_pg_cnt %d caches_num %d cache_batch %d\n", __func__, pg_cnt,
+      cache_pg_cnt, caches_num, cache_batch);
+  for (int i = 0; i < cache_batch; i++) {
+    struct st20_rfc4175_444_10_pg4_be* be_cache =
+        be_caches + (i % caches_num) * cache_pg_cnt;
+    dbg("%s, cache batch idx %d\n", __func__, i);
+
+    int max_tran = i + caches_num;
+    max_tran = RTE_MIN(max_tran, cache_batch);
+    int cur_tran = mt_cvt_dma_ctx_get_tran(ctx, 0);
+    /* push max be dma */
+    while (cur_tran < max_tran) {
+      rte_iova_t be_cache_iova = be_caches_iova + (cur_tran % caches_num) * cache_size;
+      mt_dma_copy_busy(dma, be_cache_iova, pg_be_iova, cache_size);
+      pg_be += cache_pg_cnt;
+      pg_be_iova += cache_size;
+      mt_cvt_dma_ctx_push(ctx, 0);
+      cur_tran = mt_cvt_dma_ctx_get_tran(ctx, 0);
+    }
+    mt_dma_submit_busy(dma);
+
+    /* wait until current be dma copy done */
+    while (mt_cvt_dma_ctx_get_done(ctx, 0) < (i + 1)) {
+      uint16_t nb_dq = mt_dma_completed(dma, 1, NULL, NULL);
+      if (nb_dq) mt_cvt_dma_ctx_pop(ctx);
+    }
+
+    int batch = cache_pg_cnt / 8;
+    rfc4175_444be10_to_444p10le_avx512_batch(be_cache, y_g, b_r, r_b, batch);
+    y_g += batch * 32;
+    b_r += batch * 32;
+    r_b += batch * 32;
+  }
+
+  pg_cnt = pg_cnt % cache_pg_cnt;
+  mt_cvt_dma_ctx_uinit(ctx);
+  mt_rte_free(be_caches);
+
+  /* remaining simd and scalar batch */
+  return st20_rfc4175_444be10_to_444p10le_avx512(pg_be, y_g, b_r, r_b, pg_cnt * 4, 1);
+}
+/* end st20_rfc4175_444be10_to_444p10le_avx512 */
+
+/* begin st20_444p10le_to_rfc4175_444be10_avx512 */
+int st20_444p10le_to_rfc4175_444be10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint32_t w, uint32_t h) {
+  struct cvt_b10_avx512 c;
+  __m512i idx[3];
+  int pg_cnt = w * h / 4;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  cvt_b10_avx512_init(&c);
+  for (int i = 0; i < 3; i++)
+    idx[i] = _mm512_loadu_si512((__m512i*)cvt_444_to_pg_idx_tbl_512[i]);
+
+  /* each batch handle 8 pg groups(32 pixels) */
+  int batch = pg_cnt / 8;
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    __m512i b_r_input = _mm512_loadu_si512((__m512i*)b_r);
+    b_r += 32;
+    __m512i y_g_input = _mm512_loadu_si512((__m512i*)y_g);
+    y_g += 32;
+    __m512i r_b_input = _mm512_loadu_si512((__m512i*)r_b);
+    r_b += 32;
+
+    for (int j = 0; j < 3; j++) {
+      /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+      __m512i s = cvt_444_pick_m512i(b_r_input, y_g_input, r_b_input, idx[j],
+                                     cvt_444_to_pg_k_tbl[j]);
+      cvt_be10_pack_m512i(&c, s, be);
+      be += 40;
+    }
+  }
+  pg += batch * 8;
+
+  int left = pg_cnt % 8;
+  while (left) {
+    st20_pack_444le10_pg4be(b_r, y_g, r_b, pg);
+    pg++;
+    y_g += 4;
+    b_r += 4;
+    r_b += 4;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p10le_to_rfc4175_444be10_avx512 */
+
+/* begin st20_rfc4175_444be12_to_444p12le_avx512 */
+/* each batch handle 16 pg groups(32 pixels) */
+static void rfc4175_444be12_to_444p12le_avx512_batch(
+    struct st20_rfc4175_444_12_pg2_be* pg, uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+    int batch) {
+  struct cvt_b12_avx512 c;
+  __m512i idx[3];
+  uint8_t* be = (uint8_t*)pg;
+
+  cvt_b12_avx512_init(&c, false);
+  for (int i = 0; i < 3; i++)
+    idx[i] = _mm512_loadu_si512((__m512i*)cvt_444_to_plane_idx_tbl_512[i]);
+
+  for (int i = 0; i < batch; i++) {
+    /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+    __m512i s0 = cvt_b12_unpack_m512i(&c, be);
+    __m512i s1 = cvt_b12_unpack_m512i(&c, be + 48);
+    __m512i s2 = cvt_b12_unpack_m512i(&c, be + 96);
+    be += 144;
+
+    __m512i b_r_result =
+        cvt_444_pick_m512i(s0, s1, s2, idx[0], cvt_444_to_plane_k_tbl[0]);
+    _mm512_storeu_si512((__m512i*)b_r, b_r_result);
+    b_r += 32;
+    __m512i y_g_result =
+        cvt_444_pick_m512i(s0, s1, s2, idx[1], cvt_444_to_plane_k_tbl[1]);
+    _mm512_storeu_si512((__m512i*)y_g, y_g_result);
+    y_g += 32;
+    __m512i r_b_result =
+        cvt_444_pick_m512i(s0, s1, s2, idx[2], cvt_444_to_plane_k_tbl[2]);
+    _mm512_storeu_si512((__m512i*)r_b, r_b_result);
+    r_b += 32;
+  }
+}
+
+int st20_rfc4175_444be12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  int batch = pg_cnt / 16;
+  rfc4175_444be12_to_444p12le_avx512_batch(pg, y_g, b_r, r_b, batch);
+  pg += batch * 16;
+  y_g += batch * 32;
+  b_r += batch * 32;
+  r_b += batch * 32;
+
+  int left = pg_cnt % 16;
+  while (left) {
+    st20_unpack_pg2be_444le12(pg, b_r, y_g, r_b);
+    pg++;
+    y_g += 2;
+    b_r += 2;
+    r_b += 2;
+    left--;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_444be12_to_444p12le_avx512_dma(struct mtl_dma_lender_dev* dma,
+                                                struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                                mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                                uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                                uint32_t h) {
+  int pg_cnt = w * h / 2;
+
+  int caches_num = 4;
+  int cache_pg_cnt = (256 * 1024) / sizeof(*pg_be); /* pg cnt for each cache */
+  int align = caches_num * 16; /* align to simd pg groups and caches_num */
+  cache_pg_cnt = cache_pg_cnt / align * align;
+  size_t cache_size = cache_pg_cnt * sizeof(*pg_be);
+  int soc_id = dma->parent->soc_id;
+
+  struct st20_rfc4175_444_12_pg2_be* be_caches =
+      mt_rte_zmalloc_socket(cache_size * caches_num, soc_id);
+  struct mt_cvt_dma_ctx* ctx = mt_cvt_dma_ctx_init(2 * caches_num, soc_id, 2);
+  if (!be_caches || !ctx) {
+    err("%s, alloc cache(%d,%" PRIu64 ") fail, %p\n", __func__, cache_pg_cnt, cache_size,
+        be_caches);
+    if (be_caches) mt_rte_free(be_caches);
+    if (ctx) mt_cvt_dma_ctx_uinit(ctx);
+    return st20_rfc4175_444be12_to_444p12le_avx512(pg_be, y_g, b_r, r_b, w, h);
+  }
+  rte_iova_t be_caches_iova = rte_malloc_virt2iova(be_caches);
+
+  /* first with caches batch step */
+  int cache_batch = pg_cnt / cache_pg_cnt;
+  dbg("%s, pg_cnt %d cache_pg_cnt %d caches_num %d cache_batch %d\n", __func__, pg_cnt,
+      cache_pg_cnt, caches_num, cache_batch);
+  for (int i = 0; i < cache_batch; i++) {
+    struct st20_rfc4175_444_12_pg2_be* be_cache =
+        be_caches + (i % caches_num) * cache_pg_cnt;
+    dbg("%s, cache batch idx %d\n", __func__, i);
+
+    int max_tran = i + caches_num;
+    max_tran = RTE_MIN(max_tran, cache_batch);
+    int cur_tran = mt_cvt_dma_ctx_get_tran(ctx, 0);
+    /* push max be dma */
+    while (cur_tran < max_tran) {
+      rte_iova_t be_cache_iova = be_caches_iova + (cur_tran % caches_num) * cache_size;
+      mt_dma_copy_busy(dma, be_cache_iova, pg_be_iova, cache_size);
+      pg_be += cache_pg_cnt;
+      pg_be_iova += cache_size;
+      mt_cvt_dma_ctx_push(ctx, 0);
+      cur_tran = mt_cvt_dma_ctx_get_tran(ctx, 0);
+    }
+    mt_dma_submit_busy(dma);
+
+    /* wait until current be dma copy done */
+    while (mt_cvt_dma_ctx_get_done(ctx, 0) < (i + 1)) {
+      uint16_t nb_dq = mt_dma_completed(dma, 1, NULL, NULL);
+      if (nb_dq) mt_cvt_dma_ctx_pop(ctx);
+    }
+
+    int batch = cache_pg_cnt / 16;
+    rfc4175_444be12_to_444p12le_avx512_batch(be_cache, y_g, b_r, r_b, batch);
+    y_g += batch * 32;
+    b_r += batch * 32;
+    r_b += batch * 32;
+  }
+
+  pg_cnt = pg_cnt % cache_pg_cnt;
+  mt_cvt_dma_ctx_uinit(ctx);
+  mt_rte_free(be_caches);
+
+  /* remaining simd and scalar batch */
+  return st20_rfc4175_444be12_to_444p12le_avx512(pg_be, y_g, b_r, r_b, pg_cnt * 2, 1);
+}
+/* end st20_rfc4175_444be12_to_444p12le_avx512 */
+
+/* begin st20_444p12le_to_rfc4175_444be12_avx512 */
+int st20_444p12le_to_rfc4175_444be12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint32_t w, uint32_t h) {
+  struct cvt_b12_avx512 c;
+  __m512i idx[3];
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  cvt_b12_avx512_init(&c, false);
+  for (int i = 0; i < 3; i++)
+    idx[i] = _mm512_loadu_si512((__m512i*)cvt_444_to_pg_idx_tbl_512[i]);
+
+  /* each batch handle 16 pg groups(32 pixels) */
+  int batch = pg_cnt / 16;
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    __m512i b_r_input = _mm512_loadu_si512((__m512i*)b_r);
+    b_r += 32;
+    __m512i y_g_input = _mm512_loadu_si512((__m512i*)y_g);
+    y_g += 32;
+    __m512i r_b_input = _mm512_loadu_si512((__m512i*)r_b);
+    r_b += 32;
+
+    for (int j = 0; j < 3; j++) {
+      /* {B_R0, Y_G0, R_B0, B_R1, Y_G1, R_B1, ...} */
+      __m512i s = cvt_444_pick_m512i(b_r_input, y_g_input, r_b_input, idx[j],
+                                     cvt_444_to_pg_k_tbl[j]);
+      cvt_be12_pack_m512i(&c, s, be);
+      be += 48;
+    }
+  }
+  pg += batch * 16;
+
+  int left = pg_cnt % 16;
+  while (left) {
+    st20_pack_444le12_pg2be(b_r, y_g, r_b, pg);
+    pg++;
+    y_g += 2;
+    b_r += 2;
+    r_b += 2;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p12le_to_rfc4175_444be12_avx512 */
+
+/* begin st20_yuv422p12le_to_rfc4175_422be12_avx512 */
+/* {B0..B15, R0..R15} and {Y0..Y31} to {B0, Y0, R0, Y1, ...} */
+static uint16_t ple12_to_be_idx_tbl_512[2][32] = {
+    {
+        0, 32, 16, 33, 1, 34, 17, 35, 2, 36, 18, 37, 3, 38, 19, 39,
+        4, 40, 20, 41, 5, 42, 21, 43, 6, 44, 22, 45, 7, 46, 23, 47,
+    },
+    {
+        8,  48, 24, 49, 9,  50, 25, 51, 10, 52, 26, 53, 11, 54, 27, 55,
+        12, 56, 28, 57, 13, 58, 29, 59, 14, 60, 30, 61, 15, 62, 31, 63,
+    },
+};
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_12_pg2_be* pg,
+                                               uint32_t w, uint32_t h) {
+  struct cvt_b12_avx512 c;
+  __m512i idx0 = _mm512_loadu_si512((__m512i*)ple12_to_be_idx_tbl_512[0]);
+  __m512i idx1 = _mm512_loadu_si512((__m512i*)ple12_to_be_idx_tbl_512[1]);
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  cvt_b12_avx512_init(&c, false);
+
+  /* each batch handle 16 pg groups(32 pixels) */
+  int batch = pg_cnt / 16;
+  uint8_t* be = (uint8_t*)pg;
+  for (int i = 0; i < batch; i++) {
+    __m256i b_input = _mm256_loadu_si256((__m256i*)b);
+    b += 16;
+    __m256i r_input = _mm256_loadu_si256((__m256i*)r);
+    r += 16;
+    __m512i y_input = _mm512_loadu_si512((__m512i*)y);
+    y += 32;
+    __m512i br_input = _mm512_inserti64x4(_mm512_castsi256_si512(b_input), r_input, 1);
+
+    /* {B0, Y0, R0, Y1, ...} */
+    __m512i s0 = _mm512_permutex2var_epi16(br_input, idx0, y_input);
+    cvt_be12_pack_m512i(&c, s0, be);
+    __m512i s1 = _mm512_permutex2var_epi16(br_input, idx1, y_input);
+    cvt_be12_pack_m512i(&c, s1, be + 48);
+    be += 96;
+  }
+  pg += batch * 16;
+
+  int left = pg_cnt % 16;
+  while (left) {
+    st20_pack_422le12_pg2be(*b, *y, *r, *(y + 1), pg);
+    b++;
+    r++;
+    y += 2;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_yuv422p12le_to_rfc4175_422be12_avx512 */
+
+/* begin st20_rfc4175_422le12_to_422be12_avx512 */
+/* each batch handle 8 pg groups(48 bytes) */
+static void rfc4175_422le12_to_422be12_avx512_batch(
+    struct st20_rfc4175_422_12_pg2_le* pg_le, struct st20_rfc4175_422_12_pg2_be* pg_be,
+    int batch) {
+  struct cvt_b12_avx512 c;
+
+  cvt_b12_avx512_init(&c, true);
+
+  for (int i = 0; i < batch; i++) {
+    __m512i s = cvt_b12_unpack_m512i(&c, pg_le);
+    cvt_be12_pack_m512i(&c, s, pg_be);
+    pg_le += 8;
+    pg_be += 8;
+  }
+}
+
+int st20_rfc4175_422le12_to_422be12_avx512(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                           struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                           uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  int batch = pg_cnt / 8;
+  rfc4175_422le12_to_422be12_avx512_batch(pg_le, pg_be, batch);
+  pg_le += batch * 8;
+  pg_be += batch * 8;
+
+  int left = pg_cnt % 8;
+  while (left) {
+    uint16_t cb, y0, cr, y1;
+
+    cb = pg_le->Cb00 + (pg_le->Cb00_ << 8);
+    y0 = pg_le->Y00 + (pg_le->Y00_ << 4);
+    cr = pg_le->Cr00 + (pg_le->Cr00_ << 8);
+    y1 = pg_le->Y01 + (pg_le->Y01_ << 4);
+    st20_pack_422le12_pg2be(cb, y0, cr, y1, pg_be);
+
+    pg_be++;
+    pg_le++;
+    left--;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422le12_to_422be12_avx512_dma(struct mtl_dma_lender_dev* dma,
+                                               struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                               mtl_iova_t pg_le_iova,
+                                               struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                               uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+
+  int caches_num = 4;
+  int cache_pg_cnt = (256 * 1024) / sizeof(*pg_le); /* pg cnt for each cache */
+  int align = caches_num * 8; /* align to simd pg groups and caches_num */
+  cache_pg_cnt = cache_pg_cnt / align * align;
+  size_t cache_size = cache_pg_cnt * sizeof(*pg_le);
+  int soc_id = dma->parent->soc_id;
+
+  struct st20_rfc4175_422_12_pg2_le* le_caches =
+      mt_rte_zmalloc_socket(cache_size * caches_num, soc_id);
+  struct mt_cvt_dma_ctx* ctx = mt_cvt_dma_ctx_init(2 * caches_num, soc_id, 2);
+  if (!le_caches || !ctx) {
+    err("%s, alloc cache(%d,%" PRIu64 ") fail, %p\n", __func__, cache_pg_cnt, cache_size,
+        le_caches);
+    if (le_caches) mt_rte_free(le_caches);
+    if (ctx) mt_cvt_dma_ctx_uinit(ctx);
+    return st20_rfc4175_422le12_to_422be12_avx512(pg_le, pg_be, w, h);
+  }
+  rte_iova_t le_caches_iova = rte_malloc_virt2iova(le_caches);
+
+  /* first with caches batch step */
+  int cache_batch = pg_cnt / cache_pg_cnt;
+  dbg("%s, pg_cnt %d cache_pg_cnt %d caches_num %d cache_batch %d\n", __func__, pg_cnt,
+      cache_pg_cnt, caches_num, cache_batch);
+  for (int i = 0; i < cache_batch; i++) {
+    struct st20_rfc4175_422_12_pg2_le* le_cache =
+        le_caches + (i % caches_num) * cache_pg_cnt;
+    dbg("%s, cache batch idx %d\n", __func__, i);
+
+    int max_tran = i + caches_num;
+    max_tran = RTE_MIN(max_tran, cache_batch);
+    int cur_tran = mt_cvt_dma_ctx_get_tran(ctx, 0);
+    /* push max le dma */
+    while (cur_tran < max_tran) {
+      rte_iova_t le_cache_iova = le_caches_iova + (cur_tran % caches_num) * cache_size;
+      mt_dma_copy_busy(dma, le_cache_iova, pg_le_iova, cache_size);
+      pg_le += cache_pg_cnt;
+      pg_le_iova += cache_size;
+      mt_cvt_dma_ctx_push(ctx, 0);
+      cur_tran = mt_cvt_dma_ctx_get_tran(ctx, 0);
+    }
+    mt_dma_submit_busy(dma);
+
+    /* wait until current le dma copy done */
+    while (mt_cvt_dma_ctx_get_done(ctx, 0) < (i + 1)) {
+      uint16_t nb_dq = mt_dma_completed(dma, 1, NULL, NULL);
+      if (nb_dq) mt_cvt_dma_ctx_pop(ctx);
+    }
+
+    int batch = cache_pg_cnt / 8;
+    rfc4175_422le12_to_422be12_avx512_batch(le_cache, pg_be, batch);
+    pg_be += batch * 8;
+  }
+
+  pg_cnt = pg_cnt % cache_pg_cnt;
+  mt_cvt_dma_ctx_uinit(ctx);
+  mt_rte_free(le_caches);
+
+  /* remaining simd and scalar batch */
+  return st20_rfc4175_422le12_to_422be12_avx512(pg_le, pg_be, pg_cnt * 2, 1);
+}
+/* end st20_rfc4175_422le12_to_422be12_avx512 */
+
+/* the 420 layouts of the line pair kernels below */
+enum cvt_420_layout {
+  CVT_420_YUV420P10LE = 0,
+  CVT_420_YUV420P8,
+  CVT_420_NV12,
+  CVT_420_P010,
+};
+
+/* 32 Y of two 16 pg groups from the two unpacked __m512i */
+static uint16_t be10_to_420_y_idx_tbl_512[32] = {
+    1,  3,  5,  7,  9,  11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+    33, 35, 37, 39, 41, 43, 45, 47, 49, 51, 53, 55, 57, 59, 61, 63,
+};
+
+/* 16 Cb then 16 Cr for the planar, or the 32 interleaved CbCr for the semi-planar */
+static uint16_t be10_to_420_uv_idx_tbl_512[2][32] = {
+    {
+        0, 4,  8,  12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60,
+        2, 6,  10, 14, 18, 22, 26, 30, 34, 38, 42, 46, 50, 54, 58, 62,
+    },
+    {
+        0,  2,  4,  6,  8,  10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
+        32, 34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62,
+    },
+};
+
+/*
+ * the reverse of above, build the {Cb, Y, Cr, Y} stream of 8 pg groups from the 32
+ * chroma(0-31) and the 32 Y(32-63), the planar at [0] and the semi-planar at [1].
+ */
+static uint16_t cvt_420_to_pg_idx_tbl_512[2][2][32] = {
+    {
+        {
+            0, 32, 16, 33, 1, 34, 17, 35, 2, 36, 18, 37, 3, 38, 19, 39,
+            4, 40, 20, 41, 5, 42, 21, 43, 6, 44, 22, 45, 7, 46, 23, 47,
+        },
+        {
+            8,  48, 24, 49, 9,  50, 25, 51, 10, 52, 26, 53, 11, 54, 27, 55,
+            12, 56, 28, 57, 13, 58, 29, 59, 14, 60, 30, 61, 15, 62, 31, 63,
+        },
+    },
+    {
+        {
+            0, 32, 1, 33, 2,  34, 3,  35, 4,  36, 5,  37, 6,  38, 7,  39,
+            8, 40, 9, 41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47,
+        },
+        {
+            16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23, 55,
+            24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30, 62, 31, 63,
+        },
+    },
+};
+
+struct cvt_420_avx512 {
+  struct cvt_b10_avx512 b10;
+  enum cvt_420_layout layout;
+  __m512i y_idx;
+  __m512i uv_idx;
+  __m512i pg_idx[2];
+};
+
+static inline bool cvt_420_is_semi(enum cvt_420_layout layout) {
+  return (layout == CVT_420_NV12) || (layout == CVT_420_P010);
+}
+
+static inline bool cvt_420_is_8bit(enum cvt_420_layout layout) {
+  return (layout == CVT_420_YUV420P8) || (layout == CVT_420_NV12);
+}
+
+static inline void cvt_420_avx512_init(struct cvt_420_avx512* c,
+                                       enum cvt_420_layout layout) {
+  int semi = cvt_420_is_semi(layout) ? 1 : 0;
+
+  cvt_b10_avx512_init(&c->b10);
+  c->layout = layout;
+  c->y_idx = _mm512_loadu_si512((__m512i*)be10_to_420_y_idx_tbl_512);
+  c->uv_idx = _mm512_loadu_si512((__m512i*)be10_to_420_uv_idx_tbl_512[semi]);
+  for (int i = 0; i < 2; i++)
+    c->pg_idx[i] = _mm512_loadu_si512((__m512i*)cvt_420_to_pg_idx_tbl_512[semi][i]);
+}
+
+/* store the 32 Y(10bit) at pixel x of the line */
+static inline void cvt_420_store_y(struct cvt_420_avx512* c, __m512i y, void* line,
+                                   uint32_t x) {
+  switch (c->layout) {
+    case CVT_420_YUV420P10LE:
+      _mm512_storeu_si512((__m512i*)((uint16_t*)line + x), y);
+      break;
+    case CVT_420_P010:
+      _mm512_storeu_si512((__m512i*)((uint16_t*)line + x), _mm512_slli_epi16(y, 6));
+      break;
+    default:
+      _mm256_storeu_si256((__m256i*)((uint8_t*)line + x),
+                          _mm512_cvtepi16_epi8(_mm512_srli_epi16(y, 2)));
+      break;
+  }
+}
+
+/* store the 32 chroma(10bit) of the 32 pixels start from x */
+static inline void cvt_420_store_uv(struct cvt_420_avx512* c, __m512i uv, void* u,
+                                    void* v, uint32_t x) {
+  __m256i uv8;
+
+  switch (c->layout) {
+    case CVT_420_YUV420P10LE:
+      _mm256_storeu_si256((__m256i*)((uint16_t*)u + x / 2),
+                          _mm512_castsi512_si256(uv));
+      _mm256_storeu_si256((__m256i*)((uint16_t*)v + x / 2),
+                          _mm512_extracti64x4_epi64(uv, 1));
+      break;
+    case CVT_420_YUV420P8:
+      uv8 = _mm512_cvtepi16_epi8(_mm512_srli_epi16(uv, 2));
+      _mm_storeu_si128((__m128i*)((uint8_t*)u + x / 2), _mm256_castsi256_si128(uv8));
+      _mm_storeu_si128((__m128i*)((uint8_t*)v + x / 2), _mm256_extracti128_si256(uv8, 1));
+      break;
+    case CVT_420_NV12:
+      uv8 = _mm512_cvtepi16_epi8(_mm512_srli_epi16(uv, 2));
+      _mm256_storeu_si256((__m256i*)((uint8_t*)u + x), uv8);
+      break;
+    case CVT_420_P010:
+      _mm512_storeu_si512((__m512i*)((uint16_t*)u + x), _mm512_slli_epi16(uv, 6));
+      break;
+  }
+}
+
+/* load the 32 Y at pixel x of the line to 10bit */
+static inline __m512i cvt_420_load_y(struct cvt_420_avx512* c, void* line, uint32_t x) {
+  switch (c->layout) {
+    case CVT_420_YUV420P10LE:
+      return _mm512_loadu_si512((__m512i*)((uint16_t*)line + x));
+    case CVT_420_P010:
+      return _mm512_srli_epi16(_mm512_loadu_si512((__m512i*)((uint16_t*)line + x)), 6);
+    default:
+      return _mm512_slli_epi16(
+          _mm512_cvtepu8_epi16(_mm256_loadu_si256((__m256i*)((uint8_t*)line + x))), 2);
+  }
+}
+
+/* load the 32 chroma of the 32 pixels start from x to 10bit */
+static inline __m512i cvt_420_load_uv(struct cvt_420_avx512* c, void* u, void* v,
+                                      uint32_t x) {
+  __m256i uv8;
+
+  switch (c->layout) {
+    case CVT_420_YUV420P10LE:
+      return _mm512_inserti64x4(
+          _mm512_castsi256_si512(_mm256_loadu_si256((__m256i*)((uint16_t*)u + x / 2))),
+          _mm256_loadu_si256((__m256i*)((uint16_t*)v + x / 2)), 1);
+    case CVT_420_YUV420P8:
+      uv8 = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((__m128i*)((uint8_t*)u + x / 2))),
+          _mm_loadu_si128((__m128i*)((uint8_t*)v + x / 2)), 1);
+      return _mm512_slli_epi16(_mm512_cvtepu8_epi16(uv8), 2);
+    case CVT_420_NV12:
+      uv8 = _mm256_loadu_si256((__m256i*)((uint8_t*)u + x));
+      return _mm512_slli_epi16(_mm512_cvtepu8_epi16(uv8), 2);
+    default: /* CVT_420_P010 */
+      return _mm512_srli_epi16(_mm512_loadu_si512((__m512i*)((uint16_t*)u + x)), 6);
+  }
+}
+
+/* the scalar of one pg group of the line pair, i is the pg index in the line */
+static inline void cvt_be10_to_420_pg(enum cvt_420_layout layout,
+                                      struct st20_rfc4175_422_10_pg2_be* pg0,
+                                      struct st20_rfc4175_422_10_pg2_be* pg1, void* y0,
+                                      void* y1, void* u, void* v, uint32_t i) {
+  uint16_t cb0, cr0, cb1, cr1, cb, cr;
+  uint16_t l0[2], l1[2];
+
+  st20_unpack_pg2be_422le10(pg0, &cb0, &l0[0], &cr0, &l0[1]);
+  st20_unpack_pg2be_422le10(pg1, &cb1, &l1[0], &cr1, &l1[1]);
+  cb = (cb0 + cb1 + 1) >> 1;
+  cr = (cr0 + cr1 + 1) >> 1;
+
+  for (int j = 0; j < 2; j++) {
+    switch (layout) {
+      case CVT_420_YUV420P10LE:
+        ((uint16_t*)y0)[i * 2 + j] = l0[j];
+        ((uint16_t*)y1)[i * 2 + j] = l1[j];
+        break;
+      case CVT_420_P010:
+        ((uint16_t*)y0)[i * 2 + j] = l0[j] << 6;
+        ((uint16_t*)y1)[i * 2 + j] = l1[j] << 6;
+        break;
+      default:
+        ((uint8_t*)y0)[i * 2 + j] = l0[j] >> 2;
+        ((uint8_t*)y1)[i * 2 + j] = l1[j] >> 2;
+        break;
+    }
+  }
+
+  switch (layout) {
+    case CVT_420_YUV420P10LE:
+      ((uint16_t*)u)[i] = cb;
+      ((uint16_t*)v)[i] = cr;
+      break;
+    case CVT_420_YUV420P8:
+      ((uint8_t*)u)[i] = cb >> 2;
+      ((uint8_t*)v)[i] = cr >> 2;
+      break;
+    case CVT_420_NV12:
+      ((uint8_t*)u)[i * 2] = cb >> 2;
+      ((uint8_t*)u)[i * 2 + 1] = cr >> 2;
+      break;
+    case CVT_420_P010:
+      ((uint16_t*)u)[i * 2] = cb << 6;
+      ((uint16_t*)u)[i * 2 + 1] = cr << 6;
+      break;
+  }
+}
+
+/* the scalar of one pg group of one line, i is the pg index in the line */
+static inline void cvt_420_to_be10_pg(enum cvt_420_layout layout, void* y, void* u,
+                                      void* v, uint32_t i,
+                                      struct st20_rfc4175_422_10_pg2_be* pg) {
+  uint16_t cb, y0, cr, y1;
+
+  switch (layout) {
+    case CVT_420_YUV420P10LE:
+      cb = ((uint16_t*)u)[i];
+      cr = ((uint16_t*)v)[i];
+      y0 = ((uint16_t*)y)[i * 2];
+      y1 = ((uint16_t*)y)[i * 2 + 1];
+      break;
+    case CVT_420_YUV420P8:
+      cb = ((uint8_t*)u)[i] << 2;
+      cr = ((uint8_t*)v)[i] << 2;
+      y0 = ((uint8_t*)y)[i * 2] << 2;
+      y1 = ((uint8_t*)y)[i * 2 + 1] << 2;
+      break;
+    case CVT_420_NV12:
+      cb = ((uint8_t*)u)[i * 2] << 2;
+      cr = ((uint8_t*)u)[i * 2 + 1] << 2;
+      y0 = ((uint8_t*)y)[i * 2] << 2;
+      y1 = ((uint8_t*)y)[i * 2 + 1] << 2;
+      break;
+    default: /* CVT_420_P010 */
+      cb = ((uint16_t*)u)[i * 2] >> 6;
+      cr = ((uint16_t*)u)[i * 2 + 1] >> 6;
+      y0 = ((uint16_t*)y)[i * 2] >> 6;
+      y1 = ((uint16_t*)y)[i * 2 + 1] >> 6;
+      break;
+  }
+
+  st20_pack_422le10_pg2be(cb, y0, cr, y1, pg);
+}
+
+/* begin st20_rfc4175_422be10_to_420_avx512 */
+static void cvt_be10_to_420_line2_avx512(struct cvt_420_avx512* c,
+                                         struct st20_rfc4175_422_10_pg2_be* pg0,
+                                         struct st20_rfc4175_422_10_pg2_be* pg1,
+                                         void* y0, void* y1, void* u, void* v,
+                                         uint32_t w) {
+  uint8_t* be0 = (uint8_t*)pg0;
+  uint8_t* be1 = (uint8_t*)pg1;
+  /* each batch handle 16 pg groups(32 pixels) of the two lines */
+  uint32_t batch = w / 32;
+
+  for (uint32_t i = 0; i < batch; i++) {
+    uint32_t x = i * 32;
+    /* {Cb0, Y0, Cr0, Y1, Cb1, Y2, Cr1, Y3, ...} */
+    __m512i l0_lo = cvt_be10_unpack_m512i(&c->b10, be0);
+    __m512i l0_hi = cvt_be10_unpack_m512i(&c->b10, be0 + 40);
+    be0 += 80;
+    __m512i l1_lo = cvt_be10_unpack_m512i(&c->b10, be1);
+    __m512i l1_hi = cvt_be10_unpack_m512i(&c->b10, be1 + 40);
+    be1 += 80;
+
+    cvt_420_store_y(c, _mm512_permutex2var_epi16(l0_lo, c->y_idx, l0_hi), y0, x);
+    cvt_420_store_y(c, _mm512_permutex2var_epi16(l1_lo, c->y_idx, l1_hi), y1, x);
+    /* the vertical average of the chroma, (a + b + 1) >> 1 */
+    __m512i uv0 = _mm512_permutex2var_epi16(l0_lo, c->uv_idx, l0_hi);
+    __m512i uv1 = _mm512_permutex2var_epi16(l1_lo, c->uv_idx, l1_hi);
+    cvt_420_store_uv(c, _mm512_avg_epu16(uv0, uv1), u, v, x);
+  }
+
+  for (uint32_t i = batch * 16; i < w / 2; i++)
+    cvt_be10_to_420_pg(c->layout, pg0 + i, pg1 + i, y0, y1, u, v, i);
+}
+
+static int cvt_be10_to_420_avx512(struct st20_rfc4175_422_10_pg2_be* pg, void* y,
+                                  void* u, void* v, uint32_t w, uint32_t h,
+                                  enum cvt_420_layout layout) {
+  struct cvt_420_avx512 c;
+  uint32_t pg_per_line = w / 2;
+  size_t sample_size = cvt_420_is_8bit(layout) ? 1 : 2;
+  size_t y_linesize = w * sample_size;
+  /* the u line of the semi-planar holds the interleaved CbCr */
+  size_t u_linesize = (cvt_420_is_semi(layout) ? w : w / 2) * sample_size;
+  uint8_t* y0 = y;
+  uint8_t* u0 = u;
+  uint8_t* v0 = v;
+  dbg("%s, w %u h %u layout %d\n", __func__, w, h, layout);
+
+  cvt_420_avx512_init(&c, layout);
+  for (uint32_t line = 0; line + 1 < h; line += 2) {
+    cvt_be10_to_420_line2_avx512(&c, pg, pg + pg_per_line, y0, y0 + y_linesize, u0, v0,
+                                 w);
+    pg += pg_per_line * 2;
+    y0 += y_linesize * 2;
+    u0 += u_linesize;
+    if (v0) v0 += u_linesize;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_yuv420p10le_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint16_t* y, uint16_t* b, uint16_t* r,
+                                               uint32_t w, uint32_t h) {
+  return cvt_be10_to_420_avx512(pg, y, b, r, w, h, CVT_420_YUV420P10LE);
+}
+
+int st20_rfc4175_422be10_to_yuv420p8_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint8_t* y, uint8_t* b, uint8_t* r,
+                                            uint32_t w, uint32_t h) {
+  return cvt_be10_to_420_avx512(pg, y, b, r, w, h, CVT_420_YUV420P8);
+}
+
+int st20_rfc4175_422be10_to_nv12_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint8_t* y, uint8_t* uv, uint32_t w,
+                                        uint32_t h) {
+  return cvt_be10_to_420_avx512(pg, y, uv, NULL, w, h, CVT_420_NV12);
+}
+
+int st20_rfc4175_422be10_to_p010_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint16_t* y, uint16_t* uv, uint32_t w,
+                                        uint32_t h) {
+  return cvt_be10_to_420_avx512(pg, y, uv, NULL, w, h, CVT_420_P010);
+}
+/* end st20_rfc4175_422be10_to_420_avx512 */
+
+/* begin st20_420_to_rfc4175_422be10_avx512 */
+static void cvt_420_to_be10_line2_avx512(struct cvt_420_avx512* c, void* y0, void* y1,
+                                         void* u, void* v,
+                                         struct st20_rfc4175_422_10_pg2_be* pg0,
+                                         struct st20_rfc4175_422_10_pg2_be* pg1,
+                                         uint32_t w) {
+  uint8_t* be0 = (uint8_t*)pg0;
+  uint8_t* be1 = (uint8_t*)pg1;
+  /* each batch handle 16 pg groups(32 pixels) of the two lines */
+  uint32_t batch = w / 32;
+
+  for (uint32_t i = 0; i < batch; i++) {
+    uint32_t x = i * 32;
+    /* the chroma line is shared by the two lines */
+    __m512i uv = cvt_420_load_uv(c, u, v, x);
+    __m512i l0 = cvt_420_load_y(c, y0, x);
+    __m512i l1 = cvt_420_load_y(c, y1, x);
+
+    cvt_be10_pack_m512i(&c->b10, _mm512_permutex2var_epi16(uv, c->pg_idx[0], l0), be0);
+    cvt_be10_pack_m512i(&c->b10, _mm512_permutex2var_epi16(uv, c->pg_idx[1], l0),
+                        be0 + 40);
+    be0 += 80;
+    cvt_be10_pack_m512i(&c->b10, _mm512_permutex2var_epi16(uv, c->pg_idx[0], l1), be1);
+    cvt_be10_pack_m512i(&c->b10, _mm512_permutex2var_epi16(uv, c->pg_idx[1], l1),
+                        be1 + 40);
+    be1 += 80;
+  }
+
+  for (uint32_t i = batch * 16; i < w / 2; i++) {
+    cvt_420_to_be10_pg(c->layout, y0, u, v, i, pg0 + i);
+    cvt_420_to_be10_pg(c->layout, y1, u, v, i, pg1 + i);
+  }
+}
+
+static int cvt_420_to_be10_avx512(void* y, void* u, void* v,
+                                  struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                  uint32_t h, enum cvt_420_layout layout) {
+  struct cvt_420_avx512 c;
+  uint32_t pg_per_line = w / 2;
+  size_t sample_size = cvt_420_is_8bit(layout) ? 1 : 2;
+  size_t y_linesize = w * sample_size;
+  /* the u line of the semi-planar holds the interleaved CbCr */
+  size_t u_linesize = (cvt_420_is_semi(layout) ? w : w / 2) * sample_size;
+  uint8_t* y0 = y;
+  uint8_t* u0 = u;
+  uint8_t* v0 = v;
+  dbg("%s, w %u h %u layout %d\n", __func__, w, h, layout);
+
+  cvt_420_avx512_init(&c, layout);
+  for (uint32_t line = 0; line + 1 < h; line += 2) {
+    cvt_420_to_be10_line2_avx512(&c, y0, y0 + y_linesize, u0, v0, pg, pg + pg_per_line,
+                                 w);
+    pg += pg_per_line * 2;
+    y0 += y_linesize * 2;
+    u0 += u_linesize;
+    if (v0) v0 += u_linesize;
+  }
+
+  return 0;
+}
+
+int st20_yuv420p10le_to_rfc4175_422be10_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h) {
+  return cvt_420_to_be10_avx512(y, b, r, pg, w, h, CVT_420_YUV420P10LE);
+}
+
+int st20_yuv420p8_to_rfc4175_422be10_avx512(uint8_t* y, uint8_t* b, uint8_t* r,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint32_t w, uint32_t h) {
+  return cvt_420_to_be10_avx512(y, b, r, pg, w, h, CVT_420_YUV420P8);
+}
+
+int st20_nv12_to_rfc4175_422be10_avx512(uint8_t* y, uint8_t* uv,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h) {
+  return cvt_420_to_be10_avx512(y, uv, NULL, pg, w, h, CVT_420_NV12);
+}
+
+int st20_p010_to_rfc4175_422be10_avx512(uint16_t* y, uint16_t* uv,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h) {
+  return cvt_420_to_be10_avx512(y, uv, NULL, pg, w, h, CVT_420_P010);
+}
+/* end st20_420_to_rfc4175_422be10_avx512 */
+
+/* the rgb layouts of the csc kernels below */
+enum cvt_csc_layout {
+  CVT_CSC_GBRP10LE = 0,
+  CVT_CSC_RGB8,
+};
+
+/* the R, G and B of the 32 rgb8 pixels from the 96 samples of three __m512i */
+static uint16_t rgb8_to_csc_idx_tbl_512[3][32] = {
+    {
+        0,  3,  6,  9,  12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45,
+        48, 51, 54, 57, 60, 63, 66, 69, 72, 75, 78, 81, 84, 87, 90, 93,
+    },
+    {
+        1,  4,  7,  10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+        49, 52, 55, 58, 61, 64, 67, 70, 73, 76, 79, 82, 85, 88, 91, 94,
+    },
+    {
+        2,  5,  8,  11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47,
+        50, 53, 56, 59, 62, 65, 68, 71, 74, 77, 80, 83, 86, 89, 92, 95,
+    },
+};
+
+/* the lanes of above which come from the third __m512i */
+static uint32_t rgb8_to_csc_mask_tbl[3] = {0xffc00000, 0xffe00000, 0xffe00000};
+
+/* the reverse, each 32 rgb8 samples from the R(0-31) and G(32-63), B by the mask */
+static uint16_t csc_to_rgb8_idx_tbl_512[3][32] = {
+    {
+        0, 32, 0, 1, 33, 1, 2, 34, 2, 3, 35, 3, 4, 36, 4, 5,
+        37, 5, 6, 38, 6, 7, 39, 7, 8, 40, 8, 9, 41, 9, 10, 42,
+    },
+    {
+        10, 11, 43, 11, 12, 44, 12, 13, 45, 13, 14, 46, 14, 15, 47, 15,
+        16, 48, 16, 17, 49, 17, 18, 50, 18, 19, 51, 19, 20, 52, 20, 21,
+    },
+    {
+        53, 21, 22, 54, 22, 23, 55, 23, 24, 56, 24, 25, 57, 25, 26, 58,
+        26, 27, 59, 27, 28, 60, 28, 29, 61, 29, 30, 62, 30, 31, 63, 31,
+    },
+};
+
+static uint32_t csc_to_rgb8_mask_tbl[3] = {0x24924924, 0x49249249, 0x92492492};
+
+/* the left neighbor of each pixel, the first from the lane 31 of the previous batch */
+static uint16_t csc_left_idx_tbl_512[32] = {
+    31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46,
+    47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62,
+};
+
+/* the right neighbor of each pixel, the last one is never used by the even pixels */
+static uint16_t csc_right_idx_tbl_512[32] = {
+    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+    17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 31,
+};
+
+/* the 16 Cb of the even pixels then the 16 Cr of the even pixels */
+static uint16_t csc_even_idx_tbl_512[32] = {
+    0,  2,  4,  6,  8,  10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
+    32, 34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62,
+};
+
+/* the next pg group chroma of the 16 Cb and 16 Cr, the lane 15 and 31 set later */
+static uint16_t csc_next_idx_tbl_512[32] = {
+    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 15,
+    17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 31,
+};
+
+/* the 32 Cb or Cr of each pixel, even from the pg group(0-31) and odd from the avg */
+static uint16_t csc_chroma_idx_tbl_512[2][32] = {
+    {
+        0, 32, 1, 33, 2,  34, 3,  35, 4,  36, 5,  37, 6,  38, 7,  39,
+        8, 40, 9, 41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47,
+    },
+    {
+        16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23, 55,
+        24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30, 62, 31, 63,
+    },
+};
+
+struct cvt_csc_avx512 {
+  struct cvt_b10_avx512 b10;
+  enum cvt_csc_layout layout;
+  const struct st_csc_coef* coef;
+  __m512i rgb8_idx[3];
+  __mmask32 rgb8_mask[3];
+  __m512i store_idx[3];
+  __mmask32 store_mask[3];
+  __m512i left_idx;
+  __m512i right_idx;
+  __m512i even_idx;
+  __m512i next_idx;
+  __m512i chroma_idx[2];
+  /* the be10 stream order, share with the 420 */
+  __m512i y_idx;
+  __m512i uv_idx;
+  __m512i pg_idx[2];
+  /* the madd pairs of the matrix */
+  __m512i to_y[2];
+  __m512i to_cb[2];
+  __m512i to_cr[2];
+  __m512i to_r;
+  __m512i to_g[2];
+  __m512i to_b;
+  __m512i y_off;
+  __m512i c512;
+  __m512i c1024;
+  __m512i round;
+  __m512i max10;
+};
+
+static inline __m512i cvt_csc_pair(int16_t lo, int16_t hi) {
+  return _mm512_set1_epi32((uint16_t)lo | ((uint32_t)(uint16_t)hi << 16));
+}
+
+static inline void cvt_csc_avx512_init(struct cvt_csc_avx512* c,
+                                       enum cvt_csc_layout layout,
+                                       const struct st_csc_coef* coef) {
+  int16_t off_y = coef->y_off * 8 + 4;
+  int16_t off_c = 512 * 8 + 4;
+
+  cvt_b10_avx512_init(&c->b10);
+  c->layout = layout;
+  c->coef = coef;
+  for (int i = 0; i < 3; i++) {
+    c->rgb8_idx[i] = _mm512_loadu_si512((__m512i*)rgb8_to_csc_idx_tbl_512[i]);
+    c->rgb8_mask[i] = rgb8_to_csc_mask_tbl[i];
+    c->store_idx[i] = _mm512_loadu_si512((__m512i*)csc_to_rgb8_idx_tbl_512[i]);
+    c->store_mask[i] = csc_to_rgb8_mask_tbl[i];
+  }
+  c->left_idx = _mm512_loadu_si512((__m512i*)csc_left_idx_tbl_512);
+  c->right_idx = _mm512_loadu_si512((__m512i*)csc_right_idx_tbl_512);
+  c->even_idx = _mm512_loadu_si512((__m512i*)csc_even_idx_tbl_512);
+  c->next_idx = _mm512_loadu_si512((__m512i*)csc_next_idx_tbl_512);
+  for (int i = 0; i < 2; i++) {
+    c->chroma_idx[i] = _mm512_loadu_si512((__m512i*)csc_chroma_idx_tbl_512[i]);
+    c->pg_idx[i] = _mm512_loadu_si512((__m512i*)cvt_420_to_pg_idx_tbl_512[0][i]);
+  }
+  c->y_idx = _mm512_loadu_si512((__m512i*)be10_to_420_y_idx_tbl_512);
+  c->uv_idx = _mm512_loadu_si512((__m512i*)be10_to_420_uv_idx_tbl_512[0]);
+
+  /* {R, G} and {B, 1024} pairs, the 1024 carry the offset and the round */
+  c->to_y[0] = cvt_csc_pair(coef->to_y[0], coef->to_y[1]);
+  c->to_y[1] = cvt_csc_pair(coef->to_y[2], off_y);
+  c->to_cb[0] = cvt_csc_pair(coef->to_cb[0], coef->to_cb[1]);
+  c->to_cb[1] = cvt_csc_pair(coef->to_cb[2], off_c);
+  c->to_cr[0] = cvt_csc_pair(coef->to_cr[0], coef->to_cr[1]);
+  c->to_cr[1] = cvt_csc_pair(coef->to_cr[2], off_c);
+  /* {Y, Cr}, {Y, Cb} and {Cr, 1024} pairs */
+  c->to_r = cvt_csc_pair(coef->y_gain, coef->cr_r);
+  c->to_g[0] = cvt_csc_pair(coef->y_gain, coef->cb_g);
+  c->to_g[1] = cvt_csc_pair(coef->cr_g, 4);
+  c->to_b = cvt_csc_pair(coef->y_gain, coef->cb_b);
+  c->y_off = _mm512_set1_epi16(coef->y_off);
+  c->c512 = _mm512_set1_epi16(512);
+  c->c1024 = _mm512_set1_epi16(1024);
+  c->round = _mm512_set1_epi32(1 << (ST_CSC_SHIFT - 1));
+  c->max10 = _mm512_set1_epi16(1023);
+}
+
+/* the 32 bit sums of the unpacklo and unpackhi back to 32 clipped 10 bit samples */
+static inline __m512i cvt_csc_pack(struct cvt_csc_avx512* c, __m512i lo, __m512i hi) {
+  __m512i v = _mm512_packs_epi32(_mm512_srai_epi32(lo, ST_CSC_SHIFT),
+                                 _mm512_srai_epi32(hi, ST_CSC_SHIFT));
+  return _mm512_min_epi16(_mm512_max_epi16(v, _mm512_setzero_si512()), c->max10);
+}
+
+static inline __m512i cvt_csc_row(struct cvt_csc_avx512* c, __m512i* row, __m512i rg_lo,
+                                  __m512i rg_hi, __m512i b1_lo, __m512i b1_hi) {
+  __m512i lo = _mm512_add_epi32(_mm512_madd_epi16(rg_lo, row[0]),
+                                _mm512_madd_epi16(b1_lo, row[1]));
+  __m512i hi = _mm512_add_epi32(_mm512_madd_epi16(rg_hi, row[0]),
+                                _mm512_madd_epi16(b1_hi, row[1]));
+  return cvt_csc_pack(c, lo, hi);
+}
+
+/* the [1 2 1] filter of the 32 chroma, prev is the chroma of the previous 32 pixels */
+static inline __m512i cvt_csc_filter(struct cvt_csc_avx512* c, __m512i prev,
+                                     __m512i cur) {
+  __m512i left = _mm512_permutex2var_epi16(prev, c->left_idx, cur);
+  __m512i right = _mm512_permutexvar_epi16(c->right_idx, cur);
+  __m512i sum = _mm512_add_epi16(_mm512_add_epi16(left, right),
+                                 _mm512_add_epi16(_mm512_slli_epi16(cur, 1),
+                                                  _mm512_set1_epi16(2)));
+  return _mm512_srli_epi16(sum, 2);
+}
+
+/* load the R, G and B(10bit) of the 32 pixels start from x */
+static inline void cvt_csc_load_rgb(struct cvt_csc_avx512* c, void* g, void* b,
+                                    void* r, uint32_t x, __m512i* rgb) {
+  if (c->layout == CVT_CSC_GBRP10LE) {
+    rgb[0] = _mm512_loadu_si512((__m512i*)((uint16_t*)r + x));
+    rgb[1] = _mm512_loadu_si512((__m512i*)((uint16_t*)g + x));
+    rgb[2] = _mm512_loadu_si512((__m512i*)((uint16_t*)b + x));
+    return;
+  }
+
+  /* the rgb8 is packed in g */
+  uint8_t* p = (uint8_t*)g + x * 3;
+  __m512i s[3];
+  for (int i = 0; i < 3; i++) {
+    s[i] = _mm512_cvtepu8_epi16(_mm256_loadu_si256((__m256i*)(p + i * 32)));
+    s[i] = _mm512_or_si512(_mm512_slli_epi16(s[i], 2), _mm512_srli_epi16(s[i], 6));
+  }
+  for (int i = 0; i < 3; i++) {
+    rgb[i] = _mm512_permutex2var_epi16(s[0], c->rgb8_idx[i], s[1]);
+    rgb[i] = _mm512_mask_permutexvar_epi16(rgb[i], c->rgb8_mask[i], c->rgb8_idx[i], s[2]);
+  }
+}
+
+/* store the R, G and B(10bit) of the 32 pixels start from x */
+static inline void cvt_csc_store_rgb(struct cvt_csc_avx512* c, __m512i* rgb, void* g,
+                                     void* b, void* r, uint32_t x) {
+  if (c->layout == CVT_CSC_GBRP10LE) {
+    _mm512_storeu_si512((__m512i*)((uint16_t*)r + x), rgb[0]);
+    _mm512_storeu_si512((__m512i*)((uint16_t*)g + x), rgb[1]);
+    _mm512_storeu_si512((__m512i*)((uint16_t*)b + x), rgb[2]);
+    return;
+  }
+
+  uint8_t* p = (uint8_t*)g + x * 3;
+  __m512i s8[3];
+  for (int i = 0; i < 3; i++) {
+    s8[i] = _mm512_srli_epi16(_mm512_add_epi16(rgb[i], _mm512_set1_epi16(2)), 2);
+    s8[i] = _mm512_min_epu16(s8[i], _mm512_set1_epi16(255));
+  }
+  for (int i = 0; i < 3; i++) {
+    __m512i v = _mm512_permutex2var_epi16(s8[0], c->store_idx[i], s8[1]);
+    v = _mm512_mask_permutexvar_epi16(v, c->store_mask[i], c->store_idx[i], s8[2]);
+    _mm256_storeu_si256((__m256i*)(p + i * 32), _mm512_cvtepi16_epi8(v));
+  }
+}
+
+/* the R, G and B(10bit) of the pixel x, the rgb8 is packed in g */
+static inline void cvt_csc_get_rgb(enum cvt_csc_layout layout, void* g, void* b, void* r,
+                                   uint32_t x, uint16_t* rgb) {
+  if (layout == CVT_CSC_GBRP10LE) {
+    rgb[0] = ((uint16_t*)r)[x];
+    rgb[1] = ((uint16_t*)g)[x];
+    rgb[2] = ((uint16_t*)b)[x];
+  } else {
+    uint8_t* p = (uint8_t*)g + x * 3;
+    for (int i = 0; i < 3; i++) rgb[i] = st_csc_8_to_10(p[i]);
+  }
+}
+
+static inline void cvt_csc_set_rgb(enum cvt_csc_layout layout, void* g, void* b, void* r,
+                                   uint32_t x, uint16_t* rgb) {
+  if (layout == CVT_CSC_GBRP10LE) {
+    ((uint16_t*)r)[x] = rgb[0];
+    ((uint16_t*)g)[x] = rgb[1];
+    ((uint16_t*)b)[x] = rgb[2];
+  } else {
+    uint8_t* p = (uint8_t*)g + x * 3;
+    for (int i = 0; i < 3; i++) p[i] = st_csc_10_to_8(rgb[i]);
+  }
+}
+
+/* the scalar of the line from the pixel x, the left chroma from the pixel x - 1 */
+static void cvt_csc_to_be10_tail(struct cvt_csc_avx512* c, void* g, void* b, void* r,
+                                 struct st20_rfc4175_422_10_pg2_be* pg, uint32_t x,
+                                 uint32_t w) {
+  uint16_t rgb[3], y[2], cb[3], cr[3];
+
+  cvt_csc_get_rgb(c->layout, g, b, r, x ? x - 1 : 0, rgb);
+  st_csc_rgb_to_yuv10(c->coef, rgb[0], rgb[1], rgb[2], &y[0], &cb[0], &cr[0]);
+  for (; x < w; x += 2) {
+    for (int i = 0; i < 2; i++) {
+      cvt_csc_get_rgb(c->layout, g, b, r, x + i, rgb);
+      st_csc_rgb_to_yuv10(c->coef, rgb[0], rgb[1], rgb[2], &y[i], &cb[i + 1],
+                          &cr[i + 1]);
+    }
+    st20_pack_422le10_pg2be(st_csc_chroma_filter(cb[0], cb[1], cb[2]), y[0],
+                            st_csc_chroma_filter(cr[0], cr[1], cr[2]), y[1], pg++);
+    cb[0] = cb[2];
+    cr[0] = cr[2];
+  }
+}
+
+/* the scalar of the line from the pixel x, pg point to the pg group of the pixel x */
+static void cvt_be10_to_csc_tail(struct cvt_csc_avx512* c,
+                                 struct st20_rfc4175_422_10_pg2_be* pg, void* g, void* b,
+                                 void* r, uint32_t x, uint32_t w) {
+  uint16_t cb, y0, cr, y1;
+  uint16_t cb1, y2 = 0, cr1, y3 = 0;
+  uint16_t rgb[3];
+
+  if (x >= w) return;
+  st20_unpack_pg2be_422le10(pg, &cb, &y0, &cr, &y1);
+  for (; x < w; x += 2) {
+    if (x + 2 < w) {
+      st20_unpack_pg2be_422le10(pg + 1, &cb1, &y2, &cr1, &y3);
+    } else { /* replicate the last chroma at the line end */
+      cb1 = cb;
+      cr1 = cr;
+    }
+    st_csc_yuv_to_rgb10(c->coef, y0, cb, cr, &rgb[0], &rgb[1], &rgb[2]);
+    cvt_csc_set_rgb(c->layout, g, b, r, x, rgb);
+    st_csc_yuv_to_rgb10(c->coef, y1, (cb + cb1 + 1) >> 1, (cr + cr1 + 1) >> 1, &rgb[0],
+                        &rgb[1], &rgb[2]);
+    cvt_csc_set_rgb(c->layout, g, b, r, x + 1, rgb);
+    pg++;
+    cb = cb1;
+    cr = cr1;
+    y0 = y2;
+    y1 = y3;
+  }
+}
+
+/* begin st20_rgb_to_rfc4175_422be10_avx512 */
+static void cvt_csc_to_be10_line_avx512(struct cvt_csc_avx512* c, void* g, void* b,
+                                        void* r, struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w) {
+  uint8_t* be = (uint8_t*)pg;
+  /* each batch handle 32 pixels(16 pg groups) */
+  uint32_t batch = w / 32;
+  __m512i prev_cb = _mm512_setzero_si512();
+  __m512i prev_cr = _mm512_setzero_si512();
+
+  for (uint32_t i = 0; i < batch; i++) {
+    __m512i rgb[3];
+    cvt_csc_load_rgb(c, g, b, r, i * 32, rgb);
+
+    __m512i rg_lo = _mm512_unpacklo_epi16(rgb[0], rgb[1]);
+    __m512i rg_hi = _mm512_unpackhi_epi16(rgb[0], rgb[1]);
+    __m512i b1_lo = _mm512_unpacklo_epi16(rgb[2], c->c1024);
+    __m512i b1_hi = _mm512_unpackhi_epi16(rgb[2], c->c1024);
+    __m512i y = cvt_csc_row(c, c->to_y, rg_lo, rg_hi, b1_lo, b1_hi);
+    __m512i cb = cvt_csc_row(c, c->to_cb, rg_lo, rg_hi, b1_lo, b1_hi);
+    __m512i cr = cvt_csc_row(c, c->to_cr, rg_lo, rg_hi, b1_lo, b1_hi);
+
+    if (!i) { /* the line start replicate the first chroma as the left neighbor */
+      prev_cb = _mm512_broadcastw_epi16(_mm512_castsi512_si128(cb));
+      prev_cr = _mm512_broadcastw_epi16(_mm512_castsi512_si128(cr));
+    }
+    /* 16 filtered Cb then 16 filtered Cr of the even pixels */
+    __m512i uv = _mm512_permutex2var_epi16(cvt_csc_filter(c, prev_cb, cb), c->even_idx,
+                                           cvt_csc_filter(c, prev_cr, cr));
+    prev_cb = cb;
+    prev_cr = cr;
+
+    cvt_be10_pack_m512i(&c->b10, _mm512_permutex2var_epi16(uv, c->pg_idx[0], y), be);
+    cvt_be10_pack_m512i(&c->b10, _mm512_permutex2var_epi16(uv, c->pg_idx[1], y),
+                        be + 40);
+    be += 80;
+  }
+
+  cvt_csc_to_be10_tail(c, g, b, r, pg + batch * 16, batch * 32, w);
+}
+
+static int cvt_csc_to_be10_avx512(void* g, void* b, void* r,
+                                  struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                  uint32_t h, enum cvt_csc_layout layout,
+                                  const struct st_csc_coef* coef) {
+  struct cvt_csc_avx512 c;
+  uint32_t pg_per_line = w / 2;
+  size_t linesize = (layout == CVT_CSC_GBRP10LE) ? w * 2 : w * 3;
+  uint8_t* g0 = g;
+  uint8_t* b0 = b;
+  uint8_t* r0 = r;
+  dbg("%s, w %u h %u layout %d\n", __func__, w, h, layout);
+
+  cvt_csc_avx512_init(&c, layout, coef);
+  for (uint32_t line = 0; line < h; line++) {
+    cvt_csc_to_be10_line_avx512(&c, g0, b0, r0, pg, w);
+    pg += pg_per_line;
+    g0 += linesize;
+    if (b0) b0 += linesize;
+    if (r0) r0 += linesize;
+  }
+
+  return 0;
+}
+
+int st20_gbrp10le_to_rfc4175_422be10_avx512(uint16_t* g, uint16_t* b, uint16_t* r,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint32_t w, uint32_t h,
+                                            const struct st_csc_coef* coef) {
+  return cvt_csc_to_be10_avx512(g, b, r, pg, w, h, CVT_CSC_GBRP10LE, coef);
+}
+
+int st20_rgb8_to_rfc4175_422be10_avx512(uint8_t* rgb,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h,
+                                        const struct st_csc_coef* coef) {
+  return cvt_csc_to_be10_avx512(rgb, NULL, NULL, pg, w, h, CVT_CSC_RGB8, coef);
+}
+/* end st20_rgb_to_rfc4175_422be10_avx512 */
+
+/* begin st20_rfc4175_422be10_to_rgb_avx512 */
+static void cvt_be10_to_csc_line_avx512(struct cvt_csc_avx512* c,
+                                        struct st20_rfc4175_422_10_pg2_be* pg, void* g,
+                                        void* b, void* r, uint32_t w) {
+  uint8_t* be = (uint8_t*)pg;
+  /* each batch handle 16 pg groups(32 pixels) */
+  uint32_t batch = w / 32;
+  uint16_t cb_n, y_n0, cr_n, y_n1;
+
+  for (uint32_t i = 0; i < batch; i++) {
+    uint32_t x = i * 32;
+    /* {Cb0, Y0, Cr0, Y1, Cb1, Y2, Cr1, Y3, ...} */
+    __m512i lo = cvt_be10_unpack_m512i(&c->b10, be);
+    __m512i hi = cvt_be10_unpack_m512i(&c->b10, be + 40);
+    be += 80;
+    __m512i y = _mm512_permutex2var_epi16(lo, c->y_idx, hi);
+    __m512i uv = _mm512_permutex2var_epi16(lo, c->uv_idx, hi);
+
+    /* the odd pixels interpolate the chroma of the two neighbor pg groups */
+    __m512i next = _mm512_permutexvar_epi16(c->next_idx, uv);
+    if (x + 32 < w) { /* else replicate the last chroma at the line end */
+      st20_unpack_pg2be_422le10(pg + (i + 1) * 16, &cb_n, &y_n0, &cr_n, &y_n1);
+      next = _mm512_mask_set1_epi16(next, (__mmask32)1 << 15, cb_n);
+      next = _mm512_mask_set1_epi16(next, (__mmask32)1 << 31, cr_n);
+    }
+    __m512i odd = _mm512_avg_epu16(uv, next);
+    __m512i u = _mm512_sub_epi16(_mm512_permutex2var_epi16(uv, c->chroma_idx[0], odd),
+                                 c->c512);
+    __m512i v = _mm512_sub_epi16(_mm512_permutex2var_epi16(uv, c->chroma_idx[1], odd),
+                                 c->c512);
+    __m512i yy = _mm512_sub_epi16(y, c->y_off);
+
+    __m512i yv_lo = _mm512_unpacklo_epi16(yy, v);
+    __m512i yv_hi = _mm512_unpackhi_epi16(yy, v);
+    __m512i yu_lo = _mm512_unpacklo_epi16(yy, u);
+    __m512i yu_hi = _mm512_unpackhi_epi16(yy, u);
+    __m512i v1_lo = _mm512_unpacklo_epi16(v, c->c1024);
+    __m512i v1_hi = _mm512_unpackhi_epi16(v, c->c1024);
+    __m512i rgb[3];
+    rgb[0] = cvt_csc_pack(c,
+                          _mm512_add_epi32(_mm512_madd_epi16(yv_lo, c->to_r), c->round),
+                          _mm512_add_epi32(_mm512_madd_epi16(yv_hi, c->to_r), c->round));
+    rgb[1] = cvt_csc_pack(c,
+                          _mm512_add_epi32(_mm512_madd_epi16(yu_lo, c->to_g[0]),
+                                           _mm512_madd_epi16(v1_lo, c->to_g[1])),
+                          _mm512_add_epi32(_mm512_madd_epi16(yu_hi, c->to_g[0]),
+                                           _mm512_madd_epi16(v1_hi, c->to_g[1])));
+    rgb[2] = cvt_csc_pack(c,
+                          _mm512_add_epi32(_mm512_madd_epi16(yu_lo, c->to_b), c->round),
+                          _mm512_add_epi32(_mm512_madd_epi16(yu_hi, c->to_b), c->round));
+    cvt_csc_store_rgb(c, rgb, g, b, r, x);
+  }
+
+  cvt_be10_to_csc_tail(c, pg + batch * 16, g, b, r, batch * 32, w);
+}
+
+static int cvt_be10_to_csc_avx512(struct st20_rfc4175_422_10_pg2_be* pg, void* g,
+                                  void* b, void* r, uint32_t w, uint32_t h,
+                                  enum cvt_csc_layout layout,
+                                  const struct st_csc_coef* coef) {
+  struct cvt_csc_avx512 c;
+  uint32_t pg_per_line = w / 2;
+  size_t linesize = (layout == CVT_CSC_GBRP10LE) ? w * 2 : w * 3;
+  uint8_t* g0 = g;
+  uint8_t* b0 = b;
+  uint8_t* r0 = r;
+  dbg("%s, w %u h %u layout %d\n", __func__, w, h, layout);
+
+  cvt_csc_avx512_init(&c, layout, coef);
+  for (uint32_t line = 0; line < h; line++) {
+    cvt_be10_to_csc_line_avx512(&c, pg, g0, b0, r0, w);
+    pg += pg_per_line;
+    g0 += linesize;
+    if (b0) b0 += linesize;
+    if (r0) r0 += linesize;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_gbrp10le_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint16_t* g, uint16_t* b, uint16_t* r,
+                                            uint32_t w, uint32_t h,
+                                            const struct st_csc_coef* coef) {
+  return cvt_be10_to_csc_avx512(pg, g, b, r, w, h, CVT_CSC_GBRP10LE, coef);
+}
+
+int st20_rfc4175_422be10_to_rgb8_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint8_t* rgb, uint32_t w, uint32_t h,
+                                        const struct st_csc_coef* coef) {
+  return cvt_be10_to_csc_avx512(pg, rgb, NULL, NULL, w, h, CVT_CSC_RGB8, coef);
+}
+/* end st20_rfc4175_422be10_to_rgb_avx512 */
+
+/* begin st_scale_vertical_avx512 */
+void st_scale_vertical_avx512(const uint16_t** lines, const int16_t* coef, uint32_t taps,
+                              uint16_t* dst, uint32_t w) {
+  __m512i round = _mm512_set1_epi32(1 << (ST_SCALE_V_SHIFT - 1));
+  __m512i zero = _mm512_setzero_si512();
+  __m512i pairs[ST_SCALE_MAX_TAPS / 2];
+  uint32_t x = 0;
+
+  /* two lines in one madd, the last odd line pairs with a zero coef */
+  for (uint32_t k = 0; k < taps; k += 2) {
+    uint16_t c1 = ((k + 1) < taps) ? coef[k + 1] : 0;
+    pairs[k / 2] = _mm512_set1_epi32(((uint32_t)c1 << 16) | (uint16_t)coef[k]);
+  }
+
+  for (; (x + 32) <= w; x += 32) {
+    __m512i lo = round;
+    __m512i hi = round;
+    for (uint32_t k = 0; k < taps; k += 2) {
+      __m512i a = _mm512_loadu_si512(lines[k] + x);
+      __m512i b = ((k + 1) < taps) ? _mm512_loadu_si512(lines[k + 1] + x) : zero;
+      lo = _mm512_add_epi32(lo, _mm512_madd_epi16(_mm512_unpacklo_epi16(a, b),
+                                                  pairs[k / 2]));
+      hi = _mm512_add_epi32(hi, _mm512_madd_epi16(_mm512_unpackhi_epi16(a, b),
+                                                  pairs[k / 2]));
+    }
+    lo = _mm512_srai_epi32(lo, ST_SCALE_V_SHIFT);
+    hi = _mm512_srai_epi32(hi, ST_SCALE_V_SHIFT);
+    /* the unpack and pack are both in lane, the order keeps */
+    _mm512_storeu_si512(dst + x, _mm512_packus_epi32(lo, hi));
+  }
+
+  st_scale_vertical_scalar(lines, coef, taps, dst, x, w);
+}
+/* end st_scale_vertical_avx512 */
+
+/* begin st_scale_horizontal_avx512 */
+void st_scale_horizontal_avx512(const uint16_t* src, uint16_t* dst, uint32_t w,
+                                const uint32_t* start, const int16_t* coef,
+                                uint32_t taps) {
+  __m512i round = _mm512_set1_epi32(1 << (ST_SCALE_H_SHIFT - 1));
+  __m512i two = _mm512_set1_epi32(2);
+  uint32_t i = 0;
+
+  for (; (i + 16) <= w; i += 16) {
+    __m512i idx = _mm512_loadu_si512(start + i);
+    __m512i sum = round;
+    for (uint32_t k = 0; k < taps; k += 2) {
+      /* one dword gather get the two neighbour samples of the tap pair */
+      __m512i s = _mm512_i32gather_epi32(idx, src, 2);
+      __m512i c = _mm512_loadu_si512(coef + (k * w) + (i * 2));
+      sum = _mm512_add_epi32(sum, _mm512_madd_epi16(s, c));
+      idx = _mm512_add_epi32(idx, two);
+    }
+    sum = _mm512_srai_epi32(sum, ST_SCALE_H_SHIFT);
+    _mm256_storeu_si256((__m256i*)(dst + i), _mm512_cvtusepi32_epi16(sum));
+  }
+
+  st_scale_horizontal_scalar(src, dst, i, w, start, coef, taps);
+}
+/* end st_scale_horizontal_avx512 */
 MT_TARGET_CODE_STOP
 #endif
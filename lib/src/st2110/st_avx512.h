@@ -111,4 +111,107 @@ int st20_rfc4175_422be12_to_yuv422p12le_avx512_dma(
     struct mtl_dma_lender_dev* dma, struct st20_rfc4175_422_12_pg2_be* pg_be,
     mtl_iova_t pg_be_iova, uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w, uint32_t h);
 
+
+int st20_rfc4175_444be10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_444p10le_avx512_dma(struct mtl_dma_lender_dev* dma,
+                                                struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                                mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                                uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                                uint32_t h);
+
+int st20_444p10le_to_rfc4175_444be10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444p12le_avx512_dma(struct mtl_dma_lender_dev* dma,
+                                                struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                                mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                                uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                                uint32_t h);
+
+int st20_444p12le_to_rfc4175_444be12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_12_pg2_be* pg,
+                                               uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le12_to_422be12_avx512(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                           struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                           uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le12_to_422be12_avx512_dma(struct mtl_dma_lender_dev* dma,
+                                               struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                               mtl_iova_t pg_le_iova,
+                                               struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                               uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_yuv420p10le_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint16_t* y, uint16_t* b, uint16_t* r,
+                                               uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_yuv420p8_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint8_t* y, uint8_t* b, uint8_t* r,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_nv12_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint8_t* y, uint8_t* uv, uint32_t w,
+                                        uint32_t h);
+
+int st20_rfc4175_422be10_to_p010_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint16_t* y, uint16_t* uv, uint32_t w,
+                                        uint32_t h);
+
+int st20_yuv420p10le_to_rfc4175_422be10_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h);
+
+int st20_yuv420p8_to_rfc4175_422be10_avx512(uint8_t* y, uint8_t* b, uint8_t* r,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_nv12_to_rfc4175_422be10_avx512(uint8_t* y, uint8_t* uv,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h);
+
+int st20_p010_to_rfc4175_422be10_avx512(uint16_t* y, uint16_t* uv,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h);
+
+int st20_gbrp10le_to_rfc4175_422be10_avx512(uint16_t* g, uint16_t* b, uint16_t* r,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint32_t w, uint32_t h,
+                                            const struct st_csc_coef* coef);
+
+int st20_rgb8_to_rfc4175_422be10_avx512(uint8_t* rgb,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h,
+                                        const struct st_csc_coef* coef);
+
+int st20_rfc4175_422be10_to_gbrp10le_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint16_t* g, uint16_t* b, uint16_t* r,
+                                            uint32_t w, uint32_t h,
+                                            const struct st_csc_coef* coef);
+
+int st20_rfc4175_422be10_to_rgb8_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint8_t* rgb, uint32_t w, uint32_t h,
+                                        const struct st_csc_coef* coef);
+
+/* the vertical filter of one output line, see st_scale_vertical_scalar */
+void st_scale_vertical_avx512(const uint16_t** lines, const int16_t* coef, uint32_t taps,
+                              uint16_t* dst, uint32_t w);
+
+/* the horizontal filter of one line, see st_scale_horizontal_scalar */
+void st_scale_horizontal_avx512(const uint16_t* src, uint16_t* dst, uint32_t w,
+                                const uint32_t* start, const int16_t* coef,
+                                uint32_t taps);
+
 #endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "st_convert.h"
 
 #include "../mt_log.h"
+#include "../mt_stat.h"
 #include "st_main.h"
 
 #ifdef MTL_HAS_AVX2
@@ -427,6 +428,547 @@ static int convert_gbrp12le_to_rfc4175_444be12(struct st_frame* src,
   return ret;
 }
 
+static int cvt_420_check_height(struct st_frame* frame) {
+  /* each two lines share one chroma line */
+  if (frame->height % 2) {
+    err("%s, odd height %u for fmt %s\n", __func__, frame->height,
+        st_frame_fmt_name(frame->fmt));
+    return -EINVAL;
+  }
+  return 0;
+}
+
+/* one line pair of the rfc4175_422be10, the chroma of the two lines averaged */
+static void rfc4175_422be10_to_yuv420p10le_line2(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                                 struct st20_rfc4175_422_10_pg2_be* pg1,
+                                                 uint16_t* y0, uint16_t* y1, uint16_t* b,
+                                                 uint16_t* r, uint32_t w) {
+  uint16_t cb0, cr0, cb1, cr1;
+
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    st20_unpack_pg2be_422le10(pg0++, &cb0, y0, &cr0, y0 + 1);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, y1, &cr1, y1 + 1);
+    *b++ = (cb0 + cb1 + 1) >> 1;
+    *r++ = (cr0 + cr1 + 1) >> 1;
+    y0 += 2;
+    y1 += 2;
+  }
+}
+
+static void rfc4175_422be10_to_yuv420p8_line2(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                              struct st20_rfc4175_422_10_pg2_be* pg1,
+                                              uint8_t* y0, uint8_t* y1, uint8_t* b,
+                                              uint8_t* r, uint32_t w) {
+  uint16_t cb0, y00, cr0, y01, cb1, y10, cr1, y11;
+
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    st20_unpack_pg2be_422le10(pg0++, &cb0, &y00, &cr0, &y01);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, &y10, &cr1, &y11);
+    *y0++ = y00 >> 2;
+    *y0++ = y01 >> 2;
+    *y1++ = y10 >> 2;
+    *y1++ = y11 >> 2;
+    *b++ = ((cb0 + cb1 + 1) >> 1) >> 2;
+    *r++ = ((cr0 + cr1 + 1) >> 1) >> 2;
+  }
+}
+
+static void rfc4175_422be10_to_nv12_line2(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                          struct st20_rfc4175_422_10_pg2_be* pg1,
+                                          uint8_t* y0, uint8_t* y1, uint8_t* uv,
+                                          uint32_t w) {
+  uint16_t cb0, y00, cr0, y01, cb1, y10, cr1, y11;
+
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    st20_unpack_pg2be_422le10(pg0++, &cb0, &y00, &cr0, &y01);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, &y10, &cr1, &y11);
+    *y0++ = y00 >> 2;
+    *y0++ = y01 >> 2;
+    *y1++ = y10 >> 2;
+    *y1++ = y11 >> 2;
+    *uv++ = ((cb0 + cb1 + 1) >> 1) >> 2;
+    *uv++ = ((cr0 + cr1 + 1) >> 1) >> 2;
+  }
+}
+
+static void rfc4175_422be10_to_p010_line2(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                          struct st20_rfc4175_422_10_pg2_be* pg1,
+                                          uint16_t* y0, uint16_t* y1, uint16_t* uv,
+                                          uint32_t w) {
+  uint16_t cb0, y00, cr0, y01, cb1, y10, cr1, y11;
+
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    st20_unpack_pg2be_422le10(pg0++, &cb0, &y00, &cr0, &y01);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, &y10, &cr1, &y11);
+    *y0++ = y00 << 6;
+    *y0++ = y01 << 6;
+    *y1++ = y10 << 6;
+    *y1++ = y11 << 6;
+    *uv++ = ((cb0 + cb1 + 1) >> 1) << 6;
+    *uv++ = ((cr0 + cr1 + 1) >> 1) << 6;
+  }
+}
+
+/* one line pair to the rfc4175_422be10, the chroma line duplicated to the two lines */
+static void yuv420p10le_to_rfc4175_422be10_line2(uint16_t* y0, uint16_t* y1,
+                                                 uint16_t* b, uint16_t* r,
+                                                 struct st20_rfc4175_422_10_pg2_be* pg0,
+                                                 struct st20_rfc4175_422_10_pg2_be* pg1,
+                                                 uint32_t w) {
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    st20_pack_422le10_pg2be(*b, y0[0], *r, y0[1], pg0++);
+    st20_pack_422le10_pg2be(*b, y1[0], *r, y1[1], pg1++);
+    b++;
+    r++;
+    y0 += 2;
+    y1 += 2;
+  }
+}
+
+static void yuv420p8_to_rfc4175_422be10_line2(uint8_t* y0, uint8_t* y1, uint8_t* b,
+                                              uint8_t* r,
+                                              struct st20_rfc4175_422_10_pg2_be* pg0,
+                                              struct st20_rfc4175_422_10_pg2_be* pg1,
+                                              uint32_t w) {
+  uint16_t cb, cr;
+
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    cb = *b++ << 2;
+    cr = *r++ << 2;
+    st20_pack_422le10_pg2be(cb, y0[0] << 2, cr, y0[1] << 2, pg0++);
+    st20_pack_422le10_pg2be(cb, y1[0] << 2, cr, y1[1] << 2, pg1++);
+    y0 += 2;
+    y1 += 2;
+  }
+}
+
+static void nv12_to_rfc4175_422be10_line2(uint8_t* y0, uint8_t* y1, uint8_t* uv,
+                                          struct st20_rfc4175_422_10_pg2_be* pg0,
+                                          struct st20_rfc4175_422_10_pg2_be* pg1,
+                                          uint32_t w) {
+  uint16_t cb, cr;
+
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    cb = *uv++ << 2;
+    cr = *uv++ << 2;
+    st20_pack_422le10_pg2be(cb, y0[0] << 2, cr, y0[1] << 2, pg0++);
+    st20_pack_422le10_pg2be(cb, y1[0] << 2, cr, y1[1] << 2, pg1++);
+    y0 += 2;
+    y1 += 2;
+  }
+}
+
+static void p010_to_rfc4175_422be10_line2(uint16_t* y0, uint16_t* y1, uint16_t* uv,
+                                          struct st20_rfc4175_422_10_pg2_be* pg0,
+                                          struct st20_rfc4175_422_10_pg2_be* pg1,
+                                          uint32_t w) {
+  uint16_t cb, cr;
+
+  for (uint32_t pg2 = 0; pg2 < w / 2; pg2++) {
+    cb = *uv++ >> 6;
+    cr = *uv++ >> 6;
+    st20_pack_422le10_pg2be(cb, y0[0] >> 6, cr, y0[1] >> 6, pg0++);
+    st20_pack_422le10_pg2be(cb, y1[0] >> 6, cr, y1[1] >> 6, pg1++);
+    y0 += 2;
+    y1 += 2;
+  }
+}
+
+static int convert_rfc4175_422be10_to_yuv420p10le(struct st_frame* src,
+                                                  struct st_frame* dst) {
+  int ret = cvt_420_check_height(dst);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint16_t* y = NULL;
+  uint16_t* b = NULL;
+  uint16_t* r = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    y = dst->addr[0];
+    b = dst->addr[1];
+    r = dst->addr[2];
+    ret = st20_rfc4175_422be10_to_yuv420p10le(be10, y, b, r, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      y = dst->addr[0] + dst->linesize[0] * line;
+      b = dst->addr[1] + dst->linesize[1] * (line / 2);
+      r = dst->addr[2] + dst->linesize[2] * (line / 2);
+      rfc4175_422be10_to_yuv420p10le_line2(
+          be10, (void*)be10 + src->linesize[0], y, (void*)y + dst->linesize[0], b, r,
+          dst->width);
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_yuv420p8(struct st_frame* src,
+                                               struct st_frame* dst) {
+  int ret = cvt_420_check_height(dst);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* y = NULL;
+  uint8_t* b = NULL;
+  uint8_t* r = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    y = dst->addr[0];
+    b = dst->addr[1];
+    r = dst->addr[2];
+    ret = st20_rfc4175_422be10_to_yuv420p8(be10, y, b, r, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      y = dst->addr[0] + dst->linesize[0] * line;
+      b = dst->addr[1] + dst->linesize[1] * (line / 2);
+      r = dst->addr[2] + dst->linesize[2] * (line / 2);
+      rfc4175_422be10_to_yuv420p8_line2(be10, (void*)be10 + src->linesize[0], y,
+                                        y + dst->linesize[0], b, r, dst->width);
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_nv12(struct st_frame* src, struct st_frame* dst) {
+  int ret = cvt_420_check_height(dst);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* y = NULL;
+  uint8_t* uv = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    y = dst->addr[0];
+    uv = dst->addr[1];
+    ret = st20_rfc4175_422be10_to_nv12(be10, y, uv, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      y = dst->addr[0] + dst->linesize[0] * line;
+      uv = dst->addr[1] + dst->linesize[1] * (line / 2);
+      rfc4175_422be10_to_nv12_line2(be10, (void*)be10 + src->linesize[0], y,
+                                    y + dst->linesize[0], uv, dst->width);
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_p010(struct st_frame* src, struct st_frame* dst) {
+  int ret = cvt_420_check_height(dst);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint16_t* y = NULL;
+  uint16_t* uv = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    y = dst->addr[0];
+    uv = dst->addr[1];
+    ret = st20_rfc4175_422be10_to_p010(be10, y, uv, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      y = dst->addr[0] + dst->linesize[0] * line;
+      uv = dst->addr[1] + dst->linesize[1] * (line / 2);
+      rfc4175_422be10_to_p010_line2(be10, (void*)be10 + src->linesize[0], y,
+                                    (void*)y + dst->linesize[0], uv, dst->width);
+    }
+  }
+  return ret;
+}
+
+static int convert_yuv420p10le_to_rfc4175_422be10(struct st_frame* src,
+                                                  struct st_frame* dst) {
+  int ret = cvt_420_check_height(src);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint16_t* y = NULL;
+  uint16_t* b = NULL;
+  uint16_t* r = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    y = src->addr[0];
+    b = src->addr[1];
+    r = src->addr[2];
+    be10 = dst->addr[0];
+    ret = st20_yuv420p10le_to_rfc4175_422be10(y, b, r, be10, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      y = src->addr[0] + src->linesize[0] * line;
+      b = src->addr[1] + src->linesize[1] * (line / 2);
+      r = src->addr[2] + src->linesize[2] * (line / 2);
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      yuv420p10le_to_rfc4175_422be10_line2(y, (void*)y + src->linesize[0], b, r, be10,
+                                           (void*)be10 + dst->linesize[0], dst->width);
+    }
+  }
+  return ret;
+}
+
+static int convert_yuv420p8_to_rfc4175_422be10(struct st_frame* src,
+                                               struct st_frame* dst) {
+  int ret = cvt_420_check_height(src);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* y = NULL;
+  uint8_t* b = NULL;
+  uint8_t* r = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    y = src->addr[0];
+    b = src->addr[1];
+    r = src->addr[2];
+    be10 = dst->addr[0];
+    ret = st20_yuv420p8_to_rfc4175_422be10(y, b, r, be10, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      y = src->addr[0] + src->linesize[0] * line;
+      b = src->addr[1] + src->linesize[1] * (line / 2);
+      r = src->addr[2] + src->linesize[2] * (line / 2);
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      yuv420p8_to_rfc4175_422be10_line2(y, y + src->linesize[0], b, r, be10,
+                                        (void*)be10 + dst->linesize[0], dst->width);
+    }
+  }
+  return ret;
+}
+
+static int convert_nv12_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+  int ret = cvt_420_check_height(src);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* y = NULL;
+  uint8_t* uv = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    y = src->addr[0];
+    uv = src->addr[1];
+    be10 = dst->addr[0];
+    ret = st20_nv12_to_rfc4175_422be10(y, uv, be10, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      y = src->addr[0] + src->linesize[0] * line;
+      uv = src->addr[1] + src->linesize[1] * (line / 2);
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      nv12_to_rfc4175_422be10_line2(y, y + src->linesize[0], uv, be10,
+                                    (void*)be10 + dst->linesize[0], dst->width);
+    }
+  }
+  return ret;
+}
+
+static int convert_p010_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+  int ret = cvt_420_check_height(src);
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint16_t* y = NULL;
+  uint16_t* uv = NULL;
+  if (ret < 0) return ret;
+  if (!has_lines_padding(src, dst)) {
+    y = src->addr[0];
+    uv = src->addr[1];
+    be10 = dst->addr[0];
+    ret = st20_p010_to_rfc4175_422be10(y, uv, be10, dst->width, dst->height);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line += 2) {
+      y = src->addr[0] + src->linesize[0] * line;
+      uv = src->addr[1] + src->linesize[1] * (line / 2);
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      p010_to_rfc4175_422be10_line2(y, (void*)y + src->linesize[0], uv, be10,
+                                    (void*)be10 + dst->linesize[0], dst->width);
+    }
+  }
+  return ret;
+}
+
+static void gbrp10le_to_rfc4175_422be10_line(const struct st_csc_coef* coef, uint16_t* g,
+                                             uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint32_t w) {
+  uint16_t y[2], cb[3], cr[3];
+
+  /* cb[0]/cr[0] is the left neighbor, the line start replicate the first pixel */
+  st_csc_rgb_to_yuv10(coef, r[0], g[0], b[0], &y[0], &cb[0], &cr[0]);
+  for (uint32_t x = 0; x < w; x += 2) {
+    for (int i = 0; i < 2; i++) {
+      st_csc_rgb_to_yuv10(coef, r[x + i], g[x + i], b[x + i], &y[i], &cb[i + 1],
+                          &cr[i + 1]);
+    }
+    st20_pack_422le10_pg2be(st_csc_chroma_filter(cb[0], cb[1], cb[2]), y[0],
+                            st_csc_chroma_filter(cr[0], cr[1], cr[2]), y[1], pg++);
+    cb[0] = cb[2];
+    cr[0] = cr[2];
+  }
+}
+
+static void rgb8_to_rfc4175_422be10_line(const struct st_csc_coef* coef, uint8_t* rgb,
+                                         struct st20_rfc4175_422_10_pg2_be* pg,
+                                         uint32_t w) {
+  uint16_t y[2], cb[3], cr[3];
+  uint8_t* p;
+
+  st_csc_rgb_to_yuv10(coef, st_csc_8_to_10(rgb[0]), st_csc_8_to_10(rgb[1]),
+                      st_csc_8_to_10(rgb[2]), &y[0], &cb[0], &cr[0]);
+  for (uint32_t x = 0; x < w; x += 2) {
+    for (int i = 0; i < 2; i++) {
+      p = rgb + (x + i) * 3;
+      st_csc_rgb_to_yuv10(coef, st_csc_8_to_10(p[0]), st_csc_8_to_10(p[1]),
+                          st_csc_8_to_10(p[2]), &y[i], &cb[i + 1], &cr[i + 1]);
+    }
+    st20_pack_422le10_pg2be(st_csc_chroma_filter(cb[0], cb[1], cb[2]), y[0],
+                            st_csc_chroma_filter(cr[0], cr[1], cr[2]), y[1], pg++);
+    cb[0] = cb[2];
+    cr[0] = cr[2];
+  }
+}
+
+/* the odd pixels interpolate the chroma of the two neighbor pg groups */
+static void rfc4175_422be10_to_gbrp10le_line(const struct st_csc_coef* coef,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* g, uint16_t* b, uint16_t* r,
+                                             uint32_t w) {
+  uint16_t cb, y0, cr, y1;
+  uint16_t cb1, y2 = 0, cr1, y3 = 0;
+
+  st20_unpack_pg2be_422le10(pg, &cb, &y0, &cr, &y1);
+  for (uint32_t x = 0; x < w; x += 2) {
+    if (x + 2 < w) {
+      st20_unpack_pg2be_422le10(pg + 1, &cb1, &y2, &cr1, &y3);
+    } else { /* replicate the last chroma at the line end */
+      cb1 = cb;
+      cr1 = cr;
+    }
+    st_csc_yuv_to_rgb10(coef, y0, cb, cr, &r[x], &g[x], &b[x]);
+    st_csc_yuv_to_rgb10(coef, y1, (cb + cb1 + 1) >> 1, (cr + cr1 + 1) >> 1, &r[x + 1],
+                        &g[x + 1], &b[x + 1]);
+    pg++;
+    cb = cb1;
+    cr = cr1;
+    y0 = y2;
+    y1 = y3;
+  }
+}
+
+static void rfc4175_422be10_to_rgb8_line(const struct st_csc_coef* coef,
+                                         struct st20_rfc4175_422_10_pg2_be* pg,
+                                         uint8_t* rgb, uint32_t w) {
+  uint16_t cb, y0, cr, y1;
+  uint16_t cb1, y2 = 0, cr1, y3 = 0;
+  uint16_t p[3];
+
+  st20_unpack_pg2be_422le10(pg, &cb, &y0, &cr, &y1);
+  for (uint32_t x = 0; x < w; x += 2) {
+    if (x + 2 < w) {
+      st20_unpack_pg2be_422le10(pg + 1, &cb1, &y2, &cr1, &y3);
+    } else {
+      cb1 = cb;
+      cr1 = cr;
+    }
+    st_csc_yuv_to_rgb10(coef, y0, cb, cr, &p[0], &p[1], &p[2]);
+    for (int i = 0; i < 3; i++) *rgb++ = st_csc_10_to_8(p[i]);
+    st_csc_yuv_to_rgb10(coef, y1, (cb + cb1 + 1) >> 1, (cr + cr1 + 1) >> 1, &p[0],
+                        &p[1], &p[2]);
+    for (int i = 0; i < 3; i++) *rgb++ = st_csc_10_to_8(p[i]);
+    pg++;
+    cb = cb1;
+    cr = cr1;
+    y0 = y2;
+    y1 = y3;
+  }
+}
+
+static int convert_gbrp10le_to_rfc4175_422be10(struct st_frame* src,
+                                               struct st_frame* dst) {
+  int ret = 0;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint16_t* g = NULL;
+  uint16_t* b = NULL;
+  uint16_t* r = NULL;
+  if (!has_lines_padding(src, dst)) {
+    g = src->addr[0];
+    b = src->addr[1];
+    r = src->addr[2];
+    be10 = dst->addr[0];
+    ret = st20_gbrp10le_to_rfc4175_422be10(g, b, r, be10, dst->width, dst->height,
+                                           dst->colorimetry, dst->range);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line++) {
+      g = src->addr[0] + src->linesize[0] * line;
+      b = src->addr[1] + src->linesize[1] * line;
+      r = src->addr[2] + src->linesize[2] * line;
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_gbrp10le_to_rfc4175_422be10(g, b, r, be10, dst->width, 1,
+                                             dst->colorimetry, dst->range);
+      if (ret < 0) break;
+    }
+  }
+  return ret;
+}
+
+static int convert_rgb8_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+  int ret = 0;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* rgb = NULL;
+  if (!has_lines_padding(src, dst)) {
+    rgb = src->addr[0];
+    be10 = dst->addr[0];
+    ret = st20_rgb8_to_rfc4175_422be10(rgb, be10, dst->width, dst->height,
+                                       dst->colorimetry, dst->range);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line++) {
+      rgb = src->addr[0] + src->linesize[0] * line;
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_rgb8_to_rfc4175_422be10(rgb, be10, dst->width, 1, dst->colorimetry,
+                                         dst->range);
+      if (ret < 0) break;
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_gbrp10le(struct st_frame* src,
+                                               struct st_frame* dst) {
+  int ret = 0;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint16_t* g = NULL;
+  uint16_t* b = NULL;
+  uint16_t* r = NULL;
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    g = dst->addr[0];
+    b = dst->addr[1];
+    r = dst->addr[2];
+    ret = st20_rfc4175_422be10_to_gbrp10le(be10, g, b, r, dst->width, dst->height,
+                                           src->colorimetry, src->range);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line++) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      g = dst->addr[0] + dst->linesize[0] * line;
+      b = dst->addr[1] + dst->linesize[1] * line;
+      r = dst->addr[2] + dst->linesize[2] * line;
+      ret = st20_rfc4175_422be10_to_gbrp10le(be10, g, b, r, dst->width, 1,
+                                             src->colorimetry, src->range);
+      if (ret < 0) break;
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_rgb8(struct st_frame* src, struct st_frame* dst) {
+  int ret = 0;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* rgb = NULL;
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    rgb = dst->addr[0];
+    ret = st20_rfc4175_422be10_to_rgb8(be10, rgb, dst->width, dst->height,
+                                       src->colorimetry, src->range);
+  } else {
+    for (uint32_t line = 0; line < dst->height; line++) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      rgb = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_rfc4175_422be10_to_rgb8(be10, rgb, dst->width, 1, src->colorimetry,
+                                         src->range);
+      if (ret < 0) break;
+    }
+  }
+  return ret;
+}
+
 static const struct st_frame_converter converters[] = {
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
@@ -473,6 +1015,36 @@ static const struct st_frame_converter converters[] = {
         .dst_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
         .convert_func = convert_rfc4175_444be12_to_gbrp12le,
     },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_YUV420PLANAR10LE,
+        .convert_func = convert_rfc4175_422be10_to_yuv420p10le,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_YUV420PLANAR8,
+        .convert_func = convert_rfc4175_422be10_to_yuv420p8,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_NV12,
+        .convert_func = convert_rfc4175_422be10_to_nv12,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_P010,
+        .convert_func = convert_rfc4175_422be10_to_p010,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
+        .convert_func = convert_rfc4175_422be10_to_gbrp10le,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_RGB8,
+        .convert_func = convert_rfc4175_422be10_to_rgb8,
+    },
     {
         .src_fmt = ST_FRAME_FMT_YUV422PLANAR10LE,
         .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
@@ -513,6 +1085,36 @@ static const struct st_frame_converter converters[] = {
         .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
         .convert_func = convert_gbrp12le_to_rfc4175_444be12,
     },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV420PLANAR10LE,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_yuv420p10le_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV420PLANAR8,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_yuv420p8_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_NV12,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_nv12_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_P010,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_p010_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_gbrp10le_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGB8,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_rgb8_to_rfc4175_422be10,
+    },
 };
 
 int st_frame_convert(struct st_frame* src, struct st_frame* dst) {
@@ -543,6 +1145,270 @@ int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
   return -EINVAL;
 }
 
+/* each line start at the pg/byte boundary, the frame can split at any line */
+static bool cvt_fmt_can_slice(enum st_frame_fmt fmt, uint32_t width, uint32_t height) {
+  size_t line_size = st_frame_size(fmt, width, 1, false);
+
+  if (!line_size) return false;
+  return st_frame_size(fmt, width, height, false) == (line_size * height);
+}
+
+static void cvt_frame_slice(struct st_frame* frame, uint32_t line, uint32_t lines,
+                            struct st_frame* slice) {
+  uint8_t planes = st_frame_fmt_planes(frame->fmt);
+  size_t linesize, offset;
+
+  *slice = *frame;
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    linesize = frame->linesize[plane];
+    if (!linesize) linesize = st_frame_least_linesize(frame->fmt, frame->width, plane);
+    /* the chroma planes of 420 advance half lines, the slice lines always even */
+    offset = linesize * st_frame_plane_height(frame->fmt, line, plane);
+    slice->addr[plane] = (uint8_t*)frame->addr[plane] + offset;
+    if (frame->iova[plane]) slice->iova[plane] = frame->iova[plane] + offset;
+  }
+  slice->height = lines;
+}
+
+/* claim and convert the slices until all claimed, return the number it converted */
+static int cvt_pool_job_run(struct st_cvt_pool_job* job) {
+  struct st_frame src, dst;
+  uint32_t idx, line, lines;
+  int slices = 0;
+  int ret;
+
+  while (1) {
+    idx = rte_atomic32_add_return(&job->slice_idx, 1) - 1;
+    if (idx >= job->slices) break;
+
+    line = idx * job->slice_lines;
+    lines = RTE_MIN(job->slice_lines, job->dst->height - line);
+    cvt_frame_slice(job->src, line, lines, &src);
+    cvt_frame_slice(job->dst, line, lines, &dst);
+    ret = job->converter->convert_func(&src, &dst);
+    if (ret < 0) {
+      err("%s, convert slice %u fail %d\n", __func__, idx, ret);
+      rte_atomic32_inc(&job->fail_cnt);
+    }
+    slices++;
+  }
+
+  return slices;
+}
+
+static void* cvt_pool_thread(void* arg) {
+  struct st_cvt_pool_impl* pool = arg;
+  struct st_cvt_pool_job* job;
+  int slices;
+
+#ifndef WINDOWSENV
+  if (numa_available() >= 0) numa_run_on_node(pool->socket_id);
+#endif
+
+  dbg("%s, start\n", __func__);
+  mt_pthread_mutex_lock(&pool->mutex);
+  while (rte_atomic32_read(&pool->stop_thread) == 0) {
+    job = MT_TAILQ_FIRST(&pool->jobs);
+    if (!job) {
+      mt_pthread_cond_wait(&pool->wake_cond, &pool->mutex);
+      continue;
+    }
+    job->workers++;
+    mt_pthread_mutex_unlock(&pool->mutex);
+
+    slices = cvt_pool_job_run(job);
+    rte_atomic32_add(&pool->stat_worker_slices, slices);
+
+    mt_pthread_mutex_lock(&pool->mutex);
+    /* all slices claimed, the next worker go to the next job */
+    if (job->queued) {
+      MT_TAILQ_REMOVE(&pool->jobs, job, next);
+      job->queued = false;
+    }
+    job->workers--;
+    /* the callers share the done cond */
+    if (!job->workers) mt_pthread_cond_broadcast(&pool->done_cond);
+  }
+  mt_pthread_mutex_unlock(&pool->mutex);
+  dbg("%s, stop\n", __func__);
+
+  return NULL;
+}
+
+static int cvt_pool_convert(struct st_cvt_pool_impl* pool,
+                            const struct st_frame_converter* converter,
+                            struct st_frame* src, struct st_frame* dst, uint32_t slices,
+                            uint32_t slice_lines) {
+  struct st_cvt_pool_job job;
+
+  memset(&job, 0, sizeof(job));
+  job.converter = converter;
+  job.src = src;
+  job.dst = dst;
+  job.slices = slices;
+  job.slice_lines = slice_lines;
+  rte_atomic32_set(&job.slice_idx, 0);
+  rte_atomic32_set(&job.fail_cnt, 0);
+
+  /* queue the job, the workers serve the concurrent callers in order */
+  mt_pthread_mutex_lock(&pool->mutex);
+  MT_TAILQ_INSERT_TAIL(&pool->jobs, &job, next);
+  job.queued = true;
+  mt_pthread_cond_broadcast(&pool->wake_cond);
+  mt_pthread_mutex_unlock(&pool->mutex);
+
+  /* the caller also take the slices of its own job */
+  cvt_pool_job_run(&job);
+
+  /* all slices claimed, wait the workers still on the job */
+  mt_pthread_mutex_lock(&pool->mutex);
+  if (job.queued) {
+    MT_TAILQ_REMOVE(&pool->jobs, &job, next);
+    job.queued = false;
+  }
+  while (job.workers) mt_pthread_cond_wait(&pool->done_cond, &pool->mutex);
+  mt_pthread_mutex_unlock(&pool->mutex);
+
+  rte_atomic32_inc(&pool->stat_frames);
+  rte_atomic32_add(&pool->stat_slices, slices);
+  if (rte_atomic32_read(&job.fail_cnt)) return -EIO;
+  return 0;
+}
+
+int st_frame_convert_slices(struct mtl_main_impl* impl,
+                            const struct st_frame_converter* converter,
+                            struct st_frame* src, struct st_frame* dst) {
+  struct st_cvt_pool_impl* pool = impl->cvt_pool;
+  uint32_t height = dst->height;
+  uint32_t slices, slice_lines;
+
+  if (!pool) return converter->convert_func(src, dst);
+  if (!cvt_fmt_can_slice(src->fmt, src->width, height) ||
+      !cvt_fmt_can_slice(dst->fmt, dst->width, height))
+    return converter->convert_func(src, dst);
+
+  /* one slice for each worker and the caller */
+  slices = pool->threads_nb + 1;
+  slice_lines = RTE_ALIGN_CEIL((height + slices - 1) / slices, 2);
+  if (slice_lines < ST_CVT_POOL_SLICE_MIN_LINES)
+    slice_lines = ST_CVT_POOL_SLICE_MIN_LINES;
+  slices = (height + slice_lines - 1) / slice_lines;
+  if (slices < 2) return converter->convert_func(src, dst);
+
+  return cvt_pool_convert(pool, converter, src, dst, slices, slice_lines);
+}
+
+int st_frame_convert_parallel(mtl_handle mt, struct st_frame* src, struct st_frame* dst) {
+  struct mtl_main_impl* impl = mt;
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return -EIO;
+  }
+  if (src->width != dst->width || src->height != dst->height) {
+    err("%s, width/height mismatch, source: %u x %u, dest: %u x %u\n", __func__,
+        src->width, src->height, dst->width, dst->height);
+    return -EINVAL;
+  }
+  struct st_frame_converter converter;
+  if (st_frame_get_converter(src->fmt, dst->fmt, &converter) < 0) {
+    err("%s, get converter fail\n", __func__);
+    return -EINVAL;
+  }
+  return st_frame_convert_slices(impl, &converter, src, dst);
+}
+
+static int cvt_pool_stat(void* priv) {
+  struct st_cvt_pool_impl* pool = priv;
+  int frames = rte_atomic32_read(&pool->stat_frames);
+  int slices = rte_atomic32_read(&pool->stat_slices);
+  int worker_slices = rte_atomic32_read(&pool->stat_worker_slices);
+
+  rte_atomic32_set(&pool->stat_frames, 0);
+  rte_atomic32_set(&pool->stat_slices, 0);
+  rte_atomic32_set(&pool->stat_worker_slices, 0);
+  if (!frames) return 0;
+
+  notice("CVT_POOL: frames %d, slices %d, by workers %d\n", frames, slices,
+         worker_slices);
+  return 0;
+}
+
+static int cvt_pool_threads_stop(struct st_cvt_pool_impl* pool) {
+  rte_atomic32_set(&pool->stop_thread, 1);
+  mt_pthread_mutex_lock(&pool->mutex);
+  mt_pthread_cond_broadcast(&pool->wake_cond);
+  mt_pthread_mutex_unlock(&pool->mutex);
+
+  for (int i = 0; i < pool->threads_nb; i++) {
+    if (pool->tids[i]) {
+      pthread_join(pool->tids[i], NULL);
+      pool->tids[i] = 0;
+    }
+  }
+
+  return 0;
+}
+
+int st_cvt_pool_init(struct mtl_main_impl* impl) {
+  int threads_nb = mt_get_user_params(impl)->cvt_threads;
+  int socket = mt_socket_id(impl, MTL_PORT_P);
+  struct st_cvt_pool_impl* pool;
+  int ret;
+
+  if (!threads_nb) return 0;
+  if (threads_nb > ST_CVT_POOL_THREADS_MAX) {
+    warn("%s, cvt_threads %d limit to %d\n", __func__, threads_nb,
+         ST_CVT_POOL_THREADS_MAX);
+    threads_nb = ST_CVT_POOL_THREADS_MAX;
+  }
+
+  pool = mt_rte_zmalloc_socket(sizeof(*pool), socket);
+  if (!pool) {
+    err("%s, pool malloc fail\n", __func__);
+    return -ENOMEM;
+  }
+  pool->parent = impl;
+  pool->socket_id = socket;
+  mt_pthread_mutex_init(&pool->mutex, NULL);
+  mt_pthread_cond_init(&pool->wake_cond, NULL);
+  mt_pthread_cond_init(&pool->done_cond, NULL);
+  MT_TAILQ_INIT(&pool->jobs);
+  rte_atomic32_set(&pool->stop_thread, 0);
+
+  for (int i = 0; i < threads_nb; i++) {
+    ret = pthread_create(&pool->tids[i], NULL, cvt_pool_thread, pool);
+    if (ret) {
+      err("%s(%d), thread create fail %d\n", __func__, i, ret);
+      cvt_pool_threads_stop(pool);
+      mt_rte_free(pool);
+      return -EIO;
+    }
+    pool->threads_nb++;
+  }
+
+  impl->cvt_pool = pool;
+  mt_stat_register(impl, cvt_pool_stat, pool, "cvt_pool");
+  info("%s, %d threads on socket %d\n", __func__, threads_nb, socket);
+  return 0;
+}
+
+int st_cvt_pool_uinit(struct mtl_main_impl* impl) {
+  struct st_cvt_pool_impl* pool = impl->cvt_pool;
+
+  if (!pool) return 0;
+
+  mt_stat_unregister(impl, cvt_pool_stat, pool);
+  cvt_pool_threads_stop(pool);
+  mt_pthread_cond_destroy(&pool->wake_cond);
+  mt_pthread_cond_destroy(&pool->done_cond);
+  mt_pthread_mutex_destroy(&pool->mutex);
+
+  mt_rte_free(pool);
+  impl->cvt_pool = NULL;
+  return 0;
+}
+
 static int downsample_rfc4175_wh_half(struct st_frame* old_frame,
                                       struct st_frame* new_frame, int idx) {
   enum mtl_simd_level cpu_level = mtl_get_simd_level();
@@ -619,6 +1485,437 @@ int st_frame_downsample(struct st_frame* src, struct st_frame* dst, int idx) {
   return -EINVAL;
 }
 
+enum scale_kind {
+  SCALE_KIND_PLANAR16, /* the 10/12 bits planar, filter on the frame lines directly */
+  SCALE_KIND_PLANAR8,  /* the 8 bits planar, widen/narrow with 16 bits lines */
+  SCALE_KIND_PG2BE10,  /* rfc4175_422be10, unpack/pack with yuv422p10le lines */
+  SCALE_KIND_MAX,
+};
+
+struct scale_filter {
+  uint32_t dst_len;
+  uint32_t taps;
+  uint32_t* start; /* the first src sample of each output */
+  int16_t* coef;   /* ST_SCALE_SHIFT fixed point weights */
+};
+
+struct scale_plane {
+  uint32_t src_w;
+  uint32_t src_h;
+  uint32_t dst_w;
+  uint32_t dst_h;
+  uint8_t h_sub; /* 1 for the 420 chroma planes */
+  struct scale_filter hf;
+  struct scale_filter vf;
+  /* the ring of the 16 bits src lines, slot = line % vf.taps */
+  uint16_t* ring[ST_SCALE_MAX_TAPS];
+  int32_t ring_line[ST_SCALE_MAX_TAPS];
+  const uint16_t* lines[ST_SCALE_MAX_TAPS];
+  uint16_t* v_out; /* src_w samples after the vertical filter */
+  uint16_t* h_out; /* dst_w samples after the horizontal filter */
+};
+
+struct st_frame_scaler {
+  enum st_frame_fmt fmt;
+  enum scale_kind kind;
+  enum mtl_simd_level level;
+  uint32_t src_w;
+  uint32_t src_h;
+  uint32_t dst_w;
+  uint32_t dst_h;
+  uint8_t planes;
+  struct scale_plane plane[3];
+};
+
+/* the gather of the horizontal filter may read one dword over the line end */
+#define SCALE_LINE_PAD (32)
+
+static enum scale_kind scale_fmt_kind(enum st_frame_fmt fmt) {
+  switch (fmt) {
+    case ST_FRAME_FMT_YUV422PLANAR10LE:
+    case ST_FRAME_FMT_YUV422PLANAR12LE:
+    case ST_FRAME_FMT_YUV444PLANAR10LE:
+    case ST_FRAME_FMT_YUV444PLANAR12LE:
+    case ST_FRAME_FMT_GBRPLANAR10LE:
+    case ST_FRAME_FMT_GBRPLANAR12LE:
+    case ST_FRAME_FMT_YUV420PLANAR10LE:
+      return SCALE_KIND_PLANAR16;
+    case ST_FRAME_FMT_YUV422PLANAR8:
+    case ST_FRAME_FMT_YUV420PLANAR8:
+      return SCALE_KIND_PLANAR8;
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE10:
+      return SCALE_KIND_PG2BE10;
+    default:
+      return SCALE_KIND_MAX;
+  }
+}
+
+static void scale_filter_uinit(struct scale_filter* f) {
+  if (f->start) {
+    mt_free(f->start);
+    f->start = NULL;
+  }
+  if (f->coef) {
+    mt_free(f->coef);
+    f->coef = NULL;
+  }
+}
+
+/*
+ * Area filter for downscale, each output is the average of the src samples it covers.
+ * Bilinear filter for upscale, with the pixel centers aligned.
+ * The horizontal coefs are stored in tap pairs to feed the madd of the simd ways, see
+ * st_scale_horizontal_scalar, the vertical coefs are the taps of each output line.
+ */
+static int scale_filter_init(struct scale_filter* f, uint32_t src_len, uint32_t dst_len,
+                             bool horizontal) {
+  int32_t weight[ST_SCALE_MAX_TAPS];
+  uint32_t span, taps;
+
+  if (src_len > dst_len)
+    span = (src_len + dst_len - 1) / dst_len + 1;
+  else
+    span = 2;
+  if (span > src_len) span = src_len;
+  /* the padded tap has zero weight and reads the line pad */
+  taps = horizontal ? MTL_ALIGN(span, 2) : span;
+
+  f->dst_len = dst_len;
+  f->taps = taps;
+  f->start = mt_zmalloc(sizeof(*f->start) * dst_len);
+  f->coef = mt_zmalloc(sizeof(*f->coef) * dst_len * taps);
+  if (!f->start || !f->coef) {
+    err("%s, filter malloc fail, taps %u dst_len %u\n", __func__, taps, dst_len);
+    scale_filter_uinit(f);
+    return -ENOMEM;
+  }
+
+  for (uint32_t i = 0; i < dst_len; i++) {
+    uint32_t start, max_k = 0;
+    int32_t sum = 0;
+
+    memset(weight, 0, sizeof(weight));
+    if (src_len > dst_len) {
+      /* the output covers [lo, hi) in units of 1 / dst_len src sample */
+      uint64_t lo = (uint64_t)i * src_len;
+      uint64_t hi = lo + src_len;
+      uint32_t first = lo / dst_len;
+
+      start = first;
+      if ((start + span) > src_len) start = src_len - span;
+      for (uint32_t j = first; ((uint64_t)j * dst_len) < hi; j++) {
+        uint64_t s = RTE_MAX(lo, (uint64_t)j * dst_len);
+        uint64_t e = RTE_MIN(hi, (uint64_t)(j + 1) * dst_len);
+        weight[j - start] =
+            (((e - s) << ST_SCALE_SHIFT) + src_len / 2) / src_len; /* round */
+      }
+    } else if (src_len < 2) {
+      start = 0;
+      weight[0] = 1 << ST_SCALE_SHIFT;
+    } else {
+      /* the src position of the output center */
+      int64_t pos = ((int64_t)(2 * i + 1) * src_len - dst_len) * (1 << ST_SCALE_SHIFT);
+      uint32_t frac;
+
+      pos /= (int64_t)dst_len * 2;
+      if (pos < 0) pos = 0;
+      start = pos >> ST_SCALE_SHIFT;
+      frac = pos & ((1 << ST_SCALE_SHIFT) - 1);
+      if (start >= (src_len - 1)) { /* the right edge */
+        start = src_len - 2;
+        frac = 1 << ST_SCALE_SHIFT;
+      }
+      weight[0] = (1 << ST_SCALE_SHIFT) - frac;
+      weight[1] = frac;
+    }
+
+    /* the sum should be exact 1, put the rounding error to the biggest tap */
+    for (uint32_t k = 0; k < taps; k++) {
+      sum += weight[k];
+      if (weight[k] > weight[max_k]) max_k = k;
+    }
+    weight[max_k] += (1 << ST_SCALE_SHIFT) - sum;
+
+    f->start[i] = start;
+    for (uint32_t k = 0; k < taps; k++) {
+      if (horizontal)
+        f->coef[((k >> 1) * dst_len + i) * 2 + (k & 1)] = weight[k];
+      else
+        f->coef[i * taps + k] = weight[k];
+    }
+  }
+
+  return 0;
+}
+
+static void scale_vertical(struct st_frame_scaler* scaler, struct scale_plane* plane,
+                           uint32_t line, uint16_t* dst) {
+  const int16_t* coef = plane->vf.coef + line * plane->vf.taps;
+  enum mtl_simd_level level = scaler->level;
+
+  MT_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX512
+  if (level >= MTL_SIMD_LEVEL_AVX512) {
+    st_scale_vertical_avx512(plane->lines, coef, plane->vf.taps, dst, plane->src_w);
+    return;
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (level >= MTL_SIMD_LEVEL_AVX2) {
+    st_scale_vertical_avx2(plane->lines, coef, plane->vf.taps, dst, plane->src_w);
+    return;
+  }
+#endif
+
+  /* the last option */
+  st_scale_vertical_scalar(plane->lines, coef, plane->vf.taps, dst, 0, plane->src_w);
+}
+
+static void scale_horizontal(struct st_frame_scaler* scaler, struct scale_plane* plane,
+                             uint16_t* dst) {
+  struct scale_filter* f = &plane->hf;
+  enum mtl_simd_level level = scaler->level;
+
+  MT_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX512
+  if (level >= MTL_SIMD_LEVEL_AVX512) {
+    st_scale_horizontal_avx512(plane->v_out, dst, f->dst_len, f->start, f->coef,
+                               f->taps);
+    return;
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (level >= MTL_SIMD_LEVEL_AVX2) {
+    st_scale_horizontal_avx2(plane->v_out, dst, f->dst_len, f->start, f->coef, f->taps);
+    return;
+  }
+#endif
+
+  /* the last option */
+  st_scale_horizontal_scalar(plane->v_out, dst, 0, f->dst_len, f->start, f->coef,
+                             f->taps);
+}
+
+static inline uint8_t* scale_frame_line(struct st_frame* frame, uint8_t plane,
+                                        uint32_t line) {
+  size_t linesize = frame->linesize[plane];
+
+  if (!linesize) linesize = st_frame_least_linesize(frame->fmt, frame->width, plane);
+  return (uint8_t*)frame->addr[plane] + linesize * line;
+}
+
+/* get the 16 bits src line of the plane, unpack to the ring if not a planar16 fmt */
+static const uint16_t* scale_src_line(struct st_frame_scaler* scaler,
+                                      struct st_frame* src, uint8_t p, uint32_t line) {
+  struct scale_plane* plane = &scaler->plane[p];
+  uint32_t slot = line % plane->vf.taps;
+  uint16_t* ring = plane->ring[slot];
+
+  if (scaler->kind == SCALE_KIND_PLANAR16)
+    return (const uint16_t*)scale_frame_line(src, p, line);
+  if (plane->ring_line[slot] == (int32_t)line) return ring;
+
+  if (scaler->kind == SCALE_KIND_PLANAR8) {
+    uint8_t* s = scale_frame_line(src, p, line);
+    for (uint32_t x = 0; x < plane->src_w; x++) ring[x] = s[x];
+    plane->ring_line[slot] = line;
+  } else {
+    /* all planes of the pg line unpack to the same slot */
+    st20_rfc4175_422be10_to_yuv422p10le_simd(
+        (struct st20_rfc4175_422_10_pg2_be*)scale_frame_line(src, 0, line),
+        scaler->plane[0].ring[slot], scaler->plane[1].ring[slot],
+        scaler->plane[2].ring[slot], scaler->src_w, 1, scaler->level);
+    for (uint8_t i = 0; i < 3; i++) scaler->plane[i].ring_line[slot] = line;
+  }
+  return ring;
+}
+
+int st_frame_scaler_free(struct st_frame_scaler* scaler) {
+  for (uint8_t p = 0; p < 3; p++) {
+    struct scale_plane* plane = &scaler->plane[p];
+
+    scale_filter_uinit(&plane->hf);
+    scale_filter_uinit(&plane->vf);
+    for (uint32_t k = 0; k < ST_SCALE_MAX_TAPS; k++) {
+      if (plane->ring[k]) mt_free(plane->ring[k]);
+    }
+    if (plane->v_out) mt_free(plane->v_out);
+    if (plane->h_out) mt_free(plane->h_out);
+  }
+  mt_free(scaler);
+  return 0;
+}
+
+struct st_frame_scaler* st_frame_scaler_create(enum st_frame_fmt fmt, uint32_t src_w,
+                                               uint32_t src_h, uint32_t dst_w,
+                                               uint32_t dst_h,
+                                               enum mtl_simd_level level) {
+  enum scale_kind kind = scale_fmt_kind(fmt);
+  enum st_frame_sampling sampling = st_frame_fmt_get_sampling(fmt);
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  struct st_frame_scaler* scaler;
+  int ret;
+
+  if (kind == SCALE_KIND_MAX) {
+    err("%s, fmt %s not supported\n", __func__, st_frame_fmt_name(fmt));
+    return NULL;
+  }
+  if (!src_w || !src_h || !dst_w || !dst_h) {
+    err("%s, invalid size %ux%u to %ux%u\n", __func__, src_w, src_h, dst_w, dst_h);
+    return NULL;
+  }
+  if (src_w > dst_w * ST_SCALE_MAX_RATIO || src_h > dst_h * ST_SCALE_MAX_RATIO) {
+    err("%s, %ux%u to %ux%u over the max ratio %d\n", __func__, src_w, src_h, dst_w,
+        dst_h, ST_SCALE_MAX_RATIO);
+    return NULL;
+  }
+  if (sampling != ST_FRAME_SAMPLING_444 && ((src_w | dst_w) & 1)) {
+    err("%s, the width %u %u should be even for %s\n", __func__, src_w, dst_w,
+        st_frame_fmt_name(fmt));
+    return NULL;
+  }
+  if (sampling == ST_FRAME_SAMPLING_420 && ((src_h | dst_h) & 1)) {
+    err("%s, the height %u %u should be even for %s\n", __func__, src_h, dst_h,
+        st_frame_fmt_name(fmt));
+    return NULL;
+  }
+
+  scaler = mt_zmalloc(sizeof(*scaler));
+  if (!scaler) {
+    err("%s, scaler malloc fail\n", __func__);
+    return NULL;
+  }
+  scaler->fmt = fmt;
+  scaler->kind = kind;
+  scaler->level = RTE_MIN(level, cpu_level);
+  scaler->src_w = src_w;
+  scaler->src_h = src_h;
+  scaler->dst_w = dst_w;
+  scaler->dst_h = dst_h;
+  scaler->planes = 3; /* rfc4175_422be10 filters on the three unpacked planes */
+
+  for (uint8_t p = 0; p < scaler->planes; p++) {
+    struct scale_plane* plane = &scaler->plane[p];
+    bool chroma = (p > 0) && (sampling != ST_FRAME_SAMPLING_444);
+
+    plane->h_sub = (p > 0) && (sampling == ST_FRAME_SAMPLING_420);
+    plane->src_w = chroma ? src_w / 2 : src_w;
+    plane->dst_w = chroma ? dst_w / 2 : dst_w;
+    plane->src_h = src_h >> plane->h_sub;
+    plane->dst_h = dst_h >> plane->h_sub;
+
+    ret = scale_filter_init(&plane->hf, plane->src_w, plane->dst_w, true);
+    if (ret < 0) goto fail;
+    ret = scale_filter_init(&plane->vf, plane->src_h, plane->dst_h, false);
+    if (ret < 0) goto fail;
+
+    plane->v_out = mt_zmalloc(sizeof(uint16_t) * (plane->src_w + SCALE_LINE_PAD));
+    plane->h_out = mt_zmalloc(sizeof(uint16_t) * (plane->dst_w + SCALE_LINE_PAD));
+    if (!plane->v_out || !plane->h_out) goto fail;
+    if (kind != SCALE_KIND_PLANAR16) {
+      for (uint32_t k = 0; k < plane->vf.taps; k++) {
+        plane->ring[k] = mt_zmalloc(sizeof(uint16_t) * (plane->src_w + SCALE_LINE_PAD));
+        if (!plane->ring[k]) goto fail;
+      }
+    }
+  }
+
+  dbg("%s, %s %ux%u to %ux%u, taps h %u v %u, simd level %s\n", __func__,
+      st_frame_fmt_name(fmt), src_w, src_h, dst_w, dst_h, scaler->plane[0].hf.taps,
+      scaler->plane[0].vf.taps, mtl_get_simd_level_name(scaler->level));
+  return scaler;
+
+fail:
+  err("%s, %s %ux%u to %ux%u init fail\n", __func__, st_frame_fmt_name(fmt), src_w,
+      src_h, dst_w, dst_h);
+  st_frame_scaler_free(scaler);
+  return NULL;
+}
+
+int st_frame_scaler_run(struct st_frame_scaler* scaler, struct st_frame* src,
+                        struct st_frame* dst) {
+  if (src->fmt != scaler->fmt || dst->fmt != scaler->fmt) {
+    err("%s, fmt mismatch, source: %s, dest: %s, scaler: %s\n", __func__,
+        st_frame_fmt_name(src->fmt), st_frame_fmt_name(dst->fmt),
+        st_frame_fmt_name(scaler->fmt));
+    return -EINVAL;
+  }
+  if (src->width != scaler->src_w || src->height != scaler->src_h ||
+      dst->width != scaler->dst_w || dst->height != scaler->dst_h) {
+    err("%s, size mismatch, source: %ux%u, dest: %ux%u, scaler: %ux%u to %ux%u\n",
+        __func__, src->width, src->height, dst->width, dst->height, scaler->src_w,
+        scaler->src_h, scaler->dst_w, scaler->dst_h);
+    return -EINVAL;
+  }
+
+  /* the ring lines of the last frame are stale */
+  for (uint8_t p = 0; p < scaler->planes; p++) {
+    for (uint32_t k = 0; k < ST_SCALE_MAX_TAPS; k++) scaler->plane[p].ring_line[k] = -1;
+  }
+
+  for (uint32_t y = 0; y < scaler->dst_h; y++) {
+    for (uint8_t p = 0; p < scaler->planes; p++) {
+      struct scale_plane* plane = &scaler->plane[p];
+      uint32_t line = y >> plane->h_sub;
+      uint32_t start;
+      uint16_t* out;
+
+      if (y & plane->h_sub) continue; /* the 420 chroma has half lines */
+      start = plane->vf.start[line];
+      for (uint32_t k = 0; k < plane->vf.taps; k++)
+        plane->lines[k] = scale_src_line(scaler, src, p, start + k);
+      scale_vertical(scaler, plane, line, plane->v_out);
+
+      if (scaler->kind == SCALE_KIND_PLANAR16)
+        out = (uint16_t*)scale_frame_line(dst, p, line);
+      else
+        out = plane->h_out;
+      scale_horizontal(scaler, plane, out);
+
+      if (scaler->kind == SCALE_KIND_PLANAR8) {
+        uint8_t* d = scale_frame_line(dst, p, line);
+        for (uint32_t x = 0; x < plane->dst_w; x++) d[x] = out[x];
+      }
+    }
+
+    if (scaler->kind == SCALE_KIND_PG2BE10) {
+      st20_yuv422p10le_to_rfc4175_422be10_simd(
+          scaler->plane[0].h_out, scaler->plane[1].h_out, scaler->plane[2].h_out,
+          (struct st20_rfc4175_422_10_pg2_be*)scale_frame_line(dst, 0, y), scaler->dst_w,
+          1, scaler->level);
+    }
+  }
+
+  return 0;
+}
+
+int st_frame_scale_simd(struct st_frame* src, struct st_frame* dst,
+                        enum mtl_simd_level level) {
+  struct st_frame_scaler* scaler;
+  int ret;
+
+  if (src->fmt != dst->fmt) {
+    err("%s, fmt mismatch, source: %s, dest: %s\n", __func__,
+        st_frame_fmt_name(src->fmt), st_frame_fmt_name(dst->fmt));
+    return -EINVAL;
+  }
+
+  scaler = st_frame_scaler_create(src->fmt, src->width, src->height, dst->width,
+                                  dst->height, level);
+  if (!scaler) return -EINVAL;
+  ret = st_frame_scaler_run(scaler, src, dst);
+  st_frame_scaler_free(scaler);
+  return ret;
+}
+
+int st_frame_scale(struct st_frame* src, struct st_frame* dst) {
+  return st_frame_scale_simd(src, dst, MTL_SIMD_LEVEL_MAX);
+}
+
 static int st20_yuv422p10le_to_rfc4175_422be10_scalar(
     uint16_t* y, uint16_t* b, uint16_t* r, struct st20_rfc4175_422_10_pg2_be* pg,
     uint32_t w, uint32_t h) {
@@ -1618,7 +2915,31 @@ int st20_yuv422p12le_to_rfc4175_422be12_simd(uint16_t* y, uint16_t* b, uint16_t*
                                              struct st20_rfc4175_422_12_pg2_be* pg,
                                              uint32_t w, uint32_t h,
                                              enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422be12_avx512(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422be12_avx2(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_yuv422p12le_to_rfc4175_422be12_scalar(y, b, r, pg, w, h);
 }
 
@@ -1863,14 +3184,65 @@ int st20_rfc4175_422le12_to_422be12_simd(struct st20_rfc4175_422_12_pg2_le* pg_l
                                          struct st20_rfc4175_422_12_pg2_be* pg_be,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_422be12_avx512(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_422be12_avx2(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_422le12_to_422be12_scalar(pg_le, pg_be, w, h);
 }
 
-static int st20_444p10le_to_rfc4175_444be10_scalar(uint16_t* y_g, uint16_t* b_r,
-                                                   uint16_t* r_b,
-                                                   struct st20_rfc4175_444_10_pg4_be* pg,
-                                                   uint32_t w, uint32_t h) {
+int st20_rfc4175_422le12_to_422be12_simd_dma(mtl_udma_handle udma,
+                                             struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                             mtl_iova_t pg_le_iova,
+                                             struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level) {
+  struct mtl_dma_lender_dev* dma = udma;
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+  MT_MAY_UNUSED(dma);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_422be12_avx512_dma(dma, pg_le, pg_le_iova, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422le12_to_422be12_scalar(pg_le, pg_be, w, h);
+}
+
+static int st20_444p10le_to_rfc4175_444be10_scalar(uint16_t* y_g, uint16_t* b_r,
+                                                   uint16_t* r_b,
+                                                   struct st20_rfc4175_444_10_pg4_be* pg,
+                                                   uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 4; /* four pgs in one convert */
   uint16_t cb_r0, y_g0, cr_b0, cb_r1, y_g1, cr_b1, cb_r2, y_g2, cr_b2, cb_r3, y_g3, cr_b3;
 
@@ -1923,7 +3295,31 @@ int st20_444p10le_to_rfc4175_444be10_simd(uint16_t* y_g, uint16_t* b_r, uint16_t
                                           struct st20_rfc4175_444_10_pg4_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444be10_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444be10_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_444p10le_to_rfc4175_444be10_scalar(y_g, b_r, r_b, pg, w, h);
 }
 
@@ -1970,10 +3366,61 @@ int st20_rfc4175_444be10_to_444p10le_simd(struct st20_rfc4175_444_10_pg4_be* pg,
                                           uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444be10_to_444p10le_scalar(pg, y_g, b_r, r_b, w, h);
 }
 
+int st20_rfc4175_444be10_to_444p10le_simd_dma(mtl_udma_handle udma,
+                                              struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                              mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                              uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                              uint32_t h, enum mtl_simd_level level) {
+  struct mtl_dma_lender_dev* dma = udma;
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+  MT_MAY_UNUSED(dma);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx512_dma(dma, pg_be, pg_be_iova, y_g, b_r,
+                                                      r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_444be10_to_444p10le_scalar(pg_be, y_g, b_r, r_b, w, h);
+}
+
 int st20_444p10le_to_rfc4175_444le10(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                      struct st20_rfc4175_444_10_pg4_le* pg, uint32_t w,
                                      uint32_t h) {
@@ -2119,8 +3566,24 @@ int st20_rfc4175_444be10_to_444le10_simd(struct st20_rfc4175_444_10_pg4_be* pg_b
                                          struct st20_rfc4175_444_10_pg4_le* pg_le,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
-  return st20_rfc4175_444be10_to_444le10_scalar(pg_be, pg_le, w, h);
+  /* one 444 10bit pg4 has the same 10bit stream as three 422 10bit pg2 */
+  uint32_t pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422be10_to_422le10_simd((struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                              (struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                              pg2_cnt * 2, 1, level);
+}
+
+int st20_rfc4175_444be10_to_444le10_simd_dma(mtl_udma_handle udma,
+                                             struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                             mtl_iova_t pg_be_iova,
+                                             struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level) {
+  /* one 444 10bit pg4 has the same 10bit stream as three 422 10bit pg2 */
+  uint32_t pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422be10_to_422le10_simd_dma(
+      udma, (struct st20_rfc4175_422_10_pg2_be*)pg_be, pg_be_iova,
+      (struct st20_rfc4175_422_10_pg2_le*)pg_le, pg2_cnt * 2, 1, level);
 }
 
 int st20_rfc4175_444le10_to_444be10_scalar(struct st20_rfc4175_444_10_pg4_le* pg_le,
@@ -2179,8 +3642,11 @@ int st20_rfc4175_444le10_to_444be10_simd(struct st20_rfc4175_444_10_pg4_le* pg_l
                                          struct st20_rfc4175_444_10_pg4_be* pg_be,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
-  return st20_rfc4175_444le10_to_444be10_scalar(pg_le, pg_be, w, h);
+  /* one 444 10bit pg4 has the same 10bit stream as three 422 10bit pg2 */
+  uint32_t pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422le10_to_422be10_simd((struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                              (struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                              pg2_cnt * 2, 1, level);
 }
 
 static int st20_444p12le_to_rfc4175_444be12_scalar(uint16_t* y_g, uint16_t* b_r,
@@ -2221,7 +3687,31 @@ int st20_444p12le_to_rfc4175_444be12_simd(uint16_t* y_g, uint16_t* b_r, uint16_t
                                           struct st20_rfc4175_444_12_pg2_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444be12_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444be12_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_444p12le_to_rfc4175_444be12_scalar(y_g, b_r, r_b, pg, w, h);
 }
 
@@ -2256,10 +3746,61 @@ int st20_rfc4175_444be12_to_444p12le_simd(struct st20_rfc4175_444_12_pg2_be* pg,
                                           uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444be12_to_444p12le_scalar(pg, y_g, b_r, r_b, w, h);
 }
 
+int st20_rfc4175_444be12_to_444p12le_simd_dma(mtl_udma_handle udma,
+                                              struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                              mtl_iova_t pg_be_iova, uint16_t* y_g,
+                                              uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                              uint32_t h, enum mtl_simd_level level) {
+  struct mtl_dma_lender_dev* dma = udma;
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+  MT_MAY_UNUSED(dma);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx512_dma(dma, pg_be, pg_be_iova, y_g, b_r,
+                                                      r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_444be12_to_444p12le_scalar(pg_be, y_g, b_r, r_b, w, h);
+}
+
 int st20_444p12le_to_rfc4175_444le12(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                      struct st20_rfc4175_444_12_pg2_le* pg, uint32_t w,
                                      uint32_t h) {
@@ -2357,8 +3898,40 @@ int st20_rfc4175_444be12_to_444le12_simd(struct st20_rfc4175_444_12_pg2_be* pg_b
                                          struct st20_rfc4175_444_12_pg2_le* pg_le,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
-  return st20_rfc4175_444be12_to_444le12_scalar(pg_be, pg_le, w, h);
+  /* two 444 12bit pg2 have the same 12bit stream as three 422 12bit pg2 */
+  uint32_t pg_cnt = w * h / 2;
+  uint32_t pg2_cnt = pg_cnt / 2 * 3;
+  int ret;
+
+  ret = st20_rfc4175_422be12_to_422le12_simd((struct st20_rfc4175_422_12_pg2_be*)pg_be,
+                                             (struct st20_rfc4175_422_12_pg2_le*)pg_le,
+                                             pg2_cnt * 2, 1, level);
+  if (ret < 0) return ret;
+  if (pg_cnt % 2) /* the last odd pg */
+    return st20_rfc4175_444be12_to_444le12_scalar(pg_be + pg_cnt - 1, pg_le + pg_cnt - 1,
+                                                  2, 1);
+  return 0;
+}
+
+int st20_rfc4175_444be12_to_444le12_simd_dma(mtl_udma_handle udma,
+                                             struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                             mtl_iova_t pg_be_iova,
+                                             struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level) {
+  /* two 444 12bit pg2 have the same 12bit stream as three 422 12bit pg2 */
+  uint32_t pg_cnt = w * h / 2;
+  uint32_t pg2_cnt = pg_cnt / 2 * 3;
+  int ret;
+
+  ret = st20_rfc4175_422be12_to_422le12_simd_dma(
+      udma, (struct st20_rfc4175_422_12_pg2_be*)pg_be, pg_be_iova,
+      (struct st20_rfc4175_422_12_pg2_le*)pg_le, pg2_cnt * 2, 1, level);
+  if (ret < 0) return ret;
+  if (pg_cnt % 2) /* the last odd pg */
+    return st20_rfc4175_444be12_to_444le12_scalar(pg_be + pg_cnt - 1, pg_le + pg_cnt - 1,
+                                                  2, 1);
+  return 0;
 }
 
 int st20_rfc4175_444le12_to_444be12_scalar(struct st20_rfc4175_444_12_pg2_le* pg_le,
@@ -2399,8 +3972,525 @@ int st20_rfc4175_444le12_to_444be12_simd(struct st20_rfc4175_444_12_pg2_le* pg_l
                                          struct st20_rfc4175_444_12_pg2_be* pg_be,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
-  return st20_rfc4175_444le12_to_444be12_scalar(pg_le, pg_be, w, h);
+  /* two 444 12bit pg2 have the same 12bit stream as three 422 12bit pg2 */
+  uint32_t pg_cnt = w * h / 2;
+  uint32_t pg2_cnt = pg_cnt / 2 * 3;
+  int ret;
+
+  ret = st20_rfc4175_422le12_to_422be12_simd((struct st20_rfc4175_422_12_pg2_le*)pg_le,
+                                             (struct st20_rfc4175_422_12_pg2_be*)pg_be,
+                                             pg2_cnt * 2, 1, level);
+  if (ret < 0) return ret;
+  if (pg_cnt % 2) /* the last odd pg */
+    return st20_rfc4175_444le12_to_444be12_scalar(pg_le + pg_cnt - 1, pg_be + pg_cnt - 1,
+                                                  2, 1);
+  return 0;
+}
+
+static int st20_rfc4175_422be10_to_yuv420p10le_scalar(
+    struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y, uint16_t* b, uint16_t* r,
+    uint32_t w, uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    rfc4175_422be10_to_yuv420p10le_line2(pg, pg + pg_per_line, y, y + w, b, r, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    b += w / 2;
+    r += w / 2;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_yuv420p10le_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_yuv420p10le_avx512(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_yuv420p10le_scalar(pg, y, b, r, w, h);
+}
+
+static int st20_rfc4175_422be10_to_yuv420p8_scalar(struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint8_t* y, uint8_t* b, uint8_t* r,
+                                                   uint32_t w, uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    rfc4175_422be10_to_yuv420p8_line2(pg, pg + pg_per_line, y, y + w, b, r, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    b += w / 2;
+    r += w / 2;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_yuv420p8_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint8_t* y, uint8_t* b, uint8_t* r, uint32_t w,
+                                          uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_yuv420p8_avx512(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_yuv420p8_scalar(pg, y, b, r, w, h);
+}
+
+static int st20_rfc4175_422be10_to_nv12_scalar(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint8_t* y, uint8_t* uv, uint32_t w,
+                                               uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    rfc4175_422be10_to_nv12_line2(pg, pg + pg_per_line, y, y + w, uv, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    uv += w;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_nv12_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* y,
+                                      uint8_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_nv12_avx512(pg, y, uv, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_nv12_scalar(pg, y, uv, w, h);
+}
+
+static int st20_rfc4175_422be10_to_p010_scalar(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint16_t* y, uint16_t* uv, uint32_t w,
+                                               uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    rfc4175_422be10_to_p010_line2(pg, pg + pg_per_line, y, y + w, uv, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    uv += w;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_p010_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y,
+                                      uint16_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_p010_avx512(pg, y, uv, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_p010_scalar(pg, y, uv, w, h);
+}
+
+static int st20_yuv420p10le_to_rfc4175_422be10_scalar(
+    uint16_t* y, uint16_t* b, uint16_t* r, struct st20_rfc4175_422_10_pg2_be* pg,
+    uint32_t w, uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    yuv420p10le_to_rfc4175_422be10_line2(y, y + w, b, r, pg, pg + pg_per_line, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    b += w / 2;
+    r += w / 2;
+  }
+
+  return 0;
+}
+
+int st20_yuv420p10le_to_rfc4175_422be10_simd(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_yuv420p10le_to_rfc4175_422be10_avx512(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_yuv420p10le_to_rfc4175_422be10_scalar(y, b, r, pg, w, h);
+}
+
+static int st20_yuv420p8_to_rfc4175_422be10_scalar(uint8_t* y, uint8_t* b, uint8_t* r,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint32_t w, uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    yuv420p8_to_rfc4175_422be10_line2(y, y + w, b, r, pg, pg + pg_per_line, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    b += w / 2;
+    r += w / 2;
+  }
+
+  return 0;
+}
+
+int st20_yuv420p8_to_rfc4175_422be10_simd(uint8_t* y, uint8_t* b, uint8_t* r,
+                                          struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint32_t w, uint32_t h,
+                                          enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_yuv420p8_to_rfc4175_422be10_avx512(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_yuv420p8_to_rfc4175_422be10_scalar(y, b, r, pg, w, h);
+}
+
+static int st20_nv12_to_rfc4175_422be10_scalar(uint8_t* y, uint8_t* uv,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    nv12_to_rfc4175_422be10_line2(y, y + w, uv, pg, pg + pg_per_line, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    uv += w;
+  }
+
+  return 0;
+}
+
+int st20_nv12_to_rfc4175_422be10_simd(uint8_t* y, uint8_t* uv,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_nv12_to_rfc4175_422be10_avx512(y, uv, pg, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_nv12_to_rfc4175_422be10_scalar(y, uv, pg, w, h);
+}
+
+static int st20_p010_to_rfc4175_422be10_scalar(uint16_t* y, uint16_t* uv,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h) {
+  uint32_t pg_per_line = w / 2;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    p010_to_rfc4175_422be10_line2(y, y + w, uv, pg, pg + pg_per_line, w);
+    pg += pg_per_line * 2;
+    y += w * 2;
+    uv += w;
+  }
+
+  return 0;
+}
+
+int st20_p010_to_rfc4175_422be10_simd(uint16_t* y, uint16_t* uv,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+  if (h % 2) {
+    err("%s, odd height %u, each two lines share one chroma line\n", __func__, h);
+    return -EINVAL;
+  }
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_p010_to_rfc4175_422be10_avx512(y, uv, pg, w, h);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_p010_to_rfc4175_422be10_scalar(y, uv, pg, w, h);
+}
+
+static int st20_gbrp10le_to_rfc4175_422be10_scalar(uint16_t* g, uint16_t* b, uint16_t* r,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint32_t w, uint32_t h,
+                                                   const struct st_csc_coef* coef) {
+  for (uint32_t line = 0; line < h; line++) {
+    gbrp10le_to_rfc4175_422be10_line(coef, g, b, r, pg, w);
+    g += w;
+    b += w;
+    r += w;
+    pg += w / 2;
+  }
+
+  return 0;
+}
+
+int st20_gbrp10le_to_rfc4175_422be10_simd(uint16_t* g, uint16_t* b, uint16_t* r,
+                                          struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint32_t w, uint32_t h,
+                                          enum st20_colorimetry colorimetry,
+                                          enum st20_range range,
+                                          enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  struct st_csc_coef coef;
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+
+  ret = st_csc_coef_init(&coef, colorimetry, range);
+  if (ret < 0) return ret;
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_gbrp10le_to_rfc4175_422be10_avx512(g, b, r, pg, w, h, &coef);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_gbrp10le_to_rfc4175_422be10_scalar(g, b, r, pg, w, h, &coef);
+}
+
+static int st20_rgb8_to_rfc4175_422be10_scalar(uint8_t* rgb,
+                                               struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint32_t w, uint32_t h,
+                                               const struct st_csc_coef* coef) {
+  for (uint32_t line = 0; line < h; line++) {
+    rgb8_to_rfc4175_422be10_line(coef, rgb, pg, w);
+    rgb += w * 3;
+    pg += w / 2;
+  }
+
+  return 0;
+}
+
+int st20_rgb8_to_rfc4175_422be10_simd(uint8_t* rgb, struct st20_rfc4175_422_10_pg2_be* pg,
+                                      uint32_t w, uint32_t h,
+                                      enum st20_colorimetry colorimetry,
+                                      enum st20_range range, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  struct st_csc_coef coef;
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+
+  ret = st_csc_coef_init(&coef, colorimetry, range);
+  if (ret < 0) return ret;
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rgb8_to_rfc4175_422be10_avx512(rgb, pg, w, h, &coef);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_rgb8_to_rfc4175_422be10_scalar(rgb, pg, w, h, &coef);
+}
+
+static int st20_rfc4175_422be10_to_gbrp10le_scalar(struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint16_t* g, uint16_t* b, uint16_t* r,
+                                                   uint32_t w, uint32_t h,
+                                                   const struct st_csc_coef* coef) {
+  for (uint32_t line = 0; line < h; line++) {
+    rfc4175_422be10_to_gbrp10le_line(coef, pg, g, b, r, w);
+    pg += w / 2;
+    g += w;
+    b += w;
+    r += w;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_gbrp10le_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint16_t* g, uint16_t* b, uint16_t* r,
+                                          uint32_t w, uint32_t h,
+                                          enum st20_colorimetry colorimetry,
+                                          enum st20_range range,
+                                          enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  struct st_csc_coef coef;
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+
+  ret = st_csc_coef_init(&coef, colorimetry, range);
+  if (ret < 0) return ret;
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_gbrp10le_avx512(pg, g, b, r, w, h, &coef);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_gbrp10le_scalar(pg, g, b, r, w, h, &coef);
+}
+
+static int st20_rfc4175_422be10_to_rgb8_scalar(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint8_t* rgb, uint32_t w, uint32_t h,
+                                               const struct st_csc_coef* coef) {
+  for (uint32_t line = 0; line < h; line++) {
+    rfc4175_422be10_to_rgb8_line(coef, pg, rgb, w);
+    pg += w / 2;
+    rgb += w * 3;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_rgb8_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h,
+                                      enum st20_colorimetry colorimetry,
+                                      enum st20_range range, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  struct st_csc_coef coef;
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+
+  ret = st_csc_coef_init(&coef, colorimetry, range);
+  if (ret < 0) return ret;
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_rgb8_avx512(pg, rgb, w, h, &coef);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_rgb8_scalar(pg, rgb, w, h, &coef);
 }
 
 int st31_am824_to_aes3(struct st31_am824* sf_am824, struct st31_aes3* sf_aes3,
@@ -17,4 +17,24 @@ struct st_frame_converter {
 int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
                            struct st_frame_converter* converter);
 
+/* the scaler of one fmt and size, area filter for downscale, bilinear for upscale */
+struct st_frame_scaler;
+
+struct st_frame_scaler* st_frame_scaler_create(enum st_frame_fmt fmt, uint32_t src_w,
+                                               uint32_t src_h, uint32_t dst_w,
+                                               uint32_t dst_h, enum mtl_simd_level level);
+int st_frame_scaler_free(struct st_frame_scaler* scaler);
+int st_frame_scaler_run(struct st_frame_scaler* scaler, struct st_frame* src,
+                        struct st_frame* dst);
+
+struct mtl_main_impl;
+
+int st_cvt_pool_init(struct mtl_main_impl* impl);
+int st_cvt_pool_uinit(struct mtl_main_impl* impl);
+
+/* convert by horizontal slices on the cvt pool, run on the caller thread if no pool */
+int st_frame_convert_slices(struct mtl_main_impl* impl,
+                            const struct st_frame_converter* converter,
+                            struct st_frame* src, struct st_frame* dst);
+
 #endif
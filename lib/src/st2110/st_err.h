@@ -37,6 +37,7 @@ enum sti_ret_code {
   STI_FRAME_PKT_ALLOC_FAIL,
   STI_FRAME_PKT_ENQUEUE_FAIL,
   STI_FRAME_PKT_R_ENQUEUE_FAIL,
+  STI_FRAME_BUILDER_NOT_READY,
   /* st rtp build stat */
   STI_RTP_RING_FULL = 240,
   STI_RTP_INFLIGHT_ENQUEUE_FAIL,
@@ -4,6 +4,7 @@
 
 #include "st_fmt.h"
 
+#include "../mt_dma.h"
 #include "../mt_log.h"
 #include "st_main.h"
 
@@ -341,6 +342,34 @@ static const struct st_frame_fmt_desc st_frame_fmt_descs[] = {
         .planes = 1,
         .sampling = ST_FRAME_SAMPLING_422,
     },
+    {
+        /* ST_FRAME_FMT_NV12 */
+        .fmt = ST_FRAME_FMT_NV12,
+        .name = "NV12",
+        .planes = 2,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
+    {
+        /* ST_FRAME_FMT_P010 */
+        .fmt = ST_FRAME_FMT_P010,
+        .name = "P010",
+        .planes = 2,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
+    {
+        /* ST_FRAME_FMT_YUV420PLANAR8 */
+        .fmt = ST_FRAME_FMT_YUV420PLANAR8,
+        .name = "YUV420PLANAR8",
+        .planes = 3,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
+    {
+        /* ST_FRAME_FMT_YUV420PLANAR10LE */
+        .fmt = ST_FRAME_FMT_YUV420PLANAR10LE,
+        .name = "YUV420PLANAR10LE",
+        .planes = 3,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
     {
         /* ST_FRAME_FMT_RGBRFC4175PG4BE10 */
         .fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
@@ -437,16 +466,24 @@ size_t st_frame_least_linesize(enum st_frame_fmt fmt, uint32_t width, uint8_t pl
         }
         break;
       case ST_FRAME_SAMPLING_420:
+        /* two lines carry two Y lines plus one half width line of the U and V */
+        linesize = st_frame_size(fmt, width, 2, false) / 3;
         switch (plane) {
           case 0:
-            linesize = st_frame_size(fmt, width, 1, false) * 4 / 6;
             break;
           case 1:
-          case 2:
-            linesize = st_frame_size(fmt, width, 1, false) / 6;
+            /* semi-planar has the interleaved UV on the plane 1 */
+            if (st_frame_fmt_planes(fmt) != 2) linesize /= 2;
             break;
+          case 2:
+            if (st_frame_fmt_planes(fmt) != 2) {
+              linesize /= 2;
+              break;
+            }
+            /* fall through */
           default:
-            err("%s, invalid plane idx %u for 422 planar fmt\n", __func__, plane);
+            err("%s, invalid plane idx %u for 420 planar fmt\n", __func__, plane);
+            linesize = 0;
             break;
         }
         break;
@@ -459,6 +496,13 @@ size_t st_frame_least_linesize(enum st_frame_fmt fmt, uint32_t width, uint8_t pl
   return linesize;
 }
 
+uint32_t st_frame_plane_height(enum st_frame_fmt fmt, uint32_t height, uint8_t plane) {
+  /* the chroma planes of 420 has half lines, packed 420 fmt always single plane */
+  if (plane > 0 && st_frame_fmt_get_sampling(fmt) == ST_FRAME_SAMPLING_420)
+    return height / 2;
+  return height;
+}
+
 size_t st_frame_size(enum st_frame_fmt fmt, uint32_t width, uint32_t height,
                      bool interlaced) {
   size_t size = 0;
@@ -513,6 +557,14 @@ size_t st_frame_size(enum st_frame_fmt fmt, uint32_t width, uint32_t height,
     case ST_FRAME_FMT_YUV420CUSTOM8:
       size = st20_frame_size(ST20_FMT_YUV_420_8BIT, width, height);
       break;
+    case ST_FRAME_FMT_NV12:
+    case ST_FRAME_FMT_YUV420PLANAR8:
+      size = pixels * 3 / 2;
+      break;
+    case ST_FRAME_FMT_P010:
+    case ST_FRAME_FMT_YUV420PLANAR10LE:
+      size = pixels * 3 / 2 * 2; /* 10bits in two bytes */
+      break;
     default:
       err("%s, invalid fmt %d\n", __func__, fmt);
       break;
@@ -1049,14 +1101,117 @@ void st_frame_init_plane_single_src(struct st_frame* frame, void* addr, mtl_iova
       frame->addr[plane] = addr;
       frame->iova[plane] = iova;
     } else {
-      frame->addr[plane] =
-          frame->addr[plane - 1] + frame->linesize[plane - 1] * frame->height;
-      frame->iova[plane] =
-          frame->iova[plane - 1] + frame->linesize[plane - 1] * frame->height;
+      frame->addr[plane] = frame->addr[plane - 1] + st_frame_plane_size(frame, plane - 1);
+      frame->iova[plane] = frame->iova[plane - 1] + st_frame_plane_size(frame, plane - 1);
     }
   }
 }
 
+int st_frame_copy_from_ext(struct mtl_dma_lender_dev* dma, struct st_frame* dst,
+                           struct st_ext_frame* src) {
+  uint8_t planes = st_frame_fmt_planes(dst->fmt);
+  uint32_t rows = dst->interlaced ? dst->height / 2 : dst->height;
+  int dma_copies = 0, ret;
+
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    if (!src->addr[plane]) {
+      err("%s, no addr for plane %u\n", __func__, plane);
+      return -EINVAL;
+    }
+  }
+
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    uint32_t plane_rows = st_frame_plane_height(dst->fmt, rows, plane);
+    size_t dst_linesize = dst->linesize[plane];
+    size_t src_linesize = src->linesize[plane] ? src->linesize[plane] : dst_linesize;
+    size_t line_size = st_frame_least_linesize(dst->fmt, dst->width, plane);
+
+    /* one dma copy for the whole plane if the same linesize */
+    if (dma && (dst_linesize == src_linesize) && dst->iova[plane] && src->iova[plane]) {
+      ret = mt_dma_copy(dma, dst->iova[plane], src->iova[plane],
+                        dst_linesize * plane_rows);
+      if (ret >= 0) {
+        dma_copies++;
+        continue;
+      }
+    }
+    /* cpu copy line by line */
+    for (uint32_t line = 0; line < plane_rows; line++) {
+      mtl_memcpy(dst->addr[plane] + dst_linesize * line,
+                 src->addr[plane] + src_linesize * line, line_size);
+    }
+  }
+
+  return dma_copies;
+}
+
+static int16_t csc_fixed(double v) {
+  double f = v * (1 << ST_CSC_SHIFT);
+  return (int16_t)(f < 0 ? f - 0.5 : f + 0.5);
+}
+
+int st_csc_coef_init(struct st_csc_coef* coef, enum st20_colorimetry colorimetry,
+                     enum st20_range range) {
+  double kr, kb, kg, ys, cs;
+
+  switch (colorimetry) {
+    case ST20_COLORIMETRY_BT709:
+      kr = 0.2126;
+      kb = 0.0722;
+      break;
+    case ST20_COLORIMETRY_BT601:
+      kr = 0.299;
+      kb = 0.114;
+      break;
+    case ST20_COLORIMETRY_BT2020:
+      kr = 0.2627;
+      kb = 0.0593;
+      break;
+    default:
+      err("%s, invalid colorimetry %d\n", __func__, colorimetry);
+      return -EINVAL;
+  }
+  kg = 1.0 - kr - kb;
+
+  /* the scale from the full 10 bit RGB to the Y and CbCr */
+  switch (range) {
+    case ST20_RANGE_NARROW:
+      coef->y_off = 64;
+      ys = 876.0 / 1023.0;
+      cs = 896.0 / 1023.0;
+      break;
+    case ST20_RANGE_FULL:
+      coef->y_off = 0;
+      ys = 1.0;
+      cs = 1.0;
+      break;
+    default:
+      err("%s, invalid range %d\n", __func__, range);
+      return -EINVAL;
+  }
+
+  /* the G coef take the rounding error so the grey keep the exact Y and CbCr */
+  coef->to_y[0] = csc_fixed(kr * ys);
+  coef->to_y[2] = csc_fixed(kb * ys);
+  coef->to_y[1] = csc_fixed(ys) - coef->to_y[0] - coef->to_y[2];
+  coef->to_cb[0] = csc_fixed(-kr / (2 * (1 - kb)) * cs);
+  coef->to_cb[2] = csc_fixed(0.5 * cs);
+  coef->to_cb[1] = -coef->to_cb[0] - coef->to_cb[2];
+  coef->to_cr[0] = csc_fixed(0.5 * cs);
+  coef->to_cr[2] = csc_fixed(-kb / (2 * (1 - kr)) * cs);
+  coef->to_cr[1] = -coef->to_cr[0] - coef->to_cr[2];
+
+  coef->y_gain = csc_fixed(1.0 / ys);
+  coef->cr_r = csc_fixed(2 * (1 - kr) / cs);
+  coef->cb_g = csc_fixed(-2 * (1 - kb) * kb / kg / cs);
+  coef->cr_g = csc_fixed(-2 * (1 - kr) * kr / kg / cs);
+  coef->cb_b = csc_fixed(2 * (1 - kb) / cs);
+
+  dbg("%s, colorimetry %d range %d, y %d %d %d\n", __func__, colorimetry, range,
+      coef->to_y[0], coef->to_y[1], coef->to_y[2]);
+  return 0;
+}
+
 /* the reference rl pad interval table for CVL NIC */
 struct cvl_pad_table {
   enum st20_fmt fmt;
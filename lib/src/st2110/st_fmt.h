@@ -61,6 +61,19 @@ static inline void st20_unpack_pg2be_422le10(struct st20_rfc4175_422_10_pg2_be*
   *y01 = y1;
 }
 
+static inline void st20_pack_422le10_pg2be(uint16_t cb00, uint16_t y00, uint16_t cr00,
+                                           uint16_t y01,
+                                           struct st20_rfc4175_422_10_pg2_be* pg) {
+  pg->Cb00 = cb00 >> 2;
+  pg->Cb00_ = cb00;
+  pg->Y00 = y00 >> 4;
+  pg->Y00_ = y00;
+  pg->Cr00 = cr00 >> 6;
+  pg->Cr00_ = cr00;
+  pg->Y01 = y01 >> 8;
+  pg->Y01_ = y01;
+}
+
 static inline void st20_unpack_pg2be_422le12(struct st20_rfc4175_422_12_pg2_be* pg,
                                              uint16_t* cb00, uint16_t* y00,
                                              uint16_t* cr00, uint16_t* y01) {
@@ -77,6 +90,207 @@ static inline void st20_unpack_pg2be_422le12(struct st20_rfc4175_422_12_pg2_be*
   *y01 = y1;
 }
 
+static inline void st20_pack_422le12_pg2be(uint16_t cb00, uint16_t y00, uint16_t cr00,
+                                           uint16_t y01,
+                                           struct st20_rfc4175_422_12_pg2_be* pg) {
+  pg->Cb00 = cb00 >> 4;
+  pg->Cb00_ = cb00;
+  pg->Y00 = y00 >> 8;
+  pg->Y00_ = y00;
+  pg->Cr00 = cr00 >> 4;
+  pg->Cr00_ = cr00;
+  pg->Y01 = y01 >> 8;
+  pg->Y01_ = y01;
+}
+
+/* 444 helpers, each of b_r, y_g and r_b point to the 4(10bit) or 2(12bit) samples */
+static inline void st20_unpack_pg4be_444le10(struct st20_rfc4175_444_10_pg4_be* pg,
+                                             uint16_t* b_r, uint16_t* y_g,
+                                             uint16_t* r_b) {
+  b_r[0] = (pg->Cb_R00 << 2) + pg->Cb_R00_;
+  y_g[0] = (pg->Y_G00 << 4) + pg->Y_G00_;
+  r_b[0] = (pg->Cr_B00 << 6) + pg->Cr_B00_;
+  b_r[1] = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+  y_g[1] = (pg->Y_G01 << 2) + pg->Y_G01_;
+  r_b[1] = (pg->Cr_B01 << 4) + pg->Cr_B01_;
+  b_r[2] = (pg->Cb_R02 << 6) + pg->Cb_R02_;
+  y_g[2] = (pg->Y_G02 << 8) + pg->Y_G02_;
+  r_b[2] = (pg->Cr_B02 << 2) + pg->Cr_B02_;
+  b_r[3] = (pg->Cb_R03 << 4) + pg->Cb_R03_;
+  y_g[3] = (pg->Y_G03 << 6) + pg->Y_G03_;
+  r_b[3] = (pg->Cr_B03 << 8) + pg->Cr_B03_;
+}
+
+static inline void st20_pack_444le10_pg4be(uint16_t* b_r, uint16_t* y_g, uint16_t* r_b,
+                                           struct st20_rfc4175_444_10_pg4_be* pg) {
+  pg->Cb_R00 = b_r[0] >> 2;
+  pg->Cb_R00_ = b_r[0];
+  pg->Y_G00 = y_g[0] >> 4;
+  pg->Y_G00_ = y_g[0];
+  pg->Cr_B00 = r_b[0] >> 6;
+  pg->Cr_B00_ = r_b[0];
+  pg->Cb_R01 = b_r[1] >> 8;
+  pg->Cb_R01_ = b_r[1];
+  pg->Y_G01 = y_g[1] >> 2;
+  pg->Y_G01_ = y_g[1];
+  pg->Cr_B01 = r_b[1] >> 4;
+  pg->Cr_B01_ = r_b[1];
+  pg->Cb_R02 = b_r[2] >> 6;
+  pg->Cb_R02_ = b_r[2];
+  pg->Y_G02 = y_g[2] >> 8;
+  pg->Y_G02_ = y_g[2];
+  pg->Cr_B02 = r_b[2] >> 2;
+  pg->Cr_B02_ = r_b[2];
+  pg->Cb_R03 = b_r[3] >> 4;
+  pg->Cb_R03_ = b_r[3];
+  pg->Y_G03 = y_g[3] >> 6;
+  pg->Y_G03_ = y_g[3];
+  pg->Cr_B03 = r_b[3] >> 8;
+  pg->Cr_B03_ = r_b[3];
+}
+
+static inline void st20_unpack_pg2be_444le12(struct st20_rfc4175_444_12_pg2_be* pg,
+                                             uint16_t* b_r, uint16_t* y_g,
+                                             uint16_t* r_b) {
+  b_r[0] = (pg->Cb_R00 << 4) + pg->Cb_R00_;
+  y_g[0] = (pg->Y_G00 << 8) + pg->Y_G00_;
+  r_b[0] = (pg->Cr_B00 << 4) + pg->Cr_B00_;
+  b_r[1] = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+  y_g[1] = (pg->Y_G01 << 4) + pg->Y_G01_;
+  r_b[1] = (pg->Cr_B01 << 8) + pg->Cr_B01_;
+}
+
+static inline void st20_pack_444le12_pg2be(uint16_t* b_r, uint16_t* y_g, uint16_t* r_b,
+                                           struct st20_rfc4175_444_12_pg2_be* pg) {
+  pg->Cb_R00 = b_r[0] >> 4;
+  pg->Cb_R00_ = b_r[0];
+  pg->Y_G00 = y_g[0] >> 8;
+  pg->Y_G00_ = y_g[0];
+  pg->Cr_B00 = r_b[0] >> 4;
+  pg->Cr_B00_ = r_b[0];
+  pg->Cb_R01 = b_r[1] >> 8;
+  pg->Cb_R01_ = b_r[1];
+  pg->Y_G01 = y_g[1] >> 4;
+  pg->Y_G01_ = y_g[1];
+  pg->Cr_B01 = r_b[1] >> 8;
+  pg->Cr_B01_ = r_b[1];
+}
+
+/* the fixed point bits of the RGB <-> YUV matrix */
+#define ST_CSC_SHIFT (13)
+
+/* the 10 bit RGB <-> YUV matrix of one colorimetry and range */
+struct st_csc_coef {
+  /* Y offset, 64 for narrow and 0 for full */
+  int16_t y_off;
+  /* rgb to yuv, the {R, G, B} coef for the Y, Cb and Cr */
+  int16_t to_y[3];
+  int16_t to_cb[3];
+  int16_t to_cr[3];
+  /* yuv to rgb, on the Y - y_off, Cb - 512 and Cr - 512 */
+  int16_t y_gain;
+  int16_t cr_r;
+  int16_t cb_g;
+  int16_t cr_g;
+  int16_t cb_b;
+};
+
+int st_csc_coef_init(struct st_csc_coef* coef, enum st20_colorimetry colorimetry,
+                     enum st20_range range);
+
+static inline uint16_t st_csc_clip10(int32_t v) {
+  if (v < 0) return 0;
+  if (v > 1023) return 1023;
+  return v;
+}
+
+/* the round and the offset are added as a product of 1024, same to the simd madd */
+static inline uint16_t st_csc_row(const int16_t* row, int16_t off, uint16_t r,
+                                  uint16_t g, uint16_t b) {
+  int32_t sum = row[0] * r + row[1] * g + row[2] * b + (off * 8 + 4) * 1024;
+  return st_csc_clip10(sum >> ST_CSC_SHIFT);
+}
+
+static inline void st_csc_rgb_to_yuv10(const struct st_csc_coef* coef, uint16_t r,
+                                       uint16_t g, uint16_t b, uint16_t* y,
+                                       uint16_t* cb, uint16_t* cr) {
+  *y = st_csc_row(coef->to_y, coef->y_off, r, g, b);
+  *cb = st_csc_row(coef->to_cb, 512, r, g, b);
+  *cr = st_csc_row(coef->to_cr, 512, r, g, b);
+}
+
+static inline void st_csc_yuv_to_rgb10(const struct st_csc_coef* coef, uint16_t y,
+                                       uint16_t cb, uint16_t cr, uint16_t* r,
+                                       uint16_t* g, uint16_t* b) {
+  int32_t yy = (y - coef->y_off) * coef->y_gain + (1 << (ST_CSC_SHIFT - 1));
+  int32_t u = cb - 512;
+  int32_t v = cr - 512;
+
+  *r = st_csc_clip10((yy + v * coef->cr_r) >> ST_CSC_SHIFT);
+  *g = st_csc_clip10((yy + u * coef->cb_g + v * coef->cr_g) >> ST_CSC_SHIFT);
+  *b = st_csc_clip10((yy + u * coef->cb_b) >> ST_CSC_SHIFT);
+}
+
+/* the [1 2 1] low pass of the co-sited chroma for the 444 to 422 */
+static inline uint16_t st_csc_chroma_filter(uint16_t left, uint16_t c, uint16_t right) {
+  return (left + 2 * c + right + 2) >> 2;
+}
+
+/* the 8 bit RGB sample to 10 bit and back */
+static inline uint16_t st_csc_8_to_10(uint8_t v) {
+  return (v << 2) | (v >> 6);
+}
+
+static inline uint8_t st_csc_10_to_8(uint16_t v) {
+  v = (v + 2) >> 2;
+  return v > 255 ? 255 : v;
+}
+
+/* the fixed point bits of the scaler weights, the weights of one output sum to 1 */
+#define ST_SCALE_SHIFT (14)
+/* the max downscale ratio of each direction, the area filter taps grow with it */
+#define ST_SCALE_MAX_RATIO (16)
+#define ST_SCALE_MAX_TAPS (ST_SCALE_MAX_RATIO + 2)
+/* the vertical output keeps 2 fraction bits for the horizontal filter */
+#define ST_SCALE_V_FRAC (2)
+#define ST_SCALE_V_SHIFT (ST_SCALE_SHIFT - ST_SCALE_V_FRAC)
+#define ST_SCALE_H_SHIFT (ST_SCALE_SHIFT + ST_SCALE_V_FRAC)
+
+/* the vertical filter of one output line, the coef of each tap is for one src line */
+static inline void st_scale_vertical_scalar(const uint16_t** lines, const int16_t* coef,
+                                            uint32_t taps, uint16_t* dst, uint32_t x,
+                                            uint32_t w) {
+  for (; x < w; x++) {
+    int32_t sum = 1 << (ST_SCALE_V_SHIFT - 1);
+    for (uint32_t k = 0; k < taps; k++) sum += lines[k][x] * coef[k];
+    dst[x] = sum >> ST_SCALE_V_SHIFT;
+  }
+}
+
+/*
+ * The horizontal filter of one line, the taps of each output start from start[i], the
+ * coefs are stored in tap pairs, {tap0, tap1} of all outputs then {tap2, tap3}.
+ */
+static inline void st_scale_horizontal_scalar(const uint16_t* src, uint16_t* dst,
+                                              uint32_t i, uint32_t w,
+                                              const uint32_t* start,
+                                              const int16_t* coef, uint32_t taps) {
+  for (; i < w; i++) {
+    int32_t sum = 1 << (ST_SCALE_H_SHIFT - 1);
+    for (uint32_t k = 0; k < taps; k++)
+      sum += src[start[i] + k] * coef[((k >> 1) * w + i) * 2 + (k & 1)];
+    dst[i] = sum >> ST_SCALE_H_SHIFT;
+  }
+}
+
 void st_frame_init_plane_single_src(struct st_frame* frame, void* addr, mtl_iova_t iova);
 
+/*
+ * Copy the ext frame to the frame, each plane by one dma copy if the dma is not NULL
+ * and the linesize is the same, else by cpu. Return the number of the dma copies
+ * enqueued(not submitted) or a negative error code.
+ */
+int st_frame_copy_from_ext(struct mtl_dma_lender_dev* dma, struct st_frame* dst,
+                           struct st_ext_frame* src);
+
 #endif
@@ -36,6 +36,9 @@
 
 /* number of tmstamp it will tracked for out of order pkts */
 #define ST_VIDEO_RX_REC_NUM_OFO (2)
+/* tmstamp to slot hash size, should be power of 2 and larger than ST20_RX_SLOTS_MAX */
+#define ST_VIDEO_RX_SLOT_HASH_SHIFT (4)
+#define ST_VIDEO_RX_SLOT_HASH_SIZE (1 << ST_VIDEO_RX_SLOT_HASH_SHIFT)
 /* number of slices it will tracked as out of order pkts */
 #define ST_VIDEO_RX_SLICE_NUM (32)
 /* sync to atomic if reach this threshold */
@@ -67,9 +70,16 @@
 #define ST_MAX_SESSIONS_PER_DECODER (16)
 /* max sessions number per converter */
 #define ST_MAX_SESSIONS_PER_CONVERTER (16)
+/* max worker threads in the convert pool */
+#define ST_CVT_POOL_THREADS_MAX (32)
+/* the least lines of one slice in the convert pool */
+#define ST_CVT_POOL_SLICE_MIN_LINES (16)
 
 #define ST_TX_DUMMY_PKT_IDX (0xFFFFFFFF)
 
+/* the pad interval trained with MTL_FLAG_TX_PACING_TRAIN_FAKE */
+#define ST_TX_PACING_TRAIN_FAKE_PAD (64)
+
 enum st21_tx_frame_status {
   ST21_TX_STAT_UNKNOWN = 0,
   ST21_TX_STAT_WAIT_FRAME,
@@ -245,6 +255,38 @@ struct st_vsync_info {
   bool init;
 };
 
+/* the frame jobs to builders, double buffer */
+#define ST_TX_VIDEO_BUILD_JOBS (2)
+
+/* the info of one frame for the builders */
+struct st_tx_video_build_job {
+  uint16_t frame_idx;
+  uint16_t ipv4_packet_id; /* ipv4 id of the first pkt */
+  uint32_t seq_id;         /* seq id of the first pkt */
+  uint32_t rtp_time_stamp;
+  /* hdr template of primary port, copied under the session lock at publish */
+  struct st_rfc4175_video_hdr hdr;
+};
+
+/* build the pkts of a tx video session on another sch */
+struct st_tx_video_builder {
+  struct st_tx_video_session_impl* parent;
+  int idx;
+  struct mt_sch_impl* sch;
+  int quota_mbs;
+  struct mt_sch_tasklet_impl* tasklet;
+  struct rte_ring* job_ring; /* st_tx_video_build_job from the session tasklet */
+  struct rte_ring* ring;     /* built pkts to the session tasklet */
+
+  struct st_tx_video_build_job job; /* current job */
+  bool job_active;
+  int pkt_idx; /* next pkt index in current frame */
+
+  /* stat */
+  uint32_t stat_pkts_build;
+  uint32_t stat_frames;
+};
+
 struct st_tx_video_session_impl {
   struct mtl_main_impl* impl;
   struct st_tx_video_sessions_mgr* mgr;
@@ -337,6 +379,24 @@ struct st_tx_video_session_impl {
   int st20_pkt_idx;          /* pkt index in current frame, start from zero */
   uint32_t st20_seq_id;      /* seq id for each pkt */
   uint32_t st20_rtp_time;    /* keep track of rtp time */
+
+  /* builders on other schs, the session tasklet only merge the built pkts */
+  struct st_tx_video_builder* builders[ST20_TX_BUILDERS_MAX];
+  int nb_builders;       /* set only after all builders are ready */
+  int build_chunk_pkts;  /* pkts of one chunk, multiple of bulk */
+  bool build_sharded;    /* if current frame is built by the builders */
+  struct st_tx_video_build_job build_jobs[ST_TX_VIDEO_BUILD_JOBS];
+  int build_job_idx;
+  /* builders stop and mempool reset after a fatal error, done in the admin thread */
+  bool builders_stop_pending;
+  /* the rl pacing train out of the mgr lock is not done yet */
+  bool pacing_train_pending;
+
+  /* hdr mbufs of primary port kept with one extra ref, reused once the tx is done */
+  struct rte_mbuf** recycle;
+  uint32_t recycle_mask; /* size - 1, size is power of 2 */
+  uint32_t recycle_head; /* the oldest one */
+  uint32_t recycle_tail;
   int st21_vrx_narrow;       /* pass criteria for narrow */
   int st21_vrx_wide;         /* pass criteria for wide */
 
@@ -368,6 +428,7 @@ struct st_tx_video_session_impl {
   int stat_pkts_burst;
   int stat_pkts_burst_dummy;
   int stat_pkts_chain_realloc_fail;
+  uint32_t stat_pkts_recycled;
   int stat_trs_ret_code[MTL_SESSION_PORT_MAX];
   int stat_build_ret_code;
   uint64_t stat_last_time;
@@ -427,7 +488,7 @@ struct st_rx_video_slot_impl {
   uint32_t seq_id_base_u32; /* seq id for the first packet with u32 */
   bool seq_id_got;
   struct st_frame_trans* frame; /* only for frame type */
-  uint8_t* frame_bitmap;
+  uint64_t* frame_bitmap;           /* 64 bits word bitmap */
   size_t frame_recv_size;           /* for frame type */
   size_t pkt_lcore_frame_recv_size; /* frame_recv_size for pkt lcore */
   uint32_t pkts_received;
@@ -442,6 +503,11 @@ struct st_rx_video_slot_impl {
   uint16_t st22_box_hdr_length;
   /* timestamp(ST10_TIMESTAMP_FMT_TAI, PTP) value for the first pkt */
   uint64_t timestamp_first_pkt;
+  bool active;  /* tmstamp assigned */
+  bool in_hash; /* in the slot_hash of the session */
+  /* the dma seq of the last copy to this slot, retired if dma_seq - borrowed >= it */
+  uint64_t dma_last_seq;
+  bool dma_wait_full; /* all pkts received, wait the dma copies retired */
 };
 
 struct st_rx_video_ebu_info {
@@ -645,10 +711,14 @@ struct st_rx_video_session_impl {
   /* rtp info */
   struct rte_ring* rtps_ring;
 
-  /* record two frames in case pkts out of order within marker */
-  struct st_rx_video_slot_impl slots[ST_VIDEO_RX_REC_NUM_OFO];
+  /* record multi frames in case pkts out of order within marker */
+  struct st_rx_video_slot_impl slots[ST20_RX_SLOTS_MAX];
   int slot_idx;
   int slot_max;
+  /* tmstamp hash for O(1) slot lookup, a slot collided with others is not in the hash */
+  struct st_rx_video_slot_impl* slot_hash[ST_VIDEO_RX_SLOT_HASH_SIZE];
+  int slot_hash_missed; /* active slots not in slot_hash */
+  struct st_rx_video_slot_impl* slot_last; /* the last hit slot */
 
   /* slice info */
   uint32_t slice_lines;
@@ -660,6 +730,8 @@ struct st_rx_video_session_impl {
   uint16_t dma_nb_desc;
   struct st_rx_video_slot_impl* dma_slot;
   bool dma_copy;
+  uint64_t dma_seq;      /* total dma copies borrowed */
+  int dma_slots_waiting; /* slots wait the dma copies retired to notify */
 #ifdef ST_PCAPNG_ENABLED
   /* pcap dumper */
   uint32_t pcapng_dumped_pkts;
@@ -704,6 +776,7 @@ struct st_rx_video_session_impl {
   int stat_pkts_wrong_hdr_dropped;
   int stat_pkts_received;
   int stat_pkts_multi_segments_received;
+  int stat_pkts_multi_segments_dropped;
   int stat_pkts_dma;
   int stat_pkts_rtp_ring_full;
   int stat_pkts_no_slot;
@@ -726,6 +799,10 @@ struct st_rx_video_session_impl {
   uint32_t stat_slot_query_ext_fail;
   uint64_t stat_bytes_received;
   uint32_t stat_max_notify_frame_us;
+  /* not reset by the stat dump, for st20_rx_get_mbuf_chain_stats */
+  uint64_t stat_total_multi_segments_received;
+  uint64_t stat_total_multi_segments_dropped;
+  uint64_t stat_total_multi_segments_dma;
 
   struct st_rx_video_ebu_info ebu_info;
   struct st_rx_video_ebu_stat ebu;
@@ -1234,6 +1311,39 @@ struct st_plugin_mgr {
   int plugins_nb;
 };
 
+/* one frame convert split into horizontal slices */
+struct st_cvt_pool_job {
+  const struct st_frame_converter* converter;
+  struct st_frame* src;
+  struct st_frame* dst;
+  uint32_t slice_lines;
+  uint32_t slices;
+  rte_atomic32_t slice_idx; /* the next slice to claim */
+  rte_atomic32_t fail_cnt;
+  int workers; /* the workers attached, protect by the pool mutex */
+  bool queued; /* in the pool job queue, protect by the pool mutex */
+  MT_TAILQ_ENTRY(st_cvt_pool_job) next;
+};
+
+MT_TAILQ_HEAD(st_cvt_pool_job_queue, st_cvt_pool_job);
+
+struct st_cvt_pool_impl {
+  struct mtl_main_impl* parent;
+  int socket_id;
+  int threads_nb;
+  pthread_t tids[ST_CVT_POOL_THREADS_MAX];
+  rte_atomic32_t stop_thread;
+  pthread_mutex_t mutex;    /* protect the jobs */
+  pthread_cond_t wake_cond; /* new job or stop */
+  pthread_cond_t done_cond; /* worker detached from a job */
+  /* the jobs with slices to claim, one for each concurrent caller */
+  struct st_cvt_pool_job_queue jobs;
+  /* stat */
+  rte_atomic32_t stat_frames;
+  rte_atomic32_t stat_slices;
+  rte_atomic32_t stat_worker_slices;
+};
+
 struct st_tx_video_session_handle_impl {
   struct mtl_main_impl* parent;
   enum mt_handle_type type;
@@ -487,6 +487,8 @@ static int rx_ancillary_sessions_mgr_init(struct mtl_main_impl* impl,
   ops.start = rx_ancillary_sessions_tasklet_start;
   ops.stop = rx_ancillary_sessions_tasklet_stop;
   ops.handler = rx_ancillary_sessions_tasklet_handler;
+  /* the only tasklet which lock the sessions of this mgr, it can run on any sch */
+  ops.flags = MT_TASKLET_BALANCE;
 
   mgr->tasklet = mt_sch_register_tasklet(sch, &ops);
   if (!mgr->tasklet) {
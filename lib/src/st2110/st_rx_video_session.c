@@ -11,6 +11,7 @@
 #include "../mt_rtcp.h"
 #include "../mt_stat.h"
 #include "st_fmt.h"
+#include "st_rx_video_session_test.h"
 
 static int rv_init_pkt_handler(struct st_rx_video_session_impl* s);
 static int rvs_mgr_update(struct st_rx_video_sessions_mgr* mgr);
@@ -24,6 +25,10 @@ static inline struct mtl_main_impl* rv_get_impl(struct st_rx_video_session_impl*
   return s->parent->parent;
 }
 
+static inline uint32_t rv_bitmap_words(struct st_rx_video_session_impl* s) {
+  return s->st20_frame_bitmap_size / sizeof(uint64_t);
+}
+
 static inline uint16_t rv_queue_id(struct st_rx_video_session_impl* s,
                                    enum mtl_session_port s_port) {
   return mt_rxq_queue_id(s->rxq[s_port]);
@@ -981,7 +986,7 @@ static inline void rv_slot_pkt_lcore_add_frame_size(struct st_rx_video_session_i
 void rv_slot_dump(struct st_rx_video_session_impl* s) {
   struct st_rx_video_slot_impl* slot;
 
-  for (int i = 0; i < ST_VIDEO_RX_REC_NUM_OFO; i++) {
+  for (int i = 0; i < s->slot_max; i++) {
     slot = &s->slots[i];
     info("%s(%d), tmstamp %u recv_size %" PRIu64 " pkts_received %u\n", __func__, i,
          slot->tmstamp, rv_slot_get_frame_size(s, slot), slot->pkts_received);
@@ -998,7 +1003,7 @@ static int rv_init(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr*
 static int rv_uinit_slot(struct st_rx_video_session_impl* s) {
   struct st_rx_video_slot_impl* slot;
 
-  for (int i = 0; i < ST_VIDEO_RX_REC_NUM_OFO; i++) {
+  for (int i = 0; i < ST20_RX_SLOTS_MAX; i++) {
     slot = &s->slots[i];
     if (slot->frame_bitmap) {
       mt_rte_free(slot->frame_bitmap);
@@ -1024,12 +1029,29 @@ static int rv_init_slot(struct mtl_main_impl* impl, struct st_rx_video_session_i
   int idx = s->idx;
   size_t bitmap_size = s->st20_frame_bitmap_size;
   struct st_rx_video_slot_impl* slot;
-  uint8_t* frame_bitmap;
+  uint64_t* frame_bitmap;
   struct st_rx_video_slot_slice_info* slice_info;
   enum st20_type type = s->ops.type;
 
-  /* init slot */
-  for (int i = 0; i < ST_VIDEO_RX_REC_NUM_OFO; i++) {
+  if (s->ops.slots_cnt > ST20_RX_SLOTS_MAX) {
+    err("%s(%d), invalid slots_cnt %u\n", __func__, idx, s->ops.slots_cnt);
+    return -EINVAL;
+  }
+
+  s->slot_idx = -1;
+  if (s->ops.slots_cnt)
+    s->slot_max = s->ops.slots_cnt; /* user required reorder depth */
+  else if (s->ops.flags & ST20_RX_FLAG_ENABLE_RTCP)
+    s->slot_max = 2; /* use 2 slots for rtcp */
+  else
+    s->slot_max = 1; /* default only one slot */
+  memset(s->slot_hash, 0, sizeof(s->slot_hash));
+  s->slot_hash_missed = 0;
+  s->slot_last = NULL;
+
+  /* init slot, at least ST_VIDEO_RX_REC_NUM_OFO for rtp and pkt lcore */
+  int slots_cnt = RTE_MAX(s->slot_max, ST_VIDEO_RX_REC_NUM_OFO);
+  for (int i = 0; i < slots_cnt; i++) {
     slot = &s->slots[i];
 
     slot->idx = i;
@@ -1039,6 +1061,10 @@ static int rv_init_slot(struct mtl_main_impl* impl, struct st_rx_video_session_i
     slot->pkts_redundant_received = 0;
     slot->tmstamp = 0;
     slot->seq_id_got = false;
+    slot->active = false;
+    slot->in_hash = false;
+    slot->dma_last_seq = 0;
+    slot->dma_wait_full = false;
     frame_bitmap = mt_rte_zmalloc_socket(bitmap_size, soc_id);
     if (!frame_bitmap) {
       err("%s(%d), bitmap malloc %" PRIu64 " fail\n", __func__, idx, bitmap_size);
@@ -1055,13 +1081,8 @@ static int rv_init_slot(struct mtl_main_impl* impl, struct st_rx_video_session_i
       slot->slice_info = slice_info;
     }
   }
-  s->slot_idx = -1;
-  if (s->ops.flags & ST20_RX_FLAG_ENABLE_RTCP)
-    s->slot_max = 2; /* use 2 slots for rtcp */
-  else
-    s->slot_max = 1; /* default only one slot */
 
-  dbg("%s(%d), succ\n", __func__, idx);
+  dbg("%s(%d), succ, slot_max %d\n", __func__, idx, s->slot_max);
   return 0;
 }
 
@@ -1120,6 +1141,7 @@ static void rv_frame_notify(struct st_rx_video_session_impl* s,
   meta->frame_total_size = s->st20_frame_size;
   meta->uframe_total_size = s->st20_uframe_size;
   meta->frame_recv_size = rv_slot_get_frame_size(s, slot);
+  meta->nb_missing_ranges = 0;
   if (slot->frame->user_meta_data_size) {
     meta->user_meta_size = slot->frame->user_meta_data_size;
     meta->user_meta = slot->frame->user_meta;
@@ -1151,19 +1173,25 @@ static void rv_frame_notify(struct st_rx_video_session_impl* s,
         __func__, s->idx, meta->frame_recv_size, meta->frame_total_size, slot->tmstamp);
     meta->status = ST_FRAME_STATUS_CORRUPTED;
     s->stat_frames_dropped++;
-    /* record the miss pkts */
-    float pd_sz_per_pkt = (float)meta->frame_recv_size / slot->pkts_received;
+    /* record the miss pkts, the bitmap popcount is the unique pkts got */
+    uint32_t pkts_got = mt_bitmap64_count(slot->frame_bitmap, rv_bitmap_words(s));
+    float pd_sz_per_pkt = (float)meta->frame_recv_size / RTE_MAX(pkts_got, 1u);
     int miss_pkts = (s->st20_frame_size - meta->frame_recv_size) / pd_sz_per_pkt;
     dbg("%s(%d), miss pkts %d for current frame\n", __func__, s->idx, miss_pkts);
     s->stat_frames_pks_missed += miss_pkts;
-#if 0 /* for miss pkt detail */
-    int total_pkts = s->st20_frame_size / pd_sz_per_pkt;
-    dbg("%s(%d), total_pkts %d\n", __func__, s->idx, total_pkts);
-    for (int i = 0; i < total_pkts; i++) {
-      if (!mt_bitmap_test(slot->frame_bitmap, i))
-        info("%s(%d): pkt %d miss for tmstamp %u\n", __func__, s->idx, i, slot->tmstamp);
+    /* the missing pkts detail for the incomplete frame notify */
+    uint32_t total_pkts = RTE_MIN(pkts_got + RTE_MAX(miss_pkts, 0),
+                                  (uint32_t)s->st20_frame_bitmap_size * 8);
+    struct mt_bitmap_range ranges[ST20_RX_MISSING_RANGES_MAX];
+    int nb_ranges = mt_bitmap64_missing_ranges(slot->frame_bitmap, total_pkts, ranges,
+                                               ST20_RX_MISSING_RANGES_MAX);
+    for (int i = 0; i < nb_ranges; i++) {
+      meta->missing_ranges[i].start = ranges[i].start;
+      meta->missing_ranges[i].nb = ranges[i].nb;
+      dbg("%s(%d): pkt %u(%u) miss for tmstamp %u\n", __func__, s->idx, ranges[i].start,
+          ranges[i].nb, slot->tmstamp);
     }
-#endif
+    meta->nb_missing_ranges = nb_ranges;
 
     rte_atomic32_inc(&s->cbs_incomplete_frame_cnt);
     /* notify the incomplete frame if user required */
@@ -1208,14 +1236,6 @@ static void rv_st22_frame_notify(struct st_rx_video_session_impl* s,
     if (miss_pkts < 0) miss_pkts = 0;
     dbg("%s(%d), miss pkts %d for current frame\n", __func__, s->idx, miss_pkts);
     s->stat_frames_pks_missed += miss_pkts;
-#if 0 /* for miss pkt detail */
-    int total_pkts = s->st22_expect_size_per_frame / pd_sz_per_pkt;
-    dbg("%s(%d), total_pkts %d\n", __func__, s->idx, total_pkts);
-    for (int i = 0; i < total_pkts; i++) {
-      if (!mt_bitmap_test(slot->frame_bitmap, i))
-        info("%s(%d): pkt %d miss for tmstamp %u\n", __func__, s->idx, i, slot->tmstamp);
-    }
-#endif
 
     rte_atomic32_inc(&s->cbs_incomplete_frame_cnt);
     /* notify the incomplete frame if user required */
@@ -1306,23 +1326,106 @@ static void rv_slice_add(struct st_rx_video_session_impl* s,
   }
 }
 
+static inline uint32_t rv_slot_hash(uint32_t tmstamp) {
+  /* fibonacci hashing, tmstamp of continuous frames has a fixed step */
+  return (tmstamp * 2654435761u) >> (32 - ST_VIDEO_RX_SLOT_HASH_SHIFT);
+}
+
+static void rv_slot_hash_del(struct st_rx_video_session_impl* s,
+                             struct st_rx_video_slot_impl* slot) {
+  if (!slot->active) return;
+
+  if (slot->in_hash) {
+    s->slot_hash[rv_slot_hash(slot->tmstamp)] = NULL;
+    slot->in_hash = false;
+  } else {
+    s->slot_hash_missed--;
+  }
+  slot->active = false;
+}
+
+static void rv_slot_hash_add(struct st_rx_video_session_impl* s,
+                             struct st_rx_video_slot_impl* slot) {
+  uint32_t hash = rv_slot_hash(slot->tmstamp);
+
+  if (!s->slot_hash[hash]) {
+    s->slot_hash[hash] = slot;
+    slot->in_hash = true;
+  } else {
+    /* collided, only reachable by the slow walk */
+    s->slot_hash_missed++;
+    slot->in_hash = false;
+  }
+  slot->active = true;
+}
+
+/* O(1) for the most case, walk all slots only if any slot collided in the hash */
+static inline struct st_rx_video_slot_impl* rv_slot_find(
+    struct st_rx_video_session_impl* s, uint32_t tmstamp) {
+  struct st_rx_video_slot_impl* slot = s->slot_last;
+
+  if (slot && (tmstamp == slot->tmstamp)) return slot;
+
+  slot = s->slot_hash[rv_slot_hash(tmstamp)];
+  if (slot && (tmstamp == slot->tmstamp)) {
+    s->slot_last = slot;
+    return slot;
+  }
+
+  if (unlikely(s->slot_hash_missed)) {
+    for (int i = 0; i < s->slot_max; i++) {
+      slot = &s->slots[i];
+      if (slot->active && (tmstamp == slot->tmstamp)) {
+        s->slot_last = slot;
+        return slot;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/* all the dma copies to this slot retired, the copies of one lender retire in order */
+static inline bool rv_slot_dma_retired(struct st_rx_video_session_impl* s,
+                                       struct st_rx_video_slot_impl* slot) {
+  return (s->dma_seq - s->dma_dev->nb_borrowed) >= slot->dma_last_seq;
+}
+
+static inline void rv_slot_dma_wait_clear(struct st_rx_video_session_impl* s,
+                                          struct st_rx_video_slot_impl* slot) {
+  if (slot->dma_wait_full) {
+    slot->dma_wait_full = false;
+    s->dma_slots_waiting--;
+  }
+}
+
+/* borrow the mbuf for a dma copy to the slot, track the seq of the copy on slot */
+static int rv_dma_borrow_mbuf(struct st_rx_video_session_impl* s,
+                              struct st_rx_video_slot_impl* slot, struct rte_mbuf* mbuf) {
+  int ret = mt_dma_borrow_mbuf(s->dma_dev, mbuf);
+  if (ret) return ret;
+
+  s->dma_seq++;
+  slot->dma_last_seq = s->dma_seq;
+  return 0;
+}
+
 static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
     struct st_rx_video_session_impl* s, uint32_t tmstamp, void* hdr_split_pd) {
-  int i, slot_idx;
+  int slot_idx;
   struct st_rx_video_slot_impl* slot;
 
-  for (i = 0; i < s->slot_max; i++) {
-    slot = &s->slots[i];
-
-    if (tmstamp == slot->tmstamp) return slot;
-  }
+  slot = rv_slot_find(s, tmstamp);
+  if (slot) return slot;
 
   dbg("%s(%d): new tmstamp %u\n", __func__, s->idx, tmstamp);
-  if (s->dma_dev && !mt_dma_empty(s->dma_dev)) {
+  /* the slice drop cb tracks the dma_slot only, wait all copies of previous frame */
+  if (s->dma_dev && (s->ops.type == ST20_TYPE_SLICE_LEVEL) &&
+      !mt_dma_empty(s->dma_dev)) {
     /* still in progress of previous frame, drop current pkt */
     rte_atomic32_inc(&s->dma_previous_busy_cnt);
     dbg("%s(%d): still has dma inflight %u\n", __func__, s->idx,
-        s->dma_dev->nb_borrowed[s->dma_lender]);
+        s->dma_dev->nb_borrowed);
     return NULL;
   }
 
@@ -1330,6 +1433,14 @@ static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
   slot = &s->slots[slot_idx];
   // rv_slot_dump(s);
 
+  if (s->dma_dev && !rv_slot_dma_retired(s, slot)) {
+    /* dma still copying to the frame of the slot to be reused, drop current pkt */
+    rte_atomic32_inc(&s->dma_previous_busy_cnt);
+    dbg("%s(%d): slot %d still has dma inflight\n", __func__, s->idx, slot_idx);
+    return NULL;
+  }
+  rv_slot_dma_wait_clear(s, slot);
+
   /* drop frame if any previous */
   if (slot->frame) {
     if (s->st22_info)
@@ -1340,7 +1451,10 @@ static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
   }
 
   rv_slot_init_frame_size(s, slot);
+  rv_slot_hash_del(s, slot);
   slot->tmstamp = tmstamp;
+  rv_slot_hash_add(s, slot);
+  s->slot_last = slot;
   slot->seq_id_got = false;
   slot->pkts_received = 0;
   slot->pkts_redundant_received = 0;
@@ -1386,7 +1500,7 @@ static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
   s->dma_slot = slot;
 
   /* clear bitmap */
-  memset(slot->frame_bitmap, 0x0, s->st20_frame_bitmap_size);
+  mt_bitmap64_clear(slot->frame_bitmap, rv_bitmap_words(s));
   if (slot->slice_info) memset(slot->slice_info, 0x0, sizeof(*slot->slice_info));
 
   rte_atomic32_inc(&s->cbs_frame_slot_cnt);
@@ -1418,7 +1532,7 @@ static struct st_rx_video_slot_impl* rv_rtp_slot_by_tmstamp(
   s->slot_idx = slot_idx;
 
   /* clear bitmap */
-  memset(slot->frame_bitmap, 0x0, s->st20_frame_bitmap_size);
+  mt_bitmap64_clear(slot->frame_bitmap, rv_bitmap_words(s));
 
   dbg("%s: assign slot %d for tmstamp %u\n", __func__, slot_idx, tmstamp);
   return slot;
@@ -1462,6 +1576,9 @@ static int rv_free_dma(struct mtl_main_impl* impl, struct st_rx_video_session_im
     mt_dma_free_dev(impl, s->dma_dev);
     s->dma_dev = NULL;
   }
+  /* the borrowed count restart from zero with a new lender */
+  s->dma_seq = 0;
+  for (int i = 0; i < ST20_RX_SLOTS_MAX; i++) s->slots[i].dma_last_seq = 0;
 
   return 0;
 }
@@ -1679,21 +1796,33 @@ static int rv_dma_dequeue(struct mtl_main_impl* impl,
     mt_dma_drop_mbuf(dma_dev, nb_dq);
   }
 
-  /* all dma action finished */
-  struct st_rx_video_slot_impl* dma_slot = s->dma_slot;
-  if (mt_dma_empty(dma_dev) && dma_slot) {
-    dbg("%s(%d), nb_dq %u\n", __func__, s->idx, nb_dq);
-    int32_t frame_recv_size = rv_slot_get_frame_size(s, dma_slot);
-    if (frame_recv_size >= s->st20_frame_size) {
-      dbg("%s(%d): full frame\n", __func__, s->idx);
-      rv_slot_full_frame(s, dma_slot);
-      s->dma_slot = NULL;
-    }
+  if (!s->dma_slots_waiting) return 0;
+
+  /* notify the full frames whose last dma copy retired, from the oldest slot */
+  for (int i = 1; i <= s->slot_max; i++) {
+    struct st_rx_video_slot_impl* slot = &s->slots[(s->slot_idx + i) % s->slot_max];
+    if (!slot->dma_wait_full || !rv_slot_dma_retired(s, slot)) continue;
+    dbg("%s(%d): full frame on slot %d\n", __func__, s->idx, slot->idx);
+    rv_slot_dma_wait_clear(s, slot);
+    rv_slot_full_frame(s, slot);
+    if (s->dma_slot == slot) s->dma_slot = NULL;
   }
 
   return 0;
 }
 
+/* coalesce the completion polls, the copies of the burst are submitted as one batch */
+static inline bool rv_dma_need_dequeue(struct st_rx_video_session_impl* s) {
+  struct mtl_dma_lender_dev* dma_dev = s->dma_dev;
+
+  if (s->dma_slots_waiting) return true; /* frame notify hold by the dma */
+  if (!s->dma_copy) return true;         /* no new copy in last burst, drain it */
+  if (s->ops.type == ST20_TYPE_SLICE_LEVEL) return true; /* slice notify on retire */
+  if (dma_dev->nb_borrowed >= ST_RX_VIDEO_DMA_CPL_BATCH) return true;
+  if (mt_dma_full(dma_dev)) return true;
+  return false;
+}
+
 static inline uint32_t rfc4175_rtp_seq_id(struct st20_rfc4175_rtp_hdr* rtp) {
   uint16_t seq_id_base = ntohs(rtp->base.seq_number);
   uint16_t seq_id_ext = ntohs(rtp->seq_number_ext);
@@ -1701,6 +1830,58 @@ static inline uint32_t rfc4175_rtp_seq_id(struct st20_rfc4175_rtp_hdr* rtp) {
   return seq_id;
 }
 
+/*
+ * Copy a multi segments payload by one dma copy for each segment, segment smaller than
+ * ST_RX_VIDEO_DMA_MIN_SIZE or failed to submit fallback to cpu. Each dma copy borrows the
+ * head mbuf, the refcnt of the tail segments is increased also as rte_pktmbuf_free walk
+ * the whole chain. Return the number of dma copies.
+ */
+static int rv_dma_copy_segs(struct st_rx_video_session_impl* s,
+                            struct st_rx_video_slot_impl* slot, struct rte_mbuf* mbuf,
+                            uint32_t offset, uint32_t payload_offset,
+                            uint32_t payload_length) {
+  struct mtl_dma_lender_dev* dma_dev = s->dma_dev;
+  struct rte_mbuf* seg = mbuf;
+  uint32_t seg_offset = payload_offset;
+  uint32_t remain = payload_length;
+  uint32_t len;
+  int dma_copies = 0, ret;
+
+  /* dma completion is tracked by the borrowed mbuf, set the full range on head */
+  st_rx_mbuf_set_offset(mbuf, offset);
+  st_rx_mbuf_set_len(mbuf, payload_length);
+
+  while (seg && remain) {
+    if (seg_offset >= seg->data_len) {
+      seg_offset -= seg->data_len;
+      seg = seg->next;
+      continue;
+    }
+    len = RTE_MIN((uint32_t)seg->data_len - seg_offset, remain);
+    ret = -EIO;
+    if ((len > ST_RX_VIDEO_DMA_MIN_SIZE) && !mt_dma_full(dma_dev)) {
+      ret = mt_dma_copy(dma_dev, rv_frame_get_offset_iova(s, slot->frame, offset),
+                        rte_pktmbuf_iova_offset(seg, seg_offset), len);
+    }
+    if (ret < 0) {
+      rte_memcpy(slot->frame->addr + offset,
+                 rte_pktmbuf_mtod_offset(seg, void*, seg_offset), len);
+    } else {
+      mt_mbuf_refcnt_update_tails(mbuf, 1);
+      ret = rv_dma_borrow_mbuf(s, slot, mbuf);
+      if (ret)
+        err("%s(%d), mbuf copied but not enqueued \n", __func__, s->idx);
+      dma_copies++;
+    }
+    offset += len;
+    remain -= len;
+    seg_offset = 0;
+    seg = seg->next;
+  }
+
+  return dma_copies;
+}
+
 static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf* mbuf,
                                enum mtl_session_port s_port, bool ctrl_thread) {
   struct st20_rx_ops* ops = &s->ops;
@@ -1723,17 +1904,23 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   uint32_t seq_id_u32 = rfc4175_rtp_seq_id(rtp);
   uint8_t payload_type = rtp->base.payload_type;
   int pkt_idx = -1, ret;
-  struct rte_mbuf* mbuf_next = mbuf->next;
+  /* the nic may split the pkt into multi segments if the data room is small */
+  bool multi_segs = mbuf->next && mbuf->next->data_len;
+  uint32_t payload_offset = RTE_PTR_DIFF(payload, rte_pktmbuf_mtod(mbuf, void*));
 
   if (payload_type != ops->payload_type) {
     s->stat_pkts_wrong_hdr_dropped++;
     return -EINVAL;
   }
-  if (mbuf_next && mbuf_next->data_len) {
-    /* for some reason mbuf splits into 2 segments (1024 bytes + left bytes) */
-    /* todo: payload needs to be copied from 2 places */
+  if (multi_segs) {
     s->stat_pkts_multi_segments_received++;
-    return -EIO;
+    s->stat_total_multi_segments_received++;
+    /* all hdrs should be in the first segment, uframe need a contiguous payload */
+    if ((mbuf->data_len < payload_offset) || s->st20_uframe_size) {
+      s->stat_pkts_multi_segments_dropped++;
+      s->stat_total_multi_segments_dropped++;
+      return -EIO;
+    }
   }
 
   /* find the target slot by tmstamp */
@@ -1747,7 +1934,10 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
     line1_length &= ~ST20_LEN_USER_META;
     dbg("%s(%d,%d): ST20_LEN_USER_META %u\n", __func__, s->idx, s_port, line1_length);
     if (line1_length <= slot->frame->user_meta_buffer_size) {
-      rte_memcpy(slot->frame->user_meta, payload, line1_length);
+      if (multi_segs)
+        mt_mbuf_gather_copy(slot->frame->user_meta, mbuf, payload_offset, line1_length);
+      else
+        rte_memcpy(slot->frame->user_meta, payload, line1_length);
       slot->frame->user_meta_data_size = line1_length;
     } else {
       s->stat_pkts_user_meta_err++;
@@ -1757,7 +1947,7 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
     return 0;
   }
 
-  uint8_t* bitmap = slot->frame_bitmap;
+  uint64_t* bitmap = slot->frame_bitmap;
   slot->second_field = (line1_number & ST20_SECOND_FIELD) ? true : false;
   line1_number &= ~ST20_SECOND_FIELD;
 
@@ -1776,6 +1966,11 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
     s->stat_pkts_offset_dropped++;
     return -EIO;
   }
+  if (multi_segs && (mbuf->pkt_len < payload_offset + payload_length)) {
+    s->stat_pkts_multi_segments_dropped++;
+    s->stat_total_multi_segments_dropped++;
+    return -EIO;
+  }
 
   /* check if the same pkt got already */
   if (slot->seq_id_got) {
@@ -1790,7 +1985,7 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
       return -EIO;
     }
 
-    bool is_set = mt_bitmap_test_and_set(bitmap, pkt_idx);
+    bool is_set = mt_bitmap64_test_and_set(bitmap, pkt_idx);
     if (is_set) {
       dbg("%s(%d,%d), drop as pkt %d already received\n", __func__, s->idx, s_port,
           pkt_idx);
@@ -1813,7 +2008,7 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
       }
       slot->seq_id_base_u32 = seq_id_u32 - pkt_idx;
       slot->seq_id_got = true;
-      mt_bitmap_test_and_set(bitmap, pkt_idx);
+      mt_bitmap64_test_and_set(bitmap, pkt_idx);
       dbg("%s(%d,%d), seq_id_base %d tmstamp %u\n", __func__, s->idx, s_port, seq_id_u32,
           tmstamp);
     } else {
@@ -1856,6 +2051,28 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
       pg_meta->pg_cnt = pg_meta->row_length / s->st20_pg.size;
       ops->uframe_pg_callback(ops->priv, slot->frame->addr, pg_meta);
     }
+  } else if (need_copy && multi_segs) {
+    /* copy the payload from each segment to target frame by dma or cpu */
+    if (extra_rtp && s->st20_linesize > s->st20_bytes_in_line) {
+      /* packet crosses line padding, copy two lines data */
+      mt_mbuf_gather_copy(slot->frame->addr + offset, mbuf, payload_offset,
+                          line1_length);
+      mt_mbuf_gather_copy(slot->frame->addr + (line1_number + 1) * s->st20_linesize,
+                          mbuf, payload_offset + line1_length,
+                          payload_length - line1_length);
+    } else if (dma_dev && (payload_length > ST_RX_VIDEO_DMA_MIN_SIZE) &&
+               (ops->type != ST20_TYPE_SLICE_LEVEL) &&
+               !rv_frame_payload_cross_page(s, slot->frame, offset, payload_length)) {
+      ret = rv_dma_copy_segs(s, slot, mbuf, offset, payload_offset, payload_length);
+      if (ret > 0) {
+        dma_copy = true;
+        s->stat_pkts_dma++;
+        s->stat_total_multi_segments_dma += ret;
+      }
+    } else {
+      mt_mbuf_gather_copy(slot->frame->addr + offset, mbuf, payload_offset,
+                          payload_length);
+    }
   } else if (need_copy) {
     /* copy the payload to target frame by dma or cpu */
     if (extra_rtp && s->st20_linesize > s->st20_bytes_in_line) {
@@ -1878,7 +2095,7 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
         /* abstract dma dev takes ownership of this mbuf */
         st_rx_mbuf_set_offset(mbuf, offset);
         st_rx_mbuf_set_len(mbuf, payload_length);
-        ret = mt_dma_borrow_mbuf(dma_dev, mbuf);
+        ret = rv_dma_borrow_mbuf(s, slot, mbuf);
         if (ret)
           err("%s(%d,%d), mbuf copied but not enqueued \n", __func__, s->idx, s_port);
         dma_copy = true;
@@ -1905,10 +2122,17 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   /* check if frame is full */
   size_t frame_recv_size = rv_slot_get_frame_size(s, slot);
   bool end_frame = false;
-  if (dma_dev) {
-    if (frame_recv_size >= s->st20_frame_size && mt_dma_empty(dma_dev)) end_frame = true;
-  } else {
-    if (frame_recv_size >= s->st20_frame_size) end_frame = true;
+  if (frame_recv_size >= s->st20_frame_size) {
+    if (dma_dev && !rv_slot_dma_retired(s, slot)) {
+      /* hold the notify until the last dma copy to this slot retired */
+      if (!slot->dma_wait_full) {
+        slot->dma_wait_full = true;
+        s->dma_slots_waiting++;
+      }
+    } else {
+      rv_slot_dma_wait_clear(s, slot);
+      end_frame = true;
+    }
   }
   if (end_frame) {
     dbg("%s(%d,%d): full frame on %p(%" PRIu64 ")\n", __func__, s->idx, s_port,
@@ -1948,7 +2172,7 @@ static int rv_handle_rtp_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf
     s->stat_pkts_no_slot++;
     return -ENOMEM;
   }
-  uint8_t* bitmap = slot->frame_bitmap;
+  uint64_t* bitmap = slot->frame_bitmap;
 
   /* check if the same pks got already */
   if (slot->seq_id_got) {
@@ -1970,7 +2194,7 @@ static int rv_handle_rtp_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf
       s->stat_pkts_idx_oo_bitmap++;
       return -EIO;
     }
-    bool is_set = mt_bitmap_test_and_set(bitmap, pkt_idx);
+    bool is_set = mt_bitmap64_test_and_set(bitmap, pkt_idx);
     if (is_set) {
       dbg("%s(%d,%d), drop as pkt %d already received\n", __func__, idx, s_port, pkt_idx);
       s->stat_pkts_redundant_dropped++;
@@ -1983,7 +2207,7 @@ static int rv_handle_rtp_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf
       slot->seq_id_got = true;
       rte_atomic32_inc(&s->stat_frames_received);
       s->port_user_stats[MTL_SESSION_PORT_P].frames++;
-      mt_bitmap_test_and_set(bitmap, 0);
+      mt_bitmap64_test_and_set(bitmap, 0);
       pkt_idx = 0;
       dbg("%s(%d,%d), seq_id_base %d tmstamp %u\n", __func__, idx, s_port, seq_id,
           tmstamp);
@@ -2089,7 +2313,7 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
     s->stat_pkts_no_slot++;
     return -EIO;
   }
-  uint8_t* bitmap = slot->frame_bitmap;
+  uint64_t* bitmap = slot->frame_bitmap;
 
   dbg("%s(%d,%d), seq_id %d kmode %u trans_order %u\n", __func__, s->idx, s_port, seq_id,
       rtp->kmode, rtp->trans_order);
@@ -2113,7 +2337,7 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
       return -EIO;
     }
 
-    bool is_set = mt_bitmap_test_and_set(bitmap, pkt_idx);
+    bool is_set = mt_bitmap64_test_and_set(bitmap, pkt_idx);
     if (is_set) {
       dbg("%s(%d,%d), drop as pkt %d already received\n", __func__, s->idx, s_port,
           pkt_idx);
@@ -2138,7 +2362,7 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
     slot->seq_id_base = seq_id - pkt_idx;
     slot->st22_payload_length = payload_length;
     slot->seq_id_got = true;
-    mt_bitmap_test_and_set(bitmap, pkt_idx);
+    mt_bitmap64_test_and_set(bitmap, pkt_idx);
     dbg("%s(%d,%d), get seq_id %d tmstamp %u, p_counter %u sep_counter %u, "
         "payload_length %u\n",
         __func__, s->idx, s_port, seq_id, tmstamp, p_counter, sep_counter,
@@ -2240,7 +2464,7 @@ static int rv_handle_hdr_split_pkt(struct st_rx_video_session_impl* s,
     s->stat_pkts_no_slot++;
     return -EIO;
   }
-  uint8_t* bitmap = slot->frame_bitmap;
+  uint64_t* bitmap = slot->frame_bitmap;
   slot->second_field = (line1_number & ST20_SECOND_FIELD) ? true : false;
   line1_number &= ~ST20_SECOND_FIELD;
 
@@ -2256,7 +2480,7 @@ static int rv_handle_hdr_split_pkt(struct st_rx_video_session_impl* s,
       s->stat_pkts_idx_oo_bitmap++;
       return -EIO;
     }
-    bool is_set = mt_bitmap_test_and_set(bitmap, pkt_idx);
+    bool is_set = mt_bitmap64_test_and_set(bitmap, pkt_idx);
     if (is_set) {
       dbg("%s(%d,%d), drop as pkt %d already received\n", __func__, s->idx, s_port,
           pkt_idx);
@@ -2268,7 +2492,7 @@ static int rv_handle_hdr_split_pkt(struct st_rx_video_session_impl* s,
     if (!line1_number && !line1_offset) { /* first packet */
       slot->seq_id_base_u32 = seq_id_u32;
       slot->seq_id_got = true;
-      mt_bitmap_test_and_set(bitmap, 0);
+      mt_bitmap64_test_and_set(bitmap, 0);
       pkt_idx = 0;
       dbg("%s(%d,%d), seq_id_base %d tmstamp %u\n", __func__, s->idx, s_port, seq_id_u32,
           tmstamp);
@@ -2579,7 +2803,7 @@ static int rv_init_sw(struct mtl_main_impl* impl, struct st_rx_video_sessions_mg
       return ret;
     }
     /* enable multi slot as it has two threads running */
-    s->slot_max = ST_VIDEO_RX_REC_NUM_OFO;
+    s->slot_max = RTE_MAX(s->slot_max, ST_VIDEO_RX_REC_NUM_OFO);
   }
 
   if (mt_has_ebu(impl)) {
@@ -2722,6 +2946,9 @@ static int rv_handle_detect_pkt(struct st_rx_video_session_impl* s, struct rte_m
         /* one line at line 2 packets for all the format */
         if (s->st20_frame_bitmap_size < ops->height * 2 / 8)
           s->st20_frame_bitmap_size = ops->height * 2 / 8;
+        /* align to the 64 bits word */
+        s->st20_frame_bitmap_size =
+            RTE_ALIGN_CEIL(s->st20_frame_bitmap_size, sizeof(uint64_t));
         ret = rv_init_sw(rv_get_impl(s), s->parent, s, NULL);
         if (ret < 0) {
           err("%s(%d), rv_init_sw fail %d\n", __func__, s->idx, ret);
@@ -2833,7 +3060,7 @@ static int rv_pkt_rx_tasklet(struct mtl_main_impl* impl,
   bool done = true;
 
   if (s->dma_dev) {
-    rv_dma_dequeue(impl, s);
+    if (rv_dma_need_dequeue(s)) rv_dma_dequeue(impl, s);
     /* check if has pending pkts in dma */
     if (!mt_dma_empty(s->dma_dev)) done = false;
   }
@@ -2981,9 +3208,9 @@ static int rv_init_rtcp_uhdr(struct mtl_main_impl* impl,
     return ret;
   }
 
-  ret = rte_eth_macaddr_get(s->port_id[s_port], mt_eth_s_addr(eth));
+  ret = mt_macaddr_get(impl, port, mt_eth_s_addr(eth));
   if (ret < 0) {
-    err("%s(%d), rte_eth_macaddr_get fail %d for port %d\n", __func__, idx, ret, s_port);
+    err("%s(%d), mt_macaddr_get fail %d for port %d\n", __func__, idx, ret, s_port);
     return ret;
   }
   eth->ether_type = htons(RTE_ETHER_TYPE_IPV4);
@@ -3136,6 +3363,9 @@ static int rv_attach(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr
   /* one line at line 2 packets for all the format */
   if (s->st20_frame_bitmap_size < ops->height * 2 / 8)
     s->st20_frame_bitmap_size = ops->height * 2 / 8;
+  /* align to the 64 bits word */
+  s->st20_frame_bitmap_size =
+      RTE_ALIGN_CEIL(s->st20_frame_bitmap_size, sizeof(uint64_t));
   strncpy(s->ops_name, ops->name, ST_MAX_NAME_LEN - 1);
   s->ops = *ops;
   for (int i = 0; i < num_port; i++) {
@@ -3165,6 +3395,8 @@ static int rv_attach(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr
   s->dma_nb_desc = 128;
   s->dma_slot = NULL;
   s->dma_dev = NULL;
+  s->dma_seq = 0;
+  s->dma_slots_waiting = 0;
 
   s->pri_nic_burst_cnt = 0;
   s->pri_nic_inflight_cnt = 0;
@@ -3433,6 +3665,11 @@ static void rv_stat(struct st_rx_video_sessions_mgr* mgr,
            s->stat_pkts_multi_segments_received);
     s->stat_pkts_multi_segments_received = 0;
   }
+  if (s->stat_pkts_multi_segments_dropped) {
+    notice("RX_VIDEO_SESSION(%d,%d): multi segments pkts %d dropped\n", m_idx, idx,
+           s->stat_pkts_multi_segments_dropped);
+    s->stat_pkts_multi_segments_dropped = 0;
+  }
   if (s->stat_pkts_not_bpm) {
     notice("RX_VIDEO_SESSION(%d,%d): not bpm hdr split pkts %d\n", m_idx, idx,
            s->stat_pkts_not_bpm);
@@ -3593,6 +3830,10 @@ static int rvs_mgr_init(struct mtl_main_impl* impl, struct mt_sch_impl* sch,
     rte_spinlock_init(&mgr->mutex[i]);
   }
 
+  /*
+   * no MT_TASKLET_BALANCE for pkt_rx and ctl, both try_get the session locks, and the
+   * dma devs are shared by the sessions with the sch index, see rv_init_dma.
+   */
   memset(&ops, 0x0, sizeof(ops));
   ops.priv = mgr;
   ops.name = "rvs_pkt_rx";
@@ -3814,12 +4055,23 @@ static int rv_ops_check(struct st20_rx_ops* ops) {
     }
   }
 
+  /* the slots array is fixed size for all types */
+  if (ops->slots_cnt > ST20_RX_SLOTS_MAX) {
+    err("%s, invalid slots_cnt %u, should in range [0:%d]\n", __func__, ops->slots_cnt,
+        ST20_RX_SLOTS_MAX);
+    return -EINVAL;
+  }
+
   if (st20_is_frame_type(type)) {
     if ((ops->framebuff_cnt < 2) || (ops->framebuff_cnt > ST20_FB_MAX_COUNT)) {
       err("%s, invalid framebuff_cnt %d, should in range [2:%d]\n", __func__,
           ops->framebuff_cnt, ST20_FB_MAX_COUNT);
       return -EINVAL;
     }
+    if (ops->slots_cnt > ops->framebuff_cnt) {
+      warn("%s, slots_cnt %u larger than framebuff_cnt %u, frames may be not enough\n",
+           __func__, ops->slots_cnt, ops->framebuff_cnt);
+    }
     if (!ops->notify_frame_ready) {
       err("%s, pls set notify_frame_ready\n", __func__);
       return -EINVAL;
@@ -4282,6 +4534,23 @@ bool st20_rx_dma_enabled(st20_rx_handle handle) {
   return s->dma_dev ? true : false;
 }
 
+int st20_rx_get_mbuf_chain_stats(st20_rx_handle handle,
+                                 struct st20_rx_mbuf_chain_stats* stats) {
+  struct st_rx_video_session_handle_impl* s_impl = handle;
+  struct st_rx_video_session_impl* s;
+
+  if (s_impl->type != MT_HANDLE_RX_VIDEO) {
+    err("%s, invalid type %d\n", __func__, s_impl->type);
+    return -EIO;
+  }
+
+  s = s_impl->impl;
+  stats->pkts_received = s->stat_total_multi_segments_received;
+  stats->pkts_dropped = s->stat_total_multi_segments_dropped;
+  stats->dma_copies = s->stat_total_multi_segments_dma;
+  return 0;
+}
+
 int st20_rx_get_queue_meta(st20_rx_handle handle, struct st_queue_meta* meta) {
   struct st_rx_video_session_handle_impl* s_impl = handle;
   struct st_rx_video_session_impl* s;
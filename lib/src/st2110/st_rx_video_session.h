@@ -10,6 +10,8 @@
 #define ST_RX_VIDEO_BURST_SIZE (128)
 
 #define ST_RX_VIDEO_DMA_MIN_SIZE (1024)
+/* poll the dma completions once the borrowed mbufs reach this even no slot waiting */
+#define ST_RX_VIDEO_DMA_CPL_BATCH (32)
 
 #define ST_RV_EBU_TSC_SYNC_MS (100) /* sync tsc with ptp period(ms) */
 #define ST_RV_EBU_TSC_SYNC_NS (ST_RV_EBU_TSC_SYNC_MS * 1000 * 1000)
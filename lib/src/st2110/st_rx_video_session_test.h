@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2023 Intel Corporation
+ */
+
+/* The test hooks of st_rx_video_session.c, not installed, for the gtest only */
+
+#ifndef _ST_LIB_RX_VIDEO_SESSION_TEST_HEAD_H_
+#define _ST_LIB_RX_VIDEO_SESSION_TEST_HEAD_H_
+
+#include "st20_api.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * The chained(multi segments) mbuf stats of one st20 rx session since create.
+ */
+struct st20_rx_mbuf_chain_stats {
+  /** the chained pkts received */
+  uint64_t pkts_received;
+  /** the chained pkts dropped */
+  uint64_t pkts_dropped;
+  /** the segments copied by the dma */
+  uint64_t dma_copies;
+};
+
+/**
+ * Get the chained mbuf stats of the st20(frame level) rx session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-20(video) session.
+ * @param stats
+ *   A pointer to the stats.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int st20_rx_get_mbuf_chain_stats(st20_rx_handle handle,
+                                 struct st20_rx_mbuf_chain_stats* stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
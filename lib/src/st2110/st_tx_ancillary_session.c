@@ -143,9 +143,9 @@ static int tx_ancillary_session_init_hdr(struct mtl_main_impl* impl,
     }
   }
 
-  ret = rte_eth_macaddr_get(mgr->port_id[port], mt_eth_s_addr(eth));
+  ret = mt_macaddr_get(impl, port, mt_eth_s_addr(eth));
   if (ret < 0) {
-    err("%s(%d), rte_eth_macaddr_get fail %d for port %d\n", __func__, idx, ret, port);
+    err("%s(%d), mt_macaddr_get fail %d for port %d\n", __func__, idx, ret, port);
     return ret;
   }
   eth->ether_type = htons(RTE_ETHER_TYPE_IPV4);
@@ -1480,6 +1480,8 @@ static int tx_ancillary_sessions_mgr_init(struct mtl_main_impl* impl,
   ops.start = tx_ancillary_sessions_tasklet_start;
   ops.stop = tx_ancillary_sessions_tasklet_stop;
   ops.handler = tx_ancillary_sessions_tasklet_handler;
+  /* the only tasklet which lock the sessions of this mgr, it can run on any sch */
+  ops.flags = MT_TASKLET_BALANCE;
 
   mgr->tasklet = mt_sch_register_tasklet(sch, &ops);
   if (!mgr->tasklet) {
@@ -142,9 +142,9 @@ static int tx_audio_session_init_hdr(struct mtl_main_impl* impl,
     }
   }
 
-  ret = rte_eth_macaddr_get(mgr->port_id[port], mt_eth_s_addr(eth));
+  ret = mt_macaddr_get(impl, port, mt_eth_s_addr(eth));
   if (ret < 0) {
-    err("%s(%d), rte_eth_macaddr_get fail %d for port %d\n", __func__, idx, ret, port);
+    err("%s(%d), mt_macaddr_get fail %d for port %d\n", __func__, idx, ret, port);
     return ret;
   }
   eth->ether_type = htons(RTE_ETHER_TYPE_IPV4);
@@ -1608,6 +1608,10 @@ static int tx_audio_sessions_mgr_init(struct mtl_main_impl* impl, struct mt_sch_
     return -EIO;
   }
 
+  /*
+   * no MT_TASKLET_BALANCE for build and trans, both try_get the session locks. On two
+   * lcores each one skip the sessions locked by the other and miss the pacing slot.
+   */
   memset(&ops, 0x0, sizeof(ops));
   ops.priv = mgr;
   ops.name = "tx_audio_sessions_build";
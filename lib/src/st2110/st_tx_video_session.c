@@ -281,49 +281,59 @@ static int uint64_t_cmp(const void* a, const void* b) {
   return 0;
 }
 
-static int tv_train_pacing(struct mtl_main_impl* impl, struct st_tx_video_session_impl* s,
-                           enum mtl_session_port s_port) {
+struct tv_train_ctx {
+  struct mtl_main_impl* impl;
+  struct st_tx_video_session_impl* s;
+  enum mtl_session_port s_port;
+  float pad_interval; /* result */
+  int ret;
+};
+
+static int tv_train_pacing_burst(void* priv, float* result) {
+  struct tv_train_ctx* ctx = priv;
+  struct mtl_main_impl* impl = ctx->impl;
+  struct st_tx_video_session_impl* s = ctx->s;
+  enum mtl_session_port s_port = ctx->s_port;
   enum mtl_port port = mt_port_logic2phy(s->port_maps, s_port);
   struct rte_mbuf* pad;
 
   int idx = s->idx;
   struct mt_txq_entry* queue = s->queue[s_port];
-  int pad_pkts, ret;
+  int pad_pkts;
   int up_trim = 5;
   int low_trim = up_trim + 1;
   int loop_frame = 60 * 1 + up_trim + low_trim; /* the frames to be trained */
   uint64_t frame_times_ns[loop_frame];
   float pad_interval;
-  uint64_t rl_bps = tv_rl_bps(s);
   uint64_t train_start_time, train_end_time;
-
-  uint16_t resolved = s->ops.pad_interval;
-  if (resolved) {
-    s->pacing.pad_interval = resolved;
-    info("%s(%d), user customized pad_interval %u\n", __func__, idx, resolved);
-    return 0;
-  }
-  if (!(s->ops.flags & ST20_TX_FLAG_DISABLE_STATIC_PAD_P)) {
-    resolved = st20_pacing_static_profiling(s);
-    if (resolved) {
-      s->pacing.pad_interval = resolved;
-      info("%s(%d), user static pad_interval %u\n", __func__, idx, resolved);
-      return 0;
-    }
-  }
-
-  ret = mt_pacing_train_result_search(impl, port, rl_bps, &pad_interval);
-  if (ret >= 0) {
-    s->pacing.pad_interval = pad_interval;
-    info("%s(%d), use pre-train pad_interval %f\n", __func__, idx, pad_interval);
-    return 0;
-  }
+  bool fake = mt_has_tx_pacing_train_fake(impl);
 
   /* wait ptp calibrate done, pacing ptp time */
   mt_ptp_wait_stable(impl, MTL_PORT_P, 60 * 3 * MS_PER_S);
 
   train_start_time = mt_get_tsc(impl);
 
+  int total = s->st20_total_pkts;
+  int remain = 32 - (total % 32);
+  double reactive = (1080.0 / 1125.0);
+  if (s->ops.interlaced && s->ops.height <= 576) {
+    reactive = (s->ops.height == 480) ? 487.0 / 525.0 : 576.0 / 625.0;
+  }
+
+  if (fake) {
+    /*
+     * an ideal NIC which sends the frame pkts in the active time with one pad every
+     * ST_TX_PACING_TRAIN_FAKE_PAD pkts, the train still spend the time of a real one
+     */
+    double fake_ns = (double)NS_PER_S * s->fps_tm.den / s->fps_tm.mul * reactive *
+                     ST_TX_PACING_TRAIN_FAKE_PAD / (ST_TX_PACING_TRAIN_FAKE_PAD + 1);
+    for (int loop = 0; loop < loop_frame; loop++) {
+      mt_sleep_us(fake_ns * (total + remain) / total / NS_PER_US);
+      frame_times_ns[loop] = fake_ns;
+    }
+    goto parse;
+  }
+
   /* warm-up stage to consume all nix tx buf */
   pad_pkts = mt_if_nb_tx_desc(impl, port) * 1;
   pad = s->pad[s_port][ST20_PKT_TYPE_NORMAL];
@@ -332,9 +342,6 @@ static int tv_train_pacing(struct mtl_main_impl* impl, struct st_tx_video_sessio
     mt_txq_burst_busy(queue, &pad, 1, 10);
   }
 
-  int total = s->st20_total_pkts;
-  int remain = 32 - (total % 32);
-
   /* training stage */
   for (int loop = 0; loop < loop_frame; loop++) {
     uint64_t start = mt_get_ptp_time(impl, MTL_PORT_P);
@@ -370,6 +377,7 @@ static int tv_train_pacing(struct mtl_main_impl* impl, struct st_tx_video_sessio
     frame_times_ns[loop] = time;
   }
 
+parse:
   for (int loop = 0; loop < loop_frame; loop++) {
     dbg("%s(%d), frame_time_ns %" PRIu64 "\n", __func__, idx, frame_times_ns[loop]);
   }
@@ -390,10 +398,6 @@ static int tv_train_pacing(struct mtl_main_impl* impl, struct st_tx_video_sessio
   /* parse the pad interval */
   double pkts_per_frame = pkts_per_sec * s->fps_tm.den / s->fps_tm.mul;
   /* adjust as tr offset */
-  double reactive = (1080.0 / 1125.0);
-  if (s->ops.interlaced && s->ops.height <= 576) {
-    reactive = (s->ops.height == 480) ? 487.0 / 525.0 : 576.0 / 625.0;
-  }
   pkts_per_frame = pkts_per_frame * reactive;
   if (pkts_per_frame < s->st20_total_pkts) {
     err("%s(%d), error pkts_per_frame %f, st20_total_pkts %d\n", __func__, idx,
@@ -408,8 +412,7 @@ static int tv_train_pacing(struct mtl_main_impl* impl, struct st_tx_video_sessio
     return -EINVAL;
   }
 
-  s->pacing.pad_interval = pad_interval;
-  mt_pacing_train_result_add(impl, port, rl_bps, pad_interval);
+  *result = pad_interval;
   train_end_time = mt_get_tsc(impl);
   info("%s(%d,%d), trained pad_interval %f pkts_per_frame %f with time %fs\n", __func__,
        idx, s_port, pad_interval, pkts_per_frame,
@@ -417,6 +420,44 @@ static int tv_train_pacing(struct mtl_main_impl* impl, struct st_tx_video_sessio
   return 0;
 }
 
+static int tv_train_pacing(struct tv_train_ctx* ctx) {
+  struct st_tx_video_session_impl* s = ctx->s;
+  enum mtl_port port = mt_port_logic2phy(s->port_maps, ctx->s_port);
+  int idx = s->idx;
+  int ret;
+
+  uint16_t resolved = s->ops.pad_interval;
+  if (resolved) {
+    ctx->pad_interval = resolved;
+    info("%s(%d), user customized pad_interval %u\n", __func__, idx, resolved);
+    return 0;
+  }
+  if (!(s->ops.flags & ST20_TX_FLAG_DISABLE_STATIC_PAD_P)) {
+    resolved = st20_pacing_static_profiling(s);
+    if (resolved) {
+      ctx->pad_interval = resolved;
+      info("%s(%d), user static pad_interval %u\n", __func__, idx, resolved);
+      return 0;
+    }
+  }
+
+  /* reuse the pre-train result or join the in flight train of the same rate */
+  ret = mt_pacing_train_run(ctx->impl, port, tv_rl_bps(s), &ctx->pad_interval,
+                            tv_train_pacing_burst, ctx);
+  if (ret < 0) return ret;
+  info("%s(%d,%d), pad_interval %f\n", __func__, idx, ctx->s_port, ctx->pad_interval);
+  return 0;
+}
+
+static void* tv_train_pacing_thread(void* arg) {
+  struct tv_train_ctx* ctx = arg;
+
+  ctx->ret = tv_train_pacing(ctx);
+  return NULL;
+}
+
+static int tv_init_pacing_way(struct st_tx_video_session_impl* s);
+
 static int tv_init_pacing(struct mtl_main_impl* impl,
                           struct st_tx_video_session_impl* s) {
   int idx = s->idx;
@@ -456,21 +497,25 @@ static int tv_init_pacing(struct mtl_main_impl* impl,
 
   int num_port = s->ops.num_port;
   enum mtl_port port;
-  int ret;
 
   for (int i = 0; i < num_port; i++) {
     port = mt_port_logic2phy(s->port_maps, i);
     /* use system pacing way now */
     s->pacing_way[i] = st_tx_pacing_way(impl, port);
-    if (s->pacing_way[i] == ST21_TX_PACING_WAY_RL) {
-      ret = tv_train_pacing(impl, s, i);
-      if (ret < 0) {
-        /* fallback to tsc pacing */
-        s->pacing_way[i] = ST21_TX_PACING_WAY_TSC;
-      }
-    }
+    /* the rl train takes seconds, it runs later without the mgr lock */
+    if (s->pacing_way[i] == ST21_TX_PACING_WAY_RL) s->pacing_train_pending = true;
   }
 
+  return tv_init_pacing_way(s);
+}
+
+/* the part depends on the pacing way, called again after the rl train */
+static int tv_init_pacing_way(struct st_tx_video_session_impl* s) {
+  int idx = s->idx;
+  struct st_tx_video_pacing* pacing = &s->pacing;
+  int num_port = s->ops.num_port;
+  int ret;
+
   if (num_port > 1) {
     if (s->pacing_way[MTL_SESSION_PORT_P] != s->pacing_way[MTL_SESSION_PORT_R]) {
       /* currently not support two different pacing? */
@@ -540,6 +585,71 @@ static int tv_init_pacing(struct mtl_main_impl* impl,
   return 0;
 }
 
+/*
+ * train the rl ports of a new session, call without any lock as it takes seconds. The
+ * session tasklet skips the session until the result is applied under the session lock.
+ */
+static int tv_train_pacing_ports(struct mtl_main_impl* impl,
+                                 struct st_tx_video_session_impl* s) {
+  int idx = s->idx;
+  int num_port = s->ops.num_port;
+  struct tv_train_ctx train_ctx[num_port];
+  pthread_t train_tid[num_port];
+  bool train_in_thread[num_port];
+  int ret;
+
+  if (!s->pacing_train_pending) return 0;
+
+  for (int i = 0; i < num_port; i++) {
+    train_in_thread[i] = false;
+    if (s->pacing_way[i] != ST21_TX_PACING_WAY_RL) continue;
+
+    train_ctx[i].impl = impl;
+    train_ctx[i].s = s;
+    train_ctx[i].s_port = i;
+    train_ctx[i].ret = -EIO;
+    /* train the ports in parallel, the last one run in current thread */
+    if (i < (num_port - 1)) {
+      ret = pthread_create(&train_tid[i], NULL, tv_train_pacing_thread, &train_ctx[i]);
+      if (ret == 0) {
+        train_in_thread[i] = true;
+        continue;
+      }
+      warn("%s(%d), train thread create fail %d for port %d\n", __func__, idx, ret, i);
+    }
+    tv_train_pacing_thread(&train_ctx[i]);
+  }
+  for (int i = 0; i < num_port; i++) {
+    if (train_in_thread[i]) pthread_join(train_tid[i], NULL);
+  }
+
+  struct st_tx_video_sessions_mgr* mgr = s->mgr;
+  s = tx_video_session_get(mgr, idx);
+  if (!s) {
+    err("%s(%d), get session fail\n", __func__, idx);
+    return -EIO;
+  }
+  for (int i = 0; i < num_port; i++) {
+    if (s->pacing_way[i] != ST21_TX_PACING_WAY_RL) continue;
+    if (train_ctx[i].ret < 0) {
+      /* fallback to tsc pacing */
+      s->pacing_way[i] = ST21_TX_PACING_WAY_TSC;
+    } else {
+      s->pacing.pad_interval = train_ctx[i].pad_interval;
+    }
+  }
+  ret = tv_init_pacing_way(s);
+  if (ret < 0) s->active = false; /* mark current session to dead */
+  s->pacing_train_pending = false;
+  tx_video_session_put(mgr, idx);
+  if (ret < 0) {
+    err("%s(%d), init pacing way fail %d\n", __func__, idx, ret);
+    return ret;
+  }
+
+  return 0;
+}
+
 static int tv_init_pacing_epoch(struct mtl_main_impl* impl,
                                 struct st_tx_video_session_impl* s) {
   uint64_t ptp_time = mt_get_ptp_time(impl, MTL_PORT_P);
@@ -758,9 +868,9 @@ static int tv_init_hdr(struct mtl_main_impl* impl, struct st_tx_video_session_im
     }
   }
 
-  ret = rte_eth_macaddr_get(s->port_id[s_port], mt_eth_s_addr(eth));
+  ret = mt_macaddr_get(impl, port, mt_eth_s_addr(eth));
   if (ret < 0) {
-    err("%s(%d), rte_eth_macaddr_get fail %d for port %d\n", __func__, idx, ret, s_port);
+    err("%s(%d), mt_macaddr_get fail %d for port %d\n", __func__, idx, ret, s_port);
     return ret;
   }
   eth->ether_type = htons(RTE_ETHER_TYPE_IPV4);
@@ -893,7 +1003,172 @@ static int tv_update_redundant(struct st_tx_video_session_impl* s, struct rte_mb
   return 0;
 }
 
-static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt) {
+/*
+ * payload position and the varying hdr fields of one st20 pkt, init once per bulk with
+ * the divisions and then advanced incrementally for each pkt in the bulk.
+ */
+struct tv_st20_pkt_pos {
+  struct st_frame_trans* frame;
+  /* hdr template of primary port, the builders use the snapshot in the job */
+  const struct st_rfc4175_video_hdr* hdr;
+  int pkt_idx;
+  uint32_t seq_id;
+  uint32_t rtp_time_stamp;
+  uint16_t ipv4_packet_id;
+  uint32_t offset;       /* payload offset in frame, with line padding for single line */
+  uint32_t line_bytes;   /* byte offset in current line, gpm only */
+  uint16_t line_pkt_idx; /* pkt index in current line, single line only */
+  uint16_t pixel_in_pkt; /* single line only */
+  uint16_t line1_number;
+  uint16_t line1_offset;
+};
+
+static inline void tv_st20_pos_update_sl(struct st_tx_video_session_impl* s,
+                                         struct tv_st20_pkt_pos* pos) {
+  pos->line1_offset = pos->pixel_in_pkt * pos->line_pkt_idx;
+  pos->offset = pos->line1_number * (uint32_t)s->st20_linesize +
+                pos->line1_offset / s->st20_pg.coverage * s->st20_pg.size;
+}
+
+static void tv_st20_pos_init(struct st_tx_video_session_impl* s, int pkt_idx,
+                             struct tv_st20_pkt_pos* pos) {
+  pos->pkt_idx = pkt_idx;
+  if (s->ops.packing == ST20_PACKING_GPM_SL) {
+    pos->pixel_in_pkt = s->st20_pkt_len / s->st20_pg.size * s->st20_pg.coverage;
+    pos->line1_number = pkt_idx / s->st20_pkts_in_line;
+    pos->line_pkt_idx = pkt_idx % s->st20_pkts_in_line;
+    tv_st20_pos_update_sl(s, pos);
+  } else {
+    pos->offset = s->st20_pkt_len * pkt_idx;
+    pos->line1_number = pos->offset / s->st20_bytes_in_line;
+    pos->line_bytes = pos->offset % s->st20_bytes_in_line;
+    pos->line1_offset = pos->line_bytes * s->st20_pg.coverage / s->st20_pg.size;
+  }
+}
+
+static inline void tv_st20_pos_next(struct st_tx_video_session_impl* s,
+                                    struct tv_st20_pkt_pos* pos) {
+  pos->pkt_idx++;
+  pos->seq_id++;
+  pos->ipv4_packet_id++;
+  if (s->ops.packing == ST20_PACKING_GPM_SL) {
+    pos->line_pkt_idx++;
+    if (pos->line_pkt_idx >= s->st20_pkts_in_line) {
+      pos->line_pkt_idx = 0;
+      pos->line1_number++;
+    }
+    tv_st20_pos_update_sl(s, pos);
+  } else {
+    pos->offset += s->st20_pkt_len;
+    pos->line_bytes += s->st20_pkt_len;
+    while (pos->line_bytes >= s->st20_bytes_in_line) {
+      pos->line_bytes -= s->st20_bytes_in_line;
+      pos->line1_number++;
+    }
+    pos->line1_offset = pos->line_bytes * s->st20_pg.coverage / s->st20_pg.size;
+  }
+}
+
+static inline void tv_recycle_reset_hdr(const struct st_rfc4175_video_hdr* tmpl,
+                                        struct st_rfc4175_video_hdr* hdr) {
+  hdr->ipv4.hdr_checksum = 0;
+  hdr->udp.src_port = tmpl->udp.src_port;
+  hdr->rtp.base.marker = 0;
+}
+
+/* drop the extra ref, release the mbuf if the tx is done already */
+static inline void tv_recycle_put(struct rte_mbuf* m) {
+  /* the chain seg is freed by the tx done */
+  mt_mbuf_free_head_seg(m);
+}
+
+static int tv_recycle_flush(struct st_tx_video_session_impl* s) {
+  while (s->recycle_head != s->recycle_tail) {
+    tv_recycle_put(s->recycle[s->recycle_head & s->recycle_mask]);
+    s->recycle_head++;
+  }
+  return 0;
+}
+
+static int tv_recycle_uinit(struct st_tx_video_session_impl* s) {
+  if (s->recycle) {
+    tv_recycle_flush(s);
+    mt_rte_free(s->recycle);
+    s->recycle = NULL;
+  }
+  return 0;
+}
+
+static int tv_recycle_init(struct mtl_main_impl* impl,
+                           struct st_tx_video_session_impl* s) {
+  enum mtl_port port = mt_port_logic2phy(s->port_maps, MTL_SESSION_PORT_P);
+  /* enough for all the pkts in the ring and the tx queue */
+  uint32_t size = rte_align32pow2(mt_if_nb_tx_desc(impl, port) + s->ring_count);
+
+  s->recycle =
+      mt_rte_zmalloc_socket(sizeof(*s->recycle) * size, mt_socket_id(impl, port));
+  if (!s->recycle) {
+    err("%s(%d), recycle malloc fail\n", __func__, s->idx);
+    return -ENOMEM;
+  }
+  s->recycle_mask = size - 1;
+  s->recycle_head = 0;
+  s->recycle_tail = 0;
+  info("%s(%d), size %u\n", __func__, s->idx, size);
+  return 0;
+}
+
+/*
+ * keep one extra ref of the hdr mbufs, it drops to one when the tx is done.
+ * Only the fully built ones are held, the dummy pkts never get the hdr template.
+ */
+static void tv_recycle_hold(struct st_tx_video_session_impl* s, struct rte_mbuf** pkts,
+                            unsigned int bulk) {
+  for (unsigned int i = 0; i < bulk; i++) {
+    if (st_tx_mbuf_get_idx(pkts[i]) == ST_TX_DUMMY_PKT_IDX) continue;
+    if (s->recycle_tail - s->recycle_head > s->recycle_mask) return; /* full */
+    rte_mbuf_refcnt_update(pkts[i], 1);
+    s->recycle[s->recycle_tail & s->recycle_mask] = pkts[i];
+    s->recycle_tail++;
+  }
+}
+
+/* get the hdr mbufs of primary port, the recycled ones are placed at the front */
+static int tv_recycle_alloc_bulk(struct st_tx_video_session_impl* s,
+                                 struct rte_mempool* pool, struct rte_mbuf** pkts,
+                                 unsigned int bulk, unsigned int* nb_recycled) {
+  unsigned int n = 0;
+  struct rte_mbuf* m;
+  int ret;
+
+  while ((n < bulk) && (s->recycle_head != s->recycle_tail)) {
+    m = s->recycle[s->recycle_head & s->recycle_mask];
+    /* tx is not done, the later ones are neither */
+    if (rte_mbuf_refcnt_read(m) != 1) break;
+    s->recycle_head++;
+    /* the chain seg is freed by the tx done */
+    m->next = NULL;
+    m->nb_segs = 1;
+    m->ol_flags = 0;
+    pkts[n++] = m;
+  }
+
+  if (n < bulk) {
+    ret = rte_pktmbuf_alloc_bulk(pool, &pkts[n], bulk - n);
+    if (ret < 0) {
+      /* put back, they are still in the array */
+      s->recycle_head -= n;
+      return ret;
+    }
+  }
+
+  s->stat_pkts_recycled += n;
+  *nb_recycled = n;
+  return 0;
+}
+
+static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt,
+                         struct tv_st20_pkt_pos* pos, bool recycled) {
   struct st_rfc4175_video_hdr* hdr;
   struct rte_ipv4_hdr* ipv4;
   struct rte_udp_hdr* udp;
@@ -904,34 +1179,31 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   uint16_t line1_number, line1_offset;
   uint16_t line1_length = 0, line2_length = 0;
   bool single_line = (ops->packing == ST20_PACKING_GPM_SL);
-  struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+  struct st_frame_trans* frame_info = pos->frame;
 
   hdr = rte_pktmbuf_mtod(pkt, struct st_rfc4175_video_hdr*);
   ipv4 = &hdr->ipv4;
   rtp = &hdr->rtp;
   udp = &hdr->udp;
 
-  /* copy the basic hdrs: eth, ip, udp, rtp */
-  rte_memcpy(hdr, &s->s_hdr[MTL_SESSION_PORT_P], sizeof(*hdr));
+  if (recycled) {
+    /* built from the same template, only reset the fields changed by last build */
+    tv_recycle_reset_hdr(pos->hdr, hdr);
+  } else {
+    /* copy the basic hdrs: eth, ip, udp, rtp */
+    rte_memcpy(hdr, pos->hdr, sizeof(*hdr));
+  }
 
   /* update ipv4 hdr */
-  ipv4->packet_id = htons(s->st20_ipv4_packet_id);
-  s->st20_ipv4_packet_id++;
+  ipv4->packet_id = htons(pos->ipv4_packet_id);
 
-  if (s->multi_src_port) udp->src_port += (s->st20_pkt_idx / 128) % 8;
+  if (s->multi_src_port) udp->src_port += (pos->pkt_idx / 128) % 8;
 
-  /* calculate payload header */
-  if (single_line) {
-    line1_number = s->st20_pkt_idx / s->st20_pkts_in_line;
-    int pixel_in_pkt = s->st20_pkt_len / s->st20_pg.size * s->st20_pg.coverage;
-    line1_offset = pixel_in_pkt * (s->st20_pkt_idx % s->st20_pkts_in_line);
-    offset = line1_number * (uint32_t)s->st20_linesize +
-             line1_offset / s->st20_pg.coverage * s->st20_pg.size;
-  } else {
-    offset = s->st20_pkt_len * s->st20_pkt_idx;
-    line1_number = offset / s->st20_bytes_in_line;
-    line1_offset =
-        (offset % s->st20_bytes_in_line) * s->st20_pg.coverage / s->st20_pg.size;
+  /* payload header from the precomputed position */
+  offset = pos->offset;
+  line1_number = pos->line1_number;
+  line1_offset = pos->line1_offset;
+  if (!single_line) {
     if ((offset + s->st20_pkt_len > (line1_number + 1) * s->st20_bytes_in_line) &&
         (offset + s->st20_pkt_len < s->st20_frame_size))
       e_rtp =
@@ -939,14 +1211,13 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   }
 
   /* update rtp hdr */
-  if (s->st20_pkt_idx >= (s->st20_total_pkts - 1)) rtp->base.marker = 1;
-  rtp->base.seq_number = htons((uint16_t)s->st20_seq_id);
-  rtp->seq_number_ext = htons((uint16_t)(s->st20_seq_id >> 16));
-  s->st20_seq_id++;
+  if (pos->pkt_idx >= (s->st20_total_pkts - 1)) rtp->base.marker = 1;
+  rtp->base.seq_number = htons((uint16_t)pos->seq_id);
+  rtp->seq_number_ext = htons((uint16_t)(pos->seq_id >> 16));
   uint16_t field = frame_info->tv_meta.second_field ? ST20_SECOND_FIELD : 0x0000;
   rtp->row_number = htons(line1_number | field);
   rtp->row_offset = htons(line1_offset);
-  rtp->base.tmstamp = htonl(s->pacing.rtp_time_stamp);
+  rtp->base.tmstamp = htonl(pos->rtp_time_stamp);
 
   uint32_t temp =
       single_line ? ((ops->width - line1_offset) / s->st20_pg.coverage * s->st20_pg.size)
@@ -999,7 +1270,8 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
 }
 
 static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt,
-                               struct rte_mbuf* pkt_chain) {
+                               struct rte_mbuf* pkt_chain, struct tv_st20_pkt_pos* pos,
+                               bool recycled) {
   struct st_rfc4175_video_hdr* hdr;
   struct rte_ipv4_hdr* ipv4;
   struct rte_udp_hdr* udp;
@@ -1010,33 +1282,31 @@ static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mb
   uint16_t line1_number, line1_offset;
   uint16_t line1_length = 0, line2_length = 0;
   bool single_line = (ops->packing == ST20_PACKING_GPM_SL);
-  struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+  struct st_frame_trans* frame_info = pos->frame;
 
   hdr = rte_pktmbuf_mtod(pkt, struct st_rfc4175_video_hdr*);
   ipv4 = &hdr->ipv4;
   rtp = &hdr->rtp;
   udp = &hdr->udp;
 
-  /* copy the hdr: eth, ip, udp, rtp */
-  rte_memcpy(hdr, &s->s_hdr[MTL_SESSION_PORT_P], sizeof(*hdr));
+  if (recycled) {
+    /* built from the same template, only reset the fields changed by last build */
+    tv_recycle_reset_hdr(pos->hdr, hdr);
+  } else {
+    /* copy the hdr: eth, ip, udp, rtp */
+    rte_memcpy(hdr, pos->hdr, sizeof(*hdr));
+  }
 
   /* update ipv4 hdr */
-  ipv4->packet_id = htons(s->st20_ipv4_packet_id);
-  s->st20_ipv4_packet_id++;
+  ipv4->packet_id = htons(pos->ipv4_packet_id);
 
-  if (s->multi_src_port) udp->src_port += (s->st20_pkt_idx / 128) % 8;
+  if (s->multi_src_port) udp->src_port += (pos->pkt_idx / 128) % 8;
 
-  if (single_line) {
-    line1_number = s->st20_pkt_idx / s->st20_pkts_in_line;
-    int pixel_in_pkt = s->st20_pkt_len / s->st20_pg.size * s->st20_pg.coverage;
-    line1_offset = pixel_in_pkt * (s->st20_pkt_idx % s->st20_pkts_in_line);
-    offset = line1_number * (uint32_t)s->st20_linesize +
-             line1_offset / s->st20_pg.coverage * s->st20_pg.size;
-  } else {
-    offset = s->st20_pkt_len * s->st20_pkt_idx;
-    line1_number = offset / s->st20_bytes_in_line;
-    line1_offset =
-        (offset % s->st20_bytes_in_line) * s->st20_pg.coverage / s->st20_pg.size;
+  /* payload header from the precomputed position */
+  offset = pos->offset;
+  line1_number = pos->line1_number;
+  line1_offset = pos->line1_offset;
+  if (!single_line) {
     if ((offset + s->st20_pkt_len > (line1_number + 1) * s->st20_bytes_in_line) &&
         (offset + s->st20_pkt_len < s->st20_frame_size))
       e_rtp =
@@ -1044,14 +1314,13 @@ static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mb
   }
 
   /* update rtp */
-  if (s->st20_pkt_idx >= (s->st20_total_pkts - 1)) rtp->base.marker = 1;
-  rtp->base.seq_number = htons((uint16_t)s->st20_seq_id);
-  rtp->seq_number_ext = htons((uint16_t)(s->st20_seq_id >> 16));
-  s->st20_seq_id++;
+  if (pos->pkt_idx >= (s->st20_total_pkts - 1)) rtp->base.marker = 1;
+  rtp->base.seq_number = htons((uint16_t)pos->seq_id);
+  rtp->seq_number_ext = htons((uint16_t)(pos->seq_id >> 16));
   uint16_t field = frame_info->tv_meta.second_field ? ST20_SECOND_FIELD : 0x0000;
   rtp->row_number = htons(line1_number | field);
   rtp->row_offset = htons(line1_offset);
-  rtp->base.tmstamp = htonl(s->pacing.rtp_time_stamp);
+  rtp->base.tmstamp = htonl(pos->rtp_time_stamp);
 
   uint32_t temp =
       single_line ? ((ops->width - line1_offset) / s->st20_pg.coverage * s->st20_pg.size)
@@ -1085,7 +1354,7 @@ static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mb
     rte_pktmbuf_free(pkt_chain);
     pkt_chain = rte_pktmbuf_alloc(s->mbuf_mempool_copy_chain);
     if (!pkt_chain) {
-      dbg("%s(%d), pkts chain realloc fail %d\n", __func__, s->idx, s->st20_pkt_idx);
+      dbg("%s(%d), pkts chain realloc fail %d\n", __func__, s->idx, pos->pkt_idx);
       s->stat_pkts_chain_realloc_fail++; /* we can do nothing but count */
       return -ENOMEM;
     }
@@ -1174,6 +1443,36 @@ static int tv_build_st20_redundant_chain(struct st_tx_video_session_impl* s,
   return 0;
 }
 
+/* build the pkts of primary port in bulk, the pkts beyond the frame are dummy */
+static void tv_build_st20_bulk(struct st_tx_video_session_impl* s, struct rte_mbuf** pkts,
+                               struct rte_mbuf** pkts_chain, unsigned int bulk,
+                               struct tv_st20_pkt_pos* pos, unsigned int nb_recycled) {
+  struct st_frame_trans* frame_info = pos->frame;
+
+  if (s->tx_no_chain) rte_prefetch0(frame_info->addr + pos->offset);
+
+  for (unsigned int i = 0; i < bulk; i++) {
+    /* the hdr of next pkt is written soon */
+    if (i + 1 < bulk) rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 1], void*));
+    st_tx_mbuf_set_priv(pkts[i], frame_info);
+    if (pos->pkt_idx >= s->st20_total_pkts) {
+      if (!s->tx_no_chain) rte_pktmbuf_free(pkts_chain[i]);
+      st_tx_mbuf_set_idx(pkts[i], ST_TX_DUMMY_PKT_IDX);
+      continue;
+    }
+
+    bool recycled = (i < nb_recycled);
+    if (s->tx_no_chain)
+      tv_build_st20(s, pkts[i], pos, recycled);
+    else
+      tv_build_st20_chain(s, pkts[i], pkts_chain[i], pos, recycled);
+    st_tx_mbuf_set_idx(pkts[i], pos->pkt_idx);
+    tv_st20_pos_next(s, pos);
+    /* payload of next pkt is copied by cpu in the no chain mode */
+    if (s->tx_no_chain) rte_prefetch0(frame_info->addr + pos->offset);
+  }
+}
+
 static int tv_build_rtp_chain(struct mtl_main_impl* impl,
                               struct st_tx_video_session_impl* s, struct rte_mbuf* pkt,
                               struct rte_mbuf* pkt_chain) {
@@ -1519,6 +1818,233 @@ static int tv_tasklet_start(void* priv) {
 
 static int tv_tasklet_stop(void* priv) { return 0; }
 
+static int tv_builder_tasklet_handler(void* priv) {
+  struct st_tx_video_builder* builder = priv;
+  struct st_tx_video_session_impl* s = builder->parent;
+  unsigned int bulk = s->bulk;
+  struct st_tx_video_build_job* job;
+  int ret;
+
+  if (!builder->job_active) {
+    ret = rte_ring_sc_dequeue(builder->job_ring, (void**)&job);
+    if (ret < 0) return MT_TASKLET_ALL_DONE;
+    /* copy it as the session tasklet reuse the job buffer */
+    builder->job = *job;
+    builder->job_active = true;
+    builder->pkt_idx = builder->idx * s->build_chunk_pkts;
+  }
+
+  if (rte_ring_free_count(builder->ring) < bulk) return MT_TASKLET_ALL_DONE;
+
+  struct rte_mbuf* pkts[bulk];
+  struct rte_mbuf* pkts_chain[bulk];
+
+  ret = rte_pktmbuf_alloc_bulk(s->mbuf_mempool_hdr[MTL_SESSION_PORT_P], pkts, bulk);
+  if (ret < 0) {
+    dbg("%s(%d,%d), pkts alloc fail %d\n", __func__, s->idx, builder->idx, ret);
+    return MT_TASKLET_ALL_DONE;
+  }
+  if (!s->tx_no_chain) {
+    ret = rte_pktmbuf_alloc_bulk(s->mbuf_mempool_chain, pkts_chain, bulk);
+    if (ret < 0) {
+      dbg("%s(%d,%d), pkts chain alloc fail %d\n", __func__, s->idx, builder->idx, ret);
+      rte_pktmbuf_free_bulk(pkts, bulk);
+      return MT_TASKLET_ALL_DONE;
+    }
+  }
+
+  struct tv_st20_pkt_pos pos;
+  pos.frame = &s->st20_frames[builder->job.frame_idx];
+  /* s_hdr may be updated by tv_update_dst at any time, use the snapshot */
+  pos.hdr = &builder->job.hdr;
+  pos.seq_id = builder->job.seq_id + builder->pkt_idx;
+  pos.ipv4_packet_id = builder->job.ipv4_packet_id + builder->pkt_idx;
+  pos.rtp_time_stamp = builder->job.rtp_time_stamp;
+  tv_st20_pos_init(s, builder->pkt_idx, &pos);
+  tv_build_st20_bulk(s, pkts, pkts_chain, bulk, &pos, 0);
+  /* single producer and the free count is checked already */
+  rte_ring_sp_enqueue_bulk(builder->ring, (void**)pkts, bulk, NULL);
+  builder->stat_pkts_build += bulk;
+
+  builder->pkt_idx += bulk;
+  /* skip the chunks of other builders */
+  if (!(builder->pkt_idx % s->build_chunk_pkts))
+    builder->pkt_idx += (s->nb_builders - 1) * s->build_chunk_pkts;
+  if (builder->pkt_idx >= s->st20_total_pkts) {
+    builder->job_active = false;
+    builder->stat_frames++;
+  }
+
+  return MT_TASKLET_HAS_PENDING;
+}
+
+/* hand over the new frame to all builders */
+static int tv_builders_publish(struct st_tx_video_session_impl* s) {
+  struct st_tx_video_build_job* job = &s->build_jobs[s->build_job_idx];
+  int ret;
+
+  s->build_job_idx = (s->build_job_idx + 1) % ST_TX_VIDEO_BUILD_JOBS;
+  job->frame_idx = s->st20_frame_idx;
+  job->seq_id = s->st20_seq_id;
+  job->ipv4_packet_id = s->st20_ipv4_packet_id;
+  job->rtp_time_stamp = s->pacing.rtp_time_stamp;
+  /* the session tasklet holds the session lock, same as tv_update_dst */
+  rte_memcpy(&job->hdr, &s->s_hdr[MTL_SESSION_PORT_P], sizeof(job->hdr));
+  /* the seq and ipv4 id of this frame are owned by the builders */
+  s->st20_seq_id += s->st20_total_pkts;
+  s->st20_ipv4_packet_id += s->st20_total_pkts;
+
+  for (int i = 0; i < s->nb_builders; i++) {
+    ret = rte_ring_sp_enqueue(s->builders[i]->job_ring, job);
+    if (ret < 0) {
+      err("%s(%d), job enqueue fail for builder %d\n", __func__, s->idx, i);
+      return ret;
+    }
+  }
+
+  return 0;
+}
+
+/* get the built pkts of primary port in the order of the chunks */
+static int tv_builders_dequeue(struct st_tx_video_session_impl* s,
+                               struct rte_mbuf** pkts, unsigned int bulk) {
+  int chunk = s->st20_pkt_idx / s->build_chunk_pkts;
+  struct st_tx_video_builder* builder = s->builders[chunk % s->nb_builders];
+
+  if (!rte_ring_sc_dequeue_bulk(builder->ring, (void**)pkts, bulk, NULL))
+    return -EBUSY;
+  return 0;
+}
+
+/* give back the seq and ipv4 id of the pkts published but not dequeued yet */
+static void tv_builders_rewind(struct st_tx_video_session_impl* s) {
+  int job_idx = (s->build_job_idx + ST_TX_VIDEO_BUILD_JOBS - 1) % ST_TX_VIDEO_BUILD_JOBS;
+  struct st_tx_video_build_job* job = &s->build_jobs[job_idx];
+  int built = RTE_MIN(s->st20_pkt_idx, s->st20_total_pkts);
+
+  s->st20_seq_id = job->seq_id + built;
+  s->st20_ipv4_packet_id = job->ipv4_packet_id + built;
+  dbg("%s(%d), seq id %u\n", __func__, s->idx, s->st20_seq_id);
+}
+
+static int tv_builders_uinit(struct st_tx_video_session_impl* s) {
+  struct st_tx_video_builder* builder;
+
+  for (int i = 0; i < ST20_TX_BUILDERS_MAX; i++) {
+    builder = s->builders[i];
+    if (!builder) continue;
+
+    if (builder->tasklet) {
+      mt_sch_unregister_tasklet(builder->tasklet);
+      builder->tasklet = NULL;
+    }
+    if (builder->ring) {
+      mt_ring_dequeue_clean(builder->ring);
+      rte_ring_free(builder->ring);
+      builder->ring = NULL;
+    }
+    if (builder->job_ring) {
+      rte_ring_free(builder->job_ring);
+      builder->job_ring = NULL;
+    }
+    if (builder->sch) {
+      mt_sch_put(builder->sch, builder->quota_mbs);
+      builder->sch = NULL;
+    }
+    mt_rte_free(builder);
+    s->builders[i] = NULL;
+  }
+  s->nb_builders = 0;
+  s->build_sharded = false;
+
+  return 0;
+}
+
+static int tv_builders_init(struct mtl_main_impl* impl,
+                            struct st_tx_video_session_impl* s, struct mt_sch_impl* sch,
+                            int quota_mbs) {
+  int nb_builders = s->ops.num_builders;
+  int idx = s->idx, mgr_idx = s->mgr->idx;
+  int socket = mt_socket_id(impl, MTL_PORT_P);
+  int bulk = s->bulk;
+  /* the builders should run on other schs */
+  mt_sch_mask_t mask = MT_SCH_MASK_ALL & ~MTL_BIT64(sch->idx);
+  struct st_tx_video_builder* builder;
+  char name[32];
+
+  /* at least one chunk for each builder */
+  int chunk = RTE_MIN(ST_TX_VIDEO_BUILD_CHUNK_PKTS, s->st20_total_pkts / nb_builders);
+  chunk = chunk / bulk * bulk;
+  if (chunk < bulk) {
+    err("%s(%d), too many builders %d for %d pkts\n", __func__, idx, nb_builders,
+        s->st20_total_pkts);
+    return -EINVAL;
+  }
+  s->build_chunk_pkts = chunk;
+
+  for (int i = 0; i < nb_builders; i++) {
+    builder = mt_rte_zmalloc_socket(sizeof(*builder), socket);
+    if (!builder) {
+      err("%s(%d), builder %d malloc fail\n", __func__, idx, i);
+      tv_builders_uinit(s);
+      return -ENOMEM;
+    }
+    s->builders[i] = builder;
+    builder->parent = s;
+    builder->idx = i;
+
+    builder->quota_mbs = quota_mbs / nb_builders;
+    builder->sch = mt_sch_get(impl, builder->quota_mbs, MT_SCH_TYPE_DEFAULT, mask);
+    if (!builder->sch) {
+      err("%s(%d), get sch fail for builder %d\n", __func__, idx, i);
+      tv_builders_uinit(s);
+      return -EIO;
+    }
+    mask &= ~MTL_BIT64(builder->sch->idx);
+
+    snprintf(name, sizeof(name), "%sM%dS%dB%d", ST_TX_VIDEO_PREFIX, mgr_idx, idx, i);
+    builder->ring = rte_ring_create(name, ST_TX_VIDEO_BUILD_RING_SIZE, socket,
+                                    RING_F_SP_ENQ | RING_F_SC_DEQ);
+    if (!builder->ring) {
+      err("%s(%d), ring create fail for builder %d\n", __func__, idx, i);
+      tv_builders_uinit(s);
+      return -ENOMEM;
+    }
+    snprintf(name, sizeof(name), "%sM%dS%dB%d_JOB", ST_TX_VIDEO_PREFIX, mgr_idx, idx, i);
+    builder->job_ring = rte_ring_create(name, ST_TX_VIDEO_BUILD_JOBS * 2, socket,
+                                        RING_F_SP_ENQ | RING_F_SC_DEQ);
+    if (!builder->job_ring) {
+      err("%s(%d), job ring create fail for builder %d\n", __func__, idx, i);
+      tv_builders_uinit(s);
+      return -ENOMEM;
+    }
+
+    struct mt_sch_tasklet_ops ops;
+    memset(&ops, 0x0, sizeof(ops));
+    snprintf(name, sizeof(name), "tv_builder_%d_%d", idx, i);
+    ops.name = name;
+    ops.priv = builder;
+    ops.handler = tv_builder_tasklet_handler;
+    /* a builder only touch its own rings, it can run on any sch */
+    ops.flags = MT_TASKLET_BALANCE;
+    ops.quota_mbs = builder->quota_mbs;
+    builder->tasklet = mt_sch_register_tasklet(builder->sch, &ops);
+    if (!builder->tasklet) {
+      err("%s(%d), tasklet register fail for builder %d\n", __func__, idx, i);
+      tv_builders_uinit(s);
+      return -EIO;
+    }
+    info("%s(%d), builder %d on sch %d\n", __func__, idx, i, builder->sch->idx);
+  }
+
+  /* the session tasklet check it at the start of next frame */
+  rte_smp_wmb();
+  s->nb_builders = nb_builders;
+  info("%s(%d), succ with %d builders, chunk %d pkts\n", __func__, idx, nb_builders,
+       chunk);
+  return 0;
+}
+
 static int tv_tasklet_frame(struct mtl_main_impl* impl,
                             struct st_tx_video_session_impl* s) {
   unsigned int bulk = s->bulk;
@@ -1574,6 +2100,12 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
       struct st20_tx_frame_meta meta;
       uint64_t tsc_start = 0;
 
+      /* the mempool is reset by the admin thread after the builders stopped */
+      if (s->builders_stop_pending) {
+        s->stat_build_ret_code = -STI_FRAME_BUILDER_NOT_READY;
+        return MT_TASKLET_ALL_DONE;
+      }
+
       tv_init_next_meta(s, &meta);
       /* Query next frame buffer idx */
       if (s->time_measure) tsc_start = mt_get_tsc(impl);
@@ -1662,6 +2194,8 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
       if (ops->interlaced) {
         s->second_field = second_field ? false : true;
       }
+      s->build_sharded = (s->nb_builders > 0);
+      if (s->build_sharded) tv_builders_publish(s);
     }
   }
 
@@ -1694,23 +2228,47 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
   struct rte_mbuf* pkts[bulk];
   struct rte_mbuf* pkts_r[bulk];
   struct rte_mbuf* pkts_chain[bulk];
+  struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+  bool alloc_r = send_r && !s->tx_no_chain;
+  unsigned int nb_recycled = 0;
 
-  ret = rte_pktmbuf_alloc_bulk(hdr_pool_p, pkts, bulk);
-  if (ret < 0) {
-    dbg("%s(%d), pkts alloc fail %d\n", __func__, idx, ret);
-    s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
-    return MT_TASKLET_ALL_DONE;
-  }
-
-  if (!s->tx_no_chain) {
-    ret = rte_pktmbuf_alloc_bulk(chain_pool, pkts_chain, bulk);
+  if (s->build_sharded) {
+    /* alloc pkts_r first as the built pkts can't be put back to the builder */
+    if (alloc_r) {
+      ret = rte_pktmbuf_alloc_bulk(hdr_pool_r, pkts_r, bulk);
+      if (ret < 0) {
+        dbg("%s(%d), pkts_r alloc fail %d\n", __func__, idx, ret);
+        s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
+        return MT_TASKLET_ALL_DONE;
+      }
+    }
+    ret = tv_builders_dequeue(s, pkts, bulk);
     if (ret < 0) {
-      dbg("%s(%d), pkts chain alloc fail %d\n", __func__, idx, ret);
-      rte_pktmbuf_free_bulk(pkts, bulk);
+      if (alloc_r) rte_pktmbuf_free_bulk(pkts_r, bulk);
+      s->stat_build_ret_code = -STI_FRAME_BUILDER_NOT_READY;
+      return MT_TASKLET_ALL_DONE;
+    }
+  } else {
+    if (s->recycle)
+      ret = tv_recycle_alloc_bulk(s, hdr_pool_p, pkts, bulk, &nb_recycled);
+    else
+      ret = rte_pktmbuf_alloc_bulk(hdr_pool_p, pkts, bulk);
+    if (ret < 0) {
+      dbg("%s(%d), pkts alloc fail %d\n", __func__, idx, ret);
       s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
       return MT_TASKLET_ALL_DONE;
     }
-    if (send_r) {
+
+    if (!s->tx_no_chain) {
+      ret = rte_pktmbuf_alloc_bulk(chain_pool, pkts_chain, bulk);
+      if (ret < 0) {
+        dbg("%s(%d), pkts chain alloc fail %d\n", __func__, idx, ret);
+        rte_pktmbuf_free_bulk(pkts, bulk);
+        s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
+        return MT_TASKLET_ALL_DONE;
+      }
+    }
+    if (alloc_r) {
       ret = rte_pktmbuf_alloc_bulk(hdr_pool_r, pkts_r, bulk);
       if (ret < 0) {
         dbg("%s(%d), pkts_r alloc fail %d\n", __func__, idx, ret);
@@ -1720,26 +2278,29 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
         return MT_TASKLET_ALL_DONE;
       }
     }
+
+    struct tv_st20_pkt_pos pos;
+    pos.frame = frame_info;
+    pos.hdr = &s->s_hdr[MTL_SESSION_PORT_P];
+    pos.seq_id = s->st20_seq_id;
+    pos.ipv4_packet_id = s->st20_ipv4_packet_id;
+    pos.rtp_time_stamp = pacing->rtp_time_stamp;
+    tv_st20_pos_init(s, s->st20_pkt_idx, &pos);
+    tv_build_st20_bulk(s, pkts, pkts_chain, bulk, &pos, nb_recycled);
+    s->st20_seq_id = pos.seq_id;
+    s->st20_ipv4_packet_id = pos.ipv4_packet_id;
+    if (s->recycle) tv_recycle_hold(s, pkts, bulk);
   }
 
   for (unsigned int i = 0; i < bulk; i++) {
-    st_tx_mbuf_set_priv(pkts[i], &s->st20_frames[s->st20_frame_idx]);
-    if (s->st20_pkt_idx >= s->st20_total_pkts) {
+    if (s->st20_pkt_idx >= s->st20_total_pkts)
       s->stat_pkts_dummy++;
-      if (!s->tx_no_chain) rte_pktmbuf_free(pkts_chain[i]);
-      st_tx_mbuf_set_idx(pkts[i], ST_TX_DUMMY_PKT_IDX);
-    } else {
-      if (s->tx_no_chain)
-        tv_build_st20(s, pkts[i]);
-      else
-        tv_build_st20_chain(s, pkts[i], pkts_chain[i]);
-      st_tx_mbuf_set_idx(pkts[i], s->st20_pkt_idx);
+    else
       s->port_user_stats[MTL_SESSION_PORT_P].build++;
-    }
     pacing_set_mbuf_time_stamp(pkts[i], pacing);
 
     if (send_r) {
-      st_tx_mbuf_set_priv(pkts_r[i], &s->st20_frames[s->st20_frame_idx]);
+      st_tx_mbuf_set_priv(pkts_r[i], frame_info);
       if (s->st20_pkt_idx >= s->st20_total_pkts) {
         st_tx_mbuf_set_idx(pkts_r[i], ST_TX_DUMMY_PKT_IDX);
       } else {
@@ -1797,7 +2358,6 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
     rte_atomic32_inc(&s->stat_frame_cnt);
     if (s->tx_no_chain) {
       /* trigger extbuf free cb since mbuf attach not used */
-      struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
       tv_frame_free_cb(frame_info->addr, frame_info);
     }
 
@@ -2257,6 +2817,8 @@ static int tvs_tasklet_handler(void* priv) {
     if (!s) continue;
 
     if (!s->active) goto exit;
+    /* the queue is used by the rl train now */
+    if (s->pacing_train_pending) goto exit;
 
     if (s->ops.flags & ST20_TX_FLAG_ENABLE_RTCP) tv_tasklet_rtcp(impl, s);
 
@@ -2329,6 +2891,8 @@ static int tv_init_hw(struct mtl_main_impl* impl, struct st_tx_video_sessions_mg
     flow.bytes_per_sec = tv_rl_bps(s);
     mtl_memcpy(&flow.dip_addr, &s->ops.dip_addr[i], MTL_IP_ADDR_LEN);
     flow.dst_port = s->ops.udp_port[i];
+    flow.launch_time = true;
+    flow.launch_time_hold = (st_tx_pacing_way(impl, port) == ST21_TX_PACING_WAY_TSN);
     s->queue[i] = mt_txq_get(impl, port, &flow);
     if (!s->queue[i]) {
       tv_uinit_hw(impl, s);
@@ -2374,7 +2938,7 @@ static int tv_init_hw(struct mtl_main_impl* impl, struct st_tx_video_sessions_mg
       if (!s->st20_pkt_info[j].number) continue;
       info("%s(%d), type %d number %u size %u\n", __func__, idx, j,
            s->st20_pkt_info[j].number, s->st20_pkt_info[j].size);
-      pad = mt_build_pad(impl, pad_mempool, port_id, RTE_ETHER_TYPE_IPV4,
+      pad = mt_build_pad(impl, pad_mempool, port, RTE_ETHER_TYPE_IPV4,
                          s->st20_pkt_info[j].size);
       if (!pad) {
         tv_uinit_hw(impl, s);
@@ -2468,6 +3032,10 @@ static int tv_mempool_init(struct mtl_main_impl* impl,
     } else {
       n = mt_if_nb_tx_desc(impl, port) + s->ring_count;
       if (s->ops.flags & ST20_TX_FLAG_ENABLE_RTCP) n += ST_TX_VIDEO_RTCP_RING_SIZE;
+      if ((i == MTL_SESSION_PORT_P) && (ops->num_builders > 1))
+        n += ops->num_builders * ST_TX_VIDEO_BUILD_RING_SIZE;
+      /* the recycled mbufs are held out of the pool */
+      if ((i == MTL_SESSION_PORT_P) && s->recycle) n += s->recycle_mask + 1;
       if (s->mbuf_mempool_hdr[i]) {
         warn("%s(%d), use previous hdr mempool for port %d\n", __func__, idx, i);
       } else {
@@ -2492,6 +3060,7 @@ static int tv_mempool_init(struct mtl_main_impl* impl,
     n = mt_if_nb_tx_desc(impl, port) + s->ring_count;
     if (s->ops.flags & ST20_TX_FLAG_ENABLE_RTCP) n += ST_TX_VIDEO_RTCP_RING_SIZE;
     if (ops->type == ST20_TYPE_RTP_LEVEL) n += ops->rtp_ring_size;
+    if (ops->num_builders > 1) n += ops->num_builders * ST_TX_VIDEO_BUILD_RING_SIZE;
 
     if (s->tx_mono_pool) {
       s->mbuf_mempool_chain = mt_get_tx_mempool(impl, port);
@@ -2579,6 +3148,7 @@ static int tv_uinit_sw(struct st_tx_video_session_impl* s) {
     s->packet_ring = NULL;
   }
 
+  tv_recycle_uinit(s);
   tv_mempool_free(s);
 
   tv_free_frames(s);
@@ -2625,6 +3195,16 @@ static int tv_init_sw(struct mtl_main_impl* impl, struct st_tx_video_sessions_mg
     tv_init_st22_boxes(impl, s);
   }
 
+  if (mt_has_tx_mbuf_recycle(impl) && !st22_frame_ops && st20_is_frame_type(type) &&
+      !s->tx_mono_pool && !s->mbuf_mempool_reuse_rx[MTL_SESSION_PORT_P]) {
+    ret = tv_recycle_init(impl, s);
+    if (ret < 0) {
+      err("%s(%d), tv_recycle_init fail %d\n", __func__, idx, ret);
+      tv_uinit_sw(s);
+      return ret;
+    }
+  }
+
   /* free the pool if any in previous session */
   tv_mempool_free(s);
   ret = tv_mempool_init(impl, mgr, s);
@@ -2864,7 +3444,7 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
     enum mtl_port port = mt_port_logic2phy(s->port_maps, i);
     s->eth_ipv4_cksum_offload[i] = mt_if_has_offload_ipv4_cksum(impl, port);
     s->eth_has_chain[i] = mt_if_has_multi_seg(impl, port);
-    if (mt_pmd_is_kernel(impl, port) && mt_has_af_xdp_zc(impl)) {
+    if (mt_pmd_is_af_xdp(impl, port) && mt_has_af_xdp_zc(impl)) {
       /* enable zero copy for tx */
       s->mbuf_mempool_reuse_rx[i] = true;
     } else {
@@ -3017,12 +3597,25 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
   s->stat_bytes_tx[MTL_SESSION_PORT_P] = 0;
   s->stat_bytes_tx[MTL_SESSION_PORT_R] = 0;
 
+  for (int i = 0; i < s->nb_builders; i++) {
+    struct st_tx_video_builder* builder = s->builders[i];
+    notice("TX_VIDEO_SESSION(%d,%d): builder %d on sch %d, frames %u pkts %u\n", m_idx,
+           idx, i, builder->sch->idx, builder->stat_frames, builder->stat_pkts_build);
+    builder->stat_frames = 0;
+    builder->stat_pkts_build = 0;
+  }
+
   if (s->stat_pkts_dummy) {
     notice("TX_VIDEO_SESSION(%d,%d): dummy pkts %u, burst %u\n", m_idx, idx,
            s->stat_pkts_dummy, s->stat_pkts_burst_dummy);
     s->stat_pkts_dummy = 0;
     s->stat_pkts_burst_dummy = 0;
   }
+  if (s->stat_pkts_recycled) {
+    notice("TX_VIDEO_SESSION(%d,%d): recycled pkts %u, holding %u\n", m_idx, idx,
+           s->stat_pkts_recycled, s->recycle_tail - s->recycle_head);
+    s->stat_pkts_recycled = 0;
+  }
 
   if (s->stat_epoch_troffset_mismatch) {
     notice("TX_VIDEO_SESSION(%d,%d): mismatch epoch troffset %u\n", m_idx, idx,
@@ -3126,6 +3719,8 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
 static int tv_detach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr* mgr,
                      struct st_tx_video_session_impl* s) {
   tv_stat(mgr, s);
+  /* stop the builders before the frames and mempools are freed */
+  tv_builders_uinit(s);
   /* must uinit hw firstly as frame use shared external buffer */
   tv_uinit_rtcp(s);
   tv_uinit_hw(impl, s);
@@ -3222,6 +3817,8 @@ static int tv_update_dst(struct mtl_main_impl* impl, struct st_tx_video_session_
       return ret;
     }
   }
+  /* the recycled mbufs still have the old hdr */
+  tv_recycle_flush(s);
 
   return 0;
 }
@@ -3265,6 +3862,10 @@ static int tv_mgr_init(struct mtl_main_impl* impl, struct mt_sch_impl* sch,
     rte_spinlock_init(&mgr->mutex[i]);
   }
 
+  /*
+   * no MT_TASKLET_BALANCE, it shares the session locks with the video transmitter of
+   * this sch. Moved apart, the two skip each other's sessions in the try_get.
+   */
   memset(&ops, 0x0, sizeof(ops));
   ops.priv = mgr;
   ops.name = "tx_video_sessions_mgr";
@@ -3408,6 +4009,16 @@ static int tv_ops_check(struct st20_tx_ops* ops) {
     }
   }
 
+  if (ops->num_builders > ST20_TX_BUILDERS_MAX) {
+    err("%s, invalid num_builders %u, should in range [0:%d]\n", __func__,
+        ops->num_builders, ST20_TX_BUILDERS_MAX);
+    return -EINVAL;
+  }
+  if ((ops->num_builders > 1) && (ops->type != ST20_TYPE_FRAME_LEVEL)) {
+    err("%s, builders only for ST20_TYPE_FRAME_LEVEL\n", __func__);
+    return -EINVAL;
+  }
+
   if (st20_is_frame_type(ops->type)) {
     if ((ops->framebuff_cnt < 2) || (ops->framebuff_cnt > ST20_FB_MAX_COUNT)) {
       err("%s, invalid framebuff_cnt %d, should in range [2:%d]\n", __func__,
@@ -3519,6 +4130,43 @@ static int tv_st22_ops_check(struct st22_tx_ops* ops) {
   return 0;
 }
 
+static int tv_mempool_reset(struct mtl_main_impl* impl,
+                            struct st_tx_video_session_impl* s) {
+  int ret;
+
+  tv_recycle_flush(s);
+  tv_mempool_free(s);
+  s->recovery_idx++;
+  ret = tv_mempool_init(impl, s->mgr, s);
+  if (ret < 0) {
+    s->stat_unrecoverable_error++;
+    s->active = false; /* mark current session to dead */
+    if (s->ops.notify_event) s->ops.notify_event(s->ops.priv, ST_EVENT_FATAL_ERROR, NULL);
+    return ret;
+  }
+
+  return 0;
+}
+
+int tx_video_session_stop_builders(struct mtl_main_impl* impl,
+                                   struct st_tx_video_session_impl* s) {
+  int idx = s->idx;
+  int ret;
+
+  if (!s->builders_stop_pending) return 0;
+
+  tv_builders_uinit(s);
+  ret = tv_mempool_reset(impl, s);
+  s->builders_stop_pending = false;
+  if (ret < 0) {
+    err("%s(%d), reset mempool fail\n", __func__, idx);
+    return ret;
+  }
+
+  info("%s(%d), succ, build in session tasklet\n", __func__, idx);
+  return 0;
+}
+
 int st20_tx_queue_fatal_error(struct mtl_main_impl* impl,
                               struct st_tx_video_session_impl* s,
                               enum mtl_session_port s_port) {
@@ -3531,6 +4179,18 @@ int st20_tx_queue_fatal_error(struct mtl_main_impl* impl,
     return -EIO;
   }
 
+  if (s->nb_builders && !s->builders_stop_pending) {
+    /*
+     * the builders still use the mempool, unregister them here will block the sch
+     * thread, leave the stop and the mempool reset to the admin thread
+     */
+    warn("%s(%d,%d), stop builders in admin, build in session tasklet later\n",
+         __func__, idx, s_port);
+    if (s->build_sharded) tv_builders_rewind(s);
+    s->build_sharded = false;
+    s->builders_stop_pending = true;
+  }
+
   /* clear all tx ring buffer */
   if (s->packet_ring) mt_ring_dequeue_clean(s->packet_ring);
   for (uint8_t i = 0; i < s->ops.num_port; i++) {
@@ -3548,6 +4208,8 @@ int st20_tx_queue_fatal_error(struct mtl_main_impl* impl,
   flow.bytes_per_sec = tv_rl_bps(s);
   mtl_memcpy(&flow.dip_addr, &s->ops.dip_addr[s_port], MTL_IP_ADDR_LEN);
   flow.dst_port = s->ops.udp_port[s_port];
+  flow.launch_time = true;
+  flow.launch_time_hold = (st_tx_pacing_way(impl, port) == ST21_TX_PACING_WAY_TSN);
   s->queue[s_port] = mt_txq_get(impl, port, &flow);
   if (!s->queue[s_port]) {
     err("%s(%d,%d), get new txq fail\n", __func__, idx, s_port);
@@ -3572,16 +4234,12 @@ int st20_tx_queue_fatal_error(struct mtl_main_impl* impl,
     }
   }
 
-  /* reset mempool */
-  tv_mempool_free(s);
-  s->recovery_idx++;
-  ret = tv_mempool_init(impl, s->mgr, s);
-  if (ret < 0) {
-    err("%s(%d,%d), reset mempool fail\n", __func__, idx, s_port);
-    s->stat_unrecoverable_error++;
-    s->active = false; /* mark current session to dead */
-    if (s->ops.notify_event) s->ops.notify_event(s->ops.priv, ST_EVENT_FATAL_ERROR, NULL);
-    return ret;
+  if (!s->builders_stop_pending) {
+    ret = tv_mempool_reset(impl, s);
+    if (ret < 0) {
+      err("%s(%d,%d), reset mempool fail\n", __func__, idx, s_port);
+      return ret;
+    }
   }
 
   /* point to next frame */
@@ -3723,6 +4381,27 @@ st20_tx_handle st20_tx_create(mtl_handle mt, struct st20_tx_ops* ops) {
     mt_rte_free(s_impl);
     return NULL;
   }
+  /* out of the mgr lock, other sessions on this sch can create or free meanwhile */
+  ret = tv_train_pacing_ports(impl, s);
+  if (ret < 0) {
+    err("%s(%d), train pacing fail %d\n", __func__, sch->idx, ret);
+    mt_pthread_mutex_lock(&sch->tx_video_mgr_mutex);
+    tv_mgr_detach(&sch->tx_video_mgr, s);
+    tv_mgr_update(&sch->tx_video_mgr);
+    mt_pthread_mutex_unlock(&sch->tx_video_mgr_mutex);
+    mt_sch_put(sch, quota_mbs);
+    mt_rte_free(s_impl);
+    return NULL;
+  }
+
+  if (ops->num_builders > 1) {
+    ret = tv_builders_init(impl, s, sch, quota_mbs);
+    if (ret < 0) {
+      /* not fatal, the session tasklet still can build all pkts */
+      warn("%s(%d), builders init fail %d, build in session tasklet\n", __func__,
+           s->idx, ret);
+    }
+  }
 
   /* update mgr status */
   mt_pthread_mutex_lock(&sch->tx_video_mgr_mutex);
@@ -4174,6 +4853,18 @@ st22_tx_handle st22_tx_create(mtl_handle mt, struct st22_tx_ops* ops) {
     mt_rte_free(s_impl);
     return NULL;
   }
+  /* out of the mgr lock, other sessions on this sch can create or free meanwhile */
+  ret = tv_train_pacing_ports(impl, s);
+  if (ret < 0) {
+    err("%s(%d), train pacing fail %d\n", __func__, sch->idx, ret);
+    mt_pthread_mutex_lock(&sch->tx_video_mgr_mutex);
+    tv_mgr_detach(&sch->tx_video_mgr, s);
+    tv_mgr_update(&sch->tx_video_mgr);
+    mt_pthread_mutex_unlock(&sch->tx_video_mgr_mutex);
+    mt_sch_put(sch, quota_mbs);
+    mt_rte_free(s_impl);
+    return NULL;
+  }
 
   s_impl->parent = impl;
   s_impl->type = MT_ST22_HANDLE_TX_VIDEO;
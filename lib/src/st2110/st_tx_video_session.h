@@ -12,6 +12,11 @@
 #define ST_TX_VIDEO_RTCP_BURST_SIZE (32)
 #define ST_TX_VIDEO_RTCP_RING_SIZE (1024)
 
+/* max pkts of one chunk, the chunks of a frame are built by the builders in turn */
+#define ST_TX_VIDEO_BUILD_CHUNK_PKTS (128)
+/* ring size for the built pkts of each builder, hold two chunks at least */
+#define ST_TX_VIDEO_BUILD_RING_SIZE (512)
+
 int st_tx_video_sessions_sch_init(struct mtl_main_impl* impl, struct mt_sch_impl* sch);
 
 int st_tx_video_sessions_sch_uinit(struct mtl_main_impl* impl, struct mt_sch_impl* sch);
@@ -68,6 +73,10 @@ int st_tx_video_session_migrate(struct mtl_main_impl* impl,
                                 struct st_tx_video_sessions_mgr* mgr,
                                 struct st_tx_video_session_impl* s, int idx);
 
+/* called by the admin thread with the session lock held */
+int tx_video_session_stop_builders(struct mtl_main_impl* impl,
+                                   struct st_tx_video_session_impl* s);
+
 int st20_pacing_static_profiling(struct st_tx_video_session_impl* s);
 
 #endif
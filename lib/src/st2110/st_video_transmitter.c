@@ -596,6 +596,50 @@ static int video_trs_tasklet_handler(void* priv) {
   return pending;
 }
 
+/* the nearest pacing target of all sessions, 0 if any session can go now */
+static uint64_t video_trs_tasklet_deadline(void* priv) {
+  struct st_video_transmitter_impl* trs = priv;
+  struct mtl_main_impl* impl = trs->parent;
+  struct st_tx_video_sessions_mgr* mgr = trs->mgr;
+  struct st_tx_video_session_impl* s;
+  uint64_t deadline = 0, target, cur_tsc = 0, cur_ptp = 0;
+  int sidx, s_port;
+
+  for (sidx = 0; sidx < mgr->max_idx; sidx++) {
+    if (!mgr->sessions[sidx]) continue;
+    s = tx_video_session_try_get(mgr, sidx);
+    if (!s) return 0; /* busy by attach or detach */
+
+    for (s_port = 0; s_port < s->ops.num_port; s_port++) {
+      if (!s->queue[s_port]) continue;
+      /* the rl pkts the nic refused last time are retried ahead of the target */
+      if (s->trs_inflight_num2[s_port]) {
+        tx_video_session_put(mgr, sidx);
+        return 0;
+      }
+      /*
+       * the other inflight pkts wait the target if any, a passed target is due now
+       * already. No target means a ring dequeue or a nic retry pending, go now.
+       */
+      target = s->trs_target_tsc[s_port];
+      if (!target) {
+        tx_video_session_put(mgr, sidx);
+        return 0;
+      }
+      if (!cur_tsc) cur_tsc = mt_get_tsc(impl);
+      if (s->pacing_way[s_port] == ST21_TX_PACING_WAY_PTP) {
+        /* the ptp tasklet save the ptp time, convert to the tsc time */
+        if (!cur_ptp) cur_ptp = mt_get_ptp_time(impl, MTL_PORT_P);
+        target = (target > cur_ptp) ? (cur_tsc + target - cur_ptp) : cur_tsc;
+      }
+      if (!deadline || target < deadline) deadline = target;
+    }
+    tx_video_session_put(mgr, sidx);
+  }
+
+  return deadline;
+}
+
 int st_video_resolve_pacing_tasklet(struct st_tx_video_session_impl* s,
                                     enum mtl_session_port port) {
   int idx = s->idx;
@@ -636,6 +680,8 @@ int st_video_transmitter_init(struct mtl_main_impl* impl, struct mt_sch_impl* sc
   ops.start = video_trs_tasklet_start;
   ops.stop = video_trs_tasklet_stop;
   ops.handler = video_trs_tasklet_handler;
+  ops.deadline = video_trs_tasklet_deadline;
+  /* stay with tx_video_sessions_mgr, see the note there */
 
   trs->tasklet = mt_sch_register_tasklet(sch, &ops);
   if (!trs->tasklet) {
@@ -357,6 +357,8 @@ static int urc_init_tasklet(struct mtl_main_impl* impl, struct mur_client* c) {
   ops.priv = c;
   ops.name = name;
   ops.handler = urc_tasklet_handler;
+  /* it only poll the queue of this client, it can run on any sch */
+  ops.flags = MT_TASKLET_BALANCE;
 
   c->lcore_tasklet = mt_sch_register_tasklet(impl->main_sch, &ops);
   if (!c->lcore_tasklet) {
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright 2023 Intel Corporation
+
+# Loop test through the native af_packet socket backend on a veth pair, no NIC needed.
+# Run from the top dir with root after the build.
+
+set -e
+
+VETH_0=mtl_veth0
+VETH_1=mtl_veth1
+
+cleanup() {
+  ip link del ${VETH_0} 2>/dev/null || true
+}
+trap cleanup EXIT
+
+echo "Create veth pair ${VETH_0} ${VETH_1}"
+cleanup
+ip link add ${VETH_0} type veth peer name ${VETH_1}
+ip addr add 192.168.109.101/24 dev ${VETH_0}
+ip addr add 192.168.109.102/24 dev ${VETH_1}
+ip link set ${VETH_0} up
+ip link set ${VETH_1} up
+sysctl -w net.ipv4.conf.all.rp_filter=0
+
+./build/tests/KahawaiTest --p_port ${VETH_0} --r_port ${VETH_1} --af_packet \
+  --gtest_filter="St30_rx.af_packet_loopback"
+echo "Test OK"
@@ -2,6 +2,8 @@
  * Copyright(c) 2022 Intel Corporation
  */
 
+#include <thread>
+
 #include "log.h"
 #include "tests.h"
 
@@ -2319,6 +2321,38 @@ TEST(Cvt, yuv422p12le_to_rfc4175_422be12_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, yuv422p12le_to_rfc4175_422be12_avx512) {
+  test_cvt_yuv422p12le_to_rfc4175_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_yuv422p12le_to_rfc4175_422be12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                            MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, yuv422p12le_to_rfc4175_422be12_avx2) {
+  test_cvt_yuv422p12le_to_rfc4175_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_yuv422p12le_to_rfc4175_422be12(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 static void test_cvt_rfc4175_422le12_to_yuv422p12le(int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -2641,6 +2675,110 @@ TEST(Cvt, rfc4175_422le12_to_422be12_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422le12_to_422be12_avx512) {
+  test_cvt_rfc4175_422le12_to_422be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_NONE,
+                                        MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422le12_to_422be12_2(w, h, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_422le12_to_422be12_avx2) {
+  test_cvt_rfc4175_422le12_to_422be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_NONE,
+                                        MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422le12_to_422be12_2(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+static void test_cvt_rfc4175_422le12_to_422be12_dma(mtl_udma_handle dma, int w, int h,
+                                                    enum mtl_simd_level cvt_level,
+                                                    enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 6 / 2;
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle st = ctx->handle;
+  struct st20_rfc4175_422_12_pg2_le* pg_le =
+      (struct st20_rfc4175_422_12_pg2_le*)mtl_hp_zmalloc(st, fb_pg2_size, MTL_PORT_P);
+  struct st20_rfc4175_422_12_pg2_be* pg_be =
+      (struct st20_rfc4175_422_12_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  struct st20_rfc4175_422_12_pg2_be* pg_be_2 =
+      (struct st20_rfc4175_422_12_pg2_be*)st_test_zmalloc(fb_pg2_size);
+
+  if (!pg_be || !pg_le || !pg_be_2) {
+    EXPECT_EQ(0, 1);
+    if (pg_be) st_test_free(pg_be);
+    if (pg_le) mtl_hp_free(st, pg_le);
+    if (pg_be_2) st_test_free(pg_be_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg_le, fb_pg2_size, 0);
+
+  ret = st20_rfc4175_422le12_to_422be12_simd(pg_le, pg_be, w, h, back_level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422le12_to_422be12_simd_dma(dma, pg_le, mtl_hp_virt2iova(st, pg_le),
+                                                 pg_be_2, w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(pg_be, pg_be_2, fb_pg2_size));
+
+  st_test_free(pg_be);
+  mtl_hp_free(st, pg_le);
+  st_test_free(pg_be_2);
+}
+
+TEST(Cvt, rfc4175_422le12_to_422be12_dma) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  mtl_udma_handle dma = mtl_udma_create(handle, 128, MTL_PORT_P);
+  if (!dma) return;
+
+  test_cvt_rfc4175_422le12_to_422be12_dma(dma, 1920, 1080, MTL_SIMD_LEVEL_MAX,
+                                          MTL_SIMD_LEVEL_MAX);
+
+  mtl_udma_free(dma);
+}
+
+TEST(Cvt, rfc4175_422le12_to_422be12_avx512_dma) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  mtl_udma_handle dma = mtl_udma_create(handle, 128, MTL_PORT_P);
+  if (!dma) return;
+
+  test_cvt_rfc4175_422le12_to_422be12_dma(dma, 1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12_dma(dma, 722, 111, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12_dma(dma, 722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12_dma(dma, 722, 111, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422le12_to_422be12_dma(dma, w, h, MTL_SIMD_LEVEL_AVX512,
+                                            MTL_SIMD_LEVEL_AVX512);
+  }
+
+  mtl_udma_free(dma);
+}
+
 static void test_rotate_rfc4175_422be12_422le12_yuv422p12le(
     int w, int h, enum mtl_simd_level cvt1_level, enum mtl_simd_level cvt2_level,
     enum mtl_simd_level cvt3_level) {
@@ -2786,6 +2924,112 @@ TEST(Cvt, rfc4175_444be10_to_444p10le_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx512) {
+  test_cvt_rfc4175_444be10_to_444p10le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx2) {
+  test_cvt_rfc4175_444be10_to_444p10le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+static void test_cvt_rfc4175_444be10_to_444p10le_dma(mtl_udma_handle dma, int w, int h,
+                                                     enum mtl_simd_level cvt_level,
+                                                     enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg4_size = (size_t)w * h * 15 / 4;
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle st = ctx->handle;
+  struct st20_rfc4175_444_10_pg4_be* pg =
+      (struct st20_rfc4175_444_10_pg4_be*)mtl_hp_zmalloc(st, fb_pg4_size, MTL_PORT_P);
+  struct st20_rfc4175_444_10_pg4_be* pg_2 =
+      (struct st20_rfc4175_444_10_pg4_be*)st_test_zmalloc(fb_pg4_size);
+  size_t planar_size = (size_t)w * h * 3 * sizeof(uint16_t);
+  uint16_t* p10_u16 = (uint16_t*)st_test_zmalloc(planar_size);
+
+  if (!pg || !pg_2 || !p10_u16) {
+    EXPECT_EQ(0, 1);
+    if (pg) mtl_hp_free(st, pg);
+    if (pg_2) st_test_free(pg_2);
+    if (p10_u16) st_test_free(p10_u16);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg, fb_pg4_size, 0);
+
+  ret = st20_rfc4175_444be10_to_444p10le_simd_dma(
+      dma, pg, mtl_hp_virt2iova(st, pg), p10_u16, (p10_u16 + w * h),
+      (p10_u16 + w * h * 2), w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_444p10le_to_rfc4175_444be10_simd(
+      p10_u16, (p10_u16 + w * h), (p10_u16 + w * h * 2), pg_2, w, h, back_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(pg, pg_2, fb_pg4_size));
+
+  mtl_hp_free(st, pg);
+  st_test_free(pg_2);
+  st_test_free(p10_u16);
+}
+
+TEST(Cvt, rfc4175_444be10_to_444p10le_dma) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  mtl_udma_handle dma = mtl_udma_create(handle, 128, MTL_PORT_P);
+  if (!dma) return;
+
+  test_cvt_rfc4175_444be10_to_444p10le_dma(dma, 1920, 1080, MTL_SIMD_LEVEL_MAX,
+                                           MTL_SIMD_LEVEL_MAX);
+
+  mtl_udma_free(dma);
+}
+
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx512_dma) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  mtl_udma_handle dma = mtl_udma_create(handle, 128, MTL_PORT_P);
+  if (!dma) return;
+
+  test_cvt_rfc4175_444be10_to_444p10le_dma(dma, 1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                           MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le_dma(dma, 724, 111, MTL_SIMD_LEVEL_AVX512,
+                                           MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le_dma(dma, 724, 111, MTL_SIMD_LEVEL_NONE,
+                                           MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le_dma(dma, 724, 111, MTL_SIMD_LEVEL_AVX512,
+                                           MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le_dma(dma, w, h, MTL_SIMD_LEVEL_AVX512,
+                                             MTL_SIMD_LEVEL_AVX512);
+  }
+
+  mtl_udma_free(dma);
+}
+
 static void test_cvt_444p10le_to_rfc4175_444be10(int w, int h,
                                                  enum mtl_simd_level cvt_level,
                                                  enum mtl_simd_level back_level) {
@@ -2834,6 +3078,37 @@ TEST(Cvt, 444p10le_to_rfc4175_444be10_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, 444p10le_to_rfc4175_444be10_avx512) {
+  test_cvt_444p10le_to_rfc4175_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p10le_to_rfc4175_444be10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, 444p10le_to_rfc4175_444be10_avx2) {
+  test_cvt_444p10le_to_rfc4175_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p10le_to_rfc4175_444be10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 static void test_cvt_rfc4175_444le10_to_yuv444p10le(int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -3295,6 +3570,112 @@ TEST(Cvt, rfc4175_444be12_to_444p12le_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx512) {
+  test_cvt_rfc4175_444be12_to_444p12le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx2) {
+  test_cvt_rfc4175_444be12_to_444p12le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+static void test_cvt_rfc4175_444be12_to_444p12le_dma(mtl_udma_handle dma, int w, int h,
+                                                     enum mtl_simd_level cvt_level,
+                                                     enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 9 / 2;
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle st = ctx->handle;
+  struct st20_rfc4175_444_12_pg2_be* pg =
+      (struct st20_rfc4175_444_12_pg2_be*)mtl_hp_zmalloc(st, fb_pg2_size, MTL_PORT_P);
+  struct st20_rfc4175_444_12_pg2_be* pg_2 =
+      (struct st20_rfc4175_444_12_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t planar_size = (size_t)w * h * 3 * sizeof(uint16_t);
+  uint16_t* p12_u16 = (uint16_t*)st_test_zmalloc(planar_size);
+
+  if (!pg || !pg_2 || !p12_u16) {
+    EXPECT_EQ(0, 1);
+    if (pg) mtl_hp_free(st, pg);
+    if (pg_2) st_test_free(pg_2);
+    if (p12_u16) st_test_free(p12_u16);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg, fb_pg2_size, 0);
+
+  ret = st20_rfc4175_444be12_to_444p12le_simd_dma(
+      dma, pg, mtl_hp_virt2iova(st, pg), p12_u16, (p12_u16 + w * h),
+      (p12_u16 + w * h * 2), w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_444p12le_to_rfc4175_444be12_simd(
+      p12_u16, (p12_u16 + w * h), (p12_u16 + w * h * 2), pg_2, w, h, back_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(pg, pg_2, fb_pg2_size));
+
+  mtl_hp_free(st, pg);
+  st_test_free(pg_2);
+  st_test_free(p12_u16);
+}
+
+TEST(Cvt, rfc4175_444be12_to_444p12le_dma) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  mtl_udma_handle dma = mtl_udma_create(handle, 128, MTL_PORT_P);
+  if (!dma) return;
+
+  test_cvt_rfc4175_444be12_to_444p12le_dma(dma, 1920, 1080, MTL_SIMD_LEVEL_MAX,
+                                           MTL_SIMD_LEVEL_MAX);
+
+  mtl_udma_free(dma);
+}
+
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx512_dma) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  mtl_udma_handle dma = mtl_udma_create(handle, 128, MTL_PORT_P);
+  if (!dma) return;
+
+  test_cvt_rfc4175_444be12_to_444p12le_dma(dma, 1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                           MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le_dma(dma, 722, 111, MTL_SIMD_LEVEL_AVX512,
+                                           MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le_dma(dma, 722, 111, MTL_SIMD_LEVEL_NONE,
+                                           MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le_dma(dma, 722, 111, MTL_SIMD_LEVEL_AVX512,
+                                           MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le_dma(dma, w, h, MTL_SIMD_LEVEL_AVX512,
+                                             MTL_SIMD_LEVEL_AVX512);
+  }
+
+  mtl_udma_free(dma);
+}
+
 static void test_cvt_444p12le_to_rfc4175_444be12(int w, int h,
                                                  enum mtl_simd_level cvt_level,
                                                  enum mtl_simd_level back_level) {
@@ -3343,12 +3724,43 @@ TEST(Cvt, 444p12le_to_rfc4175_444be12_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
-static void test_cvt_rfc4175_444le12_to_yuv444p12le(int w, int h,
-                                                    enum mtl_simd_level cvt_level,
-                                                    enum mtl_simd_level back_level) {
-  int ret;
-  size_t fb_pg2_size = (size_t)w * h * 9 / 2;
-  struct st20_rfc4175_444_12_pg2_le* pg =
+TEST(Cvt, 444p12le_to_rfc4175_444be12_avx512) {
+  test_cvt_444p12le_to_rfc4175_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p12le_to_rfc4175_444be12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, 444p12le_to_rfc4175_444be12_avx2) {
+  test_cvt_444p12le_to_rfc4175_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p12le_to_rfc4175_444be12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+static void test_cvt_rfc4175_444le12_to_yuv444p12le(int w, int h,
+                                                    enum mtl_simd_level cvt_level,
+                                                    enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 9 / 2;
+  struct st20_rfc4175_444_12_pg2_le* pg =
       (struct st20_rfc4175_444_12_pg2_le*)st_test_zmalloc(fb_pg2_size);
   struct st20_rfc4175_444_12_pg2_le* pg_2 =
       (struct st20_rfc4175_444_12_pg2_le*)st_test_zmalloc(fb_pg2_size);
@@ -3757,227 +4169,963 @@ TEST(Cvt, rotate_rfc4175_444be12_444p12le_444le12_scalar) {
                                                MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
-static void test_am824_to_aes3(int blocks) {
+static void test_cvt_yuv420p10le_to_rfc4175_422be10(int w, int h,
+                                                    enum mtl_simd_level cvt_level,
+                                                    enum mtl_simd_level back_level) {
   int ret;
-  int subframes = blocks * 2 * 192;
-  size_t blocks_size = subframes * 4;
-  struct st31_aes3* b_aes3 = (struct st31_aes3*)st_test_zmalloc(blocks_size);
-  struct st31_am824* b_am824 = (struct st31_am824*)st_test_zmalloc(blocks_size);
-  struct st31_am824* b_am824_2 = (struct st31_am824*)st_test_zmalloc(blocks_size);
-  if (!b_aes3 || !b_am824 || !b_am824_2) {
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint16_t);
+  uint16_t* p10 = (uint16_t*)st_test_zmalloc(p420_size);
+  uint16_t* p10_2 = (uint16_t*)st_test_zmalloc(p420_size);
+
+  if (!pg || !p10 || !p10_2) {
     EXPECT_EQ(0, 1);
-    if (b_aes3) st_test_free(b_aes3);
-    if (b_am824) st_test_free(b_am824);
-    if (b_am824_2) st_test_free(b_am824_2);
+    if (pg) st_test_free(pg);
+    if (p10) st_test_free(p10);
+    if (p10_2) st_test_free(p10_2);
     return;
   }
 
-  st_test_rand_data((uint8_t*)b_am824, blocks_size, 0);
-  /* set 'b' and 'f' for subframes */
-  struct st31_am824* sf_am824 = b_am824;
-  for (int i = 0; i < subframes; i++) {
-    sf_am824->unused = 0;
-    if (i % (192 * 2) == 0) {
-      sf_am824->b = 1;
-      sf_am824->f = 1;
-    } else if (i % 2 == 0) {
-      sf_am824->b = 0;
-      sf_am824->f = 1;
-    } else {
-      sf_am824->b = 0;
-      sf_am824->f = 0;
-    }
-    sf_am824++;
+  for (size_t i = 0; i < (p420_size / 2); i++) {
+    p10[i] = rand() & 0x3ff; /* only 10 bit */
   }
 
-  ret = st31_am824_to_aes3(b_am824, b_aes3, subframes);
+  /* the chroma line duplicated to two lines then averaged back to the same */
+  ret = st20_yuv420p10le_to_rfc4175_422be10_simd(p10, (p10 + w * h),
+                                                 (p10 + w * h * 5 / 4), pg, w, h,
+                                                 cvt_level);
   EXPECT_EQ(0, ret);
 
-  ret = st31_aes3_to_am824(b_aes3, b_am824_2, subframes);
+  ret = st20_rfc4175_422be10_to_yuv420p10le_simd(pg, p10_2, (p10_2 + w * h),
+                                                 (p10_2 + w * h * 5 / 4), w, h,
+                                                 back_level);
   EXPECT_EQ(0, ret);
 
-  EXPECT_EQ(0, memcmp(b_am824, b_am824_2, blocks_size));
+  EXPECT_EQ(0, memcmp(p10, p10_2, p420_size));
 
-  st_test_free(b_aes3);
-  st_test_free(b_am824);
-  st_test_free(b_am824_2);
+  st_test_free(pg);
+  st_test_free(p10);
+  st_test_free(p10_2);
 }
 
-TEST(Cvt, st31_am824_to_aes3) {
-  test_am824_to_aes3(1);
-  test_am824_to_aes3(10);
-  test_am824_to_aes3(100);
+TEST(Cvt, yuv420p10le_to_rfc4175_422be10) {
+  test_cvt_yuv420p10le_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_MAX,
+                                          MTL_SIMD_LEVEL_MAX);
 }
 
-static void test_aes3_to_am824(int blocks) {
+TEST(Cvt, yuv420p10le_to_rfc4175_422be10_scalar) {
+  test_cvt_yuv420p10le_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_NONE);
+}
+
+TEST(Cvt, yuv420p10le_to_rfc4175_422be10_avx512) {
+  test_cvt_yuv420p10le_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv420p10le_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv420p10le_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv420p10le_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_NONE);
+  int h = 2; /* each chroma line covers two lines */
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_yuv420p10le_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                            MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_rfc4175_422be10_to_yuv420p10le(int w, int h,
+                                                    enum mtl_simd_level level) {
   int ret;
-  int subframes = blocks * 2 * 192;
-  size_t blocks_size = subframes * 4;
-  struct st31_aes3* b_aes3 = (struct st31_aes3*)st_test_zmalloc(blocks_size);
-  struct st31_am824* b_am824 = (struct st31_am824*)st_test_zmalloc(blocks_size);
-  struct st31_aes3* b_aes3_2 = (struct st31_aes3*)st_test_zmalloc(blocks_size);
-  if (!b_aes3 || !b_am824 || !b_aes3_2) {
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint16_t);
+  uint16_t* p10 = (uint16_t*)st_test_zmalloc(p420_size);
+  uint16_t* p10_2 = (uint16_t*)st_test_zmalloc(p420_size);
+
+  if (!pg || !p10 || !p10_2) {
     EXPECT_EQ(0, 1);
-    if (b_aes3) st_test_free(b_aes3);
-    if (b_am824) st_test_free(b_am824);
-    if (b_aes3_2) st_test_free(b_aes3_2);
+    if (pg) st_test_free(pg);
+    if (p10) st_test_free(p10);
+    if (p10_2) st_test_free(p10_2);
     return;
   }
 
-  st_test_rand_data((uint8_t*)b_am824, blocks_size, 0);
-  /* set 'b' and 'f' for subframes */
-  struct st31_aes3* sf_aes3 = b_aes3;
-  for (int i = 0; i < subframes; i++) {
-    if (i % (192 * 2) == 0) {
-      sf_aes3->preamble = 0x2;
-    } else if (i % 2 == 0) {
-      sf_aes3->preamble = 0x0;
-    } else {
-      sf_aes3->preamble = 0x1;
-    }
-    sf_aes3++;
-  }
+  st_test_rand_data((uint8_t*)pg, fb_pg2_size, 0);
 
-  ret = st31_aes3_to_am824(b_aes3, b_am824, subframes);
+  /* the vertical chroma average should be same as the scalar */
+  ret = st20_rfc4175_422be10_to_yuv420p10le_simd(pg, p10, (p10 + w * h),
+                                                 (p10 + w * h * 5 / 4), w, h, level);
   EXPECT_EQ(0, ret);
 
-  ret = st31_am824_to_aes3(b_am824, b_aes3_2, subframes);
+  ret = st20_rfc4175_422be10_to_yuv420p10le_simd(pg, p10_2, (p10_2 + w * h),
+                                                 (p10_2 + w * h * 5 / 4), w, h,
+                                                 MTL_SIMD_LEVEL_NONE);
   EXPECT_EQ(0, ret);
 
-  EXPECT_EQ(0, memcmp(b_aes3, b_aes3_2, blocks_size));
-
-  st_test_free(b_aes3);
-  st_test_free(b_am824);
-  st_test_free(b_aes3_2);
-}
+  EXPECT_EQ(0, memcmp(p10, p10_2, p420_size));
 
-TEST(Cvt, st31_aes3_to_am824) {
-  test_aes3_to_am824(1);
-  test_aes3_to_am824(10);
-  test_aes3_to_am824(100);
+  st_test_free(pg);
+  st_test_free(p10);
+  st_test_free(p10_2);
 }
 
-static void frame_malloc(struct st_frame* frame, uint8_t rand, bool align) {
-  int planes = st_frame_fmt_planes(frame->fmt);
-  size_t fb_size = 0;
-  for (int plane = 0; plane < planes; plane++) {
-    size_t least_line_size = st_frame_least_linesize(frame->fmt, frame->width, plane);
-    frame->linesize[plane] = align ? MTL_ALIGN(least_line_size, 512) : least_line_size;
-    fb_size += frame->linesize[plane] * frame->height;
-  }
-  uint8_t* fb = (uint8_t*)st_test_zmalloc(fb_size);
-  if (!fb) return;
-  if (rand) { /* fill the framebuffer */
-    st_test_rand_data(fb, fb_size, rand);
-    if (frame->fmt == ST_FRAME_FMT_YUV422PLANAR10LE) {
-      /* only LSB 10 valid */
-      uint16_t* p10_u16 = (uint16_t*)fb;
-      for (size_t j = 0; j < (fb_size / 2); j++) {
-        p10_u16[j] &= 0x3ff; /* only 10 bit */
-      }
-    } else if (frame->fmt == ST_FRAME_FMT_Y210) {
-      /* only MSB 10 valid */
-      uint16_t* y210_u16 = (uint16_t*)fb;
-      for (size_t j = 0; j < (fb_size / 2); j++) {
-        y210_u16[j] &= 0xffc0; /* only 10 bit */
-      }
-    } else if (frame->fmt == ST_FRAME_FMT_V210) {
-      uint32_t* v210_word = (uint32_t*)fb;
-      for (size_t j = 0; j < (fb_size / 4); j++) {
-        v210_word[j] &= 0x3fffffff; /* only 30 bit */
-      }
-    }
-  }
-  for (int plane = 0; plane < planes; plane++) {
-    if (plane == 0)
-      frame->addr[plane] = fb;
-    else
-      frame->addr[plane] =
-          (uint8_t*)frame->addr[plane - 1] + st_frame_plane_size(frame, plane - 1);
+TEST(Cvt, rfc4175_422be10_to_yuv420p10le_avx512) {
+  test_cvt_rfc4175_422be10_to_yuv420p10le(1920, 1080, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422be10_to_yuv420p10le(722, 112, MTL_SIMD_LEVEL_AVX512);
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_rfc4175_422be10_to_yuv420p10le(w, 2, MTL_SIMD_LEVEL_AVX512);
   }
-  frame->data_size = frame->buffer_size = fb_size;
 }
 
-static void frame_free(struct st_frame* frame) {
-  if (frame->addr[0]) st_test_free(frame->addr[0]);
-  int planes = st_frame_fmt_planes(frame->fmt);
-  for (int plane = 0; plane < planes; plane++) {
-    frame->addr[plane] = NULL;
-  }
-}
+static void test_cvt_yuv420p8_to_rfc4175_422be10(int w, int h,
+                                                 enum mtl_simd_level cvt_level,
+                                                 enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint8_t);
+  uint8_t* p8 = (uint8_t*)st_test_zmalloc(p420_size);
+  uint8_t* p8_2 = (uint8_t*)st_test_zmalloc(p420_size);
 
-static int frame_compare_each_line(struct st_frame* old_frame,
-                                   struct st_frame* new_frame) {
-  int ret = 0;
-  int planes = st_frame_fmt_planes(old_frame->fmt);
-  for (int plane = 0; plane < planes; plane++) {
-    for (uint32_t line = 0; line < old_frame->height; line++) {
-      uint8_t* old_addr =
-          (uint8_t*)old_frame->addr[plane] + old_frame->linesize[plane] * line;
-      uint8_t* new_addr =
-          (uint8_t*)new_frame->addr[plane] + new_frame->linesize[plane] * line;
-      ret += memcmp(old_addr, new_addr,
-                    st_frame_least_linesize(old_frame->fmt, old_frame->width, plane));
-    }
+  if (!pg || !p8 || !p8_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (p8) st_test_free(p8);
+    if (p8_2) st_test_free(p8_2);
+    return;
   }
 
-  return ret;
+  st_test_rand_data(p8, p420_size, 0);
+
+  /* the chroma line duplicated to two lines then averaged back to the same */
+  ret = st20_yuv420p8_to_rfc4175_422be10_simd(p8, (p8 + w * h), (p8 + w * h * 5 / 4), pg,
+                                              w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422be10_to_yuv420p8_simd(pg, p8_2, (p8_2 + w * h),
+                                              (p8_2 + w * h * 5 / 4), w, h, back_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(p8, p8_2, p420_size));
+
+  st_test_free(pg);
+  st_test_free(p8);
+  st_test_free(p8_2);
 }
 
-static void test_st_frame_convert(struct st_frame* src, struct st_frame* dst,
-                                  struct st_frame* new_src, bool expect_fail) {
-  int ret;
-  ret = st_frame_convert(src, dst);
-  if (expect_fail)
-    EXPECT_NE(0, ret);
-  else
-    EXPECT_EQ(0, ret);
+TEST(Cvt, yuv420p8_to_rfc4175_422be10) {
+  test_cvt_yuv420p8_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_MAX,
+                                       MTL_SIMD_LEVEL_MAX);
+}
 
-  ret = st_frame_convert(dst, new_src);
-  if (expect_fail)
-    EXPECT_NE(0, ret);
-  else
-    EXPECT_EQ(0, ret);
+TEST(Cvt, yuv420p8_to_rfc4175_422be10_scalar) {
+  test_cvt_yuv420p8_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_NONE);
+}
 
-  if (!expect_fail) {
-    ret = frame_compare_each_line(src, new_src);
-    EXPECT_EQ(0, ret);
+TEST(Cvt, yuv420p8_to_rfc4175_422be10_avx512) {
+  test_cvt_yuv420p8_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv420p8_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv420p8_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv420p8_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int h = 2; /* each chroma line covers two lines */
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_yuv420p8_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
   }
 }
 
-TEST(Cvt, st_frame_convert_fail_resolution) {
-  struct st_frame src, dst, new_src;
-  src.fmt = new_src.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
-  dst.fmt = ST_FRAME_FMT_Y210;
+static void test_cvt_rfc4175_422be10_to_yuv420p8(int w, int h,
+                                                 enum mtl_simd_level level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint8_t);
+  uint8_t* p8 = (uint8_t*)st_test_zmalloc(p420_size);
+  uint8_t* p8_2 = (uint8_t*)st_test_zmalloc(p420_size);
 
-  src.width = new_src.width = dst.width = 1920;
-  src.height = new_src.height = 1080;
-  dst.height = 1088;
-  test_st_frame_convert(&src, &dst, &new_src, true);
+  if (!pg || !p8 || !p8_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (p8) st_test_free(p8);
+    if (p8_2) st_test_free(p8_2);
+    return;
+  }
 
-  src.width = new_src.width = 1920;
-  dst.width = 1280;
-  src.height = new_src.height = dst.height = 1080;
-  test_st_frame_convert(&src, &dst, &new_src, true);
+  st_test_rand_data((uint8_t*)pg, fb_pg2_size, 0);
 
-  src.width = new_src.width = 1920;
-  src.height = new_src.height = 1080;
-  dst.width = 3840;
-  dst.height = 2160;
-  test_st_frame_convert(&src, &dst, &new_src, true);
-}
+  /* the vertical chroma average should be same as the scalar */
+  ret = st20_rfc4175_422be10_to_yuv420p8_simd(pg, p8, (p8 + w * h), (p8 + w * h * 5 / 4),
+                                              w, h, level);
+  EXPECT_EQ(0, ret);
 
-TEST(Cvt, st_frame_convert_fail_fmt) {
-  struct st_frame src, dst, new_src;
+  ret = st20_rfc4175_422be10_to_yuv420p8_simd(pg, p8_2, (p8_2 + w * h),
+                                              (p8_2 + w * h * 5 / 4), w, h,
+                                              MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
 
-  src.width = new_src.width = dst.width = 1920;
-  src.height = new_src.height = dst.height = 1080;
+  EXPECT_EQ(0, memcmp(p8, p8_2, p420_size));
 
-  src.fmt = new_src.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
-  dst.fmt = ST_FRAME_FMT_YUV444PLANAR10LE;
-  test_st_frame_convert(&src, &dst, &new_src, true);
+  st_test_free(pg);
+  st_test_free(p8);
+  st_test_free(p8_2);
+}
 
-  src.fmt = new_src.fmt = ST_FRAME_FMT_Y210;
+TEST(Cvt, rfc4175_422be10_to_yuv420p8_avx512) {
+  test_cvt_rfc4175_422be10_to_yuv420p8(1920, 1080, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422be10_to_yuv420p8(722, 112, MTL_SIMD_LEVEL_AVX512);
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_rfc4175_422be10_to_yuv420p8(w, 2, MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_nv12_to_rfc4175_422be10(int w, int h,
+                                             enum mtl_simd_level cvt_level,
+                                             enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint8_t);
+  uint8_t* p8 = (uint8_t*)st_test_zmalloc(p420_size);
+  uint8_t* p8_2 = (uint8_t*)st_test_zmalloc(p420_size);
+
+  if (!pg || !p8 || !p8_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (p8) st_test_free(p8);
+    if (p8_2) st_test_free(p8_2);
+    return;
+  }
+
+  st_test_rand_data(p8, p420_size, 0);
+
+  /* the chroma line duplicated to two lines then averaged back to the same */
+  ret = st20_nv12_to_rfc4175_422be10_simd(p8, (p8 + w * h), pg, w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422be10_to_nv12_simd(pg, p8_2, (p8_2 + w * h), w, h, back_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(p8, p8_2, p420_size));
+
+  st_test_free(pg);
+  st_test_free(p8);
+  st_test_free(p8_2);
+}
+
+TEST(Cvt, nv12_to_rfc4175_422be10) {
+  test_cvt_nv12_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_MAX, MTL_SIMD_LEVEL_MAX);
+}
+
+TEST(Cvt, nv12_to_rfc4175_422be10_scalar) {
+  test_cvt_nv12_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
+}
+
+TEST(Cvt, nv12_to_rfc4175_422be10_avx512) {
+  test_cvt_nv12_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                   MTL_SIMD_LEVEL_AVX512);
+  test_cvt_nv12_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512,
+                                   MTL_SIMD_LEVEL_AVX512);
+  test_cvt_nv12_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_nv12_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_NONE);
+  int h = 2; /* each chroma line covers two lines */
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_nv12_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_rfc4175_422be10_to_nv12(int w, int h, enum mtl_simd_level level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint8_t);
+  uint8_t* p8 = (uint8_t*)st_test_zmalloc(p420_size);
+  uint8_t* p8_2 = (uint8_t*)st_test_zmalloc(p420_size);
+
+  if (!pg || !p8 || !p8_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (p8) st_test_free(p8);
+    if (p8_2) st_test_free(p8_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg, fb_pg2_size, 0);
+
+  /* the vertical chroma average should be same as the scalar */
+  ret = st20_rfc4175_422be10_to_nv12_simd(pg, p8, (p8 + w * h), w, h, level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422be10_to_nv12_simd(pg, p8_2, (p8_2 + w * h), w, h,
+                                          MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(p8, p8_2, p420_size));
+
+  st_test_free(pg);
+  st_test_free(p8);
+  st_test_free(p8_2);
+}
+
+TEST(Cvt, rfc4175_422be10_to_nv12_avx512) {
+  test_cvt_rfc4175_422be10_to_nv12(1920, 1080, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422be10_to_nv12(722, 112, MTL_SIMD_LEVEL_AVX512);
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_rfc4175_422be10_to_nv12(w, 2, MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_p010_to_rfc4175_422be10(int w, int h,
+                                             enum mtl_simd_level cvt_level,
+                                             enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint16_t);
+  uint16_t* p10 = (uint16_t*)st_test_zmalloc(p420_size);
+  uint16_t* p10_2 = (uint16_t*)st_test_zmalloc(p420_size);
+
+  if (!pg || !p10 || !p10_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (p10) st_test_free(p10);
+    if (p10_2) st_test_free(p10_2);
+    return;
+  }
+
+  for (size_t i = 0; i < (p420_size / 2); i++) {
+    p10[i] = rand() & 0xffc0; /* only MSB 10 bit */
+  }
+
+  /* the chroma line duplicated to two lines then averaged back to the same */
+  ret = st20_p010_to_rfc4175_422be10_simd(p10, (p10 + w * h), pg, w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422be10_to_p010_simd(pg, p10_2, (p10_2 + w * h), w, h, back_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(p10, p10_2, p420_size));
+
+  st_test_free(pg);
+  st_test_free(p10);
+  st_test_free(p10_2);
+}
+
+TEST(Cvt, p010_to_rfc4175_422be10) {
+  test_cvt_p010_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_MAX, MTL_SIMD_LEVEL_MAX);
+}
+
+TEST(Cvt, p010_to_rfc4175_422be10_scalar) {
+  test_cvt_p010_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
+}
+
+TEST(Cvt, p010_to_rfc4175_422be10_avx512) {
+  test_cvt_p010_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                   MTL_SIMD_LEVEL_AVX512);
+  test_cvt_p010_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512,
+                                   MTL_SIMD_LEVEL_AVX512);
+  test_cvt_p010_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_p010_to_rfc4175_422be10(722, 112, MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_NONE);
+  int h = 2; /* each chroma line covers two lines */
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_p010_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_rfc4175_422be10_to_p010(int w, int h, enum mtl_simd_level level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t p420_size = (size_t)w * h * 3 / 2 * sizeof(uint16_t);
+  uint16_t* p10 = (uint16_t*)st_test_zmalloc(p420_size);
+  uint16_t* p10_2 = (uint16_t*)st_test_zmalloc(p420_size);
+
+  if (!pg || !p10 || !p10_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (p10) st_test_free(p10);
+    if (p10_2) st_test_free(p10_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg, fb_pg2_size, 0);
+
+  /* the vertical chroma average should be same as the scalar */
+  ret = st20_rfc4175_422be10_to_p010_simd(pg, p10, (p10 + w * h), w, h, level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422be10_to_p010_simd(pg, p10_2, (p10_2 + w * h), w, h,
+                                          MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(p10, p10_2, p420_size));
+
+  st_test_free(pg);
+  st_test_free(p10);
+  st_test_free(p10_2);
+}
+
+TEST(Cvt, rfc4175_422be10_to_p010_avx512) {
+  test_cvt_rfc4175_422be10_to_p010(1920, 1080, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422be10_to_p010(722, 112, MTL_SIMD_LEVEL_AVX512);
+  for (int w = 2; w < (2 + 64); w += 2) {
+    test_cvt_rfc4175_422be10_to_p010(w, 2, MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_gbrp10le_to_rfc4175_422be10(int w, int h,
+                                                 enum st20_colorimetry colorimetry,
+                                                 enum st20_range range,
+                                                 enum mtl_simd_level cvt_level,
+                                                 enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  struct st20_rfc4175_422_10_pg2_be* pg_2 =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t planar_size = (size_t)w * h * 3 * sizeof(uint16_t);
+  uint16_t* p10 = (uint16_t*)st_test_zmalloc(planar_size);
+  uint16_t* p10_2 = (uint16_t*)st_test_zmalloc(planar_size);
+
+  if (!pg || !pg_2 || !p10 || !p10_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (pg_2) st_test_free(pg_2);
+    if (p10) st_test_free(p10);
+    if (p10_2) st_test_free(p10_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)p10, planar_size, 0);
+  for (size_t i = 0; i < (planar_size / 2); i++) {
+    p10[i] &= 0x3ff; /* only 10 bit */
+  }
+
+  /* the chroma filter should be same as the scalar */
+  ret = st20_gbrp10le_to_rfc4175_422be10_simd(p10, (p10 + w * h), (p10 + w * h * 2), pg,
+                                              w, h, colorimetry, range, cvt_level);
+  EXPECT_EQ(0, ret);
+  ret = st20_gbrp10le_to_rfc4175_422be10_simd(p10, (p10 + w * h), (p10 + w * h * 2),
+                                              pg_2, w, h, colorimetry, range,
+                                              MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, memcmp(pg, pg_2, fb_pg2_size));
+
+  /* one color per line, the 422 chroma is lossless then */
+  for (int plane = 0; plane < 3; plane++) {
+    for (int line = 0; line < h; line++) {
+      uint16_t* p = p10 + (size_t)w * h * plane + (size_t)w * line;
+      for (int x = 1; x < w; x++) p[x] = p[0];
+    }
+  }
+  ret = st20_gbrp10le_to_rfc4175_422be10_simd(p10, (p10 + w * h), (p10 + w * h * 2), pg,
+                                              w, h, colorimetry, range, cvt_level);
+  EXPECT_EQ(0, ret);
+  ret = st20_rfc4175_422be10_to_gbrp10le_simd(pg, p10_2, (p10_2 + w * h),
+                                              (p10_2 + w * h * 2), w, h, colorimetry,
+                                              range, back_level);
+  EXPECT_EQ(0, ret);
+
+  /* the matrix round trip error */
+  int max_diff = 0;
+  for (size_t i = 0; i < (planar_size / 2); i++) {
+    int diff = abs((int)p10[i] - (int)p10_2[i]);
+    if (diff > max_diff) max_diff = diff;
+  }
+  EXPECT_LE(max_diff, 2);
+
+  st_test_free(pg);
+  st_test_free(pg_2);
+  st_test_free(p10);
+  st_test_free(p10_2);
+}
+
+TEST(Cvt, gbrp10le_to_rfc4175_422be10) {
+  for (int cm = 0; cm < ST20_COLORIMETRY_MAX; cm++) {
+    for (int range = 0; range < ST20_RANGE_MAX; range++) {
+      test_cvt_gbrp10le_to_rfc4175_422be10(1920, 1080, (enum st20_colorimetry)cm,
+                                           (enum st20_range)range, MTL_SIMD_LEVEL_MAX,
+                                           MTL_SIMD_LEVEL_MAX);
+    }
+  }
+}
+
+TEST(Cvt, gbrp10le_to_rfc4175_422be10_scalar) {
+  test_cvt_gbrp10le_to_rfc4175_422be10(1920, 1080, ST20_COLORIMETRY_BT709,
+                                       ST20_RANGE_NARROW, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_NONE);
+}
+
+TEST(Cvt, gbrp10le_to_rfc4175_422be10_avx512) {
+  test_cvt_gbrp10le_to_rfc4175_422be10(1920, 1080, ST20_COLORIMETRY_BT709,
+                                       ST20_RANGE_NARROW, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_gbrp10le_to_rfc4175_422be10(722, 111, ST20_COLORIMETRY_BT2020,
+                                       ST20_RANGE_FULL, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_gbrp10le_to_rfc4175_422be10(722, 111, ST20_COLORIMETRY_BT601,
+                                       ST20_RANGE_NARROW, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  for (int w = 2; w < (2 + 96); w += 2) {
+    test_cvt_gbrp10le_to_rfc4175_422be10(w, 2, ST20_COLORIMETRY_BT709, ST20_RANGE_FULL,
+                                         MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_rfc4175_422be10_to_gbrp10le(int w, int h,
+                                                 enum st20_colorimetry colorimetry,
+                                                 enum st20_range range,
+                                                 enum mtl_simd_level level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t planar_size = (size_t)w * h * 3 * sizeof(uint16_t);
+  uint16_t* p10 = (uint16_t*)st_test_zmalloc(planar_size);
+  uint16_t* p10_2 = (uint16_t*)st_test_zmalloc(planar_size);
+
+  if (!pg || !p10 || !p10_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (p10) st_test_free(p10);
+    if (p10_2) st_test_free(p10_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg, fb_pg2_size, 0);
+
+  /* the chroma interpolation should be same as the scalar */
+  ret = st20_rfc4175_422be10_to_gbrp10le_simd(pg, p10, (p10 + w * h),
+                                              (p10 + w * h * 2), w, h, colorimetry,
+                                              range, level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422be10_to_gbrp10le_simd(pg, p10_2, (p10_2 + w * h),
+                                              (p10_2 + w * h * 2), w, h, colorimetry,
+                                              range, MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(p10, p10_2, planar_size));
+
+  st_test_free(pg);
+  st_test_free(p10);
+  st_test_free(p10_2);
+}
+
+TEST(Cvt, rfc4175_422be10_to_gbrp10le_avx512) {
+  for (int cm = 0; cm < ST20_COLORIMETRY_MAX; cm++) {
+    for (int range = 0; range < ST20_RANGE_MAX; range++) {
+      test_cvt_rfc4175_422be10_to_gbrp10le(1920, 1080, (enum st20_colorimetry)cm,
+                                           (enum st20_range)range,
+                                           MTL_SIMD_LEVEL_AVX512);
+    }
+  }
+  test_cvt_rfc4175_422be10_to_gbrp10le(722, 111, ST20_COLORIMETRY_BT709,
+                                       ST20_RANGE_NARROW, MTL_SIMD_LEVEL_AVX512);
+  for (int w = 2; w < (2 + 96); w += 2) {
+    test_cvt_rfc4175_422be10_to_gbrp10le(w, 2, ST20_COLORIMETRY_BT709, ST20_RANGE_NARROW,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_rgb8_to_rfc4175_422be10(int w, int h,
+                                             enum st20_colorimetry colorimetry,
+                                             enum st20_range range,
+                                             enum mtl_simd_level cvt_level,
+                                             enum mtl_simd_level back_level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  struct st20_rfc4175_422_10_pg2_be* pg_2 =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t rgb_size = (size_t)w * h * 3;
+  uint8_t* rgb = (uint8_t*)st_test_zmalloc(rgb_size);
+  uint8_t* rgb_2 = (uint8_t*)st_test_zmalloc(rgb_size);
+
+  if (!pg || !pg_2 || !rgb || !rgb_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (pg_2) st_test_free(pg_2);
+    if (rgb) st_test_free(rgb);
+    if (rgb_2) st_test_free(rgb_2);
+    return;
+  }
+
+  st_test_rand_data(rgb, rgb_size, 0);
+
+  /* the chroma filter should be same as the scalar */
+  ret = st20_rgb8_to_rfc4175_422be10_simd(rgb, pg, w, h, colorimetry, range, cvt_level);
+  EXPECT_EQ(0, ret);
+  ret = st20_rgb8_to_rfc4175_422be10_simd(rgb, pg_2, w, h, colorimetry, range,
+                                          MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, memcmp(pg, pg_2, fb_pg2_size));
+
+  /* one color per line, the 422 chroma is lossless then */
+  for (int line = 0; line < h; line++) {
+    uint8_t* p = rgb + (size_t)w * 3 * line;
+    for (int x = 1; x < w; x++) memcpy(p + x * 3, p, 3);
+  }
+  ret = st20_rgb8_to_rfc4175_422be10_simd(rgb, pg, w, h, colorimetry, range, cvt_level);
+  EXPECT_EQ(0, ret);
+  ret = st20_rfc4175_422be10_to_rgb8_simd(pg, rgb_2, w, h, colorimetry, range,
+                                          back_level);
+  EXPECT_EQ(0, ret);
+
+  /* the matrix round trip error */
+  int max_diff = 0;
+  for (size_t i = 0; i < rgb_size; i++) {
+    int diff = abs((int)rgb[i] - (int)rgb_2[i]);
+    if (diff > max_diff) max_diff = diff;
+  }
+  EXPECT_LE(max_diff, 1);
+
+  st_test_free(pg);
+  st_test_free(pg_2);
+  st_test_free(rgb);
+  st_test_free(rgb_2);
+}
+
+TEST(Cvt, rgb8_to_rfc4175_422be10) {
+  for (int cm = 0; cm < ST20_COLORIMETRY_MAX; cm++) {
+    for (int range = 0; range < ST20_RANGE_MAX; range++) {
+      test_cvt_rgb8_to_rfc4175_422be10(1920, 1080, (enum st20_colorimetry)cm,
+                                       (enum st20_range)range, MTL_SIMD_LEVEL_MAX,
+                                       MTL_SIMD_LEVEL_MAX);
+    }
+  }
+}
+
+TEST(Cvt, rgb8_to_rfc4175_422be10_scalar) {
+  test_cvt_rgb8_to_rfc4175_422be10(1920, 1080, ST20_COLORIMETRY_BT709, ST20_RANGE_NARROW,
+                                   MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
+}
+
+TEST(Cvt, rgb8_to_rfc4175_422be10_avx512) {
+  test_cvt_rgb8_to_rfc4175_422be10(1920, 1080, ST20_COLORIMETRY_BT709, ST20_RANGE_NARROW,
+                                   MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rgb8_to_rfc4175_422be10(722, 111, ST20_COLORIMETRY_BT2020, ST20_RANGE_FULL,
+                                   MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rgb8_to_rfc4175_422be10(722, 111, ST20_COLORIMETRY_BT601, ST20_RANGE_NARROW,
+                                   MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_NONE);
+  for (int w = 2; w < (2 + 96); w += 2) {
+    test_cvt_rgb8_to_rfc4175_422be10(w, 2, ST20_COLORIMETRY_BT709, ST20_RANGE_FULL,
+                                     MTL_SIMD_LEVEL_AVX512, MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+static void test_cvt_rfc4175_422be10_to_rgb8(int w, int h,
+                                             enum st20_colorimetry colorimetry,
+                                             enum st20_range range,
+                                             enum mtl_simd_level level) {
+  int ret;
+  size_t fb_pg2_size = (size_t)w * h * 5 / 2;
+  struct st20_rfc4175_422_10_pg2_be* pg =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size);
+  size_t rgb_size = (size_t)w * h * 3;
+  uint8_t* rgb = (uint8_t*)st_test_zmalloc(rgb_size);
+  uint8_t* rgb_2 = (uint8_t*)st_test_zmalloc(rgb_size);
+
+  if (!pg || !rgb || !rgb_2) {
+    EXPECT_EQ(0, 1);
+    if (pg) st_test_free(pg);
+    if (rgb) st_test_free(rgb);
+    if (rgb_2) st_test_free(rgb_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg, fb_pg2_size, 0);
+
+  /* the chroma interpolation should be same as the scalar */
+  ret = st20_rfc4175_422be10_to_rgb8_simd(pg, rgb, w, h, colorimetry, range, level);
+  EXPECT_EQ(0, ret);
+
+  ret = st20_rfc4175_422be10_to_rgb8_simd(pg, rgb_2, w, h, colorimetry, range,
+                                          MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(rgb, rgb_2, rgb_size));
+
+  st_test_free(pg);
+  st_test_free(rgb);
+  st_test_free(rgb_2);
+}
+
+TEST(Cvt, rfc4175_422be10_to_rgb8_avx512) {
+  for (int cm = 0; cm < ST20_COLORIMETRY_MAX; cm++) {
+    for (int range = 0; range < ST20_RANGE_MAX; range++) {
+      test_cvt_rfc4175_422be10_to_rgb8(1920, 1080, (enum st20_colorimetry)cm,
+                                       (enum st20_range)range, MTL_SIMD_LEVEL_AVX512);
+    }
+  }
+  test_cvt_rfc4175_422be10_to_rgb8(722, 111, ST20_COLORIMETRY_BT709, ST20_RANGE_NARROW,
+                                   MTL_SIMD_LEVEL_AVX512);
+  for (int w = 2; w < (2 + 96); w += 2) {
+    test_cvt_rfc4175_422be10_to_rgb8(w, 2, ST20_COLORIMETRY_BT709, ST20_RANGE_NARROW,
+                                     MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rgb_to_rfc4175_422be10_invalid_colorimetry) {
+  struct st20_rfc4175_422_10_pg2_be pg[2];
+  uint8_t rgb[4 * 3];
+
+  memset(rgb, 0, sizeof(rgb));
+  EXPECT_NE(0, st20_rgb8_to_rfc4175_422be10(rgb, pg, 4, 1, ST20_COLORIMETRY_MAX,
+                                            ST20_RANGE_NARROW));
+  EXPECT_NE(0, st20_rgb8_to_rfc4175_422be10(rgb, pg, 4, 1, ST20_COLORIMETRY_BT709,
+                                            ST20_RANGE_MAX));
+}
+
+static void test_am824_to_aes3(int blocks) {
+  int ret;
+  int subframes = blocks * 2 * 192;
+  size_t blocks_size = subframes * 4;
+  struct st31_aes3* b_aes3 = (struct st31_aes3*)st_test_zmalloc(blocks_size);
+  struct st31_am824* b_am824 = (struct st31_am824*)st_test_zmalloc(blocks_size);
+  struct st31_am824* b_am824_2 = (struct st31_am824*)st_test_zmalloc(blocks_size);
+  if (!b_aes3 || !b_am824 || !b_am824_2) {
+    EXPECT_EQ(0, 1);
+    if (b_aes3) st_test_free(b_aes3);
+    if (b_am824) st_test_free(b_am824);
+    if (b_am824_2) st_test_free(b_am824_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)b_am824, blocks_size, 0);
+  /* set 'b' and 'f' for subframes */
+  struct st31_am824* sf_am824 = b_am824;
+  for (int i = 0; i < subframes; i++) {
+    sf_am824->unused = 0;
+    if (i % (192 * 2) == 0) {
+      sf_am824->b = 1;
+      sf_am824->f = 1;
+    } else if (i % 2 == 0) {
+      sf_am824->b = 0;
+      sf_am824->f = 1;
+    } else {
+      sf_am824->b = 0;
+      sf_am824->f = 0;
+    }
+    sf_am824++;
+  }
+
+  ret = st31_am824_to_aes3(b_am824, b_aes3, subframes);
+  EXPECT_EQ(0, ret);
+
+  ret = st31_aes3_to_am824(b_aes3, b_am824_2, subframes);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(b_am824, b_am824_2, blocks_size));
+
+  st_test_free(b_aes3);
+  st_test_free(b_am824);
+  st_test_free(b_am824_2);
+}
+
+TEST(Cvt, st31_am824_to_aes3) {
+  test_am824_to_aes3(1);
+  test_am824_to_aes3(10);
+  test_am824_to_aes3(100);
+}
+
+static void test_aes3_to_am824(int blocks) {
+  int ret;
+  int subframes = blocks * 2 * 192;
+  size_t blocks_size = subframes * 4;
+  struct st31_aes3* b_aes3 = (struct st31_aes3*)st_test_zmalloc(blocks_size);
+  struct st31_am824* b_am824 = (struct st31_am824*)st_test_zmalloc(blocks_size);
+  struct st31_aes3* b_aes3_2 = (struct st31_aes3*)st_test_zmalloc(blocks_size);
+  if (!b_aes3 || !b_am824 || !b_aes3_2) {
+    EXPECT_EQ(0, 1);
+    if (b_aes3) st_test_free(b_aes3);
+    if (b_am824) st_test_free(b_am824);
+    if (b_aes3_2) st_test_free(b_aes3_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)b_am824, blocks_size, 0);
+  /* set 'b' and 'f' for subframes */
+  struct st31_aes3* sf_aes3 = b_aes3;
+  for (int i = 0; i < subframes; i++) {
+    if (i % (192 * 2) == 0) {
+      sf_aes3->preamble = 0x2;
+    } else if (i % 2 == 0) {
+      sf_aes3->preamble = 0x0;
+    } else {
+      sf_aes3->preamble = 0x1;
+    }
+    sf_aes3++;
+  }
+
+  ret = st31_aes3_to_am824(b_aes3, b_am824, subframes);
+  EXPECT_EQ(0, ret);
+
+  ret = st31_am824_to_aes3(b_am824, b_aes3_2, subframes);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(b_aes3, b_aes3_2, blocks_size));
+
+  st_test_free(b_aes3);
+  st_test_free(b_am824);
+  st_test_free(b_aes3_2);
+}
+
+TEST(Cvt, st31_aes3_to_am824) {
+  test_aes3_to_am824(1);
+  test_aes3_to_am824(10);
+  test_aes3_to_am824(100);
+}
+
+static void frame_malloc(struct st_frame* frame, uint8_t rand, bool align) {
+  int planes = st_frame_fmt_planes(frame->fmt);
+  size_t fb_size = 0;
+  for (int plane = 0; plane < planes; plane++) {
+    size_t least_line_size = st_frame_least_linesize(frame->fmt, frame->width, plane);
+    frame->linesize[plane] = align ? MTL_ALIGN(least_line_size, 512) : least_line_size;
+    fb_size += st_frame_plane_size(frame, plane);
+  }
+  uint8_t* fb = (uint8_t*)st_test_zmalloc(fb_size);
+  if (!fb) return;
+  if (rand) { /* fill the framebuffer */
+    st_test_rand_data(fb, fb_size, rand);
+    if (frame->fmt == ST_FRAME_FMT_YUV422PLANAR10LE ||
+        frame->fmt == ST_FRAME_FMT_YUV420PLANAR10LE ||
+        frame->fmt == ST_FRAME_FMT_YUV444PLANAR10LE ||
+        frame->fmt == ST_FRAME_FMT_GBRPLANAR10LE) {
+      /* only LSB 10 valid */
+      uint16_t* p10_u16 = (uint16_t*)fb;
+      for (size_t j = 0; j < (fb_size / 2); j++) {
+        p10_u16[j] &= 0x3ff; /* only 10 bit */
+      }
+    } else if (frame->fmt == ST_FRAME_FMT_YUV422PLANAR12LE ||
+               frame->fmt == ST_FRAME_FMT_YUV444PLANAR12LE ||
+               frame->fmt == ST_FRAME_FMT_GBRPLANAR12LE) {
+      /* only LSB 12 valid */
+      uint16_t* p12_u16 = (uint16_t*)fb;
+      for (size_t j = 0; j < (fb_size / 2); j++) {
+        p12_u16[j] &= 0xfff; /* only 12 bit */
+      }
+    } else if (frame->fmt == ST_FRAME_FMT_Y210 || frame->fmt == ST_FRAME_FMT_P010) {
+      /* only MSB 10 valid */
+      uint16_t* y210_u16 = (uint16_t*)fb;
+      for (size_t j = 0; j < (fb_size / 2); j++) {
+        y210_u16[j] &= 0xffc0; /* only 10 bit */
+      }
+    } else if (frame->fmt == ST_FRAME_FMT_V210) {
+      uint32_t* v210_word = (uint32_t*)fb;
+      for (size_t j = 0; j < (fb_size / 4); j++) {
+        v210_word[j] &= 0x3fffffff; /* only 30 bit */
+      }
+    }
+  }
+  for (int plane = 0; plane < planes; plane++) {
+    if (plane == 0)
+      frame->addr[plane] = fb;
+    else
+      frame->addr[plane] =
+          (uint8_t*)frame->addr[plane - 1] + st_frame_plane_size(frame, plane - 1);
+  }
+  frame->data_size = frame->buffer_size = fb_size;
+}
+
+static void frame_free(struct st_frame* frame) {
+  if (frame->addr[0]) st_test_free(frame->addr[0]);
+  int planes = st_frame_fmt_planes(frame->fmt);
+  for (int plane = 0; plane < planes; plane++) {
+    frame->addr[plane] = NULL;
+  }
+}
+
+static int frame_compare_each_line(struct st_frame* old_frame,
+                                   struct st_frame* new_frame) {
+  int ret = 0;
+  int planes = st_frame_fmt_planes(old_frame->fmt);
+  for (int plane = 0; plane < planes; plane++) {
+    uint32_t lines = st_frame_plane_height(old_frame->fmt, old_frame->height, plane);
+    for (uint32_t line = 0; line < lines; line++) {
+      uint8_t* old_addr =
+          (uint8_t*)old_frame->addr[plane] + old_frame->linesize[plane] * line;
+      uint8_t* new_addr =
+          (uint8_t*)new_frame->addr[plane] + new_frame->linesize[plane] * line;
+      ret += memcmp(old_addr, new_addr,
+                    st_frame_least_linesize(old_frame->fmt, old_frame->width, plane));
+    }
+  }
+
+  return ret;
+}
+
+static void test_st_frame_convert(struct st_frame* src, struct st_frame* dst,
+                                  struct st_frame* new_src, bool expect_fail) {
+  int ret;
+  ret = st_frame_convert(src, dst);
+  if (expect_fail)
+    EXPECT_NE(0, ret);
+  else
+    EXPECT_EQ(0, ret);
+
+  ret = st_frame_convert(dst, new_src);
+  if (expect_fail)
+    EXPECT_NE(0, ret);
+  else
+    EXPECT_EQ(0, ret);
+
+  if (!expect_fail) {
+    ret = frame_compare_each_line(src, new_src);
+    EXPECT_EQ(0, ret);
+  }
+}
+
+TEST(Cvt, st_frame_convert_fail_resolution) {
+  struct st_frame src, dst, new_src;
+  src.fmt = new_src.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  dst.fmt = ST_FRAME_FMT_Y210;
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = 1080;
+  dst.height = 1088;
+  test_st_frame_convert(&src, &dst, &new_src, true);
+
+  src.width = new_src.width = 1920;
+  dst.width = 1280;
+  src.height = new_src.height = dst.height = 1080;
+  test_st_frame_convert(&src, &dst, &new_src, true);
+
+  src.width = new_src.width = 1920;
+  src.height = new_src.height = 1080;
+  dst.width = 3840;
+  dst.height = 2160;
+  test_st_frame_convert(&src, &dst, &new_src, true);
+}
+
+TEST(Cvt, st_frame_convert_fail_fmt) {
+  struct st_frame src, dst, new_src;
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+
+  src.fmt = new_src.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  dst.fmt = ST_FRAME_FMT_YUV444PLANAR10LE;
+  test_st_frame_convert(&src, &dst, &new_src, true);
+
+  src.fmt = new_src.fmt = ST_FRAME_FMT_Y210;
   dst.fmt = ST_FRAME_FMT_V210;
   test_st_frame_convert(&src, &dst, &new_src, true);
 
@@ -4024,6 +5172,30 @@ TEST(Cvt, st_frame_convert_rotate_no_padding) {
   frame_free(&src);
   frame_free(&dst);
   frame_free(&new_src);
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+  src.fmt = new_src.fmt = ST_FRAME_FMT_NV12;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  frame_malloc(&src, 4, false);
+  frame_malloc(&dst, 0, false);
+  frame_malloc(&new_src, 0, false);
+  test_st_frame_convert(&src, &dst, &new_src, false);
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+  src.fmt = new_src.fmt = ST_FRAME_FMT_YUV420PLANAR10LE;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  frame_malloc(&src, 5, false);
+  frame_malloc(&dst, 0, false);
+  frame_malloc(&new_src, 0, false);
+  test_st_frame_convert(&src, &dst, &new_src, false);
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
 }
 
 TEST(Cvt, st_frame_convert_rotate_padding) {
@@ -4064,6 +5236,30 @@ TEST(Cvt, st_frame_convert_rotate_padding) {
   frame_free(&src);
   frame_free(&dst);
   frame_free(&new_src);
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+  src.fmt = new_src.fmt = ST_FRAME_FMT_P010;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  frame_malloc(&src, 4, true);
+  frame_malloc(&dst, 0, true);
+  frame_malloc(&new_src, 0, true);
+  test_st_frame_convert(&src, &dst, &new_src, false);
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+  src.fmt = new_src.fmt = ST_FRAME_FMT_YUV420PLANAR8;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  frame_malloc(&src, 5, true);
+  frame_malloc(&dst, 0, true);
+  frame_malloc(&new_src, 0, true);
+  test_st_frame_convert(&src, &dst, &new_src, false);
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
 }
 
 TEST(Cvt, st_frame_convert_rotate_mix_padding) {
@@ -4104,4 +5300,264 @@ TEST(Cvt, st_frame_convert_rotate_mix_padding) {
   frame_free(&src);
   frame_free(&dst);
   frame_free(&new_src);
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+  src.fmt = new_src.fmt = ST_FRAME_FMT_NV12;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  frame_malloc(&src, 4, true);
+  frame_malloc(&dst, 0, false);
+  frame_malloc(&new_src, 0, true);
+  test_st_frame_convert(&src, &dst, &new_src, false);
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+  src.fmt = new_src.fmt = ST_FRAME_FMT_P010;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  frame_malloc(&src, 5, false);
+  frame_malloc(&dst, 0, true);
+  frame_malloc(&new_src, 0, false);
+  test_st_frame_convert(&src, &dst, &new_src, false);
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
+}
+
+static void test_st_frame_convert_parallel(enum st_frame_fmt src_fmt,
+                                           enum st_frame_fmt dst_fmt, uint32_t w,
+                                           uint32_t h, bool align) {
+  struct st_tests_context* ctx = st_test_ctx();
+  struct st_frame src, dst, dst_2, new_src;
+  int ret;
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  memset(&dst_2, 0, sizeof(dst_2));
+  memset(&new_src, 0, sizeof(new_src));
+  src.width = new_src.width = dst.width = dst_2.width = w;
+  src.height = new_src.height = dst.height = dst_2.height = h;
+  src.fmt = new_src.fmt = src_fmt;
+  dst.fmt = dst_2.fmt = dst_fmt;
+  frame_malloc(&src, 1, align);
+  frame_malloc(&dst, 0, align);
+  frame_malloc(&dst_2, 0, false);
+  frame_malloc(&new_src, 0, false);
+
+  /* the slices result should be same as the single thread one */
+  ret = st_frame_convert_parallel(ctx->handle, &src, &dst);
+  EXPECT_EQ(0, ret);
+  ret = st_frame_convert(&src, &dst_2);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, frame_compare_each_line(&dst, &dst_2));
+
+  ret = st_frame_convert_parallel(ctx->handle, &dst, &new_src);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, frame_compare_each_line(&src, &new_src));
+
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&dst_2);
+  frame_free(&new_src);
+}
+
+TEST(Cvt, st_frame_convert_parallel) {
+  test_st_frame_convert_parallel(ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                                 ST_FRAME_FMT_YUV422PLANAR10LE, 1920, 1080, false);
+  test_st_frame_convert_parallel(ST_FRAME_FMT_YUV422RFC4175PG2BE10, ST_FRAME_FMT_V210,
+                                 3840, 2160, false);
+  test_st_frame_convert_parallel(ST_FRAME_FMT_YUV422RFC4175PG2BE10, ST_FRAME_FMT_Y210,
+                                 3840, 2160, true);
+  test_st_frame_convert_parallel(ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+                                 ST_FRAME_FMT_YUV444PLANAR10LE, 1920, 1081, false);
+  /* the 420 chroma planes slice at half lines */
+  test_st_frame_convert_parallel(ST_FRAME_FMT_NV12, ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                                 1920, 1080, false);
+  test_st_frame_convert_parallel(ST_FRAME_FMT_YUV420PLANAR10LE,
+                                 ST_FRAME_FMT_YUV422RFC4175PG2BE10, 3840, 2160, true);
+  /* too few lines to split, convert on the caller thread */
+  test_st_frame_convert_parallel(ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+                                 ST_FRAME_FMT_YUV422PLANAR12LE, 1920, 8, false);
+}
+
+static void test_st_frame_convert_parallel_loop(struct st_frame* src,
+                                                struct st_frame* dst,
+                                                struct st_frame* dst_2, int loop,
+                                                int* fail) {
+  struct st_tests_context* ctx = st_test_ctx();
+
+  for (int i = 0; i < loop; i++) {
+    memset(dst->addr[0], 0, dst->data_size);
+    if (st_frame_convert_parallel(ctx->handle, src, dst) < 0 ||
+        frame_compare_each_line(dst, dst_2) != 0)
+      (*fail)++;
+  }
+}
+
+/* the callers share the pool, each job should be done with its own frames */
+TEST(Cvt, st_frame_convert_parallel_concurrent) {
+  const int callers = 4, loop = 20;
+  uint32_t w = 1920, h = 1080;
+  struct st_frame src[callers], dst[callers], dst_2[callers];
+  int fail[callers];
+  std::thread threads[callers];
+  int ret;
+
+  for (int i = 0; i < callers; i++) {
+    memset(&src[i], 0, sizeof(src[i]));
+    memset(&dst[i], 0, sizeof(dst[i]));
+    memset(&dst_2[i], 0, sizeof(dst_2[i]));
+    src[i].width = dst[i].width = dst_2[i].width = w;
+    src[i].height = dst[i].height = dst_2[i].height = h;
+    src[i].fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+    dst[i].fmt = dst_2[i].fmt = ST_FRAME_FMT_YUV422PLANAR10LE;
+    frame_malloc(&src[i], i + 1, false);
+    frame_malloc(&dst[i], 0, false);
+    frame_malloc(&dst_2[i], 0, false);
+    ret = st_frame_convert(&src[i], &dst_2[i]);
+    EXPECT_EQ(0, ret);
+    fail[i] = 0;
+  }
+
+  for (int i = 0; i < callers; i++)
+    threads[i] = std::thread(test_st_frame_convert_parallel_loop, &src[i], &dst[i],
+                             &dst_2[i], loop, &fail[i]);
+  for (int i = 0; i < callers; i++) threads[i].join();
+
+  for (int i = 0; i < callers; i++) {
+    EXPECT_EQ(0, fail[i]);
+    frame_free(&src[i]);
+    frame_free(&dst[i]);
+    frame_free(&dst_2[i]);
+  }
+}
+
+static void test_st_frame_scale(enum st_frame_fmt fmt, uint32_t w, uint32_t h,
+                                uint32_t scale_w, uint32_t scale_h, bool align) {
+  struct st_frame src, dst, dst_2, dst_3;
+  int ret;
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  memset(&dst_2, 0, sizeof(dst_2));
+  memset(&dst_3, 0, sizeof(dst_3));
+  src.width = w;
+  src.height = h;
+  dst.width = dst_2.width = dst_3.width = scale_w;
+  dst.height = dst_2.height = dst_3.height = scale_h;
+  src.fmt = dst.fmt = dst_2.fmt = dst_3.fmt = fmt;
+  frame_malloc(&src, 1, align);
+  frame_malloc(&dst, 0, align);
+  frame_malloc(&dst_2, 0, false);
+  frame_malloc(&dst_3, 0, false);
+
+  /* the simd result should be same as the scalar */
+  ret = st_frame_scale_simd(&src, &dst, MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+  ret = st_frame_scale_simd(&src, &dst_2, MTL_SIMD_LEVEL_AVX2);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, frame_compare_each_line(&dst, &dst_2));
+  ret = st_frame_scale(&src, &dst_3);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, frame_compare_each_line(&dst, &dst_3));
+
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&dst_2);
+  frame_free(&dst_3);
+}
+
+TEST(Cvt, st_frame_scale) {
+  /* half, quarter and third */
+  test_st_frame_scale(ST_FRAME_FMT_YUV422RFC4175PG2BE10, 1920, 1080, 960, 540, false);
+  test_st_frame_scale(ST_FRAME_FMT_YUV422RFC4175PG2BE10, 3840, 2160, 960, 540, true);
+  test_st_frame_scale(ST_FRAME_FMT_YUV422PLANAR10LE, 1920, 1080, 640, 360, false);
+  /* arbitrary ratio and upscale */
+  test_st_frame_scale(ST_FRAME_FMT_YUV422RFC4175PG2BE10, 1920, 1080, 722, 111, false);
+  test_st_frame_scale(ST_FRAME_FMT_YUV422PLANAR10LE, 1280, 720, 1920, 1080, true);
+  test_st_frame_scale(ST_FRAME_FMT_YUV422PLANAR12LE, 1920, 1080, 1280, 720, false);
+  test_st_frame_scale(ST_FRAME_FMT_YUV444PLANAR10LE, 1920, 1080, 1000, 562, false);
+  test_st_frame_scale(ST_FRAME_FMT_GBRPLANAR10LE, 640, 360, 1921, 1079, false);
+  test_st_frame_scale(ST_FRAME_FMT_YUV420PLANAR10LE, 1920, 1080, 480, 270, true);
+  test_st_frame_scale(ST_FRAME_FMT_YUV420PLANAR8, 1920, 1080, 1282, 722, false);
+  test_st_frame_scale(ST_FRAME_FMT_YUV422PLANAR8, 1920, 1080, 240, 136, false);
+}
+
+TEST(Cvt, st_frame_scale_flat) {
+  struct st_frame src, dst;
+  int ret;
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  src.width = 1920;
+  src.height = 1080;
+  dst.width = 722;
+  dst.height = 406;
+  src.fmt = dst.fmt = ST_FRAME_FMT_YUV422PLANAR10LE;
+  frame_malloc(&src, 0, false);
+  frame_malloc(&dst, 0, true);
+
+  /* the weights of each output sum to 1, a flat frame keeps flat */
+  for (int plane = 0; plane < 3; plane++) {
+    uint16_t* p = (uint16_t*)src.addr[plane];
+    for (size_t i = 0; i < st_frame_plane_size(&src, plane) / 2; i++) p[i] = 64 + plane;
+  }
+  ret = st_frame_scale(&src, &dst);
+  EXPECT_EQ(0, ret);
+  for (int plane = 0; plane < 3; plane++) {
+    size_t w = st_frame_least_linesize(dst.fmt, dst.width, plane) / 2;
+    for (uint32_t line = 0; line < dst.height; line++) {
+      uint16_t* p = (uint16_t*)((uint8_t*)dst.addr[plane] + dst.linesize[plane] * line);
+      for (size_t i = 0; i < w; i++) {
+        if (p[i] != 64 + plane) {
+          EXPECT_EQ(64 + plane, p[i]);
+          line = dst.height;
+          break;
+        }
+      }
+    }
+  }
+
+  frame_free(&src);
+  frame_free(&dst);
+}
+
+TEST(Cvt, st_frame_scale_fail) {
+  struct st_frame src, dst;
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  src.width = 1920;
+  src.height = 1080;
+  dst.width = 960;
+  dst.height = 540;
+  src.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  dst.fmt = ST_FRAME_FMT_YUV422PLANAR10LE;
+  frame_malloc(&src, 0, false);
+  frame_malloc(&dst, 0, false);
+  /* fmt mismatch */
+  EXPECT_NE(0, st_frame_scale(&src, &dst));
+  frame_free(&src);
+  frame_free(&dst);
+
+  /* fmt not supported */
+  src.fmt = dst.fmt = ST_FRAME_FMT_V210;
+  dst.width = 966;
+  frame_malloc(&src, 0, false);
+  frame_malloc(&dst, 0, false);
+  EXPECT_NE(0, st_frame_scale(&src, &dst));
+  frame_free(&src);
+  frame_free(&dst);
+
+  /* over the max ratio */
+  src.fmt = dst.fmt = ST_FRAME_FMT_YUV422PLANAR10LE;
+  dst.width = 64;
+  dst.height = 64;
+  frame_malloc(&src, 0, false);
+  frame_malloc(&dst, 0, false);
+  EXPECT_NE(0, st_frame_scale(&src, &dst));
+  frame_free(&src);
+  frame_free(&dst);
 }
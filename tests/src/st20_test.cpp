@@ -2,15 +2,31 @@
  * Copyright(c) 2022 Intel Corporation
  */
 
+#include <fcntl.h>
+#include <mtl/mtl_sch_stats_api.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
 #include <thread>
 
 #include "log.h"
+#include "mt_dev_test.h"
+#include "mt_sch_test.h"
+#include "st2110/st_rx_video_session_test.h"
 #include "tests.h"
 
 #define ST20_TRAIN_TIME_S (0) /* 0 for runtime rl */
 
 #define ST20_TEST_PAYLOAD_TYPE (112)
 
+/* a data room below this splits each 1080p bpm pkt into chained mbufs */
+#define ST20_TEST_CHAIN_DATA_ROOM_MAX (1024)
+/* the nic rx ring may hold some more mbufs after the rearm */
+#define ST20_TEST_CHAIN_REARM_SLACK (128)
+
 static int tx_next_video_frame(void* priv, uint16_t* next_frame_idx,
                                struct st20_tx_frame_meta* meta) {
   auto ctx = (tests_context*)priv;
@@ -348,6 +364,7 @@ static void tx_feed_packet(void* args) {
   void* mbuf;
   void* usrptr = NULL;
   uint16_t mbuf_len = 0;
+  std::vector<std::pair<void*, uint16_t>> held;
   std::unique_lock<std::mutex> lck(ctx->mtx, std::defer_lock);
   while (!ctx->stop) {
     /* get available buffer*/
@@ -366,10 +383,28 @@ static void tx_feed_packet(void* args) {
     }
 
     /* build the rtp pkt */
+    int pkt_idx = ctx->pkt_idx;
     tx_video_build_rtp_packet(ctx, (struct st20_rfc4175_rtp_hdr*)usrptr, &mbuf_len);
 
+    if (ctx->ooo_frame_pkts) {
+      /* hold the tail of the frame, the rx has to assemble two frames at the same time */
+      if (pkt_idx >= ctx->total_pkts_in_frame - ctx->ooo_frame_pkts) {
+        held.push_back(std::make_pair(mbuf, mbuf_len));
+        continue;
+      }
+      st20_tx_put_mbuf((st20_tx_handle)ctx->handle, mbuf, mbuf_len);
+      if (pkt_idx == ctx->ooo_frame_pkts - 1) {
+        for (auto& h : held)
+          st20_tx_put_mbuf((st20_tx_handle)ctx->handle, h.first, h.second);
+        held.clear();
+      }
+      continue;
+    }
+
     st20_tx_put_mbuf((st20_tx_handle)ctx->handle, mbuf, mbuf_len);
   }
+
+  for (auto& h : held) st20_tx_put_mbuf((st20_tx_handle)ctx->handle, h.first, h.second);
 }
 
 static int tx_rtp_done(void* args) {
@@ -478,6 +513,10 @@ static void rx_get_packet(void* args) {
     hdr = (struct st20_rfc4175_rtp_hdr*)usrptr;
     uint32_t tmstamp = ntohl(hdr->base.tmstamp);
     bool newframe = false;
+    uint16_t seq_id = ntohs(hdr->base.seq_number);
+    if (ctx->rx_seq_id >= 0 && seq_id != (uint16_t)(ctx->rx_seq_id + 1))
+      ctx->rx_seq_gap_cnt++;
+    ctx->rx_seq_id = seq_id;
     ctx->packet_rec++;
     if (tmstamp != ctx->rtp_tmstamp) {
       if (ctx->packet_rec == ctx->total_pkts_in_frame || ctx->rtp_tmstamp == 0)
@@ -633,6 +672,245 @@ TEST(St20_tx, rtp_pkt_size) {
   expect_test_rtp_pkt_size(st20_tx, ST20_TYPE_RTP_LEVEL, rtp_pkt_size, false);
 }
 
+static void st20_tx_builders_test(enum st20_type type, uint16_t num_builders,
+                                  bool expect_succ) {
+  auto ctx = st_test_ctx();
+  auto m_handle = ctx->handle;
+  struct st20_tx_ops ops;
+  auto test_ctx = new tests_context();
+  ASSERT_TRUE(test_ctx != NULL);
+  st20_tx_handle handle;
+  int ret;
+
+  test_ctx->idx = 0;
+  test_ctx->ctx = ctx;
+  test_ctx->fb_cnt = 3;
+  test_ctx->fb_idx = 0;
+  st20_tx_ops_init(test_ctx, &ops);
+  /* test with 1 port */
+  ops.num_port = 1;
+  ops.type = type;
+  ops.num_builders = num_builders;
+  handle = st20_tx_create(m_handle, &ops);
+  if (expect_succ) {
+    EXPECT_TRUE(handle != NULL);
+    if (handle) {
+      ret = st20_tx_free(handle);
+      EXPECT_GE(ret, 0);
+    }
+  } else {
+    EXPECT_TRUE(handle == NULL);
+  }
+  delete test_ctx;
+}
+
+TEST(St20_tx, create_free_builders) {
+  st20_tx_builders_test(ST20_TYPE_FRAME_LEVEL, 1, true);
+  st20_tx_builders_test(ST20_TYPE_FRAME_LEVEL, 2, true);
+}
+TEST(St20_tx, create_expect_fail_builders) {
+  st20_tx_builders_test(ST20_TYPE_FRAME_LEVEL, ST20_TX_BUILDERS_MAX + 1, false);
+  st20_tx_builders_test(ST20_TYPE_RTP_LEVEL, 2, false);
+}
+
+/* find the sch of each builder tasklet from the stats shm */
+static void st20_tx_builders_sch_map(struct mtl_sch_stats_shm* shm,
+                                     std::map<std::string, int>* sch_map) {
+  for (uint32_t sch_idx = 0; sch_idx < shm->nb_sch; sch_idx++) {
+    struct mtl_sch_stats_sch* sch = mtl_sch_stats_get_sch(shm, sch_idx);
+    for (uint32_t i = 0; i < sch->nb_tasklets; i++) {
+      struct mtl_sch_stats_tasklet* slot = mtl_sch_stats_get_tasklet(sch, i);
+      char name[MTL_SCH_STATS_NAME_MAX];
+      uint32_t gen = __atomic_load_n(&slot->gen, __ATOMIC_ACQUIRE);
+      if ((gen & 0x1) || !slot->active) continue;
+      memcpy(name, slot->name, sizeof(name));
+      name[sizeof(name) - 1] = 0;
+      if (__atomic_load_n(&slot->gen, __ATOMIC_ACQUIRE) != gen) continue;
+      if (strncmp(name, "tv_builder_", strlen("tv_builder_"))) continue;
+      (*sch_map)[name] = sch_idx;
+    }
+  }
+}
+
+/* the balancer should settle down, a builder moved back and forth is a ping-pong */
+TEST(St20_tx, tasklet_balance_converge) {
+  auto ctx = st_test_ctx();
+  auto m_handle = ctx->handle;
+  uint64_t need_flags = MTL_FLAG_TASKLET_BALANCE | MTL_FLAG_SCH_STATS_SHM;
+  int sessions = 3;
+  uint16_t num_builders = 2;
+  int duration_s = 60;
+  std::vector<tests_context*> test_ctx(sessions);
+  std::vector<st20_tx_handle> handle(sessions);
+  std::map<std::string, int> sch_last;
+  std::map<std::string, int> moves;
+  struct mtl_sch_stats_shm* shm;
+  const char* shm_name;
+  struct stat st;
+  int ret;
+
+  if ((ctx->para.flags & need_flags) != need_flags)
+    GTEST_SKIP() << "run with --tasklet_balance --sch_stats_shm";
+
+  shm_name = mtl_sch_stats_shm_name(m_handle);
+  ASSERT_TRUE(shm_name != NULL);
+  int fd = shm_open(shm_name, O_RDONLY, 0);
+  ASSERT_GE(fd, 0);
+  ret = fstat(fd, &st);
+  ASSERT_GE(ret, 0);
+  shm = (struct mtl_sch_stats_shm*)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  ASSERT_TRUE(shm != MAP_FAILED);
+  EXPECT_EQ(shm->magic, (uint32_t)MTL_SCH_STATS_MAGIC);
+  EXPECT_EQ(shm->size, (uint64_t)st.st_size);
+  EXPECT_EQ(shm->size, mtl_sch_stats_shm_size(shm->nb_sch, shm->max_tasklets));
+
+  for (int i = 0; i < sessions; i++) {
+    struct st20_tx_ops ops;
+    test_ctx[i] = new tests_context();
+    test_ctx[i]->idx = i;
+    test_ctx[i]->ctx = ctx;
+    test_ctx[i]->fb_cnt = 3;
+    test_ctx[i]->fb_idx = 0;
+    st20_tx_ops_init(test_ctx[i], &ops);
+    ops.num_port = 1;
+    ops.num_builders = num_builders;
+    handle[i] = st20_tx_create(m_handle, &ops);
+    ASSERT_TRUE(handle[i] != NULL);
+    test_ctx[i]->handle = handle[i];
+  }
+
+  ret = mtl_start(m_handle);
+  EXPECT_GE(ret, 0);
+  for (int s = 0; s < duration_s; s++) {
+    std::map<std::string, int> sch_map;
+    sleep(1);
+    st20_tx_builders_sch_map(shm, &sch_map);
+    for (auto& it : sch_map) {
+      auto last = sch_last.find(it.first);
+      if (last != sch_last.end() && last->second != it.second) {
+        info("%s, %s move from sch %d to %d at %ds\n", __func__, it.first.c_str(),
+             last->second, it.second, s);
+        moves[it.first]++;
+      }
+      sch_last[it.first] = it.second;
+    }
+  }
+  ret = mtl_stop(m_handle);
+  EXPECT_GE(ret, 0);
+
+  EXPECT_EQ(sch_last.size(), (size_t)sessions * num_builders);
+  for (auto& it : moves) EXPECT_LE(it.second, 1);
+  for (int i = 0; i < sessions; i++) {
+    EXPECT_GT(test_ctx[i]->fb_send, 0);
+    ret = st20_tx_free(handle[i]);
+    EXPECT_GE(ret, 0);
+    delete test_ctx[i];
+  }
+  munmap(shm, st.st_size);
+}
+
+/* the pacing tasklet should report the future pacing target to the sch, not always 0 */
+TEST(St20_tx, pacing_tasklet_deadline) {
+  auto ctx = st_test_ctx();
+  auto m_handle = ctx->handle;
+  tests_context* test_ctx;
+  st20_tx_handle handle;
+  struct st20_tx_ops ops;
+  uint64_t calls = 0, future = 0;
+  int ret;
+
+  test_ctx = new tests_context();
+  test_ctx->idx = 0;
+  test_ctx->ctx = ctx;
+  test_ctx->fb_cnt = 3;
+  test_ctx->fb_idx = 0;
+  st20_tx_ops_init(test_ctx, &ops);
+  ops.num_port = 1;
+  handle = st20_tx_create(m_handle, &ops);
+  ASSERT_TRUE(handle != NULL);
+  test_ctx->handle = handle;
+
+  ret = mtl_start(m_handle);
+  EXPECT_GE(ret, 0);
+  sleep(5);
+  ret = mtl_sch_tasklet_deadline_stats(m_handle, "video_transmitter", &calls, &future);
+  EXPECT_GE(ret, 0);
+  ret = mtl_stop(m_handle);
+  EXPECT_GE(ret, 0);
+
+  info("%s, deadline calls %" PRIu64 " future %" PRIu64 "\n", __func__, calls, future);
+  EXPECT_GT(test_ctx->fb_send, 0);
+  EXPECT_GT(calls, 0);
+  /* every frame waits its epoch at least, the calls in the wait see a future target */
+  EXPECT_GT(future, 0);
+
+  ret = st20_tx_free(handle);
+  EXPECT_GE(ret, 0);
+  delete test_ctx;
+}
+
+/* the rl trains of concurrent creates should overlap instead of queue on the mgr lock */
+TEST(St20_tx, pacing_train_concurrent) {
+  auto ctx = st_test_ctx();
+  auto m_handle = ctx->handle;
+  int sessions = 4;
+  /* three different rates plus one duplicate which reuse the first train */
+  int width[4] = {1920, 1920, 1280, 1920};
+  int height[4] = {1080, 1080, 720, 1080};
+  enum st20_fmt fmt[4] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_8BIT,
+                          ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  std::vector<tests_context*> test_ctx(sessions);
+  std::vector<st20_tx_handle> handle(sessions);
+  std::vector<std::thread> threads;
+  int ret;
+
+  if (!(ctx->para.flags & MTL_FLAG_TX_PACING_TRAIN_FAKE) ||
+      ctx->para.pacing != ST21_TX_PACING_WAY_RL) {
+    info("%s, skip as fake rl pacing train not enabled\n", __func__);
+    return;
+  }
+
+  for (int i = 0; i < sessions; i++) {
+    test_ctx[i] = new tests_context();
+    test_ctx[i]->idx = i;
+    test_ctx[i]->ctx = ctx;
+    test_ctx[i]->fb_cnt = 3;
+    test_ctx[i]->fb_idx = 0;
+  }
+
+  uint64_t start_ns = st_test_get_monotonic_time();
+  for (int i = 0; i < sessions; i++) {
+    threads.emplace_back([&, i]() {
+      struct st20_tx_ops ops;
+      st20_tx_ops_init(test_ctx[i], &ops);
+      ops.num_port = 1;
+      ops.fps = ST_FPS_P59_94;
+      ops.width = width[i];
+      ops.height = height[i];
+      ops.fmt = fmt[i];
+      handle[i] = st20_tx_create(m_handle, &ops);
+    });
+  }
+  for (auto& t : threads) t.join();
+  uint64_t train_ns = st_test_get_monotonic_time() - start_ns;
+
+  /* one fake train is 71 frames of 59.94 fps, about 1.2s */
+  uint64_t one_train_ns = (uint64_t)(71.0 * NS_PER_S / st_frame_rate(ST_FPS_P59_94));
+  info("%s, create %d sessions in %" PRIu64 "ms, one train %" PRIu64 "ms\n", __func__,
+       sessions, train_ns / NS_PER_MS, one_train_ns / NS_PER_MS);
+  EXPECT_LT(train_ns, one_train_ns * 2);
+
+  for (int i = 0; i < sessions; i++) {
+    EXPECT_TRUE(handle[i] != NULL);
+    if (handle[i]) {
+      ret = st20_tx_free(handle[i]);
+      EXPECT_GE(ret, 0);
+    }
+    delete test_ctx[i];
+  }
+}
+
 TEST(St20_rx, create_free_single) { create_free_test(st20_rx, 0, 1, 1); }
 TEST(St20_rx, create_free_multi) { create_free_test(st20_rx, 0, 1, 6); }
 TEST(St20_rx, create_free_mix) { create_free_test(st20_rx, 2, 3, 4); }
@@ -651,6 +929,47 @@ TEST(St20_rx, create_expect_fail_ring_sz) {
   expect_fail_test_rtp_ring(st20_rx, ST20_TYPE_RTP_LEVEL, ring_size);
 }
 
+static void st20_rx_slots_test(enum st20_type type, uint16_t slots_cnt,
+                               bool expect_succ) {
+  auto ctx = st_test_ctx();
+  auto m_handle = ctx->handle;
+  struct st20_rx_ops ops;
+  auto test_ctx = new tests_context();
+  ASSERT_TRUE(test_ctx != NULL);
+  st20_rx_handle handle;
+  int ret;
+
+  test_ctx->idx = 0;
+  test_ctx->ctx = ctx;
+  test_ctx->fb_cnt = 3;
+  test_ctx->fb_idx = 0;
+  st20_rx_ops_init(test_ctx, &ops);
+  /* test with 1 port */
+  ops.num_port = 1;
+  ops.type = type;
+  ops.slots_cnt = slots_cnt;
+  handle = st20_rx_create(m_handle, &ops);
+  if (expect_succ) {
+    EXPECT_TRUE(handle != NULL);
+    if (handle) {
+      ret = st20_rx_free(handle);
+      EXPECT_GE(ret, 0);
+    }
+  } else {
+    EXPECT_TRUE(handle == NULL);
+  }
+  delete test_ctx;
+}
+
+TEST(St20_rx, create_free_slots) {
+  st20_rx_slots_test(ST20_TYPE_FRAME_LEVEL, 2, true);
+  st20_rx_slots_test(ST20_TYPE_FRAME_LEVEL, ST20_RX_SLOTS_MAX, true);
+}
+TEST(St20_rx, create_expect_fail_slots) {
+  st20_rx_slots_test(ST20_TYPE_FRAME_LEVEL, ST20_RX_SLOTS_MAX + 1, false);
+  st20_rx_slots_test(ST20_TYPE_RTP_LEVEL, ST20_RX_SLOTS_MAX + 1, false);
+}
+
 static void rtp_tx_specific_init(struct st20_tx_ops* ops, tests_context* test_ctx) {
   int ret;
   ret = st20_get_pgroup(ops->fmt, &test_ctx->st20_pg);
@@ -1091,6 +1410,65 @@ TEST(St20_tx, frame_1080p_yuv420_10bit_s1) {
   int height[1] = {1080};
   st20_tx_fps_test(type, fps, width, height, ST20_FMT_YUV_420_10BIT, ST_TEST_LEVEL_ALL);
 }
+TEST(St20_tx, launch_time_emu_1080p_fps59_94_s1) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  struct mtl_tx_launch_time_stats stats;
+  int ret;
+
+  if (!(ctx->para.flags & MTL_FLAG_TX_LAUNCH_TIME_EMU)) {
+    ret = mtl_get_tx_launch_time_stats(m_handle, MTL_PORT_P, &stats);
+    EXPECT_LT(ret, 0);
+    info("%s, skip as launch time emulation not enabled\n", __func__);
+    return;
+  }
+
+  ret = mtl_reset_tx_launch_time_stats(m_handle, MTL_PORT_P);
+  EXPECT_GE(ret, 0);
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  st20_tx_fps_test(type, fps, width, height, ST20_FMT_YUV_422_10BIT, ST_TEST_LEVEL_ALL);
+
+  ret = mtl_get_tx_launch_time_stats(m_handle, MTL_PORT_P, &stats);
+  EXPECT_GE(ret, 0);
+  info("%s, pkts %" PRIu64 " early %" PRIu64 " late avg %" PRIu64 " p99 %" PRIu64
+       " max %" PRIu64 " ahead max %u\n",
+       __func__, stats.pkts, stats.early_pkts, stats.late_avg_ns, stats.late_p99_ns,
+       stats.late_max_ns, stats.ahead_max_pkts);
+  EXPECT_GT(stats.pkts, 0);
+
+  /* Cmax of the ST2110-21 narrow sender, 4320 pkts for 1080p 422 10bit bpm */
+  double t_frame = 1.0 / st_frame_rate(ST_FPS_P59_94);
+  double r_active = 1080.0 / 1125.0;
+  uint32_t cmax = std::max(4, (int)(4320 / (43200 * r_active * t_frame)));
+  uint16_t nb_tx_desc = ctx->para.nb_tx_desc ? ctx->para.nb_tx_desc : 512;
+  info("%s, pacing way %d cmax %u\n", __func__, stats.pacing_way, cmax);
+  switch (stats.pacing_way) {
+    case ST21_TX_PACING_WAY_TSN:
+      /* the emulation holds each pkt until the launch time */
+      EXPECT_EQ(stats.early_pkts, 0);
+      EXPECT_EQ(stats.ahead_max_pkts, 0);
+      EXPECT_LT(stats.late_p99_ns, 20 * 1000);
+      break;
+    case ST21_TX_PACING_WAY_TSC:
+    case ST21_TX_PACING_WAY_TSC_NARROW:
+    case ST21_TX_PACING_WAY_PTP:
+      /* the pkts of one bulk leave together, the bulk should fit the narrow vrx */
+      EXPECT_LE(stats.ahead_max_pkts, cmax);
+      EXPECT_LT(stats.late_p99_ns, 50 * 1000);
+      break;
+    case ST21_TX_PACING_WAY_RL:
+      /* paced by the NIC, a pkt can't be ahead more than a full tx desc ring drain */
+      EXPECT_LT(stats.early_max_ns, (uint64_t)(nb_tx_desc * t_frame / 4320 * NS_PER_S));
+      EXPECT_LT(stats.late_p99_ns, 50 * 1000);
+      break;
+    default:
+      /* best effort, no pacing at all */
+      break;
+  }
+}
 TEST(St20_tx, mix_1080p_fps59_94_s3) {
   enum st20_type type[3] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_RTP_LEVEL,
                             ST20_TYPE_FRAME_LEVEL};
@@ -1796,12 +2174,14 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
                                 enum st20_fmt fmt[], bool check_fps,
                                 enum st_test_level level, int sessions = 1,
                                 bool out_of_order = false, bool hdr_split = false,
-                                bool enable_rtcp = false) {
+                                bool enable_rtcp = false, int ooo_frame_pkts = 0,
+                                uint16_t num_builders = 0, bool mbuf_chain = false) {
   auto ctx = (struct st_tests_context*)st_test_ctx();
   auto m_handle = ctx->handle;
   int ret;
   struct st20_tx_ops ops_tx;
   struct st20_rx_ops ops_rx;
+  uint32_t rx_mbufs_before = 0, rx_mbufs_after = 0;
 
   /* return if level small than global */
   if (level < ctx->level) return;
@@ -1812,6 +2192,17 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
     return;
   }
 
+  /* the nic only scatter the pkt into chained mbufs with a small data room */
+  if (mbuf_chain && (!ctx->para.rx_pool_data_size ||
+                     ctx->para.rx_pool_data_size >= ST20_TEST_CHAIN_DATA_ROOM_MAX)) {
+    info("%s, skip as no small rx_pool_data_size for chained mbufs\n", __func__);
+    return;
+  }
+  if (mbuf_chain) {
+    ret = mtl_rx_mbufs_in_use(m_handle, MTL_PORT_R, &rx_mbufs_before);
+    ASSERT_GE(ret, 0);
+  }
+
   bool has_dma = st_test_dma_available(ctx);
 
   std::vector<tests_context*> test_ctx_tx;
@@ -1869,6 +2260,7 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
     ops_tx.framebuff_cnt = test_ctx_tx[i]->fb_cnt;
     ops_tx.get_next_frame = interlaced[i] ? tx_next_video_field : tx_next_video_frame;
     ops_tx.query_frame_lines_ready = tx_frame_lines_ready;
+    ops_tx.num_builders = num_builders;
     if (tx_type[i] == ST20_TYPE_RTP_LEVEL) {
       rtp_tx_specific_init(&ops_tx, test_ctx_tx[i]);
     }
@@ -1888,6 +2280,7 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
       tx_video_build_ooo_mapping(test_ctx_tx[i]);
     }
     test_ctx_tx[i]->out_of_order_pkt = out_of_order;
+    test_ctx_tx[i]->ooo_frame_pkts = ooo_frame_pkts;
 
     tx_handle[i] = st20_tx_create(m_handle, &ops_tx);
     ASSERT_TRUE(tx_handle[i] != NULL);
@@ -1965,6 +2358,8 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
     ops_rx.rtp_ring_size = 1024 * 2;
     ops_rx.flags = ST20_RX_FLAG_DMA_OFFLOAD;
     if (hdr_split) ops_rx.flags |= ST20_RX_FLAG_HDR_SPLIT;
+    /* two frames in assembling when the tail of a frame comes after next frame */
+    if (ooo_frame_pkts) ops_rx.slots_cnt = 2;
     struct st_rx_rtcp_ops ops_rx_rtcp;
     memset(&ops_rx_rtcp, 0, sizeof(ops_rx_rtcp));
     if (enable_rtcp) {
@@ -2090,6 +2485,22 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
     if (check_fps) {
       EXPECT_NEAR(framerate[i], expect_framerate[i], expect_framerate[i] * 0.1);
     }
+    /* the chunks from all builders should be merged in the seq order */
+    if (num_builders && (rx_type[i] == ST20_TYPE_RTP_LEVEL)) {
+      EXPECT_EQ(test_ctx_rx[i]->rx_seq_gap_cnt, 0);
+    }
+    if (mbuf_chain) {
+      struct st20_rx_mbuf_chain_stats chain_stats;
+      ret = st20_rx_get_mbuf_chain_stats(rx_handle[i], &chain_stats);
+      EXPECT_GE(ret, 0);
+      EXPECT_GT(chain_stats.pkts_received, (uint64_t)0);
+      EXPECT_EQ(chain_stats.pkts_dropped, (uint64_t)0);
+      /* the segments above the dma min size go to the dma */
+      if (st20_rx_dma_enabled(rx_handle[i]))
+        EXPECT_GT(chain_stats.dma_copies, (uint64_t)0);
+      info("%s, session %d chained pkts %" PRIu64 " dma copies %" PRIu64 "\n", __func__,
+           i, chain_stats.pkts_received, chain_stats.dma_copies);
+    }
     ret = st20_tx_free(tx_handle[i]);
     EXPECT_GE(ret, 0);
     ret = st20_rx_free(rx_handle[i]);
@@ -2099,6 +2510,15 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
     delete test_ctx_tx[i];
     delete test_ctx_rx[i];
   }
+
+  /* all the segments borrowed by the dma copies should be back to the pools */
+  if (mbuf_chain) {
+    ret = mtl_rx_mbufs_in_use(m_handle, MTL_PORT_R, &rx_mbufs_after);
+    EXPECT_GE(ret, 0);
+    EXPECT_LE(rx_mbufs_after, rx_mbufs_before + ST20_TEST_CHAIN_REARM_SLACK);
+    info("%s, rx mbufs in use %u before, %u after\n", __func__, rx_mbufs_before,
+         rx_mbufs_after);
+  }
 }
 
 TEST(St20_rx, digest_frame_1080p_fps59_94_s1) {
@@ -2114,6 +2534,20 @@ TEST(St20_rx, digest_frame_1080p_fps59_94_s1) {
                       ST_TEST_LEVEL_ALL);
 }
 
+/* run with --rx_pool_data_size, and --sw_dma or --dma_dev for the dma copy of segs */
+TEST(St20_rx, digest_frame_mbuf_chain_1080p_fps59_94_s1) {
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_type rx_type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[1] = {ST20_PACKING_BPM};
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  st20_rx_digest_test(type, rx_type, packing, fps, width, height, interlaced, fmt, true,
+                      ST_TEST_LEVEL_ALL, 1, false, false, false, 0, 0, true);
+}
+
 TEST(St20_rx, digest20_field_1080p_fps59_94_s1) {
   enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
   enum st20_type rx_type[1] = {ST20_TYPE_FRAME_LEVEL};
@@ -2192,6 +2626,51 @@ TEST(St20_rx, digest_rtp_1080p_fps59_94_s1) {
                       ST_TEST_LEVEL_ALL);
 }
 
+/*
+ * the hdr mbufs are reused many times over the recycle fifo depth in the 10s run, the
+ * rx only get the frame complete with the right hdr bytes and the right payload digest
+ */
+static void st20_rx_digest_recycle_test(enum st20_type rx_type) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+
+  if (!(ctx->para.flags & MTL_FLAG_TX_MBUF_RECYCLE)) {
+    info("%s, skip as tx mbuf recycle not enabled\n", __func__);
+    return;
+  }
+
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_type rx_types[1] = {rx_type};
+  enum st20_packing packing[1] = {ST20_PACKING_BPM};
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  st20_rx_digest_test(type, rx_types, packing, fps, width, height, interlaced, fmt, true,
+                      ST_TEST_LEVEL_ALL);
+}
+
+TEST(St20_rx, digest_frame_1080p_fps59_94_s1_recycle) {
+  st20_rx_digest_recycle_test(ST20_TYPE_FRAME_LEVEL);
+}
+
+TEST(St20_rx, digest_frame_rtp_1080p_fps59_94_s1_recycle) {
+  st20_rx_digest_recycle_test(ST20_TYPE_RTP_LEVEL);
+}
+
+TEST(St20_rx, digest_frame_rtp_1080p_fps59_94_s2_builders) {
+  enum st20_type type[2] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_FRAME_LEVEL};
+  enum st20_type rx_type[2] = {ST20_TYPE_RTP_LEVEL, ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[2] = {ST20_PACKING_BPM, ST20_PACKING_GPM};
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P59_94};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  bool interlaced[2] = {false, false};
+  enum st20_fmt fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  st20_rx_digest_test(type, rx_type, packing, fps, width, height, interlaced, fmt, true,
+                      ST_TEST_LEVEL_ALL, 2, false, false, false, 0, 2);
+}
+
 TEST(St20_rx, digest_frame_720p_fps59_94_s3) {
   enum st20_type type[3] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_FRAME_LEVEL,
                             ST20_TYPE_FRAME_LEVEL};
@@ -2409,6 +2888,24 @@ TEST(St20_rx, digest_ooo_frame_s3) {
                       ST_TEST_LEVEL_MANDATORY, 3, true);
 }
 
+TEST(St20_rx, digest_ooo_cross_frame_s3) {
+  enum st20_type type[3] = {ST20_TYPE_RTP_LEVEL, ST20_TYPE_RTP_LEVEL,
+                            ST20_TYPE_RTP_LEVEL};
+  enum st20_type rx_type[3] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_FRAME_LEVEL,
+                               ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[3] = {ST20_PACKING_BPM, ST20_PACKING_GPM,
+                                  ST20_PACKING_BPM};
+  enum st_fps fps[3] = {ST_FPS_P50, ST_FPS_P50, ST_FPS_P59_94};
+  int width[3] = {1920, 1280, 1280};
+  int height[3] = {1080, 720, 720};
+  bool interlaced[3] = {false, false, false};
+  enum st20_fmt fmt[3] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT,
+                          ST20_FMT_YUV_422_10BIT};
+  /* the pkts are also shuffled inside each frame */
+  st20_rx_digest_test(type, rx_type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_MANDATORY, 3, true, false, false, 64);
+}
+
 TEST(St20_rx, digest_tx_slice_s3) {
   enum st20_type type[3] = {ST20_TYPE_SLICE_LEVEL, ST20_TYPE_SLICE_LEVEL,
                             ST20_TYPE_SLICE_LEVEL};
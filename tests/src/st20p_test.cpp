@@ -376,7 +376,16 @@ static void test_st20p_tx_frame_thread(void* args) {
       frame->user_meta = &meta;
       frame->user_meta_size = sizeof(meta);
     }
-    if (s->p_ext_frames) {
+    if (s->tx_copy) {
+      int ret = st20p_tx_put_frame_copy((st20p_tx_handle)handle, frame,
+                                        &s->p_ext_frames[s->ext_idx]);
+      if (ret < 0) {
+        err("%s, put frame copy fail %d fb_idx %d\n", __func__, ret, s->ext_idx);
+        continue;
+      }
+      s->ext_idx++;
+      if (s->ext_idx >= s->fb_cnt) s->ext_idx = 0;
+    } else if (s->p_ext_frames) {
       int ret = st20p_tx_put_ext_frame((st20p_tx_handle)handle, frame,
                                        &s->p_ext_frames[s->ext_idx]);
       if (ret < 0) {
@@ -609,6 +618,7 @@ struct st20p_rx_digest_test_para {
   int timeout_interval;
   int timeout_ms;
   bool tx_ext;
+  bool tx_copy;
   bool rx_ext;
   bool rx_get_ext;
   bool check_fps;
@@ -631,6 +641,7 @@ static void test_st20p_init_rx_digest_para(struct st20p_rx_digest_test_para* par
   para->timeout_interval = 0;
   para->timeout_ms = 0;
   para->tx_ext = false;
+  para->tx_copy = false;
   para->rx_ext = false;
   para->rx_get_ext = false;
   para->check_fps = true;
@@ -668,7 +679,7 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
   /* return if level lower than global */
   if (para->level < ctx->level) return;
 
-  if (para->tx_ext || para->rx_ext) {
+  if (para->tx_ext || para->tx_copy || para->rx_ext) {
     if (ctx->iova == MTL_IOVA_MODE_PA) {
       info("%s, skip ext_buf test as it's PA iova mode\n", __func__);
       return;
@@ -746,6 +757,10 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     if (para->tx_ext) {
       ops_tx.flags |= ST20P_TX_FLAG_EXT_FRAME;
     }
+    if (para->tx_copy) {
+      ops_tx.flags |= ST20P_TX_FLAG_DMA_OFFLOAD;
+      test_ctx_tx[i]->tx_copy = true;
+    }
     if (para->user_timestamp) ops_tx.flags |= ST20P_TX_FLAG_USER_TIMESTAMP;
     if (para->vsync) ops_tx.flags |= ST20P_TX_FLAG_ENABLE_VSYNC;
 
@@ -767,7 +782,7 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     uint8_t* fb;
 
     /* init ext frames, only for no convert */
-    if (para->tx_ext) {
+    if (para->tx_ext || para->tx_copy) {
       test_ctx_tx[i]->p_ext_frames = (struct st_ext_frame*)malloc(
           sizeof(*test_ctx_tx[i]->p_ext_frames) * test_ctx_tx[i]->fb_cnt);
       size_t pg_sz = mtl_page_size(st);
@@ -809,7 +824,7 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     }
 
     for (int frame = 0; frame < TEST_SHA_HIST_NUM; frame++) {
-      if (para->tx_ext)
+      if (para->tx_ext || para->tx_copy)
         fb = (uint8_t*)test_ctx_tx[i]->ext_fb + frame * frame_size;
       else
         fb = (uint8_t*)st20p_tx_get_fb_addr(tx_handle[i], frame);
@@ -1038,7 +1053,7 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     info("%s, session %d fb_send %d framerate %f:%f\n", __func__, i,
          test_ctx_tx[i]->fb_send, framerate_tx[i], expect_framerate_tx[i]);
     EXPECT_GT(test_ctx_tx[i]->fb_send, 0);
-    if (para->tx_ext) {
+    if (para->tx_ext || para->tx_copy) {
       mtl_dma_unmap(st, test_ctx_tx[i]->ext_fb, test_ctx_tx[i]->ext_fb_iova,
                     test_ctx_tx[i]->ext_fb_iova_map_sz);
       st_test_free(test_ctx_tx[i]->ext_fb_malloc);
@@ -1255,6 +1270,26 @@ TEST(St20p, tx_ext_digest_1080p_no_convert_s2) {
   st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
 }
 
+TEST(St20p, tx_copy_digest_1080p_no_convert_s2) {
+  enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                                 ST_FRAME_FMT_YUV422RFC4175PG2BE10};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                                 ST_FRAME_FMT_YUV422RFC4175PG2BE10};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.tx_copy = true;
+  para.level = ST_TEST_LEVEL_ALL;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
 TEST(St20p, tx_ext_digest_1080p_convert_s2) {
   enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
   int width[2] = {1920, 1920};
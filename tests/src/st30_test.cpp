@@ -684,6 +684,42 @@ TEST(St30_rx, mix_48k_96_mix) {
   enum st30_fmt f[3] = {ST30_FMT_PCM8, ST30_FMT_PCM16, ST30_FMT_PCM24};
   st30_rx_fps_test(type, s, pt, c, f, ST_TEST_LEVEL_ALL, 3);
 }
+/* run on a veth pair with --af_packet, see tests/script/af_packet_test.sh */
+TEST(St30_rx, af_packet_loopback) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  struct mtl_port_status stats_tx, stats_rx;
+  int ret;
+
+  if ((ctx->para.num_ports != 2) ||
+      (ctx->para.pmd[MTL_PORT_P] != MTL_PMD_AF_PACKET) ||
+      (ctx->para.pmd[MTL_PORT_R] != MTL_PMD_AF_PACKET)) {
+    info("%s, skip as the ports are not the af_packet pmd\n", __func__);
+    return;
+  }
+
+  mtl_reset_port_stats(m_handle, MTL_PORT_P);
+  mtl_reset_port_stats(m_handle, MTL_PORT_R);
+
+  enum st30_type type[2] = {ST30_TYPE_FRAME_LEVEL, ST30_TYPE_RTP_LEVEL};
+  enum st30_sampling s[2] = {ST30_SAMPLING_48K, ST30_SAMPLING_48K};
+  enum st30_ptime pt[2] = {ST30_PTIME_1MS, ST30_PTIME_1MS};
+  uint16_t c[2] = {2, 2};
+  enum st30_fmt f[2] = {ST30_FMT_PCM16, ST30_FMT_PCM24};
+  st30_rx_fps_test(type, s, pt, c, f, ST_TEST_LEVEL_MANDATORY, 2, true);
+
+  /* the pkts really go through the vdev, 1000 pkts per second for each session */
+  ret = mtl_get_port_stats(m_handle, MTL_PORT_P, &stats_tx);
+  EXPECT_GE(ret, 0);
+  ret = mtl_get_port_stats(m_handle, MTL_PORT_R, &stats_rx);
+  EXPECT_GE(ret, 0);
+  info("%s, tx pkts %" PRIu64 " rx pkts %" PRIu64 "\n", __func__, stats_tx.tx_packets,
+       stats_rx.rx_packets);
+  EXPECT_GT(stats_tx.tx_packets, (uint64_t)2 * 1000 * 5);
+  EXPECT_GT(stats_rx.rx_packets, (uint64_t)2 * 1000 * 5);
+  EXPECT_EQ(stats_tx.tx_err_packets, (uint64_t)0);
+}
+
 TEST(St30_rx, frame_digest_48k_96_mix) {
   enum st30_type type[2] = {ST30_TYPE_FRAME_LEVEL, ST30_TYPE_FRAME_LEVEL};
   enum st30_sampling s[2] = {ST30_SAMPLING_96K, ST30_SAMPLING_48K};
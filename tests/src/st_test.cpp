@@ -2,7 +2,12 @@
  * Copyright(c) 2022 Intel Corporation
  */
 
+#include <thread>
+
 #include "log.h"
+#include "mt_sch_test.h"
+#include "mt_shared_queue_test.h"
+#include "mt_util_test.h"
 #include "tests.h"
 
 int st_test_sch_cnt(struct st_tests_context* ctx) {
@@ -443,6 +448,349 @@ static void size_page_align_test() {
 
 TEST(Main, size_page_align) { size_page_align_test(); }
 
+/* the per pkt cost of the shared queue dispatch should stay flat with the flows */
+TEST(Main, flow_hash_bench) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  uint32_t nb_flows[5] = {1, 10, 100, 1000, 10000};
+  uint32_t nb_pkts = 1000 * 1000;
+  double ns_per_pkt[5];
+  int ret;
+
+  for (int i = 0; i < 5; i++) {
+    ret = mtl_flow_hash_bench(handle, nb_flows[i], nb_pkts, &ns_per_pkt[i]);
+    ASSERT_GE(ret, 0);
+    info("%s, flows %u, %fns per pkt\n", __func__, nb_flows[i], ns_per_pkt[i]);
+  }
+  EXPECT_LT(ns_per_pkt[3], ns_per_pkt[0] * 3 + 50);
+  /* the buckets grow with the flows, the chains should not get longer */
+  EXPECT_LT(ns_per_pkt[4], ns_per_pkt[0] * 3 + 50);
+
+  ret = mtl_flow_hash_bench(handle, 0, nb_pkts, &ns_per_pkt[0]);
+  EXPECT_LT(ret, 0);
+}
+
+/* the ring path should not lose any pkt and compare with the tx mutex path */
+TEST(Main, tsq_stress) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  struct mtl_tsq_stress_result mutex_result, ring_result;
+  uint32_t nb_producers = 8;
+  uint32_t nb_pkts = 1024 * 16;
+  int ret;
+
+  ret = mtl_tsq_stress(handle, MTL_PORT_P, true, nb_producers, nb_pkts, &mutex_result);
+  if (ret == -ENOTSUP) {
+    info("%s, skip as shared tx queue not enabled\n", __func__);
+    return;
+  }
+  ASSERT_GE(ret, 0);
+  ret = mtl_tsq_stress(handle, MTL_PORT_P, false, nb_producers, nb_pkts, &ring_result);
+  ASSERT_GE(ret, 0);
+
+  uint64_t total = (uint64_t)nb_producers * nb_pkts;
+  EXPECT_EQ(mutex_result.sent, total);
+  EXPECT_EQ(ring_result.sent, total);
+  EXPECT_EQ(ring_result.dropped, (uint64_t)0);
+  info("%s, mutex pps %f p99 %" PRIu64 "ns, ring pps %f p99 %" PRIu64 "ns\n", __func__,
+       mutex_result.pps, mutex_result.p99_ns, ring_result.pps, ring_result.p99_ns);
+}
+
+static uint32_t bitmap64_count_ref(uint64_t* bitmap, uint32_t nb_words) {
+  uint32_t cnt = 0;
+  for (uint32_t i = 0; i < nb_words * 64; i++) {
+    if (bitmap[i / 64] & (UINT64_C(1) << (i % 64))) cnt++;
+  }
+  return cnt;
+}
+
+static int bitmap64_missing_ranges_ref(uint64_t* bitmap, uint32_t nb_bits,
+                                       struct st20_rx_pkt_range* ranges, int max) {
+  int nb = 0;
+  uint32_t i = 0;
+
+  while (i < nb_bits && nb < max) {
+    if (bitmap[i / 64] & (UINT64_C(1) << (i % 64))) {
+      i++;
+      continue;
+    }
+    ranges[nb].start = i;
+    while (i < nb_bits && !(bitmap[i / 64] & (UINT64_C(1) << (i % 64)))) i++;
+    ranges[nb].nb = i - ranges[nb].start;
+    nb++;
+  }
+  return nb;
+}
+
+/* the sizes cover the avx512(8 words) and avx2(4 words) loops and the scalar tails */
+TEST(Main, bitmap64) {
+  const uint32_t nb_words[] = {1, 3, 4, 7, 8, 9, 17, 70};
+  const enum mtl_simd_level levels[] = {MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX512};
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  const int max_ranges = ST20_RX_MISSING_RANGES_MAX;
+  struct st20_rx_pkt_range ranges[max_ranges], expect[max_ranges];
+  uint64_t bitmap[71]; /* one more word as the guard */
+
+  srand(st_test_get_monotonic_time());
+  for (enum mtl_simd_level level : levels) {
+    if (level > cpu_level) {
+      info("%s, skip %s as not supported by cpu\n", __func__,
+           mtl_get_simd_level_name(level));
+      continue;
+    }
+    for (uint32_t words : nb_words) {
+      for (int loop = 0; loop < 16; loop++) {
+        for (uint32_t i = 0; i < 71; i++)
+          bitmap[i] = ((uint64_t)rand() << 32) | (uint64_t)rand();
+        /* long runs of loss and of received pkts */
+        if (loop % 4 == 1) bitmap[rand() % words] = 0;
+        if (loop % 4 == 2) bitmap[rand() % words] = UINT64_MAX;
+        uint64_t guard = bitmap[words];
+
+        EXPECT_EQ(mtl_bitmap64_count(bitmap, words, level),
+                  bitmap64_count_ref(bitmap, words));
+
+        uint32_t nb_bits = words * 64 - rand() % 64;
+        int nb = mtl_bitmap64_missing_ranges(bitmap, nb_bits, ranges, max_ranges);
+        int nb_expect = bitmap64_missing_ranges_ref(bitmap, nb_bits, expect, max_ranges);
+        ASSERT_EQ(nb, nb_expect);
+        for (int i = 0; i < nb; i++) {
+          EXPECT_EQ(ranges[i].start, expect[i].start);
+          EXPECT_EQ(ranges[i].nb, expect[i].nb);
+        }
+
+        mtl_bitmap64_clear(bitmap, words, level);
+        EXPECT_EQ(mtl_bitmap64_count(bitmap, words, level), (uint32_t)0);
+        /* no write beyond the words */
+        EXPECT_EQ(bitmap[words], guard);
+      }
+    }
+  }
+
+  /* all lost, one range to the end */
+  memset(bitmap, 0, sizeof(bitmap));
+  EXPECT_EQ(mtl_bitmap64_missing_ranges(bitmap, 100, ranges, max_ranges), 1);
+  EXPECT_EQ(ranges[0].start, (uint32_t)0);
+  EXPECT_EQ(ranges[0].nb, (uint32_t)100);
+  /* all got, the set bits beyond nb_bits are ignored */
+  memset(bitmap, 0xff, sizeof(bitmap));
+  EXPECT_EQ(mtl_bitmap64_missing_ranges(bitmap, 100, ranges, max_ranges), 0);
+  /* a loss across the word boundary */
+  bitmap[0] &= ~(UINT64_C(1) << 63);
+  bitmap[1] &= ~UINT64_C(1);
+  EXPECT_EQ(mtl_bitmap64_missing_ranges(bitmap, 100, ranges, max_ranges), 1);
+  EXPECT_EQ(ranges[0].start, (uint32_t)63);
+  EXPECT_EQ(ranges[0].nb, (uint32_t)2);
+  /* stop at max ranges */
+  for (int i = 0; i < 64; i += 2) bitmap[0] &= ~(UINT64_C(1) << i);
+  EXPECT_EQ(mtl_bitmap64_missing_ranges(bitmap, 100, ranges, 4), 4);
+  EXPECT_LT(mtl_bitmap64_missing_ranges(bitmap, 100, ranges, 0), 0);
+}
+
+static void pacing_cache_append_thread(mtl_handle handle, const char* path,
+                                       uint64_t rl_bps, int* ret) {
+  *ret = mtl_pacing_train_cache_append(handle, MTL_PORT_P, path, rl_bps,
+                                       (float)(rl_bps % 1000 + 100));
+}
+
+/* the results appended concurrently should all read back from one valid file */
+TEST(Main, pacing_cache) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  const char* path = "/tmp/st_test_pacing_cache.txt";
+  const int nb = 8;
+  std::thread threads[nb];
+  int thread_ret[nb];
+  uint64_t rl_bps[nb * 2];
+  float pad_intervals[nb * 2];
+  char line[128];
+  int ret;
+
+  remove(path);
+  ret = mtl_pacing_train_cache_read(handle, MTL_PORT_P, path, rl_bps, pad_intervals, nb);
+  EXPECT_EQ(ret, 0);
+
+  for (int i = 0; i < nb; i++)
+    threads[i] = std::thread(pacing_cache_append_thread, handle, path,
+                             (uint64_t)(i + 1) * 1000 * 1000 + i, &thread_ret[i]);
+  for (int i = 0; i < nb; i++) {
+    threads[i].join();
+    EXPECT_GE(thread_ret[i], 0);
+  }
+
+  ret = mtl_pacing_train_cache_read(handle, MTL_PORT_P, path, rl_bps, pad_intervals,
+                                    nb * 2);
+  EXPECT_EQ(ret, nb);
+  for (int i = 0; i < ret; i++)
+    EXPECT_EQ(pad_intervals[i], (float)(rl_bps[i] % 1000 + 100));
+
+  /* only one header even with the concurrent appends */
+  FILE* fp = fopen(path, "r");
+  ASSERT_TRUE(fp != NULL);
+  int headers = 0, lines = 0;
+  while (fgets(line, sizeof(line), fp)) {
+    lines++;
+    if (!strncmp(line, "mtl_pacing_train_cache", strlen("mtl_pacing_train_cache")))
+      headers++;
+  }
+  fclose(fp);
+  EXPECT_EQ(headers, 1);
+  EXPECT_EQ(lines, nb + 1);
+
+  /* a stale file is ignored but not truncated by the read */
+  fp = fopen(path, "w");
+  ASSERT_TRUE(fp != NULL);
+  fprintf(fp, "stale_cache 0\n");
+  fclose(fp);
+  ret = mtl_pacing_train_cache_read(handle, MTL_PORT_P, path, rl_bps, pad_intervals, nb);
+  EXPECT_EQ(ret, 0);
+  fp = fopen(path, "r");
+  ASSERT_TRUE(fp != NULL);
+  EXPECT_TRUE(fgets(line, sizeof(line), fp) != NULL);
+  fclose(fp);
+  EXPECT_EQ(strcmp(line, "stale_cache 0\n"), 0);
+
+  /* the next append replace it with a valid one */
+  ret = mtl_pacing_train_cache_append(handle, MTL_PORT_P, path, 1000 * 1000, 200);
+  EXPECT_GE(ret, 0);
+  ret = mtl_pacing_train_cache_read(handle, MTL_PORT_P, path, rl_bps, pad_intervals, nb);
+  EXPECT_EQ(ret, 1);
+  EXPECT_EQ(rl_bps[0], (uint64_t)1000 * 1000);
+  EXPECT_EQ(pad_intervals[0], (float)200);
+
+  remove(path);
+}
+
+/* the admission estimate the load by the measured cost of the tasklets on the sch */
+TEST(Main, sch_measured_quota_admit) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  struct mtl_sch_busy_ops ops;
+  mtl_sch_busy_handle busy, reject, admit;
+  float load, cost;
+  int sch_idx, ret;
+
+  if (!(ctx->para.flags & MTL_FLAG_SCH_MEASURED_QUOTA))
+    GTEST_SKIP() << "measured quota not enabled, run with --sch_measured_quota";
+
+  ret = mtl_start(handle);
+  EXPECT_GE(ret, 0);
+
+  memset(&ops, 0, sizeof(ops));
+  ops.name = "sch_busy";
+  ops.quota_mbs = 1000;
+  ops.load = 50;
+  ops.sch_idx = -1;
+  busy = mtl_sch_busy_tasklet_create(handle, &ops);
+  ASSERT_TRUE(busy != NULL);
+  sch_idx = mtl_sch_busy_tasklet_sch(busy);
+
+  /* the first window start with the quota change, wait one more */
+  sleep(3);
+  ret = mtl_sch_load_get(handle, sch_idx, &load, &cost);
+  EXPECT_GE(ret, 0);
+  info("%s, sch %d load %f cost %f\n", __func__, sch_idx, load, cost);
+  EXPECT_NEAR(load, 50, 10);
+  EXPECT_GT(cost, 0);
+
+  /* 2000 mb/s is estimated to about 100% */
+  ops.name = "sch_busy_reject";
+  ops.quota_mbs = 1000;
+  ops.load = 1;
+  ops.sch_idx = sch_idx;
+  reject = mtl_sch_busy_tasklet_create(handle, &ops);
+  EXPECT_TRUE(reject == NULL);
+  if (reject) mtl_sch_busy_tasklet_free(reject);
+
+  /* 1200 mb/s is estimated to about 60% */
+  ops.name = "sch_busy_admit";
+  ops.quota_mbs = 200;
+  admit = mtl_sch_busy_tasklet_create(handle, &ops);
+  ASSERT_TRUE(admit != NULL);
+  EXPECT_EQ(mtl_sch_busy_tasklet_sch(admit), sch_idx);
+
+  /* the cost of the old quota is stale, till a new window measured */
+  ret = mtl_sch_load_get(handle, sch_idx, &load, &cost);
+  EXPECT_GE(ret, 0);
+  EXPECT_EQ(cost, 0);
+  sleep(3);
+  ret = mtl_sch_load_get(handle, sch_idx, &load, &cost);
+  EXPECT_GE(ret, 0);
+  info("%s, sch %d load %f cost %f after admit\n", __func__, sch_idx, load, cost);
+  EXPECT_NEAR(load, 51, 10);
+  EXPECT_GT(cost, 0);
+
+  mtl_sch_busy_tasklet_free(admit);
+  mtl_sch_busy_tasklet_free(busy);
+  ret = mtl_stop(handle);
+  EXPECT_GE(ret, 0);
+}
+
+/* the busy tasklets on one sch should be spread till the utilization gap is closed */
+TEST(Main, sch_tasklet_balance_converge) {
+  struct st_tests_context* ctx = st_test_ctx();
+  mtl_handle handle = ctx->handle;
+  const int nb_busy = 4;
+  mtl_sch_busy_handle busy[nb_busy];
+  struct mtl_sch_busy_ops ops;
+  char name[nb_busy][32];
+  uint32_t rounds, last_rounds = 0;
+  float max_util = 0, min_util = 0, gap = 0;
+  int sch_idx = -1, converged = 0, ret;
+
+  if (!(ctx->para.flags & MTL_FLAG_TASKLET_BALANCE))
+    GTEST_SKIP() << "tasklet balance not enabled, run with --tasklet_balance";
+
+  ret = mtl_start(handle);
+  EXPECT_GE(ret, 0);
+
+  /* 4 * 15% on one new sch, any single move close a gap bigger than 15% */
+  memset(&ops, 0, sizeof(ops));
+  ops.load = 15;
+  ops.balance = true;
+  ops.sch_idx = -1;
+  ops.new_sch = true;
+  for (int i = 0; i < nb_busy; i++) {
+    snprintf(name[i], sizeof(name[i]), "sch_busy_%d", i);
+    ops.name = name[i];
+    busy[i] = mtl_sch_busy_tasklet_create(handle, &ops);
+    ASSERT_TRUE(busy[i] != NULL);
+    if (!i) {
+      sch_idx = mtl_sch_busy_tasklet_sch(busy[i]);
+      ops.sch_idx = sch_idx;
+    }
+  }
+
+  /* the balancer run every 5s, the two windows in a row within the gap */
+  for (int s = 0; s < 90 && converged < 2; s++) {
+    sleep(1);
+    ret = mtl_sch_balance_util(handle, &rounds, &max_util, &min_util, &gap);
+    ASSERT_GE(ret, 0);
+    if (rounds == last_rounds) continue;
+    last_rounds = rounds;
+    info("%s, round %u util max %f min %f at %ds\n", __func__, rounds, max_util,
+         min_util, s);
+    if (max_util - min_util < gap)
+      converged++;
+    else
+      converged = 0;
+  }
+  EXPECT_GE(converged, 2);
+  EXPECT_LT(max_util - min_util, gap);
+
+  /* some moved out from the busy sch */
+  int moved = 0;
+  for (int i = 0; i < nb_busy; i++) {
+    if (mtl_sch_busy_tasklet_sch(busy[i]) != sch_idx) moved++;
+  }
+  EXPECT_GT(moved, 0);
+
+  for (int i = 0; i < nb_busy; i++) mtl_sch_busy_tasklet_free(busy[i]);
+  ret = mtl_stop(handle);
+  EXPECT_GE(ret, 0);
+}
+
 class fps_23_98 : public ::testing::TestWithParam<std::tuple<enum st_fps, double>> {};
 
 TEST_P(fps_23_98, conv_fps_to_st_fps_23_98_test) {
@@ -44,6 +44,17 @@ enum test_args_cmd {
   TEST_ARG_IOVA_MODE,
   TEST_ARG_MULTI_SRC_PORT,
   TEST_ARG_DHCP,
+  TEST_ARG_TX_LAUNCH_TIME_EMU,
+  TEST_ARG_SW_DMA,
+  TEST_ARG_TX_PACING_TRAIN_FAKE,
+  TEST_ARG_TX_MBUF_RECYCLE,
+  TEST_ARG_TASKLET_BALANCE,
+  TEST_ARG_SCH_STATS_SHM,
+  TEST_ARG_CVT_THREADS,
+  TEST_ARG_SHARED_TX_QUEUE,
+  TEST_ARG_RX_POOL_DATA_SIZE,
+  TEST_ARG_AF_PACKET,
+  TEST_ARG_SCH_MEASURED_QUOTA,
 };
 
 static struct option test_args_options[] = {
@@ -80,6 +91,17 @@ static struct option test_args_options[] = {
     {"iova_mode", required_argument, 0, TEST_ARG_IOVA_MODE},
     {"multi_src_port", no_argument, 0, TEST_ARG_MULTI_SRC_PORT},
     {"dhcp", no_argument, 0, TEST_ARG_DHCP},
+    {"tx_launch_time_emu", no_argument, 0, TEST_ARG_TX_LAUNCH_TIME_EMU},
+    {"sw_dma", no_argument, 0, TEST_ARG_SW_DMA},
+    {"tx_pacing_train_fake", no_argument, 0, TEST_ARG_TX_PACING_TRAIN_FAKE},
+    {"tx_mbuf_recycle", no_argument, 0, TEST_ARG_TX_MBUF_RECYCLE},
+    {"tasklet_balance", no_argument, 0, TEST_ARG_TASKLET_BALANCE},
+    {"sch_stats_shm", no_argument, 0, TEST_ARG_SCH_STATS_SHM},
+    {"cvt_threads", required_argument, 0, TEST_ARG_CVT_THREADS},
+    {"shared_tx_queue", no_argument, 0, TEST_ARG_SHARED_TX_QUEUE},
+    {"rx_pool_data_size", required_argument, 0, TEST_ARG_RX_POOL_DATA_SIZE},
+    {"af_packet", no_argument, 0, TEST_ARG_AF_PACKET},
+    {"sch_measured_quota", no_argument, 0, TEST_ARG_SCH_MEASURED_QUOTA},
 
     {0, 0, 0, 0}};
 
@@ -265,6 +287,39 @@ static int test_parse_args(struct st_tests_context* ctx, struct mtl_init_params*
           p->net_proto[port] = MTL_PROTO_DHCP;
         ctx->dhcp = true;
         break;
+      case TEST_ARG_TX_LAUNCH_TIME_EMU:
+        p->flags |= MTL_FLAG_TX_LAUNCH_TIME_EMU;
+        break;
+      case TEST_ARG_SW_DMA:
+        p->flags |= MTL_FLAG_SW_DMA;
+        break;
+      case TEST_ARG_TX_PACING_TRAIN_FAKE:
+        p->flags |= MTL_FLAG_TX_PACING_TRAIN_FAKE;
+        break;
+      case TEST_ARG_TX_MBUF_RECYCLE:
+        p->flags |= MTL_FLAG_TX_MBUF_RECYCLE;
+        break;
+      case TEST_ARG_TASKLET_BALANCE:
+        p->flags |= MTL_FLAG_TASKLET_BALANCE;
+        break;
+      case TEST_ARG_SCH_STATS_SHM:
+        p->flags |= MTL_FLAG_SCH_STATS_SHM;
+        break;
+      case TEST_ARG_CVT_THREADS:
+        p->cvt_threads = atoi(optarg);
+        break;
+      case TEST_ARG_SHARED_TX_QUEUE:
+        p->flags |= MTL_FLAG_SHARED_TX_QUEUE;
+        break;
+      case TEST_ARG_RX_POOL_DATA_SIZE:
+        p->rx_pool_data_size = atoi(optarg);
+        break;
+      case TEST_ARG_AF_PACKET:
+        ctx->af_packet = true;
+        break;
+      case TEST_ARG_SCH_MEASURED_QUOTA:
+        p->flags |= MTL_FLAG_SCH_MEASURED_QUOTA;
+        break;
       default:
         break;
     }
@@ -555,6 +610,8 @@ GTEST_API_ int main(int argc, char** argv) {
   /* parse af xdp pmd info */
   for (int i = 0; i < ctx->para.num_ports; i++) {
     ctx->para.pmd[i] = mtl_pmd_by_port_name(ctx->para.port[i]);
+    if (ctx->af_packet && ctx->para.pmd[i] == MTL_PMD_DPDK_AF_XDP)
+      ctx->para.pmd[i] = MTL_PMD_AF_PACKET;
     if (ctx->para.pmd[i] != MTL_PMD_DPDK_USER) {
       mtl_get_if_ip(ctx->para.port[i], ctx->para.sip_addr[i], ctx->para.netmask[i]);
       ctx->para.flags |= MTL_FLAG_RX_SEPARATE_VIDEO_LCORE;
@@ -93,6 +93,7 @@ struct st_tests_context {
   enum st_test_level level;
   bool hdr_split;
   bool dhcp;
+  bool af_packet; /* use the native af_packet socket backend for the kernel ports */
   enum mtl_iova_mode iova;
   enum mtl_rss_mode rss_mode;
 
@@ -200,6 +201,9 @@ class tests_context {
   int user_meta_fail_cnt = 0;
   bool out_of_order_pkt = false; /* out of order pkt index */
   int* ooo_mapping = NULL;
+  int ooo_frame_pkts = 0; /* tail pkts of a frame sent after the head of next frame */
+  int64_t rx_seq_id = -1; /* last rtp seq id received */
+  int rx_seq_gap_cnt = 0;
   int slice_cnt = 0;
   uint32_t slice_recv_lines = 0;
   uint64_t slice_recv_timestamp = 0;
@@ -213,6 +217,7 @@ class tests_context {
   bool ext_fb_in_use[3] = {false}; /* assume 3 framebuffer */
   mtl_dma_mem_handle dma_mem = NULL;
   bool rx_get_ext = false;
+  bool tx_copy = false; /* put the ext frames with a lib copy */
 
   bool user_pacing = false;
   /* user timestamp which advanced by 1 for every frame */
@@ -6,6 +6,10 @@
 
 #include <getopt.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include "log.h"
 
 enum utest_args_cmd {
@@ -272,6 +276,139 @@ void socketopt_half(struct timeval* i) {
 }
 TEST(Api, socket_rcvtimeo) { socketopt_test<struct timeval>(SOL_SOCKET, SO_RCVTIMEO); }
 
+static void tx_multi_thread_sender(int fd, struct sockaddr_in* addr, int pkts,
+                                   std::vector<uint64_t>* lat_ns, int* sent) {
+  size_t payload_len = 1024;
+  char send_buf[payload_len];
+  st_test_rand_data((uint8_t*)send_buf, payload_len, 0);
+
+  for (int i = 0; i < pkts; i++) {
+    uint64_t start = st_test_get_monotonic_time();
+    ssize_t ret = mufd_sendto(fd, send_buf, sizeof(send_buf), 0,
+                              (const struct sockaddr*)addr, sizeof(*addr));
+    lat_ns->push_back(st_test_get_monotonic_time() - start);
+    if (ret == (ssize_t)sizeof(send_buf)) (*sent)++;
+  }
+}
+
+/* many producers on the tx queues, run with --queue_mode shared for the shared tx queue */
+static void socket_tx_multi_thread_test(enum mtl_port port, int threads, int pkts) {
+  struct utest_ctx* ctx = utest_get_ctx();
+  struct mtl_init_params* p = &ctx->init_params.mt_params;
+  int fds[threads];
+  struct sockaddr_in addr[threads];
+  std::vector<std::thread> sender(threads);
+  std::vector<std::vector<uint64_t>> lat_ns(threads);
+  int sent[threads];
+  int ret;
+
+  for (int i = 0; i < threads; i++) {
+    fds[i] = -1;
+    sent[i] = 0;
+    lat_ns[i].reserve(pkts);
+    mufd_init_sockaddr(&addr[i], p->sip_addr[MTL_PORT_R], 30000 + i);
+  }
+
+  for (int i = 0; i < threads; i++) {
+    ret = mufd_socket_port(AF_INET, SOCK_DGRAM, 0, port);
+    EXPECT_GE(ret, 0);
+    if (ret < 0) goto exit;
+    fds[i] = ret;
+  }
+
+  {
+    uint64_t start = st_test_get_monotonic_time();
+    for (int i = 0; i < threads; i++) {
+      sender[i] =
+          std::thread(tx_multi_thread_sender, fds[i], &addr[i], pkts, &lat_ns[i], &sent[i]);
+    }
+    for (int i = 0; i < threads; i++) sender[i].join();
+    uint64_t duration_ns = st_test_get_monotonic_time() - start;
+
+    std::vector<uint64_t> all_lat_ns;
+    int total_sent = 0;
+    for (int i = 0; i < threads; i++) {
+      all_lat_ns.insert(all_lat_ns.end(), lat_ns[i].begin(), lat_ns[i].end());
+      total_sent += sent[i];
+    }
+    std::sort(all_lat_ns.begin(), all_lat_ns.end());
+    uint64_t p99_ns = all_lat_ns[all_lat_ns.size() * 99 / 100];
+    double pps = (double)total_sent * NS_PER_S / duration_ns;
+    info("%s(%d), %d threads, pps %f, p99 latency %" PRIu64 "ns max %" PRIu64 "ns\n",
+         __func__, port, threads, pps, p99_ns, all_lat_ns.back());
+    EXPECT_EQ(total_sent, threads * pkts);
+  }
+
+exit:
+  for (int i = 0; i < threads; i++) {
+    if (fds[i] >= 0) mufd_close(fds[i]);
+  }
+}
+
+TEST(Api, socket_tx_multi_thread) {
+  socket_tx_multi_thread_test(MTL_PORT_P, 8, 1024 * 16);
+}
+TEST(Api, socket_tx_multi_thread_r) {
+  socket_tx_multi_thread_test(MTL_PORT_R, 8, 1024 * 16);
+}
+
+/* one pkt on a idle tx queue should leave without any following traffic */
+static void socket_tx_idle_single_test(enum mtl_port tx_port, enum mtl_port rx_port) {
+  struct utest_ctx* ctx = utest_get_ctx();
+  struct mtl_init_params* p = &ctx->init_params.mt_params;
+  int tx_fd = -1;
+  int rx_fd = -1;
+  int ret;
+  struct sockaddr_in rx_addr;
+  size_t payload_len = 1024;
+  char send_buf[payload_len];
+  char recv_buf[payload_len];
+  st_test_rand_data((uint8_t*)send_buf, payload_len, 0);
+
+  mufd_init_sockaddr(&rx_addr, p->sip_addr[rx_port], 20001);
+
+  ret = mufd_socket_port(AF_INET, SOCK_DGRAM, 0, tx_port);
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+  tx_fd = ret;
+
+  ret = mufd_socket_port(AF_INET, SOCK_DGRAM, 0, rx_port);
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+  rx_fd = ret;
+
+  ret = mufd_bind(rx_fd, (const struct sockaddr*)&rx_addr, sizeof(rx_addr));
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+
+  struct timeval tv;
+  tv.tv_sec = 1;
+  tv.tv_usec = 0;
+  ret = mufd_setsockopt(rx_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+
+  /* let the tx queue go idle */
+  st_usleep(100 * 1000);
+
+  {
+    ssize_t send = mufd_sendto(tx_fd, send_buf, sizeof(send_buf), 0,
+                               (const struct sockaddr*)&rx_addr, sizeof(rx_addr));
+    EXPECT_EQ(send, (ssize_t)sizeof(send_buf));
+    /* no more tx, the single pkt should arrive by itself */
+    ssize_t recv = mufd_recvfrom(rx_fd, recv_buf, sizeof(recv_buf), 0, NULL, NULL);
+    EXPECT_EQ(recv, (ssize_t)sizeof(recv_buf));
+    if (recv == (ssize_t)sizeof(recv_buf)) EXPECT_EQ(0, memcmp(send_buf, recv_buf, recv));
+  }
+
+exit:
+  if (tx_fd >= 0) mufd_close(tx_fd);
+  if (rx_fd >= 0) mufd_close(rx_fd);
+}
+
+TEST(Api, socket_tx_idle_single) { socket_tx_idle_single_test(MTL_PORT_P, MTL_PORT_R); }
+TEST(Api, socket_tx_idle_single_r) { socket_tx_idle_single_test(MTL_PORT_R, MTL_PORT_P); }
+
 static int check_r_port_alive(struct mtl_init_params* p) {
   int tx_fd = -1;
   int rx_fd = -1;